@@ -33,14 +33,20 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <sys/uio.h>
 
 #else
 
 #include <linux/stddef.h>
 #include <linux/types.h>
+#include <linux/uio.h>
 
 #endif
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /*------------------------------------------------------------------------------------------------*/
 /*---------------------------------- PUBLIC CONSTANTS AND MACROS ---------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
@@ -57,6 +63,12 @@
 /**  Max number of fragment id */
 #define RLE_MAX_FRAG_NUMBER                     (RLE_MAX_FRAG_ID + 1)
 
+/** NUMA node given to place an instance anywhere */
+#define RLE_NUMA_NODE_ANY                       (-1)
+
+/** Placement flag: back the instance with 2 MB huge pages (ignored in the kernel) */
+#define RLE_PLACEMENT_HUGEPAGES                 0x01U
+
 /** Status of the encapsulation. */
 enum rle_encap_status {
 	RLE_ENCAP_OK,                /**< Ok.                                    */
@@ -85,7 +97,8 @@ enum rle_pack_status {
 	RLE_PACK_ERR,                /**< Default error. SDUs should be dropped.                   */
 	RLE_PACK_ERR_FPDU_TOO_SMALL, /**< Error. FPDU is too small for the current PPDU. No drop.  */
 	RLE_PACK_ERR_INVALID_PPDU,   /**< Error. Current PPDU is invalid, maybe NULL or bad size.  */
-	RLE_PACK_ERR_INVALID_LAB     /**< Error. Current label is invalid, maybe NULL or bad size. */
+	RLE_PACK_ERR_INVALID_LAB,    /**< Error. Current label is invalid, maybe NULL or bad size. */
+	RLE_PACK_ERR_IOV_FULL        /**< Error. No segment left in the gather list. No drop.     */
 };
 
 /** Status of the decapsulation. */
@@ -97,7 +110,9 @@ enum rle_decap_status {
 	RLE_DECAP_ERR_SOME_DROP, /**< Error. Some SDUs were dropped. Some may be lost.          */
 	RLE_DECAP_ERR_INV_FPDU,  /**< Error. Invalid FPDU. Maybe Null or bad size.              */
 	RLE_DECAP_ERR_INV_SDUS,  /**< Error. Given preallocated SDUs array is invalid.          */
-	RLE_DECAP_ERR_INV_PL     /**< Error. Given preallocated payload label array is invalid. */
+	RLE_DECAP_ERR_INV_PL,    /**< Error. Given preallocated payload label array is invalid. */
+	RLE_DECAP_FILTERED,      /**< Ok. Payload label not accepted, FPDU dropped unparsed.    */
+	RLE_DECAP_ARENA_FULL     /**< Ok. The SDU arena is full, FPDU to be resumed.            */
 };
 
 /** Status of RLE header size. */
@@ -193,6 +208,13 @@ struct rle_frag_buf;
 /*--------------------------------- PUBLIC STRUCTS AND TYPEDEFS ----------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
 
+/** Segment of a gathered FPDU, see \ref rle_pack_iov */
+#ifndef __KERNEL__
+typedef struct iovec rle_iovec_t;
+#else
+typedef struct kvec rle_iovec_t;
+#endif
+
 /**
  * RLE Service Data Unit.
  * Interface for the encapsulation and decapsulation functions.
@@ -203,6 +225,60 @@ struct rle_sdu {
 	uint16_t protocol_type;  /**< The protocol type (uncompressed) of the RLE SDU. */
 };
 
+/** Room required before the SDU of a \ref rle_sdu_buf: largest PPDU and ALPDU headers */
+#define RLE_SDU_BUF_HEADROOM 7
+
+/** Room required after the SDU of a \ref rle_sdu_buf: largest ALPDU trailer */
+#define RLE_SDU_BUF_TAILROOM 4
+
+/**
+ * RLE SDU in a larger buffer, with room before and after it.
+ * Interface for the in place encapsulation, see \ref rle_encapsulate_in_place.
+ *
+ * +-----------+-------------------+-----------+
+ * | headroom  |        SDU        | tailroom  |
+ * +-----------+-------------------+-----------+
+ * ^           ^
+ * head        head + data_offset
+ */
+struct rle_sdu_buf {
+	unsigned char *head;     /**< The start of the buffer.                             */
+	size_t size;             /**< The size of the whole buffer.                        */
+	size_t data_offset;      /**< The offset of the SDU in the buffer, its headroom.   */
+	size_t data_len;         /**< The size of the SDU.                                 */
+	uint16_t protocol_type;  /**< The protocol type (uncompressed) of the RLE SDU.     */
+};
+
+/**
+ * RLE SDU decapsulated in a \ref rle_sdu_arena.
+ */
+struct rle_sdu_desc {
+	uint32_t offset;         /**< The offset of the SDU in the arena.                   */
+	uint16_t size;           /**< The size of the SDU.                                  */
+	uint16_t protocol_type;  /**< The protocol type (uncompressed) of the RLE SDU.     */
+	uint8_t frag_id;         /**< The context of the SDU, 0 for a Complete PPDU.        */
+};
+
+/**
+ * RLE SDUs packed back-to-back in one buffer, with a descriptor per SDU.
+ * Interface for the decapsulation in an arena, see \ref rle_decapsulate_arena.
+ *
+ * +-------+-------+-----------+-------------+
+ * | SDU 0 | SDU 1 |    ...    |    free     |
+ * +-------+-------+-----------+-------------+
+ * ^                           ^             ^
+ * buffer                      buffer + used buffer + size
+ */
+struct rle_sdu_arena {
+	unsigned char *buffer;       /**< The buffer of the SDUs.                           */
+	size_t size;                 /**< The size of the buffer.                           */
+	size_t used;                 /**< The octets of the buffer used by the SDUs.        */
+	struct rle_sdu_desc *descs;  /**< The descriptors of the SDUs.                      */
+	size_t descs_max_nr;         /**< The number of descriptors.                        */
+	size_t descs_nr;             /**< The number of SDUs in the arena.                  */
+	size_t resume_offset;        /**< Where to resume the FPDU, 0 to start a new one.   */
+};
+
 /**
  * RLE configuration
  *
@@ -296,6 +372,46 @@ struct rle_config {
 	uint8_t type_0_alpdu_label_size;
 };
 
+/**
+ * Estimate of the PPDUs of one SDU over a sequence of bursts, see \ref rle_fragment_estimate.
+ */
+struct rle_frag_estimate {
+	size_t ppdus_nr;        /**< Number of PPDUs.                                           */
+	size_t bursts_nr;       /**< Number of bursts used, the ones too small for a PPDU too.   */
+	size_t ppdu_bytes;      /**< Octets of the PPDUs: headers, SDU and trailer.             */
+	size_t header_bytes;    /**< Octets of the PPDU and ALPDU headers.                      */
+	size_t trailer_bytes;   /**< Octets of the ALPDU trailer.                               */
+	size_t padding_bytes;   /**< Octets of the bursts used left unused.                     */
+	size_t remaining_bytes; /**< Octets of ALPDU that did not fit in the bursts, 0 if none. */
+};
+
+/** Max number of FPDUs planned at once by \ref rle_pack_plan */
+#define RLE_PACK_PLAN_FPDUS_MAX 64
+
+/**
+ * One PPDU of a plan of \ref rle_pack_plan: call \ref rle_fragment on the context with the burst
+ * size, then \ref rle_pack the PPDU in the FPDU.
+ */
+struct rle_pack_slot {
+	size_t fpdu_id;         /**< The FPDU of the PPDU, index in the FPDU sizes.      */
+	size_t burst_size;      /**< The burst size to give to \ref rle_fragment.        */
+	size_t ppdu_len;        /**< The length of the PPDU.                             */
+	uint8_t frag_id;        /**< The context of the PPDU.                            */
+};
+
+/**
+ * Summary of a plan of \ref rle_pack_plan.
+ */
+struct rle_pack_plan_info {
+	size_t slots_nr;        /**< Number of PPDUs.                                    */
+	size_t completed_nr;    /**< Number of ALPDUs sent completely.                   */
+	size_t alpdu_bytes;     /**< Octets of ALPDU carried, trailers included.         */
+	size_t header_bytes;    /**< Octets of the PPDU headers.                         */
+	size_t trailer_bytes;   /**< Octets of the trailers of the ALPDUs fragmented.    */
+	size_t padding_bytes;   /**< Octets of the FPDUs left unused.                    */
+	size_t nodes;           /**< Nodes explored by the bounded search.               */
+};
+
 /**
  * RLE transmitter statistics.
  */
@@ -308,6 +424,66 @@ struct rle_transmitter_stats {
 	uint64_t bytes_dropped; /**< Number of octets dropped.              */
 };
 
+/** Types of PPDU. */
+enum rle_ppdu_type {
+	RLE_PPDU_TYPE_COMP,  /**< Complete PPDU.                   */
+	RLE_PPDU_TYPE_START, /**< START PPDU.                      */
+	RLE_PPDU_TYPE_CONT,  /**< CONTINUATION PPDU.               */
+	RLE_PPDU_TYPE_END,   /**< END PPDU.                        */
+	RLE_PPDU_TYPE_NB     /**< Number of PPDU types, not a type. */
+};
+
+/**
+ * Number of buckets of the histogram of the PPDUs per SDU: bucket n counts the SDUs sent in
+ * n + 1 PPDUs, the last one the SDUs sent in 16 PPDUs or more.
+ */
+#define RLE_PPDUS_PER_SDU_BUCKETS 16
+
+/**
+ * RLE link efficiency statistics of a transmitter context: where the octets of the PPDUs go.
+ */
+struct rle_link_ctx_stats {
+	uint64_t ppdus[RLE_PPDU_TYPE_NB];  /**< Number of PPDUs, per type.                    */
+	uint64_t sdu_bytes;                /**< Octets of the SDUs sent completely.          */
+	uint64_t ppdu_hdr_bytes;           /**< Octets of the PPDU headers.                  */
+	uint64_t alpdu_hdr_bytes;          /**< Octets of the ALPDU headers.                 */
+	uint64_t trailer_bytes;            /**< Octets of the CRC and seqnum trailers.       */
+	uint64_t ppdus_per_sdu[RLE_PPDUS_PER_SDU_BUCKETS]; /**< Histogram of the PPDUs per SDU. */
+};
+
+/**
+ * RLE link efficiency statistics of a transmitter, see \ref rle_transmitter_stats_get_link.
+ */
+struct rle_link_stats {
+	struct rle_link_ctx_stats ctx[RLE_MAX_FRAG_NUMBER]; /**< Per context counters.        */
+	struct rle_link_ctx_stats total;                   /**< Sum of the contexts.          */
+	uint64_t fpdus;                                    /**< Number of FPDUs.              */
+	uint64_t fpdu_bytes;                               /**< Octets of the FPDUs.          */
+	uint64_t label_bytes;                              /**< Octets of the payload labels. */
+	uint64_t padding_bytes;                            /**< Octets of padding.            */
+};
+
+/** Deadline of the SDUs that never expire, see \ref rle_encapsulate_timed. */
+#define RLE_SDU_NO_DEADLINE ((uint64_t) -1)
+
+/** Policies of the scheduler between the real-time contexts of a transmitter. */
+enum rle_sched_policy {
+	RLE_SCHED_PRIORITY, /**< Strict priority, lowest fragment ID first.       */
+	RLE_SCHED_EDF,      /**< Earliest deadline first, then oldest SDU first. */
+};
+
+/**
+ * Configuration of the scheduler of the fragmentation contexts of a transmitter.
+ *
+ * The contexts with a quantum of 0 are real-time ones, served before the others by \p policy.
+ * The contexts with a quantum are bulk ones, served by deficit round robin when no real-time
+ * context has an SDU, each one for about \p quantum octets per round.
+ */
+struct rle_sched_config {
+	enum rle_sched_policy policy;          /**< Policy between the real-time contexts. */
+	size_t quantum[RLE_MAX_FRAG_NUMBER];   /**< DRR quantum in octets, 0 for real-time. */
+};
+
 /**
  * RLE receiver statistics.
  */
@@ -321,6 +497,205 @@ struct rle_receiver_stats {
 	uint64_t bytes_dropped;     /**< Number of octets dropped.              */
 };
 
+/** Types of the errors detected by a receiver on malformed input. */
+enum rle_decap_error_type {
+	RLE_DECAP_ERROR_INV_LEN,       /**< Length inconsistent with the FPDU or the SDU.        */
+	RLE_DECAP_ERROR_CTX_STATE,     /**< START on a busy context, CONT or END on a free one.  */
+	RLE_DECAP_ERROR_CRC,           /**< ALPDU CRC mismatch.                                  */
+	RLE_DECAP_ERROR_SEQNUM,        /**< ALPDU sequence number gap.                           */
+	RLE_DECAP_ERROR_TRAILER_SHORT, /**< Too few bytes left for the ALPDU trailer.            */
+	RLE_DECAP_ERROR_ALPDU_HDR,     /**< Invalid ALPDU header or protocol type.               */
+	RLE_DECAP_ERROR_VLAN,          /**< VLAN protocol type that cannot be rebuilt.           */
+	RLE_DECAP_ERROR_SDUS_FULL,     /**< No SDU buffer left for the remaining PPDUs.          */
+	RLE_DECAP_ERROR_PADDING,       /**< Non-zero octets in the FPDU padding.                 */
+	RLE_DECAP_ERROR_NB             /**< Number of error types, not a type.                   */
+};
+
+/**
+ * RLE receiver error statistics, shared by all the contexts.
+ */
+struct rle_receiver_error_stats {
+	uint64_t errors[RLE_DECAP_ERROR_NB]; /**< Number of errors, per type.                     */
+	uint64_t traces_suppressed;          /**< Number of error traces dropped by rate limiting. */
+	uint64_t fpdus_filtered;             /**< Number of FPDUs dropped by the label filter.     */
+};
+
+/** Max number of payload labels accepted by the filter of a receiver. */
+#define RLE_LABEL_FILTER_MAX 8
+
+/** Default rate of the error traces of a receiver, in traces per second. */
+#define RLE_ERROR_TRACE_RATE_DEFAULT  100
+
+/** Default burst of the error traces of a receiver, in traces. */
+#define RLE_ERROR_TRACE_BURST_DEFAULT 100
+
+/** Processing stages instrumented by the latency histograms. */
+enum rle_latency_stage {
+	RLE_LATENCY_STAGE_ENCAP,       /**< rle_encapsulate, transmitter side.               */
+	RLE_LATENCY_STAGE_DEENCAP,     /**< Decapsulation of one PPDU, receiver side.        */
+	RLE_LATENCY_STAGE_REASM_COMP,  /**< Reassembly of a Complete PPDU, receiver side.    */
+	RLE_LATENCY_STAGE_REASM_START, /**< Reassembly of a Start PPDU, receiver side.       */
+	RLE_LATENCY_STAGE_REASM_CONT,  /**< Reassembly of a Continuation PPDU, receiver side. */
+	RLE_LATENCY_STAGE_REASM_END,   /**< Reassembly of an End PPDU, receiver side.        */
+	RLE_LATENCY_STAGE_NB           /**< Number of stages, not a stage.                   */
+};
+
+/**
+ * Log-2 of the number of linear sub-buckets in each power-of-two range of a latency histogram.
+ * 3 bits give a relative precision of 12.5% on every recorded value.
+ */
+#define RLE_LATENCY_HISTO_SUB_BITS              3
+
+/**
+ * Number of buckets in a latency histogram. Values up to 2^34 ns (about 17 s) are
+ * distinguished, longer ones are accounted in the last bucket.
+ */
+#define RLE_LATENCY_HISTO_BUCKETS               256
+
+/**
+ * Pseudo fragment ID used to request a latency histogram merged over all the contexts,
+ * including the PPDUs that are not related to any context (Complete PPDUs).
+ */
+#define RLE_LATENCY_ALL_CTX                     0xff
+
+/**
+ * RLE latency histogram.
+ *
+ * Log-linear (HDR-like) histogram of durations in nanoseconds: values lower than
+ * 2^RLE_LATENCY_HISTO_SUB_BITS have their own bucket, then each power-of-two range is split
+ * into 2^RLE_LATENCY_HISTO_SUB_BITS linear buckets. See \ref rle_latency_histo_get_bucket_min.
+ */
+struct rle_latency_histo {
+	uint64_t count;                               /**< Number of recorded durations.    */
+	uint64_t sum_ns;                              /**< Sum of the recorded durations.   */
+	uint64_t min_ns;                              /**< Shortest recorded duration.      */
+	uint64_t max_ns;                              /**< Longest recorded duration.       */
+	uint64_t buckets[RLE_LATENCY_HISTO_BUCKETS];  /**< Number of durations per bucket.  */
+};
+
+/**
+ * Memory allocator of the library.
+ *
+ * All the allocations and releases of the library go through the hooks, see
+ * \ref rle_set_allocator.
+ */
+struct rle_allocator {
+	/** Allocate \e size octets, return NULL on failure */
+	void *(*alloc)(void *const priv, const size_t size);
+	/** Release a block given by \e alloc, never called with NULL */
+	void (*free)(void *const priv, void *const ptr);
+	/** Private data given to the hooks */
+	void *priv;
+};
+
+/**
+ * Counters of the allocation and zeroing audit mode.
+ *
+ * Only the operations done while the audit is enabled are counted, see
+ * \ref rle_alloc_audit_enable.
+ */
+struct rle_alloc_audit {
+	uint64_t allocs;           /**< Number of successful allocations.                 */
+	uint64_t alloc_failures;   /**< Number of failed allocations.                     */
+	uint64_t frees;            /**< Number of releases.                               */
+	uint64_t bytes_allocated;  /**< Octets allocated.                                 */
+	uint64_t zeroings;         /**< Number of bulk zeroings of internal memory.       */
+	uint64_t bytes_zeroed;     /**< Octets zeroed in bulk.                            */
+	uint64_t poisonings;       /**< Number of buffer poisonings (RLE_POISON builds).  */
+	uint64_t bytes_poisoned;   /**< Octets poisoned (RLE_POISON builds).              */
+};
+
+#ifndef __KERNEL__
+
+/** Magic number at the start of a shared-memory statistics region ("RLES"). */
+#define RLE_STATS_SHM_MAGIC                     0x524c4553U
+
+/** Version of the layout of the shared-memory statistics region. */
+#define RLE_STATS_SHM_VERSION                   4
+
+/** Transmitter part of a shared-memory statistics region. */
+struct rle_stats_shm_transmitter {
+	uint64_t updates;                                   /**< Number of publications.     */
+	struct rle_transmitter_stats ctx[RLE_MAX_FRAG_NUMBER]; /**< Per context counters.   */
+	struct rle_transmitter_stats total;                 /**< Sum of the contexts.        */
+	uint64_t queue_size[RLE_MAX_FRAG_NUMBER];           /**< Per context queue size.     */
+	uint64_t sdus_expired[RLE_MAX_FRAG_NUMBER];         /**< Per context expired SDUs.   */
+	uint64_t bytes_expired[RLE_MAX_FRAG_NUMBER];        /**< Per context expired octets. */
+	uint64_t total_sdus_expired;                        /**< Expired SDUs in total.      */
+	uint64_t total_bytes_expired;                       /**< Expired octets in total.    */
+};
+
+/** Receiver part of a shared-memory statistics region. */
+struct rle_stats_shm_receiver {
+	uint64_t updates;                                   /**< Number of publications.     */
+	struct rle_receiver_stats ctx[RLE_MAX_FRAG_NUMBER]; /**< Per context counters.       */
+	struct rle_receiver_stats total;                    /**< Sum of the contexts.        */
+	uint64_t queue_size[RLE_MAX_FRAG_NUMBER];           /**< Per context queue size.     */
+	struct rle_receiver_error_stats errors;             /**< Errors on malformed input.  */
+};
+
+/** Consistent snapshot of a shared-memory statistics region. */
+struct rle_stats_shm_snapshot {
+	struct rle_stats_shm_transmitter transmitter; /**< Transmitter counters. */
+	struct rle_stats_shm_receiver receiver;       /**< Receiver counters.    */
+};
+
+/**
+ * Layout of a shared-memory statistics region.
+ *
+ * The region is written by one process only. Readers shall use \ref rle_stats_shm_read or
+ * follow the seqlock protocol: read \e seq, retry while odd, copy \e data, then retry if
+ * \e seq changed meanwhile.
+ */
+struct rle_stats_shm_region {
+	uint32_t magic;                      /**< RLE_STATS_SHM_MAGIC.                     */
+	uint32_t version;                    /**< RLE_STATS_SHM_VERSION.                   */
+	uint32_t size;                       /**< Size of the region in octets.            */
+	uint32_t seq;                        /**< Sequence counter, odd while updating.    */
+	struct rle_stats_shm_snapshot data;  /**< Statistics.                              */
+};
+
+/** Handle on a shared-memory statistics region. */
+struct rle_stats_shm;
+
+/** Magic number at the start of a FPDU trace ("RLET"). */
+#define RLE_FPDU_TRACE_MAGIC                    0x524c4554U
+
+/** Version of the layout of the FPDU traces. */
+#define RLE_FPDU_TRACE_VERSION                  1
+
+/**
+ * Header of a FPDU trace, at its start, in host byte order.
+ *
+ * The records follow the header, each one aligned on 8 octets. The index of the records, the
+ * offsets of the records as uint64_t, is appended once the trace is complete. A trace that was
+ * not completed has no index, its records are found back by a scan.
+ */
+struct rle_fpdu_trace_header {
+	uint32_t magic;         /**< RLE_FPDU_TRACE_MAGIC.                              */
+	uint32_t version;       /**< RLE_FPDU_TRACE_VERSION.                            */
+	uint64_t records_nr;    /**< Number of records of the index, 0 without index.   */
+	uint64_t index_offset;  /**< Offset of the index, 0 without index.              */
+	uint64_t reserved[5];   /**< Zeroed.                                            */
+};
+
+/** Header of a record of a FPDU trace, followed by the FPDU and padding up to 8 octets. */
+struct rle_fpdu_trace_record {
+	uint64_t timestamp_ns;  /**< Date of the FPDU, in nanoseconds.                  */
+	uint32_t burst;         /**< Burst of the FPDU, shared by the FPDUs of a burst. */
+	uint16_t fpdu_len;      /**< Octets of the FPDU, Payload Label included.        */
+	uint8_t label_len;      /**< Octets of the Payload Label: 0, 3 or 6.            */
+	uint8_t flags;          /**< Zeroed.                                            */
+};
+
+/** Writer of a FPDU trace. */
+struct rle_fpdu_trace_writer;
+
+/** FPDU trace mapped in memory. */
+struct rle_fpdu_trace;
+
+#endif /* !__KERNEL__ */
+
 /*------------------------------------------------------------------------------------------------*/
 /*--------------------------------------- PUBLIC FUNCTIONS ---------------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
@@ -346,6 +721,82 @@ __attribute__((warn_unused_result));
  */
 void rle_transmitter_destroy(struct rle_transmitter **const transmitter);
 
+/**
+ * @brief         Create and initialize a RLE transmitter module with its own allocator.
+ *
+ *                The transmitter and all its buffers are allocated and released with the given
+ *                allocator, whatever the allocator registered with \ref rle_set_allocator.
+ *
+ * @param[in]     conf       The configuration of the RLE transmitter.
+ * @param[in]     allocator  The allocator, copied. NULL for the registered one.
+ *
+ * @return        A pointer to the transmitter module.
+ *
+ * @ingroup       RLE transmitter
+ */
+struct rle_transmitter * rle_transmitter_new_with_allocator(const struct rle_config *const conf,
+                                                            const struct rle_allocator *const
+                                                            allocator)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Create and initialize a RLE transmitter module on a NUMA node.
+ *
+ *                The transmitter and all its context buffers are placed in one memory region
+ *                bound to the node, so that a core of the node processes them without remote
+ *                memory accesses. With RLE_PLACEMENT_HUGEPAGES, the region is backed by 2 MB
+ *                huge pages if some are reserved, else by transparent huge pages if possible.
+ *                On a kernel without NUMA support, node 0 is accepted as the only node.
+ *
+ * @param[in]     conf   The configuration of the RLE transmitter.
+ * @param[in]     node   The NUMA node, RLE_NUMA_NODE_ANY to use the region without binding.
+ * @param[in]     flags  The RLE_PLACEMENT_* flags.
+ *
+ * @return        A pointer to the transmitter module, NULL if the node is not available.
+ *
+ * @ingroup       RLE transmitter
+ */
+struct rle_transmitter * rle_transmitter_new_on_node(const struct rle_config *const conf,
+                                                     const int node,
+                                                     const unsigned int flags)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Create and initialize RLE transmitter modules in bulk.
+ *
+ *                The transmitters share one configuration and are all placed in one memory
+ *                region, allocated at once, instead of 9 allocations per transmitter. The
+ *                region is released with the last transmitter destroyed, with
+ *                \ref rle_transmitter_destroy_bulk or one by one with
+ *                \ref rle_transmitter_destroy. See \ref rle_transmitter_new_on_node for the
+ *                placement. The transmitters may then be handed to different threads: each one
+ *                may enable its latency histograms and be destroyed independently of the others.
+ *
+ * @param[in]     conf          The configuration of the RLE transmitters.
+ * @param[in]     nr            The number of transmitters.
+ * @param[in]     node          The NUMA node, RLE_NUMA_NODE_ANY to use the region without
+ *                              binding.
+ * @param[in]     flags         The RLE_PLACEMENT_* flags.
+ * @param[out]    transmitters  The nr transmitters, all NULL in case of failure.
+ *
+ * @return        0 if OK, else 1.
+ *
+ * @ingroup       RLE transmitter
+ */
+int rle_transmitter_new_bulk(const struct rle_config *const conf, const size_t nr, const int node,
+                             const unsigned int flags, struct rle_transmitter *transmitters[])
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Destroy RLE transmitter modules, created in bulk or not.
+ *
+ * @param[in,out] transmitters  The transmitters to destroy, set to NULL.
+ * @param[in]     nr            The number of transmitters.
+ *
+ * @ingroup       RLE transmitter
+ */
+void rle_transmitter_destroy_bulk(struct rle_transmitter *transmitters[], const size_t nr);
+
 /**
  * @brief         Create and initialize a RLE receiver module.
  *
@@ -367,6 +818,74 @@ __attribute__((warn_unused_result));
  */
 void rle_receiver_destroy(struct rle_receiver **const receiver);
 
+/**
+ * @brief         Create and initialize a RLE receiver module with its own allocator.
+ *
+ *                The receiver and all its buffers are allocated and released with the given
+ *                allocator, whatever the allocator registered with \ref rle_set_allocator.
+ *
+ * @param[in]     conf       The configuration of the RLE receiver.
+ * @param[in]     allocator  The allocator, copied. NULL for the registered one.
+ *
+ * @return        A pointer to the receiver module.
+ *
+ * @ingroup       RLE receiver
+ */
+struct rle_receiver * rle_receiver_new_with_allocator(const struct rle_config *const conf,
+                                                      const struct rle_allocator *const allocator)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Create and initialize a RLE receiver module on a NUMA node.
+ *
+ *                The receiver and all its reassembly buffers are placed in one memory region
+ *                bound to the node, see \ref rle_transmitter_new_on_node.
+ *
+ * @param[in]     conf   The configuration of the RLE receiver.
+ * @param[in]     node   The NUMA node, RLE_NUMA_NODE_ANY to use the region without binding.
+ * @param[in]     flags  The RLE_PLACEMENT_* flags.
+ *
+ * @return        A pointer to the receiver module, NULL if the node is not available.
+ *
+ * @ingroup       RLE receiver
+ */
+struct rle_receiver * rle_receiver_new_on_node(const struct rle_config *const conf,
+                                               const int node,
+                                               const unsigned int flags)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Create and initialize RLE receiver modules in bulk.
+ *
+ *                The receivers share one configuration and are all placed in one memory region,
+ *                allocated at once, instead of 17 allocations per receiver. The region is
+ *                released with the last receiver destroyed, see
+ *                \ref rle_transmitter_new_bulk.
+ *
+ * @param[in]     conf       The configuration of the RLE receivers.
+ * @param[in]     nr         The number of receivers.
+ * @param[in]     node       The NUMA node, RLE_NUMA_NODE_ANY to use the region without binding.
+ * @param[in]     flags      The RLE_PLACEMENT_* flags.
+ * @param[out]    receivers  The nr receivers, all NULL in case of failure.
+ *
+ * @return        0 if OK, else 1.
+ *
+ * @ingroup       RLE receiver
+ */
+int rle_receiver_new_bulk(const struct rle_config *const conf, const size_t nr, const int node,
+                          const unsigned int flags, struct rle_receiver *receivers[])
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Destroy RLE receiver modules, created in bulk or not.
+ *
+ * @param[in,out] receivers  The receivers to destroy, set to NULL.
+ * @param[in]     nr         The number of receivers.
+ *
+ * @ingroup       RLE receiver
+ */
+void rle_receiver_destroy_bulk(struct rle_receiver *receivers[], const size_t nr);
+
 /**
  * @brief         Create a new fragmentation buffer.
  *
@@ -416,6 +935,27 @@ int rle_frag_buf_cpy_sdu(struct rle_frag_buf *const f_buff,
                          const struct rle_sdu *const sdu)
 __attribute__((warn_unused_result));
 
+/**
+ * @brief         Attach an SDU buffer to a fragmentation buffer, without copying the SDU.
+ *
+ *                The ALPDU and PPDU headers are then written in the headroom of the SDU buffer,
+ *                the ALPDU trailer in its tailroom, and the PPDU headers of the next fragments
+ *                over the SDU octets already fragmented. The SDU buffer must thus be kept and
+ *                not be modified until the SDU is fully fragmented, and its content is lost.
+ *                The fragmentation buffer uses its own memory again once reinitialized.
+ *
+ * @param[in,out] f_buff   The fragmentation buffer. Must not contain an SDU.
+ * @param[in]     sdu_buf  The SDU buffer, with at least \ref RLE_SDU_BUF_HEADROOM octets of
+ *                         headroom and \ref RLE_SDU_BUF_TAILROOM octets of tailroom.
+ *
+ * @return        0 if OK, else 1.
+ *
+ * @ingroup       RLE Fragmentation buffer
+ */
+int rle_frag_buf_attach_sdu(struct rle_frag_buf *const f_buff,
+                            const struct rle_sdu_buf *const sdu_buf)
+__attribute__((warn_unused_result));
+
 /**
  * @brief         RLE encapsulation. Encapsulate a SDU in a RLE ALPDU frame.
  *
@@ -482,6 +1022,34 @@ enum rle_frag_status rle_fragment(struct rle_transmitter *const transmitter,
                                   size_t *const ppdu_length)
 __attribute__((warn_unused_result));
 
+/**
+ * @brief         Estimate the PPDUs of one SDU, without encapsulating it.
+ *
+ *                Give the number of PPDUs and the on-air octets that \ref rle_encapsulate then
+ *                \ref rle_fragment called with each burst size in turn would produce for the
+ *                SDU, byte for byte: the decisions are shared with the fragmentation. A burst too
+ *                small for the next PPDU is skipped, as \ref rle_fragment refuses it. The
+ *                estimation does not allocate nor touch any transmitter.
+ *
+ * @param[in]     conf         The configuration of the transmitter.
+ * @param[in]     sdu          The SDU. Its bytes are read when the ALPDU header depends on
+ *                             them only: protocol type omission with an implicit IP or VLAN
+ *                             protocol type, and VLAN frames.
+ * @param[in]     burst_sizes  The remaining sizes of the successive bursts.
+ * @param[in]     bursts_nr    The number of bursts.
+ * @param[out]    estimate     The estimate.
+ *
+ * @return        0 if OK, else 1 (invalid parameter or SDU too large).
+ *
+ * @ingroup       RLE transmitter
+ */
+int rle_fragment_estimate(const struct rle_config *const conf,
+                          const struct rle_sdu *const sdu,
+                          const size_t burst_sizes[],
+                          const size_t bursts_nr,
+                          struct rle_frag_estimate *const estimate)
+__attribute__((warn_unused_result));
+
 /**
  * @brief         RLE fragmentation. Get the next PPDU fragment.
  *
@@ -570,54 +1138,405 @@ void rle_pad(unsigned char *const fpdu,
              const size_t fpdu_remaining_size);
 
 /**
- * @brief Decapsulate the given FPDU into zero or more SDUs
- *
- * The function returns all of the SDUs that are fully decapsulated. If some
- * PPDU fragments are missing for some of them, the fragments that are already
- * received are kept in the internal contexts of the library. Next calls to
- * the function may complete them, they will then be added to the \e sdus output
- * parameter.
- *
- * The payload label is extracted in a preallocated buffer depending on the size
- * given by the caller. This size is known by the type of FPDU awaited and the
- * predefined size given by ETSI EN 301 545-2 V1.2.1, tab. 7-10 p. 119.
+ * @brief         Init the given gathered FPDU with the given Payload Label
  *
- * The array of SDUs \e sdus shall be initialized by the caller with
- * \e sdus_max_nr memory areas of at least 4095 bytes each. The \e sdus[n].size
- * and \e sdus[n].protocol_type shall be set to 0.
+ *                As \ref rle_pack_init, but the FPDU is a list of segments for vectored I/O.
+ *                The label segment points to \p label, which must live until the FPDU is sent.
  *
- * @param[in,out] receiver                The receiver module.
- * @param[in]     fpdu                    The FPDU to decapsulate.
- * @param[in]     fpdu_length             The size of the FPDU.
- * @param[in,out] sdus                    The SDUs array to extract from the FPDU, preallocated.
- * @param[in]     sdus_max_nr             The SDUs array size, max number of extractable SDUs.
- * @param[out]    sdus_nr                 The current number of SDUs in the SDUs array.
- * @param[in,out] payload_label           The identifier of the RCST, preallocated.
- * @param[in]     payload_label_size      The size of the paylod label.
+ * @param[in]     label                   The FPDU label fields.
+ * @param[in]     label_size              Size of the FPDU label field
+ * @param[in,out] iov                     The segments of the FPDU
+ * @param[in]     iov_max                 The number of segments that fit in \p iov
+ * @param[in,out] iov_nr                  The number of segments of the FPDU, 0 when empty
+ * @param[in,out] fpdu_current_pos        Current position in the FPDU
+ * @param[in,out] fpdu_remaining_size     Remaining size in the FPDU
  *
- * @return        decapsulation status.
+ * @return        Frame packing status
  *
- * @ingroup       RLE receiver
+ * @ingroup       RLE transmitter
  */
-enum rle_decap_status rle_decapsulate(struct rle_receiver *const receiver,
-                                      unsigned char *const fpdu,
-                                      const size_t fpdu_length,
-                                      struct rle_sdu sdus[],
-                                      const size_t sdus_max_nr,
-                                      size_t *const sdus_nr,
-                                      unsigned char *const payload_label,
-                                      const size_t payload_label_size)
+enum rle_pack_status rle_pack_iov_init(const unsigned char *const label,
+                                       const size_t label_size,
+                                       rle_iovec_t iov[],
+                                       const size_t iov_max,
+                                       size_t *const iov_nr,
+                                       size_t *const fpdu_current_pos,
+                                       size_t *const fpdu_remaining_size)
 __attribute__((warn_unused_result));
 
 /**
- * @brief         Get occupied size of a queue (frag_id) in an RLE transmitter module.
+ * @brief         RLE frame packing without copy. Add the given PPDU to the given gathered FPDU.
  *
- * @param[in]     transmitter             The transmitter module. Must be initialize.
- * @param[in]     fragment_id             Fragment id to use. Must be valid.
+ *                As \ref rle_pack, but the PPDU is not copied: its segment points to the PPDU
+ *                returned by \ref rle_fragment, in the fragmentation buffer of its context. The
+ *                segment is valid until the next call to \ref rle_fragment or
+ *                \ref rle_encapsulate on the same context, thus an FPDU holds at most one PPDU
+ *                per context and must be sent before the next fragmentation of its contexts.
  *
- * @return        Number of octets present in a queue.
+ * @param[in]     ppdu                    A PPDU to pack.
+ * @param[in]     ppdu_length             The PPDU size.
+ * @param[in]     label                   The FPDU label fields.
+ * @param[in]     label_size              Size of the FPDU label fields.
+ * @param[in,out] iov                     The segments of the FPDU.
+ * @param[in]     iov_max                 The number of segments that fit in \p iov.
+ * @param[in,out] iov_nr                  The number of segments of the FPDU, 0 when empty.
+ * @param[in,out] fpdu_current_pos        Current position in the FPDU.
+ * @param[in,out] fpdu_remaining_size     Remaining size in the FPDU.
  *
- * @ingroup       RLE transmitter statistics
+ * @return        Frame packing status.
+ *
+ * @ingroup       RLE transmitter
+ */
+enum rle_pack_status rle_pack_iov(const unsigned char *const ppdu,
+                                  const size_t ppdu_length,
+                                  const unsigned char *const label,
+                                  const size_t label_size,
+                                  rle_iovec_t iov[],
+                                  const size_t iov_max,
+                                  size_t *const iov_nr,
+                                  size_t *const fpdu_current_pos,
+                                  size_t *const fpdu_remaining_size)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         RLE padding without copy. Pad the given gathered FPDU with 0x00 octets.
+ *
+ *                The padding segments point to a page of zeros shared by all the FPDUs, one
+ *                segment per page of padding.
+ *
+ * @param[in,out] iov                     The segments of the FPDU.
+ * @param[in]     iov_max                 The number of segments that fit in \p iov.
+ * @param[in,out] iov_nr                  The number of segments of the FPDU.
+ * @param[in]     fpdu_remaining_size     Remaining size in the FPDU.
+ *
+ * @return        Frame packing status, RLE_PACK_ERR_IOV_FULL if the padding does not fit in
+ *                \p iov, which is then left unchanged.
+ *
+ * @ingroup       RLE transmitter
+ */
+enum rle_pack_status rle_pad_iov(rle_iovec_t iov[],
+                                 const size_t iov_max,
+                                 size_t *const iov_nr,
+                                 const size_t fpdu_remaining_size)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Plan the PPDUs of the contexts of a transmitter over several FPDUs.
+ *
+ *                Unlike filling the FPDUs one after the other, the plan chooses which ALPDUs go
+ *                whole as COMP PPDUs in which FPDU, best-fit decreasing, then fragments the other
+ *                ALPDUs in the rooms left. Among the plans, the best one sends the most ALPDUs
+ *                completely, so that the most contexts are free for the next SDUs, then carries
+ *                the most ALPDU octets, then has the least overhead: the least padding and the
+ *                fewest fragmentations.
+ *
+ *                With \p search_max not 0, plans are also searched exhaustively over the ALPDUs
+ *                that may be COMP PPDUs, within \p search_max nodes; for a few contexts, the search
+ *                is complete within a few thousands nodes.
+ *
+ *                The PPDUs are listed FPDU after FPDU, and the fragments of a context in their
+ *                order, so the plan is run in the order of the list. Nothing is changed in the
+ *                transmitter.
+ *
+ * @param[in]     transmitter             The transmitter with the SDUs to send.
+ * @param[in]     fpdu_sizes              The room for PPDUs of each FPDU, labels excluded.
+ * @param[in]     fpdus_nr                The number of FPDUs, at most RLE_PACK_PLAN_FPDUS_MAX.
+ * @param[in]     search_max              The budget of nodes of the search, 0 for none.
+ * @param[out]    slots                   The PPDUs of the plan.
+ * @param[in]     slots_max               The number of PPDUs that fit in \p slots, at most one
+ *                                        per context and FPDU.
+ * @param[out]    info                    The summary of the plan.
+ *
+ * @return        0 if OK, else 1.
+ *
+ * @ingroup       RLE transmitter
+ */
+int rle_pack_plan(const struct rle_transmitter *const transmitter,
+                  const size_t fpdu_sizes[],
+                  const size_t fpdus_nr,
+                  const size_t search_max,
+                  struct rle_pack_slot slots[],
+                  const size_t slots_max,
+                  struct rle_pack_plan_info *const info)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         RLE encapsulation of an SDU with an enqueue time and a deadline.
+ *
+ *                As \ref rle_encapsulate, and the SDU is scheduled by
+ *                \ref rle_transmitter_sched_next with its times. The times are in any unit and
+ *                from any origin, the same for all the calls on the transmitter, for example the
+ *                nanoseconds of a monotonic clock.
+ *
+ * @param[in,out] transmitter             The transmitter module.
+ * @param[in]     sdu                     The RLE Service data unit to encapsulate.
+ * @param[in]     frag_id                 Identify the context to which belongs the datas to encap.
+ * @param[in]     enqueue_time            The time at which the SDU was queued.
+ * @param[in]     deadline                The latest time to send the first fragment of the SDU,
+ *                                        RLE_SDU_NO_DEADLINE for none.
+ *
+ * @return        Encapsulation status.
+ *
+ * @ingroup       RLE transmitter
+ */
+enum rle_encap_status rle_encapsulate_timed(struct rle_transmitter *const transmitter,
+                                            const struct rle_sdu *const sdu,
+                                            const uint8_t frag_id,
+                                            const uint64_t enqueue_time,
+                                            const uint64_t deadline)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         RLE encapsulation of an SDU in place, without copying it.
+ *
+ *                As \ref rle_encapsulate, but the SDU is not copied in the context: the context
+ *                is attached to the SDU buffer as with \ref rle_frag_buf_attach_sdu, and the
+ *                headers and the trailer are written around the SDU. The SDU buffer must be
+ *                kept until the context is free again, that is until the last fragment of the
+ *                SDU is built by \ref rle_fragment or the context is freed.
+ *
+ * @param[in,out] transmitter             The transmitter module.
+ * @param[in]     sdu_buf                 The SDU buffer to encapsulate.
+ * @param[in]     frag_id                 Identify the context to which belongs the datas to encap.
+ *
+ * @return        Encapsulation status, RLE_ENCAP_ERR if the SDU buffer lacks headroom or
+ *                tailroom.
+ *
+ * @ingroup       RLE transmitter
+ */
+enum rle_encap_status rle_encapsulate_in_place(struct rle_transmitter *const transmitter,
+                                               const struct rle_sdu_buf *const sdu_buf,
+                                               const uint8_t frag_id)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         RLE encapsulation of several SDUs, each one in its own context.
+ *
+ *                As \ref rle_encapsulate for each SDU in turn, up to the first failure. With
+ *                ALPDU CRC, the CRC of the SDUs are computed side by side once all the SDUs are
+ *                copied, which is faster than one after the other.
+ *
+ * @param[in,out] transmitter             The transmitter module.
+ * @param[in]     sdus                    The SDUs to encapsulate.
+ * @param[in]     frag_ids                The context of each SDU.
+ * @param[in]     sdus_nr                 The number of SDUs, at most RLE_MAX_FRAG_NUMBER as the
+ *                                        contexts must be free.
+ * @param[out]    encap_nr                The number of SDUs encapsulated, the first ones.
+ *
+ * @return        RLE_ENCAP_OK if all the SDUs are encapsulated, else the encapsulation status
+ *                of the first SDU not encapsulated.
+ *
+ * @ingroup       RLE transmitter
+ */
+enum rle_encap_status rle_encapsulate_bulk(struct rle_transmitter *const transmitter,
+                                           const struct rle_sdu sdus[],
+                                           const uint8_t frag_ids[],
+                                           const size_t sdus_nr,
+                                           size_t *const encap_nr)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Configure the scheduler of the fragmentation contexts of a transmitter.
+ *
+ *                By default, all the contexts are real-time ones with strict priority.
+ *
+ * @param[in,out] transmitter             The transmitter module.
+ * @param[in]     conf                    The configuration of the scheduler.
+ *
+ * @return        0 if OK, else 1.
+ *
+ * @ingroup       RLE transmitter
+ */
+int rle_transmitter_sched_set(struct rle_transmitter *const transmitter,
+                              const struct rle_sched_config *const conf)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Choose the context to fragment next in a transmitter.
+ *
+ *                The SDUs past their deadline at \p now and not fragmented yet are dropped first,
+ *                and counted as expired. Then a real-time context with an SDU is chosen by the
+ *                policy of the scheduler if any, else a bulk context by deficit round robin, which
+ *                is charged with the octets that fit in \p burst_size.
+ *
+ *                Call \ref rle_fragment with the chosen context and \p burst_size right after.
+ *
+ * @param[in,out] transmitter             The transmitter module.
+ * @param[in]     now                     The current time, in the unit of the SDU times.
+ * @param[in]     burst_size              The room for the next PPDU.
+ * @param[out]    frag_id                 The chosen context.
+ *
+ * @return        0 if a context was chosen, else 1 (no SDU to send or invalid parameter).
+ *
+ * @ingroup       RLE transmitter
+ */
+int rle_transmitter_sched_next(struct rle_transmitter *const transmitter,
+                               const uint64_t now,
+                               const size_t burst_size,
+                               uint8_t *const frag_id)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief Decapsulate the given FPDU into zero or more SDUs
+ *
+ * The function returns all of the SDUs that are fully decapsulated. If some
+ * PPDU fragments are missing for some of them, the fragments that are already
+ * received are kept in the internal contexts of the library. Next calls to
+ * the function may complete them, they will then be added to the \e sdus output
+ * parameter.
+ *
+ * The payload label is extracted in a preallocated buffer depending on the size
+ * given by the caller. This size is known by the type of FPDU awaited and the
+ * predefined size given by ETSI EN 301 545-2 V1.2.1, tab. 7-10 p. 119.
+ *
+ * If the receiver accepts a set of payload labels, see \ref rle_receiver_label_filter_add, a
+ * FPDU with another label is dropped before any of its PPDUs is parsed, and RLE_DECAP_FILTERED
+ * is returned.
+ *
+ * The array of SDUs \e sdus shall be initialized by the caller with
+ * \e sdus_max_nr memory areas of at least 4095 bytes each. The \e sdus[n].size
+ * and \e sdus[n].protocol_type shall be set to 0.
+ *
+ * @param[in,out] receiver                The receiver module.
+ * @param[in]     fpdu                    The FPDU to decapsulate.
+ * @param[in]     fpdu_length             The size of the FPDU.
+ * @param[in,out] sdus                    The SDUs array to extract from the FPDU, preallocated.
+ * @param[in]     sdus_max_nr             The SDUs array size, max number of extractable SDUs.
+ * @param[out]    sdus_nr                 The current number of SDUs in the SDUs array.
+ * @param[in,out] payload_label           The identifier of the RCST, preallocated.
+ * @param[in]     payload_label_size      The size of the paylod label.
+ *
+ * @return        decapsulation status.
+ *
+ * @ingroup       RLE receiver
+ */
+enum rle_decap_status rle_decapsulate(struct rle_receiver *const receiver,
+                                      unsigned char *const fpdu,
+                                      const size_t fpdu_length,
+                                      struct rle_sdu sdus[],
+                                      const size_t sdus_max_nr,
+                                      size_t *const sdus_nr,
+                                      unsigned char *const payload_label,
+                                      const size_t payload_label_size)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief Decapsulate the given FPDU into zero or more SDUs packed in an arena
+ *
+ * As \ref rle_decapsulate, but the SDUs are written back-to-back in \e arena->buffer from
+ * \e arena->used on, and described by the descriptors of \e arena->descs from
+ * \e arena->descs_nr on. Both are updated, so the SDUs of several FPDUs may be gathered in the
+ * same arena. The caller empties the arena by setting \e arena->used and \e arena->descs_nr
+ * to 0.
+ *
+ * If the next SDU may not fit in the arena, or if there is no descriptor left, the
+ * decapsulation stops before its PPDU and RLE_DECAP_ARENA_FULL is returned: the SDUs already in
+ * the arena are valid, and \e arena->resume_offset is set to the offset of the PPDU. The caller
+ * then empties the arena and calls the function again with the same FPDU to resume it. No
+ * context is updated by the PPDUs not decapsulated yet. \e arena->resume_offset shall be 0 for a
+ * new FPDU, it is reset to 0 once a FPDU is fully decapsulated.
+ *
+ * A SDU that does not fit in an empty arena is dropped with the rest of the FPDU, and
+ * RLE_DECAP_ERR_SOME_DROP is returned. An arena of RLE_MAX_PDU_SIZE octets holds any SDU. An
+ * arena larger than UINT32_MAX octets, out of reach of the SDU offsets, is rejected with
+ * RLE_DECAP_ERR_INV_SDUS.
+ *
+ * @param[in,out] receiver                The receiver module.
+ * @param[in]     fpdu                    The FPDU to decapsulate.
+ * @param[in]     fpdu_length             The size of the FPDU.
+ * @param[in,out] arena                   The arena of the SDUs.
+ * @param[in,out] payload_label           The identifier of the RCST, preallocated.
+ * @param[in]     payload_label_size      The size of the paylod label.
+ *
+ * @return        decapsulation status.
+ *
+ * @ingroup       RLE receiver
+ */
+enum rle_decap_status rle_decapsulate_arena(struct rle_receiver *const receiver,
+                                            unsigned char *const fpdu,
+                                            const size_t fpdu_length,
+                                            struct rle_sdu_arena *const arena,
+                                            unsigned char *const payload_label,
+                                            const size_t payload_label_size)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief Start the decapsulation of a FPDU received by chunks
+ *
+ * The bytes of the FPDU are then given in order with \ref rle_decap_stream_push, and the
+ * decapsulation is closed with \ref rle_decap_stream_end. A FPDU still in progress is lost.
+ *
+ * @param[in,out] receiver                The receiver module.
+ * @param[in]     fpdu_length             The size of the whole FPDU.
+ * @param[in]     payload_label_size      The size of the paylod label.
+ *
+ * @return        decapsulation status.
+ *
+ * @ingroup       RLE receiver
+ */
+enum rle_decap_status rle_decap_stream_begin(struct rle_receiver *const receiver,
+                                             const size_t fpdu_length,
+                                             const size_t payload_label_size)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief Decapsulate the next chunk of a FPDU into zero or more SDUs
+ *
+ * Every PPDU whose bytes are complete is parsed as soon as its chunk is given, in place in the
+ * chunk when it holds the whole PPDU. Only the PPDU that straddles the end of the chunk is copied
+ * in the receiver until the next chunks complete it. The SDUs completed by the chunk are returned
+ * as with \ref rle_decapsulate, the \e sdus array may be reused from one chunk to the next.
+ *
+ * @param[in,out] receiver                The receiver module.
+ * @param[in]     chunk                   The next bytes of the FPDU.
+ * @param[in]     chunk_length            The size of the chunk, at most the rest of the FPDU.
+ * @param[in,out] sdus                    The SDUs array to extract from the chunk, preallocated.
+ * @param[in]     sdus_max_nr             The SDUs array size, max number of extractable SDUs.
+ * @param[out]    sdus_nr                 The current number of SDUs in the SDUs array.
+ *
+ * @return        decapsulation status. If the SDUs array is full, the rest of the FPDU is
+ *                dropped and RLE_DECAP_ERR_SOME_DROP is returned. Once the payload label is
+ *                received, RLE_DECAP_FILTERED is returned for the rest of a FPDU addressed to
+ *                another terminal.
+ *
+ * @ingroup       RLE receiver
+ */
+enum rle_decap_status rle_decap_stream_push(struct rle_receiver *const receiver,
+                                            unsigned char *const chunk,
+                                            const size_t chunk_length,
+                                            struct rle_sdu sdus[],
+                                            const size_t sdus_max_nr,
+                                            size_t *const sdus_nr)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief End the decapsulation of a FPDU received by chunks
+ *
+ * If the FPDU is not fully received, the PPDU carried over is lost and RLE_DECAP_ERR_INV_FPDU is
+ * returned.
+ *
+ * @param[in,out] receiver                The receiver module.
+ * @param[in,out] payload_label           The identifier of the RCST, preallocated.
+ * @param[in]     payload_label_size      The size of the paylod label, as given at the start.
+ *
+ * @return        decapsulation status.
+ *
+ * @ingroup       RLE receiver
+ */
+enum rle_decap_status rle_decap_stream_end(struct rle_receiver *const receiver,
+                                           unsigned char *const payload_label,
+                                           const size_t payload_label_size)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Get occupied size of a queue (frag_id) in an RLE transmitter module.
+ *
+ * @param[in]     transmitter             The transmitter module. Must be initialize.
+ * @param[in]     fragment_id             Fragment id to use. Must be valid.
+ *
+ * @return        Number of octets present in a queue.
+ *
+ * @ingroup       RLE transmitter statistics
  */
 size_t rle_transmitter_stats_get_queue_size(const struct rle_transmitter *const transmitter,
                                             const uint8_t fragment_id)
@@ -710,6 +1629,38 @@ uint64_t rle_transmitter_stats_get_counter_bytes_dropped(const struct rle_transm
                                                          const uint8_t fragment_id)
 __attribute__((warn_unused_result));
 
+/**
+ * @brief         Get total number of SDUs of an RLE transmitter queue dropped once expired.
+ *
+ *                These SDUs are also counted in the dropped SDUs.
+ *
+ * @param[in]     trans              The transmitter module. Must be initialize.
+ * @param[in]     fragment_id        The fragment id of the queue.
+ *
+ * @return        Number of expired SDUs.
+ *
+ * @ingroup       RLE transmitter statistics
+ */
+uint64_t rle_transmitter_stats_get_counter_sdus_expired(const struct rle_transmitter *const trans,
+                                                        const uint8_t fragment_id)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Get total number of octets of an RLE transmitter queue dropped once expired.
+ *
+ *                These octets are also counted in the dropped octets.
+ *
+ * @param[in]     trans              The transmitter module. Must be initialize.
+ * @param[in]     fragment_id        The fragment id of the queue.
+ *
+ * @return        Number of expired octets.
+ *
+ * @ingroup       RLE transmitter statistics
+ */
+uint64_t rle_transmitter_stats_get_counter_bytes_expired(const struct rle_transmitter *const trans,
+                                                         const uint8_t fragment_id)
+__attribute__((warn_unused_result));
+
 /**
  * @brief         Dump all the statistics of a given RLE transmitter queue in an RLE stats
  *                structure.
@@ -738,6 +1689,50 @@ __attribute__((warn_unused_result));
 void rle_transmitter_stats_reset_counters(struct rle_transmitter *const transmitter,
                                           const uint8_t fragment_id);
 
+/**
+ * @brief         Account one FPDU sent in the link efficiency statistics of a transmitter.
+ *
+ *                \ref rle_pack and \ref rle_pad know no transmitter: call this function once
+ *                per FPDU filled with the PPDUs of the transmitter, with the position and the
+ *                remaining size left by the packing.
+ *
+ * @param[in,out] transmitter              The transmitter module.
+ * @param[in]     label_size               The size of the payload label of the FPDU.
+ * @param[in]     fpdu_current_pos         The current position in the FPDU.
+ * @param[in]     fpdu_remaining_size      The remaining size in the FPDU, padded.
+ *
+ * @ingroup       RLE transmitter statistics
+ */
+void rle_transmitter_stats_add_fpdu(struct rle_transmitter *const transmitter,
+                                    const size_t label_size,
+                                    const size_t fpdu_current_pos,
+                                    const size_t fpdu_remaining_size);
+
+/**
+ * @brief         Dump the link efficiency statistics of a transmitter: the octets of PPDU
+ *                headers, ALPDU headers, trailers, labels and padding, the PPDUs per type and the
+ *                histogram of the PPDUs per SDU, per context and in total.
+ *
+ * @param[in]     transmitter              The transmitter module.
+ * @param[out]    stats                    The link efficiency statistics.
+ *
+ * @return        0 if OK, else 1.
+ *
+ * @ingroup       RLE transmitter statistics
+ */
+int rle_transmitter_stats_get_link(const struct rle_transmitter *const transmitter,
+                                   struct rle_link_stats *const stats)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Reset the link efficiency statistics of a transmitter.
+ *
+ * @param[in,out] transmitter              The transmitter module.
+ *
+ * @ingroup       RLE transmitter statistics
+ */
+void rle_transmitter_stats_reset_link(struct rle_transmitter *const transmitter);
+
 /**
  * @brief         Get occupied size of a queue (frag_id) in a RLE receiver queue.
  *
@@ -888,51 +1883,600 @@ void rle_receiver_stats_reset_counters(struct rle_receiver *const receiver,
                                        const uint8_t fragment_id);
 
 /**
- * @brief       RLE header decompression of protocol type function.
+ * @brief         Get the number of errors of a given type detected by an RLE receiver.
  *
- * @param[in]   compressed_ptype                A compressed protocol type to uncompress.
+ * @param[in]     receiver                 The receiver module. Must be initialize.
+ * @param[in]     type                     The type of error.
  *
- * @return      The uncompressed protocol type.
+ * @return        The number of errors.
  *
- * @ingroup     RLE header
+ * @ingroup       RLE receiver statistics
  */
-uint16_t rle_header_ptype_decompression(const uint8_t compressed_ptype)
-__attribute__((warn_unused_result));
+uint64_t rle_receiver_stats_get_counter_errors(const struct rle_receiver *const receiver,
+                                               const enum rle_decap_error_type type);
 
 /**
- * @brief       RLE header check if protocol type is compressible function.
+ * @brief         Dump the error statistics of an RLE receiver in an RLE error stats structure.
  *
- * @param[in]   uncompressed_ptype  An uncompressed protocol type to compress.
+ * @param[in]     receiver                 The receiver module. Must be initialize.
+ * @param[out]    stats                    The RLE error stats structure.
  *
- * @return      0 if the protocol type is compressible else 1.
+ * @return        0 if OK, else 1.
  *
- * @ingroup     RLE header
+ * @ingroup       RLE receiver statistics
  */
-int rle_header_ptype_is_compressible(uint16_t uncompressed_ptype)
+int rle_receiver_stats_get_errors(const struct rle_receiver *const receiver,
+                                  struct rle_receiver_error_stats *const stats)
 __attribute__((warn_unused_result));
 
 /**
- * @brief       RLE header compression of protocol type function.
+ * @brief         Reset the error statistics of an RLE receiver.
  *
- * @param[in]   uncompressed_ptype  An uncompressed protocol type to compress.
- * @param[in]   frag_buf            The SDU to encapsulate
- *
- * @return      The compressed protocol type.
+ * @param[in,out] receiver                 The receiver module. Must be initialize.
  *
- * @ingroup     RLE header
+ * @ingroup       RLE receiver statistics
  */
-uint8_t rle_header_ptype_compression(const uint16_t uncompressed_ptype,
-                                     const struct rle_frag_buf *const frag_buf)
-__attribute__((warn_unused_result, nonnull(2)));
+void rle_receiver_stats_reset_errors(struct rle_receiver *const receiver);
 
 /**
- * @brief         Get the size of an RLE headers overhead (ALPDU + PPDU + FPDU headers).
- *                Those header sizes are known only for signal fpdus, and traffic-control fpdus.
+ * @brief         Get the number of FPDUs dropped by the payload label filter of an RLE receiver.
  *
- * @param[in]     conf               The rle module configuration (unused for the
- *                                   moment, may be used for evolution or adaption
- *                                   of RLE)
- * @param[in]     fpdu_type          The type of the FPDU.
+ * @param[in]     receiver                 The receiver module. Must be initialize.
+ *
+ * @return        The number of FPDUs filtered.
+ *
+ * @ingroup       RLE receiver statistics
+ */
+uint64_t rle_receiver_stats_get_counter_fpdus_filtered(const struct rle_receiver *const receiver);
+
+/**
+ * @brief         Accept a payload label, or a set of labels, in an RLE receiver.
+ *
+ *                Once a label is accepted, the FPDUs whose payload label matches none of the
+ *                accepted ones are dropped by the decapsulation before any of their PPDUs is
+ *                parsed, with the RLE_DECAP_FILTERED status. FPDUs without payload label are
+ *                always decapsulated. A label matches if its bits selected by @p mask are
+ *                equal to the ones of @p label.
+ *
+ * @param[in,out] receiver                 The receiver module. Must be initialize.
+ * @param[in]     label                    The payload label to accept.
+ * @param[in]     mask                     The bits of the label to compare, NULL for all.
+ * @param[in]     label_size               The size of the label and the mask, 3 or 6.
+ *
+ * @return        0 if OK, else 1 (invalid label or RLE_LABEL_FILTER_MAX labels already).
+ *
+ * @ingroup       RLE receiver
+ */
+int rle_receiver_label_filter_add(struct rle_receiver *const receiver,
+                                  const unsigned char *const label,
+                                  const unsigned char *const mask,
+                                  const size_t label_size)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Remove the accepted payload labels of an RLE receiver, to accept all FPDUs.
+ *
+ * @param[in,out] receiver                 The receiver module. Must be initialize.
+ *
+ * @ingroup       RLE receiver
+ */
+void rle_receiver_label_filter_clear(struct rle_receiver *const receiver);
+
+/**
+ * @brief         Limit the rate of the error traces of an RLE receiver.
+ *
+ *                Every error is counted, but its textual trace is only formatted if a token is
+ *                available in a bucket of @p burst tokens refilled at @p rate tokens per second.
+ *                The defaults are RLE_ERROR_TRACE_RATE_DEFAULT and RLE_ERROR_TRACE_BURST_DEFAULT.
+ *
+ * @param[in,out] receiver                 The receiver module. Must be initialize.
+ * @param[in]     rate                     The traces per second, 0 for no limit.
+ * @param[in]     burst                    The max number of traces in a burst.
+ *
+ * @ingroup       RLE receiver statistics
+ */
+void rle_receiver_set_error_trace_rate(struct rle_receiver *const receiver,
+                                       const uint32_t rate,
+                                       const uint32_t burst);
+
+/**
+ * @brief         Start recording the latency histograms of an RLE transmitter.
+ *
+ *                The histograms are allocated on first activation and kept until the
+ *                transmitter is destroyed. When disabled, each instrumented stage only costs
+ *                one test. Durations are sampled with a raw monotonic clock.
+ *
+ * @param[in,out] transmitter              The transmitter module. Must be initialize.
+ *
+ * @return        0 if OK, else 1.
+ *
+ * @ingroup       RLE transmitter statistics
+ */
+int rle_transmitter_latency_enable(struct rle_transmitter *const transmitter)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Stop recording the latency histograms of an RLE transmitter.
+ *
+ *                The already recorded values are kept and may still be read.
+ *
+ * @param[in,out] transmitter              The transmitter module. Must be initialize.
+ *
+ * @ingroup       RLE transmitter statistics
+ */
+void rle_transmitter_latency_disable(struct rle_transmitter *const transmitter);
+
+/**
+ * @brief         Snapshot a latency histogram of an RLE transmitter.
+ *
+ * @param[in]     transmitter              The transmitter module. Must be initialize.
+ * @param[in]     stage                    The stage. Only RLE_LATENCY_STAGE_ENCAP is recorded
+ *                                         by transmitters.
+ * @param[in]     fragment_id              The fragment id of the queue, or
+ *                                         RLE_LATENCY_ALL_CTX for all the queues.
+ * @param[out]    histo                    The snapshot of the histogram.
+ *
+ * @return        0 if OK, else 1 (invalid parameter or latency never enabled).
+ *
+ * @ingroup       RLE transmitter statistics
+ */
+int rle_transmitter_latency_get_histo(const struct rle_transmitter *const transmitter,
+                                      const enum rle_latency_stage stage,
+                                      const uint8_t fragment_id,
+                                      struct rle_latency_histo *const histo)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Reset all the latency histograms of an RLE transmitter.
+ *
+ * @param[in,out] transmitter              The transmitter module. Must be initialize.
+ *
+ * @ingroup       RLE transmitter statistics
+ */
+void rle_transmitter_latency_reset(struct rle_transmitter *const transmitter);
+
+/**
+ * @brief         Start recording the latency histograms of an RLE receiver.
+ *
+ *                The histograms are allocated on first activation and kept until the
+ *                receiver is destroyed. When disabled, each instrumented stage only costs
+ *                one test. Durations are sampled with a raw monotonic clock.
+ *
+ * @param[in,out] receiver                 The receiver module. Must be initialize.
+ *
+ * @return        0 if OK, else 1.
+ *
+ * @ingroup       RLE receiver statistics
+ */
+int rle_receiver_latency_enable(struct rle_receiver *const receiver)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Stop recording the latency histograms of an RLE receiver.
+ *
+ *                The already recorded values are kept and may still be read.
+ *
+ * @param[in,out] receiver                 The receiver module. Must be initialize.
+ *
+ * @ingroup       RLE receiver statistics
+ */
+void rle_receiver_latency_disable(struct rle_receiver *const receiver);
+
+/**
+ * @brief         Snapshot a latency histogram of an RLE receiver.
+ *
+ *                Complete PPDUs do not belong to any context, they are only accounted in the
+ *                RLE_LATENCY_ALL_CTX histograms.
+ *
+ * @param[in]     receiver                 The receiver module. Must be initialize.
+ * @param[in]     stage                    The stage.
+ * @param[in]     fragment_id              The fragment id of the queue, or
+ *                                         RLE_LATENCY_ALL_CTX for all the queues.
+ * @param[out]    histo                    The snapshot of the histogram.
+ *
+ * @return        0 if OK, else 1 (invalid parameter or latency never enabled).
+ *
+ * @ingroup       RLE receiver statistics
+ */
+int rle_receiver_latency_get_histo(const struct rle_receiver *const receiver,
+                                   const enum rle_latency_stage stage,
+                                   const uint8_t fragment_id,
+                                   struct rle_latency_histo *const histo)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Reset all the latency histograms of an RLE receiver.
+ *
+ * @param[in,out] receiver                 The receiver module. Must be initialize.
+ *
+ * @ingroup       RLE receiver statistics
+ */
+void rle_receiver_latency_reset(struct rle_receiver *const receiver);
+
+/**
+ * @brief         Get the lowest duration accounted in a latency histogram bucket.
+ *
+ * @param[in]     bucket                   The index of the bucket.
+ *
+ * @return        The lowest duration of the bucket, in nanoseconds.
+ *
+ * @ingroup       RLE statistics
+ */
+uint64_t rle_latency_histo_get_bucket_min(const size_t bucket)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Get a percentile of a latency histogram.
+ *
+ * @param[in]     histo                    The histogram.
+ * @param[in]     basis_points             The percentile in hundredths of percent, for
+ *                                         instance 9990 for the 99.9th percentile.
+ *
+ * @return        The highest duration of the bucket holding the percentile, bounded by the
+ *                longest recorded duration, in nanoseconds. 0 if the histogram is empty.
+ *
+ * @ingroup       RLE statistics
+ */
+uint64_t rle_latency_histo_get_percentile(const struct rle_latency_histo *const histo,
+                                          const uint32_t basis_points)
+__attribute__((warn_unused_result, nonnull(1)));
+
+/**
+ * @brief         Get the size of the checkpoint of an RLE transmitter in its current state.
+ *
+ *                The size grows with the octets of the ALPDUs not sent yet, it shall be
+ *                computed again after any encapsulation or fragmentation.
+ *
+ * @param[in]     transmitter              The transmitter module.
+ *
+ * @return        The size of the checkpoint, 0 if the transmitter is NULL.
+ *
+ * @ingroup       RLE transmitter checkpoint
+ */
+size_t rle_transmitter_checkpoint_size(const struct rle_transmitter *const transmitter)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Checkpoint the state of an RLE transmitter.
+ *
+ *                The checkpoint holds the contexts in use, the sequence numbers, the octets of
+ *                the ALPDUs not sent yet, the scheduler state and the counters, so that a
+ *                standby transmitter restored with \ref rle_transmitter_restore goes on with
+ *                the next PPDU of each context. The SDUs encapsulated in place are copied in
+ *                the checkpoint, the standby does not need their buffers. The configurations,
+ *                the trace callbacks and the latency histograms are not part of the
+ *                checkpoint. The format is for the same build of the library only.
+ *
+ * @param[in]     transmitter              The transmitter module.
+ * @param[out]    buf                      The checkpoint.
+ * @param[in]     len                      The size of buf.
+ * @param[out]    written                  The size of the checkpoint.
+ *
+ * @return        0 if OK, else 1, for instance if buf is too small.
+ *
+ * @ingroup       RLE transmitter checkpoint
+ */
+int rle_transmitter_checkpoint(const struct rle_transmitter *const transmitter,
+                               unsigned char *const buf,
+                               const size_t len,
+                               size_t *const written)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Restore the state of an RLE transmitter from a checkpoint.
+ *
+ *                The transmitter shall have the configuration of the checkpointed one. The
+ *                checkpoint is checked as a whole before the transmitter is modified: in case
+ *                of failure, the transmitter is left unchanged.
+ *
+ * @param[in,out] transmitter              The transmitter module.
+ * @param[in]     buf                      The checkpoint, possibly followed by other data.
+ * @param[in]     len                      The size of buf.
+ * @param[out]    used                     The size of the checkpoint. May be NULL.
+ *
+ * @return        0 if OK, else 1.
+ *
+ * @ingroup       RLE transmitter checkpoint
+ */
+int rle_transmitter_restore(struct rle_transmitter *const transmitter,
+                            const unsigned char *const buf,
+                            const size_t len,
+                            size_t *const used)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Get the size of the checkpoint of an RLE receiver in its current state.
+ *
+ *                The size grows with the octets of the SDUs partially reassembled, it shall be
+ *                computed again after any decapsulation.
+ *
+ * @param[in]     receiver                 The receiver module.
+ *
+ * @return        The size of the checkpoint, 0 if the receiver is NULL.
+ *
+ * @ingroup       RLE receiver checkpoint
+ */
+size_t rle_receiver_checkpoint_size(const struct rle_receiver *const receiver)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Checkpoint the state of an RLE receiver.
+ *
+ *                The checkpoint holds the contexts in use, the sequence numbers and whether
+ *                they are known yet, the octets of the SDUs partially reassembled, the FPDU
+ *                decapsulated by chunks and the counters, see \ref rle_transmitter_checkpoint.
+ *                The checkpoint of an idle receiver is about 130 octets, plus 72 octets per
+ *                context that was ever used.
+ *
+ * @param[in]     receiver                 The receiver module.
+ * @param[out]    buf                      The checkpoint.
+ * @param[in]     len                      The size of buf.
+ * @param[out]    written                  The size of the checkpoint.
+ *
+ * @return        0 if OK, else 1, for instance if buf is too small.
+ *
+ * @ingroup       RLE receiver checkpoint
+ */
+int rle_receiver_checkpoint(const struct rle_receiver *const receiver,
+                            unsigned char *const buf,
+                            const size_t len,
+                            size_t *const written)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Restore the state of an RLE receiver from a checkpoint.
+ *
+ *                See \ref rle_transmitter_restore.
+ *
+ * @param[in,out] receiver                 The receiver module.
+ * @param[in]     buf                      The checkpoint, possibly followed by other data.
+ * @param[in]     len                      The size of buf.
+ * @param[out]    used                     The size of the checkpoint. May be NULL.
+ *
+ * @return        0 if OK, else 1.
+ *
+ * @ingroup       RLE receiver checkpoint
+ */
+int rle_receiver_restore(struct rle_receiver *const receiver,
+                         const unsigned char *const buf,
+                         const size_t len,
+                         size_t *const used)
+__attribute__((warn_unused_result));
+
+#ifndef __KERNEL__
+
+/**
+ * @brief         Create a shared-memory statistics region to publish counters into.
+ *
+ *                The region is a POSIX shared-memory object that external monitoring
+ *                processes may map with \ref rle_stats_shm_attach. Counters are only
+ *                published when \ref rle_stats_shm_publish_transmitter or
+ *                \ref rle_stats_shm_publish_receiver is called, for instance once per burst.
+ *                The object may be read by the user and the group of the process only, the
+ *                caller widens its mode if other users monitor it.
+ *
+ * @param[in]     name                     The name of the shared-memory object, "/rle" for
+ *                                         instance.
+ *
+ * @return        The region handle if OK, else NULL.
+ *
+ * @ingroup       RLE statistics
+ */
+struct rle_stats_shm * rle_stats_shm_create(const char *const name)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Map an existing shared-memory statistics region in read-only mode.
+ *
+ * @param[in]     name                     The name of the shared-memory object.
+ *
+ * @return        The region handle if OK, else NULL (missing region, or incompatible
+ *                version).
+ *
+ * @ingroup       RLE statistics
+ */
+struct rle_stats_shm * rle_stats_shm_attach(const char *const name)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Unmap a shared-memory statistics region. The shared-memory object is removed
+ *                if it was created with \ref rle_stats_shm_create.
+ *
+ * @param[in,out] shm                      The region handle, set to NULL. May point to NULL.
+ *
+ * @ingroup       RLE statistics
+ */
+void rle_stats_shm_destroy(struct rle_stats_shm **const shm);
+
+/**
+ * @brief         Publish all the counters of a transmitter in a shared-memory region.
+ *
+ * @param[in,out] shm                      The region handle, from \ref rle_stats_shm_create.
+ * @param[in]     transmitter              The transmitter module. Must be initialize.
+ *
+ * @return        0 if OK, else 1.
+ *
+ * @ingroup       RLE statistics
+ */
+int rle_stats_shm_publish_transmitter(struct rle_stats_shm *const shm,
+                                      const struct rle_transmitter *const transmitter);
+
+/**
+ * @brief         Publish all the counters of a receiver in a shared-memory region.
+ *
+ * @param[in,out] shm                      The region handle, from \ref rle_stats_shm_create.
+ * @param[in]     receiver                 The receiver module. Must be initialize.
+ *
+ * @return        0 if OK, else 1.
+ *
+ * @ingroup       RLE statistics
+ */
+int rle_stats_shm_publish_receiver(struct rle_stats_shm *const shm,
+                                   const struct rle_receiver *const receiver);
+
+/**
+ * @brief         Read a consistent snapshot of a shared-memory statistics region.
+ *
+ *                The call never blocks the publishing process, it retries while an update is
+ *                in progress. It gives up if the update never completes, for instance if the
+ *                publishing process died in the middle of it.
+ *
+ * @param[in]     shm                      The region handle.
+ * @param[out]    snapshot                 The snapshot of the counters.
+ *
+ * @return        0 if OK, else 1 (no update completed after many retries).
+ *
+ * @ingroup       RLE statistics
+ */
+int rle_stats_shm_read(const struct rle_stats_shm *const shm,
+                       struct rle_stats_shm_snapshot *const snapshot)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Create a FPDU trace, or truncate an existing one.
+ *
+ *                The records are gathered in a large buffer and written with one write(2)
+ *                per megabyte. The trace is complete once closed with
+ *                \ref rle_fpdu_trace_writer_close.
+ *
+ * @param[in]     path                     The path of the trace.
+ *
+ * @return        The writer if OK, else NULL.
+ *
+ * @ingroup       RLE trace
+ */
+struct rle_fpdu_trace_writer * rle_fpdu_trace_writer_open(const char *const path)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Append a FPDU to a trace.
+ *
+ * @param[in,out] writer                   The writer.
+ * @param[in]     record                   The record, its fpdu_len octets of FPDU are written.
+ * @param[in]     fpdu                     The FPDU, Payload Label included.
+ *
+ * @return        0 if OK, else 1.
+ *
+ * @ingroup       RLE trace
+ */
+int rle_fpdu_trace_write(struct rle_fpdu_trace_writer *const writer,
+                         const struct rle_fpdu_trace_record *const record,
+                         const unsigned char *const fpdu)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Complete a FPDU trace with its index, then close it.
+ *
+ * @param[in,out] writer                   The writer, set to NULL.
+ *
+ * @return        0 if OK, else 1. The writer is released in both cases.
+ *
+ * @ingroup       RLE trace
+ */
+int rle_fpdu_trace_writer_close(struct rle_fpdu_trace_writer **const writer);
+
+/**
+ * @brief         Map a FPDU trace in memory.
+ *
+ *                The records are checked once, then read in place: they are never copied nor
+ *                allocated. The mapping is private, so that the FPDUs may be given to
+ *                \ref rle_decapsulate. A trace without index, not completed, is scanned and
+ *                its last truncated record ignored.
+ *
+ * @param[in]     path                     The path of the trace.
+ *
+ * @return        The trace if OK, else NULL.
+ *
+ * @ingroup       RLE trace
+ */
+struct rle_fpdu_trace * rle_fpdu_trace_open(const char *const path)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Get the number of records of a FPDU trace.
+ *
+ * @param[in]     trace                    The trace.
+ *
+ * @return        The number of records.
+ *
+ * @ingroup       RLE trace
+ */
+size_t rle_fpdu_trace_count(const struct rle_fpdu_trace *const trace)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief         Get a record of a FPDU trace.
+ *
+ * @param[in]     trace                    The trace.
+ * @param[in]     index                    The index of the record, less than
+ *                                         \ref rle_fpdu_trace_count.
+ * @param[out]    fpdu                     The FPDU of the record, in the mapping.
+ *
+ * @return        The record, in the mapping.
+ *
+ * @ingroup       RLE trace
+ */
+const struct rle_fpdu_trace_record * rle_fpdu_trace_get(const struct rle_fpdu_trace *const trace,
+                                                        const size_t index,
+                                                        unsigned char **const fpdu);
+
+/**
+ * @brief         Unmap a FPDU trace.
+ *
+ * @param[in,out] trace                    The trace, set to NULL. May point to NULL.
+ *
+ * @ingroup       RLE trace
+ */
+void rle_fpdu_trace_close(struct rle_fpdu_trace **const trace);
+
+#endif /* !__KERNEL__ */
+
+/**
+ * @brief       RLE header decompression of protocol type function.
+ *
+ * @param[in]   compressed_ptype                A compressed protocol type to uncompress.
+ *
+ * @return      The uncompressed protocol type.
+ *
+ * @ingroup     RLE header
+ */
+uint16_t rle_header_ptype_decompression(const uint8_t compressed_ptype)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief       RLE header check if protocol type is compressible function.
+ *
+ * @param[in]   uncompressed_ptype  An uncompressed protocol type to compress.
+ *
+ * @return      0 if the protocol type is compressible else 1.
+ *
+ * @ingroup     RLE header
+ */
+int rle_header_ptype_is_compressible(uint16_t uncompressed_ptype)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief       RLE header compression of protocol type function.
+ *
+ * @param[in]   uncompressed_ptype  An uncompressed protocol type to compress.
+ * @param[in]   frag_buf            The SDU to encapsulate
+ *
+ * @return      The compressed protocol type.
+ *
+ * @ingroup     RLE header
+ */
+uint8_t rle_header_ptype_compression(const uint16_t uncompressed_ptype,
+                                     const struct rle_frag_buf *const frag_buf)
+__attribute__((warn_unused_result, nonnull(2)));
+
+/**
+ * @brief         Get the size of an RLE headers overhead (ALPDU + PPDU + FPDU headers).
+ *                Those header sizes are known only for signal fpdus, and traffic-control fpdus.
+ *
+ * @param[in]     conf               The rle module configuration (unused for the
+ *                                   moment, may be used for evolution or adaption
+ *                                   of RLE)
+ * @param[in]     fpdu_type          The type of the FPDU.
  * @param[out]    rle_header_size    The size of the RLE header in octets.
  *
  * @return        RLE_HEADER_SIZE_OK if size is calculated,
@@ -973,7 +2517,12 @@ typedef enum {
 	RLE_MOD_ID_CTX = 9,
 	RLE_MOD_ID_RECEIVER = 10,
 	RLE_MOD_ID_TRANSMITTER = 11,
-	RLE_MOD_ID_TRAILER = 12
+	RLE_MOD_ID_TRAILER = 12,
+	RLE_MOD_ID_STATS_SHM = 13,
+	RLE_MOD_ID_ALLOC = 14,
+	RLE_MOD_ID_SCHED = 15,
+	RLE_MOD_ID_FPDU_TRACE = 16,
+	RLE_MOD_ID_CHECKPOINT = 17
 } rle_mod_id_t;
 
 
@@ -1024,4 +2573,191 @@ void rle_set_trace_callback(rle_trace_callback_t callback);
  */
 rle_trace_callback_t rle_get_trace_callback(void);
 
+/**
+ * @brief Callback function registered on a transmitter or a receiver to handle its logs
+ * @param priv the private data given at registration, to identify the instance for example
+ * @param module_id the rle internal module id
+ * @param level the log level requested (DEBUG, WARNING, etc.)
+ * @param file the filename in librle in which the log was requested
+ * @param line the line at which the log was requested in librle
+ * @param func the function in librle in which the log was requested
+ * @param fmt the string which contains the format of the message
+ * @param ... the additional parameters used to format the message
+ */
+typedef void (*rle_instance_trace_callback_t) (void *const priv,
+                                               const int module_id,
+                                               const int level,
+                                               const char *const file,
+                                               const int line,
+                                               const char *const func,
+                                               const char *const message,
+                                               ...);
+
+/**
+ * @brief register the log trace callback of a transmitter
+ *
+ * The traces of the transmitter go to this callback instead of the global one, if their level
+ * is at least as severe as the given one. Traces less severe than the build level
+ * (RLE_LOG_LEVEL_BUILD) are never emitted.
+ *
+ * @param transmitter the transmitter
+ * @param callback the callback to register, NULL to use the global one again
+ * @param priv private data given to the callback
+ * @param level the least severe level given to the callback
+ */
+void rle_transmitter_set_trace_callback(struct rle_transmitter *const transmitter,
+                                        rle_instance_trace_callback_t callback,
+                                        void *const priv,
+                                        const rle_log_level_t level);
+
+/**
+ * @brief change the runtime log level of a transmitter callback
+ * @param transmitter the transmitter
+ * @param level the least severe level given to the callback
+ */
+void rle_transmitter_set_trace_level(struct rle_transmitter *const transmitter,
+                                     const rle_log_level_t level);
+
+/**
+ * @brief register the log trace callback of a receiver
+ *
+ * The traces of the receiver go to this callback instead of the global one, if their level
+ * is at least as severe as the given one. Traces less severe than the build level
+ * (RLE_LOG_LEVEL_BUILD) are never emitted.
+ *
+ * @param receiver the receiver
+ * @param callback the callback to register, NULL to use the global one again
+ * @param priv private data given to the callback
+ * @param level the least severe level given to the callback
+ */
+void rle_receiver_set_trace_callback(struct rle_receiver *const receiver,
+                                     rle_instance_trace_callback_t callback,
+                                     void *const priv,
+                                     const rle_log_level_t level);
+
+/**
+ * @brief change the runtime log level of a receiver callback
+ * @param receiver the receiver
+ * @param level the least severe level given to the callback
+ */
+void rle_receiver_set_trace_level(struct rle_receiver *const receiver,
+                                  const rle_log_level_t level);
+
+/**
+ * @brief register the memory allocator of the library
+ *
+ * The allocator is copied. It shall be registered before the creation of any transmitter or
+ * receiver, and not be changed while one exists: the memory is released with the allocator that
+ * is registered at that time.
+ *
+ * @param allocator the allocator, NULL to use the default one (malloc and free, or kmalloc and
+ *                  kfree in the kernel)
+ */
+void rle_set_allocator(const struct rle_allocator *const allocator);
+
+/**
+ * @brief start counting the allocations and the bulk zeroings of the library
+ *
+ * Counting is global to the library and costs one atomic addition per allocation or zeroing.
+ * The steady-state processing of the SDUs and FPDUs is expected not to allocate at all.
+ */
+void rle_alloc_audit_enable(void);
+
+/**
+ * @brief stop counting the allocations and the bulk zeroings of the library
+ */
+void rle_alloc_audit_disable(void);
+
+/**
+ * @brief snapshot the counters of the allocation and zeroing audit mode
+ * @param audit the snapshot
+ */
+void rle_alloc_audit_get(struct rle_alloc_audit *const audit);
+
+/**
+ * @brief reset the counters of the allocation and zeroing audit mode
+ */
+void rle_alloc_audit_reset(void);
+
+#ifdef __KERNEL__
+
+/** A transmitter and a receiver of a CPU, see \ref rle_percpu_new */
+struct rle_percpu_instance {
+	struct rle_transmitter *transmitter; /**< The transmitter of the CPU */
+	struct rle_receiver *receiver;       /**< The receiver of the CPU    */
+};
+
+/** Transmitters and receivers, one of each per possible CPU */
+struct rle_percpu;
+
+/**
+ * @brief get the allocator of the kernel module, backed by slab caches
+ *
+ * The fragmentation buffers, the reassembly buffers, the transmitters and the receivers are
+ * allocated from dedicated kmem caches sized for them, instead of being rounded up to the next
+ * power of two by kmalloc. The other allocations fall back to kvmalloc. Without the caches
+ * (before Linux 6.4, or with the module parameter kmem_caches=0), every allocation falls back.
+ *
+ * @param allocator the allocator, to give to \ref rle_transmitter_new_with_allocator or
+ *                  \ref rle_receiver_new_with_allocator
+ * @param node      the NUMA node to allocate on, RLE_NUMA_NODE_ANY for any
+ */
+void rle_kmem_allocator_get(struct rle_allocator *const allocator, const int node);
+
+/**
+ * @brief get the memory an allocation takes with the allocator of the kernel module
+ *
+ * @param size the octets requested
+ * @return the octets taken by the allocation, slab object rounding included
+ */
+size_t rle_kmem_footprint(const size_t size);
+
+/**
+ * @brief create a transmitter and a receiver per possible CPU
+ *
+ * The instances of a CPU are allocated on its NUMA node with \ref rle_kmem_allocator_get, so
+ * that the softirq paths on different CPUs never share a transmitter or a receiver, nor its
+ * cache lines. The fragments of one context shall all be steered to the same CPU, as the
+ * reassembly contexts are per receiver.
+ *
+ * @param conf the configuration of the instances
+ * @return the instances if OK, else NULL
+ */
+struct rle_percpu * rle_percpu_new(const struct rle_config *const conf)
+__attribute__((warn_unused_result));
+
+/**
+ * @brief destroy the transmitters and the receivers of all the CPUs
+ *
+ * @param percpu the instances, set to NULL
+ */
+void rle_percpu_destroy(struct rle_percpu **const percpu);
+
+/**
+ * @brief get the transmitter and the receiver of the current CPU
+ *
+ * The caller shall not be preempted while it uses them: call from softirq context, or between
+ * local_bh_disable() and local_bh_enable().
+ *
+ * @param percpu the instances
+ * @return the instances of the current CPU
+ */
+struct rle_percpu_instance * rle_percpu_get(struct rle_percpu *const percpu);
+
+/**
+ * @brief get the transmitter and the receiver of a CPU, for instance to read their counters
+ *
+ * @param percpu the instances
+ * @param cpu    a possible CPU
+ * @return the instances of the CPU
+ */
+struct rle_percpu_instance * rle_percpu_get_on(struct rle_percpu *const percpu,
+                                               const unsigned int cpu);
+
+#endif /* __KERNEL__ */
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* __RLE_H__ */
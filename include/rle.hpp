@@ -0,0 +1,510 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   rle.hpp
+ * @brief  C++20 interface file for the librle library.
+ *
+ *         Header only wrapper of rle.h: move-only owners of the transmitters and receivers,
+ *         spans instead of pointer and length pairs, iterable decapsulated SDUs, and a
+ *         configuration known at compile time. The configuration is checked by the compiler and
+ *         the payload label handling is chosen at compile time, so that no call checks it again
+ *         at runtime.
+ *
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#ifndef __RLE_HPP__
+#define __RLE_HPP__
+
+#include "rle.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+
+namespace rle
+{
+
+/*------------------------------------------------------------------------------------------------*/
+/*---------------------------------- PUBLIC CONSTANTS AND TYPES ----------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** Max size of a decapsulated SDU, a VLAN header may get its protocol type back */
+inline constexpr std::size_t max_sdu_size = RLE_MAX_PDU_SIZE + sizeof(std::uint16_t);
+
+/** Number of fragmentation and reassembly contexts */
+inline constexpr std::size_t frag_ids_nr = RLE_MAX_FRAG_NUMBER;
+
+/** Status of the encapsulation */
+enum class encap_status {
+	ok = RLE_ENCAP_OK,
+	err = RLE_ENCAP_ERR,
+	err_null_trmt = RLE_ENCAP_ERR_NULL_TRMT,
+	err_null_f_buff = RLE_ENCAP_ERR_NULL_F_BUFF,
+	err_n_init_f_buff = RLE_ENCAP_ERR_N_INIT_F_BUFF,
+	err_sdu_too_big = RLE_ENCAP_ERR_SDU_TOO_BIG,
+};
+
+/** Status of the fragmentation */
+enum class frag_status {
+	ok = RLE_FRAG_OK,
+	err = RLE_FRAG_ERR,
+	err_null_trmt = RLE_FRAG_ERR_NULL_TRMT,
+	err_null_f_buff = RLE_FRAG_ERR_NULL_F_BUFF,
+	err_n_init_f_buff = RLE_FRAG_ERR_N_INIT_F_BUFF,
+	err_burst_too_small = RLE_FRAG_ERR_BURST_TOO_SMALL,
+	err_context_is_null = RLE_FRAG_ERR_CONTEXT_IS_NULL,
+	err_invalid_size = RLE_FRAG_ERR_INVALID_SIZE,
+};
+
+/** Status of the frame packing */
+enum class pack_status {
+	ok = RLE_PACK_OK,
+	err = RLE_PACK_ERR,
+	err_fpdu_too_small = RLE_PACK_ERR_FPDU_TOO_SMALL,
+	err_invalid_ppdu = RLE_PACK_ERR_INVALID_PPDU,
+	err_invalid_lab = RLE_PACK_ERR_INVALID_LAB,
+	err_iov_full = RLE_PACK_ERR_IOV_FULL,
+};
+
+/** Status of the decapsulation */
+enum class decap_status {
+	ok = RLE_DECAP_OK,
+	err = RLE_DECAP_ERR,
+	err_null_rcvr = RLE_DECAP_ERR_NULL_RCVR,
+	err_all_drop = RLE_DECAP_ERR_ALL_DROP,
+	err_some_drop = RLE_DECAP_ERR_SOME_DROP,
+	err_inv_fpdu = RLE_DECAP_ERR_INV_FPDU,
+	err_inv_sdus = RLE_DECAP_ERR_INV_SDUS,
+	err_inv_pl = RLE_DECAP_ERR_INV_PL,
+	filtered = RLE_DECAP_FILTERED,
+	arena_full = RLE_DECAP_ARENA_FULL,
+};
+
+/** Protection of the ALPDUs */
+enum class protection {
+	crc,     /**< ALPDU CRC */
+	seqnum,  /**< ALPDU sequence number */
+};
+
+/**
+ * Configuration known at compile time, see struct rle_config.
+ *
+ * @tparam Protection          The protection of the ALPDUs.
+ * @tparam CompressedPtype     Whether the protocol types are compressed to 1 octet.
+ * @tparam PtypeOmission       Whether the implicit protocol type is omitted.
+ * @tparam ImplicitPtype       The implicit protocol type, in its compressed form.
+ * @tparam PayloadLabelSize    The size of the payload label of the FPDUs: 0, 3 or 6.
+ */
+template <protection Protection = protection::seqnum,
+          bool CompressedPtype = true,
+          bool PtypeOmission = false,
+          std::uint8_t ImplicitPtype = 0x00,
+          std::size_t PayloadLabelSize = 0>
+struct config {
+	static_assert(PayloadLabelSize == 0 || PayloadLabelSize == 3 || PayloadLabelSize == 6,
+	              "payload label of 0, 3 or 6 octets expected");
+
+	/** The protection of the ALPDUs */
+	static constexpr protection alpdu_protection = Protection;
+
+	/** The size of the payload label of the FPDUs */
+	static constexpr std::size_t payload_label_size = PayloadLabelSize;
+
+	/** The payload label of the FPDUs */
+	using label_type = std::array<unsigned char, PayloadLabelSize>;
+
+	/** The configuration for the C functions */
+	static constexpr rle_config c_config{
+		PtypeOmission ? 1 : 0,
+		CompressedPtype ? 1 : 0,
+		Protection == protection::crc ? 1 : 0,
+		Protection == protection::seqnum ? 1 : 0,
+		0,
+		ImplicitPtype,
+		0,
+		0,
+		0,
+	};
+};
+
+/** A decapsulated SDU, in the buffers of a \ref sdu_batch */
+struct sdu_view {
+	std::span<const unsigned char> data;  /**< The SDU */
+	std::uint16_t protocol_type;          /**< The protocol type (uncompressed) of the SDU */
+};
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------------ SDU BATCH -------------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * The SDUs decapsulated from one FPDU, in buffers allocated once for all.
+ *
+ * The buffers are reused by each decapsulation, the SDUs of a FPDU are thus valid until the next
+ * one is decapsulated in the same batch.
+ *
+ * @tparam N   The max number of SDUs per FPDU.
+ */
+template <std::size_t N>
+class sdu_batch
+{
+	static_assert(N > 0, "room for one SDU at least expected");
+
+public:
+	/** Iterator over the decapsulated SDUs */
+	class iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = sdu_view;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = sdu_view;
+
+		iterator() noexcept = default;
+		explicit iterator(const rle_sdu *const sdu) noexcept : sdu_(sdu) {}
+
+		sdu_view operator*() const noexcept
+		{
+			return { { sdu_->buffer, sdu_->size }, sdu_->protocol_type };
+		}
+
+		iterator &operator++() noexcept
+		{
+			++sdu_;
+			return *this;
+		}
+
+		iterator operator++(int) noexcept
+		{
+			iterator prev = *this;
+			++sdu_;
+			return prev;
+		}
+
+		bool operator==(const iterator &) const noexcept = default;
+
+	private:
+		const rle_sdu *sdu_ = nullptr;
+	};
+
+	sdu_batch() : storage_(new unsigned char[N * max_sdu_size])
+	{
+		for (std::size_t i = 0; i < N; ++i) {
+			sdus_[i].buffer = storage_.get() + i * max_sdu_size;
+			sdus_[i].size = 0;
+			sdus_[i].protocol_type = 0;
+		}
+	}
+
+	sdu_batch(sdu_batch &&) noexcept = default;
+	sdu_batch &operator=(sdu_batch &&) noexcept = default;
+	sdu_batch(const sdu_batch &) = delete;
+	sdu_batch &operator=(const sdu_batch &) = delete;
+
+	/** The number of SDUs decapsulated from the last FPDU */
+	std::size_t size() const noexcept { return nr_; }
+
+	/** Whether no SDU was decapsulated from the last FPDU */
+	bool empty() const noexcept { return nr_ == 0; }
+
+	/** The max number of SDUs per FPDU */
+	static constexpr std::size_t capacity() noexcept { return N; }
+
+	sdu_view operator[](const std::size_t i) const noexcept { return *iterator(&sdus_[i]); }
+
+	iterator begin() const noexcept { return iterator(sdus_.data()); }
+	iterator end() const noexcept { return iterator(sdus_.data() + nr_); }
+
+private:
+	template <typename> friend class receiver;
+
+	std::unique_ptr<unsigned char[]> storage_;  /**< The buffers of the SDUs */
+	std::array<rle_sdu, N> sdus_;               /**< The SDUs, for rle_decapsulate */
+	std::size_t nr_ = 0;                        /**< The number of SDUs decapsulated */
+};
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*-------------------------------------------- FRAME ---------------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * A FPDU being packed, with the payload label of the configuration.
+ *
+ * @tparam Config   The configuration, see \ref config.
+ * @tparam MaxSize  The size of the largest FPDU.
+ */
+template <typename Config, std::size_t MaxSize>
+class frame
+{
+	static_assert(MaxSize >= Config::payload_label_size + 2,
+	              "room for the payload label and a PPDU header expected");
+
+public:
+	using label_type = typename Config::label_type;
+
+	/** Start a FPDU of the given size, without payload label */
+	explicit frame(const std::size_t size = MaxSize) noexcept
+	requires (Config::payload_label_size == 0)
+		: size_(std::min(size, MaxSize))
+	{
+		clear();
+	}
+
+	/**
+	 * Start a FPDU of the given size, with the given payload label
+	 *
+	 * The size is at most MaxSize, and at least the payload label size with no room left.
+	 */
+	explicit frame(const label_type &label, const std::size_t size = MaxSize) noexcept
+	requires (Config::payload_label_size > 0)
+		: size_(std::clamp(size, Config::payload_label_size, MaxSize))
+	{
+		std::copy(label.begin(), label.end(), data_.begin());
+		clear();
+	}
+
+	/** Pack a PPDU, pack_status::err_fpdu_too_small if there is no room left for it */
+	pack_status pack(const std::span<const unsigned char> ppdu) noexcept
+	{
+		return static_cast<pack_status>(rle_pack(ppdu.data(), ppdu.size(), nullptr, 0,
+		                                          data_.data(), &pos_, &remain_));
+	}
+
+	/** Pad the room left, once all the PPDUs are packed */
+	void pad() noexcept
+	{
+		rle_pad(data_.data(), pos_, remain_);
+		pos_ += remain_;
+		remain_ = 0;
+	}
+
+	/** Restart the FPDU, with the same size and payload label */
+	void clear() noexcept
+	{
+		pos_ = Config::payload_label_size;
+		remain_ = size_ - Config::payload_label_size;
+	}
+
+	/** The room left for the PPDUs */
+	std::size_t remaining() const noexcept { return remain_; }
+
+	/** The whole FPDU */
+	std::span<unsigned char> data() noexcept { return { data_.data(), size_ }; }
+	std::span<const unsigned char> data() const noexcept { return { data_.data(), size_ }; }
+
+private:
+	std::array<unsigned char, MaxSize> data_;  /**< The FPDU, payload label first */
+	std::size_t size_;                         /**< The size of the FPDU */
+	std::size_t pos_;                          /**< The end of the last PPDU packed */
+	std::size_t remain_;                       /**< The room left for the PPDUs */
+};
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*----------------------------------------- TRANSMITTER ------------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * Move-only owner of a RLE transmitter.
+ *
+ * @tparam Config   The configuration, see \ref config.
+ */
+template <typename Config = config<>>
+class transmitter
+{
+public:
+	using config_type = Config;
+
+	/** Create the transmitter, throw std::bad_alloc if it cannot be allocated */
+	transmitter() : handle_(rle_transmitter_new(&Config::c_config))
+	{
+		if (!handle_) {
+			throw std::bad_alloc();
+		}
+	}
+
+	transmitter(transmitter &&) noexcept = default;
+	transmitter &operator=(transmitter &&) noexcept = default;
+	transmitter(const transmitter &) = delete;
+	transmitter &operator=(const transmitter &) = delete;
+
+	/** Encapsulate a SDU in a context, the SDU is copied in the context */
+	encap_status encapsulate(const std::uint8_t frag_id,
+	                         const std::span<const unsigned char> sdu,
+	                         const std::uint16_t protocol_type) noexcept
+	{
+		/* the SDU is only read, rle_sdu has no const buffer */
+		const rle_sdu c_sdu = {
+			const_cast<unsigned char *>(sdu.data()), sdu.size(), protocol_type
+		};
+
+		return static_cast<encap_status>(rle_encapsulate(handle_.get(), &c_sdu, frag_id));
+	}
+
+	/**
+	 * Encapsulate a SDU in place, see \ref rle_encapsulate_in_place.
+	 *
+	 * The SDU starts at \p headroom in \p buffer, which must be kept until the SDU is fully
+	 * fragmented. A buffer of static extent is checked at compile time.
+	 */
+	template <std::size_t Extent>
+	encap_status encapsulate_in_place(const std::uint8_t frag_id,
+	                                  const std::span<unsigned char, Extent> buffer,
+	                                  const std::size_t headroom,
+	                                  const std::size_t sdu_size,
+	                                  const std::uint16_t protocol_type) noexcept
+	{
+		static_assert(Extent == std::dynamic_extent ||
+		              Extent > RLE_SDU_BUF_HEADROOM + RLE_SDU_BUF_TAILROOM,
+		              "room for the headers, the trailer and a SDU expected");
+		const rle_sdu_buf sdu_buf = {
+			buffer.data(), buffer.size(), headroom, sdu_size, protocol_type
+		};
+
+		return static_cast<encap_status>(rle_encapsulate_in_place(handle_.get(), &sdu_buf,
+		                                                          frag_id));
+	}
+
+	/**
+	 * Get the next PPDU of a context, see \ref rle_fragment.
+	 *
+	 * The PPDU belongs to the context, and is valid until the next one of the context.
+	 */
+	frag_status fragment(const std::uint8_t frag_id, const std::size_t burst_size,
+	                     std::span<const unsigned char> &ppdu) noexcept
+	{
+		unsigned char *ppdu_buf = nullptr;
+		std::size_t ppdu_len = 0;
+		const rle_frag_status status =
+			rle_fragment(handle_.get(), frag_id, burst_size, &ppdu_buf, &ppdu_len);
+
+		ppdu = { ppdu_buf, ppdu_len };
+
+		return static_cast<frag_status>(status);
+	}
+
+	/** The number of octets left to fragment in a context */
+	std::size_t queue_size(const std::uint8_t frag_id) const noexcept
+	{
+		return rle_transmitter_stats_get_queue_size(handle_.get(), frag_id);
+	}
+
+	/** The C transmitter, for the functions not wrapped here */
+	rle_transmitter *get() const noexcept { return handle_.get(); }
+
+private:
+	struct deleter {
+		void operator()(rle_transmitter *t) const noexcept { rle_transmitter_destroy(&t); }
+	};
+
+	std::unique_ptr<rle_transmitter, deleter> handle_;
+};
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------------- RECEIVER -------------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * Move-only owner of a RLE receiver.
+ *
+ * @tparam Config   The configuration, see \ref config.
+ */
+template <typename Config = config<>>
+class receiver
+{
+public:
+	using config_type = Config;
+	using label_type = typename Config::label_type;
+
+	/** Create the receiver, throw std::bad_alloc if it cannot be allocated */
+	receiver() : handle_(rle_receiver_new(&Config::c_config))
+	{
+		if (!handle_) {
+			throw std::bad_alloc();
+		}
+	}
+
+	receiver(receiver &&) noexcept = default;
+	receiver &operator=(receiver &&) noexcept = default;
+	receiver(const receiver &) = delete;
+	receiver &operator=(const receiver &) = delete;
+
+	/** Decapsulate a FPDU without payload label in a batch of SDUs */
+	template <std::size_t N>
+	decap_status decapsulate(const std::span<unsigned char> fpdu, sdu_batch<N> &sdus) noexcept
+	requires (Config::payload_label_size == 0)
+	{
+		return static_cast<decap_status>(rle_decapsulate(handle_.get(), fpdu.data(), fpdu.size(),
+		                                                 sdus.sdus_.data(), N, &sdus.nr_,
+		                                                 nullptr, 0));
+	}
+
+	/** Decapsulate a FPDU in a batch of SDUs, and get its payload label */
+	template <std::size_t N>
+	decap_status decapsulate(const std::span<unsigned char> fpdu, sdu_batch<N> &sdus,
+	                         label_type &label) noexcept
+	requires (Config::payload_label_size > 0)
+	{
+		return static_cast<decap_status>(rle_decapsulate(handle_.get(), fpdu.data(), fpdu.size(),
+		                                                 sdus.sdus_.data(), N, &sdus.nr_,
+		                                                 label.data(), label.size()));
+	}
+
+	/** Accept the FPDUs with the given payload label, see \ref rle_receiver_label_filter_add */
+	bool accept_label(const label_type &label) noexcept
+	requires (Config::payload_label_size > 0)
+	{
+		return rle_receiver_label_filter_add(handle_.get(), label.data(), nullptr,
+		                                     label.size()) == 0;
+	}
+
+	/** The number of octets being reassembled in a context */
+	std::size_t queue_size(const std::uint8_t frag_id) const noexcept
+	{
+		return rle_receiver_stats_get_queue_size(handle_.get(), frag_id);
+	}
+
+	/** The C receiver, for the functions not wrapped here */
+	rle_receiver *get() const noexcept { return handle_.get(); }
+
+private:
+	struct deleter {
+		void operator()(rle_receiver *r) const noexcept { rle_receiver_destroy(&r); }
+	};
+
+	std::unique_ptr<rle_receiver, deleter> handle_;
+};
+
+} /* namespace rle */
+
+#endif /* __RLE_HPP__ */
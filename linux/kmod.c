@@ -27,7 +27,20 @@
  */
 
 #include <linux/module.h>
+#include <linux/moduleparam.h>
+#include <linux/slab.h>
+#include <linux/mm.h>
+#include <linux/cache.h>
+#include <linux/smp.h>
+#include <linux/cpumask.h>
+#include <linux/topology.h>
+#include <linux/version.h>
+
 #include "rle.h"
+#include "fragmentation_buffer.h"
+#include "reassembly_buffer.h"
+#include "rle_transmitter.h"
+#include "rle_receiver.h"
 
 #define PACKAGE_NAME    "RLE library"
 #define PACKAGE_VERSION "0.0.1"
@@ -39,6 +52,285 @@ MODULE_AUTHOR("Didier Barvaux, Henrick Deschamps, "
               "Thales Alenia Space France, Viveris Technologies");
 MODULE_DESCRIPTION(PACKAGE_NAME ", version " PACKAGE_VERSION);
 
+/* kfree() releases the objects of any kmem cache since Linux 6.4 only, the release hook of the
+ * allocator does not know the cache of the object */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 4, 0)
+#define RLE_KMEM_CACHES 1
+#endif
+
+/** A kmem cache for the allocations of one size */
+struct rle_kmem_cache {
+	const char *name;         /**< The name of the cache, in /proc/slabinfo */
+	size_t size;              /**< The octets of the allocations served     */
+	struct kmem_cache *cache; /**< The cache, NULL if not created           */
+};
+
+/** The instances of a CPU, alone on their cache lines */
+struct rle_percpu_slot {
+	struct rle_percpu_instance instance; /**< The instances of the CPU */
+} ____cacheline_aligned_in_smp;
+
+/**
+ * The instances of all the CPUs, indexed by CPU number (alloc_percpu is not available to the
+ * module, it is exported to the GPL modules only)
+ */
+struct rle_percpu {
+	unsigned int slots_nr;              /**< The number of slots, nr_cpu_ids */
+	struct rle_percpu_slot slots[];     /**< The instances of each CPU       */
+};
+
+/** Module parameter - allocate the buffers from dedicated kmem caches */
+static bool kmem_caches = true;
+module_param(kmem_caches, bool, 0444);
+MODULE_PARM_DESC(kmem_caches, "Allocate the buffers from dedicated kmem caches (default true)");
+
+/**
+ * The kmem caches, by size. The fragmentation buffers (4 KB and a bit) and the receivers would
+ * take 8 KB each from kmalloc.
+ */
+static struct rle_kmem_cache rle_kmem_caches[] = {
+	{ .name = "rle_frag_buf", .size = sizeof(struct rle_frag_buf) },
+	{ .name = "rle_rasm_buf", .size = RLE_R_BUFF_LEN },
+	{ .name = "rle_transmitter", .size = sizeof(struct rle_transmitter) },
+	{ .name = "rle_receiver", .size = sizeof(struct rle_receiver) },
+};
+
+/** The NUMA node of each allocator, pointed to by the private data of the allocators */
+static int rle_kmem_nodes[MAX_NUMNODES];
+
+/**
+ * @brief Get the kmem cache of an allocation
+ *
+ * @param size  The octets of the allocation
+ * @return      The cache, NULL if none
+ */
+static struct kmem_cache *rle_kmem_cache_of(const size_t size)
+{
+	size_t i;
+
+	for (i = 0; i < ARRAY_SIZE(rle_kmem_caches); ++i) {
+		if (rle_kmem_caches[i].size == size) {
+			return rle_kmem_caches[i].cache;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Allocation hook of the allocator of the kernel module
+ *
+ * @param priv  The NUMA node, NULL for any
+ * @param size  The number of octets
+ * @return      The memory if OK, else NULL
+ */
+static void *rle_kmem_alloc(void *const priv, const size_t size)
+{
+	const int node = priv == NULL ? NUMA_NO_NODE : *(const int *)priv;
+	struct kmem_cache *const cache = rle_kmem_cache_of(size);
+
+	if (cache != NULL) {
+		return kmem_cache_alloc_node(cache, GFP_KERNEL, node);
+	}
+
+	return kvmalloc_node(size, GFP_KERNEL, node);
+}
+
+/**
+ * @brief Release hook of the allocator of the kernel module
+ *
+ * @param priv  Unused
+ * @param ptr   The memory to release
+ */
+static void rle_kmem_free(void *const priv __attribute__((unused)), void *const ptr)
+{
+	kvfree(ptr);
+}
+
+void rle_kmem_allocator_get(struct rle_allocator *const allocator, const int node)
+{
+	allocator->alloc = rle_kmem_alloc;
+	allocator->free = rle_kmem_free;
+	allocator->priv = node == RLE_NUMA_NODE_ANY ? NULL : &rle_kmem_nodes[node];
+}
+
+size_t rle_kmem_footprint(const size_t size)
+{
+	struct kmem_cache *const cache = rle_kmem_cache_of(size);
+
+	if (cache != NULL) {
+		/* the objects of the caches are SLAB_HWCACHE_ALIGN */
+		return ALIGN(size, cache_line_size());
+	}
+	if (size > KMALLOC_MAX_CACHE_SIZE) {
+		return PAGE_ALIGN(size);
+	}
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 1, 0)
+	return kmalloc_size_roundup(size);
+#else
+	return roundup_pow_of_two(size);
+#endif
+}
+
+struct rle_percpu *rle_percpu_new(const struct rle_config *const conf)
+{
+	struct rle_percpu *percpu;
+	unsigned int cpu;
+
+	percpu = kvzalloc(struct_size(percpu, slots, nr_cpu_ids), GFP_KERNEL);
+	if (percpu == NULL) {
+		goto error;
+	}
+	percpu->slots_nr = nr_cpu_ids;
+
+	for_each_possible_cpu(cpu) {
+		struct rle_percpu_instance *const instance = &percpu->slots[cpu].instance;
+		struct rle_allocator allocator;
+
+		rle_kmem_allocator_get(&allocator, cpu_to_node(cpu));
+
+		instance->transmitter = rle_transmitter_new_with_allocator(conf, &allocator);
+		if (instance->transmitter == NULL) {
+			pr_err("[%s] failed to create the transmitter of CPU %u\n", THIS_MODULE->name, cpu);
+			goto destroy;
+		}
+
+		instance->receiver = rle_receiver_new_with_allocator(conf, &allocator);
+		if (instance->receiver == NULL) {
+			pr_err("[%s] failed to create the receiver of CPU %u\n", THIS_MODULE->name, cpu);
+			goto destroy;
+		}
+	}
+
+	return percpu;
+
+destroy:
+	rle_percpu_destroy(&percpu);
+error:
+	return NULL;
+}
+
+void rle_percpu_destroy(struct rle_percpu **const percpu)
+{
+	unsigned int cpu;
+
+	if (*percpu == NULL) {
+		return;
+	}
+
+	for_each_possible_cpu(cpu) {
+		struct rle_percpu_instance *const instance = &(*percpu)->slots[cpu].instance;
+
+		if (instance->transmitter != NULL) {
+			rle_transmitter_destroy(&instance->transmitter);
+		}
+		if (instance->receiver != NULL) {
+			rle_receiver_destroy(&instance->receiver);
+		}
+	}
+
+	kvfree(*percpu);
+	*percpu = NULL;
+}
+
+struct rle_percpu_instance *rle_percpu_get(struct rle_percpu *const percpu)
+{
+	return &percpu->slots[smp_processor_id()].instance;
+}
+
+struct rle_percpu_instance *rle_percpu_get_on(struct rle_percpu *const percpu,
+                                              const unsigned int cpu)
+{
+	BUG_ON(cpu >= percpu->slots_nr);
+
+	return &percpu->slots[cpu].instance;
+}
+
+/**
+ * @brief Release the kmem caches
+ */
+static void rle_kmem_caches_destroy(void)
+{
+	size_t i;
+
+	for (i = 0; i < ARRAY_SIZE(rle_kmem_caches); ++i) {
+		kmem_cache_destroy(rle_kmem_caches[i].cache);
+		rle_kmem_caches[i].cache = NULL;
+	}
+}
+
+/**
+ * @brief Create the kmem caches, if the kernel allows them
+ *
+ * @return  0 in case of success, -ENOMEM otherwise
+ */
+static int __init rle_kmem_caches_create(void)
+{
+#ifdef RLE_KMEM_CACHES
+	size_t i;
+
+	for (i = 0; i < ARRAY_SIZE(rle_kmem_caches); ++i) {
+		rle_kmem_caches[i].cache = kmem_cache_create(rle_kmem_caches[i].name,
+		                                             rle_kmem_caches[i].size, 0,
+		                                             SLAB_HWCACHE_ALIGN, NULL);
+		if (rle_kmem_caches[i].cache == NULL) {
+			pr_err("[%s] failed to create the kmem cache %s\n", THIS_MODULE->name,
+			       rle_kmem_caches[i].name);
+			rle_kmem_caches_destroy();
+			return -ENOMEM;
+		}
+	}
+#else
+	pr_info("[%s] no kmem caches before Linux 6.4, kvmalloc is used\n", THIS_MODULE->name);
+#endif
+
+	return 0;
+}
+
+/**
+ * @brief Create the kmem caches and register the allocator that uses them
+ *
+ * @return  0 in case of success, -ENOMEM otherwise
+ */
+static int __init rle_kmod_init(void)
+{
+	struct rle_allocator allocator;
+	int node;
+
+	for (node = 0; node < MAX_NUMNODES; ++node) {
+		rle_kmem_nodes[node] = node;
+	}
+
+	if (kmem_caches) {
+		const int ret = rle_kmem_caches_create();
+
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	/* no transmitter nor receiver exists yet */
+	rle_kmem_allocator_get(&allocator, RLE_NUMA_NODE_ANY);
+	rle_set_allocator(&allocator);
+
+	return 0;
+}
+
+/**
+ * @brief Restore the default allocator and release the kmem caches
+ *
+ * The module is unloaded once all its users are, so no transmitter nor receiver remains.
+ */
+static void __exit rle_kmod_exit(void)
+{
+	rle_set_allocator(NULL);
+	rle_kmem_caches_destroy();
+}
+
+module_init(rle_kmod_init);
+module_exit(rle_kmod_exit);
+
 EXPORT_SYMBOL(rle_transmitter_new);
 EXPORT_SYMBOL(rle_transmitter_destroy);
 EXPORT_SYMBOL(rle_receiver_new);
@@ -48,7 +340,20 @@ EXPORT_SYMBOL(rle_fragment);
 EXPORT_SYMBOL(rle_pack);
 EXPORT_SYMBOL(rle_pack_init);
 EXPORT_SYMBOL(rle_pad);
+EXPORT_SYMBOL(rle_pack_iov_init);
+EXPORT_SYMBOL(rle_pack_iov);
+EXPORT_SYMBOL(rle_pad_iov);
+EXPORT_SYMBOL(rle_pack_plan);
+EXPORT_SYMBOL(rle_encapsulate_timed);
+EXPORT_SYMBOL(rle_encapsulate_in_place);
+EXPORT_SYMBOL(rle_encapsulate_bulk);
+EXPORT_SYMBOL(rle_transmitter_sched_set);
+EXPORT_SYMBOL(rle_transmitter_sched_next);
 EXPORT_SYMBOL(rle_decapsulate);
+EXPORT_SYMBOL(rle_decapsulate_arena);
+EXPORT_SYMBOL(rle_decap_stream_begin);
+EXPORT_SYMBOL(rle_decap_stream_push);
+EXPORT_SYMBOL(rle_decap_stream_end);
 EXPORT_SYMBOL(rle_transmitter_stats_get_queue_size);
 EXPORT_SYMBOL(rle_transmitter_stats_get_counter_sdus_in);
 EXPORT_SYMBOL(rle_transmitter_stats_get_counter_sdus_sent);
@@ -56,8 +361,13 @@ EXPORT_SYMBOL(rle_transmitter_stats_get_counter_sdus_dropped);
 EXPORT_SYMBOL(rle_transmitter_stats_get_counter_bytes_in);
 EXPORT_SYMBOL(rle_transmitter_stats_get_counter_bytes_sent);
 EXPORT_SYMBOL(rle_transmitter_stats_get_counter_bytes_dropped);
+EXPORT_SYMBOL(rle_transmitter_stats_get_counter_sdus_expired);
+EXPORT_SYMBOL(rle_transmitter_stats_get_counter_bytes_expired);
 EXPORT_SYMBOL(rle_transmitter_stats_get_counters);
 EXPORT_SYMBOL(rle_transmitter_stats_reset_counters);
+EXPORT_SYMBOL(rle_transmitter_stats_add_fpdu);
+EXPORT_SYMBOL(rle_transmitter_stats_get_link);
+EXPORT_SYMBOL(rle_transmitter_stats_reset_link);
 EXPORT_SYMBOL(rle_receiver_stats_get_queue_size);
 EXPORT_SYMBOL(rle_receiver_stats_get_counter_sdus_received);
 EXPORT_SYMBOL(rle_receiver_stats_get_counter_sdus_reassembled);
@@ -76,5 +386,53 @@ EXPORT_SYMBOL(rle_frag_buf_new);
 EXPORT_SYMBOL(rle_frag_buf_del);
 EXPORT_SYMBOL(rle_frag_buf_init);
 EXPORT_SYMBOL(rle_frag_buf_cpy_sdu);
+EXPORT_SYMBOL(rle_frag_buf_attach_sdu);
 EXPORT_SYMBOL(rle_encap_contextless);
 EXPORT_SYMBOL(rle_frag_contextless);
+EXPORT_SYMBOL(rle_fragment_estimate);
+EXPORT_SYMBOL(rle_transmitter_latency_enable);
+EXPORT_SYMBOL(rle_transmitter_latency_disable);
+EXPORT_SYMBOL(rle_transmitter_latency_get_histo);
+EXPORT_SYMBOL(rle_transmitter_latency_reset);
+EXPORT_SYMBOL(rle_receiver_latency_enable);
+EXPORT_SYMBOL(rle_receiver_latency_disable);
+EXPORT_SYMBOL(rle_receiver_latency_get_histo);
+EXPORT_SYMBOL(rle_receiver_latency_reset);
+EXPORT_SYMBOL(rle_latency_histo_get_bucket_min);
+EXPORT_SYMBOL(rle_latency_histo_get_percentile);
+EXPORT_SYMBOL(rle_transmitter_checkpoint_size);
+EXPORT_SYMBOL(rle_transmitter_checkpoint);
+EXPORT_SYMBOL(rle_transmitter_restore);
+EXPORT_SYMBOL(rle_receiver_checkpoint_size);
+EXPORT_SYMBOL(rle_receiver_checkpoint);
+EXPORT_SYMBOL(rle_receiver_restore);
+EXPORT_SYMBOL(rle_transmitter_set_trace_callback);
+EXPORT_SYMBOL(rle_transmitter_set_trace_level);
+EXPORT_SYMBOL(rle_receiver_set_trace_callback);
+EXPORT_SYMBOL(rle_receiver_set_trace_level);
+EXPORT_SYMBOL(rle_receiver_stats_get_counter_errors);
+EXPORT_SYMBOL(rle_receiver_stats_get_errors);
+EXPORT_SYMBOL(rle_receiver_stats_reset_errors);
+EXPORT_SYMBOL(rle_receiver_stats_get_counter_fpdus_filtered);
+EXPORT_SYMBOL(rle_receiver_label_filter_add);
+EXPORT_SYMBOL(rle_receiver_label_filter_clear);
+EXPORT_SYMBOL(rle_receiver_set_error_trace_rate);
+EXPORT_SYMBOL(rle_set_allocator);
+EXPORT_SYMBOL(rle_alloc_audit_enable);
+EXPORT_SYMBOL(rle_alloc_audit_disable);
+EXPORT_SYMBOL(rle_alloc_audit_get);
+EXPORT_SYMBOL(rle_alloc_audit_reset);
+EXPORT_SYMBOL(rle_transmitter_new_with_allocator);
+EXPORT_SYMBOL(rle_transmitter_new_on_node);
+EXPORT_SYMBOL(rle_receiver_new_with_allocator);
+EXPORT_SYMBOL(rle_receiver_new_on_node);
+EXPORT_SYMBOL(rle_transmitter_new_bulk);
+EXPORT_SYMBOL(rle_transmitter_destroy_bulk);
+EXPORT_SYMBOL(rle_receiver_new_bulk);
+EXPORT_SYMBOL(rle_receiver_destroy_bulk);
+EXPORT_SYMBOL(rle_kmem_allocator_get);
+EXPORT_SYMBOL(rle_kmem_footprint);
+EXPORT_SYMBOL(rle_percpu_new);
+EXPORT_SYMBOL(rle_percpu_destroy);
+EXPORT_SYMBOL(rle_percpu_get);
+EXPORT_SYMBOL(rle_percpu_get_on);
@@ -31,6 +31,10 @@
 #include <linux/uaccess.h>
 #include <linux/proc_fs.h>
 #include <linux/string.h>
+#include <linux/slab.h>
+#include <linux/ktime.h>
+#include <linux/bottom_half.h>
+#include <linux/sched.h>
 
 #include "rle.h"
 
@@ -56,6 +60,12 @@
 /** Max number of SDUs to extract (1 per frag id) */
 #define MAX_SDUS_NR MAX_FRAG_ID
 
+/** Size of the FPDUs of the throughput benchmark */
+#define BENCH_FPDU_SIZE 599
+
+/** SDUs handled between two reschedules in the throughput benchmark */
+#define BENCH_CHUNK_SDUS 64
+
 /** Module parameter - size of the bursts for fragmentation (not packing). */
 static int param_burst_size = 14;
 
@@ -65,6 +75,10 @@ static int param_use_alpdu_crc = 0;             /** Seq No per default.      */
 static int param_use_ptype_omission = 1;        /** Ommission per default.   */
 static int param_use_compressed_ptype = 1;      /** Compression per default. */
 
+/** Module parameters - throughput benchmark at load, 0 SDU to skip it. */
+static int param_bench_sdus = 100000;
+static int param_bench_sdu_size = 1000;
+
 /** A couple of RLE transmitter/receiver and the related buffers */
 struct rle_couple {
 	/** The RLE transmitter created by the module */
@@ -119,6 +133,27 @@ static uint8_t frag_id = 0;
 static int couple_initialized = 0;
 
 
+/**
+ * @brief Init a RLE configuration from the module parameters
+ *
+ * @param conf  The configuration to initialize
+ */
+static void rle_conf_init(struct rle_config *conf)
+{
+	memset(conf, '\0', sizeof(struct rle_config));
+
+	conf->allow_ptype_omission = param_use_ptype_omission > 0 ? 1 : 0;
+	conf->use_compressed_ptype = param_use_compressed_ptype > 0 ? 1 : 0;
+	conf->allow_alpdu_crc = param_use_alpdu_crc > 0 ? 1 : 0;
+	conf->allow_alpdu_sequence_number = param_use_alpdu_crc > 0 ? 0 : 1;
+	conf->use_explicit_payload_header_map = 0;
+	conf->implicit_protocol_type = (uint8_t)param_implicit_protocol_type;
+	conf->implicit_ppdu_label_size = 0;
+	conf->implicit_payload_label_size = 0;
+	conf->type_0_alpdu_label_size = 0;
+}
+
+
 /**
  * @brief Init a RLE couple
  *
@@ -130,16 +165,7 @@ int rle_couple_init(struct rle_couple *couple)
 	pr_info("[%s] init RLE couple\n", THIS_MODULE->name);
 
 	memset(couple, '\0', sizeof(struct rle_couple));
-
-	couple->conf.allow_ptype_omission = param_use_ptype_omission > 0 ? 1 : 0;
-	couple->conf.use_compressed_ptype = param_use_compressed_ptype > 0 ? 1 : 0;
-	couple->conf.allow_alpdu_crc = param_use_alpdu_crc > 0 ? 1 : 0;
-	couple->conf.allow_alpdu_sequence_number = param_use_alpdu_crc > 0 ? 0 : 1;
-	couple->conf.use_explicit_payload_header_map = 0;
-	couple->conf.implicit_protocol_type = (uint8_t)param_implicit_protocol_type;
-	couple->conf.implicit_ppdu_label_size = 0;
-	couple->conf.implicit_payload_label_size = 0;
-	couple->conf.type_0_alpdu_label_size = 0;
+	rle_conf_init(&couple->conf);
 
 	/* create the transmitter */
 	couple->transmitter = rle_transmitter_new(&couple->conf);
@@ -507,6 +533,325 @@ void rle_proc_release(void)
 }
 
 
+/** The memory requested and taken by the allocations of the library */
+struct footprint {
+	struct rle_allocator inner; /**< The allocator that does the allocations        */
+	bool kmem;                  /**< Whether inner is the allocator of the library  */
+	size_t requested;           /**< The octets requested                           */
+	size_t taken;               /**< The octets taken, rounding of the slabs included */
+};
+
+/**
+ * @brief Allocate with kmalloc, the default allocator of the library
+ *
+ * @param priv  Unused
+ * @param size  The number of octets
+ * @return      The memory if OK, else NULL
+ */
+static void *footprint_kmalloc(void *priv, const size_t size)
+{
+	return kmalloc(size, GFP_KERNEL);
+}
+
+/**
+ * @brief Release with kfree, the default allocator of the library
+ *
+ * @param priv  Unused
+ * @param ptr   The memory to release
+ */
+static void footprint_kfree(void *priv, void *ptr)
+{
+	kfree(ptr);
+}
+
+/**
+ * @brief Allocate with the inner allocator and account the memory taken
+ *
+ * @param priv  The footprint
+ * @param size  The number of octets
+ * @return      The memory if OK, else NULL
+ */
+static void *footprint_alloc(void *priv, const size_t size)
+{
+	struct footprint *const footprint = priv;
+	void *const ptr = footprint->inner.alloc(footprint->inner.priv, size);
+
+	if (ptr != NULL) {
+		footprint->requested += size;
+		footprint->taken += footprint->kmem ? rle_kmem_footprint(size) : ksize(ptr);
+	}
+
+	return ptr;
+}
+
+/**
+ * @brief Release with the inner allocator
+ *
+ * @param priv  The footprint
+ * @param ptr   The memory to release
+ */
+static void footprint_free(void *priv, void *ptr)
+{
+	struct footprint *const footprint = priv;
+
+	footprint->inner.free(footprint->inner.priv, ptr);
+}
+
+/**
+ * @brief Measure the memory a transmitter and a receiver take with an allocator
+ *
+ * @param conf       The configuration of the transmitter and the receiver
+ * @param footprint  The footprint, with its inner allocator
+ * @return           0 in case of success, 1 otherwise
+ */
+static int footprint_measure(const struct rle_config *conf, struct footprint *footprint)
+{
+	const struct rle_allocator allocator = {
+		.alloc = footprint_alloc,
+		.free = footprint_free,
+		.priv = footprint,
+	};
+	struct rle_transmitter *transmitter;
+	struct rle_receiver *receiver;
+
+	footprint->requested = 0;
+	footprint->taken = 0;
+
+	transmitter = rle_transmitter_new_with_allocator(conf, &allocator);
+	if (transmitter == NULL) {
+		goto error;
+	}
+	receiver = rle_receiver_new_with_allocator(conf, &allocator);
+	if (receiver == NULL) {
+		goto free_transmitter;
+	}
+
+	rle_receiver_destroy(&receiver);
+	rle_transmitter_destroy(&transmitter);
+
+	return 0;
+
+free_transmitter:
+	rle_transmitter_destroy(&transmitter);
+error:
+	return 1;
+}
+
+/**
+ * @brief Report the memory a transmitter and a receiver take, with kmalloc and with the kmem
+ *        caches of the library
+ *
+ * @return  0 in case of success, 1 otherwise
+ */
+static int rle_footprint_report(void)
+{
+	struct footprint with_kmalloc = {
+		.inner = { .alloc = footprint_kmalloc, .free = footprint_kfree, .priv = NULL },
+		.kmem = false,
+	};
+	struct footprint with_kmem = { .kmem = true };
+	struct rle_config conf;
+
+	rle_conf_init(&conf);
+	rle_kmem_allocator_get(&with_kmem.inner, RLE_NUMA_NODE_ANY);
+
+	if (footprint_measure(&conf, &with_kmalloc) != 0 ||
+	    footprint_measure(&conf, &with_kmem) != 0) {
+		pr_err("[%s] failed to create a RLE couple to measure its footprint\n",
+		       THIS_MODULE->name);
+		return 1;
+	}
+
+	pr_info("[%s] footprint of a transmitter and a receiver: %zu octets requested\n",
+	        THIS_MODULE->name, with_kmalloc.requested);
+	pr_info("[%s]\twith kmalloc:     %zu octets\n", THIS_MODULE->name, with_kmalloc.taken);
+	pr_info("[%s]\twith kmem caches: %zu octets\n", THIS_MODULE->name, with_kmem.taken);
+
+	return 0;
+}
+
+/** The FPDU of the throughput benchmark */
+static unsigned char bench_fpdu[BENCH_FPDU_SIZE];
+
+/** The SDU of the throughput benchmark */
+static unsigned char bench_sdu_buffer[MAX_SDU_LENGTH];
+
+/** The buffers of the SDUs decapsulated by the throughput benchmark */
+static unsigned char bench_sdus_out_buffers[MAX_SDUS_NR][MAX_SDU_LENGTH];
+
+/**
+ * @brief Pad and decapsulate the FPDU of the throughput benchmark, if not empty
+ *
+ * @param instance     The transmitter and the receiver of the current CPU
+ * @param fpdu_pos     The current position in the FPDU, reset
+ * @param fpdu_remain  The remaining size in the FPDU, reset
+ * @param sdus_nr      The number of SDUs decapsulated, increased
+ * @return             0 in case of success, 1 otherwise
+ */
+static int bench_flush(struct rle_percpu_instance *instance, size_t *fpdu_pos,
+                       size_t *fpdu_remain, size_t *sdus_nr)
+{
+	struct rle_sdu sdus[MAX_SDUS_NR];
+	size_t sdus_out_nr = 0;
+	size_t i;
+
+	if (*fpdu_pos == 0) {
+		return 0;
+	}
+
+	rle_pad(bench_fpdu, *fpdu_pos, *fpdu_remain);
+	for (i = 0; i < MAX_SDUS_NR; ++i) {
+		sdus[i].buffer = bench_sdus_out_buffers[i];
+		sdus[i].size = 0;
+	}
+	if (rle_decapsulate(instance->receiver, bench_fpdu, BENCH_FPDU_SIZE, sdus, MAX_SDUS_NR,
+	                    &sdus_out_nr, NULL, 0) != RLE_DECAP_OK) {
+		return 1;
+	}
+
+	*sdus_nr += sdus_out_nr;
+	*fpdu_pos = 0;
+	*fpdu_remain = BENCH_FPDU_SIZE;
+
+	return 0;
+}
+
+/**
+ * @brief Encapsulate, fragment and pack SDUs, then decapsulate the FPDUs, on the instances of
+ *        the current CPU
+ *
+ * @param instance  The transmitter and the receiver of the current CPU
+ * @param sdu       The SDU to send
+ * @param count     The number of times to send it
+ * @param sdus_nr   The number of SDUs decapsulated, increased
+ * @return          0 in case of success, 1 otherwise
+ */
+static int bench_chunk(struct rle_percpu_instance *instance, const struct rle_sdu *sdu,
+                       const size_t count, size_t *sdus_nr)
+{
+	size_t fpdu_pos = 0;
+	size_t fpdu_remain = BENCH_FPDU_SIZE;
+	size_t fpdu_sdus_nr = 0;
+	size_t i;
+
+	for (i = 0; i < count; ++i) {
+		if (rle_encapsulate(instance->transmitter, sdu, 0) != RLE_ENCAP_OK) {
+			return 1;
+		}
+
+		while (rle_transmitter_stats_get_queue_size(instance->transmitter, 0) != 0) {
+			unsigned char *ppdu;
+			size_t ppdu_len;
+
+			if (rle_fragment(instance->transmitter, 0, fpdu_remain, &ppdu,
+			                 &ppdu_len) != RLE_FRAG_OK) {
+				/* too little room left, start a new FPDU */
+				if (fpdu_pos == 0 ||
+				    bench_flush(instance, &fpdu_pos, &fpdu_remain, sdus_nr) != 0) {
+					return 1;
+				}
+				fpdu_sdus_nr = 0;
+				continue;
+			}
+			if (rle_pack(ppdu, ppdu_len, NULL, 0, bench_fpdu, &fpdu_pos,
+			             &fpdu_remain) != RLE_PACK_OK) {
+				return 1;
+			}
+		}
+
+		/* no more SDUs end in one FPDU than decapsulated at once */
+		fpdu_sdus_nr++;
+		if (fpdu_sdus_nr == MAX_SDUS_NR) {
+			if (bench_flush(instance, &fpdu_pos, &fpdu_remain, sdus_nr) != 0) {
+				return 1;
+			}
+			fpdu_sdus_nr = 0;
+		}
+	}
+
+	/* the SDUs of the chunk are all sent, the next chunk may run on another CPU */
+	return bench_flush(instance, &fpdu_pos, &fpdu_remain, sdus_nr);
+}
+
+/**
+ * @brief Report the throughput of the per-CPU transmitters and receivers
+ *
+ * The SDUs are processed in chunks with the bottom halves disabled, as in a softirq path, on
+ * the instances of the CPU the chunk runs on.
+ *
+ * @return  0 in case of success, 1 otherwise
+ */
+static int rle_throughput_report(void)
+{
+	const size_t sdus_total = (size_t)param_bench_sdus;
+	struct rle_percpu *percpu;
+	struct rle_config conf;
+	struct rle_sdu sdu;
+	size_t sdus_sent = 0;
+	size_t sdus_nr = 0;
+	u64 duration_ns = 0;
+
+	if (param_bench_sdu_size <= 0 || param_bench_sdu_size > MAX_SDU_LENGTH) {
+		pr_err("[%s] SDU size %d out of range (1 to %d)\n", THIS_MODULE->name,
+		       param_bench_sdu_size, MAX_SDU_LENGTH);
+		goto error;
+	}
+
+	rle_conf_init(&conf);
+	percpu = rle_percpu_new(&conf);
+	if (percpu == NULL) {
+		pr_err("[%s] failed to create the per-CPU RLE instances\n", THIS_MODULE->name);
+		goto error;
+	}
+
+	memset(bench_sdu_buffer, 0x5a, sizeof(bench_sdu_buffer));
+	sdu.buffer = bench_sdu_buffer;
+	sdu.size = (size_t)param_bench_sdu_size;
+	sdu.protocol_type = 0x0800;
+
+	while (sdus_sent < sdus_total) {
+		const size_t count = min_t(size_t, BENCH_CHUNK_SDUS, sdus_total - sdus_sent);
+		u64 start;
+		int ret;
+
+		local_bh_disable();
+		start = ktime_get_ns();
+		ret = bench_chunk(rle_percpu_get(percpu), &sdu, count, &sdus_nr);
+		duration_ns += ktime_get_ns() - start;
+		local_bh_enable();
+
+		if (ret != 0) {
+			pr_err("[%s] failed to send %zu-octet SDUs\n", THIS_MODULE->name, sdu.size);
+			goto destroy;
+		}
+		sdus_sent += count;
+		cond_resched();
+	}
+
+	if (sdus_nr != sdus_total) {
+		pr_err("[%s] %zu SDUs decapsulated out of %zu\n", THIS_MODULE->name, sdus_nr,
+		       sdus_total);
+		goto destroy;
+	}
+
+	pr_info("[%s] throughput of %zu %zu-octet SDUs in %d-octet FPDUs:\n", THIS_MODULE->name,
+	        sdus_total, sdu.size, BENCH_FPDU_SIZE);
+	pr_info("[%s]\t%llu ns per SDU, encapsulation and decapsulation\n", THIS_MODULE->name,
+	        div64_u64(duration_ns, sdus_total));
+	pr_info("[%s]\t%llu Mb/s of SDUs\n", THIS_MODULE->name,
+	        div64_u64((u64)sdus_total * sdu.size * 8 * 1000, max_t(u64, duration_ns, 1)));
+
+	rle_percpu_destroy(&percpu);
+
+	return 0;
+
+destroy:
+	rle_percpu_destroy(&percpu);
+error:
+	return 1;
+}
+
+
 /**
  * @brief The entry point of the kernel module
  *
@@ -518,6 +863,14 @@ int __init rle_test_init(void)
 
 	pr_info("[%s] loading RLE test module...\n", THIS_MODULE->name);
 
+	/* report the footprint and the throughput before the /proc entry is used */
+	if (rle_footprint_report() != 0) {
+		goto error;
+	}
+	if (param_bench_sdus > 0 && rle_throughput_report() != 0) {
+		goto error;
+	}
+
 	/* create /proc entry for the RLE couple */
 	ret = rle_proc_init(&couple);
 	if (ret != 0) {
@@ -563,6 +916,8 @@ module_param(param_implicit_protocol_type, int, 0);
 module_param(param_use_alpdu_crc, int, 0);
 module_param(param_use_ptype_omission, int, 0);
 module_param(param_use_compressed_ptype, int, 0);
+module_param(param_bench_sdus, int, 0);
+module_param(param_bench_sdu_size, int, 0);
 
 MODULE_VERSION(PACKAGE_VERSION);
 MODULE_LICENSE("Copyright (C) 2015, Thales Alenia Space France - All Rights Reserved");
@@ -56,6 +56,9 @@
 #define _REENTRANT
 #endif
 
+#include "rle.h"
+#include "rle_alloc.h"
+
 
 /*------------------------------------------------------------------------------------------------*/
 /*---------------------------------- PUBLIC CONSTANTS AND MACROS ---------------------------------*/
@@ -73,28 +76,57 @@ enum {
 	RLE_PDU_END_FRAG,   /** END packet/fragment of PDU */
 };
 
-#define RLE_LOG(level, x, ...) \
+/** Least severe log level built in the library, less severe traces are removed at build time */
+#ifndef RLE_LOG_LEVEL_BUILD
+#define RLE_LOG_LEVEL_BUILD 4 /* RLE_LOG_LEVEL_DEBUG */
+#endif
+
+/**
+ * Trace through the callback of a transmitter or a receiver if any, within its runtime level,
+ * else through the global callback.
+ */
+#define RLE_LOG_TRACE(trace, log_level, x, ...) \
 	do { \
-		rle_trace_callback_t the_cb = rle_get_trace_callback(); \
-		if (the_cb != NULL) { \
-			the_cb(MODULE_ID, level, __FILE__, __LINE__, __func__, x, ## __VA_ARGS__); \
+		if ((log_level) <= RLE_LOG_LEVEL_BUILD) { \
+			const struct rle_trace *const the_trace = (trace); \
+			if (the_trace != NULL && the_trace->callback != NULL) { \
+				if ((log_level) <= the_trace->level) { \
+					the_trace->callback(the_trace->priv, MODULE_ID, log_level, __FILE__, \
+					                    __LINE__, __func__, x, ## __VA_ARGS__); \
+				} \
+			} else { \
+				rle_trace_callback_t the_cb = rle_get_trace_callback(); \
+				if (the_cb != NULL) { \
+					the_cb(MODULE_ID, log_level, __FILE__, __LINE__, __func__, x, ## __VA_ARGS__); \
+				} \
+			} \
 		} \
 	} while (0)
+#define RLE_LOG(level, x, ...) RLE_LOG_TRACE(NULL, level, x, ## __VA_ARGS__)
 #define RLE_DEBUG(x, ...) RLE_LOG(RLE_LOG_LEVEL_DEBUG, x, ## __VA_ARGS__)
 #define RLE_WARN(x, ...) RLE_LOG(RLE_LOG_LEVEL_WARNING, x, ## __VA_ARGS__)
 #define RLE_ERR(x, ...) RLE_LOG(RLE_LOG_LEVEL_ERROR, x, ## __VA_ARGS__)
+#define RLE_TRACE_DEBUG(trace, x, ...) RLE_LOG_TRACE(trace, RLE_LOG_LEVEL_DEBUG, x, ## __VA_ARGS__)
+#define RLE_TRACE_WARN(trace, x, ...) RLE_LOG_TRACE(trace, RLE_LOG_LEVEL_WARNING, x, ## __VA_ARGS__)
+#define RLE_TRACE_ERR(trace, x, ...) RLE_LOG_TRACE(trace, RLE_LOG_LEVEL_ERROR, x, ## __VA_ARGS__)
 
-#ifndef __KERNEL__
 
-#define MALLOC(size_bytes)      malloc(size_bytes)
-#define FREE(buf_addr)          free(buf_addr)
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PUBLIC STRUCTS AND TYPEDEFS ----------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
 
-#else
+/** Trace callback of a transmitter or a receiver */
+struct rle_trace {
+	rle_instance_trace_callback_t callback; /**< The callback, NULL for the global one */
+	void *priv;                             /**< Private data given to the callback */
+	int level;                              /**< Least severe level given to the callback */
+};
+
+/* through the allocator registered with rle_set_allocator, see rle_alloc.c */
+#define MALLOC(size_bytes)      rle_malloc(size_bytes)
+#define FREE(buf_addr)          rle_free(buf_addr)
 
-/* vmalloc allocates size with 4K modulo so for 8*2565 = 20520B it would alloc 24K
- * kmalloc allocates size with power of two so for 20520B it would alloc 32K */
-#define MALLOC(size_bytes)      kmalloc(size_bytes, GFP_KERNEL) /* vmalloc(size_bytes); */
-#define FREE(buf_addr)          kfree(buf_addr) /* vfree(buf_addr); */
+#ifdef __KERNEL__
 
 #define assert BUG_ON
 
@@ -168,3 +168,91 @@ uint32_t compute_crc(const unsigned char *data, const size_t length, const uint3
 	}
 	return crc;
 }
+
+/**
+ *  @brief   Compute several CRC32 side by side
+ *
+ *  Each CRC32 is a chain of table lookups, each one waiting for the previous one. Up to
+ *  RLE_CRC_LANES chains are interleaved so that their lookups overlap. A lane is given the next
+ *  buffer as soon as its buffer is done, so that the lanes stay busy with buffers of mixed
+ *  lengths.
+ *
+ *  @param   data      The buffers
+ *  @param   lengths   The lengths of the buffers
+ *  @param   crcs      The initial CRC values, then the CRC32 of the buffers
+ *  @param   nr        The number of buffers
+ */
+void compute_crc_lanes(const unsigned char *const data[], const size_t lengths[], uint32_t crcs[],
+                       const size_t nr)
+{
+	const unsigned char *pos[RLE_CRC_LANES];
+	size_t remain[RLE_CRC_LANES];
+	uint32_t crc[RLE_CRC_LANES];
+	size_t ids[RLE_CRC_LANES];
+	size_t active = 0;
+	size_t next = 0;
+
+	if (nr == 1) {
+		crcs[0] = compute_crc(data[0], lengths[0], crcs[0]);
+		return;
+	}
+
+	while (1) {
+		size_t common;
+		size_t lane;
+		size_t i;
+
+		/* give the free lanes the next buffers */
+		while (active < RLE_CRC_LANES && next < nr) {
+			if (lengths[next] > 0) {
+				pos[active] = data[next];
+				remain[active] = lengths[next];
+				crc[active] = crcs[next];
+				ids[active] = next;
+				active++;
+			}
+			next++;
+		}
+		if (active == 0) {
+			break;
+		}
+
+		/* run the lanes up to the end of the shortest buffer */
+		common = remain[0];
+		for (lane = 1; lane < active; lane++) {
+			if (remain[lane] < common) {
+				common = remain[lane];
+			}
+		}
+		if (active == RLE_CRC_LANES) {
+			for (i = 0; i < common; i++) {
+				for (lane = 0; lane < RLE_CRC_LANES; lane++) {
+					COMPUTE(crc[lane], pos[lane][i]);
+				}
+			}
+		} else {
+			for (i = 0; i < common; i++) {
+				for (lane = 0; lane < active; lane++) {
+					COMPUTE(crc[lane], pos[lane][i]);
+				}
+			}
+		}
+
+		/* release the lanes whose buffer is done */
+		lane = 0;
+		while (lane < active) {
+			pos[lane] += common;
+			remain[lane] -= common;
+			if (remain[lane] > 0) {
+				lane++;
+				continue;
+			}
+			crcs[ids[lane]] = crc[lane];
+			active--;
+			pos[lane] = pos[active];
+			remain[lane] = remain[active];
+			crc[lane] = crc[active];
+			ids[lane] = ids[active];
+		}
+	}
+}
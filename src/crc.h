@@ -91,6 +91,9 @@
 #define RLE_CRC_INIT GSE_CRC_INIT
 #define RLE_CRC_SIZE (sizeof(uint32_t))
 
+/** Number of CRC32 computed side by side by \ref compute_crc_lanes */
+#define RLE_CRC_LANES 8
+
 
 /*------------------------------------------------------------------------------------------------*/
 /*--------------------------------------- PUBLIC FUNCTIONS ---------------------------------------*/
@@ -99,4 +102,8 @@
 uint32_t compute_crc(const unsigned char *data, const size_t length, const uint32_t crc_init)
 __attribute__((warn_unused_result, nonnull(1)));
 
+void compute_crc_lanes(const unsigned char *const data[], const size_t lengths[], uint32_t crcs[],
+                       const size_t nr)
+__attribute__((nonnull(1, 2, 3)));
+
 #endif
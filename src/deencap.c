@@ -30,6 +30,7 @@
 #include "rle_ctx.h"
 #include "constants.h"
 #include "reassembly_buffer.h"
+#include "reassembly.h"
 #include "rle.h"
 
 #ifndef __KERNEL__
@@ -52,6 +53,420 @@
 
 #define MODULE_ID RLE_MOD_ID_DEENCAP
 
+/** Max number of PPDUs indexed at once during the decapsulation of a FPDU */
+#define RLE_DECAP_INDEX_MAX 64
+
+/** Max size of a SDU arena, for the offsets of the SDU descriptors */
+#define RLE_DECAP_ARENA_MAX_SIZE ((uint32_t)-1)
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PRIVATE STRUCTS AND TYPEDEFS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** PPDU of a FPDU, indexed before it is decapsulated */
+struct rle_ppdu_index_entry {
+	uint32_t offset;  /**< Offset of the PPDU in the FPDU                    */
+	uint16_t length;  /**< Size of the PPDU, header included                 */
+	uint8_t type;     /**< Type of the PPDU, RLE_PDU_COMPLETE for instance   */
+	uint8_t frag_id;  /**< Fragment ID, 0 for a Complete PPDU                */
+};
+
+/** Where the decapsulated SDUs are written: an array of SDU buffers, or an arena */
+struct rle_decap_output {
+	struct rle_sdu *sdus;         /**< The SDUs array, NULL with an arena       */
+	size_t sdus_max_nr;           /**< The SDUs array size                      */
+	size_t *sdus_nr;              /**< The current number of SDUs in the array  */
+	struct rle_sdu_arena *arena;  /**< The arena, NULL with a SDUs array        */
+};
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------- PRIVATE FUNCTIONS ----------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief         Decapsulate one PPDU of a FPDU.
+ *
+ * @param[in,out] receiver                The receiver module.
+ * @param[in]     ppdu                    The PPDU, whole.
+ * @param[in]     ppdu_length             The size of the PPDU.
+ * @param[in]     fpdu_remaining          The size of the FPDU from the start of the PPDU, traced
+ *                                        if the PPDU is lost.
+ * @param[in,out] out                     Where to write the SDU completed by the PPDU, if any.
+ *
+ * @return        RLE_DECAP_OK if the PPDU was parsed, RLE_DECAP_ERR if it was dropped,
+ *                RLE_DECAP_ERR_SOME_DROP if there was no SDU buffer left for it, or
+ *                RLE_DECAP_ARENA_FULL if it is left for when the arena is emptied.
+ */
+static enum rle_decap_status rle_decap_ppdu(struct rle_receiver *const receiver,
+                                            unsigned char *const ppdu,
+                                            const size_t ppdu_length,
+                                            const size_t fpdu_remaining,
+                                            const struct rle_decap_output *const out);
+
+/**
+ * @brief         Decapsulate a whole FPDU whose arguments are checked.
+ *
+ * @param[in,out] receiver                The receiver module.
+ * @param[in]     fpdu                    The FPDU to decapsulate.
+ * @param[in]     fpdu_length             The size of the FPDU.
+ * @param[in,out] out                     Where to write the SDUs, emptied by the caller.
+ * @param[in,out] payload_label           The identifier of the RCST, preallocated.
+ * @param[in]     payload_label_size      The size of the paylod label.
+ *
+ * @return        decapsulation status.
+ */
+static enum rle_decap_status rle_decap_fpdu(struct rle_receiver *const receiver,
+                                            unsigned char *const fpdu,
+                                            const size_t fpdu_length,
+                                            const struct rle_decap_output *const out,
+                                            unsigned char *const payload_label,
+                                            const size_t payload_label_size);
+
+/**
+ * @brief         Check and index the PPDUs of a FPDU.
+ *
+ *                Walk the length chain of the PPDUs from @p offset until the padding, and index
+ *                at most RLE_DECAP_INDEX_MAX of them. No context is updated.
+ *
+ * @param[in,out] receiver                The receiver module, for the errors.
+ * @param[in]     fpdu                    The FPDU.
+ * @param[in]     fpdu_length             The size of the FPDU.
+ * @param[in,out] offset                  The offset of the first PPDU to index, then the one
+ *                                        of the first PPDU not indexed.
+ * @param[out]    index                   The index.
+ * @param[out]    index_nr                The number of indexed PPDUs.
+ * @param[out]    padding_offset          The offset of the padding, if the whole chain is checked.
+ * @param[in]     check_all               Whether to check the whole chain, or to stop after the
+ *                                        last indexed PPDU.
+ *
+ * @return        C_OK if the chain is valid, else C_ERROR if a PPDU overflows the FPDU.
+ */
+static int rle_decap_index_ppdus(struct rle_receiver *const receiver,
+                                 const unsigned char *const fpdu,
+                                 const size_t fpdu_length,
+                                 size_t *const offset,
+                                 struct rle_ppdu_index_entry index[],
+                                 size_t *const index_nr,
+                                 size_t *const padding_offset,
+                                 const bool check_all);
+
+/**
+ * @brief         Check that the padding of a FPDU is all zero.
+ *
+ *                Octets are OR-ed a word at a time, the first non-zero one is only searched
+ *                if there is any.
+ *
+ * @param[in]     padding                 The padding.
+ * @param[in]     padding_length          The size of the padding.
+ * @param[out]    first_invalid           The offset of the first non-zero octet, if any.
+ *
+ * @return        true if the padding is all zero, else false.
+ */
+static bool rle_decap_is_padding(const unsigned char *const padding,
+                                 const size_t padding_length,
+                                 size_t *const first_invalid);
+
+/**
+ * @brief         Check the padding of a FPDU decapsulated by chunks.
+ *
+ *                Only the first non-zero octet of the FPDU is reported.
+ *
+ * @param[in,out] receiver                The receiver module.
+ * @param[in]     padding                 Padding bytes of the current chunk.
+ * @param[in]     padding_length          The number of padding bytes.
+ */
+static void rle_decap_stream_check_padding(struct rle_receiver *const receiver,
+                                           const unsigned char *const padding,
+                                           const size_t padding_length);
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*----------------------------------- PRIVATE FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+static enum rle_decap_status rle_decap_ppdu(struct rle_receiver *const receiver,
+                                            unsigned char *const ppdu,
+                                            const size_t ppdu_length,
+                                            const size_t fpdu_remaining,
+                                            const struct rle_decap_output *const out)
+{
+	struct rle_sdu_arena *const arena = out->arena;
+	enum rle_decap_status status = RLE_DECAP_OK;
+	struct rle_sdu arena_sdu;
+	struct rle_sdu *sdu;
+	int fragment_id;
+	int ret;
+
+	if (arena == NULL) {
+		/* stop deencapulation if there is no more SDU buffers */
+		if ((*out->sdus_nr) == out->sdus_max_nr) {
+			RLE_RECEIVER_ERR(receiver, RLE_DECAP_ERROR_SDUS_FULL,
+			                 "failed to decapsulate all SDUs from the FPDU: all %zu "
+			                 "SDU buffers are full, but FPDU is not fully parsed "
+			                 "(current %zu-byte PPDU fragment will be lost, as well "
+			                 "as the %zu bytes of FPDU that remain to be parsed)\n",
+			                 out->sdus_max_nr, ppdu_length, fpdu_remaining - ppdu_length);
+			status = RLE_DECAP_ERR_SOME_DROP;
+			goto out;
+		}
+		sdu = &out->sdus[*out->sdus_nr];
+	} else {
+		const size_t sdu_max_size = reassembly_sdu_max_size(receiver, ppdu, ppdu_length);
+
+		/* leave the PPDU for later if the SDU it may complete does not fit in the arena */
+		if (sdu_max_size > 0 && (arena->descs_nr == arena->descs_max_nr ||
+		                         sdu_max_size > (arena->size - arena->used))) {
+			if (arena->descs_nr > 0) {
+				status = RLE_DECAP_ARENA_FULL;
+				goto out;
+			}
+			RLE_RECEIVER_ERR(receiver, RLE_DECAP_ERROR_SDUS_FULL,
+			                 "failed to decapsulate all SDUs from the FPDU: the %zu-byte SDU "
+			                 "arena is too small for a SDU of up to %zu bytes (current %zu-byte "
+			                 "PPDU fragment will be lost, as well as the %zu bytes of FPDU that "
+			                 "remain to be parsed)\n", arena->size, sdu_max_size, ppdu_length,
+			                 fpdu_remaining - ppdu_length);
+			status = RLE_DECAP_ERR_SOME_DROP;
+			goto out;
+		}
+		arena_sdu.buffer = arena->buffer + arena->used;
+		arena_sdu.size = 0;
+		arena_sdu.protocol_type = 0;
+		sdu = &arena_sdu;
+	}
+
+	RLE_TRACE_DEBUG(&receiver->trace, "decapsule the %zu-byte PPDU", ppdu_length);
+	ret = rle_receiver_deencap_data(receiver, ppdu, ppdu_length, &fragment_id, sdu);
+
+	if ((ret != C_OK) && (ret != C_REASSEMBLY_OK)) {
+		/* the error is already counted and traced by the reassembly */
+		RLE_TRACE_DEBUG(&receiver->trace, "Error during reassembly\n");
+		if (fragment_id != -1) {
+			rle_receiver_free_context(receiver, fragment_id);
+		}
+		status = RLE_DECAP_ERR;
+	} else if (ret == C_REASSEMBLY_OK && arena == NULL) {
+		/* Potential SDU received. */
+		(*out->sdus_nr)++;
+	} else if (ret == C_REASSEMBLY_OK) {
+		struct rle_sdu_desc *const desc = &arena->descs[arena->descs_nr];
+
+		desc->offset = arena->used;
+		desc->size = sdu->size;
+		desc->protocol_type = sdu->protocol_type;
+		desc->frag_id = (fragment_id == -1) ? 0 : fragment_id;
+		arena->used += sdu->size;
+		arena->descs_nr++;
+	}
+
+out:
+	return status;
+}
+
+static int rle_decap_index_ppdus(struct rle_receiver *const receiver,
+                                 const unsigned char *const fpdu,
+                                 const size_t fpdu_length,
+                                 size_t *const offset,
+                                 struct rle_ppdu_index_entry index[],
+                                 size_t *const index_nr,
+                                 size_t *const padding_offset,
+                                 const bool check_all)
+{
+	size_t pos = *offset;
+
+	*index_nr = 0;
+
+	/* until there is less than 2 bytes in the FPDU payload or padding is detected */
+	while ((pos + 1) < fpdu_length && (fpdu[pos] != 0x00 || fpdu[pos + 1] != 0x00)) {
+		const rle_ppdu_hdr_t *const hdr = (const rle_ppdu_hdr_t *)&fpdu[pos];
+		struct rle_ppdu_hdr_fields fields;
+		size_t ppdu_length;
+
+		/* one load for the type, the length and the fragment ID */
+		rle_ppdu_hdr_decode(hdr, &fields);
+		ppdu_length = fields.ppdu_len + sizeof(hdr->common);
+
+		if (ppdu_length > (fpdu_length - pos)) {
+			RLE_RECEIVER_ERR(receiver, RLE_DECAP_ERROR_INV_LEN,
+			                 "Invalid fragment size, fragment length too big for FPDU "
+			                 "(fragment length = %zu, remaining FPDU size = %zu)\n",
+			                 ppdu_length, fpdu_length - pos);
+			return C_ERROR;
+		}
+
+		if ((*index_nr) < RLE_DECAP_INDEX_MAX) {
+			struct rle_ppdu_index_entry *const entry = &index[*index_nr];
+
+			entry->offset = pos;
+			entry->length = ppdu_length;
+			entry->type = fields.type;
+			entry->frag_id = fields.frag_id;
+			(*index_nr)++;
+			*offset = pos + ppdu_length;
+		} else if (!check_all) {
+			break;
+		}
+
+		pos += ppdu_length;
+	}
+
+	if (check_all) {
+		*padding_offset = pos;
+		RLE_TRACE_DEBUG(&receiver->trace, "%zu PPDU(s) indexed, padding at byte #%zu in FPDU",
+		                *index_nr, pos + 1);
+	}
+
+	return C_OK;
+}
+
+static bool rle_decap_is_padding(const unsigned char *const padding,
+                                 const size_t padding_length,
+                                 size_t *const first_invalid)
+{
+	uint64_t acc = 0;
+	size_t i;
+
+	for (i = 0; (i + sizeof(uint64_t)) <= padding_length; i += sizeof(uint64_t)) {
+		uint64_t word;
+
+		memcpy(&word, &padding[i], sizeof(uint64_t));
+		acc |= word;
+	}
+	for (; i < padding_length; i++) {
+		acc |= padding[i];
+	}
+
+	if (acc == 0) {
+		return true;
+	}
+
+	for (i = 0; padding[i] == 0x00; i++) {
+	}
+	*first_invalid = i;
+
+	return false;
+}
+
+static void rle_decap_stream_check_padding(struct rle_receiver *const receiver,
+                                           const unsigned char *const padding,
+                                           const size_t padding_length)
+{
+	struct rle_decap_stream *const stream = &receiver->stream;
+	size_t i;
+
+	if (stream->is_padding_invalid) {
+		return;
+	}
+
+	if (!rle_decap_is_padding(padding, padding_length, &i)) {
+		RLE_RECEIVER_WARN(receiver, RLE_DECAP_ERROR_PADDING,
+		                  "FPDU padding contains octets non equal to 0x00 (at least byte "
+		                  "#%zu of the %zu-byte FPDU)\n", stream->offset + i + 1,
+		                  stream->fpdu_length);
+		stream->is_padding_invalid = true;
+	}
+}
+
+static enum rle_decap_status rle_decap_fpdu(struct rle_receiver *const receiver,
+                                            unsigned char *const fpdu,
+                                            const size_t fpdu_length,
+                                            const struct rle_decap_output *const out,
+                                            unsigned char *const payload_label,
+                                            const size_t payload_label_size)
+{
+	enum rle_decap_status status = RLE_DECAP_OK;
+	const struct rle_trace *const trace = &receiver->trace;
+	struct rle_ppdu_index_entry index[RLE_DECAP_INDEX_MAX];
+	size_t index_nr = 0;
+	size_t padding_offset = 0;
+	size_t offset = 0;
+
+	if (out->arena != NULL && out->arena->resume_offset != 0) {
+		/* the payload label was already handled when the FPDU was started */
+		offset = out->arena->resume_offset;
+		out->arena->resume_offset = 0;
+		RLE_TRACE_DEBUG(trace, "resume the FPDU at byte #%zu", offset + 1);
+	} else {
+		/* drop the FPDUs addressed to other terminals before parsing them */
+		if (!rle_receiver_label_is_accepted(receiver, fpdu, payload_label_size)) {
+			receiver->fpdus_filtered++;
+			status = RLE_DECAP_FILTERED;
+			goto out;
+		}
+
+		/* copy payload label to user if present */
+		if (payload_label_size != 0) {
+			memcpy(payload_label, fpdu, payload_label_size);
+			offset += payload_label_size;
+		}
+	}
+
+	/* first pass: check the length chain of the whole FPDU and index its first PPDUs, before
+	 * any context is updated */
+	if (rle_decap_index_ppdus(receiver, fpdu, fpdu_length, &offset, index, &index_nr,
+	                          &padding_offset, true) != C_OK) {
+		status = RLE_DECAP_ERR;
+		goto out;
+	}
+
+	/* second pass: decapsulate the indexed PPDUs, then index the next ones if any */
+	while (index_nr > 0) {
+		size_t i;
+
+		for (i = 0; i < index_nr; i++) {
+			const struct rle_ppdu_index_entry *const entry = &index[i];
+			enum rle_decap_status ppdu_status;
+
+			/* the next PPDU and its context are known, load them early */
+			if ((i + 1) < index_nr) {
+				__builtin_prefetch(&fpdu[index[i + 1].offset]);
+				if (index[i + 1].type != RLE_PDU_COMPLETE) {
+					__builtin_prefetch(&receiver->rle_ctx_man[index[i + 1].frag_id]);
+				}
+			}
+
+			ppdu_status = rle_decap_ppdu(receiver, &fpdu[entry->offset], entry->length,
+			                             fpdu_length - entry->offset, out);
+			if (ppdu_status == RLE_DECAP_ARENA_FULL) {
+				RLE_TRACE_DEBUG(trace, "SDU arena full, FPDU to be resumed at byte #%zu",
+				                (size_t)entry->offset + 1);
+				out->arena->resume_offset = entry->offset;
+				status = ppdu_status;
+				goto out;
+			} else if (ppdu_status == RLE_DECAP_ERR_SOME_DROP) {
+				status = ppdu_status;
+				goto out;
+			} else if (ppdu_status != RLE_DECAP_OK) {
+				status = ppdu_status;
+			}
+		}
+
+		if (offset >= padding_offset) {
+			break;
+		}
+		/* the length chain is already checked */
+		(void) rle_decap_index_ppdus(receiver, fpdu, fpdu_length, &offset, index, &index_nr,
+		                             &padding_offset, false);
+	}
+
+	/* remaining FPDU bytes are padding: they should be all zero, warn if it is not the case */
+	RLE_TRACE_DEBUG(trace, "%zu-byte padding detected", fpdu_length - padding_offset);
+	if (!rle_decap_is_padding(&fpdu[padding_offset], fpdu_length - padding_offset, &offset)) {
+		RLE_RECEIVER_WARN(receiver, RLE_DECAP_ERROR_PADDING,
+		                  "FPDU padding contains octets non equal to 0x00 (at least byte "
+		                  "#%zu of the %zu-byte FPDU)\n", padding_offset + offset + 1,
+		                  fpdu_length);
+	}
+
+	RLE_TRACE_DEBUG(trace, "%zu SDU(s) decapsuled from FPDU",
+	                (out->arena != NULL) ? out->arena->descs_nr : *out->sdus_nr);
+
+out:
+	return status;
+}
+
 
 /*------------------------------------------------------------------------------------------------*/
 /*--------------------------------------- PUBLIC FUNCTIONS ---------------------------------------*/
@@ -67,14 +482,15 @@ enum rle_decap_status rle_decapsulate(struct rle_receiver *const receiver,
                                       const size_t payload_label_size)
 {
 	enum rle_decap_status status = RLE_DECAP_ERR;
-	int padding_detected = false;
-	size_t offset = 0;
+	const struct rle_decap_output out = { sdus, sdus_max_nr, sdus_nr, NULL };
+	const struct rle_trace *trace;
 
 	/* checks inputs */
 	if (receiver == NULL) {
 		status = RLE_DECAP_ERR_NULL_RCVR;
 		goto out;
 	}
+	trace = &receiver->trace;
 
 	if ((fpdu == NULL) || (fpdu_length == 0)) {
 		status = RLE_DECAP_ERR_INV_FPDU;
@@ -85,8 +501,8 @@ enum rle_decap_status rle_decapsulate(struct rle_receiver *const receiver,
 		status = RLE_DECAP_ERR_INV_FPDU;
 		goto out;
 	}
-	RLE_DEBUG("decapsulate one %zu-byte FPDU with a %zu-byte Payload Label",
-	          fpdu_length, payload_label_size);
+	RLE_TRACE_DEBUG(trace, "decapsulate one %zu-byte FPDU with a %zu-byte Payload Label",
+	                fpdu_length, payload_label_size);
 
 	if (sdus == NULL || sdus_max_nr == 0 || sdus_nr == NULL) {
 		status = RLE_DECAP_ERR_INV_SDUS;
@@ -106,85 +522,313 @@ enum rle_decap_status rle_decapsulate(struct rle_receiver *const receiver,
 	/* no SDUs decapsulated yet */
 	*sdus_nr = 0;
 
-	/* copy payload label to user if present */
-	if (payload_label_size != 0) {
-		memcpy(payload_label, fpdu, payload_label_size);
-		offset += payload_label_size;
+	status = rle_decap_fpdu(receiver, fpdu, fpdu_length, &out, payload_label, payload_label_size);
+
+out:
+	return status;
+}
+
+enum rle_decap_status rle_decapsulate_arena(struct rle_receiver *const receiver,
+                                            unsigned char *const fpdu,
+                                            const size_t fpdu_length,
+                                            struct rle_sdu_arena *const arena,
+                                            unsigned char *const payload_label,
+                                            const size_t payload_label_size)
+{
+	enum rle_decap_status status = RLE_DECAP_ERR;
+	const struct rle_decap_output out = { NULL, 0, NULL, arena };
+
+	/* checks inputs */
+	if (receiver == NULL) {
+		status = RLE_DECAP_ERR_NULL_RCVR;
+		goto out;
+	}
+
+	if ((fpdu == NULL) || (fpdu_length == 0)) {
+		status = RLE_DECAP_ERR_INV_FPDU;
+		goto out;
+	}
+
+	if ((fpdu_length < payload_label_size)) {
+		status = RLE_DECAP_ERR_INV_FPDU;
+		goto out;
+	}
+	RLE_TRACE_DEBUG(&receiver->trace, "decapsulate one %zu-byte FPDU with a %zu-byte Payload "
+	                "Label in a SDU arena", fpdu_length, payload_label_size);
+
+	if (arena == NULL || arena->buffer == NULL || arena->size > RLE_DECAP_ARENA_MAX_SIZE ||
+	    arena->used > arena->size || arena->descs == NULL || arena->descs_max_nr == 0 ||
+	    arena->descs_nr > arena->descs_max_nr) {
+		status = RLE_DECAP_ERR_INV_SDUS;
+		goto out;
+	}
+
+	/* a FPDU is resumed on one of its PPDUs */
+	if (arena->resume_offset != 0 &&
+	    (arena->resume_offset < payload_label_size || arena->resume_offset >= fpdu_length)) {
+		status = RLE_DECAP_ERR_INV_FPDU;
+		goto out;
+	}
+
+	if ((payload_label == NULL) ^ (payload_label_size == 0)) {
+		status = RLE_DECAP_ERR_INV_PL;
+		goto out;
+	}
+
+	if ((payload_label_size != 0) && (payload_label_size != 3) && (payload_label_size != 6)) {
+		status = RLE_DECAP_ERR_INV_PL;
+		goto out;
 	}
 
+	status = rle_decap_fpdu(receiver, fpdu, fpdu_length, &out, payload_label, payload_label_size);
+
+out:
+	return status;
+}
+
+enum rle_decap_status rle_decap_stream_begin(struct rle_receiver *const receiver,
+                                             const size_t fpdu_length,
+                                             const size_t payload_label_size)
+{
+	enum rle_decap_status status = RLE_DECAP_ERR;
+	struct rle_decap_stream *stream;
+
+	if (receiver == NULL) {
+		status = RLE_DECAP_ERR_NULL_RCVR;
+		goto out;
+	}
+	stream = &receiver->stream;
+
+	if ((fpdu_length == 0) || (fpdu_length < payload_label_size)) {
+		status = RLE_DECAP_ERR_INV_FPDU;
+		goto out;
+	}
+
+	if ((payload_label_size != 0) && (payload_label_size != 3) && (payload_label_size != 6)) {
+		status = RLE_DECAP_ERR_INV_PL;
+		goto out;
+	}
+
+	/* a FPDU still in progress is lost */
+	if (stream->state != RLE_DECAP_STREAM_IDLE && stream->offset < stream->fpdu_length) {
+		RLE_RECEIVER_ERR(receiver, RLE_DECAP_ERROR_INV_LEN,
+		                 "FPDU truncated: only %zu bytes of the %zu-byte FPDU were received\n",
+		                 stream->offset, stream->fpdu_length);
+	}
+
+	RLE_TRACE_DEBUG(&receiver->trace, "decapsulate one %zu-byte FPDU by chunks with a "
+	                "%zu-byte Payload Label", fpdu_length, payload_label_size);
+
+	stream->state = RLE_DECAP_STREAM_PPDU;
+	stream->fpdu_length = fpdu_length;
+	stream->offset = 0;
+	stream->label_size = payload_label_size;
+	stream->carry_len = 0;
+	stream->is_padding_invalid = false;
+
 	status = RLE_DECAP_OK;
 
-	/* parse all PPDUs that the FPDU contains until there is less than 2 bytes
-	 * in the FPDU payload and padding is not detected */
-	while ((offset + 1) < fpdu_length && !padding_detected) {
-		unsigned char *const ppdu = &fpdu[offset];
+out:
+	return status;
+}
+
+enum rle_decap_status rle_decap_stream_push(struct rle_receiver *const receiver,
+                                            unsigned char *const chunk,
+                                            const size_t chunk_length,
+                                            struct rle_sdu sdus[],
+                                            const size_t sdus_max_nr,
+                                            size_t *const sdus_nr)
+{
+	enum rle_decap_status status = RLE_DECAP_ERR;
+	const struct rle_decap_output out = { sdus, sdus_max_nr, sdus_nr, NULL };
+	struct rle_decap_stream *stream;
+	size_t pos = 0;
+
+	if (receiver == NULL) {
+		status = RLE_DECAP_ERR_NULL_RCVR;
+		goto out;
+	}
+	stream = &receiver->stream;
+
+	if ((chunk == NULL) || (chunk_length == 0) || (stream->state == RLE_DECAP_STREAM_IDLE) ||
+	    (chunk_length > (stream->fpdu_length - stream->offset))) {
+		status = RLE_DECAP_ERR_INV_FPDU;
+		goto out;
+	}
+
+	if (sdus == NULL || sdus_max_nr == 0 || sdus_nr == NULL) {
+		status = RLE_DECAP_ERR_INV_SDUS;
+		goto out;
+	}
+
+	/* no SDUs decapsulated yet */
+	*sdus_nr = 0;
+
+	status = (stream->state == RLE_DECAP_STREAM_FILTERED) ? RLE_DECAP_FILTERED : RLE_DECAP_OK;
+
+	/* parse all the PPDUs that end in the chunk, carry over the one that straddles its end */
+	while (pos < chunk_length && stream->state == RLE_DECAP_STREAM_PPDU) {
+		const size_t ppdu_start = stream->offset - stream->carry_len;
+		const size_t avail = chunk_length - pos;
+		enum rle_decap_status ppdu_status;
+		unsigned char *ppdu;
 		size_t ppdu_length;
-		int fragment_id;
-		int ret;
+		size_t len;
+
+		/* payload label first */
+		if (stream->offset < stream->label_size) {
+			len = stream->label_size - stream->offset;
+			len = (len < avail) ? len : avail;
+			memcpy(&stream->label[stream->offset], &chunk[pos], len);
+			pos += len;
+			stream->offset += len;
+
+			/* drop the FPDUs addressed to other terminals before parsing them */
+			if (stream->offset == stream->label_size &&
+			    !rle_receiver_label_is_accepted(receiver, stream->label, stream->label_size)) {
+				receiver->fpdus_filtered++;
+				stream->state = RLE_DECAP_STREAM_FILTERED;
+				status = RLE_DECAP_FILTERED;
+			}
+			continue;
+		}
+
+		/* less than 2 bytes left in the FPDU payload: padding */
+		if ((stream->fpdu_length - ppdu_start) < 2) {
+			stream->state = RLE_DECAP_STREAM_PADDING;
+			break;
+		}
+
+		/* PPDU header, from the chunk if it holds it whole, else from the carry-over */
+		if (stream->carry_len == 0 && avail >= 2) {
+			ppdu = &chunk[pos];
+		} else {
+			if (stream->carry_len < 2) {
+				len = 2 - stream->carry_len;
+				len = (len < avail) ? len : avail;
+				memcpy(&stream->carry[stream->carry_len], &chunk[pos], len);
+				stream->carry_len += len;
+				pos += len;
+				stream->offset += len;
+				if (stream->carry_len < 2) {
+					continue;
+				}
+			}
+			ppdu = stream->carry;
+		}
 
 		/* is there padding? */
 		if (ppdu[0] == 0x00 && ppdu[1] == 0x00) {
-			RLE_DEBUG("padding detected at byte #%zu in FPDU", offset + 1);
-			padding_detected = true;
-			continue;
+			RLE_TRACE_DEBUG(&receiver->trace, "padding detected at byte #%zu in FPDU",
+			                ppdu_start + 1);
+			stream->carry_len = 0;
+			stream->state = RLE_DECAP_STREAM_PADDING;
+			break;
 		}
 
-		/* retrieve the fragment type and length in the first 2 bytes of the PPDU fragment */
 		ppdu_length = get_fragment_length(ppdu);
-		RLE_DEBUG("%zu-byte PPDU detected at byte #%zu in FPDU", ppdu_length, offset + 1);
-
-		/* stop parsing the FPDU if the PPDU length is wrong */
-		if (ppdu_length > (fpdu_length - offset)) {
-			RLE_ERR("Invalid fragment size, fragment length too big for FPDU "
-			        "(fragment length = %zu, remaining FPDU size = %zu)\n",
-			        ppdu_length, fpdu_length - offset);
+		RLE_TRACE_DEBUG(&receiver->trace, "%zu-byte PPDU detected at byte #%zu in FPDU",
+		                ppdu_length, ppdu_start + 1);
+
+		/* drop the rest of the FPDU if the PPDU length is wrong */
+		if (ppdu_length > (stream->fpdu_length - ppdu_start)) {
+			RLE_RECEIVER_ERR(receiver, RLE_DECAP_ERROR_INV_LEN,
+			                 "Invalid fragment size, fragment length too big for FPDU "
+			                 "(fragment length = %zu, remaining FPDU size = %zu)\n",
+			                 ppdu_length, stream->fpdu_length - ppdu_start);
+			stream->carry_len = 0;
+			stream->state = RLE_DECAP_STREAM_SKIP;
 			status = RLE_DECAP_ERR;
-			goto out;
+			break;
 		}
 
-		/* stop deencapulation if there is no more SDU buffers */
-		if ((*sdus_nr) == sdus_max_nr) {
-			RLE_ERR("failed to decapsulate all SDUs from the FPDU: all %zu "
-			        "SDU buffers are full, but FPDU is not fully parsed "
-			        "(current %zu-byte PPDU fragment will be lost, as well "
-			        "as the %zu bytes of FPDU that remain to be parsed)\n",
-			        sdus_max_nr, ppdu_length, fpdu_length - offset);
-			status = RLE_DECAP_ERR_SOME_DROP;
-			goto out;
+		if (stream->carry_len == 0 && avail >= ppdu_length) {
+			/* whole PPDU in the chunk, decapsulate it in place */
+			pos += ppdu_length;
+			stream->offset += ppdu_length;
+		} else {
+			/* PPDU straddles chunks, carry its bytes over until it is complete */
+			len = ppdu_length - stream->carry_len;
+			len = (len < (chunk_length - pos)) ? len : (chunk_length - pos);
+			memcpy(&stream->carry[stream->carry_len], &chunk[pos], len);
+			stream->carry_len += len;
+			pos += len;
+			stream->offset += len;
+			if (stream->carry_len < ppdu_length) {
+				continue;
+			}
+			ppdu = stream->carry;
+			stream->carry_len = 0;
 		}
 
-		/* parse the PPDU fragment */
-		RLE_DEBUG("decapsule the %zu-byte PPDU", ppdu_length);
-		ret = rle_receiver_deencap_data(receiver, ppdu, ppdu_length, &fragment_id,
-		                                &sdus[*sdus_nr]);
-
-		/* PPDU fragment successfully parsed, skip it */
-		offset += ppdu_length;
-
-		if ((ret != C_OK) && (ret != C_REASSEMBLY_OK)) {
-			RLE_ERR("Error during reassembly\n");
-			if (fragment_id != -1) {
-				rle_receiver_free_context(receiver, fragment_id);
-			}
-			status = RLE_DECAP_ERR;
-		} else if (ret == C_REASSEMBLY_OK) {
-			/* Potential SDU received. */
-			(*sdus_nr)++;
+		ppdu_status = rle_decap_ppdu(receiver, ppdu, ppdu_length,
+		                             stream->fpdu_length - ppdu_start, &out);
+		if (ppdu_status == RLE_DECAP_ERR_SOME_DROP) {
+			stream->state = RLE_DECAP_STREAM_SKIP;
+			status = ppdu_status;
+			break;
+		} else if (ppdu_status != RLE_DECAP_OK) {
+			status = ppdu_status;
 		}
-		RLE_DEBUG("%zu bytes remaining to be parsed in FPDU", fpdu_length - offset);
 	}
 
-	/* remaining FPDU bytes are padding: they should be all zero, warn if it is not the case */
-	RLE_DEBUG("%zu-byte padding detected", fpdu_length - offset);
-	for (; offset < fpdu_length; offset++) {
-		if (fpdu[offset] != 0x00) {
-			RLE_WARN("FPDU padding contains octets non equal to 0x00 (at least byte "
-			         "#%zu of the %zu-byte FPDU)\n", offset + 1, fpdu_length);
-			break; /* stop padding verification after first error */
+	/* the remaining bytes of the chunk are padding, or dropped after an error */
+	if (pos < chunk_length) {
+		if (stream->state == RLE_DECAP_STREAM_PADDING) {
+			rle_decap_stream_check_padding(receiver, &chunk[pos], chunk_length - pos);
 		}
+		stream->offset += chunk_length - pos;
+	}
+
+	RLE_TRACE_DEBUG(&receiver->trace, "%zu SDU(s) decapsuled from %zu-byte chunk, %zu bytes "
+	                "remaining in FPDU", *sdus_nr, chunk_length,
+	                stream->fpdu_length - stream->offset);
+
+out:
+	return status;
+}
+
+enum rle_decap_status rle_decap_stream_end(struct rle_receiver *const receiver,
+                                           unsigned char *const payload_label,
+                                           const size_t payload_label_size)
+{
+	enum rle_decap_status status = RLE_DECAP_ERR;
+	struct rle_decap_stream *stream;
+
+	if (receiver == NULL) {
+		status = RLE_DECAP_ERR_NULL_RCVR;
+		goto out;
+	}
+	stream = &receiver->stream;
+
+	if (stream->state == RLE_DECAP_STREAM_IDLE) {
+		status = RLE_DECAP_ERR_INV_FPDU;
+		goto out;
+	}
+
+	if (((payload_label == NULL) ^ (payload_label_size == 0)) ||
+	    (payload_label_size != stream->label_size)) {
+		status = RLE_DECAP_ERR_INV_PL;
+		goto out;
+	}
+
+	if (stream->offset < stream->fpdu_length) {
+		/* the PPDU carried over, if any, is lost */
+		RLE_RECEIVER_ERR(receiver, RLE_DECAP_ERROR_INV_LEN,
+		                 "FPDU truncated: only %zu bytes of the %zu-byte FPDU were received\n",
+		                 stream->offset, stream->fpdu_length);
+		status = RLE_DECAP_ERR_INV_FPDU;
+	} else {
+		status = RLE_DECAP_OK;
+	}
+
+	/* copy payload label to user if received */
+	if (payload_label_size != 0 && stream->offset >= payload_label_size) {
+		memcpy(payload_label, stream->label, payload_label_size);
 	}
 
-	RLE_DEBUG("%zu SDU(s) decapsuled from FPDU", *sdus_nr);
+	stream->state = RLE_DECAP_STREAM_IDLE;
+	stream->carry_len = 0;
 
 out:
 	return status;
@@ -69,37 +69,77 @@ static void set_nonfree_frag_ctx(struct rle_transmitter *const _this, const size
 	rle_ctx_set_nonfree(&_this->free_ctx, ctx_index);
 }
 
+/**
+ * @brief         Tell whether the ALPDUs of a transmitter are protected by a CRC.
+ *
+ * @param[in]     transmitter             The transmitter module.
+ *
+ * @return        true if the ALPDUs end with a CRC, false if with a sequence number.
+ */
+static bool use_alpdu_crc(const struct rle_transmitter *const transmitter)
+{
+	return (transmitter->conf.allow_alpdu_sequence_number == 0 &&
+	        transmitter->conf.allow_alpdu_crc == 1);
+}
 
-/*------------------------------------------------------------------------------------------------*/
-/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
-/*------------------------------------------------------------------------------------------------*/
+/**
+ * @brief         Build the ALPDU header of the SDU of a fragmentation buffer.
+ *
+ * @param[in]     transmitter             The transmitter module.
+ * @param[in,out] frag_buf                The fragmentation buffer.
+ * @param[in]     with_crc                Whether the CRC of the SDU is computed now, else it is
+ *                                        set later by the caller.
+ */
+static void encap_alpdu(const struct rle_transmitter *const transmitter,
+                        struct rle_frag_buf *const frag_buf,
+                        const bool with_crc)
+{
+	if (with_crc && use_alpdu_crc(transmitter)) {
+		frag_buf->crc = compute_crc32(&frag_buf->sdu_info);
+	}
 
-enum rle_encap_status rle_encapsulate(struct rle_transmitter *const transmitter,
-                                      const struct rle_sdu *const sdu,
-                                      const uint8_t frag_id)
+	push_alpdu_hdr(frag_buf, &transmitter->conf);
+}
+
+/**
+ * @brief         Encapsulate an SDU in a context, copied or in place.
+ *
+ * @param[in,out] transmitter             The transmitter module.
+ * @param[in]     sdu                     The SDU to encapsulate.
+ * @param[in]     sdu_buf                 The buffer of the SDU to encapsulate in place, NULL to
+ *                                        copy the SDU in the context.
+ * @param[in]     frag_id                 The context of the SDU.
+ * @param[in]     with_alpdu              Whether the ALPDU is built now, else the caller sets
+ *                                        the CRC then builds it with \ref encap_alpdu.
+ *
+ * @return        Encapsulation status.
+ */
+static enum rle_encap_status encapsulate(struct rle_transmitter *const transmitter,
+                                         const struct rle_sdu *const sdu,
+                                         const struct rle_sdu_buf *const sdu_buf,
+                                         const uint8_t frag_id,
+                                         const bool with_alpdu)
 {
 	enum rle_encap_status status = RLE_ENCAP_ERR;
-	enum rle_encap_status ret_encap;
 	struct rle_ctx_mngt *rle_ctx;
 	rle_frag_buf_t *frag_buf;
+	const struct rle_trace *trace;
+	uint64_t lat_start;
 	int ret;
 
-#ifdef TIME_DEBUG
-	struct timeval tv_start = { .tv_sec = 0L, .tv_usec = 0L };
-	struct timeval tv_end = { .tv_sec = 0L, .tv_usec = 0L };
-	struct timeval tv_delta;
-	gettimeofday(&tv_start, NULL);
-#endif
-
 	if (transmitter == NULL) {
 		status = RLE_ENCAP_ERR_NULL_TRMT;
 		goto out;
 	}
 
+	trace = &transmitter->trace;
+	lat_start = rle_latency_start(transmitter->latency);
+
 	if (sdu == NULL || frag_id >= RLE_MAX_FRAG_NUMBER) {
 		goto out;
 	}
-	RLE_DEBUG("encapsulate one %zu-byte SDU in context with ID %u", sdu->size, frag_id);
+	RLE_TRACE_DEBUG(trace,
+	                "encapsulate one %zu-byte SDU in context with ID %u", sdu->size, frag_id);
 
 	rle_ctx = &transmitter->rle_ctx_man[frag_id];
 	frag_buf = (rle_frag_buf_t *)rle_ctx->buff;
@@ -110,8 +150,13 @@ enum rle_encap_status rle_encapsulate(struct rle_transmitter *const transmitter,
 		goto out;
 	}
 
+	if (sdu_buf != NULL && !frag_buf_sdu_buf_is_valid(sdu_buf)) {
+		RLE_TRACE_ERR(trace, "SDU buffer without enough headroom or tailroom");
+		goto out;
+	}
+
 	if (is_frag_ctx_free(transmitter, frag_id) == false) {
-		RLE_ERR("frag id %d is not free", frag_id);
+		RLE_TRACE_ERR(trace, "frag id %d is not free", frag_id);
 		goto out;
 	}
 
@@ -121,30 +166,122 @@ enum rle_encap_status rle_encapsulate(struct rle_transmitter *const transmitter,
 	ret = rle_frag_buf_init(frag_buf);
 	assert(ret == 0); /* cannot fail since frag_buf is not NULL */
 
-	ret = rle_frag_buf_cpy_sdu(frag_buf, sdu);
+	if (sdu_buf != NULL) {
+		ret = rle_frag_buf_attach_sdu(frag_buf, sdu_buf);
+	} else {
+		ret = rle_frag_buf_cpy_sdu(frag_buf, sdu);
+	}
 	assert(ret == 0); /* cannot fail since SDU length was already checked */
 
-	ret_encap = rle_encap_contextless(transmitter, frag_buf);
-	assert(ret_encap == RLE_ENCAP_OK); /* no way to fail here */
+	if (with_alpdu) {
+		encap_alpdu(transmitter, frag_buf, true);
+	}
 
 	rle_ctx_incr_counter_in(rle_ctx);
 	rle_ctx_incr_counter_bytes_in(rle_ctx, sdu->size);
+	rle_sched_set_sdu(&transmitter->sched, frag_id, 0, RLE_SDU_NO_DEADLINE);
 
-#ifdef TIME_DEBUG
-	gettimeofday(&tv_end, NULL);
-	tv_delta.tv_sec = tv_end.tv_sec - tv_start.tv_sec;
-	tv_delta.tv_usec = tv_end.tv_usec - tv_start.tv_usec;
-	RLE_DEBUG("duration [%04ld.%06ld]\n", tv_delta.tv_sec, tv_delta.tv_usec);
-#endif
+	rle_latency_stop(transmitter->latency, RLE_LATENCY_STAGE_ENCAP, frag_id, lat_start);
 
 	status = RLE_ENCAP_OK;
-	RLE_DEBUG("%zu-byte SDU successfully encapsulated in context with ID %u",
-	          sdu->size, frag_id);
+	RLE_TRACE_DEBUG(trace, "%zu-byte SDU successfully encapsulated in context with ID %u",
+	                sdu->size, frag_id);
+
+out:
+	return status;
+}
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+enum rle_encap_status rle_encapsulate(struct rle_transmitter *const transmitter,
+                                      const struct rle_sdu *const sdu,
+                                      const uint8_t frag_id)
+{
+	return encapsulate(transmitter, sdu, NULL, frag_id, true);
+}
+
+enum rle_encap_status rle_encapsulate_bulk(struct rle_transmitter *const transmitter,
+                                           const struct rle_sdu sdus[],
+                                           const uint8_t frag_ids[],
+                                           const size_t sdus_nr,
+                                           size_t *const encap_nr)
+{
+	enum rle_encap_status status = RLE_ENCAP_OK;
+	const struct rle_sdu *crc_sdus[RLE_MAX_FRAG_NUMBER] = { NULL };
+	rle_frag_buf_t *frag_bufs[RLE_MAX_FRAG_NUMBER];
+	uint32_t crcs[RLE_MAX_FRAG_NUMBER];
+	size_t i;
+
+	if (encap_nr != NULL) {
+		*encap_nr = 0;
+	}
+
+	if (transmitter == NULL) {
+		status = RLE_ENCAP_ERR_NULL_TRMT;
+		goto out;
+	}
+
+	if (sdus == NULL || frag_ids == NULL || encap_nr == NULL) {
+		status = RLE_ENCAP_ERR;
+		goto out;
+	}
+
+	/* the CRC are computed side by side once the SDUs are in their contexts, and before the
+	 * ALPDU headers are built since the omission of the VLAN protocol type moves the SDU */
+	for (i = 0; i < sdus_nr; ++i) {
+		status = encapsulate(transmitter, &sdus[i], NULL, frag_ids[i], false);
+		if (status != RLE_ENCAP_OK) {
+			break;
+		}
+
+		/* a context is used once, the SDUs encapsulated are at most as many as the contexts */
+		assert(*encap_nr < RLE_MAX_FRAG_NUMBER);
+		frag_bufs[*encap_nr] = (rle_frag_buf_t *)transmitter->rle_ctx_man[frag_ids[i]].buff;
+		crc_sdus[*encap_nr] = &frag_bufs[*encap_nr]->sdu_info;
+		(*encap_nr)++;
+	}
+
+	if (use_alpdu_crc(transmitter)) {
+		compute_crc32_lanes(crc_sdus, *encap_nr, crcs);
+		for (i = 0; i < *encap_nr; ++i) {
+			frag_bufs[i]->crc = crcs[i];
+		}
+	}
+	for (i = 0; i < *encap_nr; ++i) {
+		encap_alpdu(transmitter, frag_bufs[i], false);
+	}
 
 out:
 	return status;
 }
 
+enum rle_encap_status rle_encapsulate_in_place(struct rle_transmitter *const transmitter,
+                                               const struct rle_sdu_buf *const sdu_buf,
+                                               const uint8_t frag_id)
+{
+	struct rle_sdu sdu;
+
+	assert(RLE_SDU_BUF_HEADROOM == sizeof(rle_ppdu_hdr_t) + sizeof(rle_alpdu_hdr_t));
+	assert(RLE_SDU_BUF_TAILROOM == sizeof(rle_alpdu_trailer_t));
+
+	if (transmitter == NULL) {
+		return RLE_ENCAP_ERR_NULL_TRMT;
+	}
+
+	if (sdu_buf == NULL) {
+		return RLE_ENCAP_ERR;
+	}
+
+	sdu.buffer = sdu_buf->head + sdu_buf->data_offset;
+	sdu.size = sdu_buf->data_len;
+	sdu.protocol_type = sdu_buf->protocol_type;
+
+	return encapsulate(transmitter, &sdu, sdu_buf, frag_id, true);
+}
+
 enum rle_encap_status rle_encap_contextless(struct rle_transmitter *const transmitter,
                                             struct rle_frag_buf *const frag_buf)
 {
@@ -165,12 +302,7 @@ enum rle_encap_status rle_encap_contextless(struct rle_transmitter *const transm
 		goto out;
 	}
 
-	if (transmitter->conf.allow_alpdu_sequence_number == 0 &&
-	    transmitter->conf.allow_alpdu_crc == 1) {
-		frag_buf->crc = compute_crc32(&frag_buf->sdu_info);
-	}
-
-	push_alpdu_hdr(frag_buf, &transmitter->conf);
+	encap_alpdu(transmitter, frag_buf, true);
 	status = RLE_ENCAP_OK;
 
 out:
@@ -33,6 +33,7 @@
 #include "constants.h"
 #include "rle_ctx.h"
 #include "crc.h"
+#include "trailer.h"
 #include "rle_header_proto_type_field.h"
 
 #include "rle.h"
@@ -95,7 +96,8 @@ enum rle_frag_status rle_fragment(struct rle_transmitter *const transmitter,
 
 	frag_buf_ppdu_init(frag_buf);
 
-	if (!push_ppdu_hdr(frag_buf, &transmitter->conf, remaining_burst_size, rle_ctx)) {
+	if (!push_ppdu_hdr(frag_buf, &transmitter->conf, remaining_burst_size, rle_ctx,
+	                   &transmitter->trace)) {
 		/* Burst to small for header. */
 		status = RLE_FRAG_ERR_BURST_TOO_SMALL;
 		goto out;
@@ -120,6 +122,87 @@ out:
 	return status;
 }
 
+int rle_fragment_estimate(const struct rle_config *const conf,
+                          const struct rle_sdu *const sdu,
+                          const size_t burst_sizes[],
+                          const size_t bursts_nr,
+                          struct rle_frag_estimate *const estimate)
+{
+	const bool use_alpdu_crc =
+		(conf != NULL && !conf->allow_alpdu_sequence_number && conf->allow_alpdu_crc);
+	const size_t trailer_len =
+		(use_alpdu_crc ? sizeof(rle_alpdu_crc_trailer_t) : sizeof(rle_alpdu_seqno_trailer_t));
+	struct alpdu_hdr_choice alpdu_hdr;
+	size_t remain_alpdu_len;
+	bool is_fragmented = false;
+	int status = 1;
+	size_t i;
+
+	if (conf == NULL || sdu == NULL || sdu->buffer == NULL || estimate == NULL ||
+	    (burst_sizes == NULL && bursts_nr > 0)) {
+		goto out;
+	}
+	if (sdu->size == 0 || sdu->size > RLE_MAX_PDU_SIZE) {
+		goto out;
+	}
+
+	memset(estimate, 0, sizeof(struct rle_frag_estimate));
+
+	choose_alpdu_hdr(sdu->protocol_type, sdu->buffer, sdu->size, conf, &alpdu_hdr);
+	remain_alpdu_len = alpdu_hdr.len + sdu->size;
+	if (alpdu_hdr.omit_vlan_ptype) {
+		remain_alpdu_len -= sizeof(uint16_t);
+	}
+	estimate->header_bytes = alpdu_hdr.len;
+
+	for (i = 0; i < bursts_nr && remain_alpdu_len > 0; ++i) {
+		struct ppdu_choice ppdu;
+		size_t ppdu_len;
+
+		estimate->bursts_nr++;
+
+		if (!choose_ppdu(conf, burst_sizes[i], is_fragmented, remain_alpdu_len, alpdu_hdr.len,
+		                 &ppdu)) {
+			/* rle_fragment refuses the burst, the whole burst is left */
+			estimate->padding_bytes += burst_sizes[i];
+			continue;
+		}
+
+		switch (ppdu.type) {
+		case RLE_PDU_START_FRAG:
+			/* the trailer is appended with the START PPDU */
+			remain_alpdu_len += trailer_len;
+			estimate->trailer_bytes = trailer_len;
+			is_fragmented = true;
+			ppdu_len = sizeof(rle_ppdu_hdr_start_t);
+			break;
+		case RLE_PDU_CONT_FRAG:
+		case RLE_PDU_END_FRAG:
+			ppdu_len = sizeof(rle_ppdu_hdr_cont_end_t);
+			break;
+		case RLE_PDU_COMPLETE:
+		default:
+			ppdu_len = sizeof(rle_ppdu_hdr_comp_t);
+			break;
+		}
+
+		estimate->header_bytes += ppdu_len;
+		ppdu_len += ppdu.alpdu_frag_len;
+		remain_alpdu_len -= ppdu.alpdu_frag_len;
+
+		estimate->ppdus_nr++;
+		estimate->ppdu_bytes += ppdu_len;
+		estimate->padding_bytes += burst_sizes[i] - ppdu_len;
+	}
+
+	estimate->remaining_bytes = remain_alpdu_len;
+
+	status = 0;
+
+out:
+	return status;
+}
+
 enum rle_frag_status rle_frag_contextless(struct rle_transmitter *const transmitter,
                                           struct rle_frag_buf *const frag_buf,
                                           unsigned char **const ppdu,
@@ -156,7 +239,8 @@ enum rle_frag_status rle_frag_contextless(struct rle_transmitter *const transmit
 
 	frag_buf_ppdu_init(frag_buf);
 
-	if (!push_ppdu_hdr(frag_buf, &transmitter->conf, *ppdu_length, NULL)) {
+	if (!push_ppdu_hdr(frag_buf, &transmitter->conf, *ppdu_length, NULL,
+	                   &transmitter->trace)) {
 		goto out;
 	}
 
@@ -56,9 +56,19 @@
 /*------------------------------------------------------------------------------------------------*/
 
 struct rle_frag_buf * rle_frag_buf_new(void)
+{
+	return rle_frag_buf_new_with_allocator(NULL);
+}
+
+void rle_frag_buf_del(struct rle_frag_buf **const frag_buf)
+{
+	rle_frag_buf_del_with_allocator(NULL, frag_buf);
+}
+
+struct rle_frag_buf * rle_frag_buf_new_with_allocator(const struct rle_allocator *const allocator)
 {
 	struct rle_frag_buf *frag_buf =
-		(struct rle_frag_buf *)MALLOC(sizeof(struct rle_frag_buf));
+		(struct rle_frag_buf *)rle_allocator_alloc(allocator, sizeof(struct rle_frag_buf));
 
 	if (!frag_buf) {
 		RLE_ERR("fragmentation buffer not allocated");
@@ -68,13 +78,21 @@ struct rle_frag_buf * rle_frag_buf_new(void)
 	frag_buf->sdu.frag_buf = frag_buf;
 	frag_buf->alpdu.frag_buf = frag_buf;
 	frag_buf->ppdu.frag_buf = frag_buf;
+	frag_buf->base = frag_buf->buffer;
+	frag_buf->base_size = sizeof(frag_buf->buffer);
+
+	/* empty until rle_frag_buf_init, so that it is never seen in use */
+	frag_buf_ptrs_set(&frag_buf->sdu, frag_buf->buffer);
+	frag_buf_ptrs_set(&frag_buf->alpdu, frag_buf->buffer);
+	frag_buf_ptrs_set(&frag_buf->ppdu, frag_buf->buffer);
 
 out:
 
 	return frag_buf;
 }
 
-void rle_frag_buf_del(struct rle_frag_buf **const frag_buf)
+void rle_frag_buf_del_with_allocator(const struct rle_allocator *const allocator,
+                                     struct rle_frag_buf **const frag_buf)
 {
 	if (!frag_buf) {
 		RLE_WARN("fragmentation buffer pointer NULL, nothing can be done");
@@ -86,7 +104,7 @@ void rle_frag_buf_del(struct rle_frag_buf **const frag_buf)
 		goto out;
 	}
 
-	FREE(*frag_buf);
+	rle_allocator_free(allocator, *frag_buf);
 	*frag_buf = NULL;
 
 out:
@@ -100,8 +118,10 @@ int rle_frag_buf_init(struct rle_frag_buf *const frag_buf)
 		return 1;
 	}
 
-	memset(frag_buf->buffer, '\0', RLE_F_BUFF_LEN);
+	RLE_BUF_POISON(frag_buf->buffer, RLE_F_BUFF_LEN);
 
+	frag_buf->base = frag_buf->buffer;
+	frag_buf->base_size = sizeof(frag_buf->buffer);
 	frag_buf->cur_pos = frag_buf->buffer + sizeof(rle_ppdu_hdr_t) + sizeof(rle_alpdu_hdr_t);
 
 	frag_buf_ptrs_set(&frag_buf->sdu, frag_buf->cur_pos);
@@ -127,6 +147,31 @@ int rle_frag_buf_cpy_sdu(struct rle_frag_buf *const frag_buf, const struct rle_s
 	return 0;
 }
 
+int rle_frag_buf_attach_sdu(struct rle_frag_buf *const frag_buf,
+                            const struct rle_sdu_buf *const sdu_buf)
+{
+	if (frag_buf == NULL || !frag_buf_sdu_buf_is_valid(sdu_buf) || frag_buf_in_use(frag_buf)) {
+		return 1;
+	}
+
+	/* the headers are pushed in the headroom and the trailer put in the tailroom, the SDU
+	 * itself is fragmented where it is */
+	frag_buf->base = sdu_buf->head;
+	frag_buf->base_size = sdu_buf->size;
+	frag_buf->cur_pos = sdu_buf->head + sdu_buf->data_offset;
+
+	frag_buf_ptrs_set(&frag_buf->sdu, frag_buf->cur_pos);
+	frag_buf_ptrs_set(&frag_buf->alpdu, frag_buf->cur_pos);
+	frag_buf_ptrs_set(&frag_buf->ppdu, frag_buf->cur_pos);
+
+	frag_buf_sdu_put(frag_buf, sdu_buf->data_len);
+	frag_buf->sdu_info.buffer = frag_buf->sdu.start;
+	frag_buf->sdu_info.protocol_type = sdu_buf->protocol_type;
+	frag_buf->sdu_info.size = sdu_buf->data_len;
+
+	return 0;
+}
+
 void frag_buf_sdu_push(rle_frag_buf_t *const frag_buf, const ssize_t size)
 {
 	frag_buf_ptrs_push(&frag_buf->sdu, size);
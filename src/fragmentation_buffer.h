@@ -114,6 +114,8 @@ struct fragmentation_buffer_ptrs {
 /** Fragmentation buffer implementation. */
 struct rle_frag_buf {
 	unsigned char buffer[RLE_F_BUFF_LEN]; /** Buffer itself.                                     */
+	unsigned char *base;                  /**< The memory in use, the buffer or an SDU buffer */
+	size_t base_size;                     /**< The size of the memory in use */
 	unsigned char *cur_pos;               /** Current position.                                  */
 	struct rle_sdu sdu_info;              /** RLE SDU struct used without buffer to store infos. */
 	uint32_t crc;                         /**< The computed CRC if needed */
@@ -127,6 +129,27 @@ struct rle_frag_buf {
 /*--------------------------------------- PUBLIC FUNCTIONS ---------------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
 
+/**
+ * @brief         Create a new fragmentation buffer with an allocator.
+ *
+ * @param[in]     allocator       The allocator, NULL for the registered one.
+ *
+ * @return        The fragmentation buffer if OK, else NULL
+ *
+ * @ingroup       RLE Fragmentation buffer
+ */
+struct rle_frag_buf * rle_frag_buf_new_with_allocator(const struct rle_allocator *const allocator);
+
+/**
+ * @brief         Destroy a fragmentation buffer created with an allocator.
+ *
+ * @param[in]     allocator       The allocator of the buffer, NULL for the registered one.
+ * @param[in,out] frag_buf        The fragmentation buffer to destroy.
+ *
+ * @ingroup       RLE Fragmentation buffer
+ */
+void rle_frag_buf_del_with_allocator(const struct rle_allocator *const allocator,
+                                     struct rle_frag_buf **const frag_buf);
 
 /**
  * @brief         Set the start and end pointers of a fragmentation buffer pointers to an arbitraly
@@ -290,6 +313,20 @@ static inline void frag_buf_set_cur_pos(rle_frag_buf_t *const frag_buf);
  */
 static inline int frag_buf_in_use(const rle_frag_buf_t *const frag_buf);
 
+/**
+ * @brief         Check if an SDU buffer may be encapsulated in place.
+ *
+ *                The SDU must be of a valid size, with room for the largest PPDU and ALPDU
+ *                headers before it and for the largest ALPDU trailer after it.
+ *
+ * @param[in]     sdu_buf                    The SDU buffer to check.
+ *
+ * @return        true if valid, else false.
+ *
+ * @ingroup       RLE Fragmentation buffer.
+ */
+static inline bool frag_buf_sdu_buf_is_valid(const struct rle_sdu_buf *const sdu_buf);
+
 /**
  * @brief         Get the length of the SDU in the fragmentation buffer.
  *
@@ -396,6 +433,9 @@ static inline int frag_buf_dump_full_frag_buf(const rle_frag_buf_t *const frag_b
 /**
  * @brief         Check if the fragmentation buffer fully is fragmented.
  *
+ *                A part of the ALPDU was already sent. The check holds between the PPDUs as
+ *                well as while the next PPDU is being built.
+ *
  * @param[in]     frag_buf                   The fragmentation buffer.
  *
  * @return        0 if not fragmented, 1 if fragmented.
@@ -428,15 +468,15 @@ size_t frag_buf_get_current_ppdu_len(const rle_frag_buf_t *const frag_buf);
 
 static void frag_buf_ptrs_set(frag_buf_ptrs_t *const ptrs, unsigned char *const address)
 {
-	assert((address >= ptrs->frag_buf->buffer) &&
-	       (address < ptrs->frag_buf->buffer + sizeof(ptrs->frag_buf->buffer)));
+	assert((address >= ptrs->frag_buf->base) &&
+	       (address < ptrs->frag_buf->base + ptrs->frag_buf->base_size));
 
 	ptrs->start = ptrs->end = address;
 }
 
 static void frag_buf_ptrs_push(frag_buf_ptrs_t *const ptrs, const ssize_t size)
 {
-	assert((ptrs->frag_buf->buffer + size) <= ptrs->start);
+	assert((ptrs->frag_buf->base + size) <= ptrs->start);
 
 	ptrs->start -= size;
 }
@@ -444,7 +484,7 @@ static void frag_buf_ptrs_push(frag_buf_ptrs_t *const ptrs, const ssize_t size)
 static void frag_buf_ptrs_put(frag_buf_ptrs_t *const ptrs, const size_t size)
 {
 	const ptrdiff_t offset =
-		(ptrs->frag_buf->buffer + sizeof(ptrs->frag_buf->buffer)) - ptrs->end;
+		(ptrs->frag_buf->base + ptrs->frag_buf->base_size) - ptrs->end;
 
 	assert(size <= (size_t)offset);
 
@@ -489,6 +529,24 @@ static inline int frag_buf_in_use(const rle_frag_buf_t *const frag_buf)
 	return frag_buf->sdu.start != frag_buf->sdu.end;
 }
 
+static inline bool frag_buf_sdu_buf_is_valid(const struct rle_sdu_buf *const sdu_buf)
+{
+	const size_t headroom = sizeof(rle_ppdu_hdr_t) + sizeof(rle_alpdu_hdr_t);
+	const size_t tailroom = sizeof(rle_alpdu_trailer_t);
+
+	if (sdu_buf == NULL || sdu_buf->head == NULL) {
+		return false;
+	}
+
+	if (sdu_buf->data_len == 0 || sdu_buf->data_len > RLE_MAX_PDU_SIZE) {
+		return false;
+	}
+
+	return (sdu_buf->data_offset >= headroom &&
+	        sdu_buf->data_offset <= sdu_buf->size &&
+	        sdu_buf->size - sdu_buf->data_offset >= sdu_buf->data_len + tailroom);
+}
+
 static inline ssize_t frag_buf_get_sdu_len(const rle_frag_buf_t *const frag_buf)
 {
 	return (ssize_t)(frag_buf->sdu.end - frag_buf->sdu.start);
@@ -515,9 +573,9 @@ static inline int frag_buf_dump_mem(const rle_frag_buf_t *const frag_buf,
 		goto out;
 	}
 
-	if ((start < frag_buf->buffer) || (end > (frag_buf->buffer + sizeof(frag_buf->buffer)))) {
-		RLE_ERR("address out of buffer ([%p - %p]/[%p - %p])", start, end, frag_buf->buffer,
-		        frag_buf->buffer + sizeof(frag_buf->buffer));
+	if ((start < frag_buf->base) || (end > (frag_buf->base + frag_buf->base_size))) {
+		RLE_ERR("address out of buffer ([%p - %p]/[%p - %p])", start, end, frag_buf->base,
+		        frag_buf->base + frag_buf->base_size);
 		goto out;
 	}
 
@@ -639,8 +697,7 @@ static inline int frag_buf_dump_full_frag_buf(const rle_frag_buf_t *const frag_b
 		goto out;
 	}
 
-	ret = frag_buf_dump_mem(frag_buf, frag_buf->buffer, frag_buf->buffer +
-	                        sizeof(frag_buf->buffer));
+	ret = frag_buf_dump_mem(frag_buf, frag_buf->base, frag_buf->base + frag_buf->base_size);
 
 	if (ret != -1) {
 		goto out;
@@ -659,7 +716,7 @@ static inline int frag_buf_is_fragmented(const rle_frag_buf_t *const frag_buf)
 
 	assert(frag_buf_in_use(frag_buf));
 
-	is_fragmented = frag_buf->alpdu.start < frag_buf->ppdu.start ? 1 : 0;
+	is_fragmented = frag_buf->alpdu.start < frag_buf->cur_pos ? 1 : 0;
 
 	return is_fragmented;
 }
@@ -222,11 +222,7 @@ static void push_comp_ppdu_hdr(struct rle_frag_buf *const frag_buf,
 
 	ppdu_len_field = frag_buf_get_current_ppdu_len(frag_buf) - 2;
 
-	(*ppdu_hdr)->start_ind = 1;
-	(*ppdu_hdr)->end_ind = 1;
-	rle_ppdu_hdr_set_ppdu_len((rle_ppdu_hdr_t *)*ppdu_hdr, ppdu_len_field);
-	(*ppdu_hdr)->label_type = alpdu_label_type;
-	(*ppdu_hdr)->proto_type_supp = ptype_suppressed;
+	rle_comp_ppdu_hdr_set(*ppdu_hdr, ppdu_len_field, alpdu_label_type, ptype_suppressed);
 }
 
 static void push_start_ppdu_hdr(struct rle_frag_buf *const frag_buf,
@@ -250,14 +246,8 @@ static void push_start_ppdu_hdr(struct rle_frag_buf *const frag_buf,
 	                  frag_buf_get_sdu_len(frag_buf) +
 	                  frag_buf_get_alpdu_trailer_len(frag_buf);
 
-	(*ppdu_hdr)->start_ind = 1;
-	(*ppdu_hdr)->end_ind = 0;
-	rle_ppdu_hdr_set_ppdu_len((rle_ppdu_hdr_t *)*ppdu_hdr, ppdu_len_field);
-	(*ppdu_hdr)->frag_id = frag_id;
-	(*ppdu_hdr)->use_crc = (use_alpdu_crc ? 1 : 0);
-	rle_ppdu_hdr_start_set_total_len(*ppdu_hdr, total_len_field);
-	(*ppdu_hdr)->label_type = alpdu_label_type;
-	(*ppdu_hdr)->proto_type_supp = ptype_suppressed;
+	rle_start_ppdu_hdr_set(*ppdu_hdr, ppdu_len_field, frag_id, use_alpdu_crc, total_len_field,
+	                       alpdu_label_type, ptype_suppressed);
 }
 
 static void push_cont_ppdu_hdr(struct rle_frag_buf *const frag_buf, const uint8_t frag_id)
@@ -273,10 +263,7 @@ static void push_cont_ppdu_hdr(struct rle_frag_buf *const frag_buf, const uint8_
 
 	ppdu_len_field = frag_buf_get_current_ppdu_len(frag_buf) - 2;
 
-	(*ppdu_hdr)->start_ind = 0;
-	(*ppdu_hdr)->end_ind = 0;
-	rle_ppdu_hdr_set_ppdu_len((rle_ppdu_hdr_t *)*ppdu_hdr, ppdu_len_field);
-	(*ppdu_hdr)->frag_id = frag_id;
+	rle_cont_end_ppdu_hdr_set(*ppdu_hdr, false, ppdu_len_field, frag_id);
 }
 
 static void push_end_ppdu_hdr(struct rle_frag_buf *const frag_buf, const uint8_t frag_id)
@@ -292,10 +279,7 @@ static void push_end_ppdu_hdr(struct rle_frag_buf *const frag_buf, const uint8_t
 
 	ppdu_len_field = frag_buf_get_current_ppdu_len(frag_buf) - 2;
 
-	(*ppdu_hdr)->start_ind = 0;
-	(*ppdu_hdr)->end_ind = 1;
-	rle_ppdu_hdr_set_ppdu_len((rle_ppdu_hdr_t *)*ppdu_hdr, ppdu_len_field);
-	(*ppdu_hdr)->frag_id = frag_id;
+	rle_cont_end_ppdu_hdr_set(*ppdu_hdr, true, ppdu_len_field, frag_id);
 }
 
 static bool get_uncomp_ptype_from_sdu(const uint8_t *const sdu,
@@ -306,8 +290,8 @@ static bool get_uncomp_ptype_from_sdu(const uint8_t *const sdu,
 
 	if (sdu_len < 1) {
 		/* the protocol type cannot be deduced from the IP payload */
-		RLE_ERR("SDU is too short to deduce IP version from the first IP byte: "
-		        "%zu bytes available, 1 byte required at least\n", sdu_len);
+		RLE_DEBUG("SDU is too short to deduce IP version from the first IP byte: "
+		          "%zu bytes available, 1 byte required at least\n", sdu_len);
 		goto error;
 	}
 
@@ -318,7 +302,7 @@ static bool get_uncomp_ptype_from_sdu(const uint8_t *const sdu,
 	} else if (ip_version == 6) {
 		*pt = RLE_PROTO_TYPE_IPV6_UNCOMP;
 	} else {
-		RLE_ERR("unsupported IP Version %u\n", ip_version);
+		RLE_DEBUG("unsupported IP Version %u\n", ip_version);
 		goto error;
 	}
 
@@ -380,112 +364,115 @@ error:
 	return comp_ptype;
 }
 
-void push_alpdu_hdr(struct rle_frag_buf *const frag_buf, const struct rle_config *const rle_conf)
+void choose_alpdu_hdr(const uint16_t ptype,
+                      const unsigned char *const sdu,
+                      const size_t sdu_len,
+                      const struct rle_config *const rle_conf,
+                      struct alpdu_hdr_choice *const choice)
 {
-	uint16_t ptype;
-
-	RLE_DEBUG("prepend a ALPDU header");
-
-	ptype = frag_buf->sdu_info.protocol_type;
+	choice->comp_ptype = RLE_PROTO_TYPE_FALLBACK;
+	choice->omit_vlan_ptype = false;
 
 	/* ALPDU: 4 cases, len € {0,1,2,3} */
 
 	/* don't fill ALPDU ptype field if given ptype is equal to the default one and suppression is
 	 * active, or if given ptype is for signalling packet */
-	if (!ptype_is_omissible(ptype, rle_conf, frag_buf)) {
-		const uint16_t net_ptype = ntohs(ptype);
-
-		/* suppression is not possible, is compression enabled? */
-		if (!rle_conf->use_compressed_ptype) {
-			/* No compression, no suppression, ALPDU len = 2 */
-			push_uncomp_alpdu_hdr(frag_buf, net_ptype);
-		} else {
-			/* No suppression, compression is enabled */
-			uint8_t comp_ptype;
-
-			/* is protocol type compressible? */
-			if (rle_header_ptype_is_compressible(ptype) == C_OK) {
-				comp_ptype = rle_header_ptype_compression(ptype, frag_buf);
-			} else {
-				comp_ptype = RLE_PROTO_TYPE_FALLBACK;
-			}
-
-			if (comp_ptype == RLE_PROTO_TYPE_FALLBACK) {
-				/* protocol type is NOT compressible, prepend the 3-byte ALPDU before the SDU */
-				push_comp_fallback_alpdu_hdr(frag_buf, net_ptype);
-			} else {
-				/* protocol type is compressible, ALPDU len = 1 */
-
-				/* special case if the payload is VLAN with embedded IPv4 or IPv6:
-				 *  - the RLE transmitter shall suppress the protocol field of the VLAN header,
-				 *  - the RLE receiver shall detect IPv4/IPv6 with the 4 first bits of the
-				 *    embedded payload. */
-				if (ptype == RLE_PROTO_TYPE_VLAN_UNCOMP &&
-				    comp_ptype == RLE_PROTO_TYPE_VLAN_COMP_WO_PTYPE_FIELD) {
-					RLE_DEBUG("omit the protocol field of the VLAN header "
-					          "making SDU 2 bytes less (%zu bytes in total)",
-					          frag_buf_get_sdu_len(frag_buf) - sizeof(ptype));
-					memmove(frag_buf->sdu.start + sizeof(ptype),
-					        frag_buf->sdu.start, sizeof(struct ether_header) +
-					        sizeof(struct vlan_hdr) - sizeof(ptype));
-					frag_buf_sdu_push(frag_buf, -(sizeof(ptype)));
-				}
-
-				/* prepend the 1-byte ALPDU before the SDU */
-				push_comp_supported_alpdu_hdr(frag_buf, comp_ptype);
-			}
-		}
-	} else {
+	if (ptype_is_omissible(ptype, rle_conf, sdu, sdu_len)) {
 		/* protocol type is omitted, ALPDU len == 0 */
-		RLE_DEBUG("prepend a 0-byte ALPDU header with protocol type omitted");
+		choice->type = ALPDU_HDR_OMITTED;
+		choice->len = 0;
 
 		/* special case if the payload is VLAN with embedded IPv4 or IPv6:
 		 *  - the RLE transmitter shall suppress the protocol field of the VLAN header,
 		 *  - the RLE receiver shall detect IPv4/IPv6 with the 4 first bits of the
 		 *    embedded payload. */
-		if (ptype == RLE_PROTO_TYPE_VLAN_UNCOMP &&
-		    rle_conf->implicit_protocol_type == RLE_PROTO_TYPE_VLAN_COMP_WO_PTYPE_FIELD) {
-			RLE_DEBUG("omit the protocol field of the VLAN header "
-			          "making SDU 2 bytes less (%zu bytes in total)",
-			          frag_buf_get_sdu_len(frag_buf) - sizeof(ptype));
-			memmove(frag_buf->sdu.start + sizeof(ptype), frag_buf->sdu.start,
-			        sizeof(struct ether_header) + sizeof(struct vlan_hdr) -
-			        sizeof(ptype));
-			frag_buf_sdu_push(frag_buf, -(sizeof(ptype)));
+		choice->omit_vlan_ptype =
+			(ptype == RLE_PROTO_TYPE_VLAN_UNCOMP &&
+			 rle_conf->implicit_protocol_type == RLE_PROTO_TYPE_VLAN_COMP_WO_PTYPE_FIELD);
+	} else if (!rle_conf->use_compressed_ptype) {
+		/* No compression, no suppression, ALPDU len = 2 */
+		choice->type = ALPDU_HDR_UNCOMP;
+		choice->len = sizeof(rle_alpdu_hdr_uncomp_t);
+	} else {
+		/* No suppression, compression is enabled: is protocol type compressible? */
+		if (rle_header_ptype_is_compressible(ptype) == C_OK) {
+			choice->comp_ptype = get_comp_ptype(ptype, sdu, sdu_len);
+		}
+
+		if (choice->comp_ptype == RLE_PROTO_TYPE_FALLBACK) {
+			/* protocol type is NOT compressible, 3-byte ALPDU */
+			choice->type = ALPDU_HDR_COMP_FALLBACK;
+			choice->len = sizeof(rle_alpdu_hdr_comp_fallback_t);
+		} else {
+			/* protocol type is compressible, ALPDU len = 1 */
+			choice->type = ALPDU_HDR_COMP_SUPPORTED;
+			choice->len = sizeof(rle_alpdu_hdr_comp_supported_t);
+
+			/* same special case for VLAN with embedded IPv4 or IPv6 */
+			choice->omit_vlan_ptype =
+				(ptype == RLE_PROTO_TYPE_VLAN_UNCOMP &&
+				 choice->comp_ptype == RLE_PROTO_TYPE_VLAN_COMP_WO_PTYPE_FIELD);
 		}
 	}
 }
 
-bool push_ppdu_hdr(struct rle_frag_buf *const frag_buf,
-                   const struct rle_config *const rle_conf,
-                   const size_t ppdu_len,
-                   struct rle_ctx_mngt *const rle_ctx)
+void push_alpdu_hdr(struct rle_frag_buf *const frag_buf, const struct rle_config *const rle_conf)
+{
+	const uint16_t ptype = frag_buf->sdu_info.protocol_type;
+	const uint16_t net_ptype = ntohs(ptype);
+	struct alpdu_hdr_choice choice;
+
+	RLE_DEBUG("prepend a ALPDU header");
+
+	choose_alpdu_hdr(ptype, frag_buf->sdu.start, frag_buf->sdu_info.size, rle_conf, &choice);
+
+	if (choice.omit_vlan_ptype) {
+		RLE_DEBUG("omit the protocol field of the VLAN header "
+		          "making SDU 2 bytes less (%zu bytes in total)",
+		          frag_buf_get_sdu_len(frag_buf) - sizeof(ptype));
+		memmove(frag_buf->sdu.start + sizeof(ptype), frag_buf->sdu.start,
+		        sizeof(struct ether_header) + sizeof(struct vlan_hdr) - sizeof(ptype));
+		frag_buf_sdu_push(frag_buf, -(sizeof(ptype)));
+	}
+
+	switch (choice.type) {
+	case ALPDU_HDR_UNCOMP:
+		push_uncomp_alpdu_hdr(frag_buf, net_ptype);
+		break;
+	case ALPDU_HDR_COMP_SUPPORTED:
+		push_comp_supported_alpdu_hdr(frag_buf, choice.comp_ptype);
+		break;
+	case ALPDU_HDR_COMP_FALLBACK:
+		push_comp_fallback_alpdu_hdr(frag_buf, net_ptype);
+		break;
+	case ALPDU_HDR_OMITTED:
+	default:
+		RLE_DEBUG("prepend a 0-byte ALPDU header with protocol type omitted");
+		break;
+	}
+}
+
+bool choose_ppdu(const struct rle_config *const rle_conf,
+                 const size_t ppdu_len,
+                 const bool is_fragmented,
+                 const size_t remain_alpdu_len,
+                 const size_t alpdu_hdr_len,
+                 struct ppdu_choice *const choice)
 {
 	const size_t ppdu_base_hdr_len = 2;
 	const size_t ppdu_std_max_len = RLE_MAX_PPDU_PL_SIZE + ppdu_base_hdr_len;
 	size_t max_alpdu_frag_len = ppdu_len;
-	const size_t remain_alpdu_len = frag_buf_get_remaining_alpdu_length(frag_buf);
 	const bool use_alpdu_crc =
 		(rle_conf->allow_alpdu_sequence_number ? false : !!rle_conf->allow_alpdu_crc);
 
-	RLE_DEBUG("build one PPDU (%zu bytes max) with %zu remaining bytes of ALPDU",
-	          ppdu_len, remain_alpdu_len);
-
 	/* do not put more PPDU bytes than allowed by the standard, ie. length
 	 * stored on 11 bits + 2 bytes of base header = 2047+2 = 2049 */
 	if (max_alpdu_frag_len > ppdu_std_max_len) {
-		RLE_DEBUG("do not build one %zu-byte PPDU, larger than the max "
-		          "%zu bytes defined by RLE standard", max_alpdu_frag_len,
-		          ppdu_std_max_len);
 		max_alpdu_frag_len = ppdu_std_max_len;
 	}
 
-	if (frag_buf_is_fragmented(frag_buf)) {
+	if (is_fragmented) {
 		/* ALPDU is fragmented, use CONT or END PPDU */
-		RLE_DEBUG("ALPDU was already fragmented, build one CONT or END PPDU");
-
-		/* RLE context needed if ALPDU is fragmented */
-		assert(rle_ctx != NULL);
 
 		if (ppdu_len <= sizeof(rle_ppdu_hdr_cont_end_t)) {
 			/* buffer is too small for the smallest PPDU CONT or END fragment plus 1 byte of payload:
@@ -506,92 +493,154 @@ bool push_ppdu_hdr(struct rle_frag_buf *const frag_buf,
 		 * the ALPDU.
 		 * Note: the `remain_alpdu_len` contain the ALPDU trailer length */
 		if (remain_alpdu_len <= max_alpdu_frag_len) {
-			/* END PPDU is possible: put all remaining bytes into the PPDU payload, then build
-			 * the END PPDU header before the payload */
-			RLE_DEBUG("build one END PPDU");
-			frag_buf_ppdu_put(frag_buf, remain_alpdu_len);
-			push_end_ppdu_hdr(frag_buf, rle_ctx->frag_id);
+			/* END PPDU is possible: put all remaining bytes into the PPDU payload */
+			choice->type = RLE_PDU_END_FRAG;
+			choice->alpdu_frag_len = remain_alpdu_len;
 		} else {
 			/* CONT PPDU is required: determine whether the trailer is fully contained in the
 			 * next PPDU fragment or not ; if not, the trailer would be fragmented, so make
 			 * the CONT PPDU fragment smaller to avoid the trailer fragmentation */
-			RLE_DEBUG("build one CONT PPDU");
-
 			const size_t trailer_len = (use_alpdu_crc ? RLE_CRC_SIZE : 0);
 			const size_t alpdu_overflow_len = remain_alpdu_len - max_alpdu_frag_len;
 
+			choice->type = RLE_PDU_CONT_FRAG;
+
 			if (alpdu_overflow_len < trailer_len) {
 				/* the number of ALPDU bytes that will be put in the next fragments is smaller
 				 * than the ALPDU trailer, so the current CONT PPDU contains some bytes of the
 				 * trailer, so make the PPDU fragment shorter */
+				const size_t trailer_len_in_cur_ppdu = trailer_len - alpdu_overflow_len;
 
-				size_t trailer_len_in_cur_ppdu = trailer_len - alpdu_overflow_len;
-				size_t alpdu_frag_len = max_alpdu_frag_len -
-				                        trailer_len_in_cur_ppdu;
+				choice->alpdu_frag_len = max_alpdu_frag_len - trailer_len_in_cur_ppdu;
 
 				/* do not build CONT PPDU with 0 byte of ALPDU: sending 0 byte of payload is useless,
 				 * and even a problem: a CONT PPDU with 0 byte of payload may be confused with padding */
-				if (alpdu_frag_len == 0) {
+				if (choice->alpdu_frag_len == 0) {
 					goto error;
 				}
-
-				frag_buf_ppdu_put(frag_buf, alpdu_frag_len);
-				push_cont_ppdu_hdr(frag_buf, rle_ctx->frag_id);
 			} else {
 				/* the ALPDU trailer will be fully transmitted in one of the next fragments,
 				 * there is no risk of trailer fragmentation, so use the full room of the buffer */
-				frag_buf_ppdu_put(frag_buf, max_alpdu_frag_len);
-				push_cont_ppdu_hdr(frag_buf, rle_ctx->frag_id);
+				choice->alpdu_frag_len = max_alpdu_frag_len;
 			}
 		}
+	} else if (remain_alpdu_len + sizeof(rle_ppdu_hdr_comp_t) > max_alpdu_frag_len) {
+		/* Start PPDU */
+		if (max_alpdu_frag_len < (sizeof(rle_ppdu_hdr_start_t) + alpdu_hdr_len + 1)) {
+			/* buffer is too small for the smallest PPDU START fragment: the buffer shall be large
+			 * enough for the PPDU START header, the full ALPDU header and at least one byte of
+			 * ALPDU because the fragmentation of the ALPDU header is not supported by the RLE
+			 * reassembler yet */
+			goto error;
+		}
+
+		/* the ALPDU is larger than the room, the trailer is never in the START PPDU */
+		choice->type = RLE_PDU_START_FRAG;
+		choice->alpdu_frag_len = max_alpdu_frag_len - sizeof(rle_ppdu_hdr_start_t);
 	} else {
+		/* Complete PPDU */
+		choice->type = RLE_PDU_COMPLETE;
+		choice->alpdu_frag_len = remain_alpdu_len;
+	}
+
+	return true;
+
+error:
+	return false;
+}
+
+bool push_ppdu_hdr(struct rle_frag_buf *const frag_buf,
+                   const struct rle_config *const rle_conf,
+                   const size_t ppdu_len,
+                   struct rle_ctx_mngt *const rle_ctx,
+                   const struct rle_trace *const trace)
+{
+	const size_t remain_alpdu_len = frag_buf_get_remaining_alpdu_length(frag_buf);
+	const bool use_alpdu_crc =
+		(rle_conf->allow_alpdu_sequence_number ? false : !!rle_conf->allow_alpdu_crc);
+	struct ppdu_choice choice;
+
+	RLE_TRACE_DEBUG(trace, "build one PPDU (%zu bytes max) with %zu remaining bytes of ALPDU",
+	                ppdu_len, remain_alpdu_len);
+
+	if (!choose_ppdu(rle_conf, ppdu_len, frag_buf_is_fragmented(frag_buf), remain_alpdu_len,
+	                 frag_buf_get_alpdu_hdr_len(frag_buf), &choice)) {
+		RLE_TRACE_DEBUG(trace, "%zu bytes are too few for the next PPDU", ppdu_len);
+		goto error;
+	}
+
+	switch (choice.type) {
+	case RLE_PDU_END_FRAG:
+		RLE_TRACE_DEBUG(trace, "build one END PPDU");
+		/* RLE context needed if ALPDU is fragmented */
+		assert(rle_ctx != NULL);
+		frag_buf_ppdu_put(frag_buf, choice.alpdu_frag_len);
+		push_end_ppdu_hdr(frag_buf, rle_ctx->frag_id);
+		break;
+
+	case RLE_PDU_CONT_FRAG:
+		RLE_TRACE_DEBUG(trace, "build one CONT PPDU");
+		/* RLE context needed if ALPDU is fragmented */
+		assert(rle_ctx != NULL);
+		frag_buf_ppdu_put(frag_buf, choice.alpdu_frag_len);
+		push_cont_ppdu_hdr(frag_buf, rle_ctx->frag_id);
+		break;
+
+	case RLE_PDU_START_FRAG:
+	{
 		const bool ptype_suppressed = (frag_buf_get_alpdu_hdr_len(frag_buf) == 0);
-		const uint8_t alpdu_label_type =
-			get_alpdu_label_type(frag_buf->sdu_info.protocol_type, ptype_suppressed,
-			                     rle_conf->type_0_alpdu_label_size);
 
-		RLE_DEBUG("ALPDU was not fragmented yet, build one COMP or START PPDU");
+		RLE_TRACE_DEBUG(trace, "build one START PPDU");
+
+		/* RLE context needed if ALPDU is fragmented */
+		if (!rle_ctx) {
+			RLE_TRACE_ERR(trace, "RLE context needed.");
+			goto error;
+		}
 
-		if (remain_alpdu_len + sizeof(rle_ppdu_hdr_comp_t) > max_alpdu_frag_len) {
-			/* Start PPDU */
-			RLE_DEBUG("build one START PPDU");
+		push_alpdu_trailer(frag_buf, rle_conf, rle_ctx);
 
-			const size_t ppdu_and_alpdu_hdrs_len =
-				sizeof(rle_ppdu_hdr_start_t) + frag_buf_get_alpdu_hdr_len(frag_buf);
+		frag_buf_ppdu_put(frag_buf, choice.alpdu_frag_len);
 
-			/* RLE context needed if ALPDU is fragmented */
-			if (!rle_ctx) {
-				RLE_ERR("RLE context needed.");
-				goto error;
-			}
+		push_start_ppdu_hdr(frag_buf, rle_ctx->frag_id,
+		                    get_alpdu_label_type(frag_buf->sdu_info.protocol_type,
+		                                         ptype_suppressed,
+		                                         rle_conf->type_0_alpdu_label_size),
+		                    ptype_suppressed, use_alpdu_crc);
+		break;
+	}
 
-			if (max_alpdu_frag_len < (ppdu_and_alpdu_hdrs_len + 1)) {
-				/* buffer is too small for the smallest PPDU START fragment: the buffer shall be large
-				 * enough for the PPDU START header, the full ALPDU header and at least one byte of
-				 * ALPDU because the fragmentation of the ALPDU header is not supported by the RLE
-				 * reassembler yet */
-				goto error;
-			}
-			max_alpdu_frag_len -= sizeof(rle_ppdu_hdr_start_t);
+	case RLE_PDU_COMPLETE:
+	default:
+	{
+		const bool ptype_suppressed = (frag_buf_get_alpdu_hdr_len(frag_buf) == 0);
 
-			push_alpdu_trailer(frag_buf, rle_conf, rle_ctx);
+		RLE_TRACE_DEBUG(trace, "build one COMP PPDU");
 
-			frag_buf_ppdu_put(frag_buf, max_alpdu_frag_len);
+		frag_buf_ppdu_put(frag_buf, choice.alpdu_frag_len);
 
-			push_start_ppdu_hdr(frag_buf, rle_ctx->frag_id, alpdu_label_type,
-			                    ptype_suppressed, use_alpdu_crc);
-		} else {
-			/* Complete PPDU */
-			RLE_DEBUG("build one COMP PPDU");
-			if (max_alpdu_frag_len < sizeof(rle_ppdu_hdr_comp_t)) {
-				goto error;
-			}
-			max_alpdu_frag_len -= sizeof(rle_ppdu_hdr_comp_t);
+		push_comp_ppdu_hdr(frag_buf,
+		                   get_alpdu_label_type(frag_buf->sdu_info.protocol_type,
+		                                        ptype_suppressed,
+		                                        rle_conf->type_0_alpdu_label_size),
+		                   ptype_suppressed);
+		break;
+	}
+	}
 
-			frag_buf_ppdu_put(frag_buf, max_alpdu_frag_len);
+	if (rle_ctx != NULL) {
+		size_t ppdu_hdr_len = sizeof(rle_ppdu_hdr_cont_end_t);
 
-			push_comp_ppdu_hdr(frag_buf, alpdu_label_type, ptype_suppressed);
+		if (choice.type == RLE_PDU_START_FRAG) {
+			ppdu_hdr_len = sizeof(rle_ppdu_hdr_start_t);
+		} else if (choice.type == RLE_PDU_COMPLETE) {
+			ppdu_hdr_len = sizeof(rle_ppdu_hdr_comp_t);
 		}
+
+		rle_ctx_count_ppdu(rle_ctx, choice.type, ppdu_hdr_len,
+		                   (size_t)frag_buf_get_alpdu_hdr_len(frag_buf),
+		                   (size_t)frag_buf_get_alpdu_trailer_len(frag_buf),
+		                   (size_t)frag_buf_get_sdu_len(frag_buf));
 	}
 
 	frag_buf_set_cur_pos(frag_buf);
@@ -630,7 +679,7 @@ void start_ppdu_extract_alpdu_frag(unsigned char start_ppdu[],
 	*alpdu_frag = start_ppdu + sizeof(rle_ppdu_hdr_start_t);
 	*alpdu_frag_len = ppdu_len - sizeof(rle_ppdu_hdr_start_t);
 	*alpdu_total_len = rle_ppdu_hdr_start_get_total_len(start_ppdu_header);
-	*is_crc_used = start_ppdu_header->use_crc;
+	*is_crc_used = rle_start_ppdu_hdr_get_use_crc(start_ppdu_header);
 
 	assert(ppdu_len == (sizeof(rle_ppdu_hdr_start_t) + (*alpdu_frag_len)));
 
@@ -690,8 +739,8 @@ int suppr_alpdu_extract_sdu_frag(const unsigned char alpdu_frag[],
 		RLE_DEBUG("implicit protocol type 0x%02x requires to detect IP version "
 		          "from SDU", default_ptype);
 		if (!get_uncomp_ptype_from_sdu(*sdu_frag, *sdu_frag_len, ptype)) {
-			RLE_ERR("failed to get uncompressed protocol type from the "
-			        "first 4 bits of SDU\n");
+			RLE_DEBUG("failed to get uncompressed protocol type from the "
+			          "first 4 bits of SDU\n");
 			status = 1;
 			goto out;
 		}
@@ -720,7 +769,7 @@ int uncomp_alpdu_extract_sdu_frag(const unsigned char alpdu_frag[],
 	          alpdu_frag_len);
 
 	if (alpdu_frag_len < sizeof(rle_alpdu_hdr_uncomp_t)) {
-		RLE_ERR("Invalid alpdu fragment len: %zu\n", alpdu_frag_len);
+		RLE_DEBUG("Invalid alpdu fragment len: %zu\n", alpdu_frag_len);
 		status = 1;
 		goto out;
 	}
@@ -751,8 +800,8 @@ int comp_alpdu_extract_sdu_frag(const unsigned char alpdu_frag[],
 	          alpdu_frag_len);
 
 	if (alpdu_frag_len < 1) {
-		RLE_ERR("ALPDU fragment smaller (%zu) than the ALPDU header with compressed "
-		        "protocol type\n", alpdu_frag_len);
+		RLE_DEBUG("ALPDU fragment smaller (%zu) than the ALPDU header with compressed "
+		          "protocol type\n", alpdu_frag_len);
 		status = 1;
 		goto out;
 	}
@@ -761,8 +810,8 @@ int comp_alpdu_extract_sdu_frag(const unsigned char alpdu_frag[],
 
 	if ((*comp_ptype) == RLE_PROTO_TYPE_FALLBACK) {
 		if (alpdu_frag_len < sizeof(alpdu_hdr->comp_fallback)) {
-			RLE_ERR("Alpdu fragment smaller (%zu) than a header (%zu)\n",
-			        alpdu_frag_len, sizeof(alpdu_hdr->comp_fallback));
+			RLE_DEBUG("Alpdu fragment smaller (%zu) than a header (%zu)\n",
+			          alpdu_frag_len, sizeof(alpdu_hdr->comp_fallback));
 			status = 1;
 			goto out;
 		}
@@ -776,8 +825,8 @@ int comp_alpdu_extract_sdu_frag(const unsigned char alpdu_frag[],
 		          "from ALPDU", (*sdu_frag_len), (*ptype));
 	} else {
 		if (alpdu_frag_len < sizeof(alpdu_hdr->comp_supported)) {
-			RLE_ERR("Alpdu fragment smaller (%zu) than a header (%zu)\n",
-			        alpdu_frag_len, sizeof(alpdu_hdr->comp_supported));
+			RLE_DEBUG("Alpdu fragment smaller (%zu) than a header (%zu)\n",
+			          alpdu_frag_len, sizeof(alpdu_hdr->comp_supported));
 			status = 1;
 			goto out;
 		}
@@ -794,8 +843,8 @@ int comp_alpdu_extract_sdu_frag(const unsigned char alpdu_frag[],
 			RLE_DEBUG("compressed protocol type 0x%02x requires to detect IP "
 			          "version from SDU", *comp_ptype);
 			if (!get_uncomp_ptype_from_sdu(*sdu_frag, *sdu_frag_len, ptype)) {
-				RLE_ERR("failed to get uncompressed protocol type from the "
-				        "first 4 bits of SDU\n");
+				RLE_DEBUG("failed to get uncompressed protocol type from the "
+				          "first 4 bits of SDU\n");
 				status = 1;
 				goto out;
 			}
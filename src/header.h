@@ -71,31 +71,43 @@ struct rle_ctx_mngt;
 /*--------------------------------- PUBLIC STRUCTS AND TYPEDEFS ----------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
 
-/** * RLE PPDU start header */
+/*
+ * The PPDU headers are kept as octets in network byte order, and decoded with one 16-bit or
+ * 32-bit big-endian load, see the accessors below. The first 16-bit word is common to all the
+ * PPDUs:
+ *
+ *   S(1) E(1) PPDU_Length(11) Fragment_ID(3)       START, CONT and END PPDUs
+ *   S(1) E(1) PPDU_Length(11) LT(2) T(1)           Complete PPDUs
+ *
+ * START PPDUs then have a second 16-bit word:
+ *
+ *   Use_CRC(1) Total_Length(12) LT(2) T(1)
+ */
+
+/** Offset of the S and E bits in the first 16-bit word of a PPDU header */
+#define RLE_PPDU_HDR_SE_SHIFT          14
+/** Offset of the PPDU length in the first 16-bit word of a PPDU header */
+#define RLE_PPDU_HDR_LEN_SHIFT         3
+/** Mask of the PPDU length, once shifted */
+#define RLE_PPDU_HDR_LEN_MASK          0x7ff
+/** Mask of the fragment ID in the first 16-bit word of a PPDU header */
+#define RLE_PPDU_HDR_FRAG_ID_MASK      0x7
+/** Offset of the label type in the last 16-bit word of a COMP or START PPDU header */
+#define RLE_PPDU_HDR_LT_SHIFT          1
+/** Mask of the label type, once shifted */
+#define RLE_PPDU_HDR_LT_MASK           0x3
+/** Mask of the protocol type suppressed bit in the last 16-bit word of a COMP or START header */
+#define RLE_PPDU_HDR_T_MASK            0x1
+/** Offset of the use CRC bit in the second 16-bit word of a START PPDU header */
+#define RLE_PPDU_HDR_CRC_SHIFT         15
+/** Offset of the ALPDU total length in the second 16-bit word of a START PPDU header */
+#define RLE_PPDU_HDR_TOTAL_LEN_SHIFT   3
+/** Mask of the ALPDU total length, once shifted */
+#define RLE_PPDU_HDR_TOTAL_LEN_MASK    0xfff
+
+/** RLE PPDU start header */
 struct rle_ppdu_hdr_start {
-#if __BYTE_ORDER == __LITTLE_ENDIAN
-	uint32_t pkt_len_1       : 6;
-	uint32_t end_ind         : 1;
-	uint32_t start_ind       : 1;
-	uint32_t frag_id         : 3;
-	uint32_t pkt_len_2       : 5;
-	uint32_t total_len_1     : 7;
-	uint32_t use_crc         : 1;
-	uint32_t proto_type_supp : 1;
-	uint32_t label_type      : 2;
-	uint32_t total_len_2     : 5;
-#elif __BYTE_ORDER == __BIG_ENDIAN
-	uint32_t start_ind       : 1;
-	uint32_t end_ind         : 1;
-	uint32_t pkt_len         : 11;
-	uint32_t frag_id         : 3;
-	uint32_t use_crc         : 1;
-	uint32_t total_len       : 12;
-	uint32_t label_type      : 2;
-	uint32_t proto_type_supp : 1;
-#else
-#error "Please fix <asm/byteorder.h>"
-#endif
+	uint8_t bytes[4]; /**< The header, in network byte order */
 } __attribute__ ((packed));
 
 /** RLE PPDU start header definition */
@@ -103,22 +115,7 @@ typedef struct rle_ppdu_hdr_start rle_ppdu_hdr_start_t;
 
 /** RLE PPDU complete header */
 struct rle_ppdu_hdr_comp {
-#if __BYTE_ORDER == __LITTLE_ENDIAN
-	uint16_t pkt_len_1       : 6;
-	uint16_t end_ind         : 1;
-	uint16_t start_ind       : 1;
-	uint16_t proto_type_supp : 1;
-	uint16_t label_type      : 2;
-	uint16_t pkt_len_2       : 5;
-#elif __BYTE_ORDER == __BIG_ENDIAN
-	uint16_t start_ind       : 1;
-	uint16_t end_ind         : 1;
-	uint16_t pkt_len         : 11;
-	uint16_t label_type      : 2;
-	uint16_t proto_type_supp : 1;
-#else
-#error "Please fix <asm/byteorder.h>"
-#endif
+	uint8_t bytes[2]; /**< The header, in network byte order */
 } __attribute__ ((packed));
 
 /** RLE PPDU completet header definition */
@@ -126,20 +123,7 @@ typedef struct rle_ppdu_hdr_comp rle_ppdu_hdr_comp_t;
 
 /** RLE PPDU continuation or end header */
 struct rle_ppdu_hdr_cont_end {
-#if __BYTE_ORDER == __LITTLE_ENDIAN
-	uint16_t pkt_len_1   : 6;
-	uint16_t end_ind     : 1;
-	uint16_t start_ind   : 1;
-	uint16_t frag_id     : 3;
-	uint16_t pkt_len_2   : 5;
-#elif __BYTE_ORDER == __BIG_ENDIAN
-	uint16_t start_ind   : 1;
-	uint16_t end_ind     : 1;
-	uint16_t pkt_len     : 11;
-	uint16_t frag_id     : 3;
-#else
-#error "Please fix <asm/byteorder.h>"
-#endif
+	uint8_t bytes[2]; /**< The header, in network byte order */
 } __attribute__ ((packed));
 
 /** RLE PPDU contininuation or end header definition. */
@@ -148,20 +132,7 @@ typedef struct rle_ppdu_hdr_cont_end rle_ppdu_hdr_cont_end_t;
 /** RLE PPDU header.  */
 union rle_ppdu_hdr {
 	struct {
-#if __BYTE_ORDER == __LITTLE_ENDIAN
-		uint16_t rle_packet_length_1 : 6;
-		uint16_t end_ind             : 1;
-		uint16_t start_ind           : 1;
-		uint16_t                     : 3;
-		uint16_t rle_packet_length_2 : 5;
-#elif __BYTE_ORDER == __BIG_ENDIAN
-		uint16_t start_ind           : 1;
-		uint16_t end_ind             : 1;
-		uint16_t rle_packet_length   : 11;
-		uint16_t                     : 3;
-#else
-#error "Please fix <asm/byteorder.h>"
-#endif
+		uint8_t bytes[2]; /**< The first 16-bit word, in network byte order */
 	} __attribute__ ((packed)) common;
 	rle_ppdu_hdr_start_t start;
 	rle_ppdu_hdr_cont_end_t cont;
@@ -169,6 +140,14 @@ union rle_ppdu_hdr {
 	rle_ppdu_hdr_comp_t comp;
 } __attribute__ ((packed));
 
+/** Fields of the first 16-bit word of a PPDU header, decoded at once */
+struct rle_ppdu_hdr_fields {
+	int type;           /**< RLE_PDU_COMPLETE, RLE_PDU_START_FRAG, RLE_PDU_CONT_FRAG or
+	                     *   RLE_PDU_END_FRAG */
+	uint16_t ppdu_len;  /**< The PPDU length field, the first 2 octets excluded */
+	uint8_t frag_id;    /**< The fragment ID, 0 for a Complete PPDU */
+};
+
 /** RLE PPDU header definition. */
 typedef union rle_ppdu_hdr rle_ppdu_hdr_t;
 
@@ -232,6 +211,29 @@ struct vlan_hdr {
 	uint16_t tpid;           /**< Tag Protocol Identifier (TPID) */
 } __attribute__((packed));
 
+/** The types of ALPDU header */
+enum alpdu_hdr_type {
+	ALPDU_HDR_OMITTED,        /**< Protocol type omitted, no ALPDU header */
+	ALPDU_HDR_UNCOMP,         /**< Uncompressed protocol type */
+	ALPDU_HDR_COMP_SUPPORTED, /**< Compressed protocol type */
+	ALPDU_HDR_COMP_FALLBACK,  /**< Protocol type not compressible, after the fallback value */
+};
+
+/** The ALPDU header chosen for a SDU */
+struct alpdu_hdr_choice {
+	enum alpdu_hdr_type type; /**< The type of ALPDU header */
+	size_t len;               /**< The length of the ALPDU header */
+	uint8_t comp_ptype;       /**< The compressed protocol type, for ALPDU_HDR_COMP_SUPPORTED */
+	bool omit_vlan_ptype;     /**< Whether the protocol field of the VLAN header is suppressed */
+};
+
+/** The next PPDU chosen for an ALPDU */
+struct ppdu_choice {
+	int type;                 /**< RLE_PDU_COMPLETE, RLE_PDU_START_FRAG, RLE_PDU_CONT_FRAG or
+	                           *   RLE_PDU_END_FRAG */
+	size_t alpdu_frag_len;    /**< The number of ALPDU octets carried by the PPDU */
+};
+
 
 
 /*------------------------------------------------------------------------------------------------*/
@@ -253,6 +255,53 @@ struct vlan_hdr {
 int is_eth_vlan_ip_frame(const uint8_t *const sdu, const size_t sdu_len)
 __attribute__((warn_unused_result, nonnull(1)));
 
+/**
+ *  @brief         Choose the ALPDU header of a SDU, without building it.
+ *
+ *                 Shared by the encapsulation and the estimation of the fragmentation.
+ *
+ *  @param[in]     ptype                the SDU protocol type
+ *  @param[in]     sdu                  the SDU
+ *  @param[in]     sdu_len              the SDU length
+ *  @param[in]     rle_conf             the RLE configuration
+ *  @param[out]    choice               the ALPDU header
+ *
+ *  @ingroup RLE header
+ */
+void choose_alpdu_hdr(const uint16_t ptype,
+                      const unsigned char *const sdu,
+                      const size_t sdu_len,
+                      const struct rle_config *const rle_conf,
+                      struct alpdu_hdr_choice *const choice);
+
+/**
+ *  @brief         Choose the next PPDU of an ALPDU, without building it.
+ *
+ *                 Shared by the fragmentation and the estimation of the fragmentation: COMP or
+ *                 START for an ALPDU not fragmented yet, CONT or END after, and the number of
+ *                 ALPDU octets in the PPDU so that the ALPDU trailer is never fragmented.
+ *
+ *  @param[in]     rle_conf             the RLE configuration
+ *  @param[in]     ppdu_len             the room for the PPDU
+ *  @param[in]     is_fragmented        whether the ALPDU was already fragmented
+ *  @param[in]     remain_alpdu_len     the remaining ALPDU octets, the trailer included once the
+ *                                      ALPDU is fragmented only
+ *  @param[in]     alpdu_hdr_len        the length of the ALPDU header
+ *  @param[out]    choice               the PPDU
+ *
+ *  @return        true if OK
+ *                 false if the room is too small for the smallest PPDU fragment
+ *
+ *  @ingroup RLE header
+ */
+bool choose_ppdu(const struct rle_config *const rle_conf,
+                 const size_t ppdu_len,
+                 const bool is_fragmented,
+                 const size_t remain_alpdu_len,
+                 const size_t alpdu_hdr_len,
+                 struct ppdu_choice *const choice)
+__attribute__((warn_unused_result));
+
 /**
  *  @brief         create and push ALPDU header into a fragmentation buffer.
  *
@@ -272,6 +321,7 @@ void push_alpdu_hdr(struct rle_frag_buf *const frag_buf,
  *  @param[in,out] frag_buf             the fragmentation buffer in use.
  *  @param[in]     rle_conf             the RLE configuration
  *  @param[in,out] rle_ctx              the RLE context if needed (NULL if not).
+ *  @param[in]     trace                the trace callback of the transmitter
  *
  *  @return        true if OK
  *                 false if buffer is too small for the smallest PPDU fragment
@@ -281,7 +331,8 @@ void push_alpdu_hdr(struct rle_frag_buf *const frag_buf,
 bool push_ppdu_hdr(struct rle_frag_buf *const frag_buf,
                    const struct rle_config *const rle_conf,
                    const size_t ppdu_len,
-                   struct rle_ctx_mngt *const rle_ctx);
+                   struct rle_ctx_mngt *const rle_ctx,
+                   const struct rle_trace *const trace);
 
 /**
  *  @brief         Extract ALPDU fragment from complete PPDU.
@@ -425,6 +476,110 @@ int comp_alpdu_extract_sdu_frag(const unsigned char alpdu_frag[],
                                 size_t *const sdu_frag_len,
                                 size_t *const alpdu_hdr_len);
 
+/**
+ *  @brief         Load a 16-bit big-endian word, at any alignment.
+ *
+ *  @param[in]     bytes             the 2 octets.
+ *
+ *  @return        the word, in host byte order.
+ *
+ *  @ingroup RLE header
+ */
+static inline uint16_t rle_hdr_load_be16(const uint8_t *const bytes);
+
+/**
+ *  @brief         Load a 32-bit big-endian word, at any alignment.
+ *
+ *  @param[in]     bytes             the 4 octets.
+ *
+ *  @return        the word, in host byte order.
+ *
+ *  @ingroup RLE header
+ */
+static inline uint32_t rle_hdr_load_be32(const uint8_t *const bytes);
+
+/**
+ *  @brief         Store a 16-bit word in big-endian, at any alignment.
+ *
+ *  @param[out]    bytes             the 2 octets.
+ *  @param[in]     word              the word, in host byte order.
+ *
+ *  @ingroup RLE header
+ */
+static inline void rle_hdr_store_be16(uint8_t *const bytes, const uint16_t word);
+
+/**
+ *  @brief         Store a 32-bit word in big-endian, at any alignment.
+ *
+ *  @param[out]    bytes             the 4 octets.
+ *  @param[in]     word              the word, in host byte order.
+ *
+ *  @ingroup RLE header
+ */
+static inline void rle_hdr_store_be32(uint8_t *const bytes, const uint32_t word);
+
+/**
+ *  @brief         Write a whole complete PPDU header.
+ *
+ *  @param[out]    hdr               the PPDU header.
+ *  @param[in]     ppdu_len          the PPDU length field value.
+ *  @param[in]     label_type        the ALPDU label type.
+ *  @param[in]     ptype_suppressed  the protocol type suppressed bit.
+ *
+ *  @ingroup RLE header
+ */
+static inline void rle_comp_ppdu_hdr_set(rle_ppdu_hdr_comp_t *const hdr,
+                                         const uint16_t ppdu_len,
+                                         const uint8_t label_type,
+                                         const uint8_t ptype_suppressed);
+
+/**
+ *  @brief         Write a whole start PPDU header.
+ *
+ *  @param[out]    hdr               the PPDU header.
+ *  @param[in]     ppdu_len          the PPDU length field value.
+ *  @param[in]     frag_id           the fragment ID.
+ *  @param[in]     use_crc           whether the ALPDU is protected by a CRC.
+ *  @param[in]     total_len         the ALPDU total length.
+ *  @param[in]     label_type        the ALPDU label type.
+ *  @param[in]     ptype_suppressed  the protocol type suppressed bit.
+ *
+ *  @ingroup RLE header
+ */
+static inline void rle_start_ppdu_hdr_set(rle_ppdu_hdr_start_t *const hdr,
+                                          const uint16_t ppdu_len,
+                                          const uint8_t frag_id,
+                                          const bool use_crc,
+                                          const uint16_t total_len,
+                                          const uint8_t label_type,
+                                          const uint8_t ptype_suppressed);
+
+/**
+ *  @brief         Write a whole continuation or end PPDU header.
+ *
+ *  @param[out]    hdr               the PPDU header.
+ *  @param[in]     is_end            true for an END PPDU, false for a CONT one.
+ *  @param[in]     ppdu_len          the PPDU length field value.
+ *  @param[in]     frag_id           the fragment ID.
+ *
+ *  @ingroup RLE header
+ */
+static inline void rle_cont_end_ppdu_hdr_set(rle_ppdu_hdr_cont_end_t *const hdr,
+                                             const bool is_end,
+                                             const uint16_t ppdu_len,
+                                             const uint8_t frag_id);
+
+/**
+ *  @brief         Decode the fields of the first 16-bit word of a PPDU header at once.
+ *
+ *  @param[in]     hdr               the PPDU header, at least 2 octets.
+ *  @param[out]    fields            the type, length and fragment ID of the PPDU.
+ *
+ *  @ingroup RLE header
+ */
+static inline void rle_ppdu_hdr_decode(const rle_ppdu_hdr_t *const hdr,
+                                       struct rle_ppdu_hdr_fields *const fields);
+
 /**
  *  @brief         Set the PPDU length field of a PPDU header.
  *
@@ -542,120 +697,170 @@ static inline int rle_ppdu_get_fragment_type(const rle_ppdu_hdr_t *const hdr);
 /*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
 
+static inline uint16_t rle_hdr_load_be16(const uint8_t *const bytes)
+{
+	return (uint16_t)((bytes[0] << 8) | bytes[1]);
+}
+
+static inline uint32_t rle_hdr_load_be32(const uint8_t *const bytes)
+{
+	return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) |
+	       ((uint32_t)bytes[2] << 8) | (uint32_t)bytes[3];
+}
+
+static inline void rle_hdr_store_be16(uint8_t *const bytes, const uint16_t word)
+{
+	bytes[0] = (word >> 8) & 0xff;
+	bytes[1] = word & 0xff;
+}
+
+static inline void rle_hdr_store_be32(uint8_t *const bytes, const uint32_t word)
+{
+	bytes[0] = (word >> 24) & 0xff;
+	bytes[1] = (word >> 16) & 0xff;
+	bytes[2] = (word >> 8) & 0xff;
+	bytes[3] = word & 0xff;
+}
+
+static inline void rle_comp_ppdu_hdr_set(rle_ppdu_hdr_comp_t *const hdr,
+                                         const uint16_t ppdu_len,
+                                         const uint8_t label_type,
+                                         const uint8_t ptype_suppressed)
+{
+	const uint16_t word = (0x3 << RLE_PPDU_HDR_SE_SHIFT) |
+	                      ((ppdu_len & RLE_PPDU_HDR_LEN_MASK) << RLE_PPDU_HDR_LEN_SHIFT) |
+	                      ((label_type & RLE_PPDU_HDR_LT_MASK) << RLE_PPDU_HDR_LT_SHIFT) |
+	                      (ptype_suppressed & RLE_PPDU_HDR_T_MASK);
+
+	rle_hdr_store_be16(hdr->bytes, word);
+}
+
+static inline void rle_start_ppdu_hdr_set(rle_ppdu_hdr_start_t *const hdr,
+                                          const uint16_t ppdu_len,
+                                          const uint8_t frag_id,
+                                          const bool use_crc,
+                                          const uint16_t total_len,
+                                          const uint8_t label_type,
+                                          const uint8_t ptype_suppressed)
+{
+	const uint32_t first = (0x2 << RLE_PPDU_HDR_SE_SHIFT) |
+	                       ((ppdu_len & RLE_PPDU_HDR_LEN_MASK) << RLE_PPDU_HDR_LEN_SHIFT) |
+	                       (frag_id & RLE_PPDU_HDR_FRAG_ID_MASK);
+	const uint32_t second = ((use_crc ? 1 : 0) << RLE_PPDU_HDR_CRC_SHIFT) |
+	                        ((total_len & RLE_PPDU_HDR_TOTAL_LEN_MASK) <<
+	                         RLE_PPDU_HDR_TOTAL_LEN_SHIFT) |
+	                        ((label_type & RLE_PPDU_HDR_LT_MASK) << RLE_PPDU_HDR_LT_SHIFT) |
+	                        (ptype_suppressed & RLE_PPDU_HDR_T_MASK);
+
+	rle_hdr_store_be32(hdr->bytes, (first << 16) | second);
+}
+
+static inline void rle_cont_end_ppdu_hdr_set(rle_ppdu_hdr_cont_end_t *const hdr,
+                                             const bool is_end,
+                                             const uint16_t ppdu_len,
+                                             const uint8_t frag_id)
+{
+	const uint16_t word = ((is_end ? 0x1 : 0x0) << RLE_PPDU_HDR_SE_SHIFT) |
+	                      ((ppdu_len & RLE_PPDU_HDR_LEN_MASK) << RLE_PPDU_HDR_LEN_SHIFT) |
+	                      (frag_id & RLE_PPDU_HDR_FRAG_ID_MASK);
+
+	rle_hdr_store_be16(hdr->bytes, word);
+}
+
+static inline void rle_ppdu_hdr_decode(const rle_ppdu_hdr_t *const hdr,
+                                       struct rle_ppdu_hdr_fields *const fields)
+{
+	const uint16_t word = rle_hdr_load_be16(hdr->common.bytes);
+
+	fields->type = rle_ppdu_get_fragment_type(hdr);
+	fields->ppdu_len = (word >> RLE_PPDU_HDR_LEN_SHIFT) & RLE_PPDU_HDR_LEN_MASK;
+	fields->frag_id = (fields->type == RLE_PDU_COMPLETE) ? 0 :
+	                  (word & RLE_PPDU_HDR_FRAG_ID_MASK);
+}
+
 static inline void rle_ppdu_hdr_set_ppdu_len(rle_ppdu_hdr_t *const ppdu_hdr,
                                              const uint16_t ppdu_len)
 {
-#if __BYTE_ORDER == __LITTLE_ENDIAN
-	ppdu_hdr->common.rle_packet_length_1 = ((ppdu_len & 0x7ff) >> 5) & 0x3f;
-	ppdu_hdr->common.rle_packet_length_2 = ppdu_len & 0x1f;
-#elif __BYTE_ORDER == __BIG_ENDIAN
-	ppdu_hdr->common.rle_packet_length = ppdu_len;
-#else
-#error "Please fix <asm/byteorder.h>"
-#endif
-	return;
+	uint16_t word = rle_hdr_load_be16(ppdu_hdr->common.bytes);
+
+	word &= ~(RLE_PPDU_HDR_LEN_MASK << RLE_PPDU_HDR_LEN_SHIFT);
+	word |= (ppdu_len & RLE_PPDU_HDR_LEN_MASK) << RLE_PPDU_HDR_LEN_SHIFT;
+	rle_hdr_store_be16(ppdu_hdr->common.bytes, word);
 }
 
 static inline uint16_t rle_ppdu_hdr_get_ppdu_length(const rle_ppdu_hdr_t *const ppdu_hdr)
 {
-	uint16_t ppdu_length = 0;
-
-#if __BYTE_ORDER == __LITTLE_ENDIAN
-	ppdu_length = ((ppdu_hdr->common.rle_packet_length_1 & 0x3f) << 5) & 0x7ff;
-	ppdu_length |= ppdu_hdr->common.rle_packet_length_2 & 0x1f;
-#elif __BYTE_ORDER == __BIG_ENDIAN
-	ppdu_length = ppdu_hdr->common.rle_packet_length;
-#else
-#error "Please fix <asm/byteorder.h>"
-#endif
-
-	return ppdu_length;
+	return (rle_hdr_load_be16(ppdu_hdr->common.bytes) >> RLE_PPDU_HDR_LEN_SHIFT) &
+	       RLE_PPDU_HDR_LEN_MASK;
 }
 
 static inline void rle_ppdu_hdr_start_set_total_len(rle_ppdu_hdr_start_t *const ppdu_hdr,
                                                     const uint16_t total_len)
 {
-#if __BYTE_ORDER == __LITTLE_ENDIAN
-	ppdu_hdr->total_len_1 = ((total_len & 0xfff) >> 5) & 0x7f;
-	ppdu_hdr->total_len_2 = total_len & 0x1f;
-#elif __BYTE_ORDER == __BIG_ENDIAN
-	ppdu_hdr->total_len = total_len;
-#else
-#error "Please fix <asm/byteorder.h>"
-#endif
-	return;
+	uint16_t word = rle_hdr_load_be16(&ppdu_hdr->bytes[2]);
+
+	word &= ~(RLE_PPDU_HDR_TOTAL_LEN_MASK << RLE_PPDU_HDR_TOTAL_LEN_SHIFT);
+	word |= (total_len & RLE_PPDU_HDR_TOTAL_LEN_MASK) << RLE_PPDU_HDR_TOTAL_LEN_SHIFT;
+	rle_hdr_store_be16(&ppdu_hdr->bytes[2], word);
 }
 
 static inline uint16_t rle_ppdu_hdr_start_get_total_len(const rle_ppdu_hdr_start_t *const ppdu_hdr)
 {
-	uint16_t total_len = 0;
-
-#if __BYTE_ORDER == __LITTLE_ENDIAN
-	total_len = ((ppdu_hdr->total_len_1 & 0x7f) << 5) & 0xfff;
-	total_len |= ppdu_hdr->total_len_2 & 0x1f;
-#elif __BYTE_ORDER == __BIG_ENDIAN
-	total_len = ppdu_hdr->total_len;
-#else
-#error "Please fix <asm/byteorder.h>"
-#endif
-
-	return total_len;
+	return (rle_hdr_load_be16(&ppdu_hdr->bytes[2]) >> RLE_PPDU_HDR_TOTAL_LEN_SHIFT) &
+	       RLE_PPDU_HDR_TOTAL_LEN_MASK;
 }
 
 static inline bool rle_comp_ppdu_hdr_get_is_signal(const rle_ppdu_hdr_comp_t *const hdr)
 {
-	return !!(hdr->label_type == RLE_LT_PROTO_SIGNAL);
+	const uint16_t word = rle_hdr_load_be16(hdr->bytes);
+
+	return (((word >> RLE_PPDU_HDR_LT_SHIFT) & RLE_PPDU_HDR_LT_MASK) == RLE_LT_PROTO_SIGNAL);
 }
 
 static inline bool rle_comp_ppdu_hdr_get_is_suppressed(const rle_ppdu_hdr_comp_t *const hdr)
 {
-	return !!(hdr->proto_type_supp == RLE_T_PROTO_TYPE_SUPP);
+	const uint16_t word = rle_hdr_load_be16(hdr->bytes);
+
+	return ((word & RLE_PPDU_HDR_T_MASK) == RLE_T_PROTO_TYPE_SUPP);
 }
 
 static inline bool rle_start_ppdu_hdr_get_is_signal(const rle_ppdu_hdr_start_t *const hdr)
 {
-	return !!(hdr->label_type == RLE_LT_PROTO_SIGNAL);
+	const uint16_t word = rle_hdr_load_be16(&hdr->bytes[2]);
+
+	return (((word >> RLE_PPDU_HDR_LT_SHIFT) & RLE_PPDU_HDR_LT_MASK) == RLE_LT_PROTO_SIGNAL);
 }
 
 static inline bool rle_start_ppdu_hdr_get_is_suppressed(const rle_ppdu_hdr_start_t *const hdr)
 {
-	return !!(hdr->proto_type_supp == RLE_T_PROTO_TYPE_SUPP);
+	const uint16_t word = rle_hdr_load_be16(&hdr->bytes[2]);
+
+	return ((word & RLE_PPDU_HDR_T_MASK) == RLE_T_PROTO_TYPE_SUPP);
 }
 
 static inline int rle_start_ppdu_hdr_get_use_crc(const rle_ppdu_hdr_start_t *const hdr)
 {
-	return hdr->use_crc;
+	return (rle_hdr_load_be16(&hdr->bytes[2]) >> RLE_PPDU_HDR_CRC_SHIFT) & 0x1;
 }
 
 static inline uint8_t rle_start_ppdu_hdr_get_frag_id(const rle_ppdu_hdr_start_t *const hdr)
 {
-	return hdr->frag_id;
+	return rle_hdr_load_be16(hdr->bytes) & RLE_PPDU_HDR_FRAG_ID_MASK;
 }
 
 static inline uint8_t rle_cont_end_ppdu_hdr_get_frag_id(const rle_ppdu_hdr_cont_end_t *const hdr)
 {
-	return hdr->frag_id;
+	return rle_hdr_load_be16(hdr->bytes) & RLE_PPDU_HDR_FRAG_ID_MASK;
 }
 
 static inline int rle_ppdu_get_fragment_type(const rle_ppdu_hdr_t *const hdr)
 {
-	int type_rle_frag;
-
-	if (hdr->common.start_ind) {
-		if (hdr->common.end_ind) {
-			type_rle_frag = RLE_PDU_COMPLETE;
-		} else {
-			type_rle_frag = RLE_PDU_START_FRAG;
-		}
-	} else {
-		if (hdr->common.end_ind) {
-			type_rle_frag = RLE_PDU_END_FRAG;
-		} else {
-			type_rle_frag = RLE_PDU_CONT_FRAG;
-		}
-	}
-
-	return type_rle_frag;
+	/* indexed by the S and E bits */
+	static const uint8_t types[4] = {
+		RLE_PDU_CONT_FRAG, RLE_PDU_END_FRAG, RLE_PDU_START_FRAG, RLE_PDU_COMPLETE
+	};
+
+	return types[hdr->common.bytes[0] >> (RLE_PPDU_HDR_SE_SHIFT - 8)];
 }
 
 
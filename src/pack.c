@@ -49,6 +49,51 @@
 
 #define MODULE_NAME "PACK"
 
+/** Size of the page of zeros shared by the padding segments of the gathered FPDUs */
+#define RLE_PAD_IOV_PAGE_SIZE 4096
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------------- PRIVATE VARIABLES --------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** Page of zeros shared by the padding segments of the gathered FPDUs */
+static const unsigned char rle_pad_iov_page[RLE_PAD_IOV_PAGE_SIZE];
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------- PRIVATE FUNCTIONS ----------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief         Append a segment to a gathered FPDU.
+ *
+ * @param[in,out] iov                     The segments of the FPDU.
+ * @param[in,out] iov_nr                  The number of segments of the FPDU.
+ * @param[in]     base                    The octets of the segment.
+ * @param[in]     len                     The length of the segment.
+ */
+static void rle_pack_iov_push(rle_iovec_t iov[],
+                              size_t *const iov_nr,
+                              const unsigned char *const base,
+                              const size_t len);
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*----------------------------------- PRIVATE FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+static void rle_pack_iov_push(rle_iovec_t iov[],
+                              size_t *const iov_nr,
+                              const unsigned char *const base,
+                              const size_t len)
+{
+	/* the segments are only read by the vectored I/O */
+	iov[*iov_nr].iov_base = (void *)base;
+	iov[*iov_nr].iov_len = len;
+	(*iov_nr)++;
+}
+
 
 /*------------------------------------------------------------------------------------------------*/
 /*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
@@ -155,3 +200,143 @@ void rle_pad(unsigned char *const fpdu,
 		memset(fpdu + fpdu_current_pos, 0, fpdu_remaining_size);
 	}
 }
+
+enum rle_pack_status rle_pack_iov_init(const unsigned char *const label,
+                                       const size_t label_size,
+                                       rle_iovec_t iov[],
+                                       const size_t iov_max,
+                                       size_t *const iov_nr,
+                                       size_t *const fpdu_current_pos,
+                                       size_t *const fpdu_remaining_size)
+{
+	enum rle_pack_status status;
+
+	if ((label_size != 0 && label_size != 3 && label_size != 6) ||
+	    (label_size > 0 && label == NULL)) {
+		status = RLE_PACK_ERR_INVALID_LAB;
+		goto exit_label;
+	}
+
+	if (iov == NULL || iov_nr == NULL || fpdu_current_pos == NULL ||
+	    fpdu_remaining_size == NULL) {
+		status = RLE_PACK_ERR;
+		goto exit_label;
+	}
+
+	/* Check FPDU is empty */
+	if ((*fpdu_current_pos) != 0 || (*iov_nr) != 0) {
+		status = RLE_PACK_ERR;
+		goto exit_label;
+	}
+
+	/* Check there is enough place for FPDU label */
+	if ((*fpdu_remaining_size) < label_size) {
+		status = RLE_PACK_ERR_FPDU_TOO_SMALL;
+		goto exit_label;
+	}
+
+	if (label_size > 0) {
+		if (iov_max < 1) {
+			status = RLE_PACK_ERR_IOV_FULL;
+			goto exit_label;
+		}
+		rle_pack_iov_push(iov, iov_nr, label, label_size);
+		(*fpdu_current_pos) += label_size;
+		(*fpdu_remaining_size) -= label_size;
+	}
+
+	status = RLE_PACK_OK;
+
+exit_label:
+	return status;
+}
+
+enum rle_pack_status rle_pack_iov(const unsigned char *const ppdu,
+                                  const size_t ppdu_length,
+                                  const unsigned char *const label,
+                                  const size_t label_size,
+                                  rle_iovec_t iov[],
+                                  const size_t iov_max,
+                                  size_t *const iov_nr,
+                                  size_t *const fpdu_current_pos,
+                                  size_t *const fpdu_remaining_size)
+{
+	enum rle_pack_status status;
+	size_t segments_nr;
+
+	if (ppdu == NULL || ppdu_length == 0) {
+		status = RLE_PACK_ERR_INVALID_PPDU;
+		goto exit_label;
+	}
+	if ((label_size != 0 && label_size != 3 && label_size != 6) ||
+	    (label_size > 0 && label == NULL)) {
+		status = RLE_PACK_ERR_INVALID_LAB;
+		goto exit_label;
+	}
+	if (iov == NULL || iov_nr == NULL || fpdu_current_pos == NULL ||
+	    fpdu_remaining_size == NULL) {
+		status = RLE_PACK_ERR;
+		goto exit_label;
+	}
+
+	/* as rle_pack, the label comes with the first PPDU if the FPDU is empty */
+	if (((*fpdu_current_pos) == 0 && (*fpdu_remaining_size) < (label_size + ppdu_length)) ||
+	    ((*fpdu_current_pos) != 0 && (*fpdu_remaining_size) < ppdu_length)) {
+		status = RLE_PACK_ERR_FPDU_TOO_SMALL;
+		goto exit_label;
+	}
+
+	segments_nr = ((*fpdu_current_pos) == 0 && label_size > 0) ? 2 : 1;
+	if ((*iov_nr) + segments_nr > iov_max) {
+		status = RLE_PACK_ERR_IOV_FULL;
+		goto exit_label;
+	}
+
+	if ((*fpdu_current_pos) == 0 && label_size > 0) {
+		rle_pack_iov_push(iov, iov_nr, label, label_size);
+		(*fpdu_current_pos) += label_size;
+		(*fpdu_remaining_size) -= label_size;
+	}
+
+	/* point to the PPDU in its fragmentation buffer */
+	rle_pack_iov_push(iov, iov_nr, ppdu, ppdu_length);
+	(*fpdu_current_pos) += ppdu_length;
+	(*fpdu_remaining_size) -= ppdu_length;
+
+	status = RLE_PACK_OK;
+
+exit_label:
+	return status;
+}
+
+enum rle_pack_status rle_pad_iov(rle_iovec_t iov[],
+                                 const size_t iov_max,
+                                 size_t *const iov_nr,
+                                 const size_t fpdu_remaining_size)
+{
+	enum rle_pack_status status;
+	size_t remaining = fpdu_remaining_size;
+
+	if (iov == NULL || iov_nr == NULL) {
+		status = RLE_PACK_ERR;
+		goto exit_label;
+	}
+
+	if ((*iov_nr) + (fpdu_remaining_size + RLE_PAD_IOV_PAGE_SIZE - 1) / RLE_PAD_IOV_PAGE_SIZE >
+	    iov_max) {
+		status = RLE_PACK_ERR_IOV_FULL;
+		goto exit_label;
+	}
+
+	while (remaining > 0) {
+		const size_t len = remaining < RLE_PAD_IOV_PAGE_SIZE ? remaining : RLE_PAD_IOV_PAGE_SIZE;
+
+		rle_pack_iov_push(iov, iov_nr, rle_pad_iov_page, len);
+		remaining -= len;
+	}
+
+	status = RLE_PACK_OK;
+
+exit_label:
+	return status;
+}
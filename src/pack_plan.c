@@ -0,0 +1,497 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   pack_plan.c
+ * @brief  Planning of the PPDUs of the transmitter contexts over several FPDUs
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#include "fragmentation_buffer.h"
+#include "rle_transmitter.h"
+#include "header.h"
+#include "constants.h"
+#include "rle_ctx.h"
+#include "trailer.h"
+
+#include "rle.h"
+
+#ifndef __KERNEL__
+
+#include <string.h>
+
+#else
+
+#include <linux/stddef.h>
+#include <linux/types.h>
+
+#endif
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PRIVATE CONSTANTS AND MACROS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+#define MODULE_ID RLE_MOD_ID_PACK
+
+/** FPDU of an ALPDU not sent as a COMP PPDU but fragmented along the FPDUs */
+#define PACK_PLAN_SPLIT SIZE_MAX
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PRIVATE STRUCTS AND TYPEDEFS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** The ALPDU of a transmitter context along a plan */
+struct pack_plan_ctx {
+	size_t remain_alpdu_len;  /**< Remaining ALPDU octets, trailer included once fragmented */
+	size_t alpdu_hdr_len;     /**< Length of the ALPDU header                              */
+	uint8_t frag_id;          /**< The context                                             */
+	bool is_fragmented;       /**< Whether the ALPDU is already fragmented                 */
+};
+
+/**
+ * Value of a plan: the more ALPDUs sent completely the better, as each context holds one ALPDU
+ * and takes a new SDU only once free, then the more ALPDU octets carried minus the trailers of
+ * the new fragmentations the better, then the less overhead the better
+ */
+struct pack_plan_value {
+	size_t alpdu_bytes;       /**< ALPDU octets carried                           */
+	size_t header_bytes;      /**< PPDU header octets                             */
+	size_t trailer_bytes;     /**< Trailer octets added by the new fragmentations */
+	size_t completed_nr;      /**< ALPDUs sent completely                         */
+};
+
+/** The planning problem and the best plan found so far */
+struct pack_plan_problem {
+	const struct rle_config *conf;                   /**< The transmitter configuration    */
+	size_t fpdus_nr;                                 /**< The number of FPDUs              */
+	size_t trailer_len;                              /**< The trailer of a fragmented ALPDU */
+	struct pack_plan_ctx ctxs[RLE_MAX_FRAG_NUMBER];  /**< The contexts in use              */
+	size_t ctxs_nr;                                  /**< The number of contexts in use    */
+	size_t items[RLE_MAX_FRAG_NUMBER];               /**< The ALPDUs that may be COMP PPDUs,
+	                                                      the longest first                */
+	size_t items_nr;                                 /**< The number of such ALPDUs        */
+	size_t assign[RLE_MAX_FRAG_NUMBER];              /**< FPDU of the COMP PPDU of each
+	                                                      context, or PACK_PLAN_SPLIT      */
+	size_t rooms[RLE_PACK_PLAN_FPDUS_MAX];           /**< Room left by the COMP PPDUs      */
+	size_t best_assign[RLE_MAX_FRAG_NUMBER];         /**< Assignment of the best plan      */
+	struct pack_plan_value best;                     /**< Value of the best plan           */
+	size_t nodes;                                    /**< Nodes of the search explored     */
+	size_t nodes_max;                                /**< Budget of nodes of the search    */
+};
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------- PRIVATE FUNCTIONS ----------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief         Length of the COMP PPDU of a context, 0 if its ALPDU cannot be a COMP PPDU.
+ *
+ * @param[in]     ctx             The context.
+ *
+ * @return        The length of the COMP PPDU, or 0.
+ */
+static size_t pack_plan_comp_len(const struct pack_plan_ctx *const ctx);
+
+/**
+ * @brief         Run a plan: the COMP PPDUs assigned to each FPDU, then the fragments of the other
+ *                ALPDUs in the rooms left, FPDU after FPDU.
+ *
+ *                The ALPDUs already fragmented are continued first, then the ALPDUs to fragment,
+ *                the longest first. An ALPDU that does not fit in the room left lets the next
+ *                ones try, so that small gaps still carry the end of an ALPDU.
+ *
+ * @param[in]     problem         The problem, with the assignment to run.
+ * @param[out]    value           The value of the plan.
+ * @param[out]    slots           The PPDUs of the plan, NULL to compute its value only.
+ * @param[in]     slots_max       The number of PPDUs that fit in \p slots.
+ * @param[out]    info            The summary of the plan, NULL to compute its value only.
+ *
+ * @return        C_OK if OK, C_ERROR if \p slots is too small.
+ */
+static int pack_plan_run(const struct pack_plan_problem *const problem,
+                         struct pack_plan_value *const value,
+                         struct rle_pack_slot slots[],
+                         const size_t slots_max,
+                         struct rle_pack_plan_info *const info);
+
+/**
+ * @brief         Keep the assignment of the problem if its plan is better than the best one.
+ *
+ * @param[in,out] problem         The problem.
+ */
+static void pack_plan_evaluate(struct pack_plan_problem *const problem);
+
+/**
+ * @brief         Assign the ALPDUs best-fit decreasing: each one, the longest first, goes as a
+ *                COMP PPDU in the FPDU with the smallest room that fits it, else is fragmented.
+ *
+ * @param[in,out] problem         The problem.
+ */
+static void pack_plan_best_fit(struct pack_plan_problem *const problem);
+
+/**
+ * @brief         Search the assignments of the ALPDUs depth first, within the budget of nodes.
+ *
+ *                FPDUs with the same room left are equivalent for the next ALPDU, only the first
+ *                one is tried.
+ *
+ * @param[in,out] problem         The problem.
+ * @param[in]     depth           The index of the ALPDU to assign.
+ */
+static void pack_plan_search(struct pack_plan_problem *const problem, const size_t depth);
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*----------------------------------- PRIVATE FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+static size_t pack_plan_comp_len(const struct pack_plan_ctx *const ctx)
+{
+	const size_t comp_len = sizeof(rle_ppdu_hdr_comp_t) + ctx->remain_alpdu_len;
+
+	if (ctx->is_fragmented || comp_len > RLE_MAX_PPDU_PL_SIZE + sizeof(rle_ppdu_hdr_comp_t)) {
+		return 0;
+	}
+
+	return comp_len;
+}
+
+static int pack_plan_run(const struct pack_plan_problem *const problem,
+                         struct pack_plan_value *const value,
+                         struct rle_pack_slot slots[],
+                         const size_t slots_max,
+                         struct rle_pack_plan_info *const info)
+{
+	struct pack_plan_ctx ctxs[RLE_MAX_FRAG_NUMBER];
+	size_t order[RLE_MAX_FRAG_NUMBER];
+	size_t order_nr = 0;
+	size_t slots_nr = 0;
+	size_t padding = 0;
+	size_t fpdu_id;
+	size_t i;
+
+	memcpy(ctxs, problem->ctxs, problem->ctxs_nr * sizeof(struct pack_plan_ctx));
+	memset(value, 0, sizeof(struct pack_plan_value));
+
+	/* the fragmented ALPDUs first, to free their contexts, then the ones to fragment */
+	for (i = 0; i < problem->ctxs_nr; ++i) {
+		if (ctxs[i].is_fragmented) {
+			order[order_nr++] = i;
+		}
+	}
+	for (i = 0; i < problem->items_nr; ++i) {
+		if (problem->assign[problem->items[i]] == PACK_PLAN_SPLIT) {
+			order[order_nr++] = problem->items[i];
+		}
+	}
+	for (i = 0; i < problem->ctxs_nr; ++i) {
+		if (!ctxs[i].is_fragmented && pack_plan_comp_len(&ctxs[i]) == 0) {
+			order[order_nr++] = i;
+		}
+	}
+
+	for (fpdu_id = 0; fpdu_id < problem->fpdus_nr; ++fpdu_id) {
+		size_t room = problem->rooms[fpdu_id];
+
+		for (i = 0; i < problem->ctxs_nr; ++i) {
+			const size_t comp_len = sizeof(rle_ppdu_hdr_comp_t) + ctxs[i].remain_alpdu_len;
+
+			if (problem->assign[i] != fpdu_id) {
+				continue;
+			}
+			if (slots != NULL) {
+				if (slots_nr >= slots_max) {
+					goto error;
+				}
+				slots[slots_nr].frag_id = ctxs[i].frag_id;
+				slots[slots_nr].fpdu_id = fpdu_id;
+				slots[slots_nr].burst_size = comp_len;
+				slots[slots_nr].ppdu_len = comp_len;
+			}
+			slots_nr++;
+			value->alpdu_bytes += ctxs[i].remain_alpdu_len;
+			value->header_bytes += sizeof(rle_ppdu_hdr_comp_t);
+			value->completed_nr++;
+			ctxs[i].remain_alpdu_len = 0;
+		}
+
+		for (i = 0; i < order_nr && room > 0; ++i) {
+			struct pack_plan_ctx *const ctx = &ctxs[order[i]];
+			struct ppdu_choice ppdu;
+			size_t ppdu_hdr_len;
+
+			if (ctx->remain_alpdu_len == 0) {
+				continue;
+			}
+			if (!choose_ppdu(problem->conf, room, ctx->is_fragmented, ctx->remain_alpdu_len,
+			                 ctx->alpdu_hdr_len, &ppdu) || ppdu.alpdu_frag_len == 0) {
+				/* too small a room for this ALPDU, maybe not for the next ones */
+				continue;
+			}
+
+			switch (ppdu.type) {
+			case RLE_PDU_START_FRAG:
+				/* the trailer is appended with the START PPDU */
+				ctx->remain_alpdu_len += problem->trailer_len;
+				ctx->is_fragmented = true;
+				value->trailer_bytes += problem->trailer_len;
+				ppdu_hdr_len = sizeof(rle_ppdu_hdr_start_t);
+				break;
+			case RLE_PDU_CONT_FRAG:
+			case RLE_PDU_END_FRAG:
+				ppdu_hdr_len = sizeof(rle_ppdu_hdr_cont_end_t);
+				break;
+			case RLE_PDU_COMPLETE:
+			default:
+				ppdu_hdr_len = sizeof(rle_ppdu_hdr_comp_t);
+				break;
+			}
+
+			if (slots != NULL) {
+				if (slots_nr >= slots_max) {
+					goto error;
+				}
+				slots[slots_nr].frag_id = ctx->frag_id;
+				slots[slots_nr].fpdu_id = fpdu_id;
+				slots[slots_nr].burst_size = room;
+				slots[slots_nr].ppdu_len = ppdu_hdr_len + ppdu.alpdu_frag_len;
+			}
+			slots_nr++;
+			value->alpdu_bytes += ppdu.alpdu_frag_len;
+			value->header_bytes += ppdu_hdr_len;
+			ctx->remain_alpdu_len -= ppdu.alpdu_frag_len;
+			if (ctx->remain_alpdu_len == 0) {
+				value->completed_nr++;
+			}
+			room -= ppdu_hdr_len + ppdu.alpdu_frag_len;
+		}
+
+		padding += room;
+	}
+
+	if (info != NULL) {
+		info->slots_nr = slots_nr;
+		info->completed_nr = value->completed_nr;
+		info->alpdu_bytes = value->alpdu_bytes;
+		info->header_bytes = value->header_bytes;
+		info->trailer_bytes = value->trailer_bytes;
+		info->padding_bytes = padding;
+		info->nodes = problem->nodes;
+	}
+
+	return C_OK;
+
+error:
+	return C_ERROR;
+}
+
+static void pack_plan_evaluate(struct pack_plan_problem *const problem)
+{
+	const struct pack_plan_value *const best = &problem->best;
+	struct pack_plan_value value;
+	size_t carried;
+	size_t best_carried;
+
+	(void)pack_plan_run(problem, &value, NULL, 0, NULL);
+
+	/* compare the octets carried minus the new trailers without going below zero */
+	carried = value.alpdu_bytes + best->trailer_bytes;
+	best_carried = best->alpdu_bytes + value.trailer_bytes;
+
+	if (value.completed_nr > best->completed_nr ||
+	    (value.completed_nr == best->completed_nr && carried > best_carried) ||
+	    (value.completed_nr == best->completed_nr && carried == best_carried &&
+	     value.header_bytes + value.trailer_bytes < best->header_bytes + best->trailer_bytes)) {
+		problem->best = value;
+		memcpy(problem->best_assign, problem->assign, sizeof(problem->assign));
+	}
+}
+
+static void pack_plan_best_fit(struct pack_plan_problem *const problem)
+{
+	size_t i;
+
+	for (i = 0; i < problem->items_nr; ++i) {
+		const size_t k = problem->items[i];
+		const size_t comp_len = pack_plan_comp_len(&problem->ctxs[k]);
+		size_t best_fpdu = PACK_PLAN_SPLIT;
+		size_t fpdu_id;
+
+		for (fpdu_id = 0; fpdu_id < problem->fpdus_nr; ++fpdu_id) {
+			if (problem->rooms[fpdu_id] >= comp_len &&
+			    (best_fpdu == PACK_PLAN_SPLIT ||
+			     problem->rooms[fpdu_id] < problem->rooms[best_fpdu])) {
+				best_fpdu = fpdu_id;
+			}
+		}
+
+		problem->assign[k] = best_fpdu;
+		if (best_fpdu != PACK_PLAN_SPLIT) {
+			problem->rooms[best_fpdu] -= comp_len;
+		}
+	}
+}
+
+static void pack_plan_search(struct pack_plan_problem *const problem, const size_t depth)
+{
+	size_t k;
+	size_t comp_len;
+	size_t fpdu_id;
+
+	if (problem->nodes >= problem->nodes_max) {
+		return;
+	}
+	problem->nodes++;
+
+	if (depth == problem->items_nr) {
+		pack_plan_evaluate(problem);
+		return;
+	}
+
+	k = problem->items[depth];
+	comp_len = pack_plan_comp_len(&problem->ctxs[k]);
+
+	for (fpdu_id = 0; fpdu_id < problem->fpdus_nr; ++fpdu_id) {
+		size_t prev_fpdu_id;
+
+		if (problem->rooms[fpdu_id] < comp_len) {
+			continue;
+		}
+		for (prev_fpdu_id = 0; prev_fpdu_id < fpdu_id; ++prev_fpdu_id) {
+			if (problem->rooms[prev_fpdu_id] == problem->rooms[fpdu_id]) {
+				break;
+			}
+		}
+		if (prev_fpdu_id < fpdu_id) {
+			continue;
+		}
+
+		problem->assign[k] = fpdu_id;
+		problem->rooms[fpdu_id] -= comp_len;
+		pack_plan_search(problem, depth + 1);
+		problem->rooms[fpdu_id] += comp_len;
+	}
+
+	problem->assign[k] = PACK_PLAN_SPLIT;
+	pack_plan_search(problem, depth + 1);
+}
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+int rle_pack_plan(const struct rle_transmitter *const transmitter,
+                  const size_t fpdu_sizes[],
+                  const size_t fpdus_nr,
+                  const size_t search_max,
+                  struct rle_pack_slot slots[],
+                  const size_t slots_max,
+                  struct rle_pack_plan_info *const info)
+{
+	struct pack_plan_problem problem;
+	struct pack_plan_value value;
+	int status = 1;
+	size_t i;
+	size_t j;
+	uint8_t frag_id;
+
+	if (transmitter == NULL || fpdu_sizes == NULL || fpdus_nr == 0 ||
+	    fpdus_nr > RLE_PACK_PLAN_FPDUS_MAX || slots == NULL || info == NULL) {
+		goto out;
+	}
+
+	problem.conf = &transmitter->conf;
+	problem.fpdus_nr = fpdus_nr;
+	problem.trailer_len =
+		(!transmitter->conf.allow_alpdu_sequence_number && transmitter->conf.allow_alpdu_crc) ?
+		sizeof(rle_alpdu_crc_trailer_t) : sizeof(rle_alpdu_seqno_trailer_t);
+	problem.ctxs_nr = 0;
+	problem.items_nr = 0;
+	problem.nodes = 0;
+	problem.nodes_max = search_max;
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		const rle_frag_buf_t *frag_buf;
+		struct pack_plan_ctx *ctx;
+
+		if (rle_ctx_is_free(transmitter->free_ctx, frag_id)) {
+			continue;
+		}
+
+		frag_buf = (const rle_frag_buf_t *)transmitter->rle_ctx_man[frag_id].buff;
+		ctx = &problem.ctxs[problem.ctxs_nr];
+		ctx->frag_id = frag_id;
+		ctx->remain_alpdu_len = frag_buf_get_remaining_alpdu_length(frag_buf);
+		ctx->alpdu_hdr_len = (size_t)frag_buf_get_alpdu_hdr_len(frag_buf);
+		ctx->is_fragmented = frag_buf_is_fragmented(frag_buf);
+		problem.assign[problem.ctxs_nr] = PACK_PLAN_SPLIT;
+
+		/* insert the ALPDUs that may be COMP PPDUs the longest first */
+		if (pack_plan_comp_len(ctx) > 0) {
+			for (i = problem.items_nr; i > 0; --i) {
+				if (problem.ctxs[problem.items[i - 1]].remain_alpdu_len >= ctx->remain_alpdu_len) {
+					break;
+				}
+				problem.items[i] = problem.items[i - 1];
+			}
+			problem.items[i] = problem.ctxs_nr;
+			problem.items_nr++;
+		}
+
+		problem.ctxs_nr++;
+	}
+
+	/* the heuristic plan, the bound of the search */
+	memcpy(problem.rooms, fpdu_sizes, fpdus_nr * sizeof(size_t));
+	pack_plan_best_fit(&problem);
+	(void)pack_plan_run(&problem, &problem.best, NULL, 0, NULL);
+	memcpy(problem.best_assign, problem.assign, sizeof(problem.assign));
+
+	/* no plan is better than sending all the ALPDUs without new fragmentation */
+	if (search_max > 0 &&
+	    (problem.best.completed_nr < problem.ctxs_nr || problem.best.trailer_bytes > 0)) {
+		memcpy(problem.rooms, fpdu_sizes, fpdus_nr * sizeof(size_t));
+		pack_plan_search(&problem, 0);
+	}
+
+	/* run the best plan again to list its PPDUs */
+	memcpy(problem.assign, problem.best_assign, sizeof(problem.assign));
+	memcpy(problem.rooms, fpdu_sizes, fpdus_nr * sizeof(size_t));
+	for (j = 0; j < problem.ctxs_nr; ++j) {
+		if (problem.assign[j] != PACK_PLAN_SPLIT) {
+			problem.rooms[problem.assign[j]] -= pack_plan_comp_len(&problem.ctxs[j]);
+		}
+	}
+	if (pack_plan_run(&problem, &value, slots, slots_max, info) != C_OK) {
+		RLE_TRACE_ERR(&transmitter->trace, "%zu slots are too few for the plan", slots_max);
+		goto out;
+	}
+
+	status = 0;
+
+out:
+	return status;
+}
@@ -55,46 +55,59 @@
 #define MODULE_ID RLE_MOD_ID_REASSEMBLY
 
 
+static bool reassembly_get_vlan_ptype(const uint8_t *const sdu_frag,
+                                      const size_t sdu_frag_len,
+                                      uint16_t *const vlan_uncomp_ptype,
+                                      const struct rle_trace *const trace)
+__attribute__((warn_unused_result, nonnull(1, 3, 4)));
+
 static bool reassembly_insert_vlan_ptype(const uint8_t *const sdu_frag,
                                          const size_t sdu_frag_len,
-                                         struct rle_sdu *const reassembled_sdu)
-__attribute__((warn_unused_result, nonnull(1, 3)));
+                                         struct rle_sdu *const reassembled_sdu,
+                                         const struct rle_trace *const trace)
+__attribute__((warn_unused_result, nonnull(1, 3, 4)));
+
+static bool reassembly_insert_vlan_ptype_in_place(rle_rasm_buf_t *const rasm_buf,
+                                                  struct rle_sdu *const reassembled_sdu,
+                                                  const struct rle_trace *const trace)
+__attribute__((warn_unused_result, nonnull(1, 2, 3)));
 
 
 /**
- * @brief Insert the suppressed VLAN protocol type in the given VLAN/IP SDU
+ * @brief Deduce the suppressed VLAN protocol type of the given VLAN/IP SDU
  *
  * This function helps handling the special case for VLAN with embedded IPv4/IPv6:
  * the protocol field of the VLAN header is suppressed by the RLE transmitter and
  * shall be rebuilt by the RLE receiver according to the first 4 bits of the IP
  * payload.
  *
- * @param      sdu_frag          The combined SDU fragments extracted from PPDUs
- * @param      sdu_frag_len      The length of the combined SDU fragments extracted from PPDUs
- * @param[out] reassembled_sdu   The reassembled SDU with the VLAN protocol type inserted
- * @return                       true if insertion was successful,
- *                               false if frame is too short or malformed
+ * @param      sdu_frag           The combined SDU fragments extracted from PPDUs
+ * @param      sdu_frag_len       The length of the combined SDU fragments extracted from PPDUs
+ * @param[out] vlan_uncomp_ptype  The protocol type to insert in the VLAN header
+ * @param      trace              The trace callback of the receiver
+ * @return                        true if the protocol type was deduced,
+ *                                false if frame is too short or malformed
  */
-static bool reassembly_insert_vlan_ptype(const uint8_t *const sdu_frag,
-                                         const size_t sdu_frag_len,
-                                         struct rle_sdu *const reassembled_sdu)
+static bool reassembly_get_vlan_ptype(const uint8_t *const sdu_frag,
+                                      const size_t sdu_frag_len,
+                                      uint16_t *const vlan_uncomp_ptype,
+                                      const struct rle_trace *const trace)
 {
 	/* minimum SDU length:
 	 *    Ethernet header + VLAN header w/o protocol field + 1 byte of IP header */
 	const size_t comp_eth_vlan_len =
 		sizeof(struct ether_header) + sizeof(struct vlan_hdr) - sizeof(uint16_t);
 	const size_t sdu_min_len = comp_eth_vlan_len + 1;
-	uint16_t vlan_uncomp_ptype;
 
-	RLE_DEBUG("compressed protocol type 0x%02x requires to insert back the "
-	          "protocol type in the VLAN header with information from the IP "
-	          "payload", RLE_PROTO_TYPE_VLAN_COMP_WO_PTYPE_FIELD);
+	RLE_TRACE_DEBUG(trace, "compressed protocol type 0x%02x requires to insert back the "
+	                "protocol type in the VLAN header with information from the IP "
+	                "payload", RLE_PROTO_TYPE_VLAN_COMP_WO_PTYPE_FIELD);
 
 	/* drop frames that are too short: the protocol type cannot be deduced from the VLAN payload */
 	if (sdu_frag_len < sdu_min_len) {
-		RLE_ERR("ALPDU fragment is too short to deduce the VLAN protocol type "
-		        "from the first IP byte: %zu bytes available, %zu bytes required "
-		        "at least\n", sdu_frag_len, sdu_min_len);
+		RLE_TRACE_DEBUG(trace, "ALPDU fragment is too short to deduce the VLAN protocol type "
+		                "from the first IP byte: %zu bytes available, %zu bytes required "
+		                "at least\n", sdu_frag_len, sdu_min_len);
 		goto error;
 	}
 
@@ -110,25 +123,55 @@ static bool reassembly_insert_vlan_ptype(const uint8_t *const sdu_frag,
 
 		/* drop frames with unexpected protocol type in Ethernet frame: it should be VLAN */
 		if (eth_proto_type != RLE_PROTO_TYPE_VLAN_UNCOMP) {
-			RLE_ERR("failed to deduce VLAN protocol type from VLAN payload: unknown "
-			        "Ethernet protocol type 0x%04x instead of VLAN\n", eth_proto_type);
+			RLE_TRACE_DEBUG(trace, "failed to deduce VLAN protocol type from VLAN payload: "
+			                "unknown Ethernet protocol type 0x%04x instead of VLAN\n",
+			                eth_proto_type);
 			goto error;
 		}
 
 		/* deduce VLAN protocol type from the first 4 bits of the VLAN payload */
 		switch (ip_version) {
 		case 4:
-			vlan_uncomp_ptype = RLE_PROTO_TYPE_IPV4_UNCOMP;
+			*vlan_uncomp_ptype = RLE_PROTO_TYPE_IPV4_UNCOMP;
 			break;
 		case 6:
-			vlan_uncomp_ptype = RLE_PROTO_TYPE_IPV6_UNCOMP;
+			*vlan_uncomp_ptype = RLE_PROTO_TYPE_IPV6_UNCOMP;
 			break;
 		default:
-			RLE_ERR("failed to deduce VLAN protocol type from VLAN payload: "
-			        "unknown IP version %u\n", ip_version);
+			RLE_TRACE_DEBUG(trace, "failed to deduce VLAN protocol type from VLAN payload: "
+			                "unknown IP version %u\n", ip_version);
 			goto error;
 		}
-		RLE_DEBUG("IP version %u detected in VLAN payload", ip_version);
+		RLE_TRACE_DEBUG(trace, "IP version %u detected in VLAN payload", ip_version);
+	}
+
+	return true;
+
+error:
+	return false;
+}
+
+/**
+ * @brief Insert the suppressed VLAN protocol type in the given VLAN/IP SDU
+ *
+ * @param      sdu_frag          The combined SDU fragments extracted from PPDUs
+ * @param      sdu_frag_len      The length of the combined SDU fragments extracted from PPDUs
+ * @param[out] reassembled_sdu   The reassembled SDU with the VLAN protocol type inserted
+ * @param      trace             The trace callback of the receiver
+ * @return                       true if insertion was successful,
+ *                               false if frame is too short or malformed
+ */
+static bool reassembly_insert_vlan_ptype(const uint8_t *const sdu_frag,
+                                         const size_t sdu_frag_len,
+                                         struct rle_sdu *const reassembled_sdu,
+                                         const struct rle_trace *const trace)
+{
+	const size_t comp_eth_vlan_len =
+		sizeof(struct ether_header) + sizeof(struct vlan_hdr) - sizeof(uint16_t);
+	uint16_t vlan_uncomp_ptype;
+
+	if (!reassembly_get_vlan_ptype(sdu_frag, sdu_frag_len, &vlan_uncomp_ptype, trace)) {
+		return false;
 	}
 
 	reassembled_sdu->size = sdu_frag_len + sizeof(uint16_t);
@@ -150,9 +193,45 @@ static bool reassembly_insert_vlan_ptype(const uint8_t *const sdu_frag,
 	       sdu_frag + comp_eth_vlan_len, sdu_frag_len - comp_eth_vlan_len);
 
 	return true;
+}
 
-error:
-	return false;
+/**
+ * @brief Insert the suppressed VLAN protocol type in the SDU of a reassembly buffer
+ *
+ * The Ethernet header and the first part of the VLAN header are moved back in the headroom of
+ * the reassembly buffer, so that the SDU is then copied at once without moving its payload.
+ *
+ * @param      rasm_buf          The reassembly buffer with the reassembled VLAN/IP SDU
+ * @param[out] reassembled_sdu   The reassembled SDU with the VLAN protocol type inserted
+ * @param      trace             The trace callback of the receiver
+ * @return                       true if insertion was successful,
+ *                               false if frame is too short or malformed
+ */
+static bool reassembly_insert_vlan_ptype_in_place(rle_rasm_buf_t *const rasm_buf,
+                                                  struct rle_sdu *const reassembled_sdu,
+                                                  const struct rle_trace *const trace)
+{
+	const size_t comp_eth_vlan_len =
+		sizeof(struct ether_header) + sizeof(struct vlan_hdr) - sizeof(uint16_t);
+	const size_t sdu_frag_len = rasm_buf->sdu_info.size;
+	unsigned char *const sdu = rasm_buf->sdu.start - sizeof(uint16_t);
+	uint16_t vlan_uncomp_ptype;
+
+	assert(sdu >= rasm_buf->buffer);
+
+	if (!reassembly_get_vlan_ptype(rasm_buf->sdu.start, sdu_frag_len, &vlan_uncomp_ptype,
+	                               trace)) {
+		return false;
+	}
+
+	memmove(sdu, rasm_buf->sdu.start, comp_eth_vlan_len);
+	rle_hdr_store_be16(sdu + comp_eth_vlan_len, vlan_uncomp_ptype);
+
+	reassembled_sdu->size = sdu_frag_len + sizeof(uint16_t);
+	reassembled_sdu->protocol_type = RLE_PROTO_TYPE_VLAN_UNCOMP;
+	memcpy(reassembled_sdu->buffer, sdu, reassembled_sdu->size);
+
+	return true;
 }
 
 
@@ -174,19 +253,15 @@ int reassembly_comp_ppdu(struct rle_receiver *_this,
 	uint8_t comp_ptype;
 	rle_ppdu_hdr_comp_t *const header = (rle_ppdu_hdr_comp_t *)ppdu;
 
-#ifdef TIME_DEBUG
-	struct timeval tv_start = { .tv_sec = 0L, .tv_usec = 0L };
-	struct timeval tv_end = { .tv_sec = 0L, .tv_usec = 0L };
-	struct timeval tv_delta;
-	gettimeofday(&tv_start, NULL);
-#endif
+	const struct rle_trace *const trace = &_this->trace;
+	const uint64_t lat_start = rle_latency_start(_this->latency);
 
-	RLE_DEBUG("handle PPDU COMP");
+	RLE_TRACE_DEBUG(trace, "handle PPDU COMP");
 
 	comp_ppdu_extract_alpdu_frag(ppdu, ppdu_length, &alpdu_frag, &alpdu_frag_len);
 
 	if (alpdu_frag_len == 0) {
-		RLE_WARN("warning: 0-byte ALPDU in Complete PPDU");
+		RLE_TRACE_WARN(trace, "warning: 0-byte ALPDU in Complete PPDU");
 	}
 
 	if (rle_comp_ppdu_hdr_get_is_suppressed(header)) {
@@ -217,6 +292,8 @@ int reassembly_comp_ppdu(struct rle_receiver *_this,
 	}
 
 	if (ret) {
+		RLE_RECEIVER_ERR(_this, RLE_DECAP_ERROR_ALPDU_HDR,
+		                 "invalid ALPDU header in %zu-byte PPDU COMP", ppdu_length);
 		ret = C_ERROR;
 		goto out;
 	}
@@ -232,8 +309,9 @@ int reassembly_comp_ppdu(struct rle_receiver *_this,
 		/* special case for VLAN with embedded IPv4/IPv6: the protocol field of the VLAN
 		 * header is suppressed by the RLE transmitter and shall be rebuilt by the RLE
 		 * receiver according to the first 4 bits of the IP payload */
-		if (!reassembly_insert_vlan_ptype(sdu_frag, sdu_frag_len, reassembled_sdu)) {
-			RLE_ERR("failed to insert VLAN protocol type in Ethernet/VLAN/IP headers");
+		if (!reassembly_insert_vlan_ptype(sdu_frag, sdu_frag_len, reassembled_sdu, trace)) {
+			RLE_RECEIVER_ERR(_this, RLE_DECAP_ERROR_VLAN,
+			                 "failed to insert VLAN protocol type in Ethernet/VLAN/IP headers");
 			ret = C_ERROR;
 			goto out;
 		}
@@ -242,12 +320,8 @@ int reassembly_comp_ppdu(struct rle_receiver *_this,
 	ret = C_REASSEMBLY_OK;
 
 out:
-#ifdef TIME_DEBUG
-	gettimeofday(&tv_end, NULL);
-	tv_delta.tv_sec = tv_end.tv_sec - tv_start.tv_sec;
-	tv_delta.tv_usec = tv_end.tv_usec - tv_start.tv_usec;
-	RLE_DEBUG("duration [%04ld.%06ld].", tv_delta.tv_sec, tv_delta.tv_usec);
-#endif
+	rle_latency_stop(_this->latency, RLE_LATENCY_STAGE_REASM_COMP, RLE_LATENCY_NO_CTX,
+	                 lat_start);
 
 	return ret;
 }
@@ -274,16 +348,12 @@ int reassembly_start_ppdu(struct rle_receiver *_this,
 	size_t alpdu_trailer_len;
 	int ret_extract;
 
-#ifdef TIME_DEBUG
-	struct timeval tv_start = { .tv_sec = 0L, .tv_usec = 0L };
-	struct timeval tv_end = { .tv_sec = 0L, .tv_usec = 0L };
-	struct timeval tv_delta;
-	gettimeofday(&tv_start, NULL);
-#endif
+	const struct rle_trace *const trace = &_this->trace;
+	const uint64_t lat_start = rle_latency_start(_this->latency);
 
 	*index_ctx = rle_start_ppdu_hdr_get_frag_id((rle_ppdu_hdr_start_t *)ppdu);
-	RLE_DEBUG("START: fragment_id 0x%0x", *index_ctx);
-	RLE_DEBUG("handle PPDU START for context with ID %d", *index_ctx);
+	RLE_TRACE_DEBUG(trace, "START: fragment_id 0x%0x", *index_ctx);
+	RLE_TRACE_DEBUG(trace, "handle PPDU START for context with ID %d", *index_ctx);
 	assert((*index_ctx) >= 0 && (*index_ctx) <= RLE_MAX_FRAG_ID);
 
 	rle_ctx = &_this->rle_ctx_man[*index_ctx];
@@ -294,7 +364,8 @@ int reassembly_start_ppdu(struct rle_receiver *_this,
 	rle_ctx_incr_counter_bytes_in(rle_ctx, ppdu_length);
 
 	if (is_context_free(_this, *index_ctx) == false) {
-		RLE_ERR("invalid Start on context not free, frag id [%d].", *index_ctx);
+		RLE_RECEIVER_ERR(_this, RLE_DECAP_ERROR_CTX_STATE,
+		                 "invalid Start on context not free, frag id [%d].", *index_ctx);
 		/* Context is not free, whereas it must be. an error must have occured. */
 		/* Freeing context, updating stats, and restarting receiving. */
 		goto out;
@@ -340,40 +411,45 @@ int reassembly_start_ppdu(struct rle_receiver *_this,
 		alpdu_hdr_len = sizeof(rle_alpdu_hdr_uncomp_t);
 	}
 	if (ret_extract) {
+		RLE_RECEIVER_ERR(_this, RLE_DECAP_ERROR_ALPDU_HDR,
+		                 "invalid ALPDU header in PPDU START with frag id %d", *index_ctx);
 		goto out;
 	}
 
 	if (sdu_frag_len > sdu_total_len) {
-		RLE_ERR("PPDU START with frag id %d contains more SDU bytes than expected in total "
-		        "(%zu bytes in fragment, %zu bytes expected in total)", *index_ctx,
-		        sdu_frag_len, sdu_total_len);
+		RLE_RECEIVER_ERR(_this, RLE_DECAP_ERROR_INV_LEN,
+		                 "PPDU START with frag id %d contains more SDU bytes than expected in "
+		                 "total (%zu bytes in fragment, %zu bytes expected in total)", *index_ctx,
+		                 sdu_frag_len, sdu_total_len);
 		goto out;
 	}
 	sdu_total_len -= alpdu_hdr_len;
 
 	if (is_crc_used) {
-		RLE_DEBUG("ALPDU trailer is CRC");
+		RLE_TRACE_DEBUG(trace, "ALPDU trailer is CRC");
 		alpdu_trailer_len = sizeof(rle_alpdu_crc_trailer_t);
 	} else {
-		RLE_DEBUG("ALPDU trailer is seqnum");
+		RLE_TRACE_DEBUG(trace, "ALPDU trailer is seqnum");
 		alpdu_trailer_len = sizeof(rle_alpdu_seqno_trailer_t);
 	}
 	if (alpdu_trailer_len > sdu_total_len) {
-		RLE_ERR("PPDU START with frag id %d contains too few bytes for the ALPDU trailer "
-		        "(at least %zu bytes needed, but only %zu bytes available", *index_ctx,
-		        alpdu_trailer_len, sdu_total_len);
+		RLE_RECEIVER_ERR(_this, RLE_DECAP_ERROR_TRAILER_SHORT,
+		                 "PPDU START with frag id %d contains too few bytes for the ALPDU "
+		                 "trailer (at least %zu bytes needed, but only %zu bytes available",
+		                 *index_ctx, alpdu_trailer_len, sdu_total_len);
 		goto out;
 	}
 	sdu_total_len -= alpdu_trailer_len;
 
 	rle_ctx_set_use_crc(rle_ctx, is_crc_used);
-	RLE_DEBUG("ALPDU trailer is %s",
-	          rle_ctx_get_use_crc(rle_ctx) ? "CRC" : "seqnum");
+	RLE_TRACE_DEBUG(trace, "ALPDU trailer is %s",
+	                rle_ctx_get_use_crc(rle_ctx) ? "CRC" : "seqnum");
 
 	if (sdu_frag_len > sdu_total_len) {
-		RLE_ERR("PPDU START with frag id %d contains more SDU bytes than expected in total "
-		        "(%zu bytes in fragment, %zu bytes expected in total)", *index_ctx,
-		        sdu_frag_len, sdu_total_len);
+		RLE_RECEIVER_ERR(_this, RLE_DECAP_ERROR_INV_LEN,
+		                 "PPDU START with frag id %d contains more SDU bytes than expected in "
+		                 "total (%zu bytes in fragment, %zu bytes expected in total)", *index_ctx,
+		                 sdu_frag_len, sdu_total_len);
 		goto out;
 	}
 	rasm_buf_init(rasm_buf);
@@ -395,12 +471,7 @@ out:
 		rle_receiver_free_context(_this, *index_ctx);
 	}
 
-#ifdef TIME_DEBUG
-	gettimeofday(&tv_end, NULL);
-	tv_delta.tv_sec = tv_end.tv_sec - tv_start.tv_sec;
-	tv_delta.tv_usec = tv_end.tv_usec - tv_start.tv_usec;
-	RLE_DEBUG("duration [%04ld.%06ld].", tv_delta.tv_sec, tv_delta.tv_usec);
-#endif
+	rle_latency_stop(_this->latency, RLE_LATENCY_STAGE_REASM_START, *index_ctx, lat_start);
 
 	return ret;
 }
@@ -418,16 +489,12 @@ int reassembly_cont_ppdu(struct rle_receiver *_this,
 	rle_rasm_buf_t *rasm_buf;
 	struct rle_ctx_mngt *rle_ctx;
 
-#ifdef TIME_DEBUG
-	struct timeval tv_start = { .tv_sec = 0L, .tv_usec = 0L };
-	struct timeval tv_end = { .tv_sec = 0L, .tv_usec = 0L };
-	struct timeval tv_delta;
-	gettimeofday(&tv_start, NULL);
-#endif
+	const struct rle_trace *const trace = &_this->trace;
+	const uint64_t lat_start = rle_latency_start(_this->latency);
 
 	*index_ctx = rle_cont_end_ppdu_hdr_get_frag_id((rle_ppdu_hdr_cont_end_t *)ppdu);
-	RLE_DEBUG("CONT: fragment_id 0x%0x", *index_ctx);
-	RLE_DEBUG("handle PPDU CONT for context with ID %d", *index_ctx);
+	RLE_TRACE_DEBUG(trace, "CONT: fragment_id 0x%0x", *index_ctx);
+	RLE_TRACE_DEBUG(trace, "handle PPDU CONT for context with ID %d", *index_ctx);
 	assert((*index_ctx >= 0) && (*index_ctx <= RLE_MAX_FRAG_ID));
 
 	rle_ctx = &_this->rle_ctx_man[*index_ctx];
@@ -437,20 +504,21 @@ int reassembly_cont_ppdu(struct rle_receiver *_this,
 	rle_ctx_incr_counter_bytes_in(rle_ctx, ppdu_length);
 
 	if (is_context_free(_this, *index_ctx) == true) {
-		RLE_ERR("invalid Cont on context free, frag id [%d].", *index_ctx);
+		RLE_RECEIVER_ERR(_this, RLE_DECAP_ERROR_CTX_STATE,
+		                 "invalid Cont on context free, frag id [%d].", *index_ctx);
 		/* Context is free, whereas it must not. an error must have occured. */
 		/* Freeing context and updating stats. At least one packet is partialy lost.*/
 		goto out;
 	}
 
-	RLE_DEBUG("ALPDU trailer is %s",
-	          rle_ctx_get_use_crc(rle_ctx) ? "CRC" : "seqnum");
+	RLE_TRACE_DEBUG(trace, "ALPDU trailer is %s",
+	                rle_ctx_get_use_crc(rle_ctx) ? "CRC" : "seqnum");
 
 	cont_end_ppdu_extract_alpdu_frag(ppdu, ppdu_length, &alpdu_frag,
 	                                 &alpdu_frag_len);
 
 	if (alpdu_frag_len == 0) {
-		RLE_WARN("warning: 0-byte ALPDU in PPDU CONT");
+		RLE_TRACE_WARN(trace, "warning: 0-byte ALPDU in PPDU CONT");
 	}
 
 	sdu_frag = alpdu_frag;
@@ -458,10 +526,12 @@ int reassembly_cont_ppdu(struct rle_receiver *_this,
 
 	if (rasm_buf_get_reassembled_sdu_len(rasm_buf) + sdu_frag_len >
 	    rasm_buf_get_sdu_len(rasm_buf)) {
-		RLE_ERR("PPDU CONT with frag id %d contains more SDU bytes than expected in total "
-		        "(%zu bytes already received, %zu bytes in fragment, %zu bytes expected "
-		        "in total)", *index_ctx, rasm_buf_get_reassembled_sdu_len(rasm_buf),
-		        sdu_frag_len, rasm_buf_get_sdu_len(rasm_buf));
+		RLE_RECEIVER_ERR(_this, RLE_DECAP_ERROR_INV_LEN,
+		                 "PPDU CONT with frag id %d contains more SDU bytes than expected in "
+		                 "total (%zu bytes already received, %zu bytes in fragment, %zu bytes "
+		                 "expected in total)", *index_ctx,
+		                 rasm_buf_get_reassembled_sdu_len(rasm_buf), sdu_frag_len,
+		                 rasm_buf_get_sdu_len(rasm_buf));
 		goto out;
 	}
 	rasm_buf_init_sdu_frag(rasm_buf);
@@ -479,12 +549,7 @@ out:
 		rle_receiver_free_context(_this, *index_ctx);
 	}
 
-#ifdef TIME_DEBUG
-	gettimeofday(&tv_end, NULL);
-	tv_delta.tv_sec = tv_end.tv_sec - tv_start.tv_sec;
-	tv_delta.tv_usec = tv_end.tv_usec - tv_start.tv_usec;
-	RLE_DEBUG("duration [%04ld.%06ld].", tv_delta.tv_sec, tv_delta.tv_usec);
-#endif
+	rle_latency_stop(_this->latency, RLE_LATENCY_STAGE_REASM_CONT, *index_ctx, lat_start);
 
 	return ret;
 }
@@ -506,16 +571,12 @@ int reassembly_end_ppdu(struct rle_receiver *_this,
 	size_t rle_trailer_len;
 	size_t lost_packets = 0;
 
-#ifdef TIME_DEBUG
-	struct timeval tv_start = { .tv_sec = 0L, .tv_usec = 0L };
-	struct timeval tv_end = { .tv_sec = 0L, .tv_usec = 0L };
-	struct timeval tv_delta;
-	gettimeofday(&tv_start, NULL);
-#endif
+	const struct rle_trace *const trace = &_this->trace;
+	const uint64_t lat_start = rle_latency_start(_this->latency);
 
 	*index_ctx = rle_cont_end_ppdu_hdr_get_frag_id((rle_ppdu_hdr_cont_end_t *)ppdu);
-	RLE_DEBUG("END: fragment_id 0x%0x", *index_ctx);
-	RLE_DEBUG("handle PPDU END for context with ID %d", *index_ctx);
+	RLE_TRACE_DEBUG(trace, "END: fragment_id 0x%0x", *index_ctx);
+	RLE_TRACE_DEBUG(trace, "handle PPDU END for context with ID %d", *index_ctx);
 	assert((*index_ctx >= 0) && (*index_ctx <= RLE_MAX_FRAG_ID));
 
 	rle_ctx = &_this->rle_ctx_man[*index_ctx];
@@ -525,7 +586,8 @@ int reassembly_end_ppdu(struct rle_receiver *_this,
 	rle_ctx_incr_counter_bytes_in(rle_ctx, ppdu_length);
 
 	if (is_context_free(_this, *index_ctx) == true) {
-		RLE_ERR("invalid End on context free, frag id [%d].", *index_ctx);
+		RLE_RECEIVER_ERR(_this, RLE_DECAP_ERROR_CTX_STATE,
+		                 "invalid End on context free, frag id [%d].", *index_ctx);
 		/* Context is free, whereas it must not. an error must have occured. */
 		/* Freeing context and updating stats. At least one packet is partialy lost.*/
 		rle_ctx_incr_counter_dropped(rle_ctx);
@@ -539,16 +601,17 @@ int reassembly_end_ppdu(struct rle_receiver *_this,
 	cont_end_ppdu_extract_alpdu_frag(ppdu, ppdu_length, &alpdu_frag, &alpdu_frag_len);
 
 	if (rle_ctx_get_use_crc(rle_ctx)) {
-		RLE_DEBUG("ALPDU trailer is CRC");
+		RLE_TRACE_DEBUG(trace, "ALPDU trailer is CRC");
 		rle_trailer_len = sizeof(rle_alpdu_crc_trailer_t);
 	} else {
-		RLE_DEBUG("ALPDU trailer is seqnum");
+		RLE_TRACE_DEBUG(trace, "ALPDU trailer is seqnum");
 		rle_trailer_len = sizeof(rle_alpdu_seqno_trailer_t);
 	}
 	if (alpdu_frag_len < rle_trailer_len) {
-		RLE_ERR("PPDU END does not contain enough bytes for the trailer: %zu bytes "
-		        "available while at least %zu bytes required", alpdu_frag_len,
-		        rle_trailer_len);
+		RLE_RECEIVER_ERR(_this, RLE_DECAP_ERROR_TRAILER_SHORT,
+		                 "PPDU END does not contain enough bytes for the trailer: %zu bytes "
+		                 "available while at least %zu bytes required", alpdu_frag_len,
+		                 rle_trailer_len);
 		goto out;
 	}
 	sdu_frag = alpdu_frag;
@@ -559,10 +622,12 @@ int reassembly_end_ppdu(struct rle_receiver *_this,
 
 	if (rasm_buf_get_reassembled_sdu_len(rasm_buf) + sdu_frag_len >
 	    rasm_buf_get_sdu_len(rasm_buf)) {
-		RLE_ERR("PPDU END with frag id %d contains more SDU bytes than expected in total "
-		        "(%zu bytes already received, %zu bytes in fragment, %zu bytes expected "
-		        "in total)", *index_ctx, rasm_buf_get_reassembled_sdu_len(rasm_buf),
-		        sdu_frag_len, rasm_buf_get_sdu_len(rasm_buf));
+		RLE_RECEIVER_ERR(_this, RLE_DECAP_ERROR_INV_LEN,
+		                 "PPDU END with frag id %d contains more SDU bytes than expected in "
+		                 "total (%zu bytes already received, %zu bytes in fragment, %zu bytes "
+		                 "expected in total)", *index_ctx,
+		                 rasm_buf_get_reassembled_sdu_len(rasm_buf), sdu_frag_len,
+		                 rasm_buf_get_sdu_len(rasm_buf));
 		goto out;
 	}
 	rasm_buf_init_sdu_frag(rasm_buf);
@@ -570,10 +635,13 @@ int reassembly_end_ppdu(struct rle_receiver *_this,
 	rasm_buf_cpy_sdu_frag(rasm_buf, sdu_frag);
 
 	if (rasm_buf_get_sdu_len(rasm_buf) > rasm_buf_get_reassembled_sdu_len(rasm_buf)) {
-		RLE_ERR("END PPDU received but %zu bytes still missing (%zu-byte SDU expected, "
-		        "but only %zu bytes received)",
-		        rasm_buf_get_sdu_len(rasm_buf) - rasm_buf_get_reassembled_sdu_len(rasm_buf),
-		        rasm_buf_get_sdu_len(rasm_buf), rasm_buf_get_reassembled_sdu_len(rasm_buf));
+		RLE_RECEIVER_ERR(_this, RLE_DECAP_ERROR_INV_LEN,
+		                 "END PPDU received but %zu bytes still missing (%zu-byte SDU expected, "
+		                 "but only %zu bytes received)",
+		                 rasm_buf_get_sdu_len(rasm_buf) -
+		                 rasm_buf_get_reassembled_sdu_len(rasm_buf),
+		                 rasm_buf_get_sdu_len(rasm_buf),
+		                 rasm_buf_get_reassembled_sdu_len(rasm_buf));
 		goto out;
 	}
 
@@ -581,29 +649,37 @@ int reassembly_end_ppdu(struct rle_receiver *_this,
 		/* SDU is complete */
 		reassembled_sdu->size = rasm_buf->sdu_info.size;
 		reassembled_sdu->protocol_type = rasm_buf->sdu_info.protocol_type;
-		memcpy(reassembled_sdu->buffer, rasm_buf->sdu_info.buffer, reassembled_sdu->size);
-		RLE_DEBUG("%zu-byte SDU with protocol 0x%04x is complete",
-		          reassembled_sdu->size, reassembled_sdu->protocol_type);
+		memcpy(reassembled_sdu->buffer, rasm_buf->sdu.start, reassembled_sdu->size);
+		RLE_TRACE_DEBUG(trace, "%zu-byte SDU with protocol 0x%04x is complete",
+		                reassembled_sdu->size, reassembled_sdu->protocol_type);
 	} else {
 		assert(rasm_buf->sdu_info.protocol_type == RLE_PROTO_TYPE_VLAN_UNCOMP);
 
-		RLE_DEBUG("%zu-byte SDU with protocol 0x%04x shall be modified to insert "
-		          "the Protocol Type field in the VLAN header",
-		          rasm_buf->sdu_info.size, rasm_buf->sdu_info.protocol_type);
+		RLE_TRACE_DEBUG(trace, "%zu-byte SDU with protocol 0x%04x shall be modified to insert "
+		                "the Protocol Type field in the VLAN header",
+		                rasm_buf->sdu_info.size, rasm_buf->sdu_info.protocol_type);
 
 		/* special case for VLAN with embedded IPv4/IPv6: the protocol field of the VLAN
 		 * header is suppressed by the RLE transmitter and shall be rebuilt by the RLE
 		 * receiver according to the first 4 bits of the IP payload */
-		if (!reassembly_insert_vlan_ptype(rasm_buf->sdu.start, rasm_buf->sdu_info.size,
-		                                  reassembled_sdu)) {
-			RLE_ERR("failed to insert VLAN protocol type in Ethernet/VLAN/IP headers");
+		if (!reassembly_insert_vlan_ptype_in_place(rasm_buf, reassembled_sdu, trace)) {
+			RLE_RECEIVER_ERR(_this, RLE_DECAP_ERROR_VLAN,
+			                 "failed to insert VLAN protocol type in Ethernet/VLAN/IP headers");
 			goto out;
 		}
 	}
 
 	if (check_alpdu_trailer(rle_trailer, reassembled_sdu, rle_ctx,
 	                        &(_this->is_ctx_seqnum_init[*index_ctx]), &lost_packets) != 0) {
-		RLE_ERR("Wrong RLE trailer.");
+		if (rle_ctx_get_use_crc(rle_ctx)) {
+			RLE_RECEIVER_ERR(_this, RLE_DECAP_ERROR_CRC,
+			                 "wrong CRC for %zu-byte SDU of protocol 0x%04x in frag id %d",
+			                 reassembled_sdu->size, reassembled_sdu->protocol_type, *index_ctx);
+		} else {
+			RLE_RECEIVER_ERR(_this, RLE_DECAP_ERROR_SEQNUM,
+			                 "sequence number gap in frag id %d: %zu SDU(s) lost", *index_ctx,
+			                 lost_packets);
+		}
 		goto out;
 	}
 
@@ -623,12 +699,35 @@ out:
 
 	rle_receiver_free_context(_this, *index_ctx);
 
-#ifdef TIME_DEBUG
-	gettimeofday(&tv_end, NULL);
-	tv_delta.tv_sec = tv_end.tv_sec - tv_start.tv_sec;
-	tv_delta.tv_usec = tv_end.tv_usec - tv_start.tv_usec;
-	RLE_DEBUG("duration [%04ld.%06ld].", tv_delta.tv_sec, tv_delta.tv_usec);
-#endif
+	rle_latency_stop(_this->latency, RLE_LATENCY_STAGE_REASM_END, *index_ctx, lat_start);
 
 	return ret;
 }
+
+size_t reassembly_sdu_max_size(struct rle_receiver *_this,
+                               const unsigned char ppdu[],
+                               const size_t ppdu_length)
+{
+	const rle_ppdu_hdr_t *const hdr = (const rle_ppdu_hdr_t *)ppdu;
+	const rle_rasm_buf_t *rasm_buf;
+	uint8_t frag_id;
+
+	switch (rle_ppdu_get_fragment_type(hdr)) {
+	case RLE_PDU_COMPLETE:
+		/* the PPDU header is at least as large as the VLAN protocol type to insert */
+		return ppdu_length;
+	case RLE_PDU_END_FRAG:
+		frag_id = rle_cont_end_ppdu_hdr_get_frag_id((const rle_ppdu_hdr_cont_end_t *)ppdu);
+		if (is_context_free(_this, frag_id)) {
+			return 0;
+		}
+		rasm_buf = (const rle_rasm_buf_t *)_this->rle_ctx_man[frag_id].buff;
+		if (rasm_buf->comp_protocol_type == RLE_PROTO_TYPE_VLAN_COMP_WO_PTYPE_FIELD) {
+			return rasm_buf->sdu_info.size + sizeof(uint16_t);
+		}
+		return rasm_buf->sdu_info.size;
+	default:
+		/* START and CONT PPDUs never complete a SDU */
+		return 0;
+	}
+}
@@ -135,5 +135,20 @@ int reassembly_end_ppdu(struct rle_receiver *_this, const unsigned char ppdu[],
                         const size_t ppdu_length, int *const index_ctx,
                         struct rle_sdu *const reassembled_sdu);
 
+/**
+ * @brief Get the largest SDU that a PPDU may complete, before it is reassembled.
+ *
+ * @param[in]     _this            The receiver module to use for reassembly.
+ * @param[in]     ppdu             The PPDU, its header at least.
+ * @param[in]     ppdu_length      The length of the PPDU.
+ *
+ * @return        The largest size of the SDU completed by the PPDU, 0 if it cannot complete any.
+ *
+ * @ingroup RLE receiver
+ */
+size_t reassembly_sdu_max_size(struct rle_receiver *_this,
+                               const unsigned char ppdu[],
+                               const size_t ppdu_length);
+
 
 #endif /* __REASSEMBLY_H__ */
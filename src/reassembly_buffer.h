@@ -45,6 +45,9 @@
 
 /** Maximum size for a reassembly buffer. */
 #define RLE_R_BUFF_LEN ((2 << 12) - 1)
+
+/** Room before the SDU in a reassembly buffer, to insert back a suppressed VLAN protocol type */
+#define RLE_R_BUFF_HEADROOM sizeof(uint16_t)
 #define MODULE_ID RLE_MOD_ID_REASSEMBLY_BUFFER
 
 
@@ -75,15 +78,15 @@ typedef struct reassembly_buffer_ptrs rasm_buf_ptrs_t;
  *
  * Init:
  *
- *                     MAX
- *                     SDU
- *  <--------------------------------->
- * +-+···+-+-+···+-+-+-+···+-+-+-+···+-+
- * |/|   |/|/|   |/|/|/|   |/|/|/|   |/|
- * +-+···+-+-+···+-+-+-+···+-+-+-+···+-+
- *  ^
- *  |
- *  ptrs
+ *   HEAD          MAX
+ *   ROOM          SDU
+ *  <---> <--------------------------->
+ * +-+-+-+-+···+-+-+-+···+-+-+-+···+-+-+
+ * |/|/|/|/|   |/|/|/|   |/|/|/|   |/|/|
+ * +-+-+-+-+···+-+-+-+···+-+-+-+···+-+-+
+ *        ^
+ *        |
+ *       ptrs
  *
  * In use:
  *
@@ -187,20 +190,25 @@ void rasm_buf_sdu_frag_put(rle_rasm_buf_t *const rasm_buf, const size_t size);
 /**
  * @brief         Create a new reassembly buffer.
  *
+ * @param[in]     allocator                  The allocator, NULL for the registered one.
+ *
  * @return        The reassembly buffer if OK, else NULL.
  *
  * @ingroup       RLE Reassembly buffer.
  */
-static inline rle_rasm_buf_t * rasm_buf_new(void);
+static inline rle_rasm_buf_t * rasm_buf_new(const struct rle_allocator *const allocator);
 
 /**
  * @brief         Destroy a reassembly buffer.
  *
+ * @param[in]     allocator                  The allocator of the buffer, NULL for the registered
+ *                                           one.
  * @param[in,out] rasm_buf                   The reassembly buffer to destroy.
  *
  * @ingroup       RLE Reassembly buffer.
  */
-static inline void rasm_buf_del(rle_rasm_buf_t **const rasm_buf);
+static inline void rasm_buf_del(const struct rle_allocator *const allocator,
+                                rle_rasm_buf_t **const rasm_buf);
 
 /**
  * @brief         Initialize (eventually reinitialize) a reassembly buffer.
@@ -348,16 +356,17 @@ static inline void rasm_buf_init_sdu_frag(rle_rasm_buf_t *const rasm_buf)
 	rasm_buf_ptrs_set(&rasm_buf->sdu_frag, rasm_buf->sdu_frag.end);
 }
 
-static inline rle_rasm_buf_t * rasm_buf_new(void)
+static inline rle_rasm_buf_t * rasm_buf_new(const struct rle_allocator *const allocator)
 {
-	rle_rasm_buf_t *rasm_buf = (rle_rasm_buf_t *)MALLOC(sizeof(rle_rasm_buf_t));
+	rle_rasm_buf_t *rasm_buf =
+		(rle_rasm_buf_t *)rle_allocator_alloc(allocator, sizeof(rle_rasm_buf_t));
 
 	if (!rasm_buf) {
 		RLE_ERR("reassembly buffer not allocated.");
 		goto error;
 	}
 
-	rasm_buf->buffer = (unsigned char *)MALLOC(RLE_R_BUFF_LEN);
+	rasm_buf->buffer = (unsigned char *)rle_allocator_alloc(allocator, RLE_R_BUFF_LEN);
 	if (!rasm_buf->buffer) {
 		RLE_ERR("reassembly buffer not allocated (2)");
 		goto free_rasm_buf;
@@ -369,22 +378,23 @@ static inline rle_rasm_buf_t * rasm_buf_new(void)
 	return rasm_buf;
 
 free_rasm_buf:
-	FREE(rasm_buf);
+	rle_allocator_free(allocator, rasm_buf);
 error:
 	return NULL;
 }
 
-static inline void rasm_buf_del(rle_rasm_buf_t **const rasm_buf)
+static inline void rasm_buf_del(const struct rle_allocator *const allocator,
+                                rle_rasm_buf_t **const rasm_buf)
 {
 	assert(rasm_buf != NULL);
 	assert((*rasm_buf) != NULL);
 
 	if ((*rasm_buf)->sdu_info.buffer) {
-		FREE((*rasm_buf)->sdu_info.buffer);
+		rle_allocator_free(allocator, (*rasm_buf)->sdu_info.buffer);
 		(*rasm_buf)->sdu_info.buffer = NULL;
 	}
 
-	FREE(*rasm_buf);
+	rle_allocator_free(allocator, *rasm_buf);
 	*rasm_buf = NULL;
 }
 
@@ -392,10 +402,10 @@ static inline void rasm_buf_init(rle_rasm_buf_t *const rasm_buf)
 {
 	rasm_buf->buffer = rasm_buf->sdu_info.buffer;
 
-	memset(rasm_buf->buffer, '\0', RLE_R_BUFF_LEN);
+	RLE_BUF_POISON(rasm_buf->buffer, RLE_R_BUFF_LEN);
 
-	rasm_buf_ptrs_set(&rasm_buf->sdu, rasm_buf->buffer);
-	rasm_buf_ptrs_set(&rasm_buf->sdu_frag, rasm_buf->buffer);
+	rasm_buf_ptrs_set(&rasm_buf->sdu, rasm_buf->buffer + RLE_R_BUFF_HEADROOM);
+	rasm_buf_ptrs_set(&rasm_buf->sdu_frag, rasm_buf->buffer + RLE_R_BUFF_HEADROOM);
 }
 
 static inline int rasm_buf_in_use(const rle_rasm_buf_t *const rasm_buf)
@@ -0,0 +1,542 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   rle_alloc.c
+ * @brief  RLE memory allocation and its audit mode
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#include "rle_alloc.h"
+#include "constants.h"
+
+#ifndef __KERNEL__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#else
+
+#include <linux/types.h>
+#include <linux/slab.h>
+#include <linux/mm.h>
+#include <linux/string.h>
+
+#endif
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PRIVATE CONSTANTS AND MACROS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+#define MODULE_ID RLE_MOD_ID_ALLOC
+
+/** Add to an audit counter, if the audit is enabled */
+#define RLE_AUDIT_ADD(counter, value) \
+	do { \
+		if (__atomic_load_n(&rle_audit_is_enabled, __ATOMIC_RELAXED)) { \
+			__atomic_fetch_add(&rle_audit.counter, (value), __ATOMIC_RELAXED); \
+		} \
+	} while (0)
+
+/** Alignment of the blocks handed out by a region, a cache line */
+#define RLE_REGION_ALIGN 64
+
+/** Round a length up to a multiple of a power of two */
+#define RLE_ALIGN_UP(len, align) (((len) + (align) - 1) & ~((size_t)(align) - 1))
+
+/** Length of a region header, blocks start after it */
+#define RLE_REGION_HDR_LEN RLE_ALIGN_UP(sizeof(struct rle_region), RLE_REGION_ALIGN)
+
+/**
+ * Octets from which the blocks are handed out from the end of a region: the large buffers of
+ * the instances stay untouched until used, and the small structures are packed at the start.
+ */
+#define RLE_REGION_LARGE_LEN 4096
+
+#ifndef __KERNEL__
+
+/** Length of a huge page */
+#define RLE_HUGEPAGE_LEN (2UL << 20)
+
+/** Memory policy of mbind(2) that allocates on the given nodes only */
+#define RLE_MPOL_BIND 2
+
+/** Number of NUMA nodes of the node mask given to mbind(2) */
+#define RLE_NUMA_NODES_MAX 1024
+
+#endif
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PRIVATE STRUCTS AND TYPEDEFS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * Region of memory placed on a NUMA node, handing out the blocks of one or more instances.
+ *
+ * The blocks are handed out one after the other and never reused. The small blocks are handed
+ * out from the start of the region, the large ones from its end. The region is released with its
+ * last block. The blocks that do not fit are placed in their own region.
+ *
+ * The instances of a region allocate at creation, and later when their latency histograms are
+ * enabled, and release their blocks when destroyed, possibly from different threads: the blocks
+ * are handed out under a lock, and the references are counted atomically.
+ */
+struct rle_region {
+	size_t size;         /**< Octets of the region, header included */
+	size_t used;         /**< Octets handed out from the start, header included */
+	size_t top;          /**< Offset of the last large block handed out from the end */
+	size_t refs;         /**< Blocks handed out, plus one while the region is being filled */
+	int node;            /**< The NUMA node, RLE_NUMA_NODE_ANY for none */
+	unsigned int flags;  /**< The RLE_PLACEMENT_* flags */
+	bool lock;           /**< Held while blocks are handed out */
+};
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------- PRIVATE FUNCTIONS ----------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief         Default allocation hook.
+ *
+ * @param[in]     priv            Unused.
+ * @param[in]     size            The number of octets.
+ *
+ * @return        The memory if OK, else NULL.
+ */
+static void * rle_default_alloc(void *const priv, const size_t size);
+
+/**
+ * @brief         Default release hook.
+ *
+ * @param[in]     priv            Unused.
+ * @param[in]     ptr             The memory to release.
+ */
+static void rle_default_free(void *const priv, void *const ptr);
+
+/**
+ * @brief         Map a region on a NUMA node.
+ *
+ * @param[in]     size            The minimal number of octets, header included.
+ * @param[in]     node            The NUMA node, RLE_NUMA_NODE_ANY for none.
+ * @param[in]     flags           The RLE_PLACEMENT_* flags.
+ *
+ * @return        The region, with no block handed out, if OK, else NULL.
+ */
+static struct rle_region * rle_region_map(const size_t size, const int node,
+                                          const unsigned int flags);
+
+/**
+ * @brief         Take the lock of a region, spin while another thread holds it.
+ *
+ * @param[in,out] region          The region.
+ */
+static void rle_region_lock(struct rle_region *const region);
+
+/**
+ * @brief         Release the lock of a region.
+ *
+ * @param[in,out] region          The region.
+ */
+static void rle_region_unlock(struct rle_region *const region);
+
+/**
+ * @brief         Drop a reference on a region, unmap it with the last one.
+ *
+ * @param[in,out] region          The region.
+ */
+static void rle_region_put(struct rle_region *const region);
+
+/**
+ * @brief         Allocation hook of the region allocators.
+ *
+ * @param[in,out] priv            The region.
+ * @param[in]     size            The number of octets.
+ *
+ * @return        The memory if OK, else NULL.
+ */
+static void * rle_region_alloc(void *const priv, const size_t size);
+
+/**
+ * @brief         Release hook of the region allocators.
+ *
+ * @param[in,out] priv            The region.
+ * @param[in]     ptr             The memory to release.
+ */
+static void rle_region_free(void *const priv, void *const ptr);
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------- PRIVATE VARIABLES ----------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** The registered allocator */
+static struct rle_allocator rle_registered_allocator = {
+	.alloc = rle_default_alloc,
+	.free = rle_default_free,
+	.priv = NULL,
+};
+
+/** Whether the audit counters are updated */
+static bool rle_audit_is_enabled = false;
+
+/** The audit counters */
+static struct rle_alloc_audit rle_audit;
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*----------------------------------- PRIVATE FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+static void * rle_default_alloc(void *const priv __attribute__((unused)), const size_t size)
+{
+#ifndef __KERNEL__
+	return malloc(size);
+#else
+	/* vmalloc allocates size with 4K modulo so for 8*2565 = 20520B it would alloc 24K
+	 * kmalloc allocates size with power of two so for 20520B it would alloc 32K */
+	return kmalloc(size, GFP_KERNEL);
+#endif
+}
+
+static void rle_default_free(void *const priv __attribute__((unused)), void *const ptr)
+{
+#ifndef __KERNEL__
+	free(ptr);
+#else
+	kfree(ptr);
+#endif
+}
+
+static struct rle_region * rle_region_map(const size_t size, const int node,
+                                          const unsigned int flags)
+{
+	struct rle_region *region = NULL;
+	size_t len;
+
+#ifndef __KERNEL__
+	const size_t page_len = (size_t)sysconf(_SC_PAGESIZE);
+	void *addr = MAP_FAILED;
+
+	if (node != RLE_NUMA_NODE_ANY && (node < 0 || node >= RLE_NUMA_NODES_MAX)) {
+		RLE_ERR("NUMA node %d out of range", node);
+		goto out;
+	}
+
+	if (flags & RLE_PLACEMENT_HUGEPAGES) {
+		len = RLE_ALIGN_UP(size, RLE_HUGEPAGE_LEN);
+		addr = mmap(NULL, len, PROT_READ | PROT_WRITE,
+		            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (addr == MAP_FAILED) {
+			RLE_WARN("no huge page available for %zu octets, fall back to transparent huge "
+			         "pages", len);
+		}
+	}
+	if (addr == MAP_FAILED) {
+		len = RLE_ALIGN_UP(size, page_len);
+		/* like the heap, the pages of the buffers never used are not committed */
+		addr = mmap(NULL, len, PROT_READ | PROT_WRITE,
+		            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		if (addr == MAP_FAILED) {
+			RLE_ERR("failed to map %zu octets", len);
+			goto out;
+		}
+#ifdef MADV_HUGEPAGE
+		if (flags & RLE_PLACEMENT_HUGEPAGES) {
+			/* advisory only, the region is usable without */
+			(void)madvise(addr, len, MADV_HUGEPAGE);
+		}
+#endif
+	}
+
+	if (node != RLE_NUMA_NODE_ANY) {
+		unsigned long nodemask[RLE_NUMA_NODES_MAX / (8 * sizeof(unsigned long))] = { 0 };
+		const size_t bits = 8 * sizeof(unsigned long);
+		long ret = -1;
+
+		nodemask[node / bits] = 1UL << (node % bits);
+#ifdef SYS_mbind
+		/* the pages are not touched yet, they will be allocated on the node */
+		ret = syscall(SYS_mbind, addr, len, RLE_MPOL_BIND, nodemask, RLE_NUMA_NODES_MAX + 1, 0);
+#else
+		errno = ENOSYS;
+#endif
+		if (ret != 0 && !(errno == ENOSYS && node == 0)) {
+			/* without NUMA support, node 0 is the only node */
+			RLE_ERR("failed to bind %zu octets on NUMA node %d", len, node);
+			munmap(addr, len);
+			goto out;
+		}
+	}
+
+	region = (struct rle_region *)addr;
+#else
+	len = size;
+	region = (struct rle_region *)kvmalloc_node(len, GFP_KERNEL, node);
+	if (region == NULL) {
+		RLE_ERR("failed to allocate %zu octets on NUMA node %d", len, node);
+		goto out;
+	}
+#endif
+
+	region->size = len;
+	region->used = RLE_REGION_HDR_LEN;
+	region->top = len;
+	region->refs = 0;
+	region->node = node;
+	region->flags = flags;
+	region->lock = false;
+
+out:
+	return region;
+}
+
+static void rle_region_lock(struct rle_region *const region)
+{
+	while (__atomic_test_and_set(&region->lock, __ATOMIC_ACQUIRE)) {
+		while (__atomic_load_n(&region->lock, __ATOMIC_RELAXED)) {
+		}
+	}
+}
+
+static void rle_region_unlock(struct rle_region *const region)
+{
+	__atomic_clear(&region->lock, __ATOMIC_RELEASE);
+}
+
+static void rle_region_put(struct rle_region *const region)
+{
+	const size_t refs = __atomic_fetch_sub(&region->refs, 1, __ATOMIC_ACQ_REL);
+
+	assert(refs > 0);
+
+	if (refs == 1) {
+#ifndef __KERNEL__
+		munmap(region, region->size);
+#else
+		kvfree(region);
+#endif
+	}
+}
+
+static void * rle_region_alloc(void *const priv, const size_t size)
+{
+	struct rle_region *const region = (struct rle_region *)priv;
+	const size_t len = RLE_ALIGN_UP(size, RLE_REGION_ALIGN);
+	struct rle_region *block_region;
+	void *ptr = NULL;
+
+	rle_region_lock(region);
+	if (len <= region->top - region->used) {
+		if (len >= RLE_REGION_LARGE_LEN) {
+			region->top -= len;
+			ptr = (unsigned char *)region + region->top;
+		} else {
+			ptr = (unsigned char *)region + region->used;
+			region->used += len;
+		}
+		__atomic_fetch_add(&region->refs, 1, __ATOMIC_RELAXED);
+	}
+	rle_region_unlock(region);
+
+	if (ptr == NULL) {
+		/* does not fit, place the block in its own region, not shared yet */
+		block_region = rle_region_map(RLE_REGION_HDR_LEN + len, region->node, region->flags);
+		if (block_region == NULL) {
+			goto out;
+		}
+		ptr = (unsigned char *)block_region + block_region->used;
+		block_region->used += len;
+		block_region->refs++;
+	}
+
+out:
+	return ptr;
+}
+
+static void rle_region_free(void *const priv, void *const ptr)
+{
+	struct rle_region *const region = (struct rle_region *)priv;
+	const unsigned char *const start = (const unsigned char *)region;
+
+	if ((const unsigned char *)ptr >= start && (const unsigned char *)ptr < start + region->size) {
+		rle_region_put(region);
+	} else {
+		/* a block placed in its own region */
+		rle_region_put((struct rle_region *)((unsigned char *)ptr - RLE_REGION_HDR_LEN));
+	}
+}
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+void * rle_malloc(const size_t size)
+{
+	return rle_allocator_alloc(NULL, size);
+}
+
+void rle_free(void *const ptr)
+{
+	rle_allocator_free(NULL, ptr);
+}
+
+void * rle_allocator_alloc(const struct rle_allocator *const allocator, const size_t size)
+{
+	const struct rle_allocator *const the_allocator =
+		(allocator != NULL ? allocator : &rle_registered_allocator);
+	void *const ptr = the_allocator->alloc(the_allocator->priv, size);
+
+	if (ptr == NULL) {
+		RLE_AUDIT_ADD(alloc_failures, 1);
+	} else {
+		RLE_AUDIT_ADD(allocs, 1);
+		RLE_AUDIT_ADD(bytes_allocated, size);
+	}
+
+	return ptr;
+}
+
+void rle_allocator_free(const struct rle_allocator *const allocator, void *const ptr)
+{
+	const struct rle_allocator *const the_allocator =
+		(allocator != NULL ? allocator : &rle_registered_allocator);
+
+	if (ptr == NULL) {
+		return;
+	}
+
+	RLE_AUDIT_ADD(frees, 1);
+	the_allocator->free(the_allocator->priv, ptr);
+}
+
+void rle_allocator_get(struct rle_allocator *const allocator)
+{
+	*allocator = rle_registered_allocator;
+}
+
+int rle_region_allocator_new(struct rle_allocator *const allocator, const size_t size,
+                             const int node, const unsigned int flags)
+{
+	struct rle_region *region;
+	int status = C_ERROR;
+
+	region = rle_region_map(RLE_REGION_HDR_LEN + size, node, flags);
+	if (region == NULL) {
+		goto out;
+	}
+	region->refs = 1;
+
+	allocator->alloc = rle_region_alloc;
+	allocator->free = rle_region_free;
+	allocator->priv = region;
+
+	status = C_OK;
+
+out:
+	return status;
+}
+
+void rle_region_allocator_put(const struct rle_allocator *const allocator)
+{
+	rle_region_put((struct rle_region *)allocator->priv);
+}
+
+size_t rle_region_block_len(const size_t size)
+{
+	return RLE_ALIGN_UP(size, RLE_REGION_ALIGN);
+}
+
+void rle_zero(void *const buf, const size_t size)
+{
+	RLE_AUDIT_ADD(zeroings, 1);
+	RLE_AUDIT_ADD(bytes_zeroed, size);
+	memset(buf, 0, size);
+}
+
+void rle_poison(void *const buf, const size_t size)
+{
+	RLE_AUDIT_ADD(poisonings, 1);
+	RLE_AUDIT_ADD(bytes_poisoned, size);
+	memset(buf, RLE_POISON_BYTE, size);
+}
+
+void rle_set_allocator(const struct rle_allocator *const allocator)
+{
+	if (allocator == NULL) {
+		rle_registered_allocator.alloc = rle_default_alloc;
+		rle_registered_allocator.free = rle_default_free;
+		rle_registered_allocator.priv = NULL;
+	} else if (allocator->alloc == NULL || allocator->free == NULL) {
+		RLE_ERR("allocator hooks shall not be NULL, allocator unchanged");
+	} else {
+		rle_registered_allocator = *allocator;
+	}
+}
+
+void rle_alloc_audit_enable(void)
+{
+	__atomic_store_n(&rle_audit_is_enabled, true, __ATOMIC_RELAXED);
+}
+
+void rle_alloc_audit_disable(void)
+{
+	__atomic_store_n(&rle_audit_is_enabled, false, __ATOMIC_RELAXED);
+}
+
+void rle_alloc_audit_get(struct rle_alloc_audit *const audit)
+{
+	if (audit == NULL) {
+		return;
+	}
+
+	audit->allocs = __atomic_load_n(&rle_audit.allocs, __ATOMIC_RELAXED);
+	audit->alloc_failures = __atomic_load_n(&rle_audit.alloc_failures, __ATOMIC_RELAXED);
+	audit->frees = __atomic_load_n(&rle_audit.frees, __ATOMIC_RELAXED);
+	audit->bytes_allocated = __atomic_load_n(&rle_audit.bytes_allocated, __ATOMIC_RELAXED);
+	audit->zeroings = __atomic_load_n(&rle_audit.zeroings, __ATOMIC_RELAXED);
+	audit->bytes_zeroed = __atomic_load_n(&rle_audit.bytes_zeroed, __ATOMIC_RELAXED);
+	audit->poisonings = __atomic_load_n(&rle_audit.poisonings, __ATOMIC_RELAXED);
+	audit->bytes_poisoned = __atomic_load_n(&rle_audit.bytes_poisoned, __ATOMIC_RELAXED);
+}
+
+void rle_alloc_audit_reset(void)
+{
+	__atomic_store_n(&rle_audit.allocs, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&rle_audit.alloc_failures, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&rle_audit.frees, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&rle_audit.bytes_allocated, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&rle_audit.zeroings, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&rle_audit.bytes_zeroed, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&rle_audit.poisonings, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&rle_audit.bytes_poisoned, 0, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,158 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   rle_alloc.h
+ * @brief  Definition of the RLE memory allocation and of its audit mode
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#ifndef __RLE_ALLOC_H__
+#define __RLE_ALLOC_H__
+
+#ifndef __KERNEL__
+
+#include <stddef.h>
+
+#else
+
+#include <linux/stddef.h>
+
+#endif
+
+#include "rle.h"
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*---------------------------------- PUBLIC CONSTANTS AND MACROS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** Pattern written in the reused buffers by the RLE_POISON builds */
+#define RLE_POISON_BYTE 0xa5
+
+/**
+ * Poison a buffer before its reuse in RLE_POISON (debug) builds, so that reading stale data
+ * shows up. Production builds leave the buffer as is, its content is never read before written.
+ */
+#ifdef RLE_POISON
+#define RLE_BUF_POISON(buf, size) rle_poison((buf), (size))
+#else
+#define RLE_BUF_POISON(buf, size) do { } while (0)
+#endif
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------------- PUBLIC FUNCTIONS ---------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief         Allocate memory with the registered allocator.
+ *
+ * @param[in]     size            The number of octets.
+ *
+ * @return        The memory if OK, else NULL.
+ */
+void * rle_malloc(const size_t size);
+
+/**
+ * @brief         Release memory with the registered allocator.
+ *
+ * @param[in]     ptr             The memory given by @ref rle_malloc, may be NULL.
+ */
+void rle_free(void *const ptr);
+
+/**
+ * @brief         Allocate memory with an allocator.
+ *
+ * @param[in]     allocator       The allocator, NULL for the registered one.
+ * @param[in]     size            The number of octets.
+ *
+ * @return        The memory if OK, else NULL.
+ */
+void * rle_allocator_alloc(const struct rle_allocator *const allocator, const size_t size);
+
+/**
+ * @brief         Release memory with an allocator.
+ *
+ * @param[in]     allocator       The allocator of the memory, NULL for the registered one.
+ * @param[in]     ptr             The memory, may be NULL.
+ */
+void rle_allocator_free(const struct rle_allocator *const allocator, void *const ptr);
+
+/**
+ * @brief         Get a copy of the registered allocator.
+ *
+ * @param[out]    allocator       The copy.
+ */
+void rle_allocator_get(struct rle_allocator *const allocator);
+
+/**
+ * @brief         Create an allocator handing out blocks of a region placed on a NUMA node.
+ *
+ *                The region is released with the last block handed out and the reference of the
+ *                creator, dropped with @ref rle_region_allocator_put. Blocks that do not fit are
+ *                placed in their own region, on the same node.
+ *
+ * @param[out]    allocator       The allocator.
+ * @param[in]     size            The number of octets of the blocks, see
+ *                                @ref rle_region_block_len.
+ * @param[in]     node            The NUMA node, RLE_NUMA_NODE_ANY for none.
+ * @param[in]     flags           The RLE_PLACEMENT_* flags.
+ *
+ * @return        C_OK if OK, else C_ERROR.
+ */
+int rle_region_allocator_new(struct rle_allocator *const allocator, const size_t size,
+                             const int node, const unsigned int flags);
+
+/**
+ * @brief         Drop the reference of the creator on the region of an allocator.
+ *
+ * @param[in]     allocator       The allocator created with @ref rle_region_allocator_new.
+ */
+void rle_region_allocator_put(const struct rle_allocator *const allocator);
+
+/**
+ * @brief         Get the number of octets a block takes in a region.
+ *
+ * @param[in]     size            The number of octets of the block.
+ *
+ * @return        The number of octets taken in the region.
+ */
+size_t rle_region_block_len(const size_t size);
+
+/**
+ * @brief         Zero memory in bulk, accounted by the audit mode.
+ *
+ * @param[out]    buf             The memory to zero.
+ * @param[in]     size            The number of octets.
+ */
+void rle_zero(void *const buf, const size_t size);
+
+/**
+ * @brief         Poison memory with RLE_POISON_BYTE, accounted by the audit mode.
+ *
+ * @param[out]    buf             The memory to poison.
+ * @param[in]     size            The number of octets.
+ */
+void rle_poison(void *const buf, const size_t size);
+
+#endif /* __RLE_ALLOC_H__ */
@@ -0,0 +1,1030 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   rle_checkpoint.c
+ * @brief  Checkpoint and restore of the state of the RLE transmitters and receivers
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#include "rle.h"
+#include "rle_transmitter.h"
+#include "rle_receiver.h"
+#include "rle_ctx.h"
+#include "rle_sched.h"
+#include "constants.h"
+#include "fragmentation_buffer.h"
+#include "reassembly_buffer.h"
+
+#ifndef __KERNEL__
+
+#include <stdbool.h>
+#include <string.h>
+
+#else
+
+#include <linux/string.h>
+
+#endif
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PRIVATE CONSTANTS AND MACROS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+#define MODULE_ID RLE_MOD_ID_CHECKPOINT
+
+/** Magic number of the checkpoint of a transmitter, "RLET" */
+#define RLE_CHECKPOINT_MAGIC_TX 0x524c4554U
+
+/** Magic number of the checkpoint of a receiver, "RLER" */
+#define RLE_CHECKPOINT_MAGIC_RX 0x524c4552U
+
+/** Version of the checkpoint format, to increase on any change of the format */
+#define RLE_CHECKPOINT_VERSION 1
+
+/** Size of the header of a checkpoint: magic number, version and size of the checkpoint */
+#define RLE_CHECKPOINT_HDR_LEN (4 + 2 + 4)
+
+/** Size of the configuration in a checkpoint, one octet per field */
+#define RLE_CHECKPOINT_CONF_LEN 9
+
+/** Size of a fragmentation context in use, without the octets of its ALPDU */
+#define RLE_CHECKPOINT_FRAG_CTX_LEN (1 + 2 + 4 + 4 + 8 + 8 + 8 + 1 + 2 + 2 + 2)
+
+/** Size of a reassembly context in use, without the octets of its SDU */
+#define RLE_CHECKPOINT_RASM_CTX_LEN (1 + 4 + 2 + 1 + 2 + 2)
+
+/** Size of a FPDU decapsulated by chunks, without the octets carried over */
+#define RLE_CHECKPOINT_STREAM_LEN (4 + 4 + 1 + 1 + 6 + 2)
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PRIVATE STRUCTS AND TYPEDEFS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** Cursor on a checkpoint being written, large enough for all the fields */
+struct checkpoint_writer {
+	unsigned char *pos;  /**< The next octet to write */
+};
+
+/** Cursor on a checkpoint being read */
+struct checkpoint_reader {
+	const unsigned char *pos;  /**< The next octet to read */
+	const unsigned char *end;  /**< The end of the checkpoint */
+	bool is_short;             /**< Whether a field was read past the end */
+};
+
+/** A fragmentation context, as read in a checkpoint */
+struct checkpoint_frag_ctx {
+	uint8_t next_seq_nb;             /**< The next sequence number */
+	const unsigned char *counters;   /**< The counters, NULL if all zero */
+	/* the fields below are meaningful for contexts in use only */
+	bool use_crc;                    /**< Whether the ALPDU is protected by a CRC */
+	uint16_t protocol_type;          /**< The protocol type of the SDU */
+	uint32_t crc;                    /**< The CRC of the SDU */
+	uint32_t ppdus_nr;               /**< The PPDUs sent yet for the ALPDU */
+	uint64_t enqueue_time;           /**< The enqueue time of the SDU */
+	uint64_t deadline;               /**< The deadline of the SDU */
+	int64_t deficit;                 /**< The DRR deficit of the context */
+	size_t alpdu_hdr_len;            /**< The length of the ALPDU header */
+	size_t sdu_len;                  /**< The length of the SDU */
+	size_t alpdu_len;                /**< The length of the ALPDU, trailer included once sent */
+	size_t cur_off;                  /**< The octets of the ALPDU sent yet */
+	const unsigned char *remain;     /**< The octets of the ALPDU not sent yet */
+};
+
+/** A reassembly context, as read in a checkpoint */
+struct checkpoint_rasm_ctx {
+	uint8_t next_seq_nb;             /**< The next sequence number */
+	const unsigned char *counters;   /**< The counters, NULL if all zero */
+	/* the fields below are meaningful for contexts in use only */
+	bool use_crc;                    /**< Whether the ALPDU is protected by a CRC */
+	uint32_t current_counter;        /**< The octets of the PPDUs received yet */
+	uint16_t protocol_type;          /**< The protocol type of the SDU */
+	uint8_t comp_protocol_type;      /**< The compressed protocol type of the SDU */
+	size_t sdu_len;                  /**< The length of the SDU */
+	size_t received_len;             /**< The octets of the SDU received yet */
+	const unsigned char *received;   /**< The octets of the SDU received yet */
+};
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------- PRIVATE FUNCTIONS ----------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief         Check whether a block of 64-bit counters is all zero.
+ *
+ * @param[in]     counters        The counters.
+ * @param[in]     len             The size of the block, a multiple of 8 octets.
+ *
+ * @return        true if all counters are zero, else false.
+ */
+static bool checkpoint_counters_are_zero(const uint64_t *const counters, const size_t len);
+
+/**
+ * @brief         Write octets in a checkpoint.
+ *
+ * @param[in,out] writer          The checkpoint being written.
+ * @param[in]     data            The octets.
+ * @param[in]     len             The number of octets.
+ */
+static void checkpoint_put(struct checkpoint_writer *const writer, const void *const data,
+                           const size_t len);
+
+/**
+ * @brief         Read octets in a checkpoint, without copy.
+ *
+ * @param[in,out] reader          The checkpoint being read.
+ * @param[in]     len             The number of octets.
+ *
+ * @return        The octets, NULL if the checkpoint is too short.
+ */
+static const unsigned char * checkpoint_get(struct checkpoint_reader *const reader,
+                                            const size_t len);
+
+/**
+ * @brief         Write the header and the configuration of a checkpoint.
+ *
+ * @param[in,out] writer          The checkpoint being written.
+ * @param[in]     magic           The magic number of the checkpoint.
+ * @param[in]     len             The size of the checkpoint.
+ * @param[in]     conf            The configuration.
+ */
+static void checkpoint_put_hdr(struct checkpoint_writer *const writer, const uint32_t magic,
+                               const size_t len, const struct rle_config *const conf);
+
+/**
+ * @brief         Read and check the header and the configuration of a checkpoint.
+ *
+ *                The reader is bound to the size of the checkpoint given in its header.
+ *
+ * @param[in,out] reader          The checkpoint being read.
+ * @param[in]     magic           The expected magic number.
+ * @param[in]     conf            The configuration of the restored transmitter or receiver.
+ *
+ * @return        0 if the checkpoint may be restored, else 1.
+ */
+static int checkpoint_get_hdr(struct checkpoint_reader *const reader, const uint32_t magic,
+                              const struct rle_config *const conf);
+
+/**
+ * @brief         Read the fragmentation contexts of a transmitter checkpoint.
+ *
+ * @param[in,out] reader          The checkpoint being read.
+ * @param[in]     free_ctx        The contexts in use, one bit per context.
+ * @param[out]    ctxs            The contexts.
+ *
+ * @return        0 if the contexts are valid, else 1.
+ */
+static int checkpoint_get_frag_ctxs(struct checkpoint_reader *const reader,
+                                    const uint8_t free_ctx,
+                                    struct checkpoint_frag_ctx ctxs[]);
+
+/**
+ * @brief         Read the reassembly contexts of a receiver checkpoint.
+ *
+ * @param[in,out] reader          The checkpoint being read.
+ * @param[in]     free_ctx        The contexts in use, one bit per context.
+ * @param[out]    ctxs            The contexts.
+ *
+ * @return        0 if the contexts are valid, else 1.
+ */
+static int checkpoint_get_rasm_ctxs(struct checkpoint_reader *const reader,
+                                    const uint8_t free_ctx,
+                                    struct checkpoint_rasm_ctx ctxs[]);
+
+/**
+ * @brief         Restore a fragmentation context in use.
+ *
+ *                The ALPDU is moved in the buffer of the context, even if the SDU was
+ *                encapsulated in place, at the offset it would have after a copy.
+ *
+ * @param[in,out] transmitter     The transmitter.
+ * @param[in]     frag_id         The context.
+ * @param[in]     ctx             The context read in the checkpoint.
+ */
+static void checkpoint_restore_frag_ctx(struct rle_transmitter *const transmitter,
+                                        const uint8_t frag_id,
+                                        const struct checkpoint_frag_ctx *const ctx);
+
+/**
+ * @brief         Restore a reassembly context in use.
+ *
+ * @param[in,out] receiver        The receiver.
+ * @param[in]     frag_id         The context.
+ * @param[in]     ctx             The context read in the checkpoint.
+ */
+static void checkpoint_restore_rasm_ctx(struct rle_receiver *const receiver,
+                                        const uint8_t frag_id,
+                                        const struct checkpoint_rasm_ctx *const ctx);
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*----------------------------------- PRIVATE FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+static bool checkpoint_counters_are_zero(const uint64_t *const counters, const size_t len)
+{
+	uint64_t acc = 0;
+	size_t i;
+
+	for (i = 0; i < len / sizeof(uint64_t); ++i) {
+		acc |= counters[i];
+	}
+
+	return (acc == 0);
+}
+
+static void checkpoint_put(struct checkpoint_writer *const writer, const void *const data,
+                           const size_t len)
+{
+	memcpy(writer->pos, data, len);
+	writer->pos += len;
+}
+
+static const unsigned char * checkpoint_get(struct checkpoint_reader *const reader,
+                                            const size_t len)
+{
+	const unsigned char *data = NULL;
+
+	if (reader->is_short || (size_t)(reader->end - reader->pos) < len) {
+		reader->is_short = true;
+		goto out;
+	}
+
+	data = reader->pos;
+	reader->pos += len;
+
+out:
+	return data;
+}
+
+/** Write a fixed-size field in a checkpoint */
+#define CHECKPOINT_PUT(writer, type, value) \
+	do { \
+		const type cp_field = (type)(value); \
+		checkpoint_put((writer), &cp_field, sizeof(type)); \
+	} while (0)
+
+/** Read a fixed-size field in a checkpoint, 0 if the checkpoint is too short */
+#define CHECKPOINT_GET(reader, type, field) \
+	do { \
+		const unsigned char *const cp_data = checkpoint_get((reader), sizeof(type)); \
+		type cp_field = 0; \
+		if (cp_data != NULL) { \
+			memcpy(&cp_field, cp_data, sizeof(type)); \
+		} \
+		(field) = cp_field; \
+	} while (0)
+
+static void checkpoint_put_hdr(struct checkpoint_writer *const writer, const uint32_t magic,
+                               const size_t len, const struct rle_config *const conf)
+{
+	CHECKPOINT_PUT(writer, uint32_t, magic);
+	CHECKPOINT_PUT(writer, uint16_t, RLE_CHECKPOINT_VERSION);
+	CHECKPOINT_PUT(writer, uint32_t, len);
+
+	CHECKPOINT_PUT(writer, uint8_t, conf->allow_ptype_omission);
+	CHECKPOINT_PUT(writer, uint8_t, conf->use_compressed_ptype);
+	CHECKPOINT_PUT(writer, uint8_t, conf->allow_alpdu_crc);
+	CHECKPOINT_PUT(writer, uint8_t, conf->allow_alpdu_sequence_number);
+	CHECKPOINT_PUT(writer, uint8_t, conf->use_explicit_payload_header_map);
+	CHECKPOINT_PUT(writer, uint8_t, conf->implicit_protocol_type);
+	CHECKPOINT_PUT(writer, uint8_t, conf->implicit_ppdu_label_size);
+	CHECKPOINT_PUT(writer, uint8_t, conf->implicit_payload_label_size);
+	CHECKPOINT_PUT(writer, uint8_t, conf->type_0_alpdu_label_size);
+}
+
+static int checkpoint_get_hdr(struct checkpoint_reader *const reader, const uint32_t magic,
+                              const struct rle_config *const conf)
+{
+	const unsigned char *const start = reader->pos;
+	const unsigned char *conf_fields;
+	uint32_t cp_magic;
+	uint16_t cp_version;
+	uint32_t cp_len;
+	int status = 1;
+
+	CHECKPOINT_GET(reader, uint32_t, cp_magic);
+	CHECKPOINT_GET(reader, uint16_t, cp_version);
+	CHECKPOINT_GET(reader, uint32_t, cp_len);
+	if (reader->is_short || cp_magic != magic) {
+		RLE_ERR("not a %s checkpoint", magic == RLE_CHECKPOINT_MAGIC_TX ? "transmitter" :
+		        "receiver");
+		goto out;
+	}
+	if (cp_version != RLE_CHECKPOINT_VERSION) {
+		RLE_ERR("checkpoint version %u not supported (version %u expected)", cp_version,
+		        RLE_CHECKPOINT_VERSION);
+		goto out;
+	}
+	if (cp_len < RLE_CHECKPOINT_HDR_LEN + RLE_CHECKPOINT_CONF_LEN ||
+	    cp_len > (size_t)(reader->end - start)) {
+		RLE_ERR("truncated checkpoint: %u octets announced, %zu octets available", cp_len,
+		        (size_t)(reader->end - start));
+		goto out;
+	}
+	reader->end = start + cp_len;
+
+	conf_fields = checkpoint_get(reader, RLE_CHECKPOINT_CONF_LEN);
+	if (conf_fields == NULL ||
+	    conf_fields[0] != (uint8_t)conf->allow_ptype_omission ||
+	    conf_fields[1] != (uint8_t)conf->use_compressed_ptype ||
+	    conf_fields[2] != (uint8_t)conf->allow_alpdu_crc ||
+	    conf_fields[3] != (uint8_t)conf->allow_alpdu_sequence_number ||
+	    conf_fields[4] != (uint8_t)conf->use_explicit_payload_header_map ||
+	    conf_fields[5] != conf->implicit_protocol_type ||
+	    conf_fields[6] != conf->implicit_ppdu_label_size ||
+	    conf_fields[7] != conf->implicit_payload_label_size ||
+	    conf_fields[8] != conf->type_0_alpdu_label_size) {
+		RLE_ERR("checkpoint taken with another configuration");
+		goto out;
+	}
+
+	status = 0;
+
+out:
+	return status;
+}
+
+static int checkpoint_get_frag_ctxs(struct checkpoint_reader *const reader,
+                                    const uint8_t free_ctx,
+                                    struct checkpoint_frag_ctx ctxs[])
+{
+	const size_t counters_len = sizeof(struct link_status) + sizeof(struct rle_link_ctx_stats);
+	uint8_t counters_mask;
+	int status = 1;
+	size_t frag_id;
+
+	CHECKPOINT_GET(reader, uint8_t, counters_mask);
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		struct checkpoint_frag_ctx *const ctx = &ctxs[frag_id];
+
+		CHECKPOINT_GET(reader, uint8_t, ctx->next_seq_nb);
+		ctx->counters = NULL;
+		if (((counters_mask >> frag_id) & 0x1) != 0) {
+			ctx->counters = checkpoint_get(reader, counters_len);
+		}
+	}
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		struct checkpoint_frag_ctx *const ctx = &ctxs[frag_id];
+		uint8_t use_crc;
+		uint8_t alpdu_hdr_len;
+		uint16_t sdu_len;
+		uint16_t alpdu_len;
+		uint16_t cur_off;
+		uint64_t deficit;
+
+		if (rle_ctx_is_free(free_ctx, frag_id)) {
+			continue;
+		}
+
+		CHECKPOINT_GET(reader, uint8_t, use_crc);
+		CHECKPOINT_GET(reader, uint16_t, ctx->protocol_type);
+		CHECKPOINT_GET(reader, uint32_t, ctx->crc);
+		CHECKPOINT_GET(reader, uint32_t, ctx->ppdus_nr);
+		CHECKPOINT_GET(reader, uint64_t, ctx->enqueue_time);
+		CHECKPOINT_GET(reader, uint64_t, ctx->deadline);
+		CHECKPOINT_GET(reader, uint64_t, deficit);
+		CHECKPOINT_GET(reader, uint8_t, alpdu_hdr_len);
+		CHECKPOINT_GET(reader, uint16_t, sdu_len);
+		CHECKPOINT_GET(reader, uint16_t, alpdu_len);
+		CHECKPOINT_GET(reader, uint16_t, cur_off);
+		ctx->use_crc = (use_crc != 0);
+		ctx->deficit = (int64_t)deficit;
+		ctx->alpdu_hdr_len = alpdu_hdr_len;
+		ctx->sdu_len = sdu_len;
+		ctx->alpdu_len = alpdu_len;
+		ctx->cur_off = cur_off;
+
+		/* the ALPDU shall fit in the buffer of the context, trailer included */
+		if (reader->is_short || ctx->alpdu_hdr_len > sizeof(rle_alpdu_hdr_t) ||
+		    ctx->sdu_len > RLE_MAX_PDU_SIZE ||
+		    ctx->alpdu_len < ctx->alpdu_hdr_len + ctx->sdu_len ||
+		    ctx->alpdu_len - ctx->alpdu_hdr_len - ctx->sdu_len > sizeof(rle_alpdu_trailer_t) ||
+		    ctx->cur_off > ctx->alpdu_len ||
+		    (ctx->cur_off == 0) != (ctx->alpdu_len == ctx->alpdu_hdr_len + ctx->sdu_len)) {
+			RLE_ERR("invalid ALPDU in context %zu of checkpoint", frag_id);
+			goto out;
+		}
+
+		ctx->remain = checkpoint_get(reader, ctx->alpdu_len - ctx->cur_off);
+	}
+
+	if (reader->is_short) {
+		RLE_ERR("truncated fragmentation contexts in checkpoint");
+		goto out;
+	}
+
+	status = 0;
+
+out:
+	return status;
+}
+
+static int checkpoint_get_rasm_ctxs(struct checkpoint_reader *const reader,
+                                    const uint8_t free_ctx,
+                                    struct checkpoint_rasm_ctx ctxs[])
+{
+	uint8_t counters_mask;
+	int status = 1;
+	size_t frag_id;
+
+	CHECKPOINT_GET(reader, uint8_t, counters_mask);
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		struct checkpoint_rasm_ctx *const ctx = &ctxs[frag_id];
+
+		CHECKPOINT_GET(reader, uint8_t, ctx->next_seq_nb);
+		ctx->counters = NULL;
+		if (((counters_mask >> frag_id) & 0x1) != 0) {
+			ctx->counters = checkpoint_get(reader, sizeof(struct link_status));
+		}
+	}
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		struct checkpoint_rasm_ctx *const ctx = &ctxs[frag_id];
+		uint8_t use_crc;
+		uint16_t sdu_len;
+		uint16_t received_len;
+
+		if (rle_ctx_is_free(free_ctx, frag_id)) {
+			continue;
+		}
+
+		CHECKPOINT_GET(reader, uint8_t, use_crc);
+		CHECKPOINT_GET(reader, uint32_t, ctx->current_counter);
+		CHECKPOINT_GET(reader, uint16_t, ctx->protocol_type);
+		CHECKPOINT_GET(reader, uint8_t, ctx->comp_protocol_type);
+		CHECKPOINT_GET(reader, uint16_t, sdu_len);
+		CHECKPOINT_GET(reader, uint16_t, received_len);
+		ctx->use_crc = (use_crc != 0);
+		ctx->sdu_len = sdu_len;
+		ctx->received_len = received_len;
+
+		if (reader->is_short || ctx->sdu_len > RLE_R_BUFF_LEN - RLE_R_BUFF_HEADROOM ||
+		    ctx->received_len > ctx->sdu_len) {
+			RLE_ERR("invalid SDU in context %zu of checkpoint", frag_id);
+			goto out;
+		}
+
+		ctx->received = checkpoint_get(reader, ctx->received_len);
+	}
+
+	if (reader->is_short) {
+		RLE_ERR("truncated reassembly contexts in checkpoint");
+		goto out;
+	}
+
+	status = 0;
+
+out:
+	return status;
+}
+
+static void checkpoint_restore_frag_ctx(struct rle_transmitter *const transmitter,
+                                        const uint8_t frag_id,
+                                        const struct checkpoint_frag_ctx *const ctx)
+{
+	struct rle_ctx_mngt *const rle_ctx = &transmitter->rle_ctx_man[frag_id];
+	rle_frag_buf_t *const frag_buf = (rle_frag_buf_t *)rle_ctx->buff;
+	unsigned char *alpdu;
+	int ret;
+
+	ret = rle_frag_buf_init(frag_buf);
+	assert(ret == 0); /* cannot fail since frag_buf is not NULL */
+
+	/* as after a copy of the SDU: room for the largest PPDU header before the ALPDU */
+	alpdu = frag_buf->buffer + sizeof(rle_ppdu_hdr_t) + sizeof(rle_alpdu_hdr_t) -
+	        ctx->alpdu_hdr_len;
+
+	frag_buf->alpdu.start = alpdu;
+	frag_buf->alpdu.end = alpdu + ctx->alpdu_len;
+	frag_buf->sdu.start = alpdu + ctx->alpdu_hdr_len;
+	frag_buf->sdu.end = frag_buf->sdu.start + ctx->sdu_len;
+	frag_buf->cur_pos = alpdu + ctx->cur_off;
+	frag_buf->ppdu.start = frag_buf->cur_pos;
+	frag_buf->ppdu.end = frag_buf->cur_pos;
+	frag_buf->sdu_info.buffer = frag_buf->sdu.start;
+	frag_buf->sdu_info.protocol_type = ctx->protocol_type;
+	frag_buf->sdu_info.size = ctx->sdu_len;
+	frag_buf->crc = ctx->crc;
+
+	/* the octets sent yet are never read again */
+	memcpy(frag_buf->cur_pos, ctx->remain, ctx->alpdu_len - ctx->cur_off);
+
+	rle_ctx_set_use_crc(rle_ctx, ctx->use_crc);
+	rle_ctx->ppdus_nr = ctx->ppdus_nr;
+
+	transmitter->sched.enqueue_time[frag_id] = ctx->enqueue_time;
+	transmitter->sched.deadline[frag_id] = ctx->deadline;
+	transmitter->sched.deficit[frag_id] = ctx->deficit;
+}
+
+static void checkpoint_restore_rasm_ctx(struct rle_receiver *const receiver,
+                                        const uint8_t frag_id,
+                                        const struct checkpoint_rasm_ctx *const ctx)
+{
+	struct rle_ctx_mngt *const rle_ctx = &receiver->rle_ctx_man[frag_id];
+	rle_rasm_buf_t *const rasm_buf = (rle_rasm_buf_t *)rle_ctx->buff;
+
+	rasm_buf_init(rasm_buf);
+	rasm_buf_sdu_put(rasm_buf, ctx->sdu_len);
+	rasm_buf_sdu_frag_put(rasm_buf, ctx->received_len);
+	rasm_buf->sdu_info.protocol_type = ctx->protocol_type;
+	rasm_buf->sdu_info.size = ctx->sdu_len;
+	rasm_buf->comp_protocol_type = ctx->comp_protocol_type;
+	rasm_buf_cpy_sdu_frag(rasm_buf, ctx->received);
+
+	rle_ctx_set_use_crc(rle_ctx, ctx->use_crc);
+	rle_ctx->current_counter = ctx->current_counter;
+}
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+size_t rle_transmitter_checkpoint_size(const struct rle_transmitter *const transmitter)
+{
+	const size_t counters_len = sizeof(struct link_status) + sizeof(struct rle_link_ctx_stats);
+	size_t len = 0;
+	size_t frag_id;
+
+	if (transmitter == NULL) {
+		goto out;
+	}
+
+	len = RLE_CHECKPOINT_HDR_LEN + RLE_CHECKPOINT_CONF_LEN;
+	len += 1 + 1 + 1; /* contexts in use and DRR state */
+	len += sizeof(struct rle_transmitter_fpdu_stats);
+	len += 1 + RLE_MAX_FRAG_NUMBER; /* contexts with counters and sequence numbers */
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		const struct rle_ctx_mngt *const rle_ctx = &transmitter->rle_ctx_man[frag_id];
+
+		if (!checkpoint_counters_are_zero((const uint64_t *)&rle_ctx->lk_status,
+		                                  sizeof(struct link_status)) ||
+		    !checkpoint_counters_are_zero((const uint64_t *)&rle_ctx->link_stats,
+		                                  sizeof(struct rle_link_ctx_stats))) {
+			len += counters_len;
+		}
+		if (!rle_ctx_is_free(transmitter->free_ctx, frag_id)) {
+			const rle_frag_buf_t *const frag_buf = (const rle_frag_buf_t *)rle_ctx->buff;
+
+			len += RLE_CHECKPOINT_FRAG_CTX_LEN;
+			len += (size_t)(frag_buf->alpdu.end - frag_buf->cur_pos);
+		}
+	}
+
+out:
+	return len;
+}
+
+int rle_transmitter_checkpoint(const struct rle_transmitter *const transmitter,
+                               unsigned char *const buf,
+                               const size_t len,
+                               size_t *const written)
+{
+	struct checkpoint_writer writer;
+	uint8_t counters_mask = 0;
+	size_t cp_len;
+	size_t frag_id;
+	int status = 1;
+
+	if (transmitter == NULL || buf == NULL || written == NULL) {
+		goto out;
+	}
+
+	cp_len = rle_transmitter_checkpoint_size(transmitter);
+	if (cp_len > len) {
+		RLE_ERR("%zu octets are too few for a %zu-octet checkpoint", len, cp_len);
+		goto out;
+	}
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		const struct rle_ctx_mngt *const rle_ctx = &transmitter->rle_ctx_man[frag_id];
+
+		if (!rle_ctx_is_free(transmitter->free_ctx, frag_id)) {
+			const rle_frag_buf_t *const frag_buf = (const rle_frag_buf_t *)rle_ctx->buff;
+
+			if (frag_buf_get_alpdu_hdr_len(frag_buf) > (ssize_t)sizeof(rle_alpdu_hdr_t) ||
+			    frag_buf_get_sdu_len(frag_buf) > RLE_MAX_PDU_SIZE) {
+				RLE_ERR("context %zu cannot be checkpointed", frag_id);
+				goto out;
+			}
+		}
+	}
+
+	writer.pos = buf;
+	checkpoint_put_hdr(&writer, RLE_CHECKPOINT_MAGIC_TX, cp_len, &transmitter->conf);
+
+	CHECKPOINT_PUT(&writer, uint8_t, transmitter->free_ctx);
+	CHECKPOINT_PUT(&writer, uint8_t, transmitter->sched.drr_cur);
+	CHECKPOINT_PUT(&writer, uint8_t, transmitter->sched.drr_granted ? 1 : 0);
+	checkpoint_put(&writer, &transmitter->fpdu_stats, sizeof(struct rle_transmitter_fpdu_stats));
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		const struct rle_ctx_mngt *const rle_ctx = &transmitter->rle_ctx_man[frag_id];
+
+		if (!checkpoint_counters_are_zero((const uint64_t *)&rle_ctx->lk_status,
+		                                  sizeof(struct link_status)) ||
+		    !checkpoint_counters_are_zero((const uint64_t *)&rle_ctx->link_stats,
+		                                  sizeof(struct rle_link_ctx_stats))) {
+			counters_mask |= (uint8_t)(1U << frag_id);
+		}
+	}
+	CHECKPOINT_PUT(&writer, uint8_t, counters_mask);
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		const struct rle_ctx_mngt *const rle_ctx = &transmitter->rle_ctx_man[frag_id];
+
+		CHECKPOINT_PUT(&writer, uint8_t, rle_ctx_get_seq_nb(rle_ctx));
+		if (((counters_mask >> frag_id) & 0x1) != 0) {
+			checkpoint_put(&writer, &rle_ctx->lk_status, sizeof(struct link_status));
+			checkpoint_put(&writer, &rle_ctx->link_stats, sizeof(struct rle_link_ctx_stats));
+		}
+	}
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		const struct rle_ctx_mngt *const rle_ctx = &transmitter->rle_ctx_man[frag_id];
+		const rle_frag_buf_t *const frag_buf = (const rle_frag_buf_t *)rle_ctx->buff;
+		const size_t alpdu_len = (size_t)(frag_buf->alpdu.end - frag_buf->alpdu.start);
+		const size_t cur_off = (size_t)(frag_buf->cur_pos - frag_buf->alpdu.start);
+
+		if (rle_ctx_is_free(transmitter->free_ctx, frag_id)) {
+			continue;
+		}
+
+		CHECKPOINT_PUT(&writer, uint8_t, rle_ctx_get_use_crc(rle_ctx) ? 1 : 0);
+		CHECKPOINT_PUT(&writer, uint16_t, frag_buf->sdu_info.protocol_type);
+		CHECKPOINT_PUT(&writer, uint32_t, frag_buf->crc);
+		CHECKPOINT_PUT(&writer, uint32_t, rle_ctx->ppdus_nr);
+		CHECKPOINT_PUT(&writer, uint64_t, transmitter->sched.enqueue_time[frag_id]);
+		CHECKPOINT_PUT(&writer, uint64_t, transmitter->sched.deadline[frag_id]);
+		CHECKPOINT_PUT(&writer, uint64_t, transmitter->sched.deficit[frag_id]);
+		CHECKPOINT_PUT(&writer, uint8_t, frag_buf_get_alpdu_hdr_len(frag_buf));
+		CHECKPOINT_PUT(&writer, uint16_t, frag_buf_get_sdu_len(frag_buf));
+		CHECKPOINT_PUT(&writer, uint16_t, alpdu_len);
+		CHECKPOINT_PUT(&writer, uint16_t, cur_off);
+		checkpoint_put(&writer, frag_buf->cur_pos, alpdu_len - cur_off);
+	}
+
+	assert((size_t)(writer.pos - buf) == cp_len);
+	*written = cp_len;
+
+	status = 0;
+
+out:
+	return status;
+}
+
+int rle_transmitter_restore(struct rle_transmitter *const transmitter,
+                            const unsigned char *const buf,
+                            const size_t len,
+                            size_t *const used)
+{
+	struct checkpoint_frag_ctx ctxs[RLE_MAX_FRAG_NUMBER];
+	struct checkpoint_reader reader;
+	const unsigned char *fpdu_stats;
+	uint8_t free_ctx;
+	uint8_t drr_cur;
+	uint8_t drr_granted;
+	size_t frag_id;
+	int status = 1;
+
+	if (transmitter == NULL || buf == NULL) {
+		goto out;
+	}
+
+	reader.pos = buf;
+	reader.end = buf + len;
+	reader.is_short = false;
+
+	if (checkpoint_get_hdr(&reader, RLE_CHECKPOINT_MAGIC_TX, &transmitter->conf) != 0) {
+		goto out;
+	}
+
+	CHECKPOINT_GET(&reader, uint8_t, free_ctx);
+	CHECKPOINT_GET(&reader, uint8_t, drr_cur);
+	CHECKPOINT_GET(&reader, uint8_t, drr_granted);
+	fpdu_stats = checkpoint_get(&reader, sizeof(struct rle_transmitter_fpdu_stats));
+	if (reader.is_short || drr_cur >= RLE_MAX_FRAG_NUMBER) {
+		RLE_ERR("invalid transmitter state in checkpoint");
+		goto out;
+	}
+
+	if (checkpoint_get_frag_ctxs(&reader, free_ctx, ctxs) != 0) {
+		goto out;
+	}
+	if (reader.pos != reader.end) {
+		RLE_ERR("%zu unexpected octets at the end of the checkpoint",
+		        (size_t)(reader.end - reader.pos));
+		goto out;
+	}
+
+	/* the whole checkpoint is valid, the transmitter is modified from now on */
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		struct rle_ctx_mngt *const rle_ctx = &transmitter->rle_ctx_man[frag_id];
+		const struct checkpoint_frag_ctx *const ctx = &ctxs[frag_id];
+
+		rle_ctx_set_seq_nb(rle_ctx, ctx->next_seq_nb);
+		if (ctx->counters != NULL) {
+			memcpy(&rle_ctx->lk_status, ctx->counters, sizeof(struct link_status));
+			memcpy(&rle_ctx->link_stats, ctx->counters + sizeof(struct link_status),
+			       sizeof(struct rle_link_ctx_stats));
+		} else {
+			memset(&rle_ctx->lk_status, 0, sizeof(struct link_status));
+			memset(&rle_ctx->link_stats, 0, sizeof(struct rle_link_ctx_stats));
+		}
+
+		if (!rle_ctx_is_free(free_ctx, frag_id)) {
+			checkpoint_restore_frag_ctx(transmitter, (uint8_t)frag_id, ctx);
+		} else {
+			transmitter->sched.deficit[frag_id] = 0;
+		}
+	}
+	transmitter->free_ctx = free_ctx;
+	transmitter->sched.drr_cur = drr_cur;
+	transmitter->sched.drr_granted = (drr_granted != 0);
+	memcpy(&transmitter->fpdu_stats, fpdu_stats, sizeof(struct rle_transmitter_fpdu_stats));
+
+	if (used != NULL) {
+		*used = (size_t)(reader.end - buf);
+	}
+
+	status = 0;
+
+out:
+	return status;
+}
+
+size_t rle_receiver_checkpoint_size(const struct rle_receiver *const receiver)
+{
+	size_t len = 0;
+	size_t frag_id;
+
+	if (receiver == NULL) {
+		goto out;
+	}
+
+	len = RLE_CHECKPOINT_HDR_LEN + RLE_CHECKPOINT_CONF_LEN;
+	len += 1 + 1; /* contexts in use and sequence numbers known */
+	len += sizeof(receiver->errors) + sizeof(uint64_t) + sizeof(uint64_t);
+	len += 1 + RLE_MAX_FRAG_NUMBER; /* contexts with counters and sequence numbers */
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		const struct rle_ctx_mngt *const rle_ctx = &receiver->rle_ctx_man[frag_id];
+
+		if (!checkpoint_counters_are_zero((const uint64_t *)&rle_ctx->lk_status,
+		                                  sizeof(struct link_status))) {
+			len += sizeof(struct link_status);
+		}
+		if (!rle_ctx_is_free(receiver->free_ctx, frag_id)) {
+			const rle_rasm_buf_t *const rasm_buf = (const rle_rasm_buf_t *)rle_ctx->buff;
+
+			len += RLE_CHECKPOINT_RASM_CTX_LEN;
+			len += (size_t)(rasm_buf->sdu_frag.end - rasm_buf->sdu.start);
+		}
+	}
+
+	len += 1; /* state of the FPDU decapsulated by chunks */
+	if (receiver->stream.state != RLE_DECAP_STREAM_IDLE) {
+		len += RLE_CHECKPOINT_STREAM_LEN + receiver->stream.carry_len;
+	}
+
+out:
+	return len;
+}
+
+int rle_receiver_checkpoint(const struct rle_receiver *const receiver,
+                            unsigned char *const buf,
+                            const size_t len,
+                            size_t *const written)
+{
+	const struct rle_decap_stream *const stream = (receiver != NULL ? &receiver->stream : NULL);
+	struct checkpoint_writer writer;
+	uint8_t seqnum_init_mask = 0;
+	uint8_t counters_mask = 0;
+	size_t cp_len;
+	size_t frag_id;
+	int status = 1;
+
+	if (receiver == NULL || buf == NULL || written == NULL) {
+		goto out;
+	}
+
+	cp_len = rle_receiver_checkpoint_size(receiver);
+	if (cp_len > len) {
+		RLE_ERR("%zu octets are too few for a %zu-octet checkpoint", len, cp_len);
+		goto out;
+	}
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		const struct rle_ctx_mngt *const rle_ctx = &receiver->rle_ctx_man[frag_id];
+
+		if (receiver->is_ctx_seqnum_init[frag_id]) {
+			seqnum_init_mask |= (uint8_t)(1U << frag_id);
+		}
+		if (!checkpoint_counters_are_zero((const uint64_t *)&rle_ctx->lk_status,
+		                                  sizeof(struct link_status))) {
+			counters_mask |= (uint8_t)(1U << frag_id);
+		}
+	}
+
+	writer.pos = buf;
+	checkpoint_put_hdr(&writer, RLE_CHECKPOINT_MAGIC_RX, cp_len, &receiver->conf);
+
+	CHECKPOINT_PUT(&writer, uint8_t, receiver->free_ctx);
+	CHECKPOINT_PUT(&writer, uint8_t, seqnum_init_mask);
+	checkpoint_put(&writer, receiver->errors, sizeof(receiver->errors));
+	CHECKPOINT_PUT(&writer, uint64_t, receiver->error_traces_suppressed);
+	CHECKPOINT_PUT(&writer, uint64_t, receiver->fpdus_filtered);
+	CHECKPOINT_PUT(&writer, uint8_t, counters_mask);
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		const struct rle_ctx_mngt *const rle_ctx = &receiver->rle_ctx_man[frag_id];
+
+		CHECKPOINT_PUT(&writer, uint8_t, rle_ctx_get_seq_nb(rle_ctx));
+		if (((counters_mask >> frag_id) & 0x1) != 0) {
+			checkpoint_put(&writer, &rle_ctx->lk_status, sizeof(struct link_status));
+		}
+	}
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		const struct rle_ctx_mngt *const rle_ctx = &receiver->rle_ctx_man[frag_id];
+		const rle_rasm_buf_t *const rasm_buf = (const rle_rasm_buf_t *)rle_ctx->buff;
+
+		if (rle_ctx_is_free(receiver->free_ctx, frag_id)) {
+			continue;
+		}
+
+		CHECKPOINT_PUT(&writer, uint8_t, rle_ctx_get_use_crc(rle_ctx) ? 1 : 0);
+		CHECKPOINT_PUT(&writer, uint32_t, rle_ctx->current_counter);
+		CHECKPOINT_PUT(&writer, uint16_t, rasm_buf->sdu_info.protocol_type);
+		CHECKPOINT_PUT(&writer, uint8_t, rasm_buf->comp_protocol_type);
+		CHECKPOINT_PUT(&writer, uint16_t, rasm_buf_get_sdu_len(rasm_buf));
+		CHECKPOINT_PUT(&writer, uint16_t, rasm_buf_get_reassembled_sdu_len(rasm_buf));
+		checkpoint_put(&writer, rasm_buf->sdu.start, rasm_buf_get_reassembled_sdu_len(rasm_buf));
+	}
+
+	CHECKPOINT_PUT(&writer, uint8_t, stream->state);
+	if (stream->state != RLE_DECAP_STREAM_IDLE) {
+		CHECKPOINT_PUT(&writer, uint32_t, stream->fpdu_length);
+		CHECKPOINT_PUT(&writer, uint32_t, stream->offset);
+		CHECKPOINT_PUT(&writer, uint8_t, stream->label_size);
+		CHECKPOINT_PUT(&writer, uint8_t, stream->is_padding_invalid ? 1 : 0);
+		checkpoint_put(&writer, stream->label, sizeof(stream->label));
+		CHECKPOINT_PUT(&writer, uint16_t, stream->carry_len);
+		checkpoint_put(&writer, stream->carry, stream->carry_len);
+	}
+
+	assert((size_t)(writer.pos - buf) == cp_len);
+	*written = cp_len;
+
+	status = 0;
+
+out:
+	return status;
+}
+
+int rle_receiver_restore(struct rle_receiver *const receiver,
+                         const unsigned char *const buf,
+                         const size_t len,
+                         size_t *const used)
+{
+	struct checkpoint_rasm_ctx ctxs[RLE_MAX_FRAG_NUMBER];
+	struct checkpoint_reader reader;
+	const unsigned char *errors;
+	const unsigned char *label = NULL;
+	const unsigned char *carry = NULL;
+	uint64_t error_traces_suppressed;
+	uint64_t fpdus_filtered;
+	uint8_t free_ctx;
+	uint8_t seqnum_init_mask;
+	uint8_t stream_state;
+	uint32_t fpdu_length = 0;
+	uint32_t offset = 0;
+	uint8_t label_size = 0;
+	uint8_t is_padding_invalid = 0;
+	uint16_t carry_len = 0;
+	size_t frag_id;
+	int status = 1;
+
+	if (receiver == NULL || buf == NULL) {
+		goto out;
+	}
+
+	reader.pos = buf;
+	reader.end = buf + len;
+	reader.is_short = false;
+
+	if (checkpoint_get_hdr(&reader, RLE_CHECKPOINT_MAGIC_RX, &receiver->conf) != 0) {
+		goto out;
+	}
+
+	CHECKPOINT_GET(&reader, uint8_t, free_ctx);
+	CHECKPOINT_GET(&reader, uint8_t, seqnum_init_mask);
+	errors = checkpoint_get(&reader, sizeof(receiver->errors));
+	CHECKPOINT_GET(&reader, uint64_t, error_traces_suppressed);
+	CHECKPOINT_GET(&reader, uint64_t, fpdus_filtered);
+	if (reader.is_short) {
+		RLE_ERR("invalid receiver state in checkpoint");
+		goto out;
+	}
+
+	if (checkpoint_get_rasm_ctxs(&reader, free_ctx, ctxs) != 0) {
+		goto out;
+	}
+
+	CHECKPOINT_GET(&reader, uint8_t, stream_state);
+	if (stream_state != RLE_DECAP_STREAM_IDLE) {
+		CHECKPOINT_GET(&reader, uint32_t, fpdu_length);
+		CHECKPOINT_GET(&reader, uint32_t, offset);
+		CHECKPOINT_GET(&reader, uint8_t, label_size);
+		CHECKPOINT_GET(&reader, uint8_t, is_padding_invalid);
+		label = checkpoint_get(&reader, sizeof(receiver->stream.label));
+		CHECKPOINT_GET(&reader, uint16_t, carry_len);
+		if (carry_len <= sizeof(receiver->stream.carry)) {
+			carry = checkpoint_get(&reader, carry_len);
+		}
+	}
+	if (reader.is_short || stream_state > RLE_DECAP_STREAM_FILTERED || offset > fpdu_length ||
+	    label_size > sizeof(receiver->stream.label) ||
+	    carry_len > sizeof(receiver->stream.carry)) {
+		RLE_ERR("invalid FPDU decapsulated by chunks in checkpoint");
+		goto out;
+	}
+	if (reader.pos != reader.end) {
+		RLE_ERR("%zu unexpected octets at the end of the checkpoint",
+		        (size_t)(reader.end - reader.pos));
+		goto out;
+	}
+
+	/* the whole checkpoint is valid, the receiver is modified from now on */
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		struct rle_ctx_mngt *const rle_ctx = &receiver->rle_ctx_man[frag_id];
+		const struct checkpoint_rasm_ctx *const ctx = &ctxs[frag_id];
+
+		rle_ctx_set_seq_nb(rle_ctx, ctx->next_seq_nb);
+		receiver->is_ctx_seqnum_init[frag_id] = (((seqnum_init_mask >> frag_id) & 0x1) != 0);
+		if (ctx->counters != NULL) {
+			memcpy(&rle_ctx->lk_status, ctx->counters, sizeof(struct link_status));
+		} else {
+			memset(&rle_ctx->lk_status, 0, sizeof(struct link_status));
+		}
+
+		if (!rle_ctx_is_free(free_ctx, frag_id)) {
+			checkpoint_restore_rasm_ctx(receiver, (uint8_t)frag_id, ctx);
+		}
+	}
+	receiver->free_ctx = free_ctx;
+	memcpy(receiver->errors, errors, sizeof(receiver->errors));
+	receiver->error_traces_suppressed = error_traces_suppressed;
+	receiver->fpdus_filtered = fpdus_filtered;
+
+	receiver->stream.state = (enum rle_decap_stream_state)stream_state;
+	receiver->stream.fpdu_length = fpdu_length;
+	receiver->stream.offset = offset;
+	receiver->stream.label_size = label_size;
+	receiver->stream.is_padding_invalid = (is_padding_invalid != 0);
+	receiver->stream.carry_len = carry_len;
+	if (label != NULL) {
+		memcpy(receiver->stream.label, label, sizeof(receiver->stream.label));
+	}
+	if (carry_len > 0) {
+		memcpy(receiver->stream.carry, carry, carry_len);
+	}
+
+	if (used != NULL) {
+		*used = (size_t)(reader.end - buf);
+	}
+
+	status = 0;
+
+out:
+	return status;
+}
@@ -121,7 +121,8 @@ bool rle_config_check(const struct rle_config *const conf)
 
 bool ptype_is_omissible(const uint16_t ptype,
                         const struct rle_config *const rle_conf,
-                        const struct rle_frag_buf *const frag_buf)
+                        const unsigned char *const sdu,
+                        const size_t sdu_len)
 {
 	bool is_omissible;
 
@@ -145,13 +146,13 @@ bool ptype_is_omissible(const uint16_t ptype,
 			/* protocol omission is possible if IPv4 or IPv6 is detected, and the first 4 bits
 			 * of the SDU contain a supported IP version so that the RLE receiver is able to infer
 			 * the IP version from them */
-			if (frag_buf->sdu_info.size < 1) {
+			if (sdu_len < 1) {
 				RLE_DEBUG("protocol type is NOT omissible (too short IP packet)");
 				is_omissible = false;
 				break;
 			}
 
-			ip_version = (frag_buf->sdu.start[0] >> 4) & 0x0f;
+			ip_version = (sdu[0] >> 4) & 0x0f;
 			if ((ptype == RLE_PROTO_TYPE_IPV4_UNCOMP && ip_version == 4) ||
 			    (ptype == RLE_PROTO_TYPE_IPV6_UNCOMP && ip_version == 6)) {
 				RLE_DEBUG("protocol type is omissible (IP)");
@@ -169,7 +170,7 @@ bool ptype_is_omissible(const uint16_t ptype,
 			 *  - VLAN contains something else as payload.
 			 */
 			const uint8_t compressed_ptype =
-				is_eth_vlan_ip_frame(frag_buf->sdu.start, frag_buf->sdu_info.size);
+				is_eth_vlan_ip_frame(sdu, sdu_len);
 			is_omissible =
 				(compressed_ptype == RLE_PROTO_TYPE_VLAN_COMP_WO_PTYPE_FIELD);
 			RLE_DEBUG("protocol type is%s omissible", is_omissible ? "" : " NOT");
@@ -60,7 +60,8 @@ __attribute__((warn_unused_result));
  *
  *  @param	ptype    The protocol type
  *  @param	rle_conf The configuration
- *  @param  frag_buf The SDU to encapsulate
+ *  @param  sdu      The SDU to encapsulate
+ *  @param  sdu_len  The length of the SDU
  *
  *  @return	true if omissible, else false
  *
@@ -68,7 +69,8 @@ __attribute__((warn_unused_result));
  */
 bool ptype_is_omissible(const uint16_t ptype,
                         const struct rle_config *const rle_conf,
-                        const struct rle_frag_buf *const frag_buf)
+                        const unsigned char *const sdu,
+                        const size_t sdu_len)
 __attribute__((warn_unused_result, nonnull(2, 3)));
 
 #endif /* __RLE_CONF_H__ */
@@ -118,13 +118,13 @@ static void flush_ctxt_rasm_buf(struct rle_ctx_mngt *_this)
 /*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
 
-int rle_ctx_init_frag_buf(struct rle_ctx_mngt *_this)
+int rle_ctx_init_frag_buf(struct rle_ctx_mngt *_this, const struct rle_allocator *const allocator)
 {
 	int status = C_ERROR;
 
 	assert(_this != NULL);
 
-	_this->buff = (void *)rle_frag_buf_new();
+	_this->buff = (void *)rle_frag_buf_new_with_allocator(allocator);
 
 	/* allocate enough memory space for the fragmentation */
 	if (!_this->buff) {
@@ -141,14 +141,14 @@ out:
 	return status;
 }
 
-int rle_ctx_init_rasm_buf(struct rle_ctx_mngt *_this)
+int rle_ctx_init_rasm_buf(struct rle_ctx_mngt *_this, const struct rle_allocator *const allocator)
 {
 	int status = C_ERROR;
 
 	assert(_this != NULL);
 
 	/* allocate enough memory space for the reassembly */
-	_this->buff = (void *)rasm_buf_new();
+	_this->buff = (void *)rasm_buf_new(allocator);
 	if (!_this->buff) {
 		RLE_ERR("reassembly buffer allocation failed.");
 		goto out;
@@ -163,22 +163,24 @@ out:
 	return status;
 }
 
-void rle_ctx_destroy_frag_buf(struct rle_ctx_mngt *_this)
+void rle_ctx_destroy_frag_buf(struct rle_ctx_mngt *_this,
+                              const struct rle_allocator *const allocator)
 {
 	assert(_this != NULL);
 	assert(_this->buff != NULL);
 
 	flush(_this);
 
-	rle_frag_buf_del((rle_frag_buf_t **)&_this->buff);
+	rle_frag_buf_del_with_allocator(allocator, (rle_frag_buf_t **)&_this->buff);
 }
 
-void rle_ctx_destroy_rasm_buf(struct rle_ctx_mngt *_this)
+void rle_ctx_destroy_rasm_buf(struct rle_ctx_mngt *_this,
+                              const struct rle_allocator *const allocator)
 {
 	assert(_this != NULL);
 	assert(_this->buff != NULL);
 
-	rasm_buf_del((rle_rasm_buf_t **)&_this->buff);
+	rasm_buf_del(allocator, (rle_rasm_buf_t **)&_this->buff);
 }
 
 void rle_ctx_set_seq_nb(struct rle_ctx_mngt *_this, uint8_t val)
@@ -65,6 +65,10 @@ struct link_status {
 	uint64_t counter_bytes_ok;
 	/** Number of bytes dropped */
 	uint64_t counter_bytes_dropped;
+	/** Number of SDUs dropped once expired, transmission only */
+	uint64_t counter_expired;
+	/** Number of bytes dropped once expired, transmission only */
+	uint64_t counter_bytes_expired;
 };
 
 /** RLE context management structure */
@@ -83,6 +87,10 @@ struct rle_ctx_mngt {
 	int lk_type;
 	/** Fragmentation context status */
 	struct link_status lk_status;
+	/** Link efficiency counters, transmission only */
+	struct rle_link_ctx_stats link_stats;
+	/** Number of PPDUs of the ALPDU in transmission */
+	size_t ppdus_nr;
 };
 
 
@@ -93,44 +101,50 @@ struct rle_ctx_mngt {
 /**
  * @brief  Initialize RLE context structure with fragmentation buffers.
  *
- * @param[out]    _this  Pointer to the RLE context structure
+ * @param[out]    _this      Pointer to the RLE context structure
+ * @param[in]     allocator  The allocator of the buffers, NULL for the registered one
  *
  * @return  C_ERROR  If initilization went wrong
  *          C_OK     Otherwise
  *
  * @ingroup RLE context
  */
-int rle_ctx_init_frag_buf(struct rle_ctx_mngt *_this);
+int rle_ctx_init_frag_buf(struct rle_ctx_mngt *_this, const struct rle_allocator *const allocator);
 
 /**
  * @brief  Initialize RLE context structure with reassembly buffers.
  *
- * @param[out]    _this  Pointer to the RLE context structure
+ * @param[out]    _this      Pointer to the RLE context structure
+ * @param[in]     allocator  The allocator of the buffers, NULL for the registered one
  *
  * @return  C_ERROR  If initilization went wrong
  *          C_OK     Otherwise
  *
  * @ingroup RLE context
  */
-int rle_ctx_init_rasm_buf(struct rle_ctx_mngt *_this);
+int rle_ctx_init_rasm_buf(struct rle_ctx_mngt *_this, const struct rle_allocator *const allocator);
 
 /**
  * @brief  Destroy RLE context with fragmentation buffers structure and free memory
  *
- * @param[out]   _this  Pointer to the RLE context structure
+ * @param[out]   _this      Pointer to the RLE context structure
+ * @param[in]    allocator  The allocator of the buffers, NULL for the registered one
  *
  * @ingroup RLE context
  */
-void rle_ctx_destroy_frag_buf(struct rle_ctx_mngt *_this);
+void rle_ctx_destroy_frag_buf(struct rle_ctx_mngt *_this,
+                            const struct rle_allocator *const allocator);
 
 /**
  * @brief  Destroy RLE context with reassembly buffers structure and free memory
  *
- * @param[out]   _this  Pointer to the RLE context structure
+ * @param[out]   _this      Pointer to the RLE context structure
+ * @param[in]    allocator  The allocator of the buffers, NULL for the registered one
  *
  * @ingroup RLE context
  */
-void rle_ctx_destroy_rasm_buf(struct rle_ctx_mngt *_this);
+void rle_ctx_destroy_rasm_buf(struct rle_ctx_mngt *_this,
+                            const struct rle_allocator *const allocator);
 
 /**
  * @brief  Set sequence number
@@ -695,6 +709,55 @@ static inline uint64_t rle_ctx_get_counter_bytes_dropped(
 }
 
 
+/**
+ * @brief  Account one SDU dropped once expired, in the dropped counters too
+ *
+ * @param[in,out] _this  Pointer to the RLE context structure
+ * @param[in]     val    Number of bytes of the expired SDU
+ *
+ * @ingroup RLE context
+ */
+static inline void rle_ctx_incr_counter_expired(struct rle_ctx_mngt *const _this,
+                                                const uint64_t val)
+{
+	_this->lk_status.counter_expired++;
+	_this->lk_status.counter_bytes_expired += val;
+	rle_ctx_incr_counter_dropped(_this);
+	rle_ctx_incr_counter_bytes_dropped(_this, val);
+
+	return;
+}
+
+
+/**
+ * @brief  Get current number of SDUs dropped once expired
+ *
+ * @param[in]     _this   Pointer to the RLE context structure
+ *
+ * @return  Number of expired SDUs
+ *
+ * @ingroup RLE context
+ */
+static inline uint64_t rle_ctx_get_counter_expired(const struct rle_ctx_mngt *const _this)
+{
+	return _this->lk_status.counter_expired;
+}
+
+
+/**
+ * @brief  Get current number of bytes of the SDUs dropped once expired
+ *
+ * @param[in]     _this   Pointer to the RLE context structure
+ *
+ * @return  Number of bytes of the expired SDUs
+ *
+ * @ingroup RLE context
+ */
+static inline uint64_t rle_ctx_get_counter_bytes_expired(const struct rle_ctx_mngt *const _this)
+{
+	return _this->lk_status.counter_bytes_expired;
+}
+
 /**
  * @brief  Reset all counters
  *
@@ -711,6 +774,50 @@ static inline void rle_ctx_reset_counters(struct rle_ctx_mngt *const _this)
 	rle_ctx_reset_counter_bytes_in(_this);
 	rle_ctx_reset_counter_bytes_ok(_this);
 	rle_ctx_reset_counter_bytes_dropped(_this);
+	_this->lk_status.counter_expired = 0;
+	_this->lk_status.counter_bytes_expired = 0;
+
+	return;
+}
+
+/**
+ * @brief  Account one PPDU sent in the link efficiency counters
+ *
+ * @param[in,out] _this          Pointer to the RLE context structure
+ * @param[in]     ppdu_type      The type of the PPDU, RLE_PDU_COMPLETE for example
+ * @param[in]     ppdu_hdr_len   The length of the PPDU header
+ * @param[in]     alpdu_hdr_len  The length of the ALPDU header, sent with COMP and START PPDUs
+ * @param[in]     trailer_len    The length of the ALPDU trailer, sent at last with END PPDUs
+ * @param[in]     sdu_len        The length of the SDU, accounted once its last PPDU is sent
+ *
+ * @ingroup RLE context
+ */
+static inline void rle_ctx_count_ppdu(struct rle_ctx_mngt *const _this,
+                                      const int ppdu_type,
+                                      const size_t ppdu_hdr_len,
+                                      const size_t alpdu_hdr_len,
+                                      const size_t trailer_len,
+                                      const size_t sdu_len)
+{
+	struct rle_link_ctx_stats *const stats = &_this->link_stats;
+
+	stats->ppdus[ppdu_type]++;
+	stats->ppdu_hdr_bytes += ppdu_hdr_len;
+
+	if (ppdu_type == RLE_PDU_COMPLETE || ppdu_type == RLE_PDU_START_FRAG) {
+		stats->alpdu_hdr_bytes += alpdu_hdr_len;
+		_this->ppdus_nr = 0;
+	}
+	_this->ppdus_nr++;
+
+	if (ppdu_type == RLE_PDU_COMPLETE || ppdu_type == RLE_PDU_END_FRAG) {
+		const size_t bucket = (_this->ppdus_nr < RLE_PPDUS_PER_SDU_BUCKETS ?
+		                       _this->ppdus_nr : RLE_PPDUS_PER_SDU_BUCKETS) - 1;
+
+		stats->trailer_bytes += trailer_len;
+		stats->sdu_bytes += sdu_len;
+		stats->ppdus_per_sdu[bucket]++;
+	}
 
 	return;
 }
@@ -0,0 +1,475 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   rle_fpdu_trace.c
+ * @brief  Compact binary traces of FPDUs, written sequentially and read through mmap
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#include "rle.h"
+#include "constants.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PRIVATE CONSTANTS AND MACROS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+#define MODULE_ID RLE_MOD_ID_FPDU_TRACE
+
+/** Octets gathered by the writer before one write(2) */
+#define RLE_FPDU_TRACE_WRITE_LEN (1U << 20)
+
+/** Records of the first index of the writer, doubled when full */
+#define RLE_FPDU_TRACE_INDEX_MIN 1024
+
+/** Alignment of the records */
+#define RLE_FPDU_TRACE_ALIGN 8
+
+/** Octets a record takes in a trace, FPDU and padding included */
+#define RLE_FPDU_TRACE_RECORD_LEN(fpdu_len) \
+	(((sizeof(struct rle_fpdu_trace_record) + (fpdu_len)) + RLE_FPDU_TRACE_ALIGN - 1) & \
+	 ~((size_t)RLE_FPDU_TRACE_ALIGN - 1))
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PRIVATE STRUCTS AND TYPEDEFS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** Writer of a FPDU trace */
+struct rle_fpdu_trace_writer {
+	int fd;                   /**< The file of the trace */
+	unsigned char *buf;       /**< The records not written yet */
+	size_t buf_len;           /**< The octets of buf used */
+	uint64_t buf_offset;      /**< The offset of buf in the trace */
+	uint64_t *index;          /**< The offsets of the records written */
+	size_t index_nr;          /**< The number of records written */
+	size_t index_max;         /**< The number of records the index may hold */
+};
+
+/** FPDU trace mapped in memory */
+struct rle_fpdu_trace {
+	unsigned char *base;      /**< The mapping of the trace */
+	size_t len;               /**< The octets of the mapping */
+	const uint64_t *index;    /**< The offsets of the records, in the mapping or in own_index */
+	uint64_t *own_index;      /**< The index built by a scan, for a trace without index */
+	size_t records_nr;        /**< The number of records */
+};
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------- PRIVATE FUNCTIONS ----------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief         Write a buffer entirely in a file.
+ *
+ * @param[in]     fd              The file.
+ * @param[in]     buf             The buffer.
+ * @param[in]     len             The octets of the buffer.
+ *
+ * @return        C_OK if OK, else C_ERROR.
+ */
+static int rle_fpdu_trace_write_all(const int fd, const void *const buf, const size_t len);
+
+/**
+ * @brief         Write the records gathered by a writer.
+ *
+ * @param[in,out] writer          The writer.
+ *
+ * @return        C_OK if OK, else C_ERROR.
+ */
+static int rle_fpdu_trace_flush(struct rle_fpdu_trace_writer *const writer);
+
+/**
+ * @brief         Check that a record lies within the records of a trace.
+ *
+ * @param[in]     trace           The trace.
+ * @param[in]     offset          The offset of the record.
+ * @param[in]     end             The offset of the end of the records.
+ *
+ * @return        true if the record is valid, else false.
+ */
+static bool rle_fpdu_trace_record_is_valid(const struct rle_fpdu_trace *const trace,
+                                           const uint64_t offset, const uint64_t end);
+
+/**
+ * @brief         Index the records of a trace without index, up to the first truncated one.
+ *
+ * @param[in,out] trace           The trace.
+ *
+ * @return        C_OK if OK, else C_ERROR.
+ */
+static int rle_fpdu_trace_scan(struct rle_fpdu_trace *const trace);
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*----------------------------------- PRIVATE FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+static int rle_fpdu_trace_write_all(const int fd, const void *const buf, const size_t len)
+{
+	const unsigned char *pos = (const unsigned char *)buf;
+	size_t remain = len;
+
+	while (remain > 0) {
+		const ssize_t ret = write(fd, pos, remain);
+
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			RLE_ERR("failed to write %zu octets of FPDU trace: %s", remain, strerror(errno));
+			return C_ERROR;
+		}
+		pos += ret;
+		remain -= (size_t)ret;
+	}
+
+	return C_OK;
+}
+
+static int rle_fpdu_trace_flush(struct rle_fpdu_trace_writer *const writer)
+{
+	if (rle_fpdu_trace_write_all(writer->fd, writer->buf, writer->buf_len) != C_OK) {
+		return C_ERROR;
+	}
+	writer->buf_offset += writer->buf_len;
+	writer->buf_len = 0;
+
+	return C_OK;
+}
+
+static bool rle_fpdu_trace_record_is_valid(const struct rle_fpdu_trace *const trace,
+                                           const uint64_t offset, const uint64_t end)
+{
+	const struct rle_fpdu_trace_record *record;
+
+	if (offset < sizeof(struct rle_fpdu_trace_header) || offset % RLE_FPDU_TRACE_ALIGN != 0 ||
+	    offset > end || end - offset < sizeof(struct rle_fpdu_trace_record)) {
+		return false;
+	}
+	record = (const struct rle_fpdu_trace_record *)(trace->base + offset);
+
+	return (RLE_FPDU_TRACE_RECORD_LEN(record->fpdu_len) <= end - offset);
+}
+
+static int rle_fpdu_trace_scan(struct rle_fpdu_trace *const trace)
+{
+	uint64_t offset;
+	size_t records_nr = 0;
+
+	/* count, then index: the index is allocated once */
+	offset = sizeof(struct rle_fpdu_trace_header);
+	while (rle_fpdu_trace_record_is_valid(trace, offset, trace->len)) {
+		const struct rle_fpdu_trace_record *const record =
+			(const struct rle_fpdu_trace_record *)(trace->base + offset);
+
+		offset += RLE_FPDU_TRACE_RECORD_LEN(record->fpdu_len);
+		records_nr++;
+	}
+	if (offset != trace->len) {
+		RLE_WARN("FPDU trace not completed, %zu records kept", records_nr);
+	}
+
+	trace->own_index = (uint64_t *)MALLOC((records_nr > 0 ? records_nr : 1) * sizeof(uint64_t));
+	if (trace->own_index == NULL) {
+		RLE_ERR("failed to allocate the index of %zu records", records_nr);
+		return C_ERROR;
+	}
+
+	offset = sizeof(struct rle_fpdu_trace_header);
+	for (trace->records_nr = 0; trace->records_nr < records_nr; trace->records_nr++) {
+		const struct rle_fpdu_trace_record *const record =
+			(const struct rle_fpdu_trace_record *)(trace->base + offset);
+
+		trace->own_index[trace->records_nr] = offset;
+		offset += RLE_FPDU_TRACE_RECORD_LEN(record->fpdu_len);
+	}
+	trace->index = trace->own_index;
+
+	return C_OK;
+}
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+struct rle_fpdu_trace_writer * rle_fpdu_trace_writer_open(const char *const path)
+{
+	struct rle_fpdu_trace_writer *writer;
+	struct rle_fpdu_trace_header header;
+
+	writer = (struct rle_fpdu_trace_writer *)MALLOC(sizeof(struct rle_fpdu_trace_writer));
+	if (writer == NULL) {
+		RLE_ERR("failed to allocate the FPDU trace writer");
+		goto error;
+	}
+
+	writer->buf = (unsigned char *)MALLOC(RLE_FPDU_TRACE_WRITE_LEN);
+	if (writer->buf == NULL) {
+		RLE_ERR("failed to allocate the FPDU trace buffer");
+		goto free_writer;
+	}
+	writer->index = (uint64_t *)MALLOC(RLE_FPDU_TRACE_INDEX_MIN * sizeof(uint64_t));
+	if (writer->index == NULL) {
+		RLE_ERR("failed to allocate the FPDU trace index");
+		goto free_buf;
+	}
+	writer->index_nr = 0;
+	writer->index_max = RLE_FPDU_TRACE_INDEX_MIN;
+
+	writer->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (writer->fd < 0) {
+		RLE_ERR("failed to create FPDU trace '%s': %s", path, strerror(errno));
+		goto free_index;
+	}
+
+	/* without index until completed */
+	memset(&header, 0, sizeof(struct rle_fpdu_trace_header));
+	header.magic = RLE_FPDU_TRACE_MAGIC;
+	header.version = RLE_FPDU_TRACE_VERSION;
+	memcpy(writer->buf, &header, sizeof(struct rle_fpdu_trace_header));
+	writer->buf_len = sizeof(struct rle_fpdu_trace_header);
+	writer->buf_offset = 0;
+
+	return writer;
+
+free_index:
+	FREE(writer->index);
+free_buf:
+	FREE(writer->buf);
+free_writer:
+	FREE(writer);
+error:
+	return NULL;
+}
+
+int rle_fpdu_trace_write(struct rle_fpdu_trace_writer *const writer,
+                         const struct rle_fpdu_trace_record *const record,
+                         const unsigned char *const fpdu)
+{
+	const size_t record_len = RLE_FPDU_TRACE_RECORD_LEN(record->fpdu_len);
+	unsigned char *pos;
+
+	if (writer->index_nr == writer->index_max) {
+		uint64_t *const index = (uint64_t *)MALLOC(2 * writer->index_max * sizeof(uint64_t));
+
+		if (index == NULL) {
+			RLE_ERR("failed to grow the FPDU trace index");
+			goto error;
+		}
+		memcpy(index, writer->index, writer->index_nr * sizeof(uint64_t));
+		FREE(writer->index);
+		writer->index = index;
+		writer->index_max *= 2;
+	}
+
+	if (writer->buf_len + record_len > RLE_FPDU_TRACE_WRITE_LEN &&
+	    rle_fpdu_trace_flush(writer) != C_OK) {
+		goto error;
+	}
+
+	pos = writer->buf + writer->buf_len;
+	memcpy(pos, record, sizeof(struct rle_fpdu_trace_record));
+	memcpy(pos + sizeof(struct rle_fpdu_trace_record), fpdu, record->fpdu_len);
+	memset(pos + sizeof(struct rle_fpdu_trace_record) + record->fpdu_len, 0,
+	       record_len - sizeof(struct rle_fpdu_trace_record) - record->fpdu_len);
+
+	writer->index[writer->index_nr] = writer->buf_offset + writer->buf_len;
+	writer->index_nr++;
+	writer->buf_len += record_len;
+
+	return 0;
+
+error:
+	return 1;
+}
+
+int rle_fpdu_trace_writer_close(struct rle_fpdu_trace_writer **const writer)
+{
+	struct rle_fpdu_trace_header header;
+	int status = 1;
+
+	if (rle_fpdu_trace_flush(*writer) != C_OK) {
+		goto close;
+	}
+
+	memset(&header, 0, sizeof(struct rle_fpdu_trace_header));
+	header.magic = RLE_FPDU_TRACE_MAGIC;
+	header.version = RLE_FPDU_TRACE_VERSION;
+	header.records_nr = (*writer)->index_nr;
+	header.index_offset = (*writer)->buf_offset;
+
+	/* the index, then the header that points to it: a trace is never seen with half an index */
+	if (rle_fpdu_trace_write_all((*writer)->fd, (*writer)->index,
+	                             (*writer)->index_nr * sizeof(uint64_t)) != C_OK) {
+		goto close;
+	}
+	if (pwrite((*writer)->fd, &header, sizeof(struct rle_fpdu_trace_header), 0) !=
+	    (ssize_t)sizeof(struct rle_fpdu_trace_header)) {
+		RLE_ERR("failed to write the FPDU trace header: %s", strerror(errno));
+		goto close;
+	}
+
+	status = 0;
+
+close:
+	if (close((*writer)->fd) != 0) {
+		RLE_ERR("failed to close the FPDU trace: %s", strerror(errno));
+		status = 1;
+	}
+	FREE((*writer)->index);
+	FREE((*writer)->buf);
+	FREE(*writer);
+	*writer = NULL;
+
+	return status;
+}
+
+struct rle_fpdu_trace * rle_fpdu_trace_open(const char *const path)
+{
+	const struct rle_fpdu_trace_header *header;
+	struct rle_fpdu_trace *trace;
+	struct stat st;
+	void *addr;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		RLE_ERR("failed to open FPDU trace '%s': %s", path, strerror(errno));
+		goto error;
+	}
+	if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(struct rle_fpdu_trace_header)) {
+		RLE_ERR("'%s' is too short for a FPDU trace", path);
+		goto close_fd;
+	}
+
+	/* private and writable: the FPDUs are decapsulated in place, never written back */
+	addr = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	if (addr == MAP_FAILED) {
+		RLE_ERR("failed to map FPDU trace '%s': %s", path, strerror(errno));
+		goto close_fd;
+	}
+	/* advisory only, the traces are mostly replayed in order */
+	(void)madvise(addr, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+	trace = (struct rle_fpdu_trace *)MALLOC(sizeof(struct rle_fpdu_trace));
+	if (trace == NULL) {
+		RLE_ERR("failed to allocate the FPDU trace");
+		goto unmap;
+	}
+	trace->base = (unsigned char *)addr;
+	trace->len = (size_t)st.st_size;
+	trace->own_index = NULL;
+
+	header = (const struct rle_fpdu_trace_header *)trace->base;
+	if (header->magic != RLE_FPDU_TRACE_MAGIC || header->version != RLE_FPDU_TRACE_VERSION) {
+		RLE_ERR("'%s' is not a FPDU trace of version %d", path, RLE_FPDU_TRACE_VERSION);
+		goto free_trace;
+	}
+
+	if (header->index_offset == 0) {
+		if (rle_fpdu_trace_scan(trace) != C_OK) {
+			goto free_trace;
+		}
+	} else {
+		size_t i;
+
+		if (header->index_offset % RLE_FPDU_TRACE_ALIGN != 0 ||
+		    header->index_offset > trace->len ||
+		    header->records_nr > (trace->len - header->index_offset) / sizeof(uint64_t)) {
+			RLE_ERR("index of FPDU trace '%s' out of the trace", path);
+			goto free_trace;
+		}
+		trace->index = (const uint64_t *)(trace->base + header->index_offset);
+		trace->records_nr = header->records_nr;
+
+		/* once for all, the records are then read without any check */
+		for (i = 0; i < trace->records_nr; ++i) {
+			if (!rle_fpdu_trace_record_is_valid(trace, trace->index[i], header->index_offset)) {
+				RLE_ERR("record %zu of FPDU trace '%s' out of the trace", i, path);
+				goto free_trace;
+			}
+		}
+	}
+
+	close(fd);
+
+	return trace;
+
+free_trace:
+	if (trace->own_index != NULL) {
+		FREE(trace->own_index);
+	}
+	FREE(trace);
+unmap:
+	munmap(addr, (size_t)st.st_size);
+close_fd:
+	close(fd);
+error:
+	return NULL;
+}
+
+size_t rle_fpdu_trace_count(const struct rle_fpdu_trace *const trace)
+{
+	return trace->records_nr;
+}
+
+const struct rle_fpdu_trace_record * rle_fpdu_trace_get(const struct rle_fpdu_trace *const trace,
+                                                        const size_t index,
+                                                        unsigned char **const fpdu)
+{
+	unsigned char *pos;
+
+	assert(index < trace->records_nr);
+
+	pos = trace->base + trace->index[index];
+	*fpdu = pos + sizeof(struct rle_fpdu_trace_record);
+
+	return (const struct rle_fpdu_trace_record *)pos;
+}
+
+void rle_fpdu_trace_close(struct rle_fpdu_trace **const trace)
+{
+	if (*trace == NULL) {
+		return;
+	}
+
+	if ((*trace)->own_index != NULL) {
+		FREE((*trace)->own_index);
+	}
+	munmap((*trace)->base, (*trace)->len);
+	FREE(*trace);
+	*trace = NULL;
+}
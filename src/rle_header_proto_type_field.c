@@ -170,6 +170,13 @@ int rle_header_ptype_is_compressible(uint16_t uncompressed_ptype)
 
 uint8_t rle_header_ptype_compression(const uint16_t uncompressed_ptype,
                                      const struct rle_frag_buf *const frag_buf)
+{
+	return get_comp_ptype(uncompressed_ptype, frag_buf->sdu.start, frag_buf->sdu_info.size);
+}
+
+uint8_t get_comp_ptype(const uint16_t uncompressed_ptype,
+                       const unsigned char *const sdu,
+                       const size_t sdu_len)
 {
 	uint8_t compressed_ptype;
 
@@ -182,8 +189,7 @@ uint8_t rle_header_ptype_compression(const uint16_t uncompressed_ptype,
 		 *  - VLAN contains one IPv4 or IPv6 packet as payload,
 		 *  - VLAN contains something else as payload.
 		 */
-		compressed_ptype =
-			is_eth_vlan_ip_frame(frag_buf->sdu.start, frag_buf->sdu_info.size);
+		compressed_ptype = is_eth_vlan_ip_frame(sdu, sdu_len);
 		break;
 	case RLE_PROTO_TYPE_VLAN_QINQ_UNCOMP:
 		compressed_ptype = RLE_PROTO_TYPE_VLAN_QINQ_COMP;
@@ -86,5 +86,18 @@ uint8_t get_alpdu_label_type(const uint16_t protocol_type,
                              const uint8_t type_0_alpdu_label_size)
 __attribute__((warn_unused_result));
 
+/**
+ * @brief Get the compressed protocol type of a SDU.
+ *
+ * @param uncompressed_ptype  The uncompressed protocol type of the SDU.
+ * @param sdu                 The SDU, read for VLAN frames only.
+ * @param sdu_len             The length of the SDU.
+ * @return                    The compressed protocol type, RLE_PROTO_TYPE_FALLBACK if none.
+ */
+uint8_t get_comp_ptype(const uint16_t uncompressed_ptype,
+                       const unsigned char *const sdu,
+                       const size_t sdu_len)
+__attribute__((warn_unused_result));
+
 
 #endif /* __RLE_HEADER_PROTO_TYPE_FIELD_H__ */
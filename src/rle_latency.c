@@ -0,0 +1,207 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   rle_latency.c
+ * @brief  RLE per-stage latency histograms
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#include "rle_latency.h"
+#include "constants.h"
+
+#ifndef __KERNEL__
+
+#include <string.h>
+
+#else
+
+#include <linux/string.h>
+
+#endif
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------- PRIVATE FUNCTIONS ----------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief         Merge a latency histogram into another one.
+ *
+ * @param[in,out] dst             The histogram to merge into.
+ * @param[in]     src             The histogram to merge.
+ */
+static void rle_latency_histo_merge(struct rle_latency_histo *const dst,
+                                    const struct rle_latency_histo *const src);
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*----------------------------------- PRIVATE FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+static void rle_latency_histo_merge(struct rle_latency_histo *const dst,
+                                    const struct rle_latency_histo *const src)
+{
+	size_t i;
+
+	if (src->count == 0) {
+		return;
+	}
+
+	if (dst->count == 0 || src->min_ns < dst->min_ns) {
+		dst->min_ns = src->min_ns;
+	}
+	if (src->max_ns > dst->max_ns) {
+		dst->max_ns = src->max_ns;
+	}
+	dst->count += src->count;
+	dst->sum_ns += src->sum_ns;
+
+	for (i = 0; i < RLE_LATENCY_HISTO_BUCKETS; ++i) {
+		dst->buckets[i] += src->buckets[i];
+	}
+}
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+struct rle_latency * rle_latency_new(const struct rle_allocator *const allocator)
+{
+	struct rle_latency *latency;
+
+	latency = (struct rle_latency *)rle_allocator_alloc(allocator, sizeof(struct rle_latency));
+	if (latency == NULL) {
+		goto out;
+	}
+
+	latency->is_enabled = false;
+	rle_latency_reset(latency);
+
+out:
+	return latency;
+}
+
+void rle_latency_del(const struct rle_allocator *const allocator,
+                     struct rle_latency **const latency)
+{
+	if (latency == NULL || *latency == NULL) {
+		return;
+	}
+
+	rle_allocator_free(allocator, *latency);
+	*latency = NULL;
+}
+
+void rle_latency_reset(struct rle_latency *const latency)
+{
+	if (latency == NULL) {
+		return;
+	}
+
+	memset(latency->histo, 0, sizeof(latency->histo));
+}
+
+int rle_latency_get_histo(const struct rle_latency *const latency,
+                          const enum rle_latency_stage stage,
+                          const uint8_t ctx,
+                          struct rle_latency_histo *const histo)
+{
+	int status = 1;
+	size_t i;
+
+	if (latency == NULL || histo == NULL || stage >= RLE_LATENCY_STAGE_NB) {
+		goto out;
+	}
+
+	if (ctx == RLE_LATENCY_ALL_CTX) {
+		memset(histo, 0, sizeof(struct rle_latency_histo));
+		for (i = 0; i <= RLE_LATENCY_NO_CTX; ++i) {
+			rle_latency_histo_merge(histo, &latency->histo[stage][i]);
+		}
+	} else if (ctx < RLE_MAX_FRAG_NUMBER) {
+		memcpy(histo, &latency->histo[stage][ctx], sizeof(struct rle_latency_histo));
+	} else {
+		goto out;
+	}
+
+	status = 0;
+
+out:
+	return status;
+}
+
+uint64_t rle_latency_histo_get_bucket_min(const size_t bucket)
+{
+	const size_t sub_nb = 1 << RLE_LATENCY_HISTO_SUB_BITS;
+	size_t range;
+
+	if (bucket < sub_nb) {
+		return bucket;
+	}
+
+	range = (bucket >> RLE_LATENCY_HISTO_SUB_BITS) - 1;
+
+	return (uint64_t)(sub_nb + (bucket & (sub_nb - 1))) << range;
+}
+
+uint64_t rle_latency_histo_get_percentile(const struct rle_latency_histo *const histo,
+                                          const uint32_t basis_points)
+{
+	uint64_t rank;
+	uint64_t seen = 0;
+	uint64_t value = 0;
+	size_t i;
+
+	if (histo->count == 0) {
+		goto out;
+	}
+
+	/* rank of the percentile, rounded up, in [1, count] */
+	rank = (histo->count * (basis_points > 10000 ? 10000 : basis_points) + 9999) / 10000;
+	if (rank == 0) {
+		rank = 1;
+	}
+
+	for (i = 0; i < RLE_LATENCY_HISTO_BUCKETS; ++i) {
+		seen += histo->buckets[i];
+		if (seen >= rank) {
+			break;
+		}
+	}
+
+	if (i + 1 < RLE_LATENCY_HISTO_BUCKETS) {
+		value = rle_latency_histo_get_bucket_min(i + 1) - 1;
+	} else {
+		value = histo->max_ns;
+	}
+	if (value > histo->max_ns) {
+		value = histo->max_ns;
+	}
+	if (value < histo->min_ns) {
+		value = histo->min_ns;
+	}
+
+out:
+	return value;
+}
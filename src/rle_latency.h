@@ -0,0 +1,226 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   rle_latency.h
+ * @brief  Definition of the RLE per-stage latency histograms
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#ifndef __RLE_LATENCY_H__
+#define __RLE_LATENCY_H__
+
+#ifndef __KERNEL__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#else
+
+#include <linux/types.h>
+#include <linux/timekeeping.h>
+
+#endif
+
+#include "rle.h"
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*---------------------------------- PUBLIC CONSTANTS AND MACROS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** Index of the histograms of the PPDUs not related to any context (Complete PPDUs). */
+#define RLE_LATENCY_NO_CTX RLE_MAX_FRAG_NUMBER
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PUBLIC STRUCTS AND TYPEDEFS ----------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** Latency histograms of a transmitter or a receiver, per stage and per context. */
+struct rle_latency {
+	/** Whether new durations are recorded */
+	bool is_enabled;
+	/** Histograms, the extra context holds the contextless PPDUs */
+	struct rle_latency_histo histo[RLE_LATENCY_STAGE_NB][RLE_MAX_FRAG_NUMBER + 1];
+};
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------------- PUBLIC FUNCTIONS ---------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief         Allocate new latency histograms, all empty and disabled.
+ *
+ * @param[in]     allocator       The allocator, NULL for the registered one.
+ *
+ * @return        The histograms if OK, else NULL.
+ */
+struct rle_latency * rle_latency_new(const struct rle_allocator *const allocator);
+
+/**
+ * @brief         Free latency histograms.
+ *
+ * @param[in]     allocator       The allocator of the histograms, NULL for the registered one.
+ * @param[in,out] latency         The histograms to free, set to NULL. May point to NULL.
+ */
+void rle_latency_del(const struct rle_allocator *const allocator,
+                     struct rle_latency **const latency);
+
+/**
+ * @brief         Empty all the latency histograms.
+ *
+ * @param[in,out] latency         The histograms, may be NULL.
+ */
+void rle_latency_reset(struct rle_latency *const latency);
+
+/**
+ * @brief         Snapshot a latency histogram, or the merge of all the context histograms.
+ *
+ * @param[in]     latency         The histograms, may be NULL.
+ * @param[in]     stage           The stage.
+ * @param[in]     ctx             The context, or RLE_LATENCY_ALL_CTX.
+ * @param[out]    histo           The snapshot.
+ *
+ * @return        0 if OK, else 1.
+ */
+int rle_latency_get_histo(const struct rle_latency *const latency,
+                          const enum rle_latency_stage stage,
+                          const uint8_t ctx,
+                          struct rle_latency_histo *const histo);
+
+/**
+ * @brief         Get the current time of the raw monotonic clock.
+ *
+ * @return        The current time, in nanoseconds.
+ */
+static inline uint64_t rle_latency_now(void);
+
+/**
+ * @brief         Get the histogram bucket of a duration.
+ *
+ * @param[in]     duration        The duration, in nanoseconds.
+ *
+ * @return        The index of the bucket.
+ */
+static inline size_t rle_latency_get_bucket(const uint64_t duration);
+
+/**
+ * @brief         Start measuring a stage duration.
+ *
+ *                This is the only cost of the instrumentation when latency is disabled.
+ *
+ * @param[in]     latency         The histograms, may be NULL.
+ *
+ * @return        The start time if latency is enabled, else 0.
+ */
+static inline uint64_t rle_latency_start(const struct rle_latency *const latency);
+
+/**
+ * @brief         Stop measuring a stage duration and record it.
+ *
+ * @param[in,out] latency         The histograms, may be NULL.
+ * @param[in]     stage           The measured stage.
+ * @param[in]     ctx             The context, RLE_LATENCY_NO_CTX if none.
+ * @param[in]     start           The start time returned by @ref rle_latency_start.
+ */
+static inline void rle_latency_stop(struct rle_latency *const latency,
+                                    const enum rle_latency_stage stage,
+                                    const size_t ctx,
+                                    const uint64_t start);
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+static inline uint64_t rle_latency_now(void)
+{
+#ifndef __KERNEL__
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+
+	return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#else
+	return ktime_get_raw_ns();
+#endif
+}
+
+static inline size_t rle_latency_get_bucket(const uint64_t duration)
+{
+	size_t msb;
+
+	if (duration < (1ULL << RLE_LATENCY_HISTO_SUB_BITS)) {
+		return (size_t)duration;
+	}
+
+	msb = 63 - __builtin_clzll(duration);
+	if (msb >= (RLE_LATENCY_HISTO_BUCKETS >> RLE_LATENCY_HISTO_SUB_BITS) +
+	    RLE_LATENCY_HISTO_SUB_BITS - 1) {
+		return RLE_LATENCY_HISTO_BUCKETS - 1;
+	}
+
+	return ((msb - RLE_LATENCY_HISTO_SUB_BITS + 1) << RLE_LATENCY_HISTO_SUB_BITS) +
+	       ((duration >> (msb - RLE_LATENCY_HISTO_SUB_BITS)) &
+	        ((1ULL << RLE_LATENCY_HISTO_SUB_BITS) - 1));
+}
+
+static inline uint64_t rle_latency_start(const struct rle_latency *const latency)
+{
+	if (latency == NULL || !latency->is_enabled) {
+		return 0;
+	}
+
+	return rle_latency_now();
+}
+
+static inline void rle_latency_stop(struct rle_latency *const latency,
+                                    const enum rle_latency_stage stage,
+                                    const size_t ctx,
+                                    const uint64_t start)
+{
+	struct rle_latency_histo *histo;
+	uint64_t duration;
+
+	if (start == 0) {
+		return;
+	}
+
+	duration = rle_latency_now() - start;
+	histo = &latency->histo[stage][ctx];
+
+	if (histo->count == 0 || duration < histo->min_ns) {
+		histo->min_ns = duration;
+	}
+	if (duration > histo->max_ns) {
+		histo->max_ns = duration;
+	}
+	histo->count++;
+	histo->sum_ns += duration;
+	histo->buckets[rle_latency_get_bucket(duration)]++;
+}
+
+
+#endif /* __RLE_LATENCY_H__ */
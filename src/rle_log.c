@@ -60,7 +60,12 @@ const rle_log_module_tuple_t * rle_get_log_modules_list(size_t *nb_modules)
 		{ RLE_MOD_ID_CTX, "RLE_CTX" },
 		{ RLE_MOD_ID_RECEIVER, "RLE_RECEIVER" },
 		{ RLE_MOD_ID_TRANSMITTER, "RLE_TRANSMITTER" },
-		{ RLE_MOD_ID_TRAILER, "RLE_TRAILER" }
+		{ RLE_MOD_ID_TRAILER, "RLE_TRAILER" },
+		{ RLE_MOD_ID_STATS_SHM, "RLE_STATS_SHM" },
+		{ RLE_MOD_ID_ALLOC, "RLE_ALLOC" },
+		{ RLE_MOD_ID_SCHED, "RLE_SCHED" },
+		{ RLE_MOD_ID_FPDU_TRACE, "RLE_FPDU_TRACE" },
+		{ RLE_MOD_ID_CHECKPOINT, "RLE_CHECKPOINT" }
 	};
 
 	/* if the pointer passed as argument is not null,
@@ -28,6 +28,7 @@
 
 #include "rle_receiver.h"
 #include "reassembly.h"
+#include "reassembly_buffer.h"
 #include "rle_ctx.h"
 #include "rle_conf.h"
 #include "constants.h"
@@ -42,16 +43,15 @@
 
 #endif
 
-#ifdef TIME_DEBUG
-#include <sys/time.h>
-#endif
-
 /*------------------------------------------------------------------------------------------------*/
 /*--------------------------------- PRIVATE CONSTANTS AND MACROS ---------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
 
 #define MODULE_ID RLE_MOD_ID_RECEIVER
 
+/** One token of the error traces bucket, in billionths of token */
+#define RLE_TRACE_LIMIT_TOKEN 1000000000ULL
+
 
 /*------------------------------------------------------------------------------------------------*/
 /*------------------------------------- PRIVATE FUNCTIONS ----------------------------------------*/
@@ -71,6 +71,18 @@ static int get_receiver_context(const struct rle_receiver *const receiver,
                                 const struct rle_ctx_mngt **const ctx_man);
 
 
+/**
+ * @brief          Configure the rate limit of the error traces and fill its bucket.
+ *
+ * @param[in,out]  limit                    The rate limit.
+ * @param[in]      rate                     The traces per second, 0 for no limit.
+ * @param[in]      burst                    The max number of traces in a burst.
+ */
+static void rle_trace_limit_init(struct rle_trace_limit *const limit,
+                                 const uint32_t rate,
+                                 const uint32_t burst);
+
+
 /*------------------------------------------------------------------------------------------------*/
 /*----------------------------------- PRIVATE FUNCTIONS CODE -------------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
@@ -97,13 +109,31 @@ error:
 }
 
 
+static void rle_trace_limit_init(struct rle_trace_limit *const limit,
+                                 const uint32_t rate,
+                                 const uint32_t burst)
+{
+	limit->rate = rate;
+	limit->burst = (burst == 0 ? 1 : burst);
+	limit->credit = (uint64_t)limit->burst * RLE_TRACE_LIMIT_TOKEN;
+	limit->last_ns = rle_latency_now();
+}
+
+
 /*------------------------------------------------------------------------------------------------*/
 /*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
 
 struct rle_receiver * rle_receiver_new(const struct rle_config *const conf)
+{
+	return rle_receiver_new_with_allocator(conf, NULL);
+}
+
+struct rle_receiver * rle_receiver_new_with_allocator(const struct rle_config *const conf,
+                                                      const struct rle_allocator *const allocator)
 {
 	struct rle_receiver *receiver = NULL;
+	struct rle_allocator the_allocator;
 	size_t i;
 
 	if (!rle_config_check(conf)) {
@@ -111,18 +141,29 @@ struct rle_receiver * rle_receiver_new(const struct rle_config *const conf)
 		goto error;
 	}
 
-	receiver = (struct rle_receiver *)MALLOC(sizeof(struct rle_receiver));
+	if (allocator == NULL) {
+		rle_allocator_get(&the_allocator);
+	} else if (allocator->alloc == NULL || allocator->free == NULL) {
+		RLE_ERR("failed to created RLE receiver: invalid allocator");
+		goto error;
+	} else {
+		the_allocator = *allocator;
+	}
+
+	receiver = (struct rle_receiver *)rle_allocator_alloc(&the_allocator,
+	                                                      sizeof(struct rle_receiver));
 	if (!receiver) {
 		RLE_ERR("allocating receiver module failed");
 		goto error;
 	}
+	receiver->allocator = the_allocator;
 
 	memcpy(&receiver->conf, conf, sizeof(struct rle_config));
 
-	memset(receiver->rle_ctx_man, 0, RLE_MAX_FRAG_NUMBER * sizeof(struct rle_ctx_mngt));
+	rle_zero(receiver->rle_ctx_man, RLE_MAX_FRAG_NUMBER * sizeof(struct rle_ctx_mngt));
 	for (i = 0; i < RLE_MAX_FRAG_NUMBER; i++) {
 		struct rle_ctx_mngt *const ctx_man = &receiver->rle_ctx_man[i];
-		if (rle_ctx_init_rasm_buf(ctx_man) != C_OK) {
+		if (rle_ctx_init_rasm_buf(ctx_man, &receiver->allocator) != C_OK) {
 			RLE_ERR("failed to allocate memory for reassembly context with ID %zu", i);
 			goto free_ctxts;
 		}
@@ -132,6 +173,20 @@ struct rle_receiver * rle_receiver_new(const struct rle_config *const conf)
 	}
 
 	receiver->free_ctx = 0;
+	receiver->latency = NULL;
+	receiver->trace.callback = NULL;
+	receiver->trace.priv = NULL;
+	receiver->trace.level = RLE_LOG_LEVEL_DEBUG;
+	memset(receiver->errors, 0, sizeof(receiver->errors));
+	receiver->error_traces_suppressed = 0;
+	rle_trace_limit_init(&receiver->error_trace_limit, RLE_ERROR_TRACE_RATE_DEFAULT,
+	                     RLE_ERROR_TRACE_BURST_DEFAULT);
+	receiver->stream.state = RLE_DECAP_STREAM_IDLE;
+	receiver->stream.fpdu_length = 0;
+	receiver->stream.offset = 0;
+	receiver->stream.carry_len = 0;
+	rle_receiver_label_filter_clear(receiver);
+	receiver->fpdus_filtered = 0;
 
 	return receiver;
 
@@ -139,16 +194,72 @@ free_ctxts:
 	for (i = 0; i < RLE_MAX_FRAG_NUMBER; i++) {
 		struct rle_ctx_mngt *const ctx_man = &receiver->rle_ctx_man[i];
 		if (ctx_man->buff != NULL) {
-			rle_ctx_destroy_rasm_buf(ctx_man);
+			rle_ctx_destroy_rasm_buf(ctx_man, &the_allocator);
 		}
 	}
-	FREE(receiver);
+	rle_allocator_free(&the_allocator, receiver);
 error:
 	return NULL;
 }
 
+struct rle_receiver * rle_receiver_new_on_node(const struct rle_config *const conf,
+                                               const int node,
+                                               const unsigned int flags)
+{
+	struct rle_receiver *receiver = NULL;
+
+	if (rle_receiver_new_bulk(conf, 1, node, flags, &receiver) != 0) {
+		RLE_ERR("failed to created RLE receiver on NUMA node %d", node);
+	}
+
+	return receiver;
+}
+
+int rle_receiver_new_bulk(const struct rle_config *const conf, const size_t nr, const int node,
+                          const unsigned int flags, struct rle_receiver *receivers[])
+{
+	const size_t len = rle_region_block_len(sizeof(struct rle_receiver)) +
+	                    RLE_MAX_FRAG_NUMBER * (rle_region_block_len(sizeof(rle_rasm_buf_t)) +
+	                                           rle_region_block_len(RLE_R_BUFF_LEN));
+	struct rle_allocator allocator;
+	int status = 1;
+	size_t i;
+
+	if (receivers == NULL || nr == 0 || nr > SIZE_MAX / len) {
+		RLE_ERR("invalid number of receivers: %zu", nr);
+		goto out;
+	}
+
+	for (i = 0; i < nr; ++i) {
+		receivers[i] = NULL;
+	}
+
+	if (rle_region_allocator_new(&allocator, nr * len, node, flags) != C_OK) {
+		RLE_ERR("failed to allocate a region for %zu receivers", nr);
+		goto out;
+	}
+
+	for (i = 0; i < nr; ++i) {
+		receivers[i] = rle_receiver_new_with_allocator(conf, &allocator);
+		if (receivers[i] == NULL) {
+			RLE_ERR("failed to create RLE receiver #%zu of %zu", i + 1, nr);
+			rle_receiver_destroy_bulk(receivers, i);
+			goto put_region;
+		}
+	}
+
+	status = 0;
+
+put_region:
+	/* the region is now held by the blocks of the receivers, if any */
+	rle_region_allocator_put(&allocator);
+out:
+	return status;
+}
+
 void rle_receiver_destroy(struct rle_receiver **const receiver)
 {
+	struct rle_allocator allocator;
 	size_t i;
 
 	if (!receiver) {
@@ -161,12 +272,17 @@ void rle_receiver_destroy(struct rle_receiver **const receiver)
 		goto out;
 	}
 
+	/* the receiver holds its allocator, keep it until the end */
+	allocator = (*receiver)->allocator;
+
 	for (i = 0; i < RLE_MAX_FRAG_NUMBER; ++i) {
 		struct rle_ctx_mngt *const ctx_man = &(*receiver)->rle_ctx_man[i];
-		rle_ctx_destroy_rasm_buf(ctx_man);
+		rle_ctx_destroy_rasm_buf(ctx_man, &allocator);
 	}
 
-	FREE(*receiver);
+	rle_latency_del(&allocator, &(*receiver)->latency);
+
+	rle_allocator_free(&allocator, *receiver);
 	*receiver = NULL;
 
 out:
@@ -174,6 +290,22 @@ out:
 	return;
 }
 
+void rle_receiver_destroy_bulk(struct rle_receiver *receivers[], const size_t nr)
+{
+	size_t i;
+
+	if (receivers == NULL) {
+		goto out;
+	}
+
+	for (i = 0; i < nr; ++i) {
+		rle_receiver_destroy(&receivers[i]);
+	}
+
+out:
+	return;
+}
+
 int rle_receiver_deencap_data(struct rle_receiver *_this,
                               unsigned char ppdu[],
                               const size_t ppdu_length,
@@ -184,12 +316,7 @@ int rle_receiver_deencap_data(struct rle_receiver *_this,
 	int ret = C_ERROR;
 	int frag_type = 0;
 
-#ifdef TIME_DEBUG
-	struct timeval tv_start = { .tv_sec = 0L, .tv_usec = 0L };
-	struct timeval tv_end = { .tv_sec = 0L, .tv_usec = 0L };
-	struct timeval tv_delta;
-	gettimeofday(&tv_start, NULL);
-#endif
+	const uint64_t lat_start = rle_latency_start(_this->latency);
 
 	assert(index_ctx != NULL);
 
@@ -217,17 +344,13 @@ int rle_receiver_deencap_data(struct rle_receiver *_this,
 		ret = reassembly_end_ppdu(_this, ppdu, ppdu_length, index_ctx, potential_sdu);
 		break;
 	default:
-		RLE_ERR("Unhandled fragment type '%i'.", frag_type);
+		RLE_TRACE_ERR(&_this->trace, "Unhandled fragment type '%i'.", frag_type);
 		assert(0);
 		break;
 	}
 
-#ifdef TIME_DEBUG
-	gettimeofday(&tv_end, NULL);
-	tv_delta.tv_sec = tv_end.tv_sec - tv_start.tv_sec;
-	tv_delta.tv_usec = tv_end.tv_usec - tv_start.tv_usec;
-	RLE_DEBUG("duration [%04ld.%06ld].", tv_delta.tv_sec, tv_delta.tv_usec);
-#endif
+	rle_latency_stop(_this->latency, RLE_LATENCY_STAGE_DEENCAP,
+	                 *index_ctx < 0 ? RLE_LATENCY_NO_CTX : (size_t)*index_ctx, lat_start);
 
 	return ret;
 }
@@ -238,6 +361,49 @@ void rle_receiver_free_context(struct rle_receiver *_this, uint8_t fragment_id)
 	set_free_frag_ctx(_this, fragment_id);
 }
 
+bool rle_receiver_error_trace_allowed(struct rle_receiver *const _this, const int level)
+{
+	struct rle_trace_limit *const limit = &_this->error_trace_limit;
+	const uint64_t max_credit = (uint64_t)limit->burst * RLE_TRACE_LIMIT_TOKEN;
+	uint64_t now;
+	uint64_t elapsed;
+
+	/* do not spend tokens on traces that nobody receives */
+	if (_this->trace.callback != NULL) {
+		if (level > _this->trace.level) {
+			return false;
+		}
+	} else if (rle_get_trace_callback() == NULL) {
+		return false;
+	}
+
+	if (limit->rate == 0) {
+		return true;
+	}
+
+	now = rle_latency_now();
+	elapsed = now - limit->last_ns;
+	limit->last_ns = now;
+
+	/* refill the bucket, a long idle period fills it without overflowing the product */
+	if (elapsed >= max_credit / limit->rate) {
+		limit->credit = max_credit;
+	} else {
+		limit->credit += elapsed * limit->rate;
+		if (limit->credit > max_credit) {
+			limit->credit = max_credit;
+		}
+	}
+
+	if (limit->credit < RLE_TRACE_LIMIT_TOKEN) {
+		_this->error_traces_suppressed++;
+		return false;
+	}
+	limit->credit -= RLE_TRACE_LIMIT_TOKEN;
+
+	return true;
+}
+
 size_t rle_receiver_stats_get_queue_size(const struct rle_receiver *const receiver,
                                          const uint8_t fragment_id)
 {
@@ -418,3 +584,193 @@ void rle_receiver_stats_reset_counters(struct rle_receiver *const receiver,
 error:
 	return;
 }
+
+uint64_t rle_receiver_stats_get_counter_errors(const struct rle_receiver *const receiver,
+                                               const enum rle_decap_error_type type)
+{
+	if (receiver == NULL || type >= RLE_DECAP_ERROR_NB) {
+		return 0;
+	}
+
+	return receiver->errors[type];
+}
+
+int rle_receiver_stats_get_errors(const struct rle_receiver *const receiver,
+                                  struct rle_receiver_error_stats *const stats)
+{
+	int status = 1;
+
+	if (receiver == NULL || stats == NULL) {
+		goto error;
+	}
+
+	memcpy(stats->errors, receiver->errors, sizeof(stats->errors));
+	stats->traces_suppressed = receiver->error_traces_suppressed;
+	stats->fpdus_filtered = receiver->fpdus_filtered;
+
+	status = 0;
+
+error:
+	return status;
+}
+
+void rle_receiver_stats_reset_errors(struct rle_receiver *const receiver)
+{
+	if (receiver == NULL) {
+		return;
+	}
+
+	memset(receiver->errors, 0, sizeof(receiver->errors));
+	receiver->error_traces_suppressed = 0;
+	receiver->fpdus_filtered = 0;
+}
+
+uint64_t rle_receiver_stats_get_counter_fpdus_filtered(const struct rle_receiver *const receiver)
+{
+	if (receiver == NULL) {
+		return 0;
+	}
+
+	return receiver->fpdus_filtered;
+}
+
+int rle_receiver_label_filter_add(struct rle_receiver *const receiver,
+                                  const unsigned char *const label,
+                                  const unsigned char *const mask,
+                                  const size_t label_size)
+{
+	struct rle_label_filter *filter;
+	uint64_t value = (uint64_t)label_size << 56;
+	uint64_t bits = (uint64_t)0xff << 56;
+	int status = 1;
+	size_t i;
+
+	if (receiver == NULL || label == NULL || (label_size != 3 && label_size != 6)) {
+		goto error;
+	}
+	filter = &receiver->label_filter;
+
+	if (filter->nr == RLE_LABEL_FILTER_MAX) {
+		goto error;
+	}
+
+	for (i = 0; i < label_size; i++) {
+		const uint64_t byte_mask = (mask == NULL) ? 0xff : mask[i];
+
+		value |= (uint64_t)(label[i] & byte_mask) << (40 - 8 * i);
+		bits |= byte_mask << (40 - 8 * i);
+	}
+	filter->values[filter->nr] = value;
+	filter->masks[filter->nr] = bits;
+	filter->nr++;
+
+	status = 0;
+
+error:
+	return status;
+}
+
+void rle_receiver_label_filter_clear(struct rle_receiver *const receiver)
+{
+	size_t i;
+
+	if (receiver == NULL) {
+		return;
+	}
+
+	/* size 0xff in unused slots, never matched */
+	for (i = 0; i < RLE_LABEL_FILTER_MAX; i++) {
+		receiver->label_filter.values[i] = (uint64_t)0xff << 56;
+		receiver->label_filter.masks[i] = (uint64_t)0xff << 56;
+	}
+	receiver->label_filter.nr = 0;
+}
+
+void rle_receiver_set_error_trace_rate(struct rle_receiver *const receiver,
+                                       const uint32_t rate,
+                                       const uint32_t burst)
+{
+	if (receiver == NULL) {
+		return;
+	}
+
+	rle_trace_limit_init(&receiver->error_trace_limit, rate, burst);
+}
+
+int rle_receiver_latency_enable(struct rle_receiver *const receiver)
+{
+	int status = 1;
+
+	if (receiver == NULL) {
+		goto error;
+	}
+
+	if (receiver->latency == NULL) {
+		receiver->latency = rle_latency_new(&receiver->allocator);
+		if (receiver->latency == NULL) {
+			RLE_ERR("failed to allocate latency histograms");
+			goto error;
+		}
+	}
+
+	receiver->latency->is_enabled = true;
+
+	status = 0;
+
+error:
+	return status;
+}
+
+void rle_receiver_latency_disable(struct rle_receiver *const receiver)
+{
+	if (receiver == NULL || receiver->latency == NULL) {
+		return;
+	}
+
+	receiver->latency->is_enabled = false;
+}
+
+int rle_receiver_latency_get_histo(const struct rle_receiver *const receiver,
+                                   const enum rle_latency_stage stage,
+                                   const uint8_t fragment_id,
+                                   struct rle_latency_histo *const histo)
+{
+	if (receiver == NULL) {
+		return 1;
+	}
+
+	return rle_latency_get_histo(receiver->latency, stage, fragment_id, histo);
+}
+
+void rle_receiver_latency_reset(struct rle_receiver *const receiver)
+{
+	if (receiver == NULL) {
+		return;
+	}
+
+	rle_latency_reset(receiver->latency);
+}
+
+void rle_receiver_set_trace_callback(struct rle_receiver *const receiver,
+                                     rle_instance_trace_callback_t callback,
+                                     void *const priv,
+                                     const rle_log_level_t level)
+{
+	if (receiver == NULL) {
+		return;
+	}
+
+	receiver->trace.callback = callback;
+	receiver->trace.priv = priv;
+	receiver->trace.level = level;
+}
+
+void rle_receiver_set_trace_level(struct rle_receiver *const receiver,
+                                  const rle_log_level_t level)
+{
+	if (receiver == NULL) {
+		return;
+	}
+
+	receiver->trace.level = level;
+}
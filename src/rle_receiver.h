@@ -41,12 +41,79 @@
 
 #include "rle_ctx.h"
 #include "header.h"
+#include "rle_latency.h"
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*---------------------------------- PUBLIC CONSTANTS AND MACROS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * Count an error of a receiver, and trace it if the rate of its error traces allows it.
+ * The trace is only formatted if it is emitted.
+ */
+#define RLE_RECEIVER_LOG(receiver, error, log_level, x, ...) \
+	do { \
+		struct rle_receiver *const the_receiver = (receiver); \
+		the_receiver->errors[error]++; \
+		if ((log_level) <= RLE_LOG_LEVEL_BUILD && \
+		    rle_receiver_error_trace_allowed(the_receiver, log_level)) { \
+			RLE_LOG_TRACE(&the_receiver->trace, log_level, x, ## __VA_ARGS__); \
+		} \
+	} while (0)
+#define RLE_RECEIVER_WARN(receiver, error, x, ...) \
+	RLE_RECEIVER_LOG(receiver, error, RLE_LOG_LEVEL_WARNING, x, ## __VA_ARGS__)
+#define RLE_RECEIVER_ERR(receiver, error, x, ...) \
+	RLE_RECEIVER_LOG(receiver, error, RLE_LOG_LEVEL_ERROR, x, ## __VA_ARGS__)
 
 
 /*------------------------------------------------------------------------------------------------*/
 /*--------------------------------- PUBLIC STRUCTS AND TYPEDEFS ----------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
 
+/** Token bucket limiting the rate of the error traces of a receiver */
+struct rle_trace_limit {
+	uint32_t rate;    /**< Tokens added per second, 0 for no limit */
+	uint32_t burst;   /**< Max number of tokens */
+	uint64_t credit;  /**< Available tokens, in billionths of token */
+	uint64_t last_ns; /**< Time of the last refill, in nanoseconds */
+};
+
+/**
+ * Payload labels accepted by a receiver.
+ *
+ * Each label is compared as a 64-bit word holding its size in the top octet and its octets below,
+ * against all the slots at once so that the filtering time does not depend on the label. Unused
+ * slots hold a size that no label has.
+ */
+struct rle_label_filter {
+	uint64_t values[RLE_LABEL_FILTER_MAX]; /**< Masked labels, with their size           */
+	uint64_t masks[RLE_LABEL_FILTER_MAX];  /**< Masks of the labels, with their size     */
+	size_t nr;                             /**< Number of labels, 0 to accept all FPDUs  */
+};
+
+/** Parsing state of a FPDU decapsulated by chunks */
+enum rle_decap_stream_state {
+	RLE_DECAP_STREAM_IDLE,     /**< No FPDU in progress                          */
+	RLE_DECAP_STREAM_PPDU,     /**< Parsing the payload label and the PPDUs      */
+	RLE_DECAP_STREAM_PADDING,  /**< Remaining bytes of the FPDU are padding      */
+	RLE_DECAP_STREAM_SKIP,     /**< Remaining bytes are dropped after an error   */
+	RLE_DECAP_STREAM_FILTERED, /**< Payload label rejected, FPDU dropped         */
+};
+
+/** FPDU decapsulated by chunks, see rle_decap_stream_push */
+struct rle_decap_stream {
+	enum rle_decap_stream_state state; /**< Parsing state                               */
+	size_t fpdu_length;                /**< Size of the FPDU                            */
+	size_t offset;                     /**< Number of bytes of the FPDU received yet    */
+	size_t label_size;                 /**< Size of the payload label                   */
+	size_t carry_len;                  /**< Bytes of the straddling PPDU carried over   */
+	bool is_padding_invalid;           /**< Whether non-zero padding was reported       */
+	unsigned char label[6];            /**< The payload label                           */
+	/** Start of the PPDU that straddles chunks */
+	unsigned char carry[RLE_MAX_PPDU_PL_SIZE + 2];
+};
+
 /**
  * @brief RLE receiver module used for reassembly & deencapsulation.
  *        Provides a context structure for each fragment_id.
@@ -60,6 +127,21 @@ struct rle_receiver {
 	bool is_ctx_seqnum_init[RLE_MAX_FRAG_NUMBER];
 	struct rle_config conf;  /**< RLE configuration */
 	uint8_t free_ctx;        /**< List of free contexts */
+	struct rle_latency *latency; /**< Latency histograms, NULL until first enabled */
+	struct rle_trace trace;      /**< Trace callback of the receiver */
+	struct rle_allocator allocator; /**< Allocator of the receiver and its buffers */
+	/** Errors detected on malformed input, per type */
+	uint64_t errors[RLE_DECAP_ERROR_NB];
+	/** Error traces dropped by the rate limit */
+	uint64_t error_traces_suppressed;
+	/** Rate limit of the error traces */
+	struct rle_trace_limit error_trace_limit;
+	/** FPDU decapsulated by chunks */
+	struct rle_decap_stream stream;
+	/** Payload labels accepted by the receiver */
+	struct rle_label_filter label_filter;
+	/** FPDUs dropped by the payload label filter */
+	uint64_t fpdus_filtered;
 };
 
 
@@ -98,6 +180,21 @@ int rle_receiver_deencap_data(struct rle_receiver *_this,
  */
 void rle_receiver_free_context(struct rle_receiver *_this, uint8_t fragment_id);
 
+/**
+ * @brief Check whether an error trace of a receiver shall be emitted.
+ *
+ *        Traces that no callback would receive are not accounted. The others take a token from
+ *        the bucket of the receiver, or are counted as suppressed if it is empty.
+ *
+ * @param[in,out] _this        The receiver module.
+ * @param[in]     level        The level of the trace.
+ *
+ * @return true if the trace shall be emitted, else false.
+ *
+ * @ingroup RLE receiver
+ */
+bool rle_receiver_error_trace_allowed(struct rle_receiver *const _this, const int level);
+
 /**
  * @brief Set to non free the state to a given context knowing its fragment ID.
  *
@@ -128,6 +225,23 @@ static inline void set_free_frag_ctx(struct rle_receiver *const _this, const siz
  */
 static inline int is_context_free(struct rle_receiver *const _this, const size_t fragment_id);
 
+/**
+ * @brief Check whether the payload label of a FPDU is accepted by a receiver.
+ *
+ *        FPDUs without payload label are always accepted.
+ *
+ * @param[in]     _this        The receiver module.
+ * @param[in]     label        The payload label.
+ * @param[in]     label_size   The size of the payload label, 0, 3 or 6.
+ *
+ * @return true if the FPDU shall be decapsulated, else false.
+ *
+ * @ingroup RLE receiver
+ */
+static inline bool rle_receiver_label_is_accepted(const struct rle_receiver *const _this,
+                                                  const unsigned char *const label,
+                                                  const size_t label_size);
+
 
 /*------------------------------------------------------------------------------------------------*/
 /*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
@@ -150,5 +264,30 @@ static inline int is_context_free(struct rle_receiver *const _this, const size_t
 	return rle_ctx_is_free(_this->free_ctx, fragment_id);
 }
 
+static inline bool rle_receiver_label_is_accepted(const struct rle_receiver *const _this,
+                                                  const unsigned char *const label,
+                                                  const size_t label_size)
+{
+	const struct rle_label_filter *const filter = &_this->label_filter;
+	uint64_t word = (uint64_t)label_size << 56;
+	unsigned int match = 0;
+	size_t i;
+
+	if (filter->nr == 0 || label_size == 0) {
+		return true;
+	}
+
+	for (i = 0; i < label_size; i++) {
+		word |= (uint64_t)label[i] << (40 - 8 * i);
+	}
+
+	/* no early exit, all the slots are compared */
+	for (i = 0; i < RLE_LABEL_FILTER_MAX; i++) {
+		match |= ((word & filter->masks[i]) == filter->values[i]);
+	}
+
+	return (match != 0);
+}
+
 
 #endif /* __RLE_RECEIVER_H__ */
@@ -0,0 +1,271 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   rle_sched.c
+ * @brief  RLE scheduler of the fragmentation contexts of a transmitter
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#include "rle_sched.h"
+#include "rle_transmitter.h"
+#include "rle_ctx.h"
+#include "constants.h"
+#include "fragmentation_buffer.h"
+
+#ifndef __KERNEL__
+
+#include <string.h>
+
+#else
+
+#include <linux/string.h>
+
+#endif
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PRIVATE CONSTANTS AND MACROS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+#define MODULE_ID RLE_MOD_ID_SCHED
+
+/** No context chosen */
+#define RLE_SCHED_NONE RLE_MAX_FRAG_NUMBER
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------- PRIVATE FUNCTIONS ----------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief         Drop the SDUs past their deadline and not fragmented yet.
+ *
+ * @param[in,out] transmitter     The transmitter.
+ * @param[in]     now             The current time.
+ */
+static void rle_sched_expire(struct rle_transmitter *const transmitter, const uint64_t now);
+
+/**
+ * @brief         Choose a real-time context with an SDU by the policy of the scheduler.
+ *
+ * @param[in]     transmitter     The transmitter.
+ *
+ * @return        The chosen context, RLE_SCHED_NONE if none.
+ */
+static uint8_t rle_sched_pick_realtime(const struct rle_transmitter *const transmitter);
+
+/**
+ * @brief         Choose a bulk context with an SDU by deficit round robin.
+ *
+ * @param[in,out] transmitter     The transmitter.
+ * @param[in]     burst_size      The room for the next PPDU, charged to the chosen context.
+ *
+ * @return        The chosen context, RLE_SCHED_NONE if none.
+ */
+static uint8_t rle_sched_pick_bulk(struct rle_transmitter *const transmitter,
+                                   const size_t burst_size);
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*----------------------------------- PRIVATE FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+static void rle_sched_expire(struct rle_transmitter *const transmitter, const uint64_t now)
+{
+	struct rle_sched *const sched = &transmitter->sched;
+	uint8_t frag_id;
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		struct rle_ctx_mngt *const rle_ctx = &transmitter->rle_ctx_man[frag_id];
+		const rle_frag_buf_t *const frag_buf = (rle_frag_buf_t *)rle_ctx->buff;
+
+		if (rle_ctx_is_free(transmitter->free_ctx, frag_id) ||
+		    sched->deadline[frag_id] == RLE_SDU_NO_DEADLINE || now <= sched->deadline[frag_id] ||
+		    frag_buf_is_fragmented(frag_buf)) {
+			continue;
+		}
+
+		RLE_TRACE_DEBUG(&transmitter->trace, "drop the expired %zd-byte SDU of context with ID %u",
+		                frag_buf_get_sdu_len(frag_buf), frag_id);
+		rle_ctx_incr_counter_expired(rle_ctx, (uint64_t)frag_buf_get_sdu_len(frag_buf));
+		rle_transmitter_free_context(transmitter, frag_id);
+	}
+}
+
+static uint8_t rle_sched_pick_realtime(const struct rle_transmitter *const transmitter)
+{
+	const struct rle_sched *const sched = &transmitter->sched;
+	uint8_t chosen = RLE_SCHED_NONE;
+	uint8_t frag_id;
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		if (sched->conf.quantum[frag_id] != 0 ||
+		    rle_ctx_is_free(transmitter->free_ctx, frag_id)) {
+			continue;
+		}
+		if (sched->conf.policy == RLE_SCHED_PRIORITY) {
+			chosen = frag_id;
+			break;
+		}
+		/* earliest deadline first, then oldest SDU first, then lowest ID first */
+		if (chosen == RLE_SCHED_NONE || sched->deadline[frag_id] < sched->deadline[chosen] ||
+		    (sched->deadline[frag_id] == sched->deadline[chosen] &&
+		     sched->enqueue_time[frag_id] < sched->enqueue_time[chosen])) {
+			chosen = frag_id;
+		}
+	}
+
+	return chosen;
+}
+
+static uint8_t rle_sched_pick_bulk(struct rle_transmitter *const transmitter,
+                                   const size_t burst_size)
+{
+	struct rle_sched *const sched = &transmitter->sched;
+	uint8_t chosen = RLE_SCHED_NONE;
+	bool is_busy = false;
+	uint8_t frag_id;
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		if (sched->conf.quantum[frag_id] == 0) {
+			continue;
+		}
+		if (rle_ctx_is_free(transmitter->free_ctx, frag_id)) {
+			/* an idle context keeps no credit */
+			sched->deficit[frag_id] = 0;
+		} else {
+			is_busy = true;
+		}
+	}
+	if (!is_busy) {
+		goto out;
+	}
+
+	/* visit the bulk contexts in turn, each one gets its quantum once per visit and is served
+	 * while in credit; the last PPDU may overdraw it, the next visits make up for it */
+	while (chosen == RLE_SCHED_NONE) {
+		frag_id = sched->drr_cur;
+
+		if (sched->conf.quantum[frag_id] != 0 &&
+		    !rle_ctx_is_free(transmitter->free_ctx, frag_id)) {
+			if (!sched->drr_granted) {
+				sched->deficit[frag_id] += (int64_t)sched->conf.quantum[frag_id];
+				sched->drr_granted = true;
+			}
+			if (sched->deficit[frag_id] > 0) {
+				chosen = frag_id;
+				break;
+			}
+		}
+
+		sched->drr_cur = (frag_id + 1) % RLE_MAX_FRAG_NUMBER;
+		sched->drr_granted = false;
+	}
+
+	{
+		const size_t queue_size = rle_transmitter_stats_get_queue_size(transmitter, chosen);
+
+		sched->deficit[chosen] -= (int64_t)(burst_size < queue_size ? burst_size : queue_size);
+	}
+
+out:
+	return chosen;
+}
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+void rle_sched_init(struct rle_sched *const sched)
+{
+	memset(sched, 0, sizeof(struct rle_sched));
+	sched->conf.policy = RLE_SCHED_PRIORITY;
+	memset(sched->deadline, 0xff, sizeof(sched->deadline));
+}
+
+enum rle_encap_status rle_encapsulate_timed(struct rle_transmitter *const transmitter,
+                                            const struct rle_sdu *const sdu,
+                                            const uint8_t frag_id,
+                                            const uint64_t enqueue_time,
+                                            const uint64_t deadline)
+{
+	enum rle_encap_status status;
+
+	status = rle_encapsulate(transmitter, sdu, frag_id);
+	if (status == RLE_ENCAP_OK) {
+		rle_sched_set_sdu(&transmitter->sched, frag_id, enqueue_time, deadline);
+	}
+
+	return status;
+}
+
+int rle_transmitter_sched_set(struct rle_transmitter *const transmitter,
+                              const struct rle_sched_config *const conf)
+{
+	int status = 1;
+
+	if (transmitter == NULL || conf == NULL ||
+	    (conf->policy != RLE_SCHED_PRIORITY && conf->policy != RLE_SCHED_EDF)) {
+		goto out;
+	}
+
+	memcpy(&transmitter->sched.conf, conf, sizeof(struct rle_sched_config));
+	memset(transmitter->sched.deficit, 0, sizeof(transmitter->sched.deficit));
+	transmitter->sched.drr_cur = 0;
+	transmitter->sched.drr_granted = false;
+
+	status = 0;
+
+out:
+	return status;
+}
+
+int rle_transmitter_sched_next(struct rle_transmitter *const transmitter,
+                               const uint64_t now,
+                               const size_t burst_size,
+                               uint8_t *const frag_id)
+{
+	int status = 1;
+	uint8_t chosen;
+
+	if (transmitter == NULL || frag_id == NULL) {
+		goto out;
+	}
+
+	rle_sched_expire(transmitter, now);
+
+	chosen = rle_sched_pick_realtime(transmitter);
+	if (chosen == RLE_SCHED_NONE) {
+		chosen = rle_sched_pick_bulk(transmitter, burst_size);
+	}
+	if (chosen == RLE_SCHED_NONE) {
+		goto out;
+	}
+
+	*frag_id = chosen;
+	status = 0;
+
+out:
+	return status;
+}
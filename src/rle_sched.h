@@ -0,0 +1,106 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   rle_sched.h
+ * @brief  Definition of the RLE scheduler of the fragmentation contexts of a transmitter
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#ifndef __RLE_SCHED_H__
+#define __RLE_SCHED_H__
+
+#ifndef __KERNEL__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#else
+
+#include <linux/types.h>
+
+#endif
+
+#include "rle.h"
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PUBLIC STRUCTS AND TYPEDEFS ----------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** Scheduler of the fragmentation contexts of a transmitter */
+struct rle_sched {
+	/** The configuration of the scheduler */
+	struct rle_sched_config conf;
+	/** Enqueue time of the SDU of each context */
+	uint64_t enqueue_time[RLE_MAX_FRAG_NUMBER];
+	/** Deadline of the SDU of each context, RLE_SDU_NO_DEADLINE for none */
+	uint64_t deadline[RLE_MAX_FRAG_NUMBER];
+	/** DRR deficit of each bulk context, negative when overdrawn by the last PPDU */
+	int64_t deficit[RLE_MAX_FRAG_NUMBER];
+	/** Bulk context visited by the DRR */
+	uint8_t drr_cur;
+	/** Whether the context visited by the DRR got its quantum for this visit */
+	bool drr_granted;
+};
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------------- PUBLIC FUNCTIONS ---------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief         Initialize a scheduler, all contexts real-time with strict priority.
+ *
+ * @param[out]    sched          The scheduler.
+ */
+void rle_sched_init(struct rle_sched *const sched);
+
+/**
+ * @brief         Set the times of the SDU of a context.
+ *
+ * @param[in,out] sched          The scheduler.
+ * @param[in]     frag_id        The context of the SDU.
+ * @param[in]     enqueue_time   The time at which the SDU was queued.
+ * @param[in]     deadline       The latest time to send its first fragment.
+ */
+static inline void rle_sched_set_sdu(struct rle_sched *const sched,
+                                     const uint8_t frag_id,
+                                     const uint64_t enqueue_time,
+                                     const uint64_t deadline);
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+static inline void rle_sched_set_sdu(struct rle_sched *const sched,
+                                     const uint8_t frag_id,
+                                     const uint64_t enqueue_time,
+                                     const uint64_t deadline)
+{
+	sched->enqueue_time[frag_id] = enqueue_time;
+	sched->deadline[frag_id] = deadline;
+}
+
+
+#endif /* __RLE_SCHED_H__ */
@@ -0,0 +1,376 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   rle_stats_shm.c
+ * @brief  Export of the RLE statistics in a shared-memory region
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#include "rle.h"
+#include "constants.h"
+
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PRIVATE CONSTANTS AND MACROS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+#define MODULE_ID RLE_MOD_ID_STATS_SHM
+
+/** Max length of a shared-memory object name, including the trailing '\0' */
+#define RLE_STATS_SHM_NAME_MAX 256
+
+/** Reads of a region retried before giving up on an update never completed */
+#define RLE_STATS_SHM_READ_RETRIES 1000000
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*--------------------------------- PRIVATE STRUCTS AND TYPEDEFS ---------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/** Handle on a shared-memory statistics region */
+struct rle_stats_shm {
+	struct rle_stats_shm_region *region;   /**< The mapped region */
+	bool is_owner;                         /**< Whether the region was created by us */
+	char name[RLE_STATS_SHM_NAME_MAX];     /**< The name of the shared-memory object */
+};
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------- PRIVATE FUNCTIONS ----------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+/**
+ * @brief         Allocate a region handle and copy the object name in it.
+ *
+ * @param[in]     name            The name of the shared-memory object.
+ *
+ * @return        The handle if OK, else NULL.
+ */
+static struct rle_stats_shm * rle_stats_shm_new(const char *const name);
+
+/**
+ * @brief         Start an update of the region: readers retry until the end of the update.
+ *
+ * @param[in,out] region          The region to update.
+ */
+static void rle_stats_shm_write_begin(struct rle_stats_shm_region *const region);
+
+/**
+ * @brief         End an update of the region.
+ *
+ * @param[in,out] region          The updated region.
+ */
+static void rle_stats_shm_write_end(struct rle_stats_shm_region *const region);
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*----------------------------------- PRIVATE FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+static struct rle_stats_shm * rle_stats_shm_new(const char *const name)
+{
+	struct rle_stats_shm *shm = NULL;
+
+	if (name == NULL || strlen(name) >= RLE_STATS_SHM_NAME_MAX) {
+		RLE_ERR("invalid shared-memory object name");
+		goto error;
+	}
+
+	shm = (struct rle_stats_shm *)MALLOC(sizeof(struct rle_stats_shm));
+	if (shm == NULL) {
+		RLE_ERR("failed to allocate shared-memory statistics handle");
+		goto error;
+	}
+
+	shm->region = NULL;
+	shm->is_owner = false;
+	strcpy(shm->name, name);
+
+error:
+	return shm;
+}
+
+static void rle_stats_shm_write_begin(struct rle_stats_shm_region *const region)
+{
+	__atomic_store_n(&region->seq, region->seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static void rle_stats_shm_write_end(struct rle_stats_shm_region *const region)
+{
+	__atomic_store_n(&region->seq, region->seq + 1, __ATOMIC_RELEASE);
+}
+
+
+/*------------------------------------------------------------------------------------------------*/
+/*------------------------------------ PUBLIC FUNCTIONS CODE -------------------------------------*/
+/*------------------------------------------------------------------------------------------------*/
+
+struct rle_stats_shm * rle_stats_shm_create(const char *const name)
+{
+	struct rle_stats_shm *shm;
+	void *addr;
+	int fd;
+
+	shm = rle_stats_shm_new(name);
+	if (shm == NULL) {
+		goto error;
+	}
+
+	fd = shm_open(name, O_CREAT | O_RDWR | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP);
+	if (fd < 0) {
+		RLE_ERR("failed to create shared-memory object '%s'", name);
+		goto free_shm;
+	}
+
+	if (ftruncate(fd, sizeof(struct rle_stats_shm_region)) != 0) {
+		RLE_ERR("failed to resize shared-memory object '%s'", name);
+		close(fd);
+		goto unlink_shm;
+	}
+
+	addr = mmap(NULL, sizeof(struct rle_stats_shm_region), PROT_READ | PROT_WRITE, MAP_SHARED,
+	            fd, 0);
+	close(fd);
+	if (addr == MAP_FAILED) {
+		RLE_ERR("failed to map shared-memory object '%s'", name);
+		goto unlink_shm;
+	}
+
+	shm->region = (struct rle_stats_shm_region *)addr;
+	shm->is_owner = true;
+
+	/* the object is zeroed by ftruncate, publish the header last */
+	shm->region->size = sizeof(struct rle_stats_shm_region);
+	shm->region->version = RLE_STATS_SHM_VERSION;
+	__atomic_store_n(&shm->region->magic, RLE_STATS_SHM_MAGIC, __ATOMIC_RELEASE);
+
+	return shm;
+
+unlink_shm:
+	shm_unlink(name);
+free_shm:
+	FREE(shm);
+error:
+	return NULL;
+}
+
+struct rle_stats_shm * rle_stats_shm_attach(const char *const name)
+{
+	struct rle_stats_shm *shm;
+	struct stat st;
+	void *addr;
+	int fd;
+
+	shm = rle_stats_shm_new(name);
+	if (shm == NULL) {
+		goto error;
+	}
+
+	fd = shm_open(name, O_RDONLY, 0);
+	if (fd < 0) {
+		RLE_ERR("failed to open shared-memory object '%s'", name);
+		goto free_shm;
+	}
+
+	if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(struct rle_stats_shm_region)) {
+		RLE_ERR("shared-memory object '%s' is too small", name);
+		close(fd);
+		goto free_shm;
+	}
+
+	addr = mmap(NULL, sizeof(struct rle_stats_shm_region), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (addr == MAP_FAILED) {
+		RLE_ERR("failed to map shared-memory object '%s'", name);
+		goto free_shm;
+	}
+
+	shm->region = (struct rle_stats_shm_region *)addr;
+
+	if (__atomic_load_n(&shm->region->magic, __ATOMIC_ACQUIRE) != RLE_STATS_SHM_MAGIC ||
+	    shm->region->version != RLE_STATS_SHM_VERSION ||
+	    shm->region->size != sizeof(struct rle_stats_shm_region)) {
+		RLE_ERR("shared-memory object '%s' has an unsupported layout", name);
+		munmap(addr, sizeof(struct rle_stats_shm_region));
+		goto free_shm;
+	}
+
+	return shm;
+
+free_shm:
+	FREE(shm);
+error:
+	return NULL;
+}
+
+void rle_stats_shm_destroy(struct rle_stats_shm **const shm)
+{
+	if (shm == NULL || *shm == NULL) {
+		goto out;
+	}
+
+	munmap((*shm)->region, sizeof(struct rle_stats_shm_region));
+	if ((*shm)->is_owner) {
+		shm_unlink((*shm)->name);
+	}
+
+	FREE(*shm);
+	*shm = NULL;
+
+out:
+	return;
+}
+
+int rle_stats_shm_publish_transmitter(struct rle_stats_shm *const shm,
+                                      const struct rle_transmitter *const transmitter)
+{
+	struct rle_stats_shm_transmitter *out;
+	struct rle_transmitter_stats stats;
+	int status = 1;
+	uint8_t frag_id;
+
+	if (shm == NULL || !shm->is_owner || transmitter == NULL) {
+		goto out;
+	}
+
+	out = &shm->region->data.transmitter;
+
+	rle_stats_shm_write_begin(shm->region);
+
+	memset(&out->total, 0, sizeof(struct rle_transmitter_stats));
+	out->total_sdus_expired = 0;
+	out->total_bytes_expired = 0;
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		if (rle_transmitter_stats_get_counters(transmitter, frag_id, &stats) != 0) {
+			memset(&stats, 0, sizeof(struct rle_transmitter_stats));
+		}
+		out->ctx[frag_id] = stats;
+		out->queue_size[frag_id] = rle_transmitter_stats_get_queue_size(transmitter, frag_id);
+		out->sdus_expired[frag_id] =
+			rle_transmitter_stats_get_counter_sdus_expired(transmitter, frag_id);
+		out->bytes_expired[frag_id] =
+			rle_transmitter_stats_get_counter_bytes_expired(transmitter, frag_id);
+
+		out->total.sdus_in += stats.sdus_in;
+		out->total.sdus_sent += stats.sdus_sent;
+		out->total.sdus_dropped += stats.sdus_dropped;
+		out->total.bytes_in += stats.bytes_in;
+		out->total.bytes_sent += stats.bytes_sent;
+		out->total.bytes_dropped += stats.bytes_dropped;
+		out->total_sdus_expired += out->sdus_expired[frag_id];
+		out->total_bytes_expired += out->bytes_expired[frag_id];
+	}
+	out->updates++;
+
+	rle_stats_shm_write_end(shm->region);
+
+	status = 0;
+
+out:
+	return status;
+}
+
+int rle_stats_shm_publish_receiver(struct rle_stats_shm *const shm,
+                                   const struct rle_receiver *const receiver)
+{
+	struct rle_stats_shm_receiver *out;
+	struct rle_receiver_stats stats;
+	int status = 1;
+	uint8_t frag_id;
+
+	if (shm == NULL || !shm->is_owner || receiver == NULL) {
+		goto out;
+	}
+
+	out = &shm->region->data.receiver;
+
+	rle_stats_shm_write_begin(shm->region);
+
+	memset(&out->total, 0, sizeof(struct rle_receiver_stats));
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		if (rle_receiver_stats_get_counters(receiver, frag_id, &stats) != 0) {
+			memset(&stats, 0, sizeof(struct rle_receiver_stats));
+		}
+		out->ctx[frag_id] = stats;
+		out->queue_size[frag_id] = rle_receiver_stats_get_queue_size(receiver, frag_id);
+
+		out->total.sdus_received += stats.sdus_received;
+		out->total.sdus_reassembled += stats.sdus_reassembled;
+		out->total.sdus_dropped += stats.sdus_dropped;
+		out->total.sdus_lost += stats.sdus_lost;
+		out->total.bytes_received += stats.bytes_received;
+		out->total.bytes_reassembled += stats.bytes_reassembled;
+		out->total.bytes_dropped += stats.bytes_dropped;
+	}
+	if (rle_receiver_stats_get_errors(receiver, &out->errors) != 0) {
+		memset(&out->errors, 0, sizeof(struct rle_receiver_error_stats));
+	}
+	out->updates++;
+
+	rle_stats_shm_write_end(shm->region);
+
+	status = 0;
+
+out:
+	return status;
+}
+
+int rle_stats_shm_read(const struct rle_stats_shm *const shm,
+                       struct rle_stats_shm_snapshot *const snapshot)
+{
+	const struct rle_stats_shm_region *region;
+	uint32_t seq_begin;
+	uint32_t seq_end = 0;
+	size_t retries = RLE_STATS_SHM_READ_RETRIES;
+
+	if (shm == NULL || snapshot == NULL) {
+		return 1;
+	}
+
+	region = shm->region;
+
+	do {
+		/* the publishing process may have died in the middle of an update */
+		if (retries-- == 0) {
+			return 1;
+		}
+		seq_begin = __atomic_load_n(&region->seq, __ATOMIC_ACQUIRE);
+		if (seq_begin & 1) {
+			/* update in progress */
+			continue;
+		}
+		memcpy(snapshot, &region->data, sizeof(struct rle_stats_shm_snapshot));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		seq_end = __atomic_load_n(&region->seq, __ATOMIC_RELAXED);
+	} while ((seq_begin & 1) || seq_begin != seq_end);
+
+	return 0;
+}
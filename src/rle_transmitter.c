@@ -42,10 +42,6 @@
 
 #endif
 
-#ifdef TIME_DEBUG
-#include <sys/time.h>
-#endif
-
 /*------------------------------------------------------------------------------------------------*/
 /*--------------------------------- PRIVATE CONSTANTS AND MACROS ---------------------------------*/
 /*------------------------------------------------------------------------------------------------*/
@@ -107,8 +103,16 @@ static void set_free_frag_ctx(struct rle_transmitter *const _this, const size_t
 /*------------------------------------------------------------------------------------------------*/
 
 struct rle_transmitter * rle_transmitter_new(const struct rle_config *const conf)
+{
+	return rle_transmitter_new_with_allocator(conf, NULL);
+}
+
+struct rle_transmitter * rle_transmitter_new_with_allocator(const struct rle_config *const conf,
+                                                            const struct rle_allocator *const
+                                                            allocator)
 {
 	struct rle_transmitter *transmitter = NULL;
+	struct rle_allocator the_allocator;
 	size_t i;
 
 	if (!rle_config_check(conf)) {
@@ -116,17 +120,28 @@ struct rle_transmitter * rle_transmitter_new(const struct rle_config *const conf
 		goto error;
 	}
 
-	transmitter = (struct rle_transmitter *)MALLOC(sizeof(struct rle_transmitter));
+	if (allocator == NULL) {
+		rle_allocator_get(&the_allocator);
+	} else if (allocator->alloc == NULL || allocator->free == NULL) {
+		RLE_ERR("failed to created RLE transmitter: invalid allocator");
+		goto error;
+	} else {
+		the_allocator = *allocator;
+	}
+
+	transmitter = (struct rle_transmitter *)rle_allocator_alloc(&the_allocator,
+	                                                            sizeof(struct rle_transmitter));
 	if (!transmitter) {
 		RLE_ERR("allocating transmitter module failed\n");
 		goto error;
 	}
+	transmitter->allocator = the_allocator;
 
 	/* initialize fragmentation contexts */
-	memset(transmitter->rle_ctx_man, 0, RLE_MAX_FRAG_NUMBER * sizeof(struct rle_ctx_mngt));
+	rle_zero(transmitter->rle_ctx_man, RLE_MAX_FRAG_NUMBER * sizeof(struct rle_ctx_mngt));
 	for (i = 0; i < RLE_MAX_FRAG_NUMBER; ++i) {
 		struct rle_ctx_mngt *const ctx_man = &transmitter->rle_ctx_man[i];
-		if (rle_ctx_init_frag_buf(ctx_man) != C_OK) {
+		if (rle_ctx_init_frag_buf(ctx_man, &transmitter->allocator) != C_OK) {
 			RLE_ERR("failed to allocate memory for frag context with ID %zu", i);
 			goto free_ctxts;
 		}
@@ -135,6 +150,12 @@ struct rle_transmitter * rle_transmitter_new(const struct rle_config *const conf
 	}
 
 	transmitter->free_ctx = 0;
+	memset(&transmitter->fpdu_stats, 0, sizeof(struct rle_transmitter_fpdu_stats));
+	rle_sched_init(&transmitter->sched);
+	transmitter->latency = NULL;
+	transmitter->trace.callback = NULL;
+	transmitter->trace.priv = NULL;
+	transmitter->trace.level = RLE_LOG_LEVEL_DEBUG;
 
 	memcpy(&transmitter->conf, conf, sizeof(struct rle_config));
 
@@ -144,16 +165,71 @@ free_ctxts:
 	for (i = 0; i < RLE_MAX_FRAG_NUMBER; ++i) {
 		struct rle_ctx_mngt *const ctx_man = &transmitter->rle_ctx_man[i];
 		if (ctx_man->buff != NULL) {
-			rle_ctx_destroy_frag_buf(ctx_man);
+			rle_ctx_destroy_frag_buf(ctx_man, &the_allocator);
 		}
 	}
-	FREE(transmitter);
+	rle_allocator_free(&the_allocator, transmitter);
 error:
 	return NULL;
 }
 
+struct rle_transmitter * rle_transmitter_new_on_node(const struct rle_config *const conf,
+                                                     const int node,
+                                                     const unsigned int flags)
+{
+	struct rle_transmitter *transmitter = NULL;
+
+	if (rle_transmitter_new_bulk(conf, 1, node, flags, &transmitter) != 0) {
+		RLE_ERR("failed to created RLE transmitter on NUMA node %d", node);
+	}
+
+	return transmitter;
+}
+
+int rle_transmitter_new_bulk(const struct rle_config *const conf, const size_t nr, const int node,
+                             const unsigned int flags, struct rle_transmitter *transmitters[])
+{
+	const size_t len = rle_region_block_len(sizeof(struct rle_transmitter)) +
+	                    RLE_MAX_FRAG_NUMBER * rle_region_block_len(sizeof(struct rle_frag_buf));
+	struct rle_allocator allocator;
+	int status = 1;
+	size_t i;
+
+	if (transmitters == NULL || nr == 0 || nr > SIZE_MAX / len) {
+		RLE_ERR("invalid number of transmitters: %zu", nr);
+		goto out;
+	}
+
+	for (i = 0; i < nr; ++i) {
+		transmitters[i] = NULL;
+	}
+
+	if (rle_region_allocator_new(&allocator, nr * len, node, flags) != C_OK) {
+		RLE_ERR("failed to allocate a region for %zu transmitters", nr);
+		goto out;
+	}
+
+	for (i = 0; i < nr; ++i) {
+		transmitters[i] = rle_transmitter_new_with_allocator(conf, &allocator);
+		if (transmitters[i] == NULL) {
+			RLE_ERR("failed to create RLE transmitter #%zu of %zu", i + 1, nr);
+			rle_transmitter_destroy_bulk(transmitters, i);
+			goto put_region;
+		}
+	}
+
+	status = 0;
+
+put_region:
+	/* the region is now held by the blocks of the transmitters, if any */
+	rle_region_allocator_put(&allocator);
+out:
+	return status;
+}
+
 void rle_transmitter_destroy(struct rle_transmitter **const transmitter)
 {
+	struct rle_allocator allocator;
 	size_t i;
 
 	if (!transmitter) {
@@ -165,13 +241,18 @@ void rle_transmitter_destroy(struct rle_transmitter **const transmitter)
 		goto exit_label;
 	}
 
+	/* the transmitter holds its allocator, keep it until the end */
+	allocator = (*transmitter)->allocator;
+
 	for (i = 0; i < RLE_MAX_FRAG_NUMBER; i++) {
 		struct rle_ctx_mngt *const ctx_man = &(*transmitter)->rle_ctx_man[i];
 
-		rle_ctx_destroy_frag_buf(ctx_man);
+		rle_ctx_destroy_frag_buf(ctx_man, &allocator);
 	}
 
-	FREE(*transmitter);
+	rle_latency_del(&allocator, &(*transmitter)->latency);
+
+	rle_allocator_free(&allocator, *transmitter);
 	*transmitter = NULL;
 
 exit_label:
@@ -179,6 +260,22 @@ exit_label:
 	return;
 }
 
+void rle_transmitter_destroy_bulk(struct rle_transmitter *transmitters[], const size_t nr)
+{
+	size_t i;
+
+	if (transmitters == NULL) {
+		goto out;
+	}
+
+	for (i = 0; i < nr; ++i) {
+		rle_transmitter_destroy(&transmitters[i]);
+	}
+
+out:
+	return;
+}
+
 void rle_transmitter_free_context(struct rle_transmitter *const _this, const uint8_t fragment_id)
 {
 	/* set to idle this fragmentation context */
@@ -310,6 +407,40 @@ error:
 	return stat;
 }
 
+uint64_t rle_transmitter_stats_get_counter_sdus_expired(const struct rle_transmitter *const trans,
+                                                        const uint8_t fragment_id)
+{
+	uint64_t stat = 0;
+	const struct rle_ctx_mngt *ctx_man = NULL;
+
+	if (get_transmitter_context(trans, fragment_id, &ctx_man)) {
+		goto error;
+	}
+
+	stat = rle_ctx_get_counter_expired(ctx_man);
+
+error:
+
+	return stat;
+}
+
+uint64_t rle_transmitter_stats_get_counter_bytes_expired(const struct rle_transmitter *const trans,
+                                                         const uint8_t fragment_id)
+{
+	uint64_t stat = 0;
+	const struct rle_ctx_mngt *ctx_man = NULL;
+
+	if (get_transmitter_context(trans, fragment_id, &ctx_man)) {
+		goto error;
+	}
+
+	stat = rle_ctx_get_counter_bytes_expired(ctx_man);
+
+error:
+
+	return stat;
+}
+
 int rle_transmitter_stats_get_counters(const struct rle_transmitter *const transmitter,
                                        const uint8_t fragment_id,
                                        struct rle_transmitter_stats *const stats)
@@ -355,3 +486,155 @@ error:
 
 	return;
 }
+
+void rle_transmitter_stats_add_fpdu(struct rle_transmitter *const transmitter,
+                                    const size_t label_size,
+                                    const size_t fpdu_current_pos,
+                                    const size_t fpdu_remaining_size)
+{
+	struct rle_transmitter_fpdu_stats *stats;
+
+	if (transmitter == NULL) {
+		return;
+	}
+
+	stats = &transmitter->fpdu_stats;
+	stats->fpdus++;
+	stats->fpdu_bytes += fpdu_current_pos + fpdu_remaining_size;
+	stats->label_bytes += label_size;
+	stats->padding_bytes += fpdu_remaining_size;
+}
+
+int rle_transmitter_stats_get_link(const struct rle_transmitter *const transmitter,
+                                   struct rle_link_stats *const stats)
+{
+	int status = 1;
+	size_t frag_id;
+
+	if (transmitter == NULL || stats == NULL) {
+		goto error;
+	}
+
+	memset(&stats->total, 0, sizeof(struct rle_link_ctx_stats));
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		const struct rle_link_ctx_stats *const ctx =
+			&transmitter->rle_ctx_man[frag_id].link_stats;
+		size_t i;
+
+		memcpy(&stats->ctx[frag_id], ctx, sizeof(struct rle_link_ctx_stats));
+
+		for (i = 0; i < RLE_PPDU_TYPE_NB; ++i) {
+			stats->total.ppdus[i] += ctx->ppdus[i];
+		}
+		stats->total.sdu_bytes += ctx->sdu_bytes;
+		stats->total.ppdu_hdr_bytes += ctx->ppdu_hdr_bytes;
+		stats->total.alpdu_hdr_bytes += ctx->alpdu_hdr_bytes;
+		stats->total.trailer_bytes += ctx->trailer_bytes;
+		for (i = 0; i < RLE_PPDUS_PER_SDU_BUCKETS; ++i) {
+			stats->total.ppdus_per_sdu[i] += ctx->ppdus_per_sdu[i];
+		}
+	}
+
+	stats->fpdus = transmitter->fpdu_stats.fpdus;
+	stats->fpdu_bytes = transmitter->fpdu_stats.fpdu_bytes;
+	stats->label_bytes = transmitter->fpdu_stats.label_bytes;
+	stats->padding_bytes = transmitter->fpdu_stats.padding_bytes;
+
+	status = 0;
+
+error:
+	return status;
+}
+
+void rle_transmitter_stats_reset_link(struct rle_transmitter *const transmitter)
+{
+	size_t frag_id;
+
+	if (transmitter == NULL) {
+		return;
+	}
+
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		memset(&transmitter->rle_ctx_man[frag_id].link_stats, 0,
+		       sizeof(struct rle_link_ctx_stats));
+	}
+	memset(&transmitter->fpdu_stats, 0, sizeof(struct rle_transmitter_fpdu_stats));
+}
+
+int rle_transmitter_latency_enable(struct rle_transmitter *const transmitter)
+{
+	int status = 1;
+
+	if (transmitter == NULL) {
+		goto error;
+	}
+
+	if (transmitter->latency == NULL) {
+		transmitter->latency = rle_latency_new(&transmitter->allocator);
+		if (transmitter->latency == NULL) {
+			RLE_ERR("failed to allocate latency histograms");
+			goto error;
+		}
+	}
+
+	transmitter->latency->is_enabled = true;
+
+	status = 0;
+
+error:
+	return status;
+}
+
+void rle_transmitter_latency_disable(struct rle_transmitter *const transmitter)
+{
+	if (transmitter == NULL || transmitter->latency == NULL) {
+		return;
+	}
+
+	transmitter->latency->is_enabled = false;
+}
+
+int rle_transmitter_latency_get_histo(const struct rle_transmitter *const transmitter,
+                                      const enum rle_latency_stage stage,
+                                      const uint8_t fragment_id,
+                                      struct rle_latency_histo *const histo)
+{
+	if (transmitter == NULL) {
+		return 1;
+	}
+
+	return rle_latency_get_histo(transmitter->latency, stage, fragment_id, histo);
+}
+
+void rle_transmitter_latency_reset(struct rle_transmitter *const transmitter)
+{
+	if (transmitter == NULL) {
+		return;
+	}
+
+	rle_latency_reset(transmitter->latency);
+}
+
+void rle_transmitter_set_trace_callback(struct rle_transmitter *const transmitter,
+                                        rle_instance_trace_callback_t callback,
+                                        void *const priv,
+                                        const rle_log_level_t level)
+{
+	if (transmitter == NULL) {
+		return;
+	}
+
+	transmitter->trace.callback = callback;
+	transmitter->trace.priv = priv;
+	transmitter->trace.level = level;
+}
+
+void rle_transmitter_set_trace_level(struct rle_transmitter *const transmitter,
+                                     const rle_log_level_t level)
+{
+	if (transmitter == NULL) {
+		return;
+	}
+
+	transmitter->trace.level = level;
+}
@@ -41,6 +41,8 @@
 
 #include "rle_ctx.h"
 #include "header.h"
+#include "rle_latency.h"
+#include "rle_sched.h"
 
 
 /*------------------------------------------------------------------------------------------------*/
@@ -62,6 +64,14 @@ struct transmitter_link_status {
 	uint64_t counter_bytes;
 };
 
+/** Link efficiency counters of the FPDUs of a transmitter */
+struct rle_transmitter_fpdu_stats {
+	uint64_t fpdus;         /**< Number of FPDUs              */
+	uint64_t fpdu_bytes;    /**< Octets of the FPDUs          */
+	uint64_t label_bytes;   /**< Octets of the payload labels */
+	uint64_t padding_bytes; /**< Octets of padding            */
+};
+
 /**
  * RLE transmitter module used
  * for encapsulation & fragmentation.
@@ -77,6 +87,11 @@ struct rle_transmitter {
 	struct rle_ctx_mngt rle_ctx_man[RLE_MAX_FRAG_NUMBER];
 	struct rle_config conf;
 	uint8_t free_ctx;
+	struct rle_latency *latency; /**< Latency histograms, NULL until first enabled */
+	struct rle_trace trace;      /**< Trace callback of the transmitter */
+	struct rle_allocator allocator; /**< Allocator of the transmitter and its buffers */
+	struct rle_transmitter_fpdu_stats fpdu_stats; /**< Link efficiency counters of the FPDUs */
+	struct rle_sched sched;      /**< Scheduler of the fragmentation contexts */
 };
 
 
@@ -55,6 +55,9 @@
 
 #define MODULE_ID RLE_MOD_ID_TRAILER
 
+/** SDUs whose CRC are computed in one call to compute_crc_lanes */
+#define RLE_CRC32_LANES_CHUNK (2 * RLE_CRC_LANES)
+
 
 /*------------------------------------------------------------------------------------------------*/
 /*------------------------------------ PRIVATE FUNCTIONS CODE ------------------------------------*/
@@ -82,6 +85,31 @@ uint32_t compute_crc32(const struct rle_sdu *const sdu)
 	return crc32;
 }
 
+void compute_crc32_lanes(const struct rle_sdu *const sdus[], const size_t nr, uint32_t crcs[])
+{
+	const unsigned char *data[RLE_CRC32_LANES_CHUNK];
+	size_t lengths[RLE_CRC32_LANES_CHUNK];
+	size_t first;
+
+	for (first = 0; first < nr; first += RLE_CRC32_LANES_CHUNK) {
+		const size_t chunk_nr = (nr - first < RLE_CRC32_LANES_CHUNK ?
+		                         nr - first : RLE_CRC32_LANES_CHUNK);
+		size_t i;
+
+		/* the 2-byte protocol types one after the other, then the SDUs side by side */
+		for (i = 0; i < chunk_nr; i++) {
+			const struct rle_sdu *const sdu = sdus[first + i];
+			const uint16_t field_value = sdu->protocol_type;
+
+			crcs[first + i] = compute_crc((const unsigned char *)&field_value,
+			                              RLE_PROTO_TYPE_FIELD_SIZE_UNCOMP, RLE_CRC_INIT);
+			data[i] = sdu->buffer;
+			lengths[i] = sdu->size;
+		}
+		compute_crc_lanes(data, lengths, &crcs[first], chunk_nr);
+	}
+}
+
 
 /*------------------------------------------------------------------------------------------------*/
 /*------------------------------------- PUBLIC FUNCTIONS CODE-------------------------------------*/
@@ -131,10 +159,10 @@ int check_alpdu_trailer(const rle_alpdu_trailer_t *const trailer,
 		          reassembled_sdu->protocol_type, ntohl(trailer->crc_trailer.crc),
 		          expected_crc);
 		if (trailer->crc_trailer.crc != expected_crc) {
-			RLE_ERR("wrong CRC for %zu-byte SDU of protocol 0x%02x: 0x%08x received "
-			        "while 0x%08x expected", reassembled_sdu->size,
-			        reassembled_sdu->protocol_type, ntohl(trailer->crc_trailer.crc),
-			        expected_crc);
+			RLE_DEBUG("wrong CRC for %zu-byte SDU of protocol 0x%02x: 0x%08x received "
+			          "while 0x%08x expected", reassembled_sdu->size,
+			          reassembled_sdu->protocol_type, ntohl(trailer->crc_trailer.crc),
+			          expected_crc);
 			status = 1;
 			*lost_packets = 1;
 		}
@@ -157,8 +185,8 @@ int check_alpdu_trailer(const rle_alpdu_trailer_t *const trailer,
 					status = 1;
 					*lost_packets = (received_seq_no - next_seq_no) %
 					                RLE_MAX_SEQ_NO;
-					RLE_ERR("sequence number inconsistency: received %u, "
-					        "expected %u", received_seq_no, next_seq_no);
+					RLE_DEBUG("sequence number inconsistency: received %u, "
+					          "expected %u", received_seq_no, next_seq_no);
 				} else {
 					RLE_WARN("sequence number null, supposing relog: received "
 					         "%u, expected %u", received_seq_no, next_seq_no);
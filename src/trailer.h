@@ -112,5 +112,17 @@ int check_alpdu_trailer(const rle_alpdu_trailer_t *const trailer,
 uint32_t compute_crc32(const struct rle_sdu *const sdu)
 __attribute__((warn_unused_result, nonnull(1)));
 
+/**
+ * @brief Compute the CRC of several SDUs for CRC ALPDU trailers, side by side
+ *
+ * @param sdus  the SDUs to compute a CRC for
+ * @param nr    the number of SDUs
+ * @param crcs  the computed CRC32, the same as \ref compute_crc32 ones
+ *
+ * @ingroup RLE trailer.
+ */
+void compute_crc32_lanes(const struct rle_sdu *const sdus[], const size_t nr, uint32_t crcs[])
+__attribute__((nonnull(1, 3)));
+
 
 #endif /* __TRAILER_H__ */
@@ -147,6 +147,46 @@ bool test_decap_wrong_crc(void);
  */
 bool test_decap_interlaced_reassembly(void);
 
+/**
+ * @brief Test the decapsulation of FPDUs received by chunks
+ *
+ * Decapsulate the same FPDUs whole and by chunks of various sizes, and compare the SDUs.
+ *
+ * @return        true if the SDUs are the same, else false
+ */
+bool test_decap_stream(void);
+
+/**
+ * @brief Test the payload label filter of a receiver
+ *
+ * The FPDUs addressed to another terminal are dropped and counted without disturbing the
+ * reassembly, and the masks of 6-byte labels are applied.
+ *
+ * @return        true if only the FPDUs of other terminals are filtered, else false
+ */
+bool test_decap_label_filter(void);
+
+/**
+ * @brief Test the indexing of the PPDUs of a FPDU before their decapsulation
+ *
+ * Check a FPDU with more PPDUs than indexed at once, and that a FPDU with a wrong length is
+ * dropped before any of its PPDUs updates a context.
+ *
+ * @return        true if the PPDUs are indexed and the malformed FPDU dropped, else false
+ */
+bool test_decap_index(void);
+
+/**
+ * @brief Test the decapsulation of SDUs packed in an arena
+ *
+ * The SDUs of two FPDUs, one of them fragmented, are gathered in arenas too short or short of
+ * descriptors, the FPDUs being resumed each time an arena is full. A SDU larger than an empty
+ * arena is dropped.
+ *
+ * @return        true if all SDUs are found in the arenas, else false
+ */
+bool test_decap_arena(void);
+
 /**
  * @brief         All the Decapsulation tests
  *
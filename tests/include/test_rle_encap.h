@@ -63,6 +63,26 @@ bool test_encap_too_big(void);
  */
 bool test_encap_inv_config(void);
 
+/**
+ * @brief         Encapsulation test of a SDU in place, with headroom and tailroom.
+ *
+ *                Encapsulate a Ethernet/VLAN/IP SDU in place in a buffer with headroom and
+ *                tailroom, compare its PPDUs to the ones of a copied SDU, and decapsulate them.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_encap_in_place(void);
+
+/**
+ * @brief         Encapsulation test of several SDUs in bulk.
+ *
+ *                Encapsulate IMIX SDUs with ALPDU CRC in bulk and one by one, and compare their
+ *                PPDUs. Stop a bulk at a context already in use.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_encap_bulk(void);
+
 /**
  * @brief         All the Encapsulation tests
  *
@@ -102,6 +102,151 @@ bool test_rle_allocation_f_buff(void);
  */
 bool test_rle_destruction_f_buff(void);
 
+/**
+ * @brief         Test the latency histograms
+ *
+ *                Encapsulate, fragment, pack and decapsulate SDUs with latency enabled, then
+ *                check the recorded stages, the per-context accounting and the reset.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_rle_latency(void);
+
+/**
+ * @brief         Test the shared-memory statistics export
+ *
+ *                Publish the counters of a transmitter and a receiver, then read them back
+ *                through a read-only mapping of the region.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_rle_stats_shm(void);
+
+/**
+ * @brief         Test the per-instance trace callbacks
+ *
+ *                Decapsulate FPDUs with a receiver callback, check its runtime level and the
+ *                fallback to the global callback.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_rle_trace_callback(void);
+
+/**
+ * @brief         Test the decapsulation error counters
+ *
+ *                Decapsulate malformed FPDUs, check the typed error counters, the rate limiting
+ *                of the error traces and the reset of the counters.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_rle_decap_errors(void);
+
+/**
+ * @brief         Test the allocation and zeroing audit mode
+ *
+ *                Create a transmitter and a receiver with a counting allocator, replay a trace of
+ *                SDUs through encapsulation, fragmentation, packing and decapsulation, and check
+ *                that the steady state does not allocate and zeroes a bounded amount of memory per
+ *                SDU.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_rle_alloc_audit(void);
+
+/**
+ * @brief         Test the per-instance allocators and the NUMA placement of the instances
+ *
+ *                Create instances with their own allocator, then on NUMA node 0 with and without
+ *                huge pages, and transmit a fragmented SDU through them.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_rle_instance_placement(void);
+
+/**
+ * @brief         Test the bulk creation and destruction of instances
+ *
+ *                Create transmitters and receivers in bulk, transmit a fragmented SDU through
+ *                each pair, then destroy one pair alone and the others in bulk.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_rle_bulk_instances(void);
+
+/**
+ * @brief         Test the estimation of the PPDUs of a SDU
+ *
+ *                Estimate then fragment SDUs of many lengths and protocol types over sequences
+ *                of bursts, with several configurations, and compare the PPDUs byte for byte.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_rle_fragment_estimate(void);
+
+/**
+ * @brief         Test the plan of the PPDUs over several FPDUs
+ *
+ *                Send SDUs through superframes of FPDUs of several sizes, first-fit, as planned
+ *                by the heuristic and as planned by the search, and check that the plans are
+ *                followed, the SDUs received and the overhead not worse than first-fit.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_rle_pack_plan(void);
+
+/**
+ * @brief         Test the link efficiency statistics of a transmitter
+ *
+ *                Send SDUs of several lengths in labelled FPDUs, one PPDU per FPDU, and compare
+ *                the octets and the PPDUs accounted with the estimates of the fragmentation.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_rle_link_stats(void);
+
+/**
+ * @brief         Test the scheduler of the fragmentation contexts of a transmitter
+ *
+ *                Check strict priority and earliest deadline first between real-time contexts,
+ *                the drop of the expired SDUs not started yet, and deficit round robin between
+ *                bulk contexts.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_rle_sched(void);
+
+/**
+ * @brief         Test the codec of the PPDU headers
+ *
+ *                Encode the PPDU headers of each type, compare them to their encoding in network
+ *                byte order, and decode them back.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_rle_ppdu_hdr_codec(void);
+
+/**
+ * @brief         Test the FPDU traces
+ *
+ *                Write records of several lengths in a trace, read them back through the
+ *                mapping, then read a trace left without index and with a truncated record.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_rle_fpdu_trace(void);
+
+/**
+ * @brief         Checkpoint and restore of transmitters and receivers.
+ *
+ *                SDUs partially sent and partially received, one of them encapsulated in place,
+ *                are delivered by standby transmitter and receiver restored from checkpoints,
+ *                without sequence number or CRC errors.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_rle_checkpoint(void);
+
 /* Further tests can be done here, especially to check fragmentation and reassembly buffers. */
 
 
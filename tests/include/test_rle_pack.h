@@ -52,6 +52,15 @@ bool test_pack_invalid_ppdu(void);
  */
 bool test_pack_invalid_label(void);
 
+/**
+ * @brief         Packing test in a gather list.
+ *
+ *                Build the same FPDUs by copy and in a gather list, and compare them.
+ *
+ * @return        true if OK, else false.
+ */
+bool test_pack_iov(void);
+
 /**
  * @brief         Packing test in general cases.
  *
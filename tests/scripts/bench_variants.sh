@@ -0,0 +1,59 @@
+#!/bin/bash
+
+if [[ $# -lt 2 ]]; then
+	echo "NAME"
+	echo "	$(basename $0) - Benchmark the plain, LTO and PGO builds of the library"
+	echo "USAGE"
+	echo "	$(basename $0) source_dir work_dir [repeat]"
+	echo "DESCRIPTION"
+	echo "	Build each variant in its own directory of work_dir, run the loopback bridge on"
+	echo "	the non_reg and ipv4 samples with 599-byte FPDUs (the traces are sent repeat"
+	echo "	times, default 2000)"
+	echo "	and print the encapsulation and decapsulation time per SDU of each variant, best"
+	echo "	of 3 runs. The PGO variant is built with LTO too."
+	echo "RETURN"
+	echo "	0 if every variant is benchmarked, 1 otherwise"
+	exit 1
+fi
+
+src_dir="$( cd "${1}" && pwd )"
+mkdir -p "${2}" || exit 1
+work_dir="$( cd "${2}" && pwd )"
+repeat="${3:-2000}"
+jobs="$( nproc 2>/dev/null || echo 1 )"
+samples="${src_dir}/tests/samples"
+flows="${samples}/ipv4/4088.pcap $( find "${samples}/non_reg" -name "*.pcap" )"
+
+build() {
+	mkdir -p "${work_dir}/${1}"
+	( cd "${work_dir}/${1}" && cmake "${src_dir}" -DBUILD_DOC=OFF \
+	                                              ${@:2} \
+	  && make -j${jobs} test_perfs_bridge ) > "${work_dir}/${1}.log" 2>&1
+}
+
+# Best per SDU time of a stage over the runs, from the '=== stage total per-sdu' lines
+best() {
+	grep "^=== ${1} " "${work_dir}/${2}.out" | awk 'NR == 1 || $4 < best { best = $4 }
+	                                               END { printf "%.1f", best }'
+}
+
+build plain -DLTO=OFF -DPGO=OFF || { echo "=== bench: see ${work_dir}/plain.log" ; exit 1 ; }
+build lto -DLTO=ON -DPGO=OFF || { echo "=== bench: see ${work_dir}/lto.log" ; exit 1 ; }
+"$( dirname "$0" )/pgo_build.sh" "${src_dir}" "${work_dir}/pgo" -DLTO=ON || exit 1
+
+for variant in plain lto pgo ; do
+	rm -f "${work_dir}/${variant}.out"
+	for run in 1 2 3 ; do
+		"${work_dir}/${variant}/tests/test_perfs_bridge" --repeat ${repeat} --fpdu 599 \
+			${flows} >> "${work_dir}/${variant}.out" 2>&1 \
+			|| { echo "=== bench: ${variant} failed, see ${work_dir}/${variant}.out" ; exit 1 ; }
+	done
+done
+
+printf "=== %-8s %16s %16s\n" "variant" "encap (ns/sdu)" "decap (ns/sdu)"
+for variant in plain lto pgo ; do
+	printf "=== %-8s %16s %16s\n" ${variant} "$( best encap ${variant} )" \
+	                                      "$( best decap ${variant} )"
+done
+
+exit 0
@@ -0,0 +1,36 @@
+#!/bin/bash
+
+if [[ $# -lt 3 ]]; then
+	echo "NAME"
+	echo "	$(basename $0) - Convert every pcap file from pcap_folder into a FPDU trace"
+	echo "	and run a test_script against the trace"
+	echo "USAGE"
+	echo "	$(basename $0) converter test_script pcap_folder [script_args...]"
+	echo "RETURN"
+	echo "	The total number of failed tests"
+	exit 1
+fi
+
+list_pcaps="$( find ${3} -name "*.pcap" )"
+
+trace_dir="$( mktemp -d )"
+trap "rm -rf ${trace_dir}" EXIT
+
+# Error outputs are collected and counted.
+errors_sum=0
+for pcap_file in ${list_pcaps} ; do
+	trace_file="${trace_dir}/$( basename ${pcap_file} .pcap ).rlet"
+	printf "%-70s" "$(basename $2) $(basename $trace_file): "
+	${1} "${pcap_file}" "${trace_file}" > /dev/null && \
+		${2} ${@:4} "${trace_file}" > /dev/null
+	ret=$?
+	if [ ${ret} -eq 0 ] ; then
+		echo '[PASS]'
+	else
+		echo '[FAIL]'
+		errors_sum=$(( ${errors_sum} + 1 ))
+	fi
+	rm -f "${trace_file}"
+done
+
+exit ${errors_sum}
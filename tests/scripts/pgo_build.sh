@@ -0,0 +1,61 @@
+#!/bin/bash
+
+if [[ $# -lt 2 ]]; then
+	echo "NAME"
+	echo "	$(basename $0) - Build the library with profile-guided optimisation"
+	echo "USAGE"
+	echo "	$(basename $0) source_dir build_dir [cmake_args...]"
+	echo "DESCRIPTION"
+	echo "	Build an instrumented library and the test tools in build_dir, train it on the"
+	echo "	encapsulation and decapsulation workloads of the bundled samples (non_reg, perfs"
+	echo "	and ipv4), then reconfigure build_dir to rebuild it with the profile."
+	echo "RETURN"
+	echo "	0 if the optimised library is built, 1 otherwise"
+	exit 1
+fi
+
+src_dir="$( cd "${1}" && pwd )"
+mkdir -p "${2}" || exit 1
+build_dir="$( cd "${2}" && pwd )"
+jobs="$( nproc 2>/dev/null || echo 1 )"
+tools="test_non_regression test_non_regression_fpdu test_perfs_bridge"
+samples="${src_dir}/tests/samples"
+
+# The profile data is found back from the paths of the objects, so the instrumented and the
+# optimised builds share the same build directory. The new compiler flags rebuild every object.
+configure() {
+	( cd "${build_dir}" && cmake "${src_dir}" -DBUILD_DOC=OFF \
+	                             -DPGO_DIR="${build_dir}/pgo-data" ${@:2} -DPGO=${1} ) \
+		> "${build_dir}/pgo-${1}.log" 2>&1 || return 1
+	for tool in ${tools} ; do
+		make -C "${build_dir}" -j${jobs} ${tool} >> "${build_dir}/pgo-${1}.log" 2>&1 || return 1
+	done
+}
+
+echo "=== pgo: build instrumented"
+rm -rf "${build_dir}/pgo-data"
+configure GENERATE ${@:3} || { echo "=== pgo: see ${build_dir}/pgo-GENERATE.log" ; exit 1 ; }
+
+# The malformed FPDUs of the perfs samples also train the error paths: their status is ignored.
+echo "=== pgo: train"
+for pcap_file in $( find "${samples}/non_reg" -name "*.pcap" ) ; do
+	for frag_size in 2000 50 ; do
+		"${build_dir}/tests/test_non_regression" -f ${frag_size} "${pcap_file}" > /dev/null 2>&1
+	done
+done
+for pcap_file in $( find "${samples}/perfs" "${samples}/non_reg_fpdu" -name "*.pcap" ) ; do
+	"${build_dir}/tests/test_non_regression_fpdu" --ignore-malformed "${pcap_file}" \
+		> /dev/null 2>&1
+done
+"${build_dir}/tests/test_perfs_bridge" --repeat 20 --fpdu 599 "${samples}/ipv4/4088.pcap" \
+	$( find "${samples}/non_reg" -name "*.pcap" ) > /dev/null 2>&1
+
+if ! ls "${build_dir}/pgo-data/"*.gcda > /dev/null 2>&1 ; then
+	echo "=== pgo: no profile recorded in ${build_dir}/pgo-data"
+	exit 1
+fi
+
+echo "=== pgo: rebuild with the profile"
+configure USE ${@:3} || { echo "=== pgo: see ${build_dir}/pgo-USE.log" ; exit 1 ; }
+
+exit 0
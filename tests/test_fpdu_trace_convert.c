@@ -0,0 +1,256 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_fpdu_trace_convert.c
+ * @brief  Convert a PCAP file of FPDUs into a FPDU trace.
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#include "rle.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <inttypes.h>
+#include <assert.h>
+#include <getopt.h>
+#include <pcap/pcap.h>
+#include <pcap.h>
+
+/** The program version */
+#define TEST_VERSION  "RLE FPDU trace converter, version 0.0.1\n"
+
+/** The length (in bytes) of the Ethernet header */
+#define ETHER_HDR_LEN  14U
+
+/** Default Payload Label length, the one of the FPDU samples */
+#define DEFAULT_LABEL_LEN 3
+
+/** Default number of FPDUs per burst */
+#define DEFAULT_BURST_LEN 1
+
+/* prototypes of private functions */
+static void usage(void);
+static void print_log(const int module_id, const int level, const char *const file,
+                      const int line, const char *const func, const char *const message, ...);
+
+/**
+ * @brief Main function for the RLE FPDU trace converter
+ *
+ * @param[in] argc The number of program arguments
+ * @param[in] argv The program arguments
+ *
+ * @return         The unix return code:
+ *                 \li 0 in case of success,
+ *                 \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = EXIT_FAILURE;
+	long label_len = DEFAULT_LABEL_LEN;
+	long burst_len = DEFAULT_BURST_LEN;
+	char errbuf[PCAP_ERRBUF_SIZE];
+	struct rle_fpdu_trace_writer *writer;
+	struct pcap_pkthdr header;
+	const unsigned char *packet;
+	pcap_t *handle;
+	size_t fpdus_nr = 0;
+	size_t skipped_nr = 0;
+
+	while (1) {
+		int c;
+
+		const char short_options[] = "vhl:b:";
+
+		const struct option long_options[] =
+		{
+			{ "label-size", required_argument, NULL, 'l' },
+			{ "burst", required_argument, NULL, 'b' },
+			{ NULL, 0, NULL, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, short_options, long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 'l': /* Payload Label size */
+			assert(optarg != NULL);
+			label_len = atol(optarg);
+			if (label_len < 0 || label_len > UINT8_MAX) {
+				printf("ERROR: label size shall be in [0, %d].\n", UINT8_MAX);
+				goto error;
+			}
+			break;
+
+		case 'b': /* Burst */
+			assert(optarg != NULL);
+			burst_len = atol(optarg);
+			if (burst_len <= 0) {
+				printf("ERROR: burst shall be strictly positive.\n");
+				goto error;
+			}
+			break;
+
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (optind != argc - 2) {
+		fprintf(stderr, "FLOW and TRACE are mandatory parameters\n\n");
+		usage();
+		goto error;
+	}
+
+	rle_set_trace_callback(print_log);
+
+	handle = pcap_open_offline(argv[optind], errbuf);
+	if (handle == NULL) {
+		printf("failed to open the source pcap file: %s\n", errbuf);
+		goto error;
+	}
+	if (pcap_datalink(handle) != DLT_EN10MB) {
+		printf("link layer type %d not supported in source dump (supported = %d)\n",
+		       pcap_datalink(handle), DLT_EN10MB);
+		goto close_input;
+	}
+
+	writer = rle_fpdu_trace_writer_open(argv[optind + 1]);
+	if (writer == NULL) {
+		goto close_input;
+	}
+
+	while ((packet = pcap_next(handle, &header)) != NULL) {
+		struct rle_fpdu_trace_record record;
+
+		/* the same FPDUs as test_non_regression_fpdu, malformed ones included */
+		if (header.len <= ETHER_HDR_LEN || header.len != header.caplen ||
+		    header.len - ETHER_HDR_LEN > UINT16_MAX) {
+			skipped_nr++;
+			continue;
+		}
+
+		memset(&record, 0, sizeof(struct rle_fpdu_trace_record));
+		record.timestamp_ns = (uint64_t)header.ts.tv_sec * 1000000000U +
+		                      (uint64_t)header.ts.tv_usec * 1000U;
+		record.burst = (uint32_t)(fpdus_nr / burst_len);
+		record.fpdu_len = (uint16_t)(header.len - ETHER_HDR_LEN);
+		record.label_len = (uint8_t)label_len;
+
+		if (rle_fpdu_trace_write(writer, &record, packet + ETHER_HDR_LEN) != 0) {
+			printf("failed to write FPDU #%zu\n", fpdus_nr + 1);
+			rle_fpdu_trace_writer_close(&writer);
+			goto close_input;
+		}
+		fpdus_nr++;
+	}
+
+	if (rle_fpdu_trace_writer_close(&writer) != 0) {
+		goto close_input;
+	}
+
+	printf("%zu FPDUs converted, %zu packets skipped\n", fpdus_nr, skipped_nr);
+	status = EXIT_SUCCESS;
+
+close_input:
+	pcap_close(handle);
+error:
+	return status;
+}
+
+/**
+ * @brief Print usage of the converter
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "\n"
+	        "RLE FPDU trace converter: convert a PCAP file of FPDUs, with Ethernet\n"
+	        "linklayer, into a FPDU trace read by test_non_regression_fpdu and\n"
+	        "test_perfs_decap_errors without copy.\n"
+	        "\n"
+	        "usage: test_fpdu_trace_convert [OPTIONS] FLOW TRACE\n"
+	        "\n"
+	        "with:\n"
+	        "\tFLOW                    The PCAP file of FPDUs\n"
+	        "\tTRACE                   The FPDU trace to create\n"
+	        "\n"
+	        "options:\n"
+	        "\t-v                      Print version information and exit\n"
+	        "\t-h                      Print this usage and exit\n"
+	        "\t--label-size, -l        Payload Label size of the FPDUs (default %d)\n"
+	        "\t--burst, -b             Number of FPDUs per burst (default %d)\n"
+	        "\n",
+	        DEFAULT_LABEL_LEN, DEFAULT_BURST_LEN);
+
+	return;
+}
+
+/**
+ * @brief Print the library error messages
+ *
+ * @param module_id  The library module
+ * @param level      The log level
+ * @param file       The source file
+ * @param line       The source line
+ * @param func       The function
+ * @param message    The message format
+ * @param ...        The message arguments
+ */
+static void print_log(const int module_id __attribute__((unused)),
+                      const int level,
+                      const char *const file __attribute__((unused)),
+                      const int line __attribute__((unused)),
+                      const char *const func,
+                      const char *const message, ...)
+{
+	va_list args;
+
+	if (level > RLE_LOG_LEVEL_WARNING) {
+		return;
+	}
+
+	va_start(args, message);
+	fprintf(stderr, "%s: ", func);
+	vfprintf(stderr, message, args);
+	fprintf(stderr, "\n");
+	va_end(args);
+}
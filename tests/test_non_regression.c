@@ -1298,6 +1298,10 @@ static char * str_decap_error(const enum rle_decap_status status)
 		return "[RLE_DECAP_ERR_INV_SDUS] Given preallocated SDUs array is invalid.";
 	case RLE_DECAP_ERR_INV_PL:
 		return "[RLE_DECAP_ERR_INV_PL] Given preallocated payload label array is invalid.";
+	case RLE_DECAP_FILTERED:
+		return "[RLE_DECAP_FILTERED] Payload label not accepted, FPDU dropped unparsed.";
+	case RLE_DECAP_ARENA_FULL:
+		return "[RLE_DECAP_ARENA_FULL] The SDU arena is full, FPDU to be resumed.";
 	default:
 		return "[Unknwon status]";
 	}
@@ -153,7 +153,8 @@ static void usage(void)
 	        "\n"
 	        "with:\n"
 	        "  FLOW                    The flow of FPDU to test\n"
-	        "                          (in PCAP format, with Ethernet linklayer)\n"
+	        "                          (in PCAP format, with Ethernet linklayer,\n"
+	        "                          or a FPDU trace, see test_fpdu_trace_convert)\n"
 	        "\n"
 	        "options:\n"
 	        "  -v                      Print version information and exit\n"
@@ -283,7 +284,7 @@ static int decap_fpdus(struct rle_receiver *const receiver,
  * @brief Test the RLE library with a flow of FPDUs going through decapsulation
  *
  * @param ignore_malformed     Whether to handle malformed FPDU as fatal for test
- * @param src_filename         The name of the PCAP file that contains the FPDUs
+ * @param src_filename         The name of the PCAP file or FPDU trace that contains the FPDUs
  * @return                     0 in case of success,
  *                             1 in case of failure,
  *                             77 if test is skipped
@@ -291,7 +292,8 @@ static int decap_fpdus(struct rle_receiver *const receiver,
 static int test_decap_fpdus(const bool ignore_malformed, const char *const src_filename)
 {
 	char errbuf[PCAP_ERRBUF_SIZE];
-	pcap_t *handle;
+	pcap_t *handle = NULL;
+	struct rle_fpdu_trace *trace;
 	int link_layer_type_src;
 	size_t link_len_src;
 	struct pcap_pkthdr header;
@@ -383,6 +385,14 @@ static int test_decap_fpdus(const bool ignore_malformed, const char *const src_f
 
 	printf("=== initialization:\n");
 
+	/* the FPDUs of a trace are decapsulated in its mapping, without copy */
+	trace = rle_fpdu_trace_open(src_filename);
+	if (trace != NULL) {
+		link_len_src = ETHER_HDR_LEN;
+		counter = 0;
+		goto load_trace;
+	}
+
 	/* open the source dump file */
 	handle = pcap_open_offline(src_filename, errbuf);
 	if (handle == NULL) {
@@ -401,17 +411,19 @@ static int test_decap_fpdus(const bool ignore_malformed, const char *const src_f
 	}
 	link_len_src = ETHER_HDR_LEN;
 
+load_trace:
 	printf("\n");
 
 	/* for each fpdu in the dump */
-	unsigned char **fpdus = malloc(sizeof(unsigned char *));
+	const size_t fpdus_max = trace != NULL ? rle_fpdu_trace_count(trace) + 1 : 1;
+	unsigned char **fpdus = malloc(fpdus_max * sizeof(unsigned char *));
 	if (fpdus == NULL) {
 		printf("failed to allocate FPDUs.\n");
 		status = 1;
-		goto error;
+		goto close_input;
 	}
 
-	size_t *fpdus_lengths = malloc(sizeof(size_t));
+	size_t *fpdus_lengths = malloc(fpdus_max * sizeof(size_t));
 	if (fpdus_lengths == NULL) {
 		printf("failed to allocate FPDUs lengths.\n");
 		status = 1;
@@ -419,7 +431,25 @@ static int test_decap_fpdus(const bool ignore_malformed, const char *const src_f
 	}
 
 	counter = 0;
-	while ((fpdu = (unsigned char *)pcap_next(handle, &header)) != NULL) {
+	if (trace != NULL) {
+		size_t record_id;
+
+		for (record_id = 0; record_id < rle_fpdu_trace_count(trace); ++record_id) {
+			const struct rle_fpdu_trace_record *const record =
+				rle_fpdu_trace_get(trace, record_id, &fpdu);
+
+			/* the Payload Label of the pcaps, see decap_fpdus() */
+			if (record->label_len != 3) {
+				printf("bad trace record %zu (label_len = %u)\n", record_id,
+				       record->label_len);
+				continue;
+			}
+			fpdus[counter] = fpdu;
+			fpdus_lengths[counter] = record->fpdu_len;
+			counter++;
+		}
+	}
+	while (handle != NULL && (fpdu = (unsigned char *)pcap_next(handle, &header)) != NULL) {
 		/* check Ethernet frame length */
 		if (header.len <= link_len_src || header.len != header.caplen) {
 			printf("bad PCAP fpdu (len = %d, caplen = %d)\n", header.len,
@@ -558,7 +588,7 @@ static int test_decap_fpdus(const bool ignore_malformed, const char *const src_f
 free_alloc:
 	if (fpdus != NULL) {
 		size_t fpdu_id;
-		for (fpdu_id = 0; fpdu_id < (size_t)counter; ++fpdu_id) {
+		for (fpdu_id = 0; trace == NULL && fpdu_id < (size_t)counter; ++fpdu_id) {
 			if (fpdus[fpdu_id] != NULL) {
 				free(fpdus[fpdu_id]);
 			}
@@ -571,7 +601,10 @@ free_alloc:
 		fpdus_lengths = NULL;
 	}
 close_input:
-	pcap_close(handle);
+	if (handle != NULL) {
+		pcap_close(handle);
+	}
+	rle_fpdu_trace_close(&trace);
 error:
 	return status;
 }
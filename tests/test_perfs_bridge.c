@@ -0,0 +1,1255 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_perfs_bridge.c
+ * @brief  Reference bridge from a TUN device or a PCAP trace to RLE FPDUs over UDP and back.
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#define _GNU_SOURCE
+
+#include "rle.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <assert.h>
+#include <getopt.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <linux/if_tun.h>
+#include <pcap/pcap.h>
+#include <pcap.h>
+
+/** The program version */
+#define TEST_VERSION  "RLE bridge performances test application, version 0.0.1\n"
+
+/** The length (in bytes) of the Ethernet header */
+#define ETHER_HDR_LEN  14U
+
+/** Default size of the FPDUs */
+#define DEFAULT_FPDU_SIZE 1200
+
+/** Default number of FPDUs per sendmmsg or recvmmsg */
+#define DEFAULT_BURST 32
+
+/** Largest size of a FPDU sent in one UDP datagram */
+#define FPDU_SIZE_MAX 9000
+
+/** Largest number of FPDUs per batch */
+#define BURST_MAX 1024
+
+/** Default UDP port of the receiving side */
+#define DEFAULT_PORT 5000
+
+/** The stages of the bridge */
+enum stage {
+	STAGE_SOURCE,  /**< Read the SDUs from the TUN device or the trace      */
+	STAGE_ENCAP,   /**< Encapsulate, fragment and pack the SDUs in FPDUs    */
+	STAGE_SEND,    /**< Send the FPDUs with sendmmsg                        */
+	STAGE_RECV,    /**< Receive the FPDUs with recvmmsg                     */
+	STAGE_DECAP,   /**< Decapsulate the FPDUs                               */
+	STAGE_SINK,    /**< Write the SDUs to the TUN device or check them      */
+	STAGE_NB,
+};
+
+/** The names of the stages */
+static const char *const stage_names[STAGE_NB] = {
+	[STAGE_SOURCE] = "source",
+	[STAGE_ENCAP] = "encap",
+	[STAGE_SEND] = "send",
+	[STAGE_RECV] = "recv",
+	[STAGE_DECAP] = "decap",
+	[STAGE_SINK] = "sink",
+};
+
+/** The counters of the bridge */
+struct counters {
+	uint64_t sdus_in;           /**< SDUs read from the source             */
+	uint64_t sdu_bytes_in;      /**< Octets of the SDUs read               */
+	uint64_t sdus_rejected;     /**< SDUs the transmitter rejected         */
+	uint64_t fpdus_sent;        /**< FPDUs sent                            */
+	uint64_t fpdu_bytes_sent;   /**< Octets of the FPDUs sent              */
+	uint64_t send_calls;        /**< Calls to sendmmsg                     */
+	uint64_t send_errors;       /**< FPDUs that sendmmsg failed to send    */
+	uint64_t fpdus_recv;        /**< FPDUs received                        */
+	uint64_t recv_calls;        /**< Calls to recvmmsg                     */
+	uint64_t decap_errors;      /**< FPDUs the receiver failed to decap    */
+	uint64_t sdus_out;          /**< SDUs decapsulated                     */
+	uint64_t sdu_bytes_out;     /**< Octets of the SDUs decapsulated       */
+	uint64_t sink_errors;       /**< SDUs that failed to be written        */
+	uint64_t hash_in;           /**< Sum of the hashes of the SDUs read    */
+	uint64_t hash_out;          /**< Sum of the hashes of the SDUs decap   */
+	uint64_t stage_ns[STAGE_NB]; /**< Time spent in each stage, in ns      */
+};
+
+/** The SDUs of the traces */
+struct sdus {
+	unsigned char *data;  /**< The SDUs one after the other */
+	size_t *lens;         /**< The length of each SDU */
+	uint16_t *ptypes;     /**< The protocol type of each SDU */
+	size_t nr;            /**< The number of SDUs */
+	size_t max_nr;        /**< The number of SDUs allocated */
+};
+
+/** The configuration of the bridge */
+struct bridge {
+	struct rle_config conf;          /**< The RLE configuration                    */
+	size_t fpdu_size;                /**< The size of the FPDUs                    */
+	size_t burst;                    /**< FPDUs per sendmmsg or recvmmsg           */
+	uint8_t contexts_nr;             /**< Fragmentation contexts used              */
+	bool do_tx;                      /**< Whether to run the transmitting side     */
+	bool do_rx;                      /**< Whether to run the receiving side        */
+	int tun_fd;                      /**< The TUN device, -1 if none               */
+	int tx_sock;                     /**< The socket of the transmitting side      */
+	int rx_sock;                     /**< The socket of the receiving side         */
+	struct sockaddr_in remote;       /**< The address of the receiving side        */
+	struct counters counters;        /**< The counters                             */
+};
+
+/** The transmitting side */
+struct tx {
+	struct rle_transmitter *transmitter; /**< The RLE transmitter              */
+	unsigned char *fpdus;                /**< The FPDUs of the batch           */
+	struct iovec *iovs;                  /**< One segment per FPDU             */
+	struct mmsghdr *msgs;                /**< The messages of the batch        */
+	size_t pending_nr;                   /**< FPDUs ready in the batch         */
+	uint8_t next_ctx;                    /**< First context of the next FPDU   */
+};
+
+/** The receiving side */
+struct rx {
+	struct rle_receiver *receiver;       /**< The RLE receiver                 */
+	unsigned char *fpdus;                /**< The FPDUs of the batch           */
+	struct iovec *iovs;                  /**< One segment per FPDU             */
+	struct mmsghdr *msgs;                /**< The messages of the batch        */
+	unsigned char *sdu_buffers;          /**< The buffers of the SDUs          */
+	struct rle_sdu *sdus;                /**< The SDUs of one FPDU             */
+	size_t sdus_max;                     /**< The number of SDUs of one FPDU   */
+};
+
+/** Whether the bridge shall stop */
+static volatile bool stop_bridge = false;
+
+/* prototypes of private functions */
+static void usage(void);
+static void print_log(const int module_id, const int level, const char *const file,
+                      const int line, const char *const func, const char *const message, ...);
+static void handle_signal(const int signum);
+static uint64_t now_ns(void);
+static uint64_t hash_sdu(const unsigned char *const data, const size_t len);
+static int load_trace(const char *const filename, struct sdus *const sdus);
+static int open_tun(const char *const name);
+static int open_udp(const struct sockaddr_in *const addr);
+static int parse_addr(const char *const str, struct sockaddr_in *const addr);
+static int tx_new(struct bridge *const bridge, struct tx *const tx);
+static void tx_del(struct tx *const tx);
+static int tx_push_sdu(struct bridge *const bridge, struct tx *const tx,
+                       const struct rle_sdu *const sdu);
+static bool tx_build_fpdu(struct bridge *const bridge, struct tx *const tx);
+static void tx_flush(struct bridge *const bridge, struct tx *const tx);
+static int tx_push_sdu_timed(struct bridge *const bridge, struct tx *const tx,
+                             const struct rle_sdu *const sdu);
+static void tx_drain_timed(struct bridge *const bridge, struct tx *const tx);
+static int rx_new(struct bridge *const bridge, struct rx *const rx);
+static void rx_del(struct rx *const rx);
+static size_t rx_poll(struct bridge *const bridge, struct rx *const rx, const int timeout_ms);
+static int run_trace(struct bridge *const bridge, const struct sdus *const sdus,
+                     const size_t repeat);
+static int run_tun(struct bridge *const bridge);
+static void print_counters(const struct bridge *const bridge, const uint64_t duration_ns);
+
+/**
+ * @brief Main function for the RLE bridge performances test
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	struct bridge bridge = {
+		.conf = {
+			.allow_ptype_omission = 0,
+			.use_compressed_ptype = 1,
+			.allow_alpdu_crc = 1,
+			.allow_alpdu_sequence_number = 0,
+			.use_explicit_payload_header_map = 0,
+			.implicit_protocol_type = 0x00,
+			.implicit_ppdu_label_size = 0,
+			.implicit_payload_label_size = 0,
+			.type_0_alpdu_label_size = 0,
+		},
+		.fpdu_size = DEFAULT_FPDU_SIZE,
+		.burst = DEFAULT_BURST,
+		.contexts_nr = RLE_MAX_FRAG_NUMBER,
+		.do_tx = true,
+		.do_rx = true,
+		.tun_fd = -1,
+		.tx_sock = -1,
+		.rx_sock = -1,
+	};
+	struct sockaddr_in local;
+	struct sdus sdus = { NULL, NULL, NULL, 0, 0 };
+	const char *tun_name = NULL;
+	const char *local_str = NULL;
+	const char *remote_str = NULL;
+	size_t repeat = 1;
+	uint64_t start;
+	int status = EXIT_FAILURE;
+	int i;
+
+	while (1) {
+		int c;
+
+		const char short_options[] = "vhf:b:c:r:t:l:R:m:S";
+
+		const struct option long_options[] =
+		{
+			{ "fpdu", required_argument, NULL, 'f' },
+			{ "burst", required_argument, NULL, 'b' },
+			{ "contexts", required_argument, NULL, 'c' },
+			{ "repeat", required_argument, NULL, 'r' },
+			{ "tun", required_argument, NULL, 't' },
+			{ "local", required_argument, NULL, 'l' },
+			{ "remote", required_argument, NULL, 'R' },
+			{ "mode", required_argument, NULL, 'm' },
+			{ "seqnum", no_argument, NULL, 'S' },
+			{ NULL, 0, NULL, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, short_options, long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 'f': /* FPDU size */
+			assert(optarg != NULL);
+			bridge.fpdu_size = strtoul(optarg, NULL, 10);
+			if (bridge.fpdu_size < 3 || bridge.fpdu_size > FPDU_SIZE_MAX) {
+				printf("ERROR: FPDU size shall be in [3, %d].\n", FPDU_SIZE_MAX);
+				goto error;
+			}
+			break;
+
+		case 'b': /* Burst of FPDUs */
+			assert(optarg != NULL);
+			bridge.burst = strtoul(optarg, NULL, 10);
+			if (bridge.burst < 1 || bridge.burst > BURST_MAX) {
+				printf("ERROR: burst shall be in [1, %d].\n", BURST_MAX);
+				goto error;
+			}
+			break;
+
+		case 'c': /* Number of contexts */
+			assert(optarg != NULL);
+			bridge.contexts_nr = strtoul(optarg, NULL, 10);
+			if (bridge.contexts_nr < 1 || bridge.contexts_nr > RLE_MAX_FRAG_NUMBER) {
+				printf("ERROR: contexts shall be in [1, %d].\n", RLE_MAX_FRAG_NUMBER);
+				goto error;
+			}
+			break;
+
+		case 'r': /* Repetitions of the traces */
+			assert(optarg != NULL);
+			repeat = strtoul(optarg, NULL, 10);
+			break;
+
+		case 't': /* TUN device */
+			tun_name = optarg;
+			break;
+
+		case 'l': /* Local address */
+			local_str = optarg;
+			break;
+
+		case 'R': /* Remote address */
+			remote_str = optarg;
+			break;
+
+		case 'm': /* Mode */
+			assert(optarg != NULL);
+			if (strcmp(optarg, "tx") == 0) {
+				bridge.do_rx = false;
+			} else if (strcmp(optarg, "rx") == 0) {
+				bridge.do_tx = false;
+			} else if (strcmp(optarg, "loopback") != 0) {
+				printf("ERROR: mode shall be tx, rx or loopback.\n");
+				goto error;
+			}
+			break;
+
+		case 'S': /* Sequence numbers */
+			bridge.conf.allow_alpdu_crc = 0;
+			bridge.conf.allow_alpdu_sequence_number = 1;
+			break;
+
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (tun_name == NULL && bridge.do_tx && optind >= argc) {
+		fprintf(stderr, "FLOW or --tun is a mandatory parameter\n\n");
+		usage();
+		goto error;
+	}
+
+	rle_set_trace_callback(print_log);
+	signal(SIGINT, handle_signal);
+	signal(SIGTERM, handle_signal);
+
+	/* the receiving side listens on the local address, the loopback on any free port */
+	memset(&local, 0, sizeof(local));
+	local.sin_family = AF_INET;
+	local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	local.sin_port = htons(bridge.do_tx && bridge.do_rx ? 0 : DEFAULT_PORT);
+	if (local_str != NULL && parse_addr(local_str, &local) != 0) {
+		goto error;
+	}
+	bridge.remote = local;
+	bridge.remote.sin_port = htons(DEFAULT_PORT);
+	if (remote_str != NULL && parse_addr(remote_str, &bridge.remote) != 0) {
+		goto error;
+	}
+
+	if (bridge.do_rx) {
+		socklen_t len = sizeof(local);
+
+		bridge.rx_sock = open_udp(&local);
+		if (bridge.rx_sock < 0) {
+			goto close;
+		}
+		if (getsockname(bridge.rx_sock, (struct sockaddr *)&local, &len) != 0) {
+			perror("getsockname");
+			goto close;
+		}
+		if (bridge.do_tx) {
+			bridge.remote = local;
+		}
+	}
+	if (bridge.do_tx) {
+		struct sockaddr_in any;
+
+		memset(&any, 0, sizeof(any));
+		any.sin_family = AF_INET;
+		bridge.tx_sock = open_udp(&any);
+		if (bridge.tx_sock < 0) {
+			goto close;
+		}
+	}
+
+	if (tun_name != NULL) {
+		bridge.tun_fd = open_tun(tun_name);
+		if (bridge.tun_fd < 0) {
+			goto close;
+		}
+	} else {
+		for (i = optind; i < argc; ++i) {
+			if (load_trace(argv[i], &sdus) != 0) {
+				goto free_sdus;
+			}
+		}
+		if (bridge.do_tx && sdus.nr == 0) {
+			fprintf(stderr, "no SDU in the traces\n");
+			goto free_sdus;
+		}
+	}
+
+	printf("=== test:\n");
+	printf("===\tmode:                %s\n",
+	       bridge.do_tx && bridge.do_rx ? "loopback" : (bridge.do_tx ? "tx" : "rx"));
+	printf("===\tsource:              %s\n", tun_name != NULL ? tun_name : "trace");
+	printf("===\tfpdu size:           %zu bytes\n", bridge.fpdu_size);
+	printf("===\tburst:               %zu fpdus\n", bridge.burst);
+	printf("===\tcontexts:            %u\n", bridge.contexts_nr);
+	printf("===\ttrailer:             %s\n", bridge.conf.allow_alpdu_crc ? "crc" : "seqnum");
+	printf("===\tremote:              %s:%u\n", inet_ntoa(bridge.remote.sin_addr),
+	       ntohs(bridge.remote.sin_port));
+
+	start = now_ns();
+	if (tun_name != NULL || !bridge.do_tx) {
+		if (run_tun(&bridge) != 0) {
+			goto free_sdus;
+		}
+	} else if (run_trace(&bridge, &sdus, repeat) != 0) {
+		goto free_sdus;
+	}
+	print_counters(&bridge, now_ns() - start);
+
+	status = EXIT_SUCCESS;
+	if (bridge.do_tx && bridge.do_rx && tun_name == NULL &&
+	    (bridge.counters.sdus_out != bridge.counters.sdus_in - bridge.counters.sdus_rejected ||
+	     bridge.counters.hash_out != bridge.counters.hash_in)) {
+		printf("=== loopback: SDUs decapsulated differ from the SDUs read\n");
+		status = EXIT_FAILURE;
+	}
+
+free_sdus:
+	free(sdus.data);
+	free(sdus.lens);
+	free(sdus.ptypes);
+close:
+	if (bridge.tun_fd >= 0) {
+		close(bridge.tun_fd);
+	}
+	if (bridge.tx_sock >= 0) {
+		close(bridge.tx_sock);
+	}
+	if (bridge.rx_sock >= 0) {
+		close(bridge.rx_sock);
+	}
+error:
+	return status;
+}
+
+/**
+ * @brief Print usage of the performance test application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "\n"
+	        "RLE bridge performances test: read IP packets from a TUN device or Ethernet\n"
+	        "traces, encapsulate, fragment and pack them in FPDUs sent over UDP with\n"
+	        "sendmmsg; receive the FPDUs with recvmmsg, decapsulate them and write the\n"
+	        "SDUs back to the TUN device. In loopback mode, both sides run in the same\n"
+	        "process over the loopback interface and the SDUs of the traces are checked.\n"
+	        "\n"
+	        "usage: test_perfs_bridge [OPTIONS] [FLOW...]\n"
+	        "\n"
+	        "with:\n"
+	        "\tFLOW                    The flows of Ethernet frames to send (PCAP format).\n"
+	        "\n"
+	        "options:\n"
+	        "\t-v                      Print version information and exit\n"
+	        "\t-h                      Print this usage and exit\n"
+	        "\t--mode, -m              tx, rx or loopback (default loopback)\n"
+	        "\t--tun, -t               Read and write IP packets on this TUN device\n"
+	        "\t--local, -l             ADDR:PORT the receiving side listens on\n"
+	        "\t                        (default 127.0.0.1:%d, any port in loopback)\n"
+	        "\t--remote, -R            ADDR:PORT the transmitting side sends to\n"
+	        "\t                        (default 127.0.0.1:%d)\n"
+	        "\t--fpdu, -f              Size of the FPDUs (default %d)\n"
+	        "\t--burst, -b             FPDUs per sendmmsg and recvmmsg (default %d)\n"
+	        "\t--contexts, -c          Fragmentation contexts used (default %d)\n"
+	        "\t--repeat, -r            Send the traces this number of times (default 1)\n"
+	        "\t--seqnum, -S            Sequence number trailers instead of CRC\n"
+	        "\n",
+	        DEFAULT_PORT, DEFAULT_PORT, DEFAULT_FPDU_SIZE, DEFAULT_BURST, RLE_MAX_FRAG_NUMBER);
+
+	return;
+}
+
+/**
+ * @brief Print the library error messages
+ *
+ * @param module_id  The library module
+ * @param level      The log level
+ * @param file       The source file
+ * @param line       The source line
+ * @param func       The function
+ * @param message    The message format
+ * @param ...        The message arguments
+ */
+static void print_log(const int module_id __attribute__((unused)),
+                      const int level,
+                      const char *const file __attribute__((unused)),
+                      const int line __attribute__((unused)),
+                      const char *const func,
+                      const char *const message, ...)
+{
+	va_list args;
+
+	if (level > RLE_LOG_LEVEL_WARNING) {
+		return;
+	}
+
+	va_start(args, message);
+	fprintf(stderr, "%s: ", func);
+	vfprintf(stderr, message, args);
+	fprintf(stderr, "\n");
+	va_end(args);
+}
+
+/**
+ * @brief Stop the bridge on SIGINT or SIGTERM
+ *
+ * @param signum  The signal
+ */
+static void handle_signal(const int signum __attribute__((unused)))
+{
+	stop_bridge = true;
+}
+
+/**
+ * @brief Get the time of a monotonic clock
+ *
+ * @return The time, in nanoseconds
+ */
+static uint64_t now_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Hash a SDU, FNV-1a, to check the SDUs whatever their order
+ *
+ * @param data  The SDU
+ * @param len   The length of the SDU
+ * @return      The hash of the SDU
+ */
+static uint64_t hash_sdu(const unsigned char *const data, const size_t len)
+{
+	uint64_t hash = 14695981039346656037ULL;
+	size_t i;
+
+	for (i = 0; i < len; ++i) {
+		hash = (hash ^ data[i]) * 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+/**
+ * @brief Load the SDUs of an Ethernet trace
+ *
+ * @param filename  The PCAP file
+ * @param sdus      The SDUs to append to
+ * @return          0 if OK, else 1
+ */
+static int load_trace(const char *const filename, struct sdus *const sdus)
+{
+	char errbuf[PCAP_ERRBUF_SIZE];
+	struct pcap_pkthdr header;
+	const unsigned char *packet;
+	pcap_t *handle;
+	int status = 1;
+
+	handle = pcap_open_offline(filename, errbuf);
+	if (handle == NULL) {
+		fprintf(stderr, "failed to open the trace %s: %s\n", filename, errbuf);
+		goto error;
+	}
+	if (pcap_datalink(handle) != DLT_EN10MB) {
+		fprintf(stderr, "trace %s is not an Ethernet one, skipped\n", filename);
+		status = 0;
+		goto close;
+	}
+
+	while ((packet = pcap_next(handle, &header)) != NULL) {
+		const size_t len = header.caplen - ETHER_HDR_LEN;
+
+		if (header.caplen <= ETHER_HDR_LEN || header.len != header.caplen ||
+		    len > RLE_MAX_PDU_SIZE) {
+			continue;
+		}
+
+		if (sdus->nr == sdus->max_nr) {
+			const size_t max_nr = (sdus->max_nr == 0 ? 1024 : sdus->max_nr * 2);
+			unsigned char *const data = realloc(sdus->data, max_nr * RLE_MAX_PDU_SIZE);
+			size_t *const lens = realloc(sdus->lens, max_nr * sizeof(size_t));
+			uint16_t *const ptypes = realloc(sdus->ptypes, max_nr * sizeof(uint16_t));
+
+			if (data != NULL) {
+				sdus->data = data;
+			}
+			if (lens != NULL) {
+				sdus->lens = lens;
+			}
+			if (ptypes != NULL) {
+				sdus->ptypes = ptypes;
+			}
+			if (data == NULL || lens == NULL || ptypes == NULL) {
+				fprintf(stderr, "failed to allocate the SDUs\n");
+				goto close;
+			}
+			sdus->max_nr = max_nr;
+		}
+
+		memcpy(sdus->data + sdus->nr * RLE_MAX_PDU_SIZE, packet + ETHER_HDR_LEN, len);
+		sdus->lens[sdus->nr] = len;
+		sdus->ptypes[sdus->nr] = ntohs(*(const uint16_t *)(packet + ETHER_HDR_LEN - 2));
+		sdus->nr++;
+	}
+
+	status = 0;
+
+close:
+	pcap_close(handle);
+error:
+	return status;
+}
+
+/**
+ * @brief Open a TUN device, without packet information
+ *
+ * @param name  The name of the TUN device
+ * @return      The file descriptor of the device, -1 in case of error
+ */
+static int open_tun(const char *const name)
+{
+	struct ifreq ifr;
+	int fd;
+
+	fd = open("/dev/net/tun", O_RDWR);
+	if (fd < 0) {
+		perror("failed to open /dev/net/tun");
+		goto error;
+	}
+
+	memset(&ifr, 0, sizeof(ifr));
+	ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
+	strncpy(ifr.ifr_name, name, IFNAMSIZ - 1);
+	if (ioctl(fd, TUNSETIFF, &ifr) != 0) {
+		perror("failed to attach the TUN device");
+		close(fd);
+		fd = -1;
+	}
+
+error:
+	return fd;
+}
+
+/**
+ * @brief Open a UDP socket bound to an address, with large buffers
+ *
+ * @param addr  The address to bind to
+ * @return      The socket, -1 in case of error
+ */
+static int open_udp(const struct sockaddr_in *const addr)
+{
+	const int buf_size = 8 * 1024 * 1024;
+	int sock;
+
+	sock = socket(AF_INET, SOCK_DGRAM, 0);
+	if (sock < 0) {
+		perror("failed to create the UDP socket");
+		goto error;
+	}
+
+	/* best effort, the buffers are capped by the system */
+	setsockopt(sock, SOL_SOCKET, SO_SNDBUF, &buf_size, sizeof(buf_size));
+	setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &buf_size, sizeof(buf_size));
+
+	if (bind(sock, (const struct sockaddr *)addr, sizeof(*addr)) != 0) {
+		perror("failed to bind the UDP socket");
+		close(sock);
+		sock = -1;
+	}
+
+error:
+	return sock;
+}
+
+/**
+ * @brief Parse an ADDR:PORT string
+ *
+ * @param str   The string
+ * @param addr  The address, its port unchanged if none is given
+ * @return      0 if OK, else 1
+ */
+static int parse_addr(const char *const str, struct sockaddr_in *const addr)
+{
+	char host[INET_ADDRSTRLEN];
+	const char *const colon = strchr(str, ':');
+	const size_t host_len = (colon != NULL ? (size_t)(colon - str) : strlen(str));
+	int status = 1;
+
+	if (host_len >= sizeof(host)) {
+		goto error;
+	}
+	memcpy(host, str, host_len);
+	host[host_len] = '\0';
+
+	if (inet_pton(AF_INET, host, &addr->sin_addr) != 1) {
+		goto error;
+	}
+	if (colon != NULL) {
+		addr->sin_port = htons(strtoul(colon + 1, NULL, 10));
+	}
+
+	status = 0;
+
+error:
+	if (status != 0) {
+		fprintf(stderr, "invalid address %s, ADDR:PORT expected\n", str);
+	}
+	return status;
+}
+
+/**
+ * @brief Create the transmitting side
+ *
+ * @param bridge  The bridge
+ * @param tx      The transmitting side
+ * @return        0 if OK, else 1
+ */
+static int tx_new(struct bridge *const bridge, struct tx *const tx)
+{
+	size_t i;
+
+	memset(tx, 0, sizeof(struct tx));
+
+	tx->transmitter = rle_transmitter_new(&bridge->conf);
+	tx->fpdus = malloc(bridge->burst * bridge->fpdu_size);
+	tx->iovs = calloc(bridge->burst, sizeof(struct iovec));
+	tx->msgs = calloc(bridge->burst, sizeof(struct mmsghdr));
+	if (tx->transmitter == NULL || tx->fpdus == NULL || tx->iovs == NULL || tx->msgs == NULL) {
+		fprintf(stderr, "failed to create the transmitting side\n");
+		tx_del(tx);
+		return 1;
+	}
+
+	for (i = 0; i < bridge->burst; ++i) {
+		tx->iovs[i].iov_base = tx->fpdus + i * bridge->fpdu_size;
+		tx->iovs[i].iov_len = bridge->fpdu_size;
+		tx->msgs[i].msg_hdr.msg_name = &bridge->remote;
+		tx->msgs[i].msg_hdr.msg_namelen = sizeof(bridge->remote);
+		tx->msgs[i].msg_hdr.msg_iov = &tx->iovs[i];
+		tx->msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Destroy the transmitting side
+ *
+ * @param tx  The transmitting side
+ */
+static void tx_del(struct tx *const tx)
+{
+	rle_transmitter_destroy(&tx->transmitter);
+	free(tx->fpdus);
+	free(tx->iovs);
+	free(tx->msgs);
+}
+
+/**
+ * @brief Encapsulate a SDU in a free context, building FPDUs until one is free
+ *
+ * @param bridge  The bridge
+ * @param tx      The transmitting side
+ * @param sdu     The SDU
+ * @return        0 if OK, else 1
+ */
+static int tx_push_sdu(struct bridge *const bridge, struct tx *const tx,
+                       const struct rle_sdu *const sdu)
+{
+	while (1) {
+		uint8_t i;
+
+		for (i = 0; i < bridge->contexts_nr; ++i) {
+			const uint8_t frag_id = (tx->next_ctx + i) % bridge->contexts_nr;
+
+			if (rle_transmitter_stats_get_queue_size(tx->transmitter, frag_id) != 0) {
+				continue;
+			}
+			if (rle_encapsulate(tx->transmitter, sdu, frag_id) != RLE_ENCAP_OK) {
+				bridge->counters.sdus_rejected++;
+			}
+			return 0;
+		}
+
+		if (!tx_build_fpdu(bridge, tx)) {
+			fprintf(stderr, "all the contexts are busy but no FPDU can be built\n");
+			return 1;
+		}
+	}
+}
+
+/**
+ * @brief Build one FPDU with one PPDU of each busy context, send the batch once full
+ *
+ * @param bridge  The bridge
+ * @param tx      The transmitting side
+ * @return        true if a FPDU was built, false if all the contexts are free
+ */
+static bool tx_build_fpdu(struct bridge *const bridge, struct tx *const tx)
+{
+	unsigned char *const fpdu = tx->fpdus + tx->pending_nr * bridge->fpdu_size;
+	size_t fpdu_pos = 0;
+	size_t fpdu_remain = bridge->fpdu_size;
+	uint8_t i;
+
+	for (i = 0; i < bridge->contexts_nr; ++i) {
+		const uint8_t frag_id = (tx->next_ctx + i) % bridge->contexts_nr;
+		unsigned char *ppdu;
+		size_t ppdu_len;
+
+		if (rle_transmitter_stats_get_queue_size(tx->transmitter, frag_id) == 0) {
+			continue;
+		}
+		if (rle_fragment(tx->transmitter, frag_id, fpdu_remain, &ppdu,
+		                 &ppdu_len) != RLE_FRAG_OK) {
+			/* too little room left for this context */
+			continue;
+		}
+		if (rle_pack(ppdu, ppdu_len, NULL, 0, fpdu, &fpdu_pos, &fpdu_remain) != RLE_PACK_OK) {
+			fprintf(stderr, "failed to pack a %zu-byte PPDU\n", ppdu_len);
+			abort();
+		}
+	}
+	tx->next_ctx = (tx->next_ctx + 1) % bridge->contexts_nr;
+
+	if (fpdu_pos == 0) {
+		return false;
+	}
+
+	rle_pad(fpdu, fpdu_pos, fpdu_remain);
+	rle_transmitter_stats_add_fpdu(tx->transmitter, 0, fpdu_pos, fpdu_remain);
+	tx->pending_nr++;
+	if (tx->pending_nr == bridge->burst) {
+		tx_flush(bridge, tx);
+	}
+
+	return true;
+}
+
+/**
+ * @brief Send the FPDUs of the batch with sendmmsg
+ *
+ * @param bridge  The bridge
+ * @param tx      The transmitting side
+ */
+static void tx_flush(struct bridge *const bridge, struct tx *const tx)
+{
+	struct counters *const counters = &bridge->counters;
+	size_t sent_nr = 0;
+	uint64_t start;
+
+	start = now_ns();
+	while (sent_nr < tx->pending_nr) {
+		const int ret = sendmmsg(bridge->tx_sock, tx->msgs + sent_nr, tx->pending_nr - sent_nr,
+		                         0);
+
+		counters->send_calls++;
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			counters->send_errors += tx->pending_nr - sent_nr;
+			break;
+		}
+		sent_nr += (size_t)ret;
+	}
+	counters->fpdus_sent += sent_nr;
+	counters->fpdu_bytes_sent += sent_nr * bridge->fpdu_size;
+	counters->stage_ns[STAGE_SEND] += now_ns() - start;
+
+	tx->pending_nr = 0;
+}
+
+/**
+ * @brief Encapsulate a SDU, accounting the time out of the sending in the encap stage
+ *
+ * @param bridge  The bridge
+ * @param tx      The transmitting side
+ * @param sdu     The SDU
+ * @return        0 if OK, else 1
+ */
+static int tx_push_sdu_timed(struct bridge *const bridge, struct tx *const tx,
+                             const struct rle_sdu *const sdu)
+{
+	struct counters *const counters = &bridge->counters;
+	const uint64_t send_ns = counters->stage_ns[STAGE_SEND];
+	const uint64_t start = now_ns();
+	int status;
+
+	status = tx_push_sdu(bridge, tx, sdu);
+	counters->stage_ns[STAGE_ENCAP] += now_ns() - start;
+	counters->stage_ns[STAGE_ENCAP] -= counters->stage_ns[STAGE_SEND] - send_ns;
+
+	return status;
+}
+
+/**
+ * @brief Build the FPDUs of all the SDUs left in the contexts and send them
+ *
+ * @param bridge  The bridge
+ * @param tx      The transmitting side
+ */
+static void tx_drain_timed(struct bridge *const bridge, struct tx *const tx)
+{
+	struct counters *const counters = &bridge->counters;
+	const uint64_t send_ns = counters->stage_ns[STAGE_SEND];
+	const uint64_t start = now_ns();
+
+	while (tx_build_fpdu(bridge, tx)) {
+	}
+	counters->stage_ns[STAGE_ENCAP] += now_ns() - start;
+	counters->stage_ns[STAGE_ENCAP] -= counters->stage_ns[STAGE_SEND] - send_ns;
+
+	tx_flush(bridge, tx);
+}
+
+/**
+ * @brief Create the receiving side
+ *
+ * @param bridge  The bridge
+ * @param rx      The receiving side
+ * @return        0 if OK, else 1
+ */
+static int rx_new(struct bridge *const bridge, struct rx *const rx)
+{
+	size_t i;
+
+	memset(rx, 0, sizeof(struct rx));
+
+	/* at most one SDU per 3 octets of FPDU, a 2-byte PPDU header and 1-byte SDU */
+	rx->sdus_max = bridge->fpdu_size / 3 + 1;
+	rx->receiver = rle_receiver_new(&bridge->conf);
+	rx->fpdus = malloc(bridge->burst * FPDU_SIZE_MAX);
+	rx->iovs = calloc(bridge->burst, sizeof(struct iovec));
+	rx->msgs = calloc(bridge->burst, sizeof(struct mmsghdr));
+	rx->sdu_buffers = malloc(rx->sdus_max * RLE_MAX_PDU_SIZE);
+	rx->sdus = calloc(rx->sdus_max, sizeof(struct rle_sdu));
+	if (rx->receiver == NULL || rx->fpdus == NULL || rx->iovs == NULL || rx->msgs == NULL ||
+	    rx->sdu_buffers == NULL || rx->sdus == NULL) {
+		fprintf(stderr, "failed to create the receiving side\n");
+		rx_del(rx);
+		return 1;
+	}
+
+	for (i = 0; i < bridge->burst; ++i) {
+		rx->iovs[i].iov_base = rx->fpdus + i * FPDU_SIZE_MAX;
+		rx->iovs[i].iov_len = FPDU_SIZE_MAX;
+		rx->msgs[i].msg_hdr.msg_iov = &rx->iovs[i];
+		rx->msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+	for (i = 0; i < rx->sdus_max; ++i) {
+		rx->sdus[i].buffer = rx->sdu_buffers + i * RLE_MAX_PDU_SIZE;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Destroy the receiving side
+ *
+ * @param rx  The receiving side
+ */
+static void rx_del(struct rx *const rx)
+{
+	rle_receiver_destroy(&rx->receiver);
+	free(rx->fpdus);
+	free(rx->iovs);
+	free(rx->msgs);
+	free(rx->sdu_buffers);
+	free(rx->sdus);
+}
+
+/**
+ * @brief Receive a batch of FPDUs with recvmmsg, decapsulate them and sink the SDUs
+ *
+ * @param bridge      The bridge
+ * @param rx          The receiving side
+ * @param timeout_ms  How long to wait for the first FPDU, 0 not to wait
+ * @return            The number of FPDUs received
+ */
+static size_t rx_poll(struct bridge *const bridge, struct rx *const rx, const int timeout_ms)
+{
+	struct counters *const counters = &bridge->counters;
+	struct pollfd pfd = { .fd = bridge->rx_sock, .events = POLLIN, .revents = 0 };
+	uint64_t start;
+	size_t i;
+	int ret;
+
+	if (timeout_ms != 0 && poll(&pfd, 1, timeout_ms) <= 0) {
+		return 0;
+	}
+
+	start = now_ns();
+	ret = recvmmsg(bridge->rx_sock, rx->msgs, bridge->burst, MSG_DONTWAIT, NULL);
+	counters->recv_calls++;
+	counters->stage_ns[STAGE_RECV] += now_ns() - start;
+	if (ret <= 0) {
+		return 0;
+	}
+	counters->fpdus_recv += (uint64_t)ret;
+
+	for (i = 0; i < (size_t)ret; ++i) {
+		size_t sdus_nr = 0;
+		size_t j;
+
+		start = now_ns();
+		if (rle_decapsulate(rx->receiver, rx->fpdus + i * FPDU_SIZE_MAX, rx->msgs[i].msg_len,
+		                    rx->sdus, rx->sdus_max, &sdus_nr, NULL, 0) != RLE_DECAP_OK) {
+			counters->decap_errors++;
+		}
+		counters->stage_ns[STAGE_DECAP] += now_ns() - start;
+
+		start = now_ns();
+		for (j = 0; j < sdus_nr; ++j) {
+			counters->sdus_out++;
+			counters->sdu_bytes_out += rx->sdus[j].size;
+			if (bridge->tun_fd >= 0) {
+				if (write(bridge->tun_fd, rx->sdus[j].buffer, rx->sdus[j].size) < 0) {
+					counters->sink_errors++;
+				}
+			} else {
+				counters->hash_out += hash_sdu(rx->sdus[j].buffer, rx->sdus[j].size);
+			}
+		}
+		counters->stage_ns[STAGE_SINK] += now_ns() - start;
+	}
+
+	return (size_t)ret;
+}
+
+/**
+ * @brief Send the SDUs of the traces, and receive them back in loopback mode
+ *
+ * @param bridge  The bridge
+ * @param sdus    The SDUs of the traces
+ * @param repeat  The number of times to send the traces
+ * @return        0 if OK, else 1
+ */
+static int run_trace(struct bridge *const bridge, const struct sdus *const sdus,
+                     const size_t repeat)
+{
+	struct counters *const counters = &bridge->counters;
+	struct tx tx;
+	struct rx rx;
+	int status = 1;
+	size_t r;
+	size_t i;
+
+	if (tx_new(bridge, &tx) != 0) {
+		goto error;
+	}
+	if (bridge->do_rx && rx_new(bridge, &rx) != 0) {
+		goto free_tx;
+	}
+
+	for (r = 0; r < repeat && !stop_bridge; ++r) {
+		for (i = 0; i < sdus->nr; ++i) {
+			const struct rle_sdu sdu = {
+				.buffer = sdus->data + i * RLE_MAX_PDU_SIZE,
+				.size = sdus->lens[i],
+				.protocol_type = sdus->ptypes[i],
+			};
+			const uint64_t fpdus_sent = counters->fpdus_sent;
+			const uint64_t sdus_rejected = counters->sdus_rejected;
+
+			counters->sdus_in++;
+			counters->sdu_bytes_in += sdu.size;
+			if (tx_push_sdu_timed(bridge, &tx, &sdu) != 0) {
+				goto free_rx;
+			}
+			if (bridge->do_rx && counters->sdus_rejected == sdus_rejected) {
+				counters->hash_in += hash_sdu(sdu.buffer, sdu.size);
+			}
+
+			/* drain the batch just sent before the socket buffer overflows */
+			if (bridge->do_rx && counters->fpdus_sent != fpdus_sent) {
+				while (counters->fpdus_recv < counters->fpdus_sent &&
+				       rx_poll(bridge, &rx, 1000) > 0) {
+				}
+			}
+		}
+	}
+
+	/* send what is left in the contexts, then the last batch */
+	tx_drain_timed(bridge, &tx);
+	if (bridge->do_rx) {
+		while (counters->fpdus_recv < counters->fpdus_sent && rx_poll(bridge, &rx, 1000) > 0) {
+		}
+	}
+
+	status = 0;
+
+free_rx:
+	if (bridge->do_rx) {
+		rx_del(&rx);
+	}
+free_tx:
+	tx_del(&tx);
+error:
+	return status;
+}
+
+/**
+ * @brief Bridge a TUN device, until it is closed or SIGINT
+ *
+ * @param bridge  The bridge
+ * @return        0 if OK, else 1
+ */
+static int run_tun(struct bridge *const bridge)
+{
+	struct counters *const counters = &bridge->counters;
+	unsigned char packet[RLE_MAX_PDU_SIZE];
+	struct tx tx;
+	struct rx rx;
+	int status = 1;
+
+	if (bridge->do_tx && tx_new(bridge, &tx) != 0) {
+		goto error;
+	}
+	if (bridge->do_rx && rx_new(bridge, &rx) != 0) {
+		goto free_tx;
+	}
+
+	while (!stop_bridge) {
+		struct pollfd pfds[2];
+		nfds_t nfds = 0;
+		uint64_t start;
+
+		if (bridge->do_tx) {
+			pfds[nfds].fd = bridge->tun_fd;
+			pfds[nfds].events = POLLIN;
+			nfds++;
+		}
+		if (bridge->do_rx) {
+			pfds[nfds].fd = bridge->rx_sock;
+			pfds[nfds].events = POLLIN;
+			nfds++;
+		}
+
+		if (poll(pfds, nfds, 100) < 0) {
+			break;
+		}
+
+		/* a batch of IP packets from the TUN device, then the FPDUs built so far */
+		if (bridge->do_tx && (pfds[0].revents & POLLIN)) {
+			size_t n;
+
+			for (n = 0; n < bridge->burst * bridge->contexts_nr; ++n) {
+				struct rle_sdu sdu = { .buffer = packet, .size = 0, .protocol_type = 0 };
+				ssize_t len;
+
+				start = now_ns();
+				len = read(bridge->tun_fd, packet, sizeof(packet));
+				counters->stage_ns[STAGE_SOURCE] += now_ns() - start;
+				if (len <= 0) {
+					break;
+				}
+				sdu.size = (size_t)len;
+				sdu.protocol_type = ((packet[0] >> 4) == 6 ? 0x86dd : 0x0800);
+				counters->sdus_in++;
+				counters->sdu_bytes_in += sdu.size;
+				if (tx_push_sdu_timed(bridge, &tx, &sdu) != 0) {
+					goto free_rx;
+				}
+
+				/* no more packet ready, do not wait for the next one */
+				if (poll(pfds, 1, 0) <= 0) {
+					break;
+				}
+			}
+			tx_drain_timed(bridge, &tx);
+		}
+
+		if (bridge->do_rx && (pfds[nfds - 1].revents & POLLIN)) {
+			while (rx_poll(bridge, &rx, 0) == bridge->burst) {
+			}
+		}
+	}
+
+	status = 0;
+
+free_rx:
+	if (bridge->do_rx) {
+		rx_del(&rx);
+	}
+free_tx:
+	if (bridge->do_tx) {
+		tx_del(&tx);
+	}
+error:
+	return status;
+}
+
+/**
+ * @brief Print the counters of the bridge
+ *
+ * @param bridge       The bridge
+ * @param duration_ns  The duration of the run, in nanoseconds
+ */
+static void print_counters(const struct bridge *const bridge, const uint64_t duration_ns)
+{
+	const struct counters *const counters = &bridge->counters;
+	const double duration_s = duration_ns / 1e9;
+	int stage;
+
+	printf("=== counters:\n");
+	printf("===\tsdus in:             %" PRIu64 " (%" PRIu64 " bytes, %" PRIu64 " rejected)\n",
+	       counters->sdus_in, counters->sdu_bytes_in, counters->sdus_rejected);
+	printf("===\tfpdus sent:          %" PRIu64 " (%" PRIu64 " bytes, %" PRIu64 " errors, "
+	       "%.1f per sendmmsg)\n", counters->fpdus_sent, counters->fpdu_bytes_sent,
+	       counters->send_errors,
+	       counters->send_calls ? (double)counters->fpdus_sent / counters->send_calls : 0.0);
+	printf("===\tfpdus received:      %" PRIu64 " (%" PRIu64 " decap errors, "
+	       "%.1f per recvmmsg)\n", counters->fpdus_recv, counters->decap_errors,
+	       counters->recv_calls ? (double)counters->fpdus_recv / counters->recv_calls : 0.0);
+	printf("===\tsdus out:            %" PRIu64 " (%" PRIu64 " bytes, %" PRIu64 " errors)\n",
+	       counters->sdus_out, counters->sdu_bytes_out, counters->sink_errors);
+	if (counters->fpdu_bytes_sent > 0) {
+		printf("===\tlink efficiency:     %.2f %%\n",
+		       100.0 * counters->sdu_bytes_in / counters->fpdu_bytes_sent);
+	}
+	printf("===\tduration:            %.3f s (%.1f Mb/s of SDUs)\n", duration_s,
+	       duration_s > 0 ? counters->sdu_bytes_in * 8 / duration_s / 1e6 : 0.0);
+
+	printf("=== %-8s %12s %12s\n", "stage", "total (ms)", "per sdu (ns)");
+	for (stage = 0; stage < STAGE_NB; ++stage) {
+		printf("=== %-8s %12.3f %12.1f\n", stage_names[stage], counters->stage_ns[stage] / 1e6,
+		       counters->sdus_in ? (double)counters->stage_ns[stage] / counters->sdus_in : 0.0);
+	}
+}
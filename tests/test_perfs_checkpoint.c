@@ -0,0 +1,362 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_perfs_checkpoint.c
+ * @brief  Checkpoint and restore time of many receivers in a shared memory region.
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#include "rle.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <getopt.h>
+#include <time.h>
+#include <sys/mman.h>
+
+/** The program version */
+#define TEST_VERSION  "RLE checkpoint performances test application, version 0.0.1\n"
+
+/** Default number of receivers */
+#define DEFAULT_RECEIVERS 100000
+
+/** Default number of rounds, the best one is kept */
+#define DEFAULT_ROUNDS 3
+
+/** Size of the FPDUs that start the SDUs in the receivers */
+#define FPDU_SIZE 600
+
+/** Size of the SDUs partially received */
+#define SDU_SIZE 1500
+
+/** Most contexts with a SDU partially received in a receiver */
+#define PARTIAL_CTX_MAX 2
+
+/* prototypes of private functions */
+static void usage(void);
+static int start_sdus(const struct rle_config *const conf,
+                      unsigned char fpdus[PARTIAL_CTX_MAX][FPDU_SIZE]);
+static double elapsed(const struct timespec *const start, const struct timespec *const end);
+
+/**
+ * @brief Main function for the RLE checkpoint performances test
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = 0,
+		.allow_alpdu_sequence_number = 1,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	static unsigned char fpdus[PARTIAL_CTX_MAX][FPDU_SIZE];
+	struct rle_receiver **receivers = NULL;
+	struct rle_receiver **standbys = NULL;
+	long receivers_nr = DEFAULT_RECEIVERS;
+	long rounds = DEFAULT_ROUNDS;
+	double best_checkpoint = 0.0;
+	double best_restore = 0.0;
+	unsigned char *region = MAP_FAILED;
+	size_t region_len = 0;
+	size_t used_len = 0;
+	int status = EXIT_FAILURE;
+	long round;
+	size_t i;
+
+	while (1) {
+		int c;
+
+		const char short_options[] = "vhr:n:";
+
+		const struct option long_options[] =
+		{
+			{ "receivers", required_argument, NULL, 'r' },
+			{ "rounds", required_argument, NULL, 'n' },
+			{ NULL, 0, NULL, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, short_options, long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 'r': /* Receivers */
+			assert(optarg != NULL);
+			receivers_nr = atol(optarg);
+			if (receivers_nr <= 0) {
+				printf("ERROR: number of receivers shall be strictly positive.\n");
+				goto error;
+			}
+			break;
+
+		case 'n': /* Rounds */
+			assert(optarg != NULL);
+			rounds = atol(optarg);
+			if (rounds <= 0) {
+				printf("ERROR: number of rounds shall be strictly positive.\n");
+				goto error;
+			}
+			break;
+
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (start_sdus(&conf, fpdus) != 0) {
+		goto error;
+	}
+
+	receivers = calloc(receivers_nr, sizeof(struct rle_receiver *));
+	standbys = calloc(receivers_nr, sizeof(struct rle_receiver *));
+	if (receivers == NULL || standbys == NULL) {
+		printf("failed to allocate %ld receivers\n", receivers_nr);
+		goto free_arrays;
+	}
+	if (rle_receiver_new_bulk(&conf, receivers_nr, RLE_NUMA_NODE_ANY, 0, receivers) != 0 ||
+	    rle_receiver_new_bulk(&conf, receivers_nr, RLE_NUMA_NODE_ANY, 0, standbys) != 0) {
+		printf("failed to create %ld receivers\n", receivers_nr);
+		goto destroy_receivers;
+	}
+
+	/* receiver i has SDUs partially received in (i % 3) contexts */
+	for (i = 0; i < (size_t)receivers_nr; ++i) {
+		size_t ctx;
+
+		for (ctx = 0; ctx < i % (PARTIAL_CTX_MAX + 1); ++ctx) {
+			struct rle_sdu sdu;
+			size_t sdus_nr;
+
+			if (rle_decapsulate(receivers[i], fpdus[ctx], FPDU_SIZE, &sdu, 1, &sdus_nr, NULL,
+			                    0) != RLE_DECAP_OK || sdus_nr != 0) {
+				printf("failed to start SDU in context %zu of receiver #%zu\n", ctx, i + 1);
+				goto destroy_receivers;
+			}
+		}
+		region_len += rle_receiver_checkpoint_size(receivers[i]);
+	}
+
+	region = mmap(NULL, region_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (region == MAP_FAILED) {
+		printf("failed to map %zu octets of shared memory\n", region_len);
+		goto destroy_receivers;
+	}
+	memset(region, 0, region_len);
+
+	printf("=== test:\n");
+	printf("===\tnumber of receivers: %ld, %d SDUs of %d octets started in 3\n", receivers_nr,
+	       PARTIAL_CTX_MAX, SDU_SIZE);
+	printf("===\tnumber of rounds:    %ld (best kept)\n", rounds);
+	printf("===\tcheckpoints:         %zu octets, %.1f octets per receiver\n", region_len,
+	       (double)region_len / receivers_nr);
+	printf("\n");
+
+	for (round = 0; round < rounds; ++round) {
+		struct timespec start;
+		struct timespec end;
+		size_t offset = 0;
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (i = 0; i < (size_t)receivers_nr; ++i) {
+			size_t written;
+
+			if (rle_receiver_checkpoint(receivers[i], region + offset, region_len - offset,
+			                            &written) != 0) {
+				printf("failed to checkpoint receiver #%zu\n", i + 1);
+				goto unmap_region;
+			}
+			offset += written;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		if (round == 0 || elapsed(&start, &end) < best_checkpoint) {
+			best_checkpoint = elapsed(&start, &end);
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (offset = 0, i = 0; i < (size_t)receivers_nr; ++i) {
+			size_t used;
+
+			if (rle_receiver_restore(standbys[i], region + offset, region_len - offset,
+			                         &used) != 0) {
+				printf("failed to restore receiver #%zu\n", i + 1);
+				goto unmap_region;
+			}
+			offset += used;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		if (round == 0 || elapsed(&start, &end) < best_restore) {
+			best_restore = elapsed(&start, &end);
+		}
+		used_len = offset;
+	}
+
+	/* the standbys are in the state of the receivers */
+	for (i = 0; i < (size_t)receivers_nr; ++i) {
+		if (rle_receiver_checkpoint_size(standbys[i]) !=
+		    rle_receiver_checkpoint_size(receivers[i])) {
+			printf("receiver #%zu not restored\n", i + 1);
+			goto unmap_region;
+		}
+	}
+	if (used_len != region_len) {
+		printf("%zu octets restored, %zu octets checkpointed\n", used_len, region_len);
+		goto unmap_region;
+	}
+
+	printf("=== checkpoint %10.3f ms %8.1f ns/receiver\n", best_checkpoint * 1e3,
+	       best_checkpoint * 1e9 / receivers_nr);
+	printf("=== restore    %10.3f ms %8.1f ns/receiver\n", best_restore * 1e3,
+	       best_restore * 1e9 / receivers_nr);
+
+	status = EXIT_SUCCESS;
+
+unmap_region:
+	munmap(region, region_len);
+destroy_receivers:
+	if (receivers[0] != NULL) {
+		rle_receiver_destroy_bulk(receivers, receivers_nr);
+	}
+	if (standbys[0] != NULL) {
+		rle_receiver_destroy_bulk(standbys, receivers_nr);
+	}
+free_arrays:
+	free(standbys);
+	free(receivers);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the performance test application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "RLE checkpoint performances tool: measure the time to checkpoint the state of\n"
+	        "receivers in a shared memory region, then to restore standby receivers from it.\n"
+	        "Two receivers out of three have SDUs partially received.\n"
+	        "\n"
+	        "usage: test_perfs_checkpoint [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -v                      Print version information and exit\n"
+	        "  -h                      Print this usage and exit\n"
+	        "  --receivers, -r         Number of receivers (default %d)\n"
+	        "  --rounds, -n            Number of rounds, the best one is kept (default %d)\n",
+	        DEFAULT_RECEIVERS, DEFAULT_ROUNDS);
+}
+
+
+/**
+ * @brief Build FPDUs with the START PPDU of a SDU, one FPDU per context
+ *
+ * @param conf   The configuration of the transmitter
+ * @param fpdus  The FPDUs
+ * @return       0 if OK, else 1
+ */
+static int start_sdus(const struct rle_config *const conf,
+                      unsigned char fpdus[PARTIAL_CTX_MAX][FPDU_SIZE])
+{
+	static unsigned char sdu_buffer[SDU_SIZE];
+	const struct rle_sdu sdu = {
+		.buffer = sdu_buffer, .size = SDU_SIZE, .protocol_type = 0x0800
+	};
+	struct rle_transmitter *transmitter;
+	int status = 1;
+	uint8_t frag_id;
+
+	memset(sdu_buffer, 0x42, sizeof(sdu_buffer));
+
+	transmitter = rle_transmitter_new(conf);
+	if (transmitter == NULL) {
+		printf("failed to create the transmitter\n");
+		goto error;
+	}
+
+	for (frag_id = 0; frag_id < PARTIAL_CTX_MAX; ++frag_id) {
+		unsigned char *ppdu;
+		size_t ppdu_len;
+		size_t fpdu_pos = 0;
+		size_t fpdu_remain = FPDU_SIZE;
+
+		if (rle_encapsulate(transmitter, &sdu, frag_id) != RLE_ENCAP_OK ||
+		    rle_fragment(transmitter, frag_id, fpdu_remain, &ppdu, &ppdu_len) != RLE_FRAG_OK ||
+		    rle_pack(ppdu, ppdu_len, NULL, 0, fpdus[frag_id], &fpdu_pos,
+		             &fpdu_remain) != RLE_PACK_OK) {
+			printf("failed to build the START PPDU of context %u\n", frag_id);
+			goto destroy_transmitter;
+		}
+		rle_pad(fpdus[frag_id], fpdu_pos, fpdu_remain);
+	}
+
+	status = 0;
+
+destroy_transmitter:
+	rle_transmitter_destroy(&transmitter);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Get the duration between two times
+ *
+ * @param start  The start time
+ * @param end    The end time
+ * @return       The duration, in seconds
+ */
+static double elapsed(const struct timespec *const start, const struct timespec *const end)
+{
+	return (end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) / 1e9;
+}
@@ -0,0 +1,431 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_perfs_cpp.cpp
+ * @brief  Encapsulation and decapsulation through the C++ header rle.hpp, compared to the same
+ *         work through the C functions of rle.h.
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#include "rle.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <getopt.h>
+#include <time.h>
+#include <vector>
+
+/** The program version */
+#define TEST_VERSION  "RLE C++ header performances test application, version 0.0.1\n"
+
+/** Default number of rounds, the best one is kept */
+#define DEFAULT_ROUNDS 5
+
+/** Default number of SDUs per round */
+#define DEFAULT_SDUS 100000
+
+/** Default FPDU size */
+#define DEFAULT_FPDU_SIZE 599
+
+/** Largest FPDU */
+#define MAX_FPDU_SIZE 4096
+
+/** Max number of SDUs decapsulated from one FPDU */
+#define MAX_SDUS_PER_FPDU 256
+
+/** The configuration of the test */
+using bench_config = rle::config<rle::protection::seqnum, true>;
+
+/** The outcome of one round, the same through the C and the C++ functions */
+struct outcome {
+	double duration;    /**< The duration of the round, in seconds */
+	size_t sdus;        /**< The number of SDUs decapsulated */
+	size_t octets;      /**< The number of SDU octets decapsulated */
+	uint32_t checksum;  /**< A checksum of the SDU octets decapsulated */
+};
+
+/* prototypes of private functions */
+static void usage(void);
+static double elapsed(const struct timespec *const start, const struct timespec *const end);
+static void account(struct outcome *const out, const unsigned char *const sdu, const size_t len);
+static bool round_c(const std::vector<std::vector<unsigned char>> &sdus, const size_t fpdu_size,
+                    struct outcome *const out);
+static bool round_cpp(const std::vector<std::vector<unsigned char>> &sdus, const size_t fpdu_size,
+                      struct outcome *const out);
+
+
+/**
+ * @brief Main function for the RLE C++ header performances test
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	/* IMIX-like sizes of the SDUs */
+	const size_t sizes[] = { 40, 40, 40, 40, 40, 40, 40, 576, 576, 576, 576, 1500 };
+	long rounds = DEFAULT_ROUNDS;
+	long sdus_nr = DEFAULT_SDUS;
+	long fpdu_size = DEFAULT_FPDU_SIZE;
+	std::vector<std::vector<unsigned char>> sdus;
+	struct outcome best_c = { 0.0, 0, 0, 0 };
+	struct outcome best_cpp = { 0.0, 0, 0, 0 };
+	int status = EXIT_FAILURE;
+	long round;
+	long i;
+
+	while (1) {
+		int c;
+
+		const char short_options[] = "vhn:s:f:";
+
+		const struct option long_options[] =
+		{
+			{ "rounds", required_argument, NULL, 'n' },
+			{ "sdus", required_argument, NULL, 's' },
+			{ "fpdu", required_argument, NULL, 'f' },
+			{ NULL, 0, NULL, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, short_options, long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 'n': /* Rounds */
+			assert(optarg != NULL);
+			rounds = atol(optarg);
+			if (rounds <= 0) {
+				printf("ERROR: number of rounds shall be strictly positive.\n");
+				goto error;
+			}
+			break;
+
+		case 's': /* SDUs */
+			assert(optarg != NULL);
+			sdus_nr = atol(optarg);
+			if (sdus_nr <= 0) {
+				printf("ERROR: number of SDUs shall be strictly positive.\n");
+				goto error;
+			}
+			break;
+
+		case 'f': /* FPDU size */
+			assert(optarg != NULL);
+			fpdu_size = atol(optarg);
+			if (fpdu_size < 3 || fpdu_size > MAX_FPDU_SIZE) {
+				printf("ERROR: FPDU size shall be in [3 ; %d].\n", MAX_FPDU_SIZE);
+				goto error;
+			}
+			break;
+
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	sdus.resize(sdus_nr);
+	for (i = 0; i < sdus_nr; ++i) {
+		const size_t size = sizes[i % (sizeof(sizes) / sizeof(sizes[0]))];
+		size_t j;
+
+		sdus[i].resize(size);
+		for (j = 0; j < size; ++j) {
+			sdus[i][j] = (unsigned char)(i + j * 3);
+		}
+		/* IPv4 */
+		sdus[i][0] = 0x45;
+	}
+
+	printf("=== test:\n");
+	printf("===\tnumber of rounds:    %ld (best kept)\n", rounds);
+	printf("===\tnumber of SDUs:      %ld\n", sdus_nr);
+	printf("===\tFPDU size:           %ld\n", fpdu_size);
+	printf("\n");
+
+	for (round = 0; round < rounds; ++round) {
+		struct outcome out_c = { 0.0, 0, 0, 0 };
+		struct outcome out_cpp = { 0.0, 0, 0, 0 };
+
+		if (!round_c(sdus, fpdu_size, &out_c) || !round_cpp(sdus, fpdu_size, &out_cpp)) {
+			goto error;
+		}
+		if (out_c.sdus != (size_t)sdus_nr || out_c.sdus != out_cpp.sdus ||
+		    out_c.octets != out_cpp.octets || out_c.checksum != out_cpp.checksum) {
+			printf("ERROR: %zu/%zu SDUs of %zu/%zu octets decapsulated through C/C++\n",
+			       out_c.sdus, out_cpp.sdus, out_c.octets, out_cpp.octets);
+			goto error;
+		}
+		if (round == 0 || out_c.duration < best_c.duration) {
+			best_c = out_c;
+		}
+		if (round == 0 || out_cpp.duration < best_cpp.duration) {
+			best_cpp = out_cpp;
+		}
+	}
+
+	printf("=== %-6s %12s %12s %12s\n", "API", "duration(ms)", "ns/SDU", "Mbit/s");
+	printf("=== %-6s %12.3f %12.1f %12.1f\n", "C", best_c.duration * 1e3,
+	       best_c.duration * 1e9 / sdus_nr, best_c.octets * 8 / best_c.duration / 1e6);
+	printf("=== %-6s %12.3f %12.1f %12.1f\n", "C++", best_cpp.duration * 1e3,
+	       best_cpp.duration * 1e9 / sdus_nr, best_cpp.octets * 8 / best_cpp.duration / 1e6);
+	printf("=== C++/C duration ratio: %.3f\n", best_cpp.duration / best_c.duration);
+
+	status = EXIT_SUCCESS;
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the performance test application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "RLE C++ header performances tool: encapsulate, fragment, pack and decapsulate\n"
+	        "IMIX-like SDUs through the C++ header rle.hpp and through the C functions,\n"
+	        "check that both give the same SDUs back and compare their durations.\n"
+	        "\n"
+	        "usage: test_perfs_cpp [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -v                      Print version information and exit\n"
+	        "  -h                      Print this usage and exit\n"
+	        "  --rounds, -n            Number of rounds, the best one is kept (default %d)\n"
+	        "  --sdus, -s              Number of SDUs per round (default %d)\n"
+	        "  --fpdu, -f              Size of the FPDUs (default %d)\n",
+	        DEFAULT_ROUNDS, DEFAULT_SDUS, DEFAULT_FPDU_SIZE);
+}
+
+
+/**
+ * @brief Get the duration between two instants
+ *
+ * @param start  The first instant
+ * @param end    The last instant
+ * @return       The duration in seconds
+ */
+static double elapsed(const struct timespec *const start, const struct timespec *const end)
+{
+	return (end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+
+/**
+ * @brief Account a decapsulated SDU in the outcome of a round
+ *
+ * @param out  The outcome of the round
+ * @param sdu  The SDU
+ * @param len  The length of the SDU
+ */
+static void account(struct outcome *const out, const unsigned char *const sdu, const size_t len)
+{
+	size_t i;
+
+	out->sdus++;
+	out->octets += len;
+	for (i = 0; i < len; i += 64) {
+		out->checksum = out->checksum * 31 + sdu[i];
+	}
+	out->checksum = out->checksum * 31 + sdu[len - 1];
+}
+
+
+/**
+ * @brief Run one round through the C functions
+ *
+ * @param sdus       The SDUs to encapsulate
+ * @param fpdu_size  The size of the FPDUs
+ * @param out        The outcome of the round
+ * @return           true if OK, else false
+ */
+static bool round_c(const std::vector<std::vector<unsigned char>> &sdus, const size_t fpdu_size,
+                    struct outcome *const out)
+{
+	struct rle_transmitter *transmitter = rle_transmitter_new(&bench_config::c_config);
+	struct rle_receiver *receiver = rle_receiver_new(&bench_config::c_config);
+	std::vector<unsigned char> storage(MAX_SDUS_PER_FPDU * rle::max_sdu_size);
+	struct rle_sdu sdus_out[MAX_SDUS_PER_FPDU];
+	unsigned char fpdu[MAX_FPDU_SIZE];
+	size_t fpdu_pos = 0;
+	size_t fpdu_remain = fpdu_size;
+	struct timespec start;
+	struct timespec end;
+	bool is_ok = false;
+	size_t i;
+
+	if (transmitter == NULL || receiver == NULL) {
+		printf("failed to create the C transmitter or receiver\n");
+		goto out;
+	}
+	for (i = 0; i < MAX_SDUS_PER_FPDU; ++i) {
+		sdus_out[i].buffer = storage.data() + i * rle::max_sdu_size;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i <= sdus.size(); ++i) {
+		bool is_last = (i == sdus.size());
+
+		if (!is_last) {
+			const struct rle_sdu sdu = {
+				const_cast<unsigned char *>(sdus[i].data()), sdus[i].size(), 0x0800
+			};
+
+			if (rle_encapsulate(transmitter, &sdu, 0) != RLE_ENCAP_OK) {
+				printf("failed to encapsulate SDU #%zu through C\n", i + 1);
+				goto out;
+			}
+		}
+
+		while (rle_transmitter_stats_get_queue_size(transmitter, 0) > 0 ||
+		       (is_last && fpdu_pos > 0)) {
+			unsigned char *ppdu;
+			size_t ppdu_len;
+			size_t sdus_nr = 0;
+			size_t j;
+
+			if (rle_transmitter_stats_get_queue_size(transmitter, 0) > 0 && fpdu_remain > 2 &&
+			    rle_fragment(transmitter, 0, fpdu_remain, &ppdu, &ppdu_len) == RLE_FRAG_OK) {
+				if (rle_pack(ppdu, ppdu_len, NULL, 0, fpdu, &fpdu_pos,
+				             &fpdu_remain) != RLE_PACK_OK) {
+					printf("failed to pack PPDU through C\n");
+					goto out;
+				}
+				continue;
+			}
+
+			/* FPDU full */
+			rle_pad(fpdu, fpdu_pos, fpdu_remain);
+			if (rle_decapsulate(receiver, fpdu, fpdu_size, sdus_out, MAX_SDUS_PER_FPDU,
+			                    &sdus_nr, NULL, 0) != RLE_DECAP_OK) {
+				printf("failed to decapsulate FPDU through C\n");
+				goto out;
+			}
+			for (j = 0; j < sdus_nr; ++j) {
+				account(out, sdus_out[j].buffer, sdus_out[j].size);
+			}
+			fpdu_pos = 0;
+			fpdu_remain = fpdu_size;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	out->duration = elapsed(&start, &end);
+
+	is_ok = true;
+
+out:
+	if (transmitter != NULL) {
+		rle_transmitter_destroy(&transmitter);
+	}
+	if (receiver != NULL) {
+		rle_receiver_destroy(&receiver);
+	}
+	return is_ok;
+}
+
+
+/**
+ * @brief Run one round through the C++ header
+ *
+ * @param sdus       The SDUs to encapsulate
+ * @param fpdu_size  The size of the FPDUs
+ * @param out        The outcome of the round
+ * @return           true if OK, else false
+ */
+static bool round_cpp(const std::vector<std::vector<unsigned char>> &sdus, const size_t fpdu_size,
+                      struct outcome *const out)
+{
+	rle::transmitter<bench_config> transmitter;
+	rle::receiver<bench_config> receiver;
+	rle::sdu_batch<MAX_SDUS_PER_FPDU> batch;
+	rle::frame<bench_config, MAX_FPDU_SIZE> fpdu(fpdu_size);
+	size_t used = 0;
+	struct timespec start;
+	struct timespec end;
+	size_t i;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i <= sdus.size(); ++i) {
+		bool is_last = (i == sdus.size());
+
+		if (!is_last && transmitter.encapsulate(0, sdus[i], 0x0800) != rle::encap_status::ok) {
+			printf("failed to encapsulate SDU #%zu through C++\n", i + 1);
+			return false;
+		}
+
+		while (transmitter.queue_size(0) > 0 || (is_last && used > 0)) {
+			std::span<const unsigned char> ppdu;
+			const size_t remain = fpdu.remaining();
+
+			if (transmitter.queue_size(0) > 0 && remain > 2 &&
+			    transmitter.fragment(0, remain, ppdu) == rle::frag_status::ok) {
+				if (fpdu.pack(ppdu) != rle::pack_status::ok) {
+					printf("failed to pack PPDU through C++\n");
+					return false;
+				}
+				used += ppdu.size();
+				continue;
+			}
+
+			/* FPDU full */
+			fpdu.pad();
+			if (receiver.decapsulate(fpdu.data(), batch) !=
+			    rle::decap_status::ok) {
+				printf("failed to decapsulate FPDU through C++\n");
+				return false;
+			}
+			for (const rle::sdu_view sdu : batch) {
+				account(out, sdu.data.data(), sdu.data.size());
+			}
+			fpdu.clear();
+			used = 0;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	out->duration = elapsed(&start, &end);
+
+	return true;
+}
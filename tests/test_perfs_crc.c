@@ -0,0 +1,356 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_perfs_crc.c
+ * @brief  Encapsulation time of IMIX batches of SDUs with ALPDU CRC, one by one or in bulk.
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#include "rle.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <getopt.h>
+#include <time.h>
+
+/** The program version */
+#define TEST_VERSION  "RLE CRC performances test application, version 0.0.1\n"
+
+/** Default number of batches */
+#define DEFAULT_BATCHES 20000
+
+/** Default number of rounds, the best one is kept */
+#define DEFAULT_ROUNDS 3
+
+/** Burst size used to empty the contexts, the long SDUs are fragmented */
+#define DRAIN_BURST_SIZE 1000
+
+/** Number of SDUs of different lengths in the IMIX */
+#define IMIX_SDUS_NR 12
+
+/** Simple IMIX: 7 SDUs of 40 octets, 4 of 576 and 1 of 1500 */
+static const size_t imix_lens[IMIX_SDUS_NR] = {
+	40, 40, 40, 40, 40, 40, 40, 576, 576, 576, 576, 1500
+};
+
+/** The SDUs of the batches */
+struct batches {
+	struct rle_sdu *sdus;  /**< The SDUs, RLE_MAX_FRAG_NUMBER per batch */
+	size_t nr;             /**< The number of batches */
+	size_t bytes;          /**< The octets of all the SDUs */
+};
+
+/* prototypes of private functions */
+static void usage(void);
+static int build_batches(struct batches *const batches, const size_t nr);
+static void free_batches(struct batches *const batches);
+static int bench(const struct rle_config *const conf, const struct batches *const batches,
+                 const bool is_bulk, double *const duration);
+
+/**
+ * @brief Main function for the RLE CRC performances test
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = 1,
+		.allow_alpdu_sequence_number = 0,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	struct batches batches = { NULL, 0, 0 };
+	long batches_nr = DEFAULT_BATCHES;
+	long rounds = DEFAULT_ROUNDS;
+	double best[2] = { 0.0, 0.0 };
+	int status = EXIT_FAILURE;
+	int is_bulk;
+
+	while (1) {
+		int c;
+
+		const char short_options[] = "vhb:n:";
+
+		const struct option long_options[] =
+		{
+			{ "batches", required_argument, NULL, 'b' },
+			{ "rounds", required_argument, NULL, 'n' },
+			{ NULL, 0, NULL, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, short_options, long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 'b': /* Batches */
+			assert(optarg != NULL);
+			batches_nr = atol(optarg);
+			if (batches_nr <= 0) {
+				printf("ERROR: number of batches shall be strictly positive.\n");
+				goto error;
+			}
+			break;
+
+		case 'n': /* Rounds */
+			assert(optarg != NULL);
+			rounds = atol(optarg);
+			if (rounds <= 0) {
+				printf("ERROR: number of rounds shall be strictly positive.\n");
+				goto error;
+			}
+			break;
+
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (build_batches(&batches, (size_t)batches_nr) != 0) {
+		goto error;
+	}
+
+	printf("=== test:\n");
+	printf("===\tnumber of batches:   %zu of %d SDUs (IMIX 40/576/1500 7:4:1)\n", batches.nr,
+	       RLE_MAX_FRAG_NUMBER);
+	printf("===\tnumber of rounds:    %ld (best kept)\n", rounds);
+	printf("\n");
+
+	for (is_bulk = 0; is_bulk <= 1; ++is_bulk) {
+		long round;
+
+		for (round = 0; round < rounds; ++round) {
+			double duration;
+
+			if (bench(&conf, &batches, is_bulk, &duration) != 0) {
+				goto free_batches;
+			}
+			if (round == 0 || duration < best[is_bulk]) {
+				best[is_bulk] = duration;
+			}
+		}
+		printf("=== %-8s %10.1f ns/SDU %8.3f ns/octet\n", is_bulk ? "bulk" : "one/one",
+		       best[is_bulk] * 1e9 / (batches.nr * RLE_MAX_FRAG_NUMBER),
+		       best[is_bulk] * 1e9 / batches.bytes);
+	}
+	printf("=== speedup of bulk encapsulation: %.2f\n", best[0] / best[1]);
+
+	status = EXIT_SUCCESS;
+
+free_batches:
+	free_batches(&batches);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the performance test application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "RLE CRC performances tool: measure the encapsulation time of batches of IMIX\n"
+	        "SDUs with ALPDU CRC, one SDU after the other with rle_encapsulate, then all the\n"
+	        "SDUs of a batch at once with rle_encapsulate_bulk that computes their CRC side\n"
+	        "by side. A batch fills all the contexts of a transmitter.\n"
+	        "\n"
+	        "usage: test_perfs_crc [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -v                      Print version information and exit\n"
+	        "  -h                      Print this usage and exit\n"
+	        "  --batches, -b           Number of batches (default %d)\n"
+	        "  --rounds, -n            Number of rounds, the best one is kept (default %d)\n",
+	        DEFAULT_BATCHES, DEFAULT_ROUNDS);
+}
+
+
+/**
+ * @brief Build batches of IMIX SDUs in a random order
+ *
+ * @param batches  The batches
+ * @param nr       The number of batches
+ * @return         0 if OK, else 1
+ */
+static int build_batches(struct batches *const batches, const size_t nr)
+{
+	const size_t sdus_nr = nr * RLE_MAX_FRAG_NUMBER;
+	unsigned int seed = 42;
+	size_t i;
+
+	batches->sdus = calloc(sdus_nr, sizeof(struct rle_sdu));
+	if (batches->sdus == NULL) {
+		printf("failed to allocate %zu SDUs\n", sdus_nr);
+		return 1;
+	}
+	batches->nr = nr;
+	batches->bytes = 0;
+
+	for (i = 0; i < sdus_nr; ++i) {
+		struct rle_sdu *const sdu = &batches->sdus[i];
+		size_t j;
+
+		seed = seed * 1103515245U + 12345U;
+		sdu->size = imix_lens[(seed >> 16) % IMIX_SDUS_NR];
+		sdu->protocol_type = 0x0800;
+		sdu->buffer = malloc(sdu->size);
+		if (sdu->buffer == NULL) {
+			printf("failed to allocate SDU #%zu\n", i + 1);
+			free_batches(batches);
+			return 1;
+		}
+		for (j = 0; j < sdu->size; ++j) {
+			sdu->buffer[j] = (unsigned char)(i + j);
+		}
+		batches->bytes += sdu->size;
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief Free batches of SDUs
+ *
+ * @param batches  The batches
+ */
+static void free_batches(struct batches *const batches)
+{
+	size_t i;
+
+	for (i = 0; i < batches->nr * RLE_MAX_FRAG_NUMBER; ++i) {
+		free(batches->sdus[i].buffer);
+	}
+	free(batches->sdus);
+	batches->sdus = NULL;
+	batches->nr = 0;
+}
+
+
+/**
+ * @brief Encapsulate batches of SDUs, one by one or in bulk, and measure the duration
+ *
+ * The contexts are emptied after each batch, out of the measure.
+ *
+ * @param conf      The configuration of the transmitter
+ * @param batches   The batches
+ * @param is_bulk   Whether to encapsulate the SDUs of a batch in bulk
+ * @param duration  The duration of the encapsulations, in seconds
+ * @return          0 if OK, else 1
+ */
+static int bench(const struct rle_config *const conf, const struct batches *const batches,
+                 const bool is_bulk, double *const duration)
+{
+	uint8_t frag_ids[RLE_MAX_FRAG_NUMBER];
+	struct rle_transmitter *transmitter;
+	int status = 1;
+	size_t batch;
+	size_t i;
+
+	for (i = 0; i < RLE_MAX_FRAG_NUMBER; ++i) {
+		frag_ids[i] = (uint8_t)i;
+	}
+
+	transmitter = rle_transmitter_new(conf);
+	if (transmitter == NULL) {
+		printf("failed to create the transmitter\n");
+		goto error;
+	}
+
+	*duration = 0.0;
+	for (batch = 0; batch < batches->nr; ++batch) {
+		const struct rle_sdu *const sdus = &batches->sdus[batch * RLE_MAX_FRAG_NUMBER];
+		struct timespec start;
+		struct timespec end;
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		if (is_bulk) {
+			size_t encap_nr;
+
+			if (rle_encapsulate_bulk(transmitter, sdus, frag_ids, RLE_MAX_FRAG_NUMBER,
+			                         &encap_nr) != RLE_ENCAP_OK) {
+				printf("failed to encapsulate batch #%zu in bulk\n", batch + 1);
+				goto destroy_transmitter;
+			}
+		} else {
+			for (i = 0; i < RLE_MAX_FRAG_NUMBER; ++i) {
+				if (rle_encapsulate(transmitter, &sdus[i], frag_ids[i]) != RLE_ENCAP_OK) {
+					printf("failed to encapsulate batch #%zu\n", batch + 1);
+					goto destroy_transmitter;
+				}
+			}
+		}
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		*duration += (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+		for (i = 0; i < RLE_MAX_FRAG_NUMBER; ++i) {
+			while (rle_transmitter_stats_get_queue_size(transmitter, frag_ids[i]) > 0) {
+				unsigned char *ppdu;
+				size_t ppdu_len;
+
+				if (rle_fragment(transmitter, frag_ids[i], DRAIN_BURST_SIZE, &ppdu,
+				                 &ppdu_len) != RLE_FRAG_OK) {
+					printf("failed to fragment batch #%zu\n", batch + 1);
+					goto destroy_transmitter;
+				}
+			}
+		}
+	}
+
+	status = 0;
+
+destroy_transmitter:
+	rle_transmitter_destroy(&transmitter);
+error:
+	return status;
+}
@@ -0,0 +1,563 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_perfs_decap_errors.c
+ * @brief  Decapsulation throughput on malformed FPDUs, with and without error trace rate limiting.
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#include "rle.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include <assert.h>
+#include <getopt.h>
+#include <time.h>
+#include <pcap/pcap.h>
+#include <pcap.h>
+
+/** The program version */
+#define TEST_VERSION  "RLE decapsulation errors performances test application, version 0.0.1\n"
+
+/** The length (in bytes) of the Ethernet header */
+#define ETHER_HDR_LEN  14U
+
+/** Max number of SDUs decapsulated from one FPDU */
+#define MAX_SDUS_NB    100
+
+/** Max SDU len */
+#define MAX_SDU_LEN    4088
+
+/** Payload label length of the FPDUs of the samples */
+#define PAYLOAD_LABEL_LEN 3
+
+/** Default number of rounds over the FPDUs */
+#define DEFAULT_ROUNDS 100
+
+/** Names of the receiver error types */
+static const char *const decap_error_names[RLE_DECAP_ERROR_NB] = {
+	[RLE_DECAP_ERROR_INV_LEN] = "invalid length",
+	[RLE_DECAP_ERROR_CTX_STATE] = "context state",
+	[RLE_DECAP_ERROR_CRC] = "CRC mismatch",
+	[RLE_DECAP_ERROR_SEQNUM] = "seqnum gap",
+	[RLE_DECAP_ERROR_TRAILER_SHORT] = "trailer too short",
+	[RLE_DECAP_ERROR_ALPDU_HDR] = "ALPDU header",
+	[RLE_DECAP_ERROR_VLAN] = "VLAN",
+	[RLE_DECAP_ERROR_SDUS_FULL] = "SDUs full",
+	[RLE_DECAP_ERROR_PADDING] = "padding",
+};
+
+/** A flow of FPDUs loaded in memory */
+struct fpdus {
+	unsigned char **data;           /**< The FPDUs */
+	size_t *lengths;                /**< The FPDUs lengths */
+	bool *mapped;                   /**< Whether the FPDUs lie in a trace, not in own copies */
+	size_t nr;                      /**< The number of FPDUs */
+	struct rle_fpdu_trace **traces; /**< The traces the mapped FPDUs lie in */
+	size_t traces_nr;               /**< The number of traces */
+};
+
+/* prototypes of private functions */
+static void usage(void);
+static int load_fpdus(const char *const src_filename, struct fpdus *const fpdus);
+static int load_fpdu_trace(struct rle_fpdu_trace *trace, struct fpdus *const fpdus);
+static int append_fpdu(struct fpdus *const fpdus, unsigned char *const data, const size_t length,
+                       const bool mapped);
+static void free_fpdus(struct fpdus *const fpdus);
+static int bench_decap(const struct fpdus *const fpdus, const struct rle_config *const conf,
+                       const size_t rounds, const bool rate_limit, FILE *const log_file,
+                       double *const duration, size_t *const failures,
+                       struct rle_receiver_error_stats *const stats);
+static void log_error(void *const priv, const int module_id, const int level,
+                      const char *const file, const int line, const char *const func,
+                      const char *const message, ...);
+
+/** Buffers of the decapsulated SDUs */
+static unsigned char sdu_buffers[MAX_SDUS_NB][MAX_SDU_LEN];
+static struct rle_sdu sdus_out[MAX_SDUS_NB];
+
+/**
+ * @brief Main function for the RLE decapsulation errors performances test
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	struct rle_config conf_comp = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = 0,
+		.allow_alpdu_sequence_number = 1,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	struct fpdus fpdus = { NULL, NULL, NULL, 0, NULL, 0 };
+	const char *log_filename = "/dev/null";
+	FILE *log_file = NULL;
+	long rounds = DEFAULT_ROUNDS;
+	int status = EXIT_FAILURE;
+	int i;
+
+	while (1) {
+		int c;
+
+		const char short_options[] = "vhn:l:";
+
+		const struct option long_options[] =
+		{
+			{ "rounds", required_argument, NULL, 'n' },
+			{ "log", required_argument, NULL, 'l' },
+			{ NULL, 0, NULL, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, short_options, long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 'n': /* Rounds */
+			assert(optarg != NULL);
+			rounds = atol(optarg);
+			if (rounds <= 0) {
+				printf("ERROR: number of rounds shall be strictly positive.\n");
+				goto error;
+			}
+			break;
+
+		case 'l': /* Log file */
+			assert(optarg != NULL);
+			log_filename = optarg;
+			break;
+
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (optind >= argc) {
+		fprintf(stderr, "FLOW is a mandatory parameter\n\n");
+		usage();
+		goto error;
+	}
+
+	/* fuzzed captures may be unreadable, skip them */
+	for (i = optind; i < argc; ++i) {
+		if (load_fpdus(argv[i], &fpdus) != 0) {
+			printf("skip '%s'\n", argv[i]);
+		}
+	}
+	if (fpdus.nr == 0) {
+		printf("no FPDU to decapsulate\n");
+		goto free_fpdus;
+	}
+
+	log_file = fopen(log_filename, "w");
+	if (log_file == NULL) {
+		printf("failed to open the log file '%s'\n", log_filename);
+		goto free_fpdus;
+	}
+
+	for (i = 0; i < (int)(sizeof(sdus_out) / sizeof(*sdus_out)); ++i) {
+		sdus_out[i].buffer = sdu_buffers[i];
+	}
+
+	printf("=== test:\n");
+	printf("===\tnumber of fpdus:     %zu\n", fpdus.nr);
+	printf("===\tnumber of rounds:    %ld\n", rounds);
+	printf("===\terror traces:        %s\n", log_filename);
+	printf("\n");
+
+	{
+		const bool rate_limits[] = { false, true };
+		double durations[2];
+		size_t mode;
+
+		for (mode = 0; mode < 2; ++mode) {
+			struct rle_receiver_error_stats stats;
+			size_t failures;
+			size_t type;
+
+			if (bench_decap(&fpdus, &conf_comp, rounds, rate_limits[mode], log_file,
+			                &durations[mode], &failures, &stats) != 0) {
+				goto close_log;
+			}
+
+			printf("=== %s:\n", rate_limits[mode] ? "rate-limited error traces" :
+			       "all error traces");
+			printf("===\tduration:            %.3f s\n", durations[mode]);
+			printf("===\tthroughput:          %.0f FPDU/s\n",
+			       (double)(fpdus.nr * rounds) / durations[mode]);
+			printf("===\tfailed FPDUs:        %zu\n", failures);
+			for (type = 0; type < RLE_DECAP_ERROR_NB; ++type) {
+				printf("===\t%-20s %" PRIu64 "\n", decap_error_names[type], stats.errors[type]);
+			}
+			printf("===\ttraces suppressed:   %" PRIu64 "\n", stats.traces_suppressed);
+			printf("\n");
+		}
+
+		printf("=== speedup with rate limiting: %.2f\n", durations[0] / durations[1]);
+	}
+
+	status = EXIT_SUCCESS;
+
+close_log:
+	fclose(log_file);
+free_fpdus:
+	free_fpdus(&fpdus);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the performance test application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "RLE decapsulation errors performances tool: measure the decapsulation\n"
+	        "throughput on flows of malformed FPDUs, with every error traced then with\n"
+	        "rate-limited error traces. Run it on a clean flow for the reference rate.\n"
+	        "\n"
+	        "usage: test_perfs_decap_errors [OPTIONS] FLOW...\n"
+	        "\n"
+	        "with:\n"
+	        "  FLOW                    The flows of FPDU to decapsulate\n"
+	        "                          (in PCAP format, with Ethernet linklayer, or\n"
+	        "                          FPDU traces, see test_fpdu_trace_convert),\n"
+	        "                          tests/samples/fuzzing-fpdu/*.pcap for example\n"
+	        "\n"
+	        "options:\n"
+	        "  -v                      Print version information and exit\n"
+	        "  -h                      Print this usage and exit\n"
+	        "  --rounds, -n            Number of rounds over the FPDUs (default %d)\n"
+	        "  --log, -l               File written by the error traces (default /dev/null)\n",
+	        DEFAULT_ROUNDS);
+}
+
+
+/**
+ * @brief Append the FPDUs of a PCAP file or of a FPDU trace to a flow
+ *
+ * @param src_filename  The name of the PCAP file or FPDU trace
+ * @param fpdus         The flow
+ * @return              0 if OK, else 1
+ */
+static int load_fpdus(const char *const src_filename, struct fpdus *const fpdus)
+{
+	char errbuf[PCAP_ERRBUF_SIZE];
+	struct pcap_pkthdr header;
+	struct rle_fpdu_trace *trace;
+	const unsigned char *packet;
+	pcap_t *handle;
+	int status = 1;
+
+	/* the FPDUs of a trace are decapsulated in its mapping, without copy */
+	trace = rle_fpdu_trace_open(src_filename);
+	if (trace != NULL) {
+		return load_fpdu_trace(trace, fpdus);
+	}
+
+	handle = pcap_open_offline(src_filename, errbuf);
+	if (handle == NULL) {
+		printf("failed to open the source pcap file: %s\n", errbuf);
+		goto error;
+	}
+
+	if (pcap_datalink(handle) != DLT_EN10MB) {
+		printf("link layer type %d not supported in source dump (supported = %d)\n",
+		       pcap_datalink(handle), DLT_EN10MB);
+		goto close_input;
+	}
+
+	while ((packet = pcap_next(handle, &header)) != NULL) {
+		unsigned char *data;
+		size_t length;
+
+		if (header.len <= ETHER_HDR_LEN || header.len != header.caplen) {
+			continue;
+		}
+		length = header.len - ETHER_HDR_LEN;
+
+		data = malloc(length);
+		if (data == NULL) {
+			printf("failed to allocate a FPDU\n");
+			goto close_input;
+		}
+		memcpy(data, packet + ETHER_HDR_LEN, length);
+		if (append_fpdu(fpdus, data, length, false) != 0) {
+			free(data);
+			goto close_input;
+		}
+	}
+
+	status = 0;
+
+close_input:
+	pcap_close(handle);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Append the FPDUs of a FPDU trace to a flow, the trace is then owned by the flow
+ *
+ * @param trace  The FPDU trace
+ * @param fpdus  The flow
+ * @return       0 if OK, else 1
+ */
+static int load_fpdu_trace(struct rle_fpdu_trace *trace, struct fpdus *const fpdus)
+{
+	struct rle_fpdu_trace **traces;
+	size_t i;
+
+	traces = realloc(fpdus->traces, (fpdus->traces_nr + 1) * sizeof(struct rle_fpdu_trace *));
+	if (traces == NULL) {
+		printf("failed to allocate FPDU traces\n");
+		rle_fpdu_trace_close(&trace);
+		return 1;
+	}
+	fpdus->traces = traces;
+	fpdus->traces[fpdus->traces_nr] = trace;
+	fpdus->traces_nr++;
+
+	for (i = 0; i < rle_fpdu_trace_count(trace); ++i) {
+		const struct rle_fpdu_trace_record *record;
+		unsigned char *fpdu;
+
+		record = rle_fpdu_trace_get(trace, i, &fpdu);
+		if (record->label_len != PAYLOAD_LABEL_LEN) {
+			printf("skip record %zu with a %u-octet Payload Label\n", i, record->label_len);
+			continue;
+		}
+		if (append_fpdu(fpdus, fpdu, record->fpdu_len, true) != 0) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief Append one FPDU to a flow
+ *
+ * @param fpdus   The flow
+ * @param data    The FPDU
+ * @param length  The FPDU length
+ * @param mapped  Whether the FPDU lies in a trace, not in an own copy
+ * @return        0 if OK, else 1
+ */
+static int append_fpdu(struct fpdus *const fpdus, unsigned char *const data, const size_t length,
+                       const bool mapped)
+{
+	unsigned char **datas;
+	size_t *lengths;
+	bool *mappeds;
+
+	datas = realloc(fpdus->data, (fpdus->nr + 1) * sizeof(unsigned char *));
+	if (datas == NULL) {
+		printf("failed to allocate FPDUs\n");
+		return 1;
+	}
+	fpdus->data = datas;
+	lengths = realloc(fpdus->lengths, (fpdus->nr + 1) * sizeof(size_t));
+	if (lengths == NULL) {
+		printf("failed to allocate FPDUs lengths\n");
+		return 1;
+	}
+	fpdus->lengths = lengths;
+	mappeds = realloc(fpdus->mapped, (fpdus->nr + 1) * sizeof(bool));
+	if (mappeds == NULL) {
+		printf("failed to allocate FPDUs origins\n");
+		return 1;
+	}
+	fpdus->mapped = mappeds;
+
+	fpdus->data[fpdus->nr] = data;
+	fpdus->lengths[fpdus->nr] = length;
+	fpdus->mapped[fpdus->nr] = mapped;
+	fpdus->nr++;
+
+	return 0;
+}
+
+
+/**
+ * @brief Free a flow of FPDUs
+ *
+ * @param fpdus  The flow
+ */
+static void free_fpdus(struct fpdus *const fpdus)
+{
+	size_t i;
+
+	for (i = 0; i < fpdus->nr; ++i) {
+		if (!fpdus->mapped[i]) {
+			free(fpdus->data[i]);
+		}
+	}
+	free(fpdus->data);
+	free(fpdus->lengths);
+	free(fpdus->mapped);
+	for (i = 0; i < fpdus->traces_nr; ++i) {
+		rle_fpdu_trace_close(&fpdus->traces[i]);
+	}
+	free(fpdus->traces);
+}
+
+
+/**
+ * @brief Decapsulate a flow of FPDUs several times and measure the duration
+ *
+ * @param fpdus       The flow
+ * @param conf        The configuration of the receiver
+ * @param rounds      The number of rounds over the flow
+ * @param rate_limit  Whether the error traces are rate-limited
+ * @param log_file    The file written by the error traces
+ * @param duration    The duration of the decapsulation, in seconds
+ * @param failures    The number of FPDUs whose decapsulation failed
+ * @param stats       The error counters of the receiver
+ * @return            0 if OK, else 1
+ */
+static int bench_decap(const struct fpdus *const fpdus, const struct rle_config *const conf,
+                       const size_t rounds, const bool rate_limit, FILE *const log_file,
+                       double *const duration, size_t *const failures,
+                       struct rle_receiver_error_stats *const stats)
+{
+	unsigned char label[PAYLOAD_LABEL_LEN];
+	struct rle_receiver *receiver;
+	struct timespec start;
+	struct timespec end;
+	size_t round;
+	int status = 1;
+
+	receiver = rle_receiver_new(conf);
+	if (receiver == NULL) {
+		printf("failed to create the receiver\n");
+		goto error;
+	}
+
+	rle_receiver_set_trace_callback(receiver, log_error, log_file, RLE_LOG_LEVEL_WARNING);
+	if (rate_limit) {
+		rle_receiver_set_error_trace_rate(receiver, RLE_ERROR_TRACE_RATE_DEFAULT,
+		                                  RLE_ERROR_TRACE_BURST_DEFAULT);
+	} else {
+		rle_receiver_set_error_trace_rate(receiver, 0, 0);
+	}
+
+	*failures = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (round = 0; round < rounds; ++round) {
+		size_t i;
+
+		for (i = 0; i < fpdus->nr; ++i) {
+			size_t sdus_nr = 0;
+
+			/* malformed FPDUs are expected, they are only counted */
+			if (rle_decapsulate(receiver, fpdus->data[i], fpdus->lengths[i], sdus_out,
+			                    MAX_SDUS_NB, &sdus_nr, label, PAYLOAD_LABEL_LEN) != RLE_DECAP_OK) {
+				(*failures)++;
+			}
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	*duration = (double)(end.tv_sec - start.tv_sec) +
+	            (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+	if (rle_receiver_stats_get_errors(receiver, stats) != 0) {
+		printf("failed to get receiver error counters\n");
+		goto destroy_receiver;
+	}
+
+	status = 0;
+
+destroy_receiver:
+	rle_receiver_destroy(&receiver);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Format the error traces of the library and write them in the log file
+ *
+ * @param priv       The log file
+ * @param module_id  The library module
+ * @param level      The log level
+ * @param file       The source file
+ * @param line       The source line
+ * @param func       The function
+ * @param message    The message format
+ * @param ...        The message arguments
+ */
+static void log_error(void *const priv, const int module_id, const int level,
+                      const char *const file, const int line, const char *const func,
+                      const char *const message, ...)
+{
+	FILE *const log_file = (FILE *)priv;
+	char buffer[1024];
+	va_list args;
+	int len;
+
+	len = snprintf(buffer, sizeof(buffer), "[%d][%d] %s:%d %s: ", module_id, level, file,
+	               line, func);
+	va_start(args, message);
+	if (len >= 0 && (size_t)len < sizeof(buffer)) {
+		vsnprintf(buffer + len, sizeof(buffer) - len, message, args);
+	}
+	va_end(args);
+
+	fputs(buffer, log_file);
+	fputc('\n', log_file);
+}
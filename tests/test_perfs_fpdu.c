@@ -544,6 +544,10 @@ static char * str_decap_error(const enum rle_decap_status status)
 	case RLE_DECAP_ERR_INV_PL:
 		return "[RLE_DECAP_ERR_INV_PL] Error. Given preallocated payload label array is "
 		       "invalid";
+	case RLE_DECAP_FILTERED:
+		return "[RLE_DECAP_FILTERED] Ok. Payload label not accepted, FPDU dropped unparsed.";
+	case RLE_DECAP_ARENA_FULL:
+		return "[RLE_DECAP_ARENA_FULL] Ok. The SDU arena is full, FPDU to be resumed.";
 	default:
 		return "[Unknwon RLE_DECAP status]";
 	}
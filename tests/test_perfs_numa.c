@@ -0,0 +1,624 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_perfs_numa.c
+ * @brief  Decapsulation throughput of receivers placed on each NUMA node, with and without huge
+ *         pages.
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#define _GNU_SOURCE
+
+#include "rle.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <getopt.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+/** The program version */
+#define TEST_VERSION  "RLE NUMA placement performances test application, version 0.0.1\n"
+
+/** Max number of SDUs decapsulated from one FPDU */
+#define MAX_SDUS_NB    100
+
+/** Max SDU len */
+#define MAX_SDU_LEN    4088
+
+/** Number of SDUs of the generated flow */
+#define FLOW_SDUS_NB   (RLE_MAX_FRAG_NUMBER * 64)
+
+/** Smallest room left in a FPDU for one more PPDU */
+#define MIN_BURST_SIZE 14
+
+/** Default FPDU length */
+#define DEFAULT_FPDU_LEN 599
+
+/** Default number of rounds over the FPDUs */
+#define DEFAULT_ROUNDS 10
+
+/** Default number of receivers, to exceed the caches */
+#define DEFAULT_INSTANCES 256
+
+/** Max number of NUMA nodes measured */
+#define MAX_NODES 64
+
+/** Pseudo NUMA node of the receivers allocated on the heap */
+#define NODE_HEAP (-2)
+
+/** A flow of FPDUs loaded in memory */
+struct fpdus {
+	unsigned char **data;  /**< The FPDUs */
+	size_t *lengths;       /**< The FPDUs lengths */
+	size_t nr;             /**< The number of FPDUs */
+};
+
+/* prototypes of private functions */
+static void usage(void);
+static int build_fpdus(const struct rle_config *const conf, const size_t fpdu_len,
+                       struct fpdus *const fpdus);
+static int add_fpdu(struct fpdus *const fpdus, unsigned char *const fpdu, const size_t fpdu_len,
+                    size_t *const fpdu_pos, size_t *const fpdu_remain);
+static void free_fpdus(struct fpdus *const fpdus);
+static size_t get_nodes(int nodes[MAX_NODES]);
+static int get_cpu_node(const int cpu);
+static int bench_decap(const struct fpdus *const fpdus, const struct rle_config *const conf,
+                       const size_t rounds, const size_t instances, const int node,
+                       const unsigned int flags, double *const duration);
+
+/** Buffers of the decapsulated SDUs */
+static unsigned char sdu_buffers[MAX_SDUS_NB][MAX_SDU_LEN];
+static struct rle_sdu sdus_out[MAX_SDUS_NB];
+
+/**
+ * @brief Main function for the RLE NUMA placement performances test
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	/* CRC protected ALPDUs, so that the flow can be given again and again to the receivers */
+	struct rle_config conf_crc = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = 1,
+		.allow_alpdu_sequence_number = 0,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	struct fpdus fpdus = { NULL, NULL, 0 };
+	long rounds = DEFAULT_ROUNDS;
+	long instances = DEFAULT_INSTANCES;
+	long fpdu_len = DEFAULT_FPDU_LEN;
+	int cpu = -1;
+	int nodes[MAX_NODES];
+	size_t nodes_nr;
+	int status = EXIT_FAILURE;
+	int i;
+
+	while (1) {
+		int c;
+
+		const char short_options[] = "vhn:i:c:f:";
+
+		const struct option long_options[] =
+		{
+			{ "rounds", required_argument, NULL, 'n' },
+			{ "instances", required_argument, NULL, 'i' },
+			{ "cpu", required_argument, NULL, 'c' },
+			{ "fpdu", required_argument, NULL, 'f' },
+			{ NULL, 0, NULL, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, short_options, long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 'n': /* Rounds */
+			assert(optarg != NULL);
+			rounds = atol(optarg);
+			if (rounds <= 0) {
+				printf("ERROR: number of rounds shall be strictly positive.\n");
+				goto error;
+			}
+			break;
+
+		case 'i': /* Instances */
+			assert(optarg != NULL);
+			instances = atol(optarg);
+			if (instances <= 0) {
+				printf("ERROR: number of receivers shall be strictly positive.\n");
+				goto error;
+			}
+			break;
+
+		case 'c': /* CPU */
+			assert(optarg != NULL);
+			cpu = atoi(optarg);
+			break;
+
+		case 'f': /* FPDU length */
+			assert(optarg != NULL);
+			fpdu_len = atol(optarg);
+			if (fpdu_len < MIN_BURST_SIZE) {
+				printf("ERROR: FPDU length shall be at least %d.\n", MIN_BURST_SIZE);
+				goto error;
+			}
+			break;
+
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (optind != argc) {
+		usage();
+		goto error;
+	}
+
+	if (build_fpdus(&conf_crc, fpdu_len, &fpdus) != 0) {
+		goto free_fpdus;
+	}
+
+	for (i = 0; i < (int)(sizeof(sdus_out) / sizeof(*sdus_out)); ++i) {
+		sdus_out[i].buffer = sdu_buffers[i];
+	}
+
+	/* run on one CPU, so that its node is the local one */
+	if (cpu < 0) {
+		cpu = sched_getcpu();
+	}
+	{
+		cpu_set_t cpus;
+
+		CPU_ZERO(&cpus);
+		CPU_SET(cpu, &cpus);
+		if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+			printf("failed to run on CPU %d\n", cpu);
+			goto free_fpdus;
+		}
+	}
+
+	nodes_nr = get_nodes(nodes);
+
+	printf("=== test:\n");
+	printf("===\tnumber of sdus:      %d\n", FLOW_SDUS_NB);
+	printf("===\tnumber of fpdus:     %zu (%ld bytes)\n", fpdus.nr, fpdu_len);
+	printf("===\tnumber of rounds:    %ld\n", rounds);
+	printf("===\tnumber of receivers: %ld\n", instances);
+	printf("===\tCPU:                 %d (NUMA node %d)\n", cpu, get_cpu_node(cpu));
+	printf("===\tNUMA nodes:          %zu\n", nodes_nr);
+	if (nodes_nr < 2) {
+		printf("===\tsingle NUMA node, only the placement on the local node is measured\n");
+	}
+	printf("\n");
+
+	{
+		const unsigned int flags[] = { 0, RLE_PLACEMENT_HUGEPAGES };
+		double reference = 0;
+		size_t node_idx;
+
+		printf("=== %-12s %-10s %12s %14s %8s\n", "placement", "pages", "duration (s)",
+		       "rate (FPDU/s)", "ratio");
+
+		/* the heap first, as the reference, then each node */
+		for (node_idx = 0; node_idx <= nodes_nr; ++node_idx) {
+			const int node = (node_idx == 0 ? NODE_HEAP : nodes[node_idx - 1]);
+			size_t flags_idx;
+
+			for (flags_idx = 0; flags_idx < sizeof(flags) / sizeof(flags[0]); ++flags_idx) {
+				const size_t decaps = fpdus.nr * rounds * instances;
+				char placement[32];
+				double duration;
+
+				if (node == NODE_HEAP && flags[flags_idx] != 0) {
+					continue;
+				}
+
+				if (node == NODE_HEAP) {
+					snprintf(placement, sizeof(placement), "heap");
+				} else {
+					snprintf(placement, sizeof(placement), "node %d", node);
+				}
+
+				if (bench_decap(&fpdus, &conf_crc, rounds, instances, node, flags[flags_idx],
+				                &duration) != 0) {
+					printf("=== %-12s %-10s %12s\n", placement,
+					       flags[flags_idx] ? "huge" : "normal", "unavailable");
+					continue;
+				}
+				if (node == NODE_HEAP) {
+					reference = duration;
+				}
+
+				printf("=== %-12s %-10s %12.3f %14.0f %8.2f\n", placement,
+				       flags[flags_idx] ? "huge" : "normal", duration,
+				       (double)decaps / duration, reference / duration);
+			}
+		}
+	}
+
+	status = EXIT_SUCCESS;
+
+free_fpdus:
+	free_fpdus(&fpdus);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the performance test application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "RLE NUMA placement performances tool: measure the decapsulation throughput of\n"
+	        "receivers allocated on the heap, then placed on each NUMA node, with normal\n"
+	        "then huge pages. The FPDUs carry a generated flow of SDUs of mixed lengths on\n"
+	        "all the contexts. Run it on a CPU of each node to compare local and remote\n"
+	        "placements. On a single-node machine, only the local placement is measured.\n"
+	        "\n"
+	        "usage: test_perfs_numa [OPTIONS]\n"
+	        "\n"
+	        "options:\n"
+	        "  -v                      Print version information and exit\n"
+	        "  -h                      Print this usage and exit\n"
+	        "  --rounds, -n            Number of rounds over the FPDUs (default %d)\n"
+	        "  --instances, -i         Number of receivers each FPDU is given to (default %d)\n"
+	        "  --cpu, -c               CPU to run on (default the current one)\n"
+	        "  --fpdu, -f              FPDU length (default %d)\n",
+	        DEFAULT_ROUNDS, DEFAULT_INSTANCES, DEFAULT_FPDU_LEN);
+}
+
+
+/**
+ * @brief Generate a flow of FPDUs: SDUs of mixed lengths, interleaved on all the contexts
+ *
+ * @param conf      The configuration of the transmitter
+ * @param fpdu_len  The length of the FPDUs
+ * @param fpdus     The flow
+ * @return          0 if OK, else 1
+ */
+static int build_fpdus(const struct rle_config *const conf, const size_t fpdu_len,
+                       struct fpdus *const fpdus)
+{
+	const size_t sdu_lens[] = { 40, 576, 1500, 40, 1500, 64, 1280, 4088 };
+	static unsigned char sdu_buffer[MAX_SDU_LEN];
+	struct rle_transmitter *transmitter;
+	unsigned char *fpdu;
+	size_t fpdu_pos = 0;
+	size_t fpdu_remain = fpdu_len;
+	size_t sdu_id;
+	int status = 1;
+
+	memset(sdu_buffer, 0x45, sizeof(sdu_buffer));
+
+	fpdu = malloc(fpdu_len);
+	if (fpdu == NULL) {
+		printf("failed to allocate a FPDU\n");
+		goto error;
+	}
+
+	transmitter = rle_transmitter_new(conf);
+	if (transmitter == NULL) {
+		printf("failed to create the transmitter\n");
+		goto free_fpdu;
+	}
+
+	for (sdu_id = 0; sdu_id < FLOW_SDUS_NB; sdu_id += RLE_MAX_FRAG_NUMBER) {
+		bool is_queued = true;
+		uint8_t frag_id;
+
+		/* one SDU per context, then their fragments interleaved */
+		for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+			const struct rle_sdu sdu = {
+				.buffer = sdu_buffer,
+				.size = sdu_lens[(sdu_id + frag_id) % (sizeof(sdu_lens) / sizeof(sdu_lens[0]))],
+				.protocol_type = 0x0800,
+			};
+
+			if (rle_encapsulate(transmitter, &sdu, frag_id) != RLE_ENCAP_OK) {
+				printf("failed to encapsulate SDU #%zu\n", sdu_id + frag_id + 1);
+				goto destroy_transmitter;
+			}
+		}
+
+		while (is_queued) {
+			is_queued = false;
+			for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+				unsigned char *ppdu;
+				size_t ppdu_len;
+
+				if (rle_transmitter_stats_get_queue_size(transmitter, frag_id) == 0) {
+					continue;
+				}
+				is_queued = true;
+
+				if (fpdu_remain < MIN_BURST_SIZE &&
+				    add_fpdu(fpdus, fpdu, fpdu_len, &fpdu_pos, &fpdu_remain) != 0) {
+					goto destroy_transmitter;
+				}
+				if (rle_fragment(transmitter, frag_id, fpdu_remain, &ppdu,
+				                 &ppdu_len) != RLE_FRAG_OK ||
+				    rle_pack(ppdu, ppdu_len, NULL, 0, fpdu, &fpdu_pos,
+				             &fpdu_remain) != RLE_PACK_OK) {
+					printf("failed to fragment or pack SDU in context %u\n", frag_id);
+					goto destroy_transmitter;
+				}
+			}
+		}
+	}
+	if (fpdu_pos > 0 && add_fpdu(fpdus, fpdu, fpdu_len, &fpdu_pos, &fpdu_remain) != 0) {
+		goto destroy_transmitter;
+	}
+
+	status = 0;
+
+destroy_transmitter:
+	rle_transmitter_destroy(&transmitter);
+free_fpdu:
+	free(fpdu);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Pad a FPDU, append it to a flow and start a new one
+ *
+ * @param fpdus        The flow
+ * @param fpdu         The FPDU
+ * @param fpdu_len     The length of the FPDU
+ * @param fpdu_pos     The position in the FPDU, reset
+ * @param fpdu_remain  The room left in the FPDU, reset
+ * @return             0 if OK, else 1
+ */
+static int add_fpdu(struct fpdus *const fpdus, unsigned char *const fpdu, const size_t fpdu_len,
+                    size_t *const fpdu_pos, size_t *const fpdu_remain)
+{
+	unsigned char **data;
+	size_t *lengths;
+	int status = 1;
+
+	rle_pad(fpdu, *fpdu_pos, *fpdu_remain);
+
+	data = realloc(fpdus->data, (fpdus->nr + 1) * sizeof(unsigned char *));
+	if (data == NULL) {
+		printf("failed to allocate FPDUs\n");
+		goto error;
+	}
+	fpdus->data = data;
+	lengths = realloc(fpdus->lengths, (fpdus->nr + 1) * sizeof(size_t));
+	if (lengths == NULL) {
+		printf("failed to allocate FPDUs lengths\n");
+		goto error;
+	}
+	fpdus->lengths = lengths;
+
+	fpdus->data[fpdus->nr] = malloc(fpdu_len);
+	if (fpdus->data[fpdus->nr] == NULL) {
+		printf("failed to allocate a FPDU\n");
+		goto error;
+	}
+	memcpy(fpdus->data[fpdus->nr], fpdu, fpdu_len);
+	fpdus->lengths[fpdus->nr] = fpdu_len;
+	fpdus->nr++;
+
+	*fpdu_pos = 0;
+	*fpdu_remain = fpdu_len;
+
+	status = 0;
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Free a flow of FPDUs
+ *
+ * @param fpdus  The flow
+ */
+static void free_fpdus(struct fpdus *const fpdus)
+{
+	size_t i;
+
+	for (i = 0; i < fpdus->nr; ++i) {
+		free(fpdus->data[i]);
+	}
+	free(fpdus->data);
+	free(fpdus->lengths);
+}
+
+
+/**
+ * @brief Get the online NUMA nodes
+ *
+ * @param nodes  The online nodes
+ * @return       The number of online nodes, 1 (node 0) if unknown
+ */
+static size_t get_nodes(int nodes[MAX_NODES])
+{
+	FILE *online;
+	size_t nodes_nr = 0;
+	int first;
+	int last;
+	char sep;
+
+	online = fopen("/sys/devices/system/node/online", "r");
+	if (online == NULL) {
+		goto out;
+	}
+
+	/* a list of ranges, "0-1,4" for example */
+	while (fscanf(online, "%d", &first) == 1) {
+		last = first;
+		sep = (char)fgetc(online);
+		if (sep == '-') {
+			if (fscanf(online, "%d", &last) != 1) {
+				break;
+			}
+			sep = (char)fgetc(online);
+		}
+		for (; first <= last && nodes_nr < MAX_NODES; ++first) {
+			nodes[nodes_nr++] = first;
+		}
+		if (sep != ',') {
+			break;
+		}
+	}
+	fclose(online);
+
+out:
+	if (nodes_nr == 0) {
+		nodes[nodes_nr++] = 0;
+	}
+	return nodes_nr;
+}
+
+
+/**
+ * @brief Get the NUMA node of a CPU
+ *
+ * @param cpu  The CPU
+ * @return     The node, 0 if unknown
+ */
+static int get_cpu_node(const int cpu)
+{
+	char path[128];
+	int node;
+
+	for (node = 0; node < MAX_NODES; ++node) {
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/node%d", cpu, node);
+		if (access(path, F_OK) == 0) {
+			return node;
+		}
+	}
+
+	return 0;
+}
+
+
+/**
+ * @brief Give each FPDU of a flow to several receivers and measure the duration
+ *
+ * @param fpdus      The flow
+ * @param conf       The configuration of the receivers
+ * @param rounds     The number of rounds over the flow
+ * @param instances  The number of receivers
+ * @param node       The NUMA node of the receivers, NODE_HEAP for the heap
+ * @param flags      The RLE_PLACEMENT_* flags
+ * @param duration   The duration of the decapsulation, in seconds
+ * @return           0 if OK, else 1
+ */
+static int bench_decap(const struct fpdus *const fpdus, const struct rle_config *const conf,
+                       const size_t rounds, const size_t instances, const int node,
+                       const unsigned int flags, double *const duration)
+{
+	struct rle_receiver **receivers;
+	struct timespec start;
+	struct timespec end;
+	size_t round;
+	size_t i;
+	int status = 1;
+
+	receivers = calloc(instances, sizeof(struct rle_receiver *));
+	if (receivers == NULL) {
+		printf("failed to allocate the receivers\n");
+		goto error;
+	}
+
+	for (i = 0; i < instances; ++i) {
+		if (node == NODE_HEAP) {
+			receivers[i] = rle_receiver_new(conf);
+		} else {
+			receivers[i] = rle_receiver_new_on_node(conf, node, flags);
+		}
+		if (receivers[i] == NULL) {
+			goto destroy_receivers;
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (round = 0; round < rounds; ++round) {
+		size_t fpdu;
+
+		for (fpdu = 0; fpdu < fpdus->nr; ++fpdu) {
+			for (i = 0; i < instances; ++i) {
+				size_t sdus_nr = 0;
+
+				if (rle_decapsulate(receivers[i], fpdus->data[fpdu], fpdus->lengths[fpdu],
+				                    sdus_out, MAX_SDUS_NB, &sdus_nr, NULL,
+				                    0) != RLE_DECAP_OK) {
+					printf("failed to decapsulate FPDU #%zu\n", fpdu + 1);
+					goto destroy_receivers;
+				}
+			}
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	*duration = (double)(end.tv_sec - start.tv_sec) +
+	            (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+	status = 0;
+
+destroy_receivers:
+	for (i = 0; i < instances; ++i) {
+		rle_receiver_destroy(&receivers[i]);
+	}
+	free(receivers);
+error:
+	return status;
+}
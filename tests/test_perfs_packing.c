@@ -0,0 +1,584 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_perfs_packing.c
+ * @brief  Padding and overhead of first-fit packing and of planned packing over superframes.
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#include "rle.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <assert.h>
+#include <getopt.h>
+#include <time.h>
+#include <sys/types.h>
+#include <arpa/inet.h>
+#include <pcap/pcap.h>
+#include <pcap.h>
+
+/** The program version */
+#define TEST_VERSION  "RLE packing performances test application, version 0.0.1\n"
+
+/** The length (in bytes) of the Ethernet header */
+#define ETHER_HDR_LEN  14U
+
+/** Default budget of nodes of the search of the plan */
+#define DEFAULT_SEARCH_MAX 10000
+
+/** The SDUs of the traces */
+struct sdus {
+	unsigned char *data;  /**< The SDUs one after the other */
+	size_t *lens;         /**< The length of each SDU */
+	uint16_t *ptypes;     /**< The protocol type of each SDU */
+	size_t nr;            /**< The number of SDUs */
+	size_t bytes;         /**< The octets of all the SDUs */
+	size_t max_nr;        /**< The number of SDUs allocated */
+};
+
+/** The packing strategies */
+enum strategy {
+	STRATEGY_WHOLE,       /**< Fill the FPDUs one after the other with whole PPDUs, fragment
+	                           only the ALPDUs longer than any FPDU                      */
+	STRATEGY_FIRST_FIT,   /**< Fill the FPDUs one after the other, contexts in turn */
+	STRATEGY_HEURISTIC,   /**< Follow rle_pack_plan without search */
+	STRATEGY_SEARCH,      /**< Follow rle_pack_plan with search */
+	STRATEGY_NB,
+};
+
+/** The names of the packing strategies */
+static const char *const strategy_names[STRATEGY_NB] = {
+	[STRATEGY_WHOLE] = "whole",
+	[STRATEGY_FIRST_FIT] = "first-fit",
+	[STRATEGY_HEURISTIC] = "planned",
+	[STRATEGY_SEARCH] = "searched",
+};
+
+/** Octets sent through the superframes */
+struct result {
+	size_t superframes_nr;  /**< Number of superframes */
+	size_t ppdu_bytes;      /**< Octets of the PPDUs */
+	size_t padding_bytes;   /**< Octets of padding */
+	double plan_ns;         /**< Duration of the planning, in nanoseconds */
+};
+
+/* prototypes of private functions */
+static void usage(void);
+static void print_log(const int module_id, const int level, const char *const file,
+                      const int line, const char *const func, const char *const message, ...);
+static int load_trace(const char *const filename, struct sdus *const sdus);
+static bool fits_whole(const struct rle_config *const conf, const struct sdus *const sdus,
+                       const size_t sdu_id, const size_t room);
+static int run(const struct rle_config *const conf, const struct sdus *const sdus,
+               const size_t fpdu_sizes[], const size_t fpdus_nr, const enum strategy strategy,
+               const size_t search_max, struct result *const result);
+
+/**
+ * @brief Main function for the RLE packing performances test
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = 1,
+		.allow_alpdu_sequence_number = 0,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	size_t fpdu_sizes[RLE_PACK_PLAN_FPDUS_MAX] = { 599, 599, 1199, 311, 899 };
+	size_t fpdus_nr = 0;
+	size_t search_max = DEFAULT_SEARCH_MAX;
+	struct sdus sdus = { NULL, NULL, NULL, 0, 0, 0 };
+	struct result results[STRATEGY_NB];
+	int status = EXIT_FAILURE;
+	int strategy;
+	size_t capacity = 0;
+	size_t i;
+
+	while (1) {
+		int c;
+
+		const char short_options[] = "vhf:s:S";
+
+		const struct option long_options[] =
+		{
+			{ "fpdu", required_argument, NULL, 'f' },
+			{ "search", required_argument, NULL, 's' },
+			{ "seqnum", no_argument, NULL, 'S' },
+			{ NULL, 0, NULL, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, short_options, long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 'f': /* FPDU size */
+			assert(optarg != NULL);
+			if (fpdus_nr >= RLE_PACK_PLAN_FPDUS_MAX) {
+				printf("ERROR: at most %d FPDUs per superframe.\n", RLE_PACK_PLAN_FPDUS_MAX);
+				goto error;
+			}
+			fpdu_sizes[fpdus_nr] = strtoul(optarg, NULL, 10);
+			if (fpdu_sizes[fpdus_nr] < 3 || fpdu_sizes[fpdus_nr] > RLE_MAX_PPDU_PL_SIZE + 2) {
+				printf("ERROR: FPDU size shall be in [3, %d].\n", RLE_MAX_PPDU_PL_SIZE + 2);
+				goto error;
+			}
+			fpdus_nr++;
+			break;
+
+		case 's': /* Search budget */
+			assert(optarg != NULL);
+			search_max = strtoul(optarg, NULL, 10);
+			break;
+
+		case 'S': /* Sequence numbers */
+			conf.allow_alpdu_crc = 0;
+			conf.allow_alpdu_sequence_number = 1;
+			break;
+
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (optind >= argc) {
+		fprintf(stderr, "FLOW is a mandatory parameter\n\n");
+		usage();
+		goto error;
+	}
+	if (fpdus_nr == 0) {
+		fpdus_nr = 5;
+	}
+
+	rle_set_trace_callback(print_log);
+
+	for (i = (size_t)optind; i < (size_t)argc; ++i) {
+		if (load_trace(argv[i], &sdus) != 0) {
+			goto free_sdus;
+		}
+	}
+	if (sdus.nr == 0) {
+		fprintf(stderr, "no SDU in the traces\n");
+		goto free_sdus;
+	}
+	for (i = 0; i < fpdus_nr; ++i) {
+		capacity += fpdu_sizes[i];
+	}
+
+	printf("=== test:\n");
+	printf("===\tnumber of sdus:      %zu (%zu bytes)\n", sdus.nr, sdus.bytes);
+	printf("===\tsuperframe:          %zu fpdus (%zu bytes)\n", fpdus_nr, capacity);
+	printf("===\ttrailer:             %s\n", conf.allow_alpdu_crc ? "crc" : "seqnum");
+	printf("===\tsearch budget:       %zu nodes\n", search_max);
+	printf("=== %-10s %11s %12s %12s %12s %12s %13s\n", "strategy", "superframes", "ppdu bytes",
+	       "overhead", "padding", "unused", "plan (us/sf)");
+
+	for (strategy = 0; strategy < STRATEGY_NB; ++strategy) {
+		struct result *const result = &results[strategy];
+		size_t overhead;
+
+		if (run(&conf, &sdus, fpdu_sizes, fpdus_nr, strategy, search_max, result) != 0) {
+			goto free_sdus;
+		}
+
+		/* the last superframe is partly empty whatever the strategy */
+		overhead = result->ppdu_bytes - sdus.bytes;
+		printf("=== %-10s %11zu %12zu %12zu %12zu %12zu %13.3f\n", strategy_names[strategy],
+		       result->superframes_nr, result->ppdu_bytes, overhead, result->padding_bytes,
+		       result->superframes_nr * capacity - sdus.bytes,
+		       result->plan_ns / result->superframes_nr / 1000.0);
+	}
+
+	for (strategy = 0; strategy < STRATEGY_HEURISTIC; ++strategy) {
+		printf("=== saved against %s: %zd bytes of overhead, %zd bytes of padding, "
+		       "%zd superframes\n", strategy_names[strategy],
+		       (ssize_t)results[strategy].ppdu_bytes - (ssize_t)results[STRATEGY_SEARCH].ppdu_bytes,
+		       (ssize_t)results[strategy].padding_bytes -
+		       (ssize_t)results[STRATEGY_SEARCH].padding_bytes,
+		       (ssize_t)results[strategy].superframes_nr -
+		       (ssize_t)results[STRATEGY_SEARCH].superframes_nr);
+	}
+
+	status = EXIT_SUCCESS;
+
+free_sdus:
+	free(sdus.data);
+	free(sdus.lens);
+	free(sdus.ptypes);
+error:
+	return status;
+}
+
+/**
+ * @brief Print usage of the performance test application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "\n"
+	        "RLE packing performances test: send the SDUs of Ethernet traces through\n"
+	        "superframes of FPDUs, first-fit with whole PPDUs, first-fit with fragments,\n"
+	        "then as planned by rle_pack_plan, and compare the overhead and the padding.\n"
+	        "\n"
+	        "usage: test_perfs_packing [OPTIONS] FLOW...\n"
+	        "\n"
+	        "with:\n"
+	        "\tFLOW                    The flows of Ethernet frames to send (PCAP format).\n"
+	        "\n"
+	        "options:\n"
+	        "\t-v                      Print version information and exit\n"
+	        "\t-h                      Print this usage and exit\n"
+	        "\t--fpdu, -f              Size of a FPDU of the superframe, repeat for each FPDU\n"
+	        "\t                        (default 599 599 1199 311 899)\n"
+	        "\t--search, -s            Budget of nodes of the search (default %d)\n"
+	        "\t--seqnum, -S            Sequence number trailers instead of CRC\n"
+	        "\n",
+	        DEFAULT_SEARCH_MAX);
+
+	return;
+}
+
+/**
+ * @brief Print the library error messages
+ *
+ * @param module_id  The library module
+ * @param level      The log level
+ * @param file       The source file
+ * @param line       The source line
+ * @param func       The function
+ * @param message    The message format
+ * @param ...        The message arguments
+ */
+static void print_log(const int module_id __attribute__((unused)),
+                      const int level,
+                      const char *const file __attribute__((unused)),
+                      const int line __attribute__((unused)),
+                      const char *const func,
+                      const char *const message, ...)
+{
+	va_list args;
+
+	if (level > RLE_LOG_LEVEL_WARNING) {
+		return;
+	}
+
+	va_start(args, message);
+	fprintf(stderr, "%s: ", func);
+	vfprintf(stderr, message, args);
+	fprintf(stderr, "\n");
+	va_end(args);
+}
+
+/**
+ * @brief Load the SDUs of an Ethernet trace
+ *
+ * @param filename  The PCAP file
+ * @param sdus      The SDUs to append to
+ * @return          0 if OK, else 1
+ */
+static int load_trace(const char *const filename, struct sdus *const sdus)
+{
+	char errbuf[PCAP_ERRBUF_SIZE];
+	struct pcap_pkthdr header;
+	const unsigned char *packet;
+	pcap_t *handle;
+	int status = 1;
+
+	handle = pcap_open_offline(filename, errbuf);
+	if (handle == NULL) {
+		fprintf(stderr, "failed to open the trace %s: %s\n", filename, errbuf);
+		goto error;
+	}
+	if (pcap_datalink(handle) != DLT_EN10MB) {
+		fprintf(stderr, "trace %s is not an Ethernet one, skipped\n", filename);
+		status = 0;
+		goto close;
+	}
+
+	while ((packet = pcap_next(handle, &header)) != NULL) {
+		const size_t len = header.caplen - ETHER_HDR_LEN;
+
+		if (header.caplen <= ETHER_HDR_LEN || header.len != header.caplen ||
+		    len > RLE_MAX_PDU_SIZE) {
+			continue;
+		}
+
+		if (sdus->nr == sdus->max_nr) {
+			const size_t max_nr = (sdus->max_nr == 0 ? 1024 : sdus->max_nr * 2);
+			unsigned char *const data = realloc(sdus->data, max_nr * RLE_MAX_PDU_SIZE);
+			size_t *const lens = realloc(sdus->lens, max_nr * sizeof(size_t));
+			uint16_t *const ptypes = realloc(sdus->ptypes, max_nr * sizeof(uint16_t));
+
+			if (data != NULL) {
+				sdus->data = data;
+			}
+			if (lens != NULL) {
+				sdus->lens = lens;
+			}
+			if (ptypes != NULL) {
+				sdus->ptypes = ptypes;
+			}
+			if (data == NULL || lens == NULL || ptypes == NULL) {
+				fprintf(stderr, "failed to allocate the SDUs\n");
+				goto close;
+			}
+			sdus->max_nr = max_nr;
+		}
+
+		memcpy(sdus->data + sdus->nr * RLE_MAX_PDU_SIZE, packet + ETHER_HDR_LEN, len);
+		sdus->lens[sdus->nr] = len;
+		sdus->ptypes[sdus->nr] = ntohs(*(const uint16_t *)(packet + ETHER_HDR_LEN - 2));
+		sdus->bytes += len;
+		sdus->nr++;
+	}
+
+	status = 0;
+
+close:
+	pcap_close(handle);
+error:
+	return status;
+}
+
+/**
+ * @brief Whether a SDU fits whole in a room, as a COMP PPDU
+ *
+ * @param conf    The configuration of the transmitter
+ * @param sdus    The SDUs
+ * @param sdu_id  The SDU
+ * @param room    The room
+ * @return        true if the SDU fits whole, else false
+ */
+static bool fits_whole(const struct rle_config *const conf, const struct sdus *const sdus,
+                       const size_t sdu_id, const size_t room)
+{
+	const struct rle_sdu sdu = {
+		.buffer = sdus->data + sdu_id * RLE_MAX_PDU_SIZE,
+		.size = sdus->lens[sdu_id],
+		.protocol_type = sdus->ptypes[sdu_id],
+	};
+	struct rle_frag_estimate estimate;
+
+	return (rle_fragment_estimate(conf, &sdu, &room, 1, &estimate) == 0 &&
+	        estimate.ppdus_nr == 1 && estimate.remaining_bytes == 0);
+}
+
+/**
+ * @brief Send the SDUs through superframes with a packing strategy
+ *
+ * Before each superframe, the free contexts take the next SDUs. Each FPDU is decapsulated
+ * and the SDUs received are counted.
+ *
+ * @param conf        The configuration of the transmitter and the receiver
+ * @param sdus        The SDUs to send
+ * @param fpdu_sizes  The sizes of the FPDUs of a superframe
+ * @param fpdus_nr    The number of FPDUs of a superframe
+ * @param strategy    The packing strategy
+ * @param search_max  The budget of the search
+ * @param result      The octets sent
+ * @return            0 if OK, else 1
+ */
+static int run(const struct rle_config *const conf, const struct sdus *const sdus,
+               const size_t fpdu_sizes[], const size_t fpdus_nr, const enum strategy strategy,
+               const size_t search_max, struct result *const result)
+{
+	static unsigned char sdus_out_buffers[RLE_MAX_FRAG_NUMBER][RLE_MAX_PDU_SIZE];
+	struct rle_pack_slot slots[RLE_MAX_FRAG_NUMBER * RLE_PACK_PLAN_FPDUS_MAX];
+	unsigned char fpdu[RLE_MAX_PPDU_PL_SIZE + 2];
+	struct rle_transmitter *transmitter;
+	struct rle_receiver *receiver;
+	size_t ctx_sdus[RLE_MAX_FRAG_NUMBER];
+	bool ctx_started[RLE_MAX_FRAG_NUMBER];
+	size_t fpdu_max_size = 0;
+	size_t sdus_in = 0;
+	size_t sdus_out = 0;
+	int status = 1;
+	size_t i;
+
+	memset(result, 0, sizeof(struct result));
+	for (i = 0; i < fpdus_nr; ++i) {
+		if (fpdu_sizes[i] > fpdu_max_size) {
+			fpdu_max_size = fpdu_sizes[i];
+		}
+	}
+
+	transmitter = rle_transmitter_new(conf);
+	receiver = rle_receiver_new(conf);
+	if (transmitter == NULL || receiver == NULL) {
+		fprintf(stderr, "failed to create the transmitter or the receiver\n");
+		goto destroy;
+	}
+
+	while (sdus_out < sdus->nr) {
+		struct rle_pack_plan_info info;
+		struct timespec start;
+		struct timespec end;
+		size_t slot_id = 0;
+		size_t fpdu_id;
+		uint8_t frag_id;
+
+		for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER && sdus_in < sdus->nr; ++frag_id) {
+			const struct rle_sdu sdu = {
+				.buffer = sdus->data + sdus_in * RLE_MAX_PDU_SIZE,
+				.size = sdus->lens[sdus_in],
+				.protocol_type = sdus->ptypes[sdus_in],
+			};
+
+			if (rle_transmitter_stats_get_queue_size(transmitter, frag_id) > 0) {
+				continue;
+			}
+			if (rle_encapsulate(transmitter, &sdu, frag_id) != RLE_ENCAP_OK) {
+				fprintf(stderr, "failed to encapsulate SDU #%zu\n", sdus_in);
+				goto destroy;
+			}
+			ctx_sdus[frag_id] = sdus_in;
+			ctx_started[frag_id] = false;
+			sdus_in++;
+		}
+
+		if (strategy == STRATEGY_HEURISTIC || strategy == STRATEGY_SEARCH) {
+			clock_gettime(CLOCK_MONOTONIC, &start);
+			if (rle_pack_plan(transmitter, fpdu_sizes, fpdus_nr,
+			                  strategy == STRATEGY_SEARCH ? search_max : 0, slots,
+			                  sizeof(slots) / sizeof(slots[0]), &info) != 0) {
+				fprintf(stderr, "failed to plan superframe #%zu\n", result->superframes_nr);
+				goto destroy;
+			}
+			clock_gettime(CLOCK_MONOTONIC, &end);
+			result->plan_ns += (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+		}
+
+		for (fpdu_id = 0; fpdu_id < fpdus_nr; ++fpdu_id) {
+			struct rle_sdu sdus_out_fpdu[RLE_MAX_FRAG_NUMBER];
+			size_t fpdu_pos = 0;
+			size_t fpdu_remain = fpdu_sizes[fpdu_id];
+			size_t sdus_nr = 0;
+
+			frag_id = 0;
+			while (fpdu_remain > 0) {
+				unsigned char *ppdu;
+				size_t ppdu_len;
+				size_t burst_size = fpdu_remain;
+				enum rle_frag_status frag_status;
+
+				if (strategy == STRATEGY_HEURISTIC || strategy == STRATEGY_SEARCH) {
+					if (slot_id >= info.slots_nr || slots[slot_id].fpdu_id != fpdu_id) {
+						break;
+					}
+					frag_id = slots[slot_id].frag_id;
+					burst_size = slots[slot_id].burst_size;
+					slot_id++;
+				} else {
+					while (frag_id < RLE_MAX_FRAG_NUMBER &&
+					       rle_transmitter_stats_get_queue_size(transmitter, frag_id) == 0) {
+						frag_id++;
+					}
+					if (frag_id >= RLE_MAX_FRAG_NUMBER) {
+						break;
+					}
+					if (strategy == STRATEGY_WHOLE && !ctx_started[frag_id] &&
+					    !fits_whole(conf, sdus, ctx_sdus[frag_id], fpdu_remain) &&
+					    fits_whole(conf, sdus, ctx_sdus[frag_id], fpdu_max_size)) {
+						/* wait for a FPDU with room for the whole PPDU */
+						frag_id++;
+						continue;
+					}
+					ctx_started[frag_id] = true;
+				}
+
+				frag_status = rle_fragment(transmitter, frag_id, burst_size, &ppdu, &ppdu_len);
+				if (frag_status == RLE_FRAG_ERR_BURST_TOO_SMALL &&
+				    (strategy == STRATEGY_WHOLE || strategy == STRATEGY_FIRST_FIT)) {
+					/* the next context may fit in the room left */
+					frag_id++;
+					continue;
+				}
+				if (frag_status != RLE_FRAG_OK ||
+				    rle_pack(ppdu, ppdu_len, NULL, 0, fpdu, &fpdu_pos,
+				             &fpdu_remain) != RLE_PACK_OK) {
+					fprintf(stderr, "failed to fragment or pack in FPDU #%zu\n", fpdu_id);
+					goto destroy;
+				}
+				result->ppdu_bytes += ppdu_len;
+			}
+			rle_pad(fpdu, fpdu_pos, fpdu_remain);
+			result->padding_bytes += fpdu_remain;
+
+			for (i = 0; i < RLE_MAX_FRAG_NUMBER; ++i) {
+				sdus_out_fpdu[i].buffer = sdus_out_buffers[i];
+				sdus_out_fpdu[i].size = 0;
+				sdus_out_fpdu[i].protocol_type = 0;
+			}
+			if (rle_decapsulate(receiver, fpdu, fpdu_sizes[fpdu_id], sdus_out_fpdu,
+			                    RLE_MAX_FRAG_NUMBER, &sdus_nr, NULL, 0) != RLE_DECAP_OK) {
+				fprintf(stderr, "failed to decapsulate FPDU #%zu\n", fpdu_id);
+				goto destroy;
+			}
+			sdus_out += sdus_nr;
+		}
+
+		result->superframes_nr++;
+		if (result->superframes_nr > sdus->nr) {
+			fprintf(stderr, "SDUs are not all received\n");
+			goto destroy;
+		}
+	}
+
+	status = 0;
+
+destroy:
+	rle_transmitter_destroy(&transmitter);
+	rle_receiver_destroy(&receiver);
+	return status;
+}
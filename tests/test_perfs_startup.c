@@ -0,0 +1,450 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_perfs_startup.c
+ * @brief  Start-up time of thousands of transmitters and receivers, created one by one or in
+ *         bulk.
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#include "rle.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <getopt.h>
+#include <time.h>
+
+/** The program version */
+#define TEST_VERSION  "RLE start-up performances test application, version 0.0.1\n"
+
+/** Default number of rounds, the best one is kept */
+#define DEFAULT_ROUNDS 3
+
+/** Max number of instance counts measured */
+#define MAX_COUNTS 16
+
+/** Creation and destruction of the instances of one kind */
+struct kind {
+	const char *name;  /**< The name of the instances */
+	/** Create one instance */
+	void * (*new_one)(const struct rle_config *const conf);
+	/** Destroy one instance */
+	void (*destroy_one)(void *const instance);
+	/** Create instances in bulk */
+	int (*new_bulk)(const struct rle_config *const conf, const size_t nr,
+	                const unsigned int flags, void *instances[]);
+	/** Destroy instances in bulk */
+	void (*destroy_bulk)(void *instances[], const size_t nr);
+};
+
+/** Durations of the creation and destruction of instances */
+struct durations {
+	double create;   /**< Duration of the creation, in seconds */
+	double destroy;  /**< Duration of the destruction, in seconds */
+};
+
+/* prototypes of private functions */
+static void usage(void);
+static double elapsed(const struct timespec *const start, const struct timespec *const end);
+static int bench(const struct kind *const kind, const struct rle_config *const conf,
+                 const size_t nr, const bool is_bulk, const unsigned int flags,
+                 void *instances[], struct durations *const durations);
+static void * transmitter_new(const struct rle_config *const conf);
+static void transmitter_destroy(void *const instance);
+static int transmitter_new_bulk(const struct rle_config *const conf, const size_t nr,
+                                const unsigned int flags, void *instances[]);
+static void transmitter_destroy_bulk(void *instances[], const size_t nr);
+static void * receiver_new(const struct rle_config *const conf);
+static void receiver_destroy(void *const instance);
+static int receiver_new_bulk(const struct rle_config *const conf, const size_t nr,
+                             const unsigned int flags, void *instances[]);
+static void receiver_destroy_bulk(void *instances[], const size_t nr);
+
+/** The kinds of instances measured */
+static const struct kind kinds[] = {
+	{
+		"transmitters", transmitter_new, transmitter_destroy, transmitter_new_bulk,
+		transmitter_destroy_bulk
+	},
+	{ "receivers", receiver_new, receiver_destroy, receiver_new_bulk, receiver_destroy_bulk },
+};
+
+/**
+ * @brief Main function for the RLE start-up performances test
+ *
+ * @param argc The number of program arguments
+ * @param argv The program arguments
+ * @return     The unix return code:
+ *              \li 0 in case of success,
+ *              \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = 0,
+		.allow_alpdu_sequence_number = 1,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	size_t counts[MAX_COUNTS] = { 1000, 10000, 100000 };
+	size_t counts_nr = 3;
+	size_t max_count = 0;
+	long rounds = DEFAULT_ROUNDS;
+	unsigned int flags = 0;
+	void **instances = NULL;
+	int status = EXIT_FAILURE;
+	size_t i;
+	size_t k;
+
+	while (1) {
+		int c;
+
+		const char short_options[] = "vhn:H";
+
+		const struct option long_options[] =
+		{
+			{ "rounds", required_argument, NULL, 'n' },
+			{ "hugepages", no_argument, NULL, 'H' },
+			{ NULL, 0, NULL, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, short_options, long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 'n': /* Rounds */
+			assert(optarg != NULL);
+			rounds = atol(optarg);
+			if (rounds <= 0) {
+				printf("ERROR: number of rounds shall be strictly positive.\n");
+				goto error;
+			}
+			break;
+
+		case 'H': /* Huge pages */
+			flags |= RLE_PLACEMENT_HUGEPAGES;
+			break;
+
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (optind < argc) {
+		counts_nr = 0;
+		for (i = optind; i < (size_t)argc && counts_nr < MAX_COUNTS; ++i) {
+			const long count = atol(argv[i]);
+
+			if (count <= 0) {
+				printf("ERROR: number of instances shall be strictly positive.\n");
+				goto error;
+			}
+			counts[counts_nr++] = (size_t)count;
+		}
+	}
+	for (i = 0; i < counts_nr; ++i) {
+		if (counts[i] > max_count) {
+			max_count = counts[i];
+		}
+	}
+
+	instances = calloc(max_count, sizeof(void *));
+	if (instances == NULL) {
+		printf("failed to allocate the instances\n");
+		goto error;
+	}
+
+	printf("=== test:\n");
+	printf("===\tnumber of rounds:    %ld (best kept)\n", rounds);
+	printf("===\thuge pages:          %s\n", (flags & RLE_PLACEMENT_HUGEPAGES) ? "yes" : "no");
+	printf("\n");
+	printf("=== %-12s %9s %-8s %12s %12s %14s\n", "kind", "instances", "mode", "create (ms)",
+	       "destroy (ms)", "create (us/i)");
+
+	for (k = 0; k < sizeof(kinds) / sizeof(kinds[0]); ++k) {
+		for (i = 0; i < counts_nr; ++i) {
+			int is_bulk;
+
+			for (is_bulk = 0; is_bulk <= 1; ++is_bulk) {
+				struct durations best = { 0.0, 0.0 };
+				long round;
+
+				for (round = 0; round < rounds; ++round) {
+					struct durations durations;
+
+					if (bench(&kinds[k], &conf, counts[i], is_bulk, flags, instances,
+					          &durations) != 0) {
+						goto free_instances;
+					}
+					if (round == 0 || durations.create < best.create) {
+						best.create = durations.create;
+					}
+					if (round == 0 || durations.destroy < best.destroy) {
+						best.destroy = durations.destroy;
+					}
+				}
+
+				printf("=== %-12s %9zu %-8s %12.3f %12.3f %14.3f\n", kinds[k].name, counts[i],
+				       is_bulk ? "bulk" : "one/one", best.create * 1e3, best.destroy * 1e3,
+				       best.create * 1e6 / counts[i]);
+			}
+		}
+	}
+
+	status = EXIT_SUCCESS;
+
+free_instances:
+	free(instances);
+error:
+	return status;
+}
+
+
+/**
+ * @brief Print usage of the performance test application
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "RLE start-up performances tool: measure the time to create then destroy\n"
+	        "thousands of transmitters and receivers, one by one on the heap, then in bulk\n"
+	        "in one region.\n"
+	        "\n"
+	        "usage: test_perfs_startup [OPTIONS] [COUNT...]\n"
+	        "\n"
+	        "with:\n"
+	        "  COUNT                   The numbers of instances (default 1000 10000 100000)\n"
+	        "\n"
+	        "options:\n"
+	        "  -v                      Print version information and exit\n"
+	        "  -h                      Print this usage and exit\n"
+	        "  --rounds, -n            Number of rounds, the best one is kept (default %d)\n"
+	        "  --hugepages, -H         Place the instances created in bulk in huge pages\n",
+	        DEFAULT_ROUNDS);
+}
+
+
+/**
+ * @brief Get the duration between two instants
+ *
+ * @param start  The first instant
+ * @param end    The last instant
+ * @return       The duration in seconds
+ */
+static double elapsed(const struct timespec *const start, const struct timespec *const end)
+{
+	return (end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+
+/**
+ * @brief Create then destroy instances, one by one or in bulk
+ *
+ * @param kind       The kind of instances
+ * @param conf       The configuration of the instances
+ * @param nr         The number of instances
+ * @param is_bulk    Whether to create and destroy the instances in bulk
+ * @param flags      The RLE_PLACEMENT_* flags of the instances created in bulk
+ * @param instances  Room for the nr instances
+ * @param durations  The durations of the creation and of the destruction
+ * @return           0 if OK, else 1
+ */
+static int bench(const struct kind *const kind, const struct rle_config *const conf,
+                 const size_t nr, const bool is_bulk, const unsigned int flags,
+                 void *instances[], struct durations *const durations)
+{
+	struct timespec start;
+	struct timespec end;
+	int status = 1;
+	size_t i;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if (is_bulk) {
+		if (kind->new_bulk(conf, nr, flags, instances) != 0) {
+			printf("failed to create %zu %s in bulk\n", nr, kind->name);
+			goto error;
+		}
+	} else {
+		for (i = 0; i < nr; ++i) {
+			instances[i] = kind->new_one(conf);
+			if (instances[i] == NULL) {
+				printf("failed to create %s #%zu\n", kind->name, i + 1);
+				while (i > 0) {
+					kind->destroy_one(instances[--i]);
+				}
+				goto error;
+			}
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	durations->create = elapsed(&start, &end);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if (is_bulk) {
+		kind->destroy_bulk(instances, nr);
+	} else {
+		for (i = 0; i < nr; ++i) {
+			kind->destroy_one(instances[i]);
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	durations->destroy = elapsed(&start, &end);
+
+	status = 0;
+
+error:
+	return status;
+}
+
+
+/**
+ * @brief Create one transmitter on the heap
+ *
+ * @param conf  The configuration of the transmitter
+ * @return      The transmitter if OK, else NULL
+ */
+static void * transmitter_new(const struct rle_config *const conf)
+{
+	return rle_transmitter_new(conf);
+}
+
+
+/**
+ * @brief Destroy one transmitter
+ *
+ * @param instance  The transmitter
+ */
+static void transmitter_destroy(void *const instance)
+{
+	struct rle_transmitter *transmitter = instance;
+
+	rle_transmitter_destroy(&transmitter);
+}
+
+
+/**
+ * @brief Create transmitters in bulk
+ *
+ * @param conf       The configuration of the transmitters
+ * @param nr         The number of transmitters
+ * @param flags      The RLE_PLACEMENT_* flags
+ * @param instances  The nr transmitters
+ * @return           0 if OK, else 1
+ */
+static int transmitter_new_bulk(const struct rle_config *const conf, const size_t nr,
+                                const unsigned int flags, void *instances[])
+{
+	return rle_transmitter_new_bulk(conf, nr, RLE_NUMA_NODE_ANY, flags,
+	                                (struct rle_transmitter **)instances);
+}
+
+
+/**
+ * @brief Destroy transmitters created in bulk
+ *
+ * @param instances  The transmitters
+ * @param nr         The number of transmitters
+ */
+static void transmitter_destroy_bulk(void *instances[], const size_t nr)
+{
+	rle_transmitter_destroy_bulk((struct rle_transmitter **)instances, nr);
+}
+
+
+/**
+ * @brief Create one receiver on the heap
+ *
+ * @param conf  The configuration of the receiver
+ * @return      The receiver if OK, else NULL
+ */
+static void * receiver_new(const struct rle_config *const conf)
+{
+	return rle_receiver_new(conf);
+}
+
+
+/**
+ * @brief Destroy one receiver
+ *
+ * @param instance  The receiver
+ */
+static void receiver_destroy(void *const instance)
+{
+	struct rle_receiver *receiver = instance;
+
+	rle_receiver_destroy(&receiver);
+}
+
+
+/**
+ * @brief Create receivers in bulk
+ *
+ * @param conf       The configuration of the receivers
+ * @param nr         The number of receivers
+ * @param flags      The RLE_PLACEMENT_* flags
+ * @param instances  The nr receivers
+ * @return           0 if OK, else 1
+ */
+static int receiver_new_bulk(const struct rle_config *const conf, const size_t nr,
+                             const unsigned int flags, void *instances[])
+{
+	return rle_receiver_new_bulk(conf, nr, RLE_NUMA_NODE_ANY, flags,
+	                             (struct rle_receiver **)instances);
+}
+
+
+/**
+ * @brief Destroy receivers created in bulk
+ *
+ * @param instances  The receivers
+ * @param nr         The number of receivers
+ */
+static void receiver_destroy_bulk(void *instances[], const size_t nr)
+{
+	rle_receiver_destroy_bulk((struct rle_receiver **)instances, nr);
+}
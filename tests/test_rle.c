@@ -64,6 +64,8 @@ static bool encap_tests(void)
 	const struct test null_transmitter = { "Null transmitter", test_encap_null_transmitter };
 	const struct test too_big = { "Too big", test_encap_too_big };
 	const struct test inv_config = { "Invalid configuration", test_encap_inv_config };
+	const struct test in_place = { "In place", test_encap_in_place };
+	const struct test bulk = { "Bulk", test_encap_bulk };
 
 	const struct test *const encapsulation_tests[] =
 	{
@@ -71,6 +73,8 @@ static bool encap_tests(void)
 		&null_transmitter,
 		&too_big,
 		&inv_config,
+		&in_place,
+		&bulk,
 		NULL
 	};
 
@@ -162,6 +166,7 @@ static bool pack_tests(void)
 	const struct test fpdu_too_small = { "FPDU too small", test_pack_fpdu_too_small };
 	const struct test invalid_ppdu = { "Invalid PPDU", test_pack_invalid_ppdu };
 	const struct test invalid_label = { "Invalid label", test_pack_invalid_label };
+	const struct test iov = { "Gather list", test_pack_iov };
 
 	const struct test *const packing_tests[] =
 	{
@@ -169,6 +174,7 @@ static bool pack_tests(void)
 		&fpdu_too_small,
 		&invalid_ppdu,
 		&invalid_label,
+		&iov,
 		NULL
 	};
 
@@ -194,6 +200,10 @@ static bool decap_tests(void)
 	const struct test wrong_crc = { "Wrong CRC", test_decap_wrong_crc };
 	const struct test interlaced_reassembly = { "Interlaced reassembly",
 		                                    test_decap_interlaced_reassembly };
+	const struct test stream = { "Decapsulation by chunks", test_decap_stream };
+	const struct test label_filter = { "Payload label filter", test_decap_label_filter };
+	const struct test decap_index = { "Index the PPDUs of a FPDU", test_decap_index };
+	const struct test arena = { "Decapsulation in an arena", test_decap_arena };
 
 	const struct test *const decapsulation_tests[] =
 	{
@@ -211,6 +221,10 @@ static bool decap_tests(void)
 		&ppdu_2_bytes,
 		&wrong_crc,
 		&interlaced_reassembly,
+		&stream,
+		&label_filter,
+		&decap_index,
+		&arena,
 		NULL
 	};
 
@@ -241,6 +255,21 @@ static bool misc_tests(void)
 		                                   test_rle_api_robustness_transmitter };
 	const struct test api_robustness_recv = { "API robustness for receiver",
 		                                  test_rle_api_robustness_receiver };
+	const struct test latency = { "Latency histograms", test_rle_latency };
+	const struct test stats_shm = { "Shared-memory statistics", test_rle_stats_shm };
+	const struct test trace_callback = { "Per-instance trace callbacks", test_rle_trace_callback };
+	const struct test decap_errors = { "Decapsulation error counters", test_rle_decap_errors };
+	const struct test alloc_audit = { "Allocation and zeroing audit", test_rle_alloc_audit };
+	const struct test placement = { "Instance allocators and placement",
+		                        test_rle_instance_placement };
+	const struct test bulk = { "Bulk creation of instances", test_rle_bulk_instances };
+	const struct test estimate = { "Fragmentation estimate", test_rle_fragment_estimate };
+	const struct test pack_plan = { "Pack plan", test_rle_pack_plan };
+	const struct test link_stats = { "Link efficiency statistics", test_rle_link_stats };
+	const struct test sched = { "Scheduler", test_rle_sched };
+	const struct test ppdu_hdr_codec = { "PPDU header codec", test_rle_ppdu_hdr_codec };
+	const struct test fpdu_trace = { "FPDU trace", test_rle_fpdu_trace };
+	const struct test checkpoint = { "Checkpoint and restore", test_rle_checkpoint };
 
 	const struct test *const miscellaneous_tests[] =
 	{
@@ -254,6 +283,20 @@ static bool misc_tests(void)
 		&destruction_f_buff,
 		&api_robustness_trans,
 		&api_robustness_recv,
+		&latency,
+		&stats_shm,
+		&trace_callback,
+		&decap_errors,
+		&alloc_audit,
+		&placement,
+		&bulk,
+		&estimate,
+		&pack_plan,
+		&link_stats,
+		&sched,
+		&ppdu_hdr_codec,
+		&fpdu_trace,
+		&checkpoint,
 		NULL
 	};
 
@@ -895,14 +895,14 @@ bool test_rle_api_robustness_receiver(void)
 		/* FPDU with PPDU wrong length */
 		{
 			printf("\t\trle_decapsulate() with PPDU wrong length\n");
-			rle_ppdu_hdr_comp_t *ppdu_comp_hdr =
-				(rle_ppdu_hdr_comp_t *)(fpdu + fpdu_label_len);
-			ppdu_comp_hdr->pkt_len_2--;
+			rle_ppdu_hdr_t *ppdu_hdr = (rle_ppdu_hdr_t *)(fpdu + fpdu_label_len);
+			const uint16_t ppdu_len = rle_ppdu_hdr_get_ppdu_length(ppdu_hdr);
+			rle_ppdu_hdr_set_ppdu_len(ppdu_hdr, ppdu_len - 1);
 			decap_status = rle_decapsulate(rle_receiver, fpdu, fpdu_len,
 			                               sdus, sdus_max_nr, &sdus_nr,
 			                               fpdu_label, fpdu_label_len);
 			assert(decap_status != RLE_DECAP_OK);
-			ppdu_comp_hdr->pkt_len_2++;
+			rle_ppdu_hdr_set_ppdu_len(ppdu_hdr, ppdu_len);
 		}
 
 		/* nominal case */
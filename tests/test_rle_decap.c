@@ -63,6 +63,95 @@ static bool test_decap(const uint16_t protocol_type,
                        const size_t burst_size,
                        const size_t label_length);
 
+/** The size of the payload label of the FPDUs built with the decapsulation fixture */
+#define DECAP_FIXTURE_LABEL_SIZE  3
+
+/** The configuration of the decapsulation fixture */
+static const struct rle_config decap_fixture_conf = {
+	.allow_ptype_omission = 0,
+	.use_compressed_ptype = 1,
+	.allow_alpdu_crc = 0,
+	.allow_alpdu_sequence_number = 1,
+	.use_explicit_payload_header_map = 0,
+	.implicit_protocol_type = 0x00,
+	.implicit_ppdu_label_size = 0,
+	.implicit_payload_label_size = DECAP_FIXTURE_LABEL_SIZE,
+	.type_0_alpdu_label_size = 0,
+};
+
+/** The payload label of the FPDUs built with the decapsulation fixture */
+static const unsigned char decap_fixture_label[DECAP_FIXTURE_LABEL_SIZE] = { 0xaa, 0xbb, 0xcc };
+
+/** The transmitter and the receiver of the decapsulation tests that build their own FPDUs */
+struct decap_fixture {
+	struct rle_transmitter *transmitter; /**< The transmitter, with the fixture configuration */
+	struct rle_receiver *receiver;       /**< The receiver, with the fixture configuration */
+};
+
+/**
+ * @brief         Create the transmitter and the receiver of a decapsulation fixture.
+ *
+ * @param[out]    fixture              The fixture, to tear down even if its setup failed
+ *
+ * @return        true if OK, else false.
+ */
+static bool decap_fixture_setup(struct decap_fixture *const fixture);
+
+/**
+ * @brief         Replace the receiver of a decapsulation fixture by a new one.
+ *
+ * @param[in,out] fixture              The fixture
+ *
+ * @return        true if OK, else false.
+ */
+static bool decap_fixture_new_receiver(struct decap_fixture *const fixture);
+
+/**
+ * @brief         Destroy the transmitter and the receiver of a decapsulation fixture.
+ *
+ * @param[in,out] fixture              The fixture
+ */
+static void decap_fixture_teardown(struct decap_fixture *const fixture);
+
+/**
+ * @brief         Fragment the next PPDU of a context and pack it in a FPDU.
+ *
+ *                The payload label is packed with the first PPDU of the FPDU.
+ *
+ * @param[in,out] transmitter          The transmitter, with the fixture configuration
+ * @param[in]     frag_id              The context, in use
+ * @param[in]     burst_size           The largest PPDU, whatever the room left in the FPDU
+ * @param[in]     label                The payload label of the FPDU
+ * @param[in,out] fpdu                 The FPDU
+ * @param[in,out] fpdu_pos             The end of the last PPDU packed in the FPDU
+ * @param[in,out] fpdu_remain          The room left in the FPDU
+ *
+ * @return        true if OK, else false.
+ */
+static bool decap_fixture_pack_ppdu(struct rle_transmitter *const transmitter,
+                                    const uint8_t frag_id,
+                                    const size_t burst_size,
+                                    const unsigned char label[DECAP_FIXTURE_LABEL_SIZE],
+                                    unsigned char fpdu[],
+                                    size_t *const fpdu_pos,
+                                    size_t *const fpdu_remain);
+
+/**
+ * @brief         Check the SDUs of an arena against the next expected SDUs.
+ *
+ * @param[in]     arena                The arena
+ * @param[in]     buffers              The expected SDUs, of at most 900 octets
+ * @param[in]     lens                 The lengths of the expected SDUs
+ * @param[in]     frag_ids             The contexts of the expected SDUs
+ * @param[in]     sdus_nr              The number of expected SDUs
+ * @param[in,out] next                 The next expected SDU
+ *
+ * @return        true if the SDUs of the arena are the next expected ones, else false.
+ */
+static bool check_arena(const struct rle_sdu_arena *const arena,
+                        unsigned char buffers[][900], const size_t lens[],
+                        const uint8_t frag_ids[], const size_t sdus_nr, size_t *const next);
+
 static void print_modules_stats(const struct rle_transmitter *const transmitter,
                                 const struct rle_receiver *const receiver)
 {
@@ -277,6 +366,94 @@ exit_label:
 	return output;
 }
 
+static bool decap_fixture_setup(struct decap_fixture *const fixture)
+{
+	fixture->receiver = NULL;
+	fixture->transmitter = rle_transmitter_new(&decap_fixture_conf);
+	if (fixture->transmitter == NULL) {
+		PRINT_ERROR("Error allocating transmitter.");
+		return false;
+	}
+
+	return decap_fixture_new_receiver(fixture);
+}
+
+static bool decap_fixture_new_receiver(struct decap_fixture *const fixture)
+{
+	if (fixture->receiver != NULL) {
+		rle_receiver_destroy(&fixture->receiver);
+	}
+	fixture->receiver = rle_receiver_new(&decap_fixture_conf);
+	if (fixture->receiver == NULL) {
+		PRINT_ERROR("Error allocating receiver.");
+		return false;
+	}
+
+	return true;
+}
+
+static void decap_fixture_teardown(struct decap_fixture *const fixture)
+{
+	if (fixture->transmitter != NULL) {
+		rle_transmitter_destroy(&fixture->transmitter);
+	}
+	if (fixture->receiver != NULL) {
+		rle_receiver_destroy(&fixture->receiver);
+	}
+}
+
+static bool decap_fixture_pack_ppdu(struct rle_transmitter *const transmitter,
+                                    const uint8_t frag_id,
+                                    const size_t burst_size,
+                                    const unsigned char label[DECAP_FIXTURE_LABEL_SIZE],
+                                    unsigned char fpdu[],
+                                    size_t *const fpdu_pos,
+                                    size_t *const fpdu_remain)
+{
+	const size_t label_size = (*fpdu_pos == 0) ? DECAP_FIXTURE_LABEL_SIZE : 0;
+	size_t ppdu_max_len = burst_size;
+	unsigned char *ppdu;
+	size_t ppdu_len;
+
+	if (*fpdu_remain < label_size) {
+		return false;
+	}
+	if (ppdu_max_len > *fpdu_remain - label_size) {
+		ppdu_max_len = *fpdu_remain - label_size;
+	}
+
+	return (rle_fragment(transmitter, frag_id, ppdu_max_len, &ppdu, &ppdu_len) == RLE_FRAG_OK &&
+	        rle_pack(ppdu, ppdu_len, label, DECAP_FIXTURE_LABEL_SIZE, fpdu, fpdu_pos,
+	                 fpdu_remain) == RLE_PACK_OK);
+}
+
+static bool check_arena(const struct rle_sdu_arena *const arena,
+                        unsigned char buffers[][900], const size_t lens[],
+                        const uint8_t frag_ids[], const size_t sdus_nr, size_t *const next)
+{
+	size_t used = 0;
+	size_t i;
+
+	for (i = 0; i < arena->descs_nr; ++i) {
+		const struct rle_sdu_desc *const desc = &arena->descs[i];
+
+		if ((*next) == sdus_nr || desc->offset != used || desc->size != lens[*next] ||
+		    desc->protocol_type != 0x0800 || desc->frag_id != frag_ids[*next] ||
+		    memcmp(arena->buffer + desc->offset, buffers[*next], desc->size) != 0) {
+			PRINT_ERROR("SDU %zu differs in the arena.", *next);
+			return false;
+		}
+		used += desc->size;
+		(*next)++;
+	}
+	if (used != arena->used) {
+		PRINT_ERROR("%zu octets used in the arena, %zu expected.", arena->used, used);
+		return false;
+	}
+
+	return true;
+}
+
 bool test_decap_null_receiver(void)
 {
 	PRINT_TEST("Special case : Decapsulation with a null receiver.");
@@ -2261,3 +2438,627 @@ error:
 	printf("\n");
 	return is_success;
 }
+
+bool test_decap_stream(void)
+{
+	bool is_success = false;
+	const size_t sdu_lens[] = { 1500, 40, 700, 2900, 64, 1200, 1, 300, 4000, 90 };
+	const size_t sdus_total = sizeof(sdu_lens) / sizeof(sdu_lens[0]);
+	const size_t chunk_lens[] = { 0, 1, 2, 3, 7, 64, 599, 600 };
+	const size_t fpdu_size = 600;
+	struct decap_fixture fixture;
+	unsigned char sdu_buffer[RLE_MAX_PDU_SIZE];
+	unsigned char fpdus[40][600];
+	unsigned char out_buffers[4][RLE_MAX_PDU_SIZE];
+	struct rle_sdu sdus[4];
+	unsigned char ref[16384];
+	unsigned char got[16384];
+	size_t ref_len = 0;
+	size_t fpdus_nr = 0;
+	size_t sdus_in = 0;
+	size_t i;
+	size_t c;
+
+	PRINT_TEST("Decapsulation of FPDUs received by chunks");
+
+	for (i = 0; i < sizeof(sdu_buffer); ++i) {
+		sdu_buffer[i] = (i * 7) & 0xff;
+	}
+	for (i = 0; i < 4; ++i) {
+		sdus[i].buffer = out_buffers[i];
+	}
+
+	if (!decap_fixture_setup(&fixture)) {
+		goto out;
+	}
+
+	/* FPDUs with PPDUs of 3 contexts, straddling any chunk boundary */
+	while (sdus_in < sdus_total ||
+	       rle_transmitter_stats_get_queue_size(fixture.transmitter, 0) > 0 ||
+	       rle_transmitter_stats_get_queue_size(fixture.transmitter, 1) > 0 ||
+	       rle_transmitter_stats_get_queue_size(fixture.transmitter, 2) > 0) {
+		size_t fpdu_pos = 0;
+		size_t fpdu_remain = fpdu_size;
+		uint8_t frag_id;
+
+		if (fpdus_nr == sizeof(fpdus) / sizeof(fpdus[0])) {
+			PRINT_ERROR("Too many FPDUs.");
+			goto out;
+		}
+
+		for (frag_id = 0; frag_id < 3; ++frag_id) {
+			if (rle_transmitter_stats_get_queue_size(fixture.transmitter, frag_id) == 0 &&
+			    sdus_in < sdus_total) {
+				const struct rle_sdu sdu = {
+					.buffer = sdu_buffer + sdus_in, .size = sdu_lens[sdus_in],
+					.protocol_type = 0x0800
+				};
+
+				if (rle_encapsulate(fixture.transmitter, &sdu, frag_id) != RLE_ENCAP_OK) {
+					PRINT_ERROR("Encap does not return OK.");
+					goto out;
+				}
+				sdus_in++;
+			}
+			if (rle_transmitter_stats_get_queue_size(fixture.transmitter, frag_id) == 0 ||
+			    fpdu_remain < DECAP_FIXTURE_LABEL_SIZE + 10) {
+				continue;
+			}
+			if (!decap_fixture_pack_ppdu(fixture.transmitter, frag_id, fpdu_size,
+			                             decap_fixture_label, fpdus[fpdus_nr], &fpdu_pos,
+			                             &fpdu_remain)) {
+				PRINT_ERROR("Frag or pack does not return OK.");
+				goto out;
+			}
+		}
+		rle_pad(fpdus[fpdus_nr], fpdu_pos, fpdu_remain);
+		fpdus_nr++;
+	}
+
+	/* chunk length 0 stands for the reference, the whole FPDUs */
+	for (c = 0; c < sizeof(chunk_lens) / sizeof(chunk_lens[0]); ++c) {
+		size_t got_len = 0;
+
+		if (!decap_fixture_new_receiver(&fixture)) {
+			goto out;
+		}
+
+		for (i = 0; i < fpdus_nr; ++i) {
+			unsigned char got_label[DECAP_FIXTURE_LABEL_SIZE] = { 0, 0, 0 };
+			size_t sdus_nr = 0;
+			size_t pos = 0;
+			size_t j;
+
+			if (chunk_lens[c] == 0) {
+				if (rle_decapsulate(fixture.receiver, fpdus[i], fpdu_size, sdus, 4, &sdus_nr,
+				                    got_label, sizeof(got_label)) != RLE_DECAP_OK) {
+					PRINT_ERROR("Decap does not return OK.");
+					goto out;
+				}
+				for (j = 0; j < sdus_nr; ++j) {
+					memcpy(ref + ref_len, sdus[j].buffer, sdus[j].size);
+					ref_len += sdus[j].size;
+				}
+			} else {
+				if (rle_decap_stream_begin(fixture.receiver, fpdu_size, sizeof(got_label)) !=
+				    RLE_DECAP_OK) {
+					PRINT_ERROR("Start of decapsulation by chunks failed.");
+					goto out;
+				}
+				while (pos < fpdu_size) {
+					const size_t len =
+						(fpdu_size - pos < chunk_lens[c]) ? fpdu_size - pos : chunk_lens[c];
+
+					if (rle_decap_stream_push(fixture.receiver, fpdus[i] + pos, len, sdus, 4,
+					                          &sdus_nr) != RLE_DECAP_OK) {
+						PRINT_ERROR("Decapsulation of a %zu-byte chunk failed.", len);
+						goto out;
+					}
+					for (j = 0; j < sdus_nr; ++j) {
+						memcpy(got + got_len, sdus[j].buffer, sdus[j].size);
+						got_len += sdus[j].size;
+					}
+					pos += len;
+				}
+				if (rle_decap_stream_end(fixture.receiver, got_label, sizeof(got_label)) !=
+				    RLE_DECAP_OK) {
+					PRINT_ERROR("End of decapsulation by chunks failed.");
+					goto out;
+				}
+			}
+			if (memcmp(got_label, decap_fixture_label, sizeof(got_label)) != 0) {
+				PRINT_ERROR("Wrong payload label.");
+				goto out;
+			}
+		}
+
+		if (chunk_lens[c] != 0) {
+			if (got_len != ref_len || memcmp(got, ref, ref_len) != 0) {
+				PRINT_ERROR("SDUs decapsulated by %zu-byte chunks differ.", chunk_lens[c]);
+				goto out;
+			}
+			printf("%zu FPDUs by %zu-byte chunks: %zu octets of SDUs\n", fpdus_nr,
+			       chunk_lens[c], got_len);
+		}
+	}
+
+	{
+		size_t total = 0;
+
+		for (i = 0; i < sdus_total; ++i) {
+			total += sdu_lens[i];
+		}
+		if (ref_len != total) {
+			PRINT_ERROR("%zu octets of SDUs decapsulated, %zu expected.", ref_len, total);
+			goto out;
+		}
+	}
+
+	/* invalid sequences, and a truncated FPDU */
+	if (!decap_fixture_new_receiver(&fixture)) {
+		goto out;
+	}
+	{
+		struct rle_receiver *const receiver = fixture.receiver;
+		unsigned char got_label[DECAP_FIXTURE_LABEL_SIZE];
+		size_t sdus_nr;
+
+		if (rle_decap_stream_push(receiver, fpdus[0], 10, sdus, 4,
+		                          &sdus_nr) != RLE_DECAP_ERR_INV_FPDU ||
+		    rle_decap_stream_end(receiver, got_label, 3) != RLE_DECAP_ERR_INV_FPDU ||
+		    rle_decap_stream_begin(receiver, 2, 3) != RLE_DECAP_ERR_INV_FPDU ||
+		    rle_decap_stream_begin(receiver, fpdu_size, 4) != RLE_DECAP_ERR_INV_PL ||
+		    rle_decap_stream_begin(receiver, fpdu_size, 3) != RLE_DECAP_OK ||
+		    rle_decap_stream_push(receiver, fpdus[0], fpdu_size + 1, sdus, 4,
+		                          &sdus_nr) != RLE_DECAP_ERR_INV_FPDU ||
+		    rle_decap_stream_push(receiver, fpdus[0], 100, sdus, 4,
+		                          &sdus_nr) != RLE_DECAP_OK ||
+		    rle_decap_stream_end(receiver, got_label, 6) != RLE_DECAP_ERR_INV_PL ||
+		    rle_decap_stream_end(receiver, got_label, 3) != RLE_DECAP_ERR_INV_FPDU ||
+		    rle_decap_stream_push(receiver, fpdus[0] + 100, 100, sdus, 4,
+		                          &sdus_nr) != RLE_DECAP_ERR_INV_FPDU) {
+			PRINT_ERROR("Decapsulation by chunks with invalid sequences should fail.");
+			goto out;
+		}
+	}
+
+	is_success = true;
+
+out:
+	decap_fixture_teardown(&fixture);
+
+	PRINT_TEST_STATUS(is_success);
+	printf("\n");
+
+	return is_success;
+}
+
+bool test_decap_label_filter(void)
+{
+	bool is_success = false;
+	const unsigned char other_label[DECAP_FIXTURE_LABEL_SIZE] = { 0xaa, 0xbb, 0xcd };
+	struct decap_fixture fixture;
+	struct rle_transmitter *other_transmitter = NULL;
+	unsigned char sdu_buffer[1000];
+	const struct rle_sdu sdu = {
+		.buffer = sdu_buffer, .size = sizeof(sdu_buffer), .protocol_type = 0x0800
+	};
+	unsigned char fpdus[3][600];
+	unsigned char out_buffer[RLE_MAX_PDU_SIZE];
+	struct rle_sdu sdu_out = { .buffer = out_buffer, .size = 0, .protocol_type = 0 };
+	struct rle_receiver_error_stats errors;
+	unsigned char got_label[DECAP_FIXTURE_LABEL_SIZE];
+	size_t sdus_nr = 0;
+	size_t i;
+
+	PRINT_TEST("Payload label filter");
+
+	for (i = 0; i < sizeof(sdu_buffer); ++i) {
+		sdu_buffer[i] = i & 0xff;
+	}
+
+	if (!decap_fixture_setup(&fixture)) {
+		goto out;
+	}
+	other_transmitter = rle_transmitter_new(&decap_fixture_conf);
+	if (other_transmitter == NULL) {
+		PRINT_ERROR("Error allocating transmitter.");
+		goto out;
+	}
+
+	/* START for us, START for another terminal on the same context, then END for us */
+	if (rle_encapsulate(fixture.transmitter, &sdu, 0) != RLE_ENCAP_OK ||
+	    rle_encapsulate(other_transmitter, &sdu, 0) != RLE_ENCAP_OK) {
+		PRINT_ERROR("Encap does not return OK.");
+		goto out;
+	}
+	for (i = 0; i < 3; ++i) {
+		size_t fpdu_pos = 0;
+		size_t fpdu_remain = sizeof(fpdus[i]);
+
+		if (!decap_fixture_pack_ppdu(i == 1 ? other_transmitter : fixture.transmitter, 0,
+		                             fpdu_remain, i == 1 ? other_label : decap_fixture_label,
+		                             fpdus[i], &fpdu_pos, &fpdu_remain)) {
+			PRINT_ERROR("Frag or pack does not return OK.");
+			goto out;
+		}
+		rle_pad(fpdus[i], fpdu_pos, fpdu_remain);
+	}
+
+	if (rle_receiver_label_filter_add(fixture.receiver, decap_fixture_label, NULL,
+	                                  DECAP_FIXTURE_LABEL_SIZE) != 0) {
+		PRINT_ERROR("Failed to accept a payload label.");
+		goto out;
+	}
+
+	if (rle_decapsulate(fixture.receiver, fpdus[0], sizeof(fpdus[0]), &sdu_out, 1, &sdus_nr,
+	                    got_label, sizeof(got_label)) != RLE_DECAP_OK || sdus_nr != 0 ||
+	    rle_decapsulate(fixture.receiver, fpdus[1], sizeof(fpdus[1]), &sdu_out, 1, &sdus_nr,
+	                    got_label, sizeof(got_label)) != RLE_DECAP_FILTERED || sdus_nr != 0 ||
+	    rle_decapsulate(fixture.receiver, fpdus[2], sizeof(fpdus[2]), &sdu_out, 1, &sdus_nr,
+	                    got_label, sizeof(got_label)) != RLE_DECAP_OK || sdus_nr != 1) {
+		PRINT_ERROR("FPDU for another terminal not filtered.");
+		goto out;
+	}
+	if (sdu_out.size != sizeof(sdu_buffer) || memcmp(out_buffer, sdu_buffer, sdu_out.size) != 0) {
+		PRINT_ERROR("SDU reassembly disturbed by a filtered FPDU.");
+		goto out;
+	}
+	if (rle_receiver_stats_get_errors(fixture.receiver, &errors) != 0 ||
+	    errors.fpdus_filtered != 1 ||
+	    rle_receiver_stats_get_counter_fpdus_filtered(fixture.receiver) != 1 ||
+	    errors.errors[RLE_DECAP_ERROR_CTX_STATE] != 0) {
+		PRINT_ERROR("Wrong filtered FPDU counter.");
+		goto out;
+	}
+
+	/* 6-byte labels, the last 2 octets ignored, through the decapsulation by chunks */
+	{
+		struct rle_receiver *const receiver = fixture.receiver;
+		const unsigned char accepted[6] = { 0x01, 0x02, 0x03, 0x04, 0x00, 0x00 };
+		const unsigned char mask[6] = { 0xff, 0xff, 0xff, 0xff, 0x00, 0x00 };
+		unsigned char fpdu[8] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x00, 0x00 };
+		unsigned char label6[6];
+
+		if (rle_receiver_label_filter_add(receiver, accepted, mask, 6) != 0 ||
+		    rle_decap_stream_begin(receiver, sizeof(fpdu), 6) != RLE_DECAP_OK ||
+		    rle_decap_stream_push(receiver, fpdu, 4, &sdu_out, 1, &sdus_nr) != RLE_DECAP_OK ||
+		    rle_decap_stream_push(receiver, fpdu + 4, 4, &sdu_out, 1, &sdus_nr) !=
+		    RLE_DECAP_OK ||
+		    rle_decap_stream_end(receiver, label6, 6) != RLE_DECAP_OK) {
+			PRINT_ERROR("FPDU with a masked label wrongly filtered.");
+			goto out;
+		}
+		fpdu[3] = 0x05;
+		if (rle_decap_stream_begin(receiver, sizeof(fpdu), 6) != RLE_DECAP_OK ||
+		    rle_decap_stream_push(receiver, fpdu, 4, &sdu_out, 1, &sdus_nr) != RLE_DECAP_OK ||
+		    rle_decap_stream_push(receiver, fpdu + 4, 2, &sdu_out, 1, &sdus_nr) !=
+		    RLE_DECAP_FILTERED ||
+		    rle_decap_stream_push(receiver, fpdu + 6, 2, &sdu_out, 1, &sdus_nr) !=
+		    RLE_DECAP_FILTERED ||
+		    rle_decap_stream_end(receiver, label6, 6) != RLE_DECAP_OK ||
+		    rle_receiver_stats_get_counter_fpdus_filtered(receiver) != 2) {
+			PRINT_ERROR("FPDU with a masked label not filtered.");
+			goto out;
+		}
+	}
+
+	/* limits, then all FPDUs accepted again */
+	for (i = 2; i < RLE_LABEL_FILTER_MAX; ++i) {
+		if (rle_receiver_label_filter_add(fixture.receiver, decap_fixture_label, NULL,
+		                                  DECAP_FIXTURE_LABEL_SIZE) != 0) {
+			PRINT_ERROR("Failed to accept a payload label.");
+			goto out;
+		}
+	}
+	if (rle_receiver_label_filter_add(fixture.receiver, decap_fixture_label, NULL,
+	                                  DECAP_FIXTURE_LABEL_SIZE) == 0 ||
+	    rle_receiver_label_filter_add(fixture.receiver, decap_fixture_label, NULL, 4) == 0) {
+		PRINT_ERROR("Too many or invalid payload labels accepted.");
+		goto out;
+	}
+	rle_receiver_label_filter_clear(fixture.receiver);
+	if (rle_decapsulate(fixture.receiver, fpdus[1], sizeof(fpdus[1]), &sdu_out, 1, &sdus_nr,
+	                    got_label, sizeof(got_label)) != RLE_DECAP_OK) {
+		PRINT_ERROR("FPDU filtered after the filter was cleared.");
+		goto out;
+	}
+
+	is_success = true;
+
+out:
+	if (other_transmitter != NULL) {
+		rle_transmitter_destroy(&other_transmitter);
+	}
+	decap_fixture_teardown(&fixture);
+
+	PRINT_TEST_STATUS(is_success);
+	printf("\n");
+
+	return is_success;
+}
+
+bool test_decap_index(void)
+{
+	bool is_success = false;
+	const size_t sdus_max_nr = 100;
+	struct decap_fixture fixture;
+	unsigned char sdu_buffer[10] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+	const struct rle_sdu sdu = {
+		.buffer = sdu_buffer, .size = sizeof(sdu_buffer), .protocol_type = 0x0800
+	};
+	unsigned char fpdu[1400];
+	unsigned char out_buffers[100][64];
+	struct rle_sdu sdus[100];
+	unsigned char label[DECAP_FIXTURE_LABEL_SIZE];
+	size_t fpdu_pos = 0;
+	size_t fpdu_remain = sizeof(fpdu);
+	size_t sdus_nr = 0;
+	size_t i;
+
+	PRINT_TEST("Index the PPDUs of a FPDU");
+
+	for (i = 0; i < sdus_max_nr; ++i) {
+		sdus[i].buffer = out_buffers[i];
+	}
+
+	if (!decap_fixture_setup(&fixture)) {
+		goto out;
+	}
+
+	/* more Complete PPDUs than indexed at once */
+	for (i = 0; i < sdus_max_nr; ++i) {
+		if (rle_encapsulate(fixture.transmitter, &sdu, 0) != RLE_ENCAP_OK ||
+		    !decap_fixture_pack_ppdu(fixture.transmitter, 0, fpdu_remain, decap_fixture_label,
+		                             fpdu, &fpdu_pos, &fpdu_remain)) {
+			PRINT_ERROR("Encap, frag or pack does not return OK.");
+			goto out;
+		}
+	}
+	rle_pad(fpdu, fpdu_pos, fpdu_remain);
+
+	if (rle_decapsulate(fixture.receiver, fpdu, sizeof(fpdu), sdus, sdus_max_nr, &sdus_nr,
+	                    label, sizeof(label)) != RLE_DECAP_OK || sdus_nr != sdus_max_nr) {
+		PRINT_ERROR("%zu SDUs decapsulated, %zu expected.", sdus_nr, sdus_max_nr);
+		goto out;
+	}
+	for (i = 0; i < sdus_nr; ++i) {
+		if (sdus[i].size != sizeof(sdu_buffer) ||
+		    memcmp(sdus[i].buffer, sdu_buffer, sizeof(sdu_buffer)) != 0) {
+			PRINT_ERROR("SDU #%zu differs.", i);
+			goto out;
+		}
+	}
+	if (rle_decapsulate(fixture.receiver, fpdu, sizeof(fpdu), sdus, 10, &sdus_nr, label,
+	                    sizeof(label)) != RLE_DECAP_ERR_SOME_DROP || sdus_nr != 10) {
+		PRINT_ERROR("Full SDUs array not detected.");
+		goto out;
+	}
+
+	/* a Start PPDU, then a PPDU that overflows the FPDU: nothing is decapsulated */
+	{
+		const struct rle_sdu big_sdu = {
+			.buffer = fpdu, .size = 500, .protocol_type = 0x0800
+		};
+
+		fpdu_pos = 0;
+		fpdu_remain = 300;
+		if (rle_encapsulate(fixture.transmitter, &big_sdu, 1) != RLE_ENCAP_OK ||
+		    !decap_fixture_pack_ppdu(fixture.transmitter, 1, 200, decap_fixture_label, fpdu,
+		                             &fpdu_pos, &fpdu_remain)) {
+			PRINT_ERROR("Encap, frag or pack does not return OK.");
+			goto out;
+		}
+		/* Complete PPDU of 0x7ff octets */
+		fpdu[fpdu_pos] = 0xdf;
+		fpdu[fpdu_pos + 1] = 0xf8;
+		rle_pad(fpdu, fpdu_pos + 2, fpdu_remain - 2);
+
+		if (rle_decapsulate(fixture.receiver, fpdu, 300, sdus, sdus_max_nr, &sdus_nr, label,
+		                    sizeof(label)) != RLE_DECAP_ERR || sdus_nr != 0 ||
+		    rle_receiver_stats_get_counter_errors(fixture.receiver,
+		                                          RLE_DECAP_ERROR_INV_LEN) != 1 ||
+		    rle_receiver_stats_get_queue_size(fixture.receiver, 1) != 0) {
+			PRINT_ERROR("Malformed FPDU not dropped before its first PPDU.");
+			goto out;
+		}
+	}
+
+	is_success = true;
+
+out:
+	decap_fixture_teardown(&fixture);
+
+	PRINT_TEST_STATUS(is_success);
+	printf("\n");
+
+	return is_success;
+}
+
+bool test_decap_arena(void)
+{
+	bool is_success = false;
+	/* first arena too short for the SDUs of the first FPDU, second one short of descriptors */
+	const size_t arena_sizes[2] = { 1024, 4096 };
+	const size_t arena_descs_nr[2] = { 16, 5 };
+	const size_t fpdu_size = 1800;
+	const size_t long_sdu = 12;
+	struct decap_fixture fixture;
+	static unsigned char sdus_buffers[14][900];
+	static unsigned char fpdus[2][1800];
+	static unsigned char arena_buffer[4096];
+	struct rle_sdu_desc descs[16];
+	struct rle_sdu_arena arena;
+	unsigned char label_out[DECAP_FIXTURE_LABEL_SIZE];
+	size_t sdus_lens[14];
+	uint8_t frag_ids[14];
+	enum rle_decap_status status;
+	size_t fpdu_pos = 0;
+	size_t fpdu_remain = fpdu_size;
+	size_t next;
+	size_t a;
+	size_t i;
+
+	PRINT_TEST("Decapsulation in an arena");
+
+	/* 12 short SDUs in Complete PPDUs and the START of a long SDU in the first FPDU, the END
+	 * of the long SDU and a short SDU in the second one */
+	for (i = 0; i < 14; ++i) {
+		size_t j;
+
+		sdus_lens[i] = (i == long_sdu) ? 900 : (40 + 9 * (i % 12));
+		frag_ids[i] = (i == long_sdu) ? 7 : 0;
+		for (j = 0; j < sdus_lens[i]; ++j) {
+			sdus_buffers[i][j] = (unsigned char)(i * 17 + j);
+		}
+	}
+
+	if (!decap_fixture_setup(&fixture)) {
+		goto out;
+	}
+	for (i = 0; i < 14; ++i) {
+		const struct rle_sdu sdu = {
+			.buffer = sdus_buffers[i], .size = sdus_lens[i], .protocol_type = 0x0800
+		};
+		const uint8_t frag_id = (i == long_sdu) ? 7 : (uint8_t)(i % 8);
+		unsigned char *const fpdu = fpdus[(i <= long_sdu) ? 0 : 1];
+
+		if (rle_encapsulate(fixture.transmitter, &sdu, frag_id) != RLE_ENCAP_OK ||
+		    !decap_fixture_pack_ppdu(fixture.transmitter, frag_id,
+		                             (i == long_sdu) ? 300 : fpdu_remain, decap_fixture_label,
+		                             fpdu, &fpdu_pos, &fpdu_remain)) {
+			PRINT_ERROR("SDU %zu not packed.", i);
+			goto out;
+		}
+		if (i == long_sdu) {
+			rle_pad(fpdu, fpdu_pos, fpdu_remain);
+			fpdu_pos = 0;
+			fpdu_remain = fpdu_size;
+			if (!decap_fixture_pack_ppdu(fixture.transmitter, frag_id, fpdu_remain,
+			                             decap_fixture_label, fpdus[1], &fpdu_pos,
+			                             &fpdu_remain) ||
+			    rle_transmitter_stats_get_queue_size(fixture.transmitter, frag_id) != 0) {
+				PRINT_ERROR("END PPDU of SDU %zu not packed.", i);
+				goto out;
+			}
+		}
+	}
+	rle_pad(fpdus[1], fpdu_pos, fpdu_remain);
+
+	/* SDUs of both FPDUs gathered in the arena, emptied only when it is full */
+	for (a = 0; a < 2; ++a) {
+		size_t resumes = 0;
+		size_t f;
+
+		if (a > 0 && !decap_fixture_new_receiver(&fixture)) {
+			goto out;
+		}
+		memset(&arena, 0, sizeof(arena));
+		arena.buffer = arena_buffer;
+		arena.size = arena_sizes[a];
+		arena.descs = descs;
+		arena.descs_max_nr = arena_descs_nr[a];
+		next = 0;
+
+		for (f = 0; f < 2; ++f) {
+			do {
+				status = rle_decapsulate_arena(fixture.receiver, fpdus[f], fpdu_size, &arena,
+				                               label_out, sizeof(label_out));
+				if (status == RLE_DECAP_ARENA_FULL) {
+					if (arena.resume_offset < DECAP_FIXTURE_LABEL_SIZE ||
+					    !check_arena(&arena, sdus_buffers, sdus_lens, frag_ids, 14, &next)) {
+						PRINT_ERROR("Wrong arena full with arena %zu.", a);
+						goto out;
+					}
+					arena.used = 0;
+					arena.descs_nr = 0;
+					resumes++;
+				}
+			} while (status == RLE_DECAP_ARENA_FULL);
+			if (status != RLE_DECAP_OK || arena.resume_offset != 0 ||
+			    memcmp(label_out, decap_fixture_label, sizeof(label_out)) != 0) {
+				PRINT_ERROR("Decapsulation of FPDU %zu in arena %zu failed.", f, a);
+				goto out;
+			}
+		}
+		if (!check_arena(&arena, sdus_buffers, sdus_lens, frag_ids, 14, &next) || next != 14 ||
+		    resumes < 2) {
+			PRINT_ERROR("%zu SDUs out of arena %zu after %zu resumes.", next, a, resumes);
+			goto out;
+		}
+		for (i = 0; i < RLE_DECAP_ERROR_NB; ++i) {
+			if (rle_receiver_stats_get_counter_errors(fixture.receiver,
+			                                          (enum rle_decap_error_type)i) != 0) {
+				PRINT_ERROR("Error %zu detected with arena %zu.", i, a);
+				goto out;
+			}
+		}
+	}
+
+	/* a SDU larger than the empty arena is dropped with the rest of the FPDU */
+	if (!decap_fixture_new_receiver(&fixture)) {
+		goto out;
+	}
+	memset(&arena, 0, sizeof(arena));
+	arena.buffer = arena_buffer;
+	arena.size = 100;
+	arena.descs = descs;
+	arena.descs_max_nr = 16;
+	next = 0;
+	do {
+		status = rle_decapsulate_arena(fixture.receiver, fpdus[0], fpdu_size, &arena, label_out,
+		                               sizeof(label_out));
+		if (!check_arena(&arena, sdus_buffers, sdus_lens, frag_ids, 14, &next)) {
+			goto out;
+		}
+		arena.used = 0;
+		arena.descs_nr = 0;
+	} while (status == RLE_DECAP_ARENA_FULL);
+	if (status != RLE_DECAP_ERR_SOME_DROP || arena.resume_offset != 0 || next != 7 ||
+	    rle_receiver_stats_get_counter_errors(fixture.receiver, RLE_DECAP_ERROR_SDUS_FULL) != 1) {
+		PRINT_ERROR("SDU larger than the arena not dropped.");
+		goto out;
+	}
+
+	/* invalid arenas */
+	arena.descs_nr = arena.descs_max_nr + 1;
+	if (rle_decapsulate_arena(fixture.receiver, fpdus[0], fpdu_size, NULL, label_out,
+	                          sizeof(label_out)) != RLE_DECAP_ERR_INV_SDUS ||
+	    rle_decapsulate_arena(fixture.receiver, fpdus[0], fpdu_size, &arena, label_out,
+	                          sizeof(label_out)) != RLE_DECAP_ERR_INV_SDUS) {
+		PRINT_ERROR("Invalid arena accepted.");
+		goto out;
+	}
+	arena.descs_nr = 0;
+#if SIZE_MAX > UINT32_MAX
+	arena.size = (size_t)UINT32_MAX + 1;
+	if (rle_decapsulate_arena(fixture.receiver, fpdus[0], fpdu_size, &arena, label_out,
+	                          sizeof(label_out)) != RLE_DECAP_ERR_INV_SDUS) {
+		PRINT_ERROR("Arena out of reach of the SDU offsets accepted.");
+		goto out;
+	}
+	arena.size = 100;
+#endif
+	arena.resume_offset = 1;
+	if (rle_decapsulate_arena(fixture.receiver, fpdus[0], fpdu_size, &arena, label_out,
+	                          sizeof(label_out)) != RLE_DECAP_ERR_INV_FPDU) {
+		PRINT_ERROR("Resume in the payload label accepted.");
+		goto out;
+	}
+	arena.resume_offset = fpdu_size;
+	if (rle_decapsulate_arena(fixture.receiver, fpdus[0], fpdu_size, &arena, label_out,
+	                          sizeof(label_out)) != RLE_DECAP_ERR_INV_FPDU) {
+		PRINT_ERROR("Resume out of the FPDU accepted.");
+		goto out;
+	}
+
+	is_success = true;
+
+out:
+	decap_fixture_teardown(&fixture);
+
+	PRINT_TEST_STATUS(is_success);
+	printf("\n");
+
+	return is_success;
+}
@@ -684,3 +684,261 @@ error:
 	printf("\n");
 	return output;
 }
+
+bool test_encap_in_place(void)
+{
+	bool output = false;
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = 1,
+		.allow_alpdu_sequence_number = 0,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	const size_t frame_len = 600;
+	struct rle_transmitter *tx_copy = NULL;
+	struct rle_transmitter *tx_in_place = NULL;
+	struct rle_receiver *receiver = NULL;
+	unsigned char frame[600];
+	unsigned char sdu_mem[RLE_SDU_BUF_HEADROOM + 600 + RLE_SDU_BUF_TAILROOM];
+	struct rle_sdu_buf sdu_buf = {
+		.head = sdu_mem, .size = sizeof(sdu_mem), .data_offset = RLE_SDU_BUF_HEADROOM,
+		.data_len = 600, .protocol_type = 0x8100
+	};
+	const struct rle_sdu sdu = { .buffer = frame, .size = 600, .protocol_type = 0x8100 };
+	unsigned char fpdu[1000];
+	unsigned char out_buffer[700];
+	struct rle_sdu out_sdu = { .buffer = out_buffer };
+	size_t fpdu_pos = 0;
+	size_t fpdu_remain = sizeof(fpdu);
+	size_t sdus_nr = 0;
+	size_t i;
+
+	PRINT_TEST("Test the encapsulation of a SDU in place, with headroom and tailroom.");
+
+	/* Ethernet/VLAN/IPv4 frame: the VLAN protocol type is suppressed */
+	for (i = 0; i < frame_len; ++i) {
+		frame[i] = (unsigned char)(i * 7 + 3);
+	}
+	frame[12] = 0x81;
+	frame[13] = 0x00;
+	frame[16] = 0x08;
+	frame[17] = 0x00;
+	frame[18] = 0x45;
+	memcpy(sdu_mem + RLE_SDU_BUF_HEADROOM, frame, frame_len);
+
+	tx_copy = rle_transmitter_new(&conf);
+	tx_in_place = rle_transmitter_new(&conf);
+	receiver = rle_receiver_new(&conf);
+	if (tx_copy == NULL || tx_in_place == NULL || receiver == NULL) {
+		PRINT_ERROR("Transmitters or receiver creation failed.");
+		goto exit_label;
+	}
+
+	/* no room for the headers or for the trailer */
+	sdu_buf.data_offset = RLE_SDU_BUF_HEADROOM - 1;
+	if (rle_encapsulate_in_place(tx_in_place, &sdu_buf, 0) != RLE_ENCAP_ERR) {
+		PRINT_ERROR("SDU buffer without enough headroom accepted.");
+		goto exit_label;
+	}
+	sdu_buf.data_offset = RLE_SDU_BUF_HEADROOM + 1;
+	if (rle_encapsulate_in_place(tx_in_place, &sdu_buf, 0) != RLE_ENCAP_ERR) {
+		PRINT_ERROR("SDU buffer without enough tailroom accepted.");
+		goto exit_label;
+	}
+	sdu_buf.data_offset = RLE_SDU_BUF_HEADROOM;
+
+	if (rle_encapsulate(tx_copy, &sdu, 0) != RLE_ENCAP_OK ||
+	    rle_encapsulate_in_place(tx_in_place, &sdu_buf, 0) != RLE_ENCAP_OK) {
+		PRINT_ERROR("Encapsulation failed.");
+		goto exit_label;
+	}
+
+	/* the same PPDUs, built in the SDU buffer */
+	while (rle_transmitter_stats_get_queue_size(tx_in_place, 0) > 0) {
+		unsigned char *ppdu_copy;
+		unsigned char *ppdu;
+		size_t ppdu_copy_len;
+		size_t ppdu_len;
+
+		if (rle_fragment(tx_copy, 0, 250, &ppdu_copy, &ppdu_copy_len) != RLE_FRAG_OK ||
+		    rle_fragment(tx_in_place, 0, 250, &ppdu, &ppdu_len) != RLE_FRAG_OK) {
+			PRINT_ERROR("Fragmentation failed.");
+			goto exit_label;
+		}
+		if (ppdu_len != ppdu_copy_len || memcmp(ppdu, ppdu_copy, ppdu_len) != 0) {
+			PRINT_ERROR("PPDU built in place differs.");
+			goto exit_label;
+		}
+		if (ppdu < sdu_mem || ppdu + ppdu_len > sdu_mem + sizeof(sdu_mem)) {
+			PRINT_ERROR("PPDU not built in the SDU buffer.");
+			goto exit_label;
+		}
+		if (rle_pack(ppdu, ppdu_len, NULL, 0, fpdu, &fpdu_pos, &fpdu_remain) != RLE_PACK_OK) {
+			PRINT_ERROR("Packing failed.");
+			goto exit_label;
+		}
+	}
+	rle_pad(fpdu, fpdu_pos, fpdu_remain);
+
+	/* the context uses its own buffer again */
+	if (rle_encapsulate(tx_in_place, &sdu, 0) != RLE_ENCAP_OK ||
+	    rle_transmitter_stats_get_queue_size(tx_in_place, 0) == 0) {
+		PRINT_ERROR("Encapsulation after the in place one failed.");
+		goto exit_label;
+	}
+
+	/* the VLAN protocol type is inserted back */
+	if (rle_decapsulate(receiver, fpdu, sizeof(fpdu), &out_sdu, 1, &sdus_nr, NULL,
+	                    0) != RLE_DECAP_OK || sdus_nr != 1) {
+		PRINT_ERROR("Decapsulation failed.");
+		goto exit_label;
+	}
+	if (out_sdu.size != frame_len || out_sdu.protocol_type != 0x8100 ||
+	    memcmp(out_sdu.buffer, frame, frame_len) != 0) {
+		PRINT_ERROR("Decapsulated SDU differs.");
+		goto exit_label;
+	}
+
+	output = true;
+
+exit_label:
+	if (tx_copy != NULL) {
+		rle_transmitter_destroy(&tx_copy);
+	}
+	if (tx_in_place != NULL) {
+		rle_transmitter_destroy(&tx_in_place);
+	}
+	if (receiver != NULL) {
+		rle_receiver_destroy(&receiver);
+	}
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+	return output;
+}
+
+bool test_encap_bulk(void)
+{
+	bool output = false;
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = 1,
+		.allow_alpdu_sequence_number = 0,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	/* IMIX lengths, the same context for the last two SDUs of the second bulk */
+	const size_t sdus_lens[RLE_MAX_FRAG_NUMBER] = { 40, 576, 1500, 40, 40, 576, 40, 1 };
+	const uint8_t frag_ids[RLE_MAX_FRAG_NUMBER] = { 7, 6, 5, 4, 3, 2, 1, 0 };
+	const uint8_t frag_ids_dup[3] = { 3, 5, 5 };
+	struct rle_transmitter *tx_serial = NULL;
+	struct rle_transmitter *tx_bulk = NULL;
+	static unsigned char buffers[RLE_MAX_FRAG_NUMBER][1500];
+	struct rle_sdu sdus[RLE_MAX_FRAG_NUMBER];
+	size_t encap_nr;
+	size_t round;
+	size_t i;
+
+	PRINT_TEST("Test the encapsulation of several SDUs with their CRC computed side by side.");
+
+	for (i = 0; i < RLE_MAX_FRAG_NUMBER; ++i) {
+		size_t j;
+
+		for (j = 0; j < sdus_lens[i]; ++j) {
+			buffers[i][j] = (unsigned char)(i * 31 + j * 7);
+		}
+		sdus[i].buffer = buffers[i];
+		sdus[i].size = sdus_lens[i];
+		sdus[i].protocol_type = (i % 2 == 0 ? 0x0800 : 0x86dd);
+	}
+
+	/* an Ethernet/VLAN/IPv4 frame: the VLAN protocol type is suppressed from the SDU, after its
+	 * CRC is computed */
+	buffers[1][12] = 0x81;
+	buffers[1][13] = 0x00;
+	buffers[1][16] = 0x08;
+	buffers[1][17] = 0x00;
+	buffers[1][18] = 0x45;
+	sdus[1].protocol_type = 0x8100;
+
+	tx_serial = rle_transmitter_new(&conf);
+	tx_bulk = rle_transmitter_new(&conf);
+	if (tx_serial == NULL || tx_bulk == NULL) {
+		PRINT_ERROR("Transmitters creation failed.");
+		goto exit_label;
+	}
+
+	if (rle_encapsulate_bulk(NULL, sdus, frag_ids, 1, &encap_nr) != RLE_ENCAP_ERR_NULL_TRMT ||
+	    encap_nr != 0) {
+		PRINT_ERROR("Bulk encapsulation without transmitter accepted.");
+		goto exit_label;
+	}
+
+	for (round = 0; round < 2; ++round) {
+		const uint8_t *const ids = (round == 0 ? frag_ids : frag_ids_dup);
+		const size_t nr = (round == 0 ? RLE_MAX_FRAG_NUMBER : 3);
+		const size_t expected_nr = (round == 0 ? RLE_MAX_FRAG_NUMBER : 2);
+		const enum rle_encap_status expected = (round == 0 ? RLE_ENCAP_OK : RLE_ENCAP_ERR);
+
+		if (rle_encapsulate_bulk(tx_bulk, sdus, ids, nr, &encap_nr) != expected ||
+		    encap_nr != expected_nr) {
+			PRINT_ERROR("Bulk encapsulation %zu: %zu SDUs encapsulated, %zu expected.", round,
+			            encap_nr, expected_nr);
+			goto exit_label;
+		}
+		for (i = 0; i < expected_nr; ++i) {
+			if (rle_encapsulate(tx_serial, &sdus[i], ids[i]) != RLE_ENCAP_OK) {
+				PRINT_ERROR("Encapsulation failed.");
+				goto exit_label;
+			}
+		}
+
+		/* the same PPDUs, CRC included */
+		for (i = 0; i < expected_nr; ++i) {
+			while (rle_transmitter_stats_get_queue_size(tx_bulk, ids[i]) > 0) {
+				unsigned char *ppdu_serial;
+				unsigned char *ppdu;
+				size_t ppdu_serial_len;
+				size_t ppdu_len;
+
+				if (rle_fragment(tx_serial, ids[i], 250, &ppdu_serial, &ppdu_serial_len) !=
+				    RLE_FRAG_OK ||
+				    rle_fragment(tx_bulk, ids[i], 250, &ppdu, &ppdu_len) != RLE_FRAG_OK) {
+					PRINT_ERROR("Fragmentation failed.");
+					goto exit_label;
+				}
+				if (ppdu_len != ppdu_serial_len || memcmp(ppdu, ppdu_serial, ppdu_len) != 0) {
+					PRINT_ERROR("PPDU of SDU %zu differs.", i);
+					goto exit_label;
+				}
+			}
+			if (rle_transmitter_stats_get_queue_size(tx_serial, ids[i]) != 0) {
+				PRINT_ERROR("PPDUs of SDU %zu missing.", i);
+				goto exit_label;
+			}
+		}
+	}
+
+	output = true;
+
+exit_label:
+	if (tx_serial != NULL) {
+		rle_transmitter_destroy(&tx_serial);
+	}
+	if (tx_bulk != NULL) {
+		rle_transmitter_destroy(&tx_bulk);
+	}
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+	return output;
+}
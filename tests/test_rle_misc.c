@@ -29,14 +29,20 @@
 #include "test_rle_misc.h"
 
 #include "rle.h"
+#include "header.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <inttypes.h>
 #include <string.h>
 #include <netinet/in.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 /** Test configuration structure */
 struct test_request {
@@ -70,6 +76,415 @@ static bool test_request_rle_header_overhead(const enum rle_fpdu_types fpdu_type
                                              const size_t expected_size,
                                              const struct rle_config *const conf);
 
+/** Traces counted by the trace callbacks of @ref test_rle_trace_callback */
+struct trace_count {
+	size_t debug; /**< Number of debug traces */
+	size_t error; /**< Number of error traces */
+};
+
+/** Traces counted by the global callback of @ref test_rle_trace_callback */
+static struct trace_count global_trace_count;
+
+/**
+ * @brief         Trace callback of an instance, counting its traces in its private data.
+ */
+static void count_instance_trace(void *const priv, const int module_id, const int level,
+                                 const char *const file, const int line, const char *const func,
+                                 const char *const message, ...);
+
+/**
+ * @brief         Global trace callback, counting the traces in @ref global_trace_count.
+ */
+static void count_global_trace(const int module_id, const int level, const char *const file,
+                               const int line, const char *const func, const char *const message,
+                               ...);
+
+/**
+ * @brief         Count a trace according to its level.
+ */
+static void count_trace(struct trace_count *const count, const int level);
+
+/** Blocks handed out by the allocator of @ref test_rle_alloc_audit */
+struct alloc_count {
+	size_t allocs; /**< Number of allocations */
+	size_t frees;  /**< Number of releases */
+};
+
+/**
+ * @brief         Allocation hook counting the allocations in its private data.
+ */
+static void * count_alloc(void *const priv, const size_t size);
+
+/**
+ * @brief         Release hook counting the releases in its private data.
+ */
+static void count_free(void *const priv, void *const ptr);
+
+/**
+ * @brief         Compare the estimate of the PPDUs of a SDU with its real fragmentation.
+ *
+ * @param[in,out] transmitter  The transmitter, with a free context 0.
+ * @param[in]     conf         The configuration of the transmitter.
+ * @param[in]     sdu          The SDU.
+ * @param[in]     bursts       The remaining sizes of the successive bursts.
+ * @param[in]     bursts_nr    The number of bursts.
+ *
+ * @return        true if the estimate matches, else false.
+ */
+static bool check_fragment_estimate(struct rle_transmitter *const transmitter,
+                                    const struct rle_config *const conf,
+                                    const struct rle_sdu *const sdu,
+                                    const size_t bursts[], const size_t bursts_nr);
+
+/** Octets sent through the superframes of @ref send_superframes */
+struct superframe_count {
+	size_t superframes_nr; /**< Number of superframes */
+	size_t ppdu_bytes;     /**< Octets of the PPDUs */
+	size_t padding_bytes;  /**< Octets of padding */
+};
+
+/**
+ * @brief         Send SDUs through superframes of FPDUs, first-fit or as planned.
+ *
+ *                Before each superframe, the free contexts take the next SDUs. First-fit fills
+ *                the FPDUs one after the other with the contexts in turn, the plan follows
+ *                rle_pack_plan. Each FPDU is decapsulated and the SDUs are checked.
+ *
+ * @param[in,out] transmitter  The transmitter, with free contexts.
+ * @param[in,out] receiver     The receiver.
+ * @param[in]     sdu_lens     The lengths of the SDUs to send, SDU i is filled with i.
+ * @param[in]     sdus_nr      The number of SDUs, at most 256.
+ * @param[in]     fpdu_sizes   The sizes of the FPDUs of a superframe.
+ * @param[in]     fpdus_nr     The number of FPDUs of a superframe.
+ * @param[in]     use_plan     Whether to follow rle_pack_plan instead of first-fit.
+ * @param[in]     search_max   The budget of the search of rle_pack_plan.
+ * @param[out]    count        The octets sent.
+ *
+ * @return        true if all the SDUs are received, else false.
+ */
+static bool send_superframes(struct rle_transmitter *const transmitter,
+                             struct rle_receiver *const receiver,
+                             const size_t sdu_lens[], const size_t sdus_nr,
+                             const size_t fpdu_sizes[], const size_t fpdus_nr,
+                             const bool use_plan, const size_t search_max,
+                             struct superframe_count *const count);
+
+/**
+ * @brief         Send the next PPDU of a context alone in a FPDU and decapsulate it.
+ *
+ * @param[in,out] transmitter  The transmitter.
+ * @param[in]     frag_id      The context, in use.
+ * @param[in]     fpdu_size    The size of the FPDU.
+ * @param[in,out] receiver     The receiver.
+ * @param[out]    sdu          The reassembled SDU, if any. Its buffer is given by the caller.
+ * @param[out]    sdus_nr      The number of reassembled SDUs, 0 or 1.
+ *
+ * @return        true if the PPDU is sent and decapsulated, else false.
+ */
+static bool send_ppdu(struct rle_transmitter *const transmitter, const uint8_t frag_id,
+                      const size_t fpdu_size, struct rle_receiver *const receiver,
+                      struct rle_sdu *const sdu, size_t *const sdus_nr);
+
+static void count_trace(struct trace_count *const count, const int level)
+{
+	if (level == RLE_LOG_LEVEL_DEBUG) {
+		count->debug++;
+	} else if (level <= RLE_LOG_LEVEL_ERROR) {
+		count->error++;
+	}
+}
+
+static bool send_superframes(struct rle_transmitter *const transmitter,
+                             struct rle_receiver *const receiver,
+                             const size_t sdu_lens[], const size_t sdus_nr,
+                             const size_t fpdu_sizes[], const size_t fpdus_nr,
+                             const bool use_plan, const size_t search_max,
+                             struct superframe_count *const count)
+{
+	static unsigned char sdu_buffer[RLE_MAX_PDU_SIZE];
+	static unsigned char sdus_out_buffers[RLE_MAX_FRAG_NUMBER][RLE_MAX_PDU_SIZE];
+	unsigned char fpdu[RLE_MAX_PPDU_PL_SIZE + 2];
+	struct rle_pack_slot slots[RLE_MAX_FRAG_NUMBER * 8];
+	size_t sdus_in = 0;
+	size_t sdus_out = 0;
+
+	memset(count, 0, sizeof(struct superframe_count));
+
+	while (sdus_out < sdus_nr) {
+		struct rle_pack_plan_info info;
+		size_t slot_id = 0;
+		size_t fpdu_id;
+		uint8_t frag_id;
+
+		for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER && sdus_in < sdus_nr; ++frag_id) {
+			const struct rle_sdu sdu = {
+				.buffer = sdu_buffer, .size = sdu_lens[sdus_in], .protocol_type = 0x0800
+			};
+
+			if (rle_transmitter_stats_get_queue_size(transmitter, frag_id) > 0) {
+				continue;
+			}
+			memset(sdu_buffer, (int)sdus_in, sdu.size);
+			if (rle_encapsulate(transmitter, &sdu, frag_id) != RLE_ENCAP_OK) {
+				PRINT_ERROR("Encapsulation of SDU #%zu failed.", sdus_in);
+				return false;
+			}
+			sdus_in++;
+		}
+
+		if (use_plan && rle_pack_plan(transmitter, fpdu_sizes, fpdus_nr, search_max, slots,
+		                              sizeof(slots) / sizeof(slots[0]), &info) != 0) {
+			PRINT_ERROR("Planning of superframe #%zu failed.", count->superframes_nr);
+			return false;
+		}
+		if (use_plan && search_max > 0) {
+			struct rle_pack_plan_info heuristic;
+
+			/* the search starts from the heuristic plan, it cannot carry less */
+			if (rle_pack_plan(transmitter, fpdu_sizes, fpdus_nr, 0, slots,
+			                  sizeof(slots) / sizeof(slots[0]), &heuristic) != 0 ||
+			    rle_pack_plan(transmitter, fpdu_sizes, fpdus_nr, search_max, slots,
+			                  sizeof(slots) / sizeof(slots[0]), &info) != 0 ||
+			    info.completed_nr < heuristic.completed_nr ||
+			    (info.completed_nr == heuristic.completed_nr &&
+			     info.alpdu_bytes + heuristic.trailer_bytes <
+			     heuristic.alpdu_bytes + info.trailer_bytes)) {
+				PRINT_ERROR("Search of superframe #%zu is worse than the heuristic.",
+				            count->superframes_nr);
+				return false;
+			}
+		}
+
+		for (fpdu_id = 0; fpdu_id < fpdus_nr; ++fpdu_id) {
+			struct rle_sdu sdus[RLE_MAX_FRAG_NUMBER];
+			size_t fpdu_pos = 0;
+			size_t fpdu_remain = fpdu_sizes[fpdu_id];
+			size_t sdus_nr_out = 0;
+			size_t i;
+
+			frag_id = 0;
+			while (fpdu_remain > 0) {
+				unsigned char *ppdu;
+				size_t ppdu_len;
+				size_t burst_size = fpdu_remain;
+
+				if (use_plan) {
+					if (slot_id >= info.slots_nr || slots[slot_id].fpdu_id != fpdu_id) {
+						break;
+					}
+					frag_id = slots[slot_id].frag_id;
+					burst_size = slots[slot_id].burst_size;
+				} else {
+					while (frag_id < RLE_MAX_FRAG_NUMBER &&
+					       rle_transmitter_stats_get_queue_size(transmitter, frag_id) == 0) {
+						frag_id++;
+					}
+					if (frag_id >= RLE_MAX_FRAG_NUMBER) {
+						break;
+					}
+				}
+
+				switch (rle_fragment(transmitter, frag_id, burst_size, &ppdu, &ppdu_len)) {
+				case RLE_FRAG_OK:
+					break;
+				case RLE_FRAG_ERR_BURST_TOO_SMALL:
+					if (!use_plan) {
+						/* first-fit: the next context may fit in the room left */
+						frag_id++;
+						continue;
+					}
+				/* fall through */
+				default:
+					PRINT_ERROR("Fragmentation in FPDU #%zu failed.", fpdu_id);
+					return false;
+				}
+				if (use_plan && ppdu_len != slots[slot_id].ppdu_len) {
+					PRINT_ERROR("PPDU of %zu bytes instead of %zu planned.", ppdu_len,
+					            slots[slot_id].ppdu_len);
+					return false;
+				}
+				if (rle_pack(ppdu, ppdu_len, NULL, 0, fpdu, &fpdu_pos,
+				             &fpdu_remain) != RLE_PACK_OK) {
+					PRINT_ERROR("Packing in FPDU #%zu failed.", fpdu_id);
+					return false;
+				}
+				count->ppdu_bytes += ppdu_len;
+				slot_id++;
+			}
+			rle_pad(fpdu, fpdu_pos, fpdu_remain);
+			count->padding_bytes += fpdu_remain;
+
+			for (i = 0; i < RLE_MAX_FRAG_NUMBER; ++i) {
+				sdus[i].buffer = sdus_out_buffers[i];
+				sdus[i].size = 0;
+				sdus[i].protocol_type = 0;
+			}
+			if (rle_decapsulate(receiver, fpdu, fpdu_sizes[fpdu_id], sdus, RLE_MAX_FRAG_NUMBER,
+			                    &sdus_nr_out, NULL, 0) != RLE_DECAP_OK) {
+				PRINT_ERROR("Decapsulation of FPDU #%zu failed.", fpdu_id);
+				return false;
+			}
+			for (i = 0; i < sdus_nr_out; ++i) {
+				const size_t sdu_id = sdus[i].buffer[0];
+				size_t byte;
+
+				for (byte = 1; byte < sdus[i].size; ++byte) {
+					if (sdus[i].buffer[byte] != sdu_id) {
+						break;
+					}
+				}
+				if (byte < sdus[i].size || sdu_id >= sdus_nr || sdus[i].size != sdu_lens[sdu_id]) {
+					PRINT_ERROR("SDU of %zu bytes is corrupted.", sdus[i].size);
+					return false;
+				}
+			}
+			sdus_out += sdus_nr_out;
+		}
+
+		if (use_plan && slot_id != info.slots_nr) {
+			PRINT_ERROR("%zu PPDUs sent instead of %zu planned.", slot_id, info.slots_nr);
+			return false;
+		}
+
+		count->superframes_nr++;
+		if (count->superframes_nr > sdus_nr) {
+			PRINT_ERROR("SDUs are not all sent.");
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool send_ppdu(struct rle_transmitter *const transmitter, const uint8_t frag_id,
+                      const size_t fpdu_size, struct rle_receiver *const receiver,
+                      struct rle_sdu *const sdu, size_t *const sdus_nr)
+{
+	unsigned char fpdu[RLE_MAX_PPDU_PL_SIZE + 2];
+	unsigned char *ppdu;
+	size_t ppdu_len;
+	size_t fpdu_pos = 0;
+	size_t fpdu_remain = fpdu_size;
+
+	if (fpdu_size > sizeof(fpdu) ||
+	    rle_fragment(transmitter, frag_id, fpdu_remain, &ppdu, &ppdu_len) != RLE_FRAG_OK ||
+	    rle_pack(ppdu, ppdu_len, NULL, 0, fpdu, &fpdu_pos, &fpdu_remain) != RLE_PACK_OK) {
+		return false;
+	}
+	rle_pad(fpdu, fpdu_pos, fpdu_remain);
+
+	return (rle_decapsulate(receiver, fpdu, fpdu_size, sdu, 1, sdus_nr, NULL, 0) ==
+	        RLE_DECAP_OK);
+}
+
+static void count_instance_trace(void *const priv, const int module_id __attribute__((unused)),
+                                 const int level, const char *const file __attribute__((unused)),
+                                 const int line __attribute__((unused)),
+                                 const char *const func __attribute__((unused)),
+                                 const char *const message __attribute__((unused)), ...)
+{
+	count_trace((struct trace_count *)priv, level);
+}
+
+static void count_global_trace(const int module_id __attribute__((unused)), const int level,
+                               const char *const file __attribute__((unused)),
+                               const int line __attribute__((unused)),
+                               const char *const func __attribute__((unused)),
+                               const char *const message __attribute__((unused)), ...)
+{
+	count_trace(&global_trace_count, level);
+}
+
+static void * count_alloc(void *const priv, const size_t size)
+{
+	((struct alloc_count *)priv)->allocs++;
+
+	return malloc(size);
+}
+
+static void count_free(void *const priv, void *const ptr)
+{
+	((struct alloc_count *)priv)->frees++;
+	free(ptr);
+}
+
+static bool check_fragment_estimate(struct rle_transmitter *const transmitter,
+                                    const struct rle_config *const conf,
+                                    const struct rle_sdu *const sdu,
+                                    const size_t bursts[], const size_t bursts_nr)
+{
+	struct rle_frag_estimate estimate;
+	size_t ppdus_nr = 0;
+	size_t ppdu_bytes = 0;
+	size_t padding_bytes = 0;
+	size_t i;
+
+	if (rle_fragment_estimate(conf, sdu, bursts, bursts_nr, &estimate) != 0) {
+		PRINT_ERROR("Estimation failed for a %zu-byte SDU.", sdu->size);
+		return false;
+	}
+
+	if (rle_encapsulate(transmitter, sdu, 0) != RLE_ENCAP_OK) {
+		PRINT_ERROR("Encapsulation failed for a %zu-byte SDU.", sdu->size);
+		return false;
+	}
+
+	for (i = 0; i < bursts_nr && rle_transmitter_stats_get_queue_size(transmitter, 0) > 0; ++i) {
+		unsigned char *ppdu;
+		size_t ppdu_len;
+
+		switch (rle_fragment(transmitter, 0, bursts[i], &ppdu, &ppdu_len)) {
+		case RLE_FRAG_OK:
+			ppdus_nr++;
+			ppdu_bytes += ppdu_len;
+			padding_bytes += bursts[i] - ppdu_len;
+			break;
+		case RLE_FRAG_ERR_BURST_TOO_SMALL:
+			padding_bytes += bursts[i];
+			break;
+		default:
+			PRINT_ERROR("Fragmentation failed for a %zu-byte SDU.", sdu->size);
+			return false;
+		}
+	}
+
+	if (estimate.ppdus_nr != ppdus_nr || estimate.bursts_nr != i ||
+	    estimate.ppdu_bytes != ppdu_bytes || estimate.padding_bytes != padding_bytes ||
+	    (estimate.remaining_bytes == 0) !=
+	    (rle_transmitter_stats_get_queue_size(transmitter, 0) == 0)) {
+		PRINT_ERROR("Estimate of a %zu-byte SDU with protocol type 0x%04x over %zu bursts: "
+		            "%zu PPDUs, %zu bursts, %zu bytes, %zu padding, %zu remaining, while "
+		            "%zu PPDUs, %zu bursts, %zu bytes, %zu padding, %zu queued", sdu->size,
+		            sdu->protocol_type, bursts_nr, estimate.ppdus_nr, estimate.bursts_nr,
+		            estimate.ppdu_bytes, estimate.padding_bytes, estimate.remaining_bytes,
+		            ppdus_nr, i, ppdu_bytes, padding_bytes,
+		            rle_transmitter_stats_get_queue_size(transmitter, 0));
+		return false;
+	}
+
+	/* all the octets are accounted for, the VLAN frames may lose their protocol field */
+	if (estimate.remaining_bytes == 0 && sdu->protocol_type != 0x8100 &&
+	    estimate.ppdu_bytes != estimate.header_bytes + sdu->size + estimate.trailer_bytes) {
+		PRINT_ERROR("Estimate of a %zu-byte SDU: %zu bytes of PPDUs, while %zu bytes of headers "
+		            "and %zu bytes of trailer", sdu->size, estimate.ppdu_bytes,
+		            estimate.header_bytes, estimate.trailer_bytes);
+		return false;
+	}
+
+	/* flush the context for the next SDU */
+	while (rle_transmitter_stats_get_queue_size(transmitter, 0) > 0) {
+		unsigned char *ppdu;
+		size_t ppdu_len;
+
+		if (rle_fragment(transmitter, 0, 1000, &ppdu, &ppdu_len) != RLE_FRAG_OK) {
+			PRINT_ERROR("Fragmentation of the rest of the SDU failed.");
+			return false;
+		}
+	}
+
+	return true;
+}
+
 static char * get_fpdu_type(const enum rle_fpdu_types fpdu_type)
 {
 	switch (fpdu_type) {
@@ -532,3 +947,1825 @@ out:
 
 	return output;
 }
+
+bool test_rle_latency(void)
+{
+	bool output = false;
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 0,
+		.allow_alpdu_crc = 0,
+		.allow_alpdu_sequence_number = 1,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	const uint8_t frag_id = 3;
+	unsigned char sdu_buffer[300];
+	struct rle_sdu sdu = {
+		.buffer = sdu_buffer,
+		.size = sizeof(sdu_buffer),
+		.protocol_type = 0x0800,
+	};
+	unsigned char fpdu[1000];
+	unsigned char sdu_out_buffer[RLE_MAX_PDU_SIZE];
+	struct rle_sdu sdu_out = { .buffer = sdu_out_buffer, .size = 0, .protocol_type = 0 };
+	struct rle_latency_histo histo;
+	struct rle_transmitter *t = NULL;
+	struct rle_receiver *r = NULL;
+	size_t sdus_nr = 0;
+	size_t i;
+
+	PRINT_TEST("RLE latency histograms.\n");
+
+	memset(sdu_buffer, 0x42, sizeof(sdu_buffer));
+
+	t = rle_transmitter_new(&conf);
+	r = rle_receiver_new(&conf);
+	if (!t || !r) {
+		PRINT_ERROR("Transmitter and receiver should be allocated.");
+		goto out;
+	}
+
+	if (rle_transmitter_latency_get_histo(t, RLE_LATENCY_STAGE_ENCAP, frag_id, &histo) == 0) {
+		PRINT_ERROR("Histograms should not be available before activation.");
+		goto out;
+	}
+
+	if (rle_transmitter_latency_enable(t) != 0 || rle_receiver_latency_enable(r) != 0) {
+		PRINT_ERROR("Latency should be enabled.");
+		goto out;
+	}
+
+	/* Send the SDU in two FPDUs, so that it is fragmented in a START and an END PPDUs */
+	if (rle_encapsulate(t, &sdu, frag_id) != RLE_ENCAP_OK) {
+		PRINT_ERROR("Encapsulation failed.");
+		goto out;
+	}
+	for (i = 0; i < 2; ++i) {
+		unsigned char *ppdu;
+		size_t ppdu_len;
+		size_t fpdu_pos = 0;
+		size_t fpdu_remain = 200;
+
+		if (rle_fragment(t, frag_id, fpdu_remain, &ppdu, &ppdu_len) != RLE_FRAG_OK ||
+		    rle_pack(ppdu, ppdu_len, NULL, 0, fpdu, &fpdu_pos, &fpdu_remain) != RLE_PACK_OK) {
+			PRINT_ERROR("Fragmentation or packing failed.");
+			goto out;
+		}
+		rle_pad(fpdu, fpdu_pos, fpdu_remain);
+		if (rle_decapsulate(r, fpdu, fpdu_pos + fpdu_remain, &sdu_out, 1, &sdus_nr, NULL,
+		                    0) != RLE_DECAP_OK) {
+			PRINT_ERROR("Decapsulation failed.");
+			goto out;
+		}
+	}
+	if (sdus_nr != 1 || sdu_out.size != sdu.size) {
+		PRINT_ERROR("SDU should be reassembled.");
+		goto out;
+	}
+
+	if (rle_transmitter_latency_get_histo(t, RLE_LATENCY_STAGE_ENCAP, frag_id, &histo) != 0 ||
+	    histo.count != 1 || histo.min_ns > histo.max_ns ||
+	    rle_latency_histo_get_percentile(&histo, 10000) != histo.max_ns) {
+		PRINT_ERROR("One encapsulation should be recorded in context %u.", frag_id);
+		goto out;
+	}
+	if (rle_transmitter_latency_get_histo(t, RLE_LATENCY_STAGE_ENCAP, 0, &histo) != 0 ||
+	    histo.count != 0) {
+		PRINT_ERROR("No encapsulation should be recorded in context 0.");
+		goto out;
+	}
+	if (rle_receiver_latency_get_histo(r, RLE_LATENCY_STAGE_DEENCAP, RLE_LATENCY_ALL_CTX,
+	                                   &histo) != 0 || histo.count != 2) {
+		PRINT_ERROR("Two PPDUs should be recorded in decapsulation.");
+		goto out;
+	}
+	if (rle_receiver_latency_get_histo(r, RLE_LATENCY_STAGE_REASM_START, frag_id, &histo) != 0 ||
+	    histo.count != 1 ||
+	    rle_receiver_latency_get_histo(r, RLE_LATENCY_STAGE_REASM_END, frag_id, &histo) != 0 ||
+	    histo.count != 1 ||
+	    rle_receiver_latency_get_histo(r, RLE_LATENCY_STAGE_REASM_COMP, RLE_LATENCY_ALL_CTX,
+	                                   &histo) != 0 || histo.count != 0) {
+		PRINT_ERROR("One START and one END PPDUs should be recorded.");
+		goto out;
+	}
+
+	rle_receiver_latency_reset(r);
+	rle_receiver_latency_disable(r);
+	if (rle_receiver_latency_get_histo(r, RLE_LATENCY_STAGE_DEENCAP, RLE_LATENCY_ALL_CTX,
+	                                   &histo) != 0 || histo.count != 0) {
+		PRINT_ERROR("Histograms should be empty after reset.");
+		goto out;
+	}
+
+	/* bucket lower bounds shall be increasing */
+	for (i = 1; i < RLE_LATENCY_HISTO_BUCKETS; ++i) {
+		if (rle_latency_histo_get_bucket_min(i) <= rle_latency_histo_get_bucket_min(i - 1)) {
+			PRINT_ERROR("Bucket %zu should start after bucket %zu.", i, i - 1);
+			goto out;
+		}
+	}
+
+	output = true;
+
+out:
+
+	rle_transmitter_destroy(&t);
+	rle_receiver_destroy(&r);
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+
+	return output;
+}
+
+bool test_rle_stats_shm(void)
+{
+	bool output = false;
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 0,
+		.allow_alpdu_crc = 0,
+		.allow_alpdu_sequence_number = 1,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	char name[64];
+	unsigned char sdu_buffer[100];
+	const struct rle_sdu sdu = {
+		.buffer = sdu_buffer,
+		.size = sizeof(sdu_buffer),
+		.protocol_type = 0x0800,
+	};
+	struct rle_stats_shm_snapshot snapshot;
+	struct rle_transmitter *t = NULL;
+	struct rle_receiver *r = NULL;
+	struct rle_stats_shm *writer = NULL;
+	struct rle_stats_shm *reader = NULL;
+	struct rle_stats_shm_region *region;
+	struct stat st;
+	bool is_read;
+	int fd;
+
+	PRINT_TEST("RLE shared-memory statistics.\n");
+
+	memset(sdu_buffer, 0x42, sizeof(sdu_buffer));
+	snprintf(name, sizeof(name), "/rle_test_stats_%d", (int)getpid());
+
+	t = rle_transmitter_new(&conf);
+	r = rle_receiver_new(&conf);
+	if (!t || !r) {
+		PRINT_ERROR("Transmitter and receiver should be allocated.");
+		goto out;
+	}
+
+	if (rle_stats_shm_attach(name) != NULL) {
+		PRINT_ERROR("Region should not exist before creation.");
+		goto out;
+	}
+
+	writer = rle_stats_shm_create(name);
+	reader = rle_stats_shm_attach(name);
+	if (!writer || !reader) {
+		PRINT_ERROR("Region should be created and attached.");
+		goto out;
+	}
+
+	if (rle_encapsulate(t, &sdu, 2) != RLE_ENCAP_OK) {
+		PRINT_ERROR("Encapsulation failed.");
+		goto out;
+	}
+
+	if (rle_stats_shm_publish_transmitter(writer, t) != 0 ||
+	    rle_stats_shm_publish_receiver(writer, r) != 0) {
+		PRINT_ERROR("Counters should be published.");
+		goto out;
+	}
+
+	if (rle_stats_shm_publish_transmitter(reader, t) == 0) {
+		PRINT_ERROR("Counters should not be published through a read-only region.");
+		goto out;
+	}
+
+	if (rle_stats_shm_read(reader, &snapshot) != 0) {
+		PRINT_ERROR("Counters should be read.");
+		goto out;
+	}
+
+	if (snapshot.transmitter.updates != 1 || snapshot.receiver.updates != 1 ||
+	    snapshot.transmitter.ctx[2].sdus_in != 1 ||
+	    snapshot.transmitter.ctx[2].bytes_in != sdu.size ||
+	    snapshot.transmitter.total.sdus_in != 1 ||
+	    snapshot.transmitter.queue_size[2] == 0 ||
+	    snapshot.transmitter.queue_size[0] != 0 ||
+	    snapshot.receiver.total.sdus_received != 0) {
+		PRINT_ERROR("Counters read are not the published ones.");
+		goto out;
+	}
+
+	/* a publisher dead in the middle of an update does not hang the readers */
+	fd = shm_open(name, O_RDWR, 0);
+	if (fd < 0) {
+		PRINT_ERROR("Region should be opened.");
+		goto out;
+	}
+	if (fstat(fd, &st) != 0 || (st.st_mode & S_IROTH) != 0) {
+		PRINT_ERROR("Region should not be readable by other users.");
+		close(fd);
+		goto out;
+	}
+	region = mmap(NULL, sizeof(struct rle_stats_shm_region), PROT_READ | PROT_WRITE, MAP_SHARED,
+	              fd, 0);
+	close(fd);
+	if (region == MAP_FAILED) {
+		PRINT_ERROR("Region should be mapped.");
+		goto out;
+	}
+	region->seq++;
+	is_read = (rle_stats_shm_read(reader, &snapshot) == 0);
+	region->seq++;
+	munmap(region, sizeof(struct rle_stats_shm_region));
+	if (is_read) {
+		PRINT_ERROR("Counters should not be read while an update never completes.");
+		goto out;
+	}
+
+	output = true;
+
+out:
+
+	rle_stats_shm_destroy(&reader);
+	rle_stats_shm_destroy(&writer);
+	rle_transmitter_destroy(&t);
+	rle_receiver_destroy(&r);
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+
+	return output;
+}
+
+bool test_rle_trace_callback(void)
+{
+	bool output = false;
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 0,
+		.allow_alpdu_crc = 0,
+		.allow_alpdu_sequence_number = 1,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	/* padding only */
+	unsigned char fpdu_padding[10] = { 0x00 };
+	/* a Complete PPDU longer than the FPDU */
+	unsigned char fpdu_invalid[10] = { 0xff, 0xff };
+	unsigned char sdu_out_buffer[RLE_MAX_PDU_SIZE];
+	struct rle_sdu sdu_out = { .buffer = sdu_out_buffer, .size = 0, .protocol_type = 0 };
+	const rle_trace_callback_t old_callback = rle_get_trace_callback();
+	struct trace_count count = { 0, 0 };
+	struct rle_receiver *r = NULL;
+	size_t sdus_nr = 0;
+
+	PRINT_TEST("RLE per-instance trace callbacks.\n");
+
+	memset(&global_trace_count, 0, sizeof(global_trace_count));
+	rle_set_trace_callback(count_global_trace);
+
+	r = rle_receiver_new(&conf);
+	if (!r) {
+		PRINT_ERROR("Receiver should be allocated.");
+		goto out;
+	}
+
+	rle_receiver_set_trace_callback(r, count_instance_trace, &count, RLE_LOG_LEVEL_DEBUG);
+
+	if (rle_decapsulate(r, fpdu_padding, sizeof(fpdu_padding), &sdu_out, 1, &sdus_nr, NULL,
+	                    0) != RLE_DECAP_OK) {
+		PRINT_ERROR("Decapsulation failed.");
+		goto out;
+	}
+	if (count.debug == 0 || count.error != 0 || global_trace_count.debug != 0) {
+		PRINT_ERROR("Debug traces should go to the receiver callback only.");
+		goto out;
+	}
+
+	/* less severe traces than the runtime level are filtered out */
+	memset(&count, 0, sizeof(count));
+	rle_receiver_set_trace_level(r, RLE_LOG_LEVEL_ERROR);
+	if (rle_decapsulate(r, fpdu_invalid, sizeof(fpdu_invalid), &sdu_out, 1, &sdus_nr, NULL,
+	                    0) == RLE_DECAP_OK) {
+		PRINT_ERROR("Decapsulation of an invalid FPDU should fail.");
+		goto out;
+	}
+	if (count.debug != 0 || count.error == 0) {
+		PRINT_ERROR("Only error traces should go to the receiver callback.");
+		goto out;
+	}
+
+	/* without instance callback, traces go to the global one again */
+	memset(&count, 0, sizeof(count));
+	rle_receiver_set_trace_callback(r, NULL, NULL, RLE_LOG_LEVEL_DEBUG);
+	if (rle_decapsulate(r, fpdu_invalid, sizeof(fpdu_invalid), &sdu_out, 1, &sdus_nr, NULL,
+	                    0) == RLE_DECAP_OK) {
+		PRINT_ERROR("Decapsulation of an invalid FPDU should fail.");
+		goto out;
+	}
+	if (count.error != 0 || global_trace_count.error == 0) {
+		PRINT_ERROR("Traces should go to the global callback.");
+		goto out;
+	}
+
+	output = true;
+
+out:
+
+	rle_receiver_destroy(&r);
+	rle_set_trace_callback(old_callback);
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+
+	return output;
+}
+
+bool test_rle_decap_errors(void)
+{
+	bool output = false;
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 0,
+		.allow_alpdu_crc = 0,
+		.allow_alpdu_sequence_number = 1,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	/* a Complete PPDU longer than the FPDU */
+	unsigned char fpdu_invalid[10] = { 0xff, 0xff };
+	/* a 4-byte Continuation PPDU on the free context 1 */
+	unsigned char fpdu_cont[10] = { 0x00, 0x21, 0x01, 0x02, 0x03, 0x04 };
+	unsigned char sdu_out_buffer[RLE_MAX_PDU_SIZE];
+	struct rle_sdu sdu_out = { .buffer = sdu_out_buffer, .size = 0, .protocol_type = 0 };
+	struct rle_receiver_error_stats stats;
+	struct trace_count count = { 0, 0 };
+	struct rle_receiver *r = NULL;
+	size_t sdus_nr = 0;
+	size_t i;
+
+	PRINT_TEST("RLE decapsulation error counters and trace rate limiting.\n");
+
+	r = rle_receiver_new(&conf);
+	if (!r) {
+		PRINT_ERROR("Receiver should be allocated.");
+		goto out;
+	}
+
+	rle_receiver_set_trace_callback(r, count_instance_trace, &count, RLE_LOG_LEVEL_ERROR);
+
+	/* a 2-trace burst, then 1 trace per second: the bucket is not refilled during the test */
+	rle_receiver_set_error_trace_rate(r, 1, 2);
+	for (i = 0; i < 10; ++i) {
+		if (rle_decapsulate(r, fpdu_invalid, sizeof(fpdu_invalid), &sdu_out, 1, &sdus_nr, NULL,
+		                    0) == RLE_DECAP_OK) {
+			PRINT_ERROR("Decapsulation of an invalid FPDU should fail.");
+			goto out;
+		}
+	}
+	if (rle_receiver_stats_get_errors(r, &stats) != 0) {
+		PRINT_ERROR("Error counters should be available.");
+		goto out;
+	}
+	if (stats.errors[RLE_DECAP_ERROR_INV_LEN] != 10 || stats.traces_suppressed != 8 ||
+	    count.error != 2) {
+		PRINT_ERROR("10 errors expected with 2 traces, %" PRIu64 " errors with %zu traces.",
+		            stats.errors[RLE_DECAP_ERROR_INV_LEN], count.error);
+		goto out;
+	}
+
+	/* without limit, every error is traced */
+	memset(&count, 0, sizeof(count));
+	rle_receiver_set_error_trace_rate(r, 0, 0);
+	if (rle_decapsulate(r, fpdu_cont, sizeof(fpdu_cont), &sdu_out, 1, &sdus_nr, NULL,
+	                    0) == RLE_DECAP_OK ||
+	    rle_decapsulate(r, fpdu_cont, sizeof(fpdu_cont), &sdu_out, 1, &sdus_nr, NULL,
+	                    0) == RLE_DECAP_OK) {
+		PRINT_ERROR("Decapsulation of a CONT PPDU on a free context should fail.");
+		goto out;
+	}
+	if (rle_receiver_stats_get_counter_errors(r, RLE_DECAP_ERROR_CTX_STATE) != 2 ||
+	    rle_receiver_stats_get_counter_errors(r, RLE_DECAP_ERROR_INV_LEN) != 10 ||
+	    count.error != 2) {
+		PRINT_ERROR("2 context state errors should be counted and traced.");
+		goto out;
+	}
+
+	rle_receiver_stats_reset_errors(r);
+	if (rle_receiver_stats_get_errors(r, &stats) != 0) {
+		PRINT_ERROR("Error counters should be available.");
+		goto out;
+	}
+	for (i = 0; i < RLE_DECAP_ERROR_NB; ++i) {
+		if (stats.errors[i] != 0) {
+			PRINT_ERROR("Error counters should be reset.");
+			goto out;
+		}
+	}
+	if (stats.traces_suppressed != 0) {
+		PRINT_ERROR("Suppressed traces counter should be reset.");
+		goto out;
+	}
+
+	output = true;
+
+out:
+
+	rle_receiver_destroy(&r);
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+
+	return output;
+}
+
+bool test_rle_alloc_audit(void)
+{
+	bool output = false;
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 0,
+		.allow_alpdu_crc = 0,
+		.allow_alpdu_sequence_number = 1,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	/* SDU lengths of the replayed trace, from a single octet to the largest SDU */
+	const size_t sdu_lens[] = { 40, 576, 1500, 1, 300, 4088, 64, 1280 };
+	/* octets of bulk zeroing allowed per SDU in steady state */
+	const uint64_t zeroed_per_sdu_max = 64;
+	const size_t sdus_nr_max = 1000;
+	const size_t fpdu_len = 600;
+	unsigned char sdu_buffer[RLE_MAX_PDU_SIZE];
+	unsigned char fpdu[600];
+	unsigned char sdu_out_buffer[RLE_MAX_PDU_SIZE];
+	struct rle_sdu sdu_out = { .buffer = sdu_out_buffer, .size = 0, .protocol_type = 0 };
+	const struct rle_allocator allocator = {
+		.alloc = count_alloc,
+		.free = count_free,
+		.priv = NULL,
+	};
+	struct rle_allocator counting = allocator;
+	struct alloc_count count = { 0, 0 };
+	struct rle_alloc_audit audit;
+	struct rle_transmitter *t = NULL;
+	struct rle_receiver *r = NULL;
+	size_t sdus_in = 0;
+	size_t sdus_out = 0;
+
+	PRINT_TEST("RLE allocation and zeroing audit.\n");
+
+	memset(sdu_buffer, 0x42, sizeof(sdu_buffer));
+
+	counting.priv = &count;
+	rle_set_allocator(&counting);
+	rle_alloc_audit_reset();
+	rle_alloc_audit_enable();
+
+	t = rle_transmitter_new(&conf);
+	r = rle_receiver_new(&conf);
+	if (!t || !r) {
+		PRINT_ERROR("Transmitter and receiver should be allocated.");
+		goto out;
+	}
+
+	rle_alloc_audit_get(&audit);
+	if (count.allocs == 0 || audit.allocs != count.allocs || audit.bytes_allocated == 0) {
+		PRINT_ERROR("Creation should allocate through the registered allocator, %zu "
+		            "allocations with it, %" PRIu64 " audited.", count.allocs, audit.allocs);
+		goto out;
+	}
+
+	/* steady state: replay the trace on all the contexts */
+	rle_alloc_audit_reset();
+	for (sdus_in = 0; sdus_in < sdus_nr_max; ++sdus_in) {
+		const struct rle_sdu sdu = {
+			.buffer = sdu_buffer,
+			.size = sdu_lens[sdus_in % (sizeof(sdu_lens) / sizeof(sdu_lens[0]))],
+			.protocol_type = 0x0800,
+		};
+		const uint8_t frag_id = sdus_in % RLE_MAX_FRAG_NUMBER;
+
+		if (rle_encapsulate(t, &sdu, frag_id) != RLE_ENCAP_OK) {
+			PRINT_ERROR("Encapsulation of SDU %zu failed.", sdus_in);
+			goto out;
+		}
+		while (rle_transmitter_stats_get_queue_size(t, frag_id) > 0) {
+			size_t fpdu_pos = 0;
+			size_t fpdu_remain = fpdu_len;
+			size_t sdus_nr = 0;
+			unsigned char *ppdu;
+			size_t ppdu_len;
+
+			if (rle_fragment(t, frag_id, fpdu_remain, &ppdu, &ppdu_len) != RLE_FRAG_OK ||
+			    rle_pack(ppdu, ppdu_len, NULL, 0, fpdu, &fpdu_pos, &fpdu_remain) != RLE_PACK_OK) {
+				PRINT_ERROR("Fragmentation or packing of SDU %zu failed.", sdus_in);
+				goto out;
+			}
+			rle_pad(fpdu, fpdu_pos, fpdu_remain);
+			if (rle_decapsulate(r, fpdu, fpdu_len, &sdu_out, 1, &sdus_nr, NULL,
+			                    0) != RLE_DECAP_OK) {
+				PRINT_ERROR("Decapsulation of SDU %zu failed.", sdus_in);
+				goto out;
+			}
+			sdus_out += sdus_nr;
+		}
+	}
+	rle_alloc_audit_get(&audit);
+
+	if (sdus_out != sdus_in) {
+		PRINT_ERROR("%zu SDUs sent, %zu received.", sdus_in, sdus_out);
+		goto out;
+	}
+	if (audit.allocs != 0 || audit.alloc_failures != 0 || audit.frees != 0) {
+		PRINT_ERROR("Steady state should not allocate, %" PRIu64 " allocations and %" PRIu64
+		            " releases for %zu SDUs.", audit.allocs, audit.frees, sdus_in);
+		goto out;
+	}
+	if (audit.bytes_zeroed > zeroed_per_sdu_max * sdus_in) {
+		PRINT_ERROR("%" PRIu64 " octets zeroed for %zu SDUs, at most %" PRIu64 " per SDU "
+		            "expected.", audit.bytes_zeroed, sdus_in, zeroed_per_sdu_max);
+		goto out;
+	}
+	PRINT_TEST("%zu SDUs: %" PRIu64 " allocations, %" PRIu64 " octets zeroed, %" PRIu64
+	           " octets poisoned.\n", sdus_in, audit.allocs, audit.bytes_zeroed,
+	           audit.bytes_poisoned);
+
+	rle_transmitter_destroy(&t);
+	rle_receiver_destroy(&r);
+	if (count.frees != count.allocs) {
+		PRINT_ERROR("Destruction should release all the blocks, %zu allocated, %zu released.",
+		            count.allocs, count.frees);
+		goto out;
+	}
+
+	output = true;
+
+out:
+
+	rle_transmitter_destroy(&t);
+	rle_receiver_destroy(&r);
+	rle_alloc_audit_disable();
+	rle_set_allocator(NULL);
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+
+	return output;
+}
+
+bool test_rle_instance_placement(void)
+{
+	bool output = false;
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 0,
+		.allow_alpdu_crc = 1,
+		.allow_alpdu_sequence_number = 0,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	/* node and flags of the placed instances, node 0 exists on all the machines */
+	const struct {
+		int node;
+		unsigned int flags;
+	} placements[] = {
+		{ RLE_NUMA_NODE_ANY, 0 },
+		{ 0, 0 },
+		{ 0, RLE_PLACEMENT_HUGEPAGES },
+	};
+	const uint8_t frag_id = 5;
+	unsigned char sdu_buffer[1500];
+	const struct rle_sdu sdu = {
+		.buffer = sdu_buffer,
+		.size = sizeof(sdu_buffer),
+		.protocol_type = 0x86dd,
+	};
+	unsigned char fpdu[600];
+	unsigned char sdu_out_buffer[RLE_MAX_PDU_SIZE];
+	struct rle_sdu sdu_out = { .buffer = sdu_out_buffer, .size = 0, .protocol_type = 0 };
+	struct rle_allocator allocator = {
+		.alloc = count_alloc,
+		.free = count_free,
+		.priv = NULL,
+	};
+	struct alloc_count count = { 0, 0 };
+	struct rle_transmitter *t = NULL;
+	struct rle_receiver *r = NULL;
+	size_t i;
+
+	PRINT_TEST("RLE per-instance allocators and NUMA placement.\n");
+
+	memset(sdu_buffer, 0x5a, sizeof(sdu_buffer));
+
+	/* per-instance allocator, the registered one stays the default */
+	allocator.priv = &count;
+	t = rle_transmitter_new_with_allocator(&conf, &allocator);
+	r = rle_receiver_new_with_allocator(&conf, &allocator);
+	if (!t || !r || count.allocs == 0) {
+		PRINT_ERROR("Transmitter and receiver should be allocated with their allocator.");
+		goto out;
+	}
+	if (rle_transmitter_latency_enable(t) != 0 || rle_receiver_latency_enable(r) != 0) {
+		PRINT_ERROR("Latency should be enabled.");
+		goto out;
+	}
+	rle_transmitter_destroy(&t);
+	rle_receiver_destroy(&r);
+	if (count.frees != count.allocs) {
+		PRINT_ERROR("Destruction should release all the blocks with the instance allocator, %zu "
+		            "allocated, %zu released.", count.allocs, count.frees);
+		goto out;
+	}
+
+	for (i = 0; i < sizeof(placements) / sizeof(placements[0]); ++i) {
+		size_t sdus_nr = 0;
+		size_t round;
+
+		t = rle_transmitter_new_on_node(&conf, placements[i].node, placements[i].flags);
+		r = rle_receiver_new_on_node(&conf, placements[i].node, placements[i].flags);
+		if (!t || !r) {
+			PRINT_ERROR("Transmitter and receiver should be placed on node %d with flags 0x%x.",
+			            placements[i].node, placements[i].flags);
+			goto out;
+		}
+
+		/* the latency histograms do not fit in the region of the instance */
+		if (rle_receiver_latency_enable(r) != 0) {
+			PRINT_ERROR("Latency should be enabled.");
+			goto out;
+		}
+
+		if (rle_encapsulate(t, &sdu, frag_id) != RLE_ENCAP_OK) {
+			PRINT_ERROR("Encapsulation failed.");
+			goto out;
+		}
+		for (round = 0; rle_transmitter_stats_get_queue_size(t, frag_id) > 0; ++round) {
+			size_t fpdu_pos = 0;
+			size_t fpdu_remain = sizeof(fpdu);
+			unsigned char *ppdu;
+			size_t ppdu_len;
+
+			if (rle_fragment(t, frag_id, fpdu_remain, &ppdu, &ppdu_len) != RLE_FRAG_OK ||
+			    rle_pack(ppdu, ppdu_len, NULL, 0, fpdu, &fpdu_pos, &fpdu_remain) != RLE_PACK_OK) {
+				PRINT_ERROR("Fragmentation or packing failed.");
+				goto out;
+			}
+			rle_pad(fpdu, fpdu_pos, fpdu_remain);
+			if (rle_decapsulate(r, fpdu, sizeof(fpdu), &sdu_out, 1, &sdus_nr, NULL,
+			                    0) != RLE_DECAP_OK) {
+				PRINT_ERROR("Decapsulation failed.");
+				goto out;
+			}
+		}
+		if (round < 2 || sdus_nr != 1 || sdu_out.size != sdu.size ||
+		    memcmp(sdu_out.buffer, sdu.buffer, sdu.size) != 0) {
+			PRINT_ERROR("SDU should be fragmented and reassembled.");
+			goto out;
+		}
+
+		rle_transmitter_destroy(&t);
+		rle_receiver_destroy(&r);
+	}
+
+	if (rle_receiver_new_on_node(&conf, 1 << 20, 0) != NULL) {
+		PRINT_ERROR("Placement on an invalid node should fail.");
+		goto out;
+	}
+
+	output = true;
+
+out:
+
+	rle_transmitter_destroy(&t);
+	rle_receiver_destroy(&r);
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+
+	return output;
+}
+
+bool test_rle_bulk_instances(void)
+{
+	bool output = false;
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = 0,
+		.allow_alpdu_sequence_number = 1,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	enum { instances_nr = 64 };
+	struct rle_transmitter *transmitters[instances_nr];
+	struct rle_receiver *receivers[instances_nr];
+	unsigned char sdu_buffer[1000];
+	const struct rle_sdu sdu = {
+		.buffer = sdu_buffer,
+		.size = sizeof(sdu_buffer),
+		.protocol_type = 0x0800,
+	};
+	unsigned char fpdu[300];
+	unsigned char sdu_out_buffer[RLE_MAX_PDU_SIZE];
+	size_t i;
+
+	PRINT_TEST("RLE bulk creation and destruction of instances.\n");
+
+	memset(transmitters, 0, sizeof(transmitters));
+	memset(receivers, 0, sizeof(receivers));
+
+	if (rle_receiver_new_bulk(&conf, 0, RLE_NUMA_NODE_ANY, 0, receivers) == 0) {
+		PRINT_ERROR("Bulk creation of no receivers should fail.");
+		goto out;
+	}
+
+	if (rle_transmitter_new_bulk(&conf, instances_nr, RLE_NUMA_NODE_ANY, 0, transmitters) != 0 ||
+	    rle_receiver_new_bulk(&conf, instances_nr, RLE_NUMA_NODE_ANY, 0, receivers) != 0) {
+		PRINT_ERROR("Bulk creation failed.");
+		goto out;
+	}
+
+	for (i = 0; i < instances_nr; ++i) {
+		const uint8_t frag_id = i % RLE_MAX_FRAG_NUMBER;
+		struct rle_sdu sdu_out = { .buffer = sdu_out_buffer, .size = 0, .protocol_type = 0 };
+		size_t sdus_nr = 0;
+
+		memset(sdu_buffer, (int)i, sizeof(sdu_buffer));
+
+		if (rle_encapsulate(transmitters[i], &sdu, frag_id) != RLE_ENCAP_OK) {
+			PRINT_ERROR("Encapsulation failed with transmitter #%zu.", i);
+			goto out;
+		}
+		while (rle_transmitter_stats_get_queue_size(transmitters[i], frag_id) > 0) {
+			size_t fpdu_pos = 0;
+			size_t fpdu_remain = sizeof(fpdu);
+			unsigned char *ppdu;
+			size_t ppdu_len;
+
+			if (rle_fragment(transmitters[i], frag_id, fpdu_remain, &ppdu,
+			                 &ppdu_len) != RLE_FRAG_OK ||
+			    rle_pack(ppdu, ppdu_len, NULL, 0, fpdu, &fpdu_pos, &fpdu_remain) != RLE_PACK_OK) {
+				PRINT_ERROR("Fragmentation or packing failed with transmitter #%zu.", i);
+				goto out;
+			}
+			rle_pad(fpdu, fpdu_pos, fpdu_remain);
+			if (rle_decapsulate(receivers[i], fpdu, sizeof(fpdu), &sdu_out, 1, &sdus_nr, NULL,
+			                    0) != RLE_DECAP_OK) {
+				PRINT_ERROR("Decapsulation failed with receiver #%zu.", i);
+				goto out;
+			}
+		}
+		if (sdus_nr != 1 || sdu_out.size != sdu.size ||
+		    memcmp(sdu_out.buffer, sdu.buffer, sdu.size) != 0) {
+			PRINT_ERROR("SDU should be reassembled by receiver #%zu.", i);
+			goto out;
+		}
+	}
+
+	/* the region outlives the instances destroyed alone */
+	rle_transmitter_destroy(&transmitters[0]);
+	rle_receiver_destroy(&receivers[0]);
+	if (rle_receiver_latency_enable(receivers[1]) != 0) {
+		PRINT_ERROR("Latency should be enabled.");
+		goto out;
+	}
+
+	output = true;
+
+out:
+
+	rle_transmitter_destroy_bulk(transmitters, instances_nr);
+	rle_receiver_destroy_bulk(receivers, instances_nr);
+	for (i = 0; i < instances_nr; ++i) {
+		if (transmitters[i] != NULL || receivers[i] != NULL) {
+			PRINT_ERROR("Bulk destruction should reset the instances.");
+			output = false;
+			break;
+		}
+	}
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+
+	return output;
+}
+
+bool test_rle_fragment_estimate(void)
+{
+	bool output = false;
+	const struct rle_config confs[] = {
+		{
+			.allow_ptype_omission = 0, .use_compressed_ptype = 0, .allow_alpdu_crc = 0,
+			.allow_alpdu_sequence_number = 1, .implicit_protocol_type = 0x00,
+		},
+		{
+			.allow_ptype_omission = 0, .use_compressed_ptype = 1, .allow_alpdu_crc = 1,
+			.allow_alpdu_sequence_number = 0, .implicit_protocol_type = 0x00,
+		},
+		{
+			.allow_ptype_omission = 1, .use_compressed_ptype = 1, .allow_alpdu_crc = 1,
+			.allow_alpdu_sequence_number = 0, .implicit_protocol_type = RLE_PROTO_TYPE_IP_COMP,
+		},
+		{
+			.allow_ptype_omission = 1, .use_compressed_ptype = 0, .allow_alpdu_crc = 0,
+			.allow_alpdu_sequence_number = 1,
+			.implicit_protocol_type = RLE_PROTO_TYPE_VLAN_COMP_WO_PTYPE_FIELD,
+		},
+	};
+	const uint16_t ptypes[] = { 0x0800, 0x8100, 0x1234, 0x0082 };
+	const size_t sdu_lens[] = {
+		1, 2, 3, 4, 5, 10, 19, 100, 593, 594, 595, 596, 597, 598, 599, 600, 1500, 2043, 2044,
+		2045, 2046, 2047, 2048, 2049, 2050, 4087, 4088
+	};
+	/* a standard burst, shorter and longer ones, some too small for any PPDU */
+	const size_t bursts_std[] = { 600, 600, 600, 600, 600, 600, 600, 600, 600 };
+	const size_t bursts_mixed[] = { 1, 7, 2, 5, 3, 2100, 4, 6, 1, 9, 300, 3, 8, 4000, 5, 2 };
+	const size_t bursts_short[] = { 2, 3, 4, 5, 6, 7, 8 };
+	const struct {
+		const size_t *sizes;
+		size_t nr;
+	} bursts[] = {
+		{ bursts_std, sizeof(bursts_std) / sizeof(bursts_std[0]) },
+		{ bursts_mixed, sizeof(bursts_mixed) / sizeof(bursts_mixed[0]) },
+		{ bursts_short, sizeof(bursts_short) / sizeof(bursts_short[0]) },
+	};
+	unsigned char sdu_buffer[RLE_MAX_PDU_SIZE];
+	struct rle_sdu sdu = { .buffer = sdu_buffer, .size = 0, .protocol_type = 0 };
+	struct rle_frag_estimate estimate;
+	struct rle_transmitter *transmitter = NULL;
+	size_t conf_id;
+
+	PRINT_TEST("RLE estimation of the PPDUs of a SDU.\n");
+
+	/* an Ethernet/VLAN/IPv4 frame, also an IPv4 packet for its first 4 bits */
+	memset(sdu_buffer, 0x00, sizeof(sdu_buffer));
+	sdu_buffer[0] = 0x45;
+	sdu_buffer[12] = 0x81;
+	sdu_buffer[13] = 0x00;
+	sdu_buffer[16] = 0x08;
+	sdu_buffer[17] = 0x00;
+	sdu_buffer[18] = 0x45;
+
+	sdu.size = RLE_MAX_PDU_SIZE + 1;
+	sdu.protocol_type = 0x0800;
+	if (rle_fragment_estimate(&confs[0], &sdu, bursts_std, 1, &estimate) == 0) {
+		PRINT_ERROR("Estimation of a too large SDU should fail.");
+		goto out;
+	}
+
+	for (conf_id = 0; conf_id < sizeof(confs) / sizeof(confs[0]); ++conf_id) {
+		size_t ptype_id;
+
+		transmitter = rle_transmitter_new(&confs[conf_id]);
+		if (transmitter == NULL) {
+			PRINT_ERROR("Transmitter not created.");
+			goto out;
+		}
+
+		for (ptype_id = 0; ptype_id < sizeof(ptypes) / sizeof(ptypes[0]); ++ptype_id) {
+			size_t len_id;
+
+			for (len_id = 0; len_id < sizeof(sdu_lens) / sizeof(sdu_lens[0]); ++len_id) {
+				size_t bursts_id;
+
+				sdu.size = sdu_lens[len_id];
+				sdu.protocol_type = ptypes[ptype_id];
+
+				for (bursts_id = 0; bursts_id < sizeof(bursts) / sizeof(bursts[0]); ++bursts_id) {
+					if (!check_fragment_estimate(transmitter, &confs[conf_id], &sdu,
+					                             bursts[bursts_id].sizes, bursts[bursts_id].nr)) {
+						PRINT_ERROR("Mismatch with configuration #%zu.", conf_id);
+						goto out;
+					}
+				}
+			}
+		}
+
+		rle_transmitter_destroy(&transmitter);
+	}
+
+	output = true;
+
+out:
+
+	rle_transmitter_destroy(&transmitter);
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+
+	return output;
+}
+
+bool test_rle_pack_plan(void)
+{
+	bool output = false;
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = 1,
+		.allow_alpdu_sequence_number = 0,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	const size_t sdu_pattern[] = {
+		40, 576, 1500, 40, 1500, 64, 1280, 4088, 590, 120, 1000, 300, 52, 1420, 800, 200
+	};
+	const size_t fpdu_sizes[] = { 599, 599, 1199, 311, 899 };
+	const size_t fpdus_nr = sizeof(fpdu_sizes) / sizeof(fpdu_sizes[0]);
+	const size_t search_max = 100000;
+	size_t sdu_lens[64];
+	struct rle_transmitter *transmitter = NULL;
+	struct rle_receiver *receiver = NULL;
+	struct rle_pack_slot slots[RLE_MAX_FRAG_NUMBER * 8];
+	struct rle_pack_plan_info info;
+	struct superframe_count first_fit;
+	struct superframe_count heuristic;
+	struct superframe_count searched;
+	struct superframe_count *const counts[] = { &first_fit, &heuristic, &searched };
+	unsigned char sdu_buffer[500];
+	const struct rle_sdu sdu = {
+		.buffer = sdu_buffer,
+		.size = sizeof(sdu_buffer),
+		.protocol_type = 0x0800,
+	};
+	size_t i;
+
+	PRINT_TEST("RLE plan of the PPDUs over several FPDUs.\n");
+
+	memset(sdu_buffer, 0x42, sizeof(sdu_buffer));
+	for (i = 0; i < sizeof(sdu_lens) / sizeof(sdu_lens[0]); ++i) {
+		sdu_lens[i] = sdu_pattern[i % (sizeof(sdu_pattern) / sizeof(sdu_pattern[0]))];
+	}
+
+	transmitter = rle_transmitter_new(&conf);
+	if (transmitter == NULL) {
+		PRINT_ERROR("Transmitter creation failed.");
+		goto out;
+	}
+
+	if (rle_pack_plan(NULL, fpdu_sizes, fpdus_nr, 0, slots, 1, &info) == 0 ||
+	    rle_pack_plan(transmitter, fpdu_sizes, 0, 0, slots, 1, &info) == 0 ||
+	    rle_pack_plan(transmitter, fpdu_sizes, RLE_PACK_PLAN_FPDUS_MAX + 1, 0, slots, 1,
+	                  &info) == 0) {
+		PRINT_ERROR("Planning with invalid parameters should fail.");
+		goto out;
+	}
+
+	if (rle_pack_plan(transmitter, fpdu_sizes, fpdus_nr, 0, slots, 1, &info) != 0 ||
+	    info.slots_nr != 0 || info.padding_bytes != 599 + 599 + 1199 + 311 + 899) {
+		PRINT_ERROR("Planning without SDUs should pad all the FPDUs.");
+		goto out;
+	}
+
+	for (i = 0; i < 3; ++i) {
+		if (rle_encapsulate(transmitter, &sdu, i) != RLE_ENCAP_OK) {
+			PRINT_ERROR("Encapsulation failed.");
+			goto out;
+		}
+	}
+	if (rle_pack_plan(transmitter, fpdu_sizes, fpdus_nr, 0, slots, 2, &info) == 0) {
+		PRINT_ERROR("Planning with too few slots should fail.");
+		goto out;
+	}
+	rle_transmitter_destroy(&transmitter);
+
+	for (i = 0; i < 3; ++i) {
+		transmitter = rle_transmitter_new(&conf);
+		receiver = rle_receiver_new(&conf);
+		if (transmitter == NULL || receiver == NULL) {
+			PRINT_ERROR("Instances creation failed.");
+			goto out;
+		}
+		if (!send_superframes(transmitter, receiver, sdu_lens,
+		                      sizeof(sdu_lens) / sizeof(sdu_lens[0]), fpdu_sizes, fpdus_nr, i > 0,
+		                      i > 1 ? search_max : 0, counts[i])) {
+			goto out;
+		}
+		printf("\t%s: %zu superframes, %zu bytes of PPDUs, %zu bytes of padding\n",
+		       i == 0 ? "first-fit" : (i == 1 ? "heuristic" : "searched"),
+		       counts[i]->superframes_nr, counts[i]->ppdu_bytes, counts[i]->padding_bytes);
+		if (counts[i]->superframes_nr > first_fit.superframes_nr ||
+		    counts[i]->ppdu_bytes > first_fit.ppdu_bytes) {
+			PRINT_ERROR("The plan should not need more superframes or overhead than first-fit.");
+			goto out;
+		}
+		rle_transmitter_destroy(&transmitter);
+		rle_receiver_destroy(&receiver);
+	}
+
+	output = true;
+
+out:
+	if (transmitter != NULL) {
+		rle_transmitter_destroy(&transmitter);
+	}
+	if (receiver != NULL) {
+		rle_receiver_destroy(&receiver);
+	}
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+
+	return output;
+}
+
+bool test_rle_link_stats(void)
+{
+	bool output = false;
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = 1,
+		.allow_alpdu_sequence_number = 0,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 3,
+		.type_0_alpdu_label_size = 0,
+	};
+	const size_t sdu_lens[] = { 40, 1000, 194, 195, 1500, 64, 4088, 196, 600, 2 };
+	const unsigned char label[3] = { 0x01, 0x02, 0x03 };
+	struct rle_transmitter *transmitter = NULL;
+	struct rle_link_stats stats;
+	unsigned char sdu_buffer[RLE_MAX_PDU_SIZE];
+	unsigned char fpdu[200];
+	uint64_t ppdus_per_sdu[RLE_PPDUS_PER_SDU_BUCKETS] = { 0 };
+	uint64_t ctx1_sdu_bytes = 0;
+	uint64_t sdu_bytes = 0;
+	uint64_t header_bytes = 0;
+	uint64_t trailer_bytes = 0;
+	uint64_t ppdu_bytes = 0;
+	uint64_t fragmented = 0;
+	uint64_t ppdus = 0;
+	size_t i;
+
+	PRINT_TEST("RLE link efficiency statistics.\n");
+
+	memset(sdu_buffer, 0x42, sizeof(sdu_buffer));
+
+	transmitter = rle_transmitter_new(&conf);
+	if (transmitter == NULL) {
+		PRINT_ERROR("Transmitter creation failed.");
+		goto out;
+	}
+
+	if (rle_transmitter_stats_get_link(NULL, &stats) == 0 ||
+	    rle_transmitter_stats_get_link(transmitter, NULL) == 0) {
+		PRINT_ERROR("Statistics with invalid parameters should fail.");
+		goto out;
+	}
+
+	for (i = 0; i < sizeof(sdu_lens) / sizeof(sdu_lens[0]); ++i) {
+		const uint8_t frag_id = i % RLE_MAX_FRAG_NUMBER;
+		const struct rle_sdu sdu = {
+			.buffer = sdu_buffer, .size = sdu_lens[i], .protocol_type = 0x0800
+		};
+		const size_t burst = sizeof(fpdu) - sizeof(label);
+		const size_t bursts[] = { burst, burst, burst, burst, burst, burst, burst, burst,
+		                          burst, burst, burst, burst, burst, burst, burst, burst,
+		                          burst, burst, burst, burst, burst, burst, burst };
+		struct rle_frag_estimate estimate;
+
+		if (rle_fragment_estimate(&conf, &sdu, bursts, sizeof(bursts) / sizeof(bursts[0]),
+		                          &estimate) != 0 || estimate.remaining_bytes != 0) {
+			PRINT_ERROR("Estimation failed for a %zu-byte SDU.", sdu.size);
+			goto out;
+		}
+		ppdus_per_sdu[estimate.ppdus_nr < RLE_PPDUS_PER_SDU_BUCKETS ?
+		              estimate.ppdus_nr - 1 : RLE_PPDUS_PER_SDU_BUCKETS - 1]++;
+		ppdus += estimate.ppdus_nr;
+		fragmented += (estimate.ppdus_nr > 1);
+		header_bytes += estimate.header_bytes;
+		trailer_bytes += estimate.trailer_bytes;
+		sdu_bytes += sdu.size;
+		if (frag_id == 1) {
+			ctx1_sdu_bytes += sdu.size;
+		}
+
+		if (rle_encapsulate(transmitter, &sdu, frag_id) != RLE_ENCAP_OK) {
+			PRINT_ERROR("Encapsulation failed for a %zu-byte SDU.", sdu.size);
+			goto out;
+		}
+		while (rle_transmitter_stats_get_queue_size(transmitter, frag_id) > 0) {
+			size_t fpdu_pos = 0;
+			size_t fpdu_remain = sizeof(fpdu);
+			unsigned char *ppdu;
+			size_t ppdu_len;
+
+			if (rle_pack_init(label, sizeof(label), fpdu, &fpdu_pos,
+			                  &fpdu_remain) != RLE_PACK_OK ||
+			    rle_fragment(transmitter, frag_id, fpdu_remain, &ppdu,
+			                 &ppdu_len) != RLE_FRAG_OK ||
+			    rle_pack(ppdu, ppdu_len, label, sizeof(label), fpdu, &fpdu_pos,
+			             &fpdu_remain) != RLE_PACK_OK) {
+				PRINT_ERROR("Fragmentation or packing failed for a %zu-byte SDU.", sdu.size);
+				goto out;
+			}
+			rle_pad(fpdu, fpdu_pos, fpdu_remain);
+			rle_transmitter_stats_add_fpdu(transmitter, sizeof(label), fpdu_pos, fpdu_remain);
+			ppdu_bytes += ppdu_len;
+		}
+	}
+
+	if (rle_transmitter_stats_get_link(transmitter, &stats) != 0) {
+		PRINT_ERROR("Statistics failed.");
+		goto out;
+	}
+
+	if (stats.total.sdu_bytes != sdu_bytes || stats.ctx[1].sdu_bytes != ctx1_sdu_bytes ||
+	    stats.total.ppdu_hdr_bytes + stats.total.alpdu_hdr_bytes != header_bytes ||
+	    stats.total.trailer_bytes != trailer_bytes ||
+	    stats.total.sdu_bytes + stats.total.ppdu_hdr_bytes + stats.total.alpdu_hdr_bytes +
+	    stats.total.trailer_bytes != ppdu_bytes) {
+		PRINT_ERROR("Octets of SDUs, headers and trailers should add up to the PPDUs.");
+		goto out;
+	}
+
+	if (stats.total.ppdus[RLE_PPDU_TYPE_COMP] + fragmented !=
+	    sizeof(sdu_lens) / sizeof(sdu_lens[0]) ||
+	    stats.total.ppdus[RLE_PPDU_TYPE_START] != fragmented ||
+	    stats.total.ppdus[RLE_PPDU_TYPE_END] != fragmented ||
+	    stats.total.ppdus[RLE_PPDU_TYPE_COMP] + stats.total.ppdus[RLE_PPDU_TYPE_START] +
+	    stats.total.ppdus[RLE_PPDU_TYPE_CONT] + stats.total.ppdus[RLE_PPDU_TYPE_END] != ppdus ||
+	    memcmp(stats.total.ppdus_per_sdu, ppdus_per_sdu, sizeof(ppdus_per_sdu)) != 0) {
+		PRINT_ERROR("PPDUs per type and per SDU should match the estimates.");
+		goto out;
+	}
+
+	if (stats.fpdus != ppdus || stats.fpdu_bytes != ppdus * sizeof(fpdu) ||
+	    stats.label_bytes != ppdus * sizeof(label) ||
+	    stats.label_bytes + ppdu_bytes + stats.padding_bytes != stats.fpdu_bytes) {
+		PRINT_ERROR("Octets of labels, PPDUs and padding should add up to the FPDUs.");
+		goto out;
+	}
+
+	rle_transmitter_stats_reset_link(transmitter);
+	if (rle_transmitter_stats_get_link(transmitter, &stats) != 0 || stats.fpdus != 0 ||
+	    stats.total.sdu_bytes != 0 || stats.total.ppdus_per_sdu[0] != 0) {
+		PRINT_ERROR("Statistics should be reset.");
+		goto out;
+	}
+
+	output = true;
+
+out:
+	if (transmitter != NULL) {
+		rle_transmitter_destroy(&transmitter);
+	}
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+
+	return output;
+}
+
+bool test_rle_sched(void)
+{
+	bool output = false;
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = 1,
+		.allow_alpdu_sequence_number = 0,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 0,
+		.type_0_alpdu_label_size = 0,
+	};
+	struct rle_sched_config sched_conf;
+	struct rle_transmitter *transmitter = NULL;
+	struct rle_transmitter_stats stats;
+	unsigned char sdu_buffer[RLE_MAX_PDU_SIZE];
+	const struct rle_sdu sdu = { .buffer = sdu_buffer, .size = 1000, .protocol_type = 0x0800 };
+	const struct rle_sdu bulk_sdu = {
+		.buffer = sdu_buffer, .size = RLE_MAX_PDU_SIZE, .protocol_type = 0x0800
+	};
+	size_t served[RLE_MAX_FRAG_NUMBER] = { 0 };
+	unsigned char *ppdu;
+	size_t ppdu_len;
+	uint8_t frag_id;
+	size_t i;
+
+	PRINT_TEST("RLE scheduler of the fragmentation contexts.\n");
+
+	memset(sdu_buffer, 0x42, sizeof(sdu_buffer));
+
+	transmitter = rle_transmitter_new(&conf);
+	if (transmitter == NULL) {
+		PRINT_ERROR("Transmitter creation failed.");
+		goto out;
+	}
+
+	if (rle_transmitter_sched_next(transmitter, 0, 100, &frag_id) == 0) {
+		PRINT_ERROR("No context should be chosen without SDU.");
+		goto out;
+	}
+
+	/* strict priority by default, whatever the deadlines */
+	if (rle_encapsulate(transmitter, &sdu, 3) != RLE_ENCAP_OK ||
+	    rle_encapsulate_timed(transmitter, &sdu, 1, 0, 5000) != RLE_ENCAP_OK ||
+	    rle_encapsulate_timed(transmitter, &sdu, 2, 0, 1000) != RLE_ENCAP_OK ||
+	    rle_encapsulate_timed(transmitter, &sdu, 4, 10, 100) != RLE_ENCAP_OK) {
+		PRINT_ERROR("Encapsulation failed.");
+		goto out;
+	}
+	if (rle_transmitter_sched_next(transmitter, 0, 100, &frag_id) != 0 || frag_id != 1) {
+		PRINT_ERROR("Strict priority should choose context 1.");
+		goto out;
+	}
+
+	/* earliest deadline first, the SDUs without deadline last */
+	memset(&sched_conf, 0, sizeof(sched_conf));
+	sched_conf.policy = RLE_SCHED_EDF;
+	if (rle_transmitter_sched_set(transmitter, &sched_conf) != 0 ||
+	    rle_transmitter_sched_next(transmitter, 0, 100, &frag_id) != 0 || frag_id != 4) {
+		PRINT_ERROR("Earliest deadline first should choose context 4.");
+		goto out;
+	}
+
+	/* the policy and the deadlines are not statistics */
+	rle_transmitter_stats_reset_link(transmitter);
+	if (rle_transmitter_sched_next(transmitter, 0, 100, &frag_id) != 0 || frag_id != 4) {
+		PRINT_ERROR("Statistics reset should keep the policy and the deadlines.");
+		goto out;
+	}
+
+	/* start to send the SDU of context 2, it does not expire any more */
+	if (rle_fragment(transmitter, 2, 100, &ppdu, &ppdu_len) != RLE_FRAG_OK) {
+		PRINT_ERROR("Fragmentation failed.");
+		goto out;
+	}
+
+	/* at 2000, the SDU of context 4 expired, the one of context 2 is started */
+	if (rle_transmitter_sched_next(transmitter, 2000, 100, &frag_id) != 0 || frag_id != 2) {
+		PRINT_ERROR("Earliest deadline first should choose context 2 once 4 expired.");
+		goto out;
+	}
+	if (rle_transmitter_stats_get_queue_size(transmitter, 4) != 0 ||
+	    rle_transmitter_stats_get_counter_sdus_expired(transmitter, 4) != 1 ||
+	    rle_transmitter_stats_get_counters(transmitter, 4, &stats) != 0 ||
+	    stats.sdus_dropped != 1 || stats.bytes_dropped != sdu.size ||
+	    rle_transmitter_stats_get_counter_bytes_expired(transmitter, 4) != sdu.size ||
+	    rle_transmitter_stats_get_counter_sdus_expired(transmitter, 2) != 0) {
+		PRINT_ERROR("Only the SDU of context 4 should be dropped as expired.");
+		goto out;
+	}
+
+	/* at 6000, the SDU of context 1 expired too, the one without deadline is left */
+	if (rle_transmitter_sched_next(transmitter, 6000, 100, &frag_id) != 0 || frag_id != 2) {
+		PRINT_ERROR("The started SDU of context 2 should still be chosen.");
+		goto out;
+	}
+	if (rle_transmitter_stats_get_counter_sdus_expired(transmitter, 1) != 1 ||
+	    rle_transmitter_stats_get_queue_size(transmitter, 3) == 0) {
+		PRINT_ERROR("The SDU of context 1 should be expired, the one of context 3 kept.");
+		goto out;
+	}
+	for (i = 1; i < 4; ++i) {
+		while (rle_transmitter_stats_get_queue_size(transmitter, i) > 0) {
+			if (rle_fragment(transmitter, i, 500, &ppdu, &ppdu_len) != RLE_FRAG_OK) {
+				PRINT_ERROR("Fragmentation failed.");
+				goto out;
+			}
+		}
+	}
+
+	/* contexts 6 and 7 are bulk ones with a quantum ratio of 1 to 3 */
+	sched_conf.policy = RLE_SCHED_PRIORITY;
+	sched_conf.quantum[6] = 500;
+	sched_conf.quantum[7] = 1500;
+	if (rle_transmitter_sched_set(transmitter, &sched_conf) != 0) {
+		PRINT_ERROR("Scheduler configuration failed.");
+		goto out;
+	}
+	rle_transmitter_stats_reset_link(transmitter);
+	for (i = 0; i < 400; ++i) {
+		if (i == 200 && rle_encapsulate(transmitter, &sdu, 0) != RLE_ENCAP_OK) {
+			PRINT_ERROR("Encapsulation failed.");
+			goto out;
+		}
+		if (rle_transmitter_stats_get_queue_size(transmitter, 6) == 0 &&
+		    rle_encapsulate(transmitter, &bulk_sdu, 6) != RLE_ENCAP_OK) {
+			PRINT_ERROR("Encapsulation failed.");
+			goto out;
+		}
+		if (rle_transmitter_stats_get_queue_size(transmitter, 7) == 0 &&
+		    rle_encapsulate(transmitter, &bulk_sdu, 7) != RLE_ENCAP_OK) {
+			PRINT_ERROR("Encapsulation failed.");
+			goto out;
+		}
+		if (rle_transmitter_sched_next(transmitter, 0, 200, &frag_id) != 0 ||
+		    (i >= 200 && rle_transmitter_stats_get_queue_size(transmitter, 0) > 0 &&
+		     frag_id != 0) ||
+		    rle_fragment(transmitter, frag_id, 200, &ppdu, &ppdu_len) != RLE_FRAG_OK) {
+			PRINT_ERROR("Scheduling failed at step %zu.", i);
+			goto out;
+		}
+		served[frag_id] += ppdu_len;
+	}
+	PRINT_TEST("served %zu, %zu and %zu octets in contexts 0, 6 and 7\n",
+	           served[0], served[6], served[7]);
+	if (served[0] == 0 || served[7] < served[6] * 5 / 2 || served[7] > served[6] * 7 / 2) {
+		PRINT_ERROR("Bulk contexts should be served in proportion of their quantum.");
+		goto out;
+	}
+
+	if (rle_transmitter_sched_set(transmitter, NULL) == 0 ||
+	    rle_transmitter_sched_next(NULL, 0, 100, &frag_id) == 0 ||
+	    rle_transmitter_sched_next(transmitter, 0, 100, NULL) == 0) {
+		PRINT_ERROR("Scheduler with invalid parameters should fail.");
+		goto out;
+	}
+
+	output = true;
+
+out:
+	if (transmitter != NULL) {
+		rle_transmitter_destroy(&transmitter);
+	}
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+
+	return output;
+}
+
+bool test_rle_ppdu_hdr_codec(void)
+{
+	bool output = false;
+	const uint8_t start_bytes[4] = { 0x8a, 0xad, 0xd5, 0xe7 };
+	const uint8_t comp_bytes[2] = { 0xff, 0xfc };
+	const uint8_t cont_bytes[2] = { 0x20, 0x00 };
+	const uint8_t end_bytes[2] = { 0x40, 0x0f };
+	rle_ppdu_hdr_t hdr;
+	struct rle_ppdu_hdr_fields fields;
+
+	PRINT_TEST("RLE PPDU header codec.\n");
+
+	/* START: length 0x155, fragment ID 5, CRC, total length 0xabc, signal, suppressed */
+	memset(&hdr, 0xff, sizeof(hdr));
+	rle_start_ppdu_hdr_set(&hdr.start, 0x155, 5, true, 0xabc, 3, 1);
+	rle_ppdu_hdr_decode(&hdr, &fields);
+	if (memcmp(hdr.start.bytes, start_bytes, sizeof(start_bytes)) != 0 ||
+	    fields.type != RLE_PDU_START_FRAG || fields.ppdu_len != 0x155 || fields.frag_id != 5 ||
+	    rle_ppdu_hdr_start_get_total_len(&hdr.start) != 0xabc ||
+	    rle_start_ppdu_hdr_get_use_crc(&hdr.start) != 1 ||
+	    rle_start_ppdu_hdr_get_frag_id(&hdr.start) != 5 ||
+	    !rle_start_ppdu_hdr_get_is_signal(&hdr.start) ||
+	    !rle_start_ppdu_hdr_get_is_suppressed(&hdr.start)) {
+		PRINT_ERROR("Wrong START PPDU header encoding.");
+		goto out;
+	}
+
+	/* fields updated in place */
+	rle_ppdu_hdr_set_ppdu_len(&hdr, 0x2aa);
+	rle_ppdu_hdr_start_set_total_len(&hdr.start, 0x543);
+	if (rle_ppdu_hdr_get_ppdu_length(&hdr) != 0x2aa ||
+	    rle_ppdu_hdr_start_get_total_len(&hdr.start) != 0x543 ||
+	    rle_start_ppdu_hdr_get_frag_id(&hdr.start) != 5 ||
+	    rle_start_ppdu_hdr_get_use_crc(&hdr.start) != 1 ||
+	    rle_ppdu_get_fragment_type(&hdr) != RLE_PDU_START_FRAG) {
+		PRINT_ERROR("Wrong START PPDU header update.");
+		goto out;
+	}
+
+	/* COMP: length 0x7ff, label type 2, not suppressed */
+	rle_comp_ppdu_hdr_set(&hdr.comp, 0x7ff, 2, 0);
+	rle_ppdu_hdr_decode(&hdr, &fields);
+	if (memcmp(hdr.comp.bytes, comp_bytes, sizeof(comp_bytes)) != 0 ||
+	    fields.type != RLE_PDU_COMPLETE || fields.ppdu_len != 0x7ff || fields.frag_id != 0 ||
+	    rle_comp_ppdu_hdr_get_is_signal(&hdr.comp) ||
+	    rle_comp_ppdu_hdr_get_is_suppressed(&hdr.comp)) {
+		PRINT_ERROR("Wrong COMP PPDU header encoding.");
+		goto out;
+	}
+
+	/* CONT: length 0x400, fragment ID 0 */
+	rle_cont_end_ppdu_hdr_set(&hdr.cont, false, 0x400, 0);
+	rle_ppdu_hdr_decode(&hdr, &fields);
+	if (memcmp(hdr.cont.bytes, cont_bytes, sizeof(cont_bytes)) != 0 ||
+	    fields.type != RLE_PDU_CONT_FRAG || fields.ppdu_len != 0x400 || fields.frag_id != 0) {
+		PRINT_ERROR("Wrong CONT PPDU header encoding.");
+		goto out;
+	}
+
+	/* END: length 1, fragment ID 7 */
+	rle_cont_end_ppdu_hdr_set(&hdr.end, true, 1, 7);
+	rle_ppdu_hdr_decode(&hdr, &fields);
+	if (memcmp(hdr.end.bytes, end_bytes, sizeof(end_bytes)) != 0 ||
+	    fields.type != RLE_PDU_END_FRAG || fields.ppdu_len != 1 || fields.frag_id != 7 ||
+	    rle_cont_end_ppdu_hdr_get_frag_id(&hdr.end) != 7) {
+		PRINT_ERROR("Wrong END PPDU header encoding.");
+		goto out;
+	}
+
+	output = true;
+
+out:
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+
+	return output;
+}
+
+bool test_rle_fpdu_trace(void)
+{
+	bool output = false;
+	const size_t records_nr = 300;
+	char path[64];
+	unsigned char fpdu_in[600];
+	struct rle_fpdu_trace_writer *writer = NULL;
+	struct rle_fpdu_trace *trace = NULL;
+	struct rle_fpdu_trace_header header;
+	const unsigned char *first = NULL;
+	off_t last_offset = 0;
+	unsigned char *fpdu;
+	size_t i;
+	int fd;
+
+	PRINT_TEST("FPDU trace.\n");
+
+	snprintf(path, sizeof(path), "/tmp/rle_test_fpdu_trace_%d", (int)getpid());
+
+	writer = rle_fpdu_trace_writer_open(path);
+	if (writer == NULL) {
+		PRINT_ERROR("Writer should be opened.");
+		goto out;
+	}
+	for (i = 0; i < records_nr; ++i) {
+		const struct rle_fpdu_trace_record record = {
+			.timestamp_ns = 1000 * i,
+			.burst = i / 4,
+			.fpdu_len = 1 + (i * 7) % sizeof(fpdu_in),
+			.label_len = i % 2,
+			.flags = 0,
+		};
+
+		memset(fpdu_in, (int)i, sizeof(fpdu_in));
+		if (rle_fpdu_trace_write(writer, &record, fpdu_in) != 0) {
+			PRINT_ERROR("Record %zu should be written.", i);
+			goto out;
+		}
+	}
+	if (rle_fpdu_trace_writer_close(&writer) != 0 || writer != NULL) {
+		PRINT_ERROR("Writer should be closed.");
+		goto out;
+	}
+
+	/* the trace is read back with its index */
+	trace = rle_fpdu_trace_open(path);
+	if (trace == NULL || rle_fpdu_trace_count(trace) != records_nr) {
+		PRINT_ERROR("Trace should be opened with all its records.");
+		goto out;
+	}
+	for (i = 0; i < records_nr; ++i) {
+		const struct rle_fpdu_trace_record *const record = rle_fpdu_trace_get(trace, i, &fpdu);
+		size_t j;
+
+		if (record->timestamp_ns != 1000 * i || record->burst != i / 4 ||
+		    record->fpdu_len != 1 + (i * 7) % sizeof(fpdu_in) || record->label_len != i % 2 ||
+		    ((uintptr_t)record) % 8 != 0 || fpdu != (const unsigned char *)(record + 1)) {
+			PRINT_ERROR("Record %zu differs.", i);
+			goto out;
+		}
+		for (j = 0; j < record->fpdu_len; ++j) {
+			if (fpdu[j] != (unsigned char)i) {
+				PRINT_ERROR("FPDU of record %zu differs.", i);
+				goto out;
+			}
+		}
+
+		/* the records follow the header, the FPDUs may be decapsulated in place */
+		if (i == 0) {
+			first = (const unsigned char *)record;
+		}
+		last_offset = sizeof(struct rle_fpdu_trace_header) +
+		              ((const unsigned char *)record - first);
+		fpdu[0] = 0xff;
+	}
+	rle_fpdu_trace_close(&trace);
+	if (trace != NULL) {
+		PRINT_ERROR("Trace should be closed.");
+		goto out;
+	}
+
+	/* a trace not completed: without index, the last record truncated */
+	if (truncate(path, last_offset + sizeof(struct rle_fpdu_trace_record) + 1) != 0) {
+		PRINT_ERROR("Trace should be truncated.");
+		goto out;
+	}
+	memset(&header, 0, sizeof(struct rle_fpdu_trace_header));
+	header.magic = RLE_FPDU_TRACE_MAGIC;
+	header.version = RLE_FPDU_TRACE_VERSION;
+	fd = open(path, O_WRONLY);
+	if (fd < 0) {
+		PRINT_ERROR("Trace should be opened for writing.");
+		goto out;
+	}
+	if (pwrite(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) {
+		PRINT_ERROR("Header should be written.");
+		close(fd);
+		goto out;
+	}
+	close(fd);
+
+	trace = rle_fpdu_trace_open(path);
+	if (trace == NULL || rle_fpdu_trace_count(trace) != records_nr - 1) {
+		PRINT_ERROR("Trace should be opened with all its complete records.");
+		goto out;
+	}
+	if (rle_fpdu_trace_get(trace, records_nr - 2, &fpdu)->timestamp_ns !=
+	    1000 * (records_nr - 2) || fpdu[0] == 0xff || fpdu[1] != (unsigned char)(records_nr - 2)) {
+		PRINT_ERROR("Last complete record differs.");
+		goto out;
+	}
+
+	/* not a trace */
+	header.magic = 0;
+	fd = open(path, O_WRONLY);
+	if (fd < 0 || pwrite(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header)) {
+		PRINT_ERROR("Header should be overwritten.");
+		if (fd >= 0) {
+			close(fd);
+		}
+		goto out;
+	}
+	close(fd);
+	rle_fpdu_trace_close(&trace);
+	trace = rle_fpdu_trace_open(path);
+	if (trace != NULL) {
+		PRINT_ERROR("File without magic should not be opened.");
+		goto out;
+	}
+
+	output = true;
+
+out:
+	if (writer != NULL) {
+		rle_fpdu_trace_writer_close(&writer);
+	}
+	rle_fpdu_trace_close(&trace);
+	unlink(path);
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+
+	return output;
+}
+
+bool test_rle_checkpoint(void)
+{
+	bool output = false;
+	const struct rle_config confs[2] = {
+		{
+			.allow_ptype_omission = 0,
+			.use_compressed_ptype = 1,
+			.allow_alpdu_crc = 0,
+			.allow_alpdu_sequence_number = 1,
+			.use_explicit_payload_header_map = 0,
+			.implicit_protocol_type = 0x00,
+			.implicit_ppdu_label_size = 0,
+			.implicit_payload_label_size = 0,
+			.type_0_alpdu_label_size = 0,
+		},
+		{
+			.allow_ptype_omission = 0,
+			.use_compressed_ptype = 1,
+			.allow_alpdu_crc = 1,
+			.allow_alpdu_sequence_number = 0,
+			.use_explicit_payload_header_map = 0,
+			.implicit_protocol_type = 0x00,
+			.implicit_ppdu_label_size = 0,
+			.implicit_payload_label_size = 0,
+			.type_0_alpdu_label_size = 0,
+		},
+	};
+	/* a SDU copied, a Ethernet/VLAN/IPv4 frame encapsulated in place and a short SDU */
+	const uint8_t frag_ids[3] = { 0, 3, 5 };
+	const size_t sdus_lens[3] = { 1500, 600, 40 };
+	const size_t fpdu_size = 600;
+	struct rle_transmitter *tx = NULL;
+	struct rle_transmitter *tx_standby = NULL;
+	struct rle_receiver *rx = NULL;
+	struct rle_receiver *rx_standby = NULL;
+	struct rle_receiver *rx_other = NULL;
+	static unsigned char sdus_buffers[3][1500];
+	static unsigned char sdu_mem[RLE_SDU_BUF_HEADROOM + 600 + RLE_SDU_BUF_TAILROOM];
+	static unsigned char tx_cp[2][RLE_MAX_FRAG_NUMBER * 2048];
+	static unsigned char rx_cp[2][RLE_MAX_FRAG_NUMBER * 2048];
+	static unsigned char out_buffer[1500];
+	struct rle_sdu_buf sdu_buf = {
+		.head = sdu_mem, .size = sizeof(sdu_mem), .data_offset = RLE_SDU_BUF_HEADROOM,
+		.data_len = 600, .protocol_type = 0x8100
+	};
+	struct rle_sdu sdus[3];
+	size_t c;
+	size_t i;
+
+	PRINT_TEST("RLE checkpoint and restore of transmitters and receivers.\n");
+
+	for (i = 0; i < 3; ++i) {
+		size_t j;
+
+		for (j = 0; j < sdus_lens[i]; ++j) {
+			sdus_buffers[i][j] = (unsigned char)(i * 31 + j * 7);
+		}
+		sdus[i].buffer = sdus_buffers[i];
+		sdus[i].size = sdus_lens[i];
+		sdus[i].protocol_type = 0x0800;
+	}
+	sdus_buffers[1][12] = 0x81;
+	sdus_buffers[1][13] = 0x00;
+	sdus_buffers[1][16] = 0x08;
+	sdus_buffers[1][17] = 0x00;
+	sdus_buffers[1][18] = 0x45;
+	sdus[1].protocol_type = 0x8100;
+
+	for (c = 0; c < 2; ++c) {
+		const struct rle_config *const conf = &confs[c];
+		struct rle_sdu out_sdu = { .buffer = out_buffer };
+		size_t tx_cp_len;
+		size_t rx_cp_len;
+		size_t used;
+		size_t sdus_nr;
+		size_t delivered = 0;
+
+		tx = rle_transmitter_new(conf);
+		tx_standby = rle_transmitter_new(conf);
+		rx = rle_receiver_new(conf);
+		rx_standby = rle_receiver_new(conf);
+		rx_other = rle_receiver_new(&confs[1 - c]);
+		if (tx == NULL || tx_standby == NULL || rx == NULL || rx_standby == NULL ||
+		    rx_other == NULL) {
+			PRINT_ERROR("Transmitters or receivers creation failed.");
+			goto out;
+		}
+
+		/* a first SDU synchronizes the sequence numbers of context 0 */
+		if (rle_encapsulate(tx, &sdus[0], frag_ids[0]) != RLE_ENCAP_OK) {
+			PRINT_ERROR("Encapsulation failed.");
+			goto out;
+		}
+		while (rle_transmitter_stats_get_queue_size(tx, frag_ids[0]) > 0) {
+			if (!send_ppdu(tx, frag_ids[0], fpdu_size, rx, &out_sdu, &sdus_nr)) {
+				PRINT_ERROR("First SDU not sent.");
+				goto out;
+			}
+		}
+
+		/* the SDUs in flight: 2 partially sent and received, 1 not sent yet */
+		memcpy(sdu_mem + RLE_SDU_BUF_HEADROOM, sdus_buffers[1], sdus_lens[1]);
+		if (rle_encapsulate(tx, &sdus[0], frag_ids[0]) != RLE_ENCAP_OK ||
+		    rle_encapsulate_in_place(tx, &sdu_buf, frag_ids[1]) != RLE_ENCAP_OK ||
+		    rle_encapsulate(tx, &sdus[2], frag_ids[2]) != RLE_ENCAP_OK) {
+			PRINT_ERROR("Encapsulation failed.");
+			goto out;
+		}
+		for (i = 0; i < 2; ++i) {
+			if (!send_ppdu(tx, frag_ids[i], fpdu_size, rx, &out_sdu, &sdus_nr) ||
+			    sdus_nr != 0) {
+				PRINT_ERROR("START PPDU of SDU %zu not sent.", i);
+				goto out;
+			}
+		}
+
+		if (rle_transmitter_checkpoint(tx, tx_cp[0], rle_transmitter_checkpoint_size(tx) - 1,
+		                               &tx_cp_len) == 0 ||
+		    rle_receiver_checkpoint(rx, rx_cp[0], rle_receiver_checkpoint_size(rx) - 1,
+		                            &rx_cp_len) == 0) {
+			PRINT_ERROR("Checkpoint in a too small buffer accepted.");
+			goto out;
+		}
+		if (rle_transmitter_checkpoint(tx, tx_cp[0], sizeof(tx_cp[0]), &tx_cp_len) != 0 ||
+		    tx_cp_len != rle_transmitter_checkpoint_size(tx) ||
+		    rle_receiver_checkpoint(rx, rx_cp[0], sizeof(rx_cp[0]), &rx_cp_len) != 0 ||
+		    rx_cp_len != rle_receiver_checkpoint_size(rx)) {
+			PRINT_ERROR("Checkpoint failed.");
+			goto out;
+		}
+
+		/* the primary goes away with the buffer of the SDU encapsulated in place */
+		rle_transmitter_destroy(&tx);
+		rle_receiver_destroy(&rx);
+		memset(sdu_mem, 0, sizeof(sdu_mem));
+
+		if (rle_receiver_restore(rx_standby, tx_cp[0], tx_cp_len, NULL) == 0 ||
+		    rle_receiver_restore(rx_standby, rx_cp[0], rx_cp_len - 1, NULL) == 0 ||
+		    rle_receiver_restore(rx_other, rx_cp[0], rx_cp_len, NULL) == 0 ||
+		    rle_transmitter_restore(tx_standby, tx_cp[0], tx_cp_len - 1, NULL) == 0) {
+			PRINT_ERROR("Invalid checkpoint restored.");
+			goto out;
+		}
+		if (rle_transmitter_restore(tx_standby, tx_cp[0], sizeof(tx_cp[0]), &used) != 0 ||
+		    used != tx_cp_len ||
+		    rle_receiver_restore(rx_standby, rx_cp[0], sizeof(rx_cp[0]), &used) != 0 ||
+		    used != rx_cp_len) {
+			PRINT_ERROR("Restore failed.");
+			goto out;
+		}
+
+		/* the standbys checkpoint the same state */
+		if (rle_transmitter_checkpoint(tx_standby, tx_cp[1], sizeof(tx_cp[1]), &used) != 0 ||
+		    used != tx_cp_len || memcmp(tx_cp[0], tx_cp[1], used) != 0 ||
+		    rle_receiver_checkpoint(rx_standby, rx_cp[1], sizeof(rx_cp[1]), &used) != 0 ||
+		    used != rx_cp_len || memcmp(rx_cp[0], rx_cp[1], used) != 0) {
+			PRINT_ERROR("Restored state differs.");
+			goto out;
+		}
+
+		/* the standbys go on without loss */
+		for (i = 0; i < 3; ++i) {
+			while (rle_transmitter_stats_get_queue_size(tx_standby, frag_ids[i]) > 0) {
+				if (!send_ppdu(tx_standby, frag_ids[i], fpdu_size, rx_standby, &out_sdu,
+				               &sdus_nr)) {
+					PRINT_ERROR("PPDU of SDU %zu not sent by the standby.", i);
+					goto out;
+				}
+				if (sdus_nr == 1) {
+					if (out_sdu.size != sdus_lens[i] ||
+					    memcmp(out_sdu.buffer, sdus_buffers[i], sdus_lens[i]) != 0) {
+						PRINT_ERROR("SDU %zu differs.", i);
+						goto out;
+					}
+					delivered++;
+				}
+			}
+		}
+		if (delivered != 3 ||
+		    rle_receiver_stats_get_counter_sdus_reassembled(rx_standby, frag_ids[0]) != 2 ||
+		    rle_transmitter_stats_get_counter_sdus_sent(tx_standby, frag_ids[0]) != 2) {
+			PRINT_ERROR("%zu SDUs delivered by the standbys, 3 expected.", delivered);
+			goto out;
+		}
+		for (i = 0; i < RLE_DECAP_ERROR_NB; ++i) {
+			if (rle_receiver_stats_get_counter_errors(rx_standby,
+			                                          (enum rle_decap_error_type)i) != 0) {
+				PRINT_ERROR("Error %zu detected by the standby receiver.", i);
+				goto out;
+			}
+		}
+
+		rle_transmitter_destroy(&tx_standby);
+		rle_receiver_destroy(&rx_standby);
+		rle_receiver_destroy(&rx_other);
+	}
+
+	output = true;
+
+out:
+	if (tx != NULL) {
+		rle_transmitter_destroy(&tx);
+	}
+	if (tx_standby != NULL) {
+		rle_transmitter_destroy(&tx_standby);
+	}
+	if (rx != NULL) {
+		rle_receiver_destroy(&rx);
+	}
+	if (rx_standby != NULL) {
+		rle_receiver_destroy(&rx_standby);
+	}
+	if (rx_other != NULL) {
+		rle_receiver_destroy(&rx_other);
+	}
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+
+	return output;
+}
+
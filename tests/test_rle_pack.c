@@ -432,3 +432,144 @@ bool test_pack_all(void)
 	printf("\n");
 	return output;
 }
+
+bool test_pack_iov(void)
+{
+	bool output = false;
+	const struct rle_config conf = {
+		.allow_ptype_omission = 0,
+		.use_compressed_ptype = 1,
+		.allow_alpdu_crc = 0,
+		.allow_alpdu_sequence_number = 1,
+		.use_explicit_payload_header_map = 0,
+		.implicit_protocol_type = 0x00,
+		.implicit_ppdu_label_size = 0,
+		.implicit_payload_label_size = 3,
+		.type_0_alpdu_label_size = 0,
+	};
+	const size_t sdu_lens[] = { 1500, 40, 700 };
+	const unsigned char label[3] = { 0xaa, 0xbb, 0xcc };
+	struct rle_transmitter *transmitters[2] = { NULL, NULL };
+	unsigned char sdu_buffer[RLE_MAX_PDU_SIZE];
+	unsigned char fpdu[9000];
+	unsigned char gathered[9000];
+	rle_iovec_t iov[16];
+	size_t fpdus_nr = 0;
+	uint8_t frag_id;
+	size_t i;
+
+	PRINT_TEST("Test PACK in a gather list.");
+
+	for (i = 0; i < sizeof(sdu_buffer); ++i) {
+		sdu_buffer[i] = i & 0xff;
+	}
+
+	for (i = 0; i < 2; ++i) {
+		transmitters[i] = rle_transmitter_new(&conf);
+		if (transmitters[i] == NULL) {
+			PRINT_ERROR("Transmitter creation failed.");
+			goto exit_label;
+		}
+	}
+
+	for (frag_id = 0; frag_id < 3; ++frag_id) {
+		const struct rle_sdu sdu = {
+			.buffer = sdu_buffer, .size = sdu_lens[frag_id], .protocol_type = 0x0800
+		};
+
+		for (i = 0; i < 2; ++i) {
+			if (rle_encapsulate(transmitters[i], &sdu, frag_id) != RLE_ENCAP_OK) {
+				PRINT_ERROR("Encapsulation failed.");
+				goto exit_label;
+			}
+		}
+	}
+
+	/* a copied FPDU and a gathered one, with one PPDU of each context at most */
+	while (rle_transmitter_stats_get_queue_size(transmitters[0], 0) > 0 ||
+	       rle_transmitter_stats_get_queue_size(transmitters[0], 2) > 0) {
+		const size_t fpdu_size = (fpdus_nr % 2 == 0 ? 500 : sizeof(fpdu));
+		size_t fpdu_pos[2] = { 0, 0 };
+		size_t fpdu_remain[2] = { fpdu_size, fpdu_size };
+		size_t iov_nr = 0;
+		size_t gathered_len = 0;
+
+		for (frag_id = 0; frag_id < 3; ++frag_id) {
+			unsigned char *ppdus[2];
+			size_t ppdus_len[2];
+
+			if (rle_transmitter_stats_get_queue_size(transmitters[0], frag_id) == 0 ||
+			    fpdu_remain[0] < 3 + 10) {
+				continue;
+			}
+			for (i = 0; i < 2; ++i) {
+				if (rle_fragment(transmitters[i], frag_id,
+				                 fpdu_remain[i] - (fpdu_pos[i] == 0 ? 3 : 0), &ppdus[i],
+				                 &ppdus_len[i]) != RLE_FRAG_OK) {
+					PRINT_ERROR("Fragmentation failed.");
+					goto exit_label;
+				}
+			}
+			if (rle_pack(ppdus[0], ppdus_len[0], label, sizeof(label), fpdu, &fpdu_pos[0],
+			             &fpdu_remain[0]) != RLE_PACK_OK ||
+			    rle_pack_iov(ppdus[1], ppdus_len[1], label, sizeof(label), iov, 16, &iov_nr,
+			                 &fpdu_pos[1], &fpdu_remain[1]) != RLE_PACK_OK) {
+				PRINT_ERROR("Packing failed.");
+				goto exit_label;
+			}
+		}
+		rle_pad(fpdu, fpdu_pos[0], fpdu_remain[0]);
+		if ((fpdu_remain[1] > 0 &&
+		     rle_pad_iov(iov, iov_nr, &iov_nr, fpdu_remain[1]) != RLE_PACK_ERR_IOV_FULL) ||
+		    rle_pad_iov(iov, 16, &iov_nr, fpdu_remain[1]) != RLE_PACK_OK) {
+			PRINT_ERROR("Padding failed.");
+			goto exit_label;
+		}
+
+		for (i = 0; i < iov_nr; ++i) {
+			memcpy(gathered + gathered_len, iov[i].iov_base, iov[i].iov_len);
+			gathered_len += iov[i].iov_len;
+		}
+		if (fpdu_pos[0] != fpdu_pos[1] || gathered_len != fpdu_size ||
+		    memcmp(fpdu, gathered, fpdu_size) != 0) {
+			PRINT_ERROR("Gathered FPDU #%zu differs from the copied one.", fpdus_nr);
+			goto exit_label;
+		}
+		PRINT_TEST("FPDU #%zu: %zu octets in %zu segments", fpdus_nr, gathered_len, iov_nr);
+		fpdus_nr++;
+	}
+
+	{
+		size_t iov_nr = 0;
+		size_t fpdu_pos = 0;
+		size_t fpdu_remain = 100;
+
+		if (rle_pack_iov_init(label, sizeof(label), iov, 0, &iov_nr, &fpdu_pos,
+		                      &fpdu_remain) != RLE_PACK_ERR_IOV_FULL ||
+		    rle_pack_iov_init(label, 2, iov, 16, &iov_nr, &fpdu_pos,
+		                      &fpdu_remain) != RLE_PACK_ERR_INVALID_LAB ||
+		    rle_pack_iov_init(label, sizeof(label), iov, 16, &iov_nr, &fpdu_pos,
+		                      &fpdu_remain) != RLE_PACK_OK ||
+		    iov_nr != 1 || fpdu_pos != 3 || fpdu_remain != 97 ||
+		    rle_pack_iov(sdu_buffer, 98, label, sizeof(label), iov, 16, &iov_nr, &fpdu_pos,
+		                 &fpdu_remain) != RLE_PACK_ERR_FPDU_TOO_SMALL ||
+		    rle_pack_iov(NULL, 10, label, sizeof(label), iov, 16, &iov_nr, &fpdu_pos,
+		                 &fpdu_remain) != RLE_PACK_ERR_INVALID_PPDU) {
+			PRINT_ERROR("Packing in a gather list with invalid parameters should fail.");
+			goto exit_label;
+		}
+	}
+
+	output = true;
+
+exit_label:
+	for (i = 0; i < 2; ++i) {
+		if (transmitters[i] != NULL) {
+			rle_transmitter_destroy(&transmitters[i]);
+		}
+	}
+
+	PRINT_TEST_STATUS(output);
+	printf("\n");
+	return output;
+}
@@ -0,0 +1,295 @@
+/*
+ * librle implements the Return Link Encapsulation (RLE) protocol
+ *
+ * Copyright (C) 2015-2016, Thales Alenia Space France - All Rights Reserved
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file   test_stats_shm_reader.c
+ * @brief  Print the RLE statistics published in a shared-memory region.
+ * @author Thales Alenia Space France
+ * @date   10/2026
+ * @copyright
+ *   Copyright (C) 2026, Thales Alenia Space France - All Rights Reserved
+ */
+
+#include "rle.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <inttypes.h>
+#include <assert.h>
+#include <getopt.h>
+#include <signal.h>
+#include <unistd.h>
+
+/** The program version */
+#define TEST_VERSION  "RLE shared-memory statistics reader, version 0.0.1\n"
+
+/** Default refresh interval in milliseconds */
+#define DEFAULT_INTERVAL 1000
+
+/* prototypes of private functions */
+static void usage(void);
+static void test_interrupt(int signum);
+static void print_log(const int module_id, const int level, const char *const file,
+                      const int line, const char *const func, const char *const message, ...);
+static void print_snapshot(const struct rle_stats_shm_snapshot *const snapshot);
+
+/** Names of the receiver error types */
+static const char *const decap_error_names[RLE_DECAP_ERROR_NB] = {
+	[RLE_DECAP_ERROR_INV_LEN] = "invalid_length",
+	[RLE_DECAP_ERROR_CTX_STATE] = "context_state",
+	[RLE_DECAP_ERROR_CRC] = "crc_mismatch",
+	[RLE_DECAP_ERROR_SEQNUM] = "seqnum_gap",
+	[RLE_DECAP_ERROR_TRAILER_SHORT] = "trailer_too_short",
+	[RLE_DECAP_ERROR_ALPDU_HDR] = "alpdu_header",
+	[RLE_DECAP_ERROR_VLAN] = "vlan",
+	[RLE_DECAP_ERROR_SDUS_FULL] = "sdus_full",
+	[RLE_DECAP_ERROR_PADDING] = "padding",
+};
+
+/** Flag to stop the application */
+static int stop_program = 0;
+
+/**
+ * @brief Main function for the RLE shared-memory statistics reader
+ *
+ * @param[in] argc The number of program arguments
+ * @param[in] argv The program arguments
+ *
+ * @return         The unix return code:
+ *                 \li 0 in case of success,
+ *                 \li 1 in case of failure
+ */
+int main(int argc, char *argv[])
+{
+	int status = EXIT_FAILURE;
+	long interval = DEFAULT_INTERVAL;
+	long count = 1;
+	struct rle_stats_shm *shm = NULL;
+	struct rle_stats_shm_snapshot snapshot;
+	long i;
+
+	while (1) {
+		int c;
+
+		const char short_options[] = "vhi:c:";
+
+		const struct option long_options[] =
+		{
+			{ "interval", required_argument, NULL, 'i' },
+			{ "count", required_argument, NULL, 'c' },
+			{ NULL, 0, NULL, 0 }
+		};
+
+		int option_index = 0;
+
+		c = getopt_long(argc, argv, short_options, long_options, &option_index);
+
+		if (c == -1) {
+			break;
+		}
+
+		switch (c) {
+		case 'i': /* Interval */
+			assert(optarg != NULL);
+			interval = atol(optarg);
+			if (interval <= 0) {
+				printf("ERROR: interval shall be strictly positive.\n");
+				goto error;
+			}
+			break;
+
+		case 'c': /* Count */
+			assert(optarg != NULL);
+			count = atol(optarg);
+			break;
+
+		case 'v': /* Version */
+			printf(TEST_VERSION);
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case 'h': /* Help */
+			usage();
+			status = EXIT_SUCCESS;
+			goto error;
+
+		case '?':
+		default:
+			usage();
+			goto error;
+		}
+	}
+
+	if (optind != argc - 1) {
+		fprintf(stderr, "NAME is a mandatory parameter\n\n");
+		usage();
+		goto error;
+	}
+
+	rle_set_trace_callback(print_log);
+	signal(SIGINT, test_interrupt);
+
+	shm = rle_stats_shm_attach(argv[optind]);
+	if (shm == NULL) {
+		goto error;
+	}
+
+	for (i = 0; !stop_program && (count <= 0 || i < count); ++i) {
+		if (i > 0) {
+			usleep(interval * 1000);
+		}
+		if (rle_stats_shm_read(shm, &snapshot) != 0) {
+			fprintf(stderr, "failed to read statistics\n");
+			goto detach;
+		}
+		print_snapshot(&snapshot);
+	}
+
+	status = EXIT_SUCCESS;
+
+detach:
+	rle_stats_shm_destroy(&shm);
+error:
+	return status;
+}
+
+/**
+ * @brief Print usage of the reader
+ */
+static void usage(void)
+{
+	fprintf(stderr,
+	        "\n"
+	        "RLE shared-memory statistics reader: print the counters published by a\n"
+	        "process with rle_stats_shm_create.\n"
+	        "\n"
+	        "usage: test_stats_shm_reader [OPTIONS] NAME\n"
+	        "\n"
+	        "with:\n"
+	        "\tNAME                    The name of the shared-memory object (/rle for example).\n"
+	        "\n"
+	        "options:\n"
+	        "\t-v                      Print version information and exit\n"
+	        "\t-h                      Print this usage and exit\n"
+	        "\t--interval, -i          Refresh interval (default %d ms)\n"
+	        "\t--count, -c             Number of snapshots, 0 for endless (default 1)\n"
+	        "\n",
+	        DEFAULT_INTERVAL);
+
+	return;
+}
+
+/**
+ * @brief Handle UNIX signals that interrupt the program
+ *
+ * @param signum  The UNIX signal number
+ */
+static void test_interrupt(int signum)
+{
+	/* end the program with next captured packet */
+	printf("signal %d catched\n", signum);
+	stop_program = 1;
+
+	return;
+}
+
+/**
+ * @brief Print the library error messages
+ *
+ * @param module_id  The library module
+ * @param level      The log level
+ * @param file       The source file
+ * @param line       The source line
+ * @param func       The function
+ * @param message    The message format
+ * @param ...        The message arguments
+ */
+static void print_log(const int module_id __attribute__((unused)),
+                      const int level,
+                      const char *const file __attribute__((unused)),
+                      const int line __attribute__((unused)),
+                      const char *const func,
+                      const char *const message, ...)
+{
+	va_list args;
+
+	if (level > RLE_LOG_LEVEL_WARNING) {
+		return;
+	}
+
+	va_start(args, message);
+	fprintf(stderr, "%s: ", func);
+	vfprintf(stderr, message, args);
+	fprintf(stderr, "\n");
+	va_end(args);
+}
+
+/**
+ * @brief Print a snapshot of the statistics
+ *
+ * @param snapshot  The snapshot to print
+ */
+static void print_snapshot(const struct rle_stats_shm_snapshot *const snapshot)
+{
+	const struct rle_stats_shm_transmitter *const t = &snapshot->transmitter;
+	const struct rle_stats_shm_receiver *const r = &snapshot->receiver;
+	size_t frag_id;
+	size_t type;
+
+	printf("transmitter (%" PRIu64 " updates)\n", t->updates);
+	printf("  ctx %10s %10s %10s %12s %12s %12s %6s\n", "sdus_in", "sent", "dropped",
+	       "bytes_in", "bytes_sent", "bytes_drop", "queue");
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		const struct rle_transmitter_stats *const s = &t->ctx[frag_id];
+
+		printf("  %3zu %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %12" PRIu64 " %12" PRIu64
+		       " %12" PRIu64 " %6" PRIu64 "\n", frag_id, s->sdus_in, s->sdus_sent,
+		       s->sdus_dropped, s->bytes_in, s->bytes_sent, s->bytes_dropped,
+		       t->queue_size[frag_id]);
+	}
+	printf("  all %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %12" PRIu64 " %12" PRIu64
+	       " %12" PRIu64 "\n", t->total.sdus_in, t->total.sdus_sent, t->total.sdus_dropped,
+	       t->total.bytes_in, t->total.bytes_sent, t->total.bytes_dropped);
+
+	printf("receiver (%" PRIu64 " updates)\n", r->updates);
+	printf("  ctx %10s %10s %10s %10s %12s %12s %12s %6s\n", "sdus_recv", "reasm", "dropped",
+	       "lost", "bytes_recv", "bytes_reasm", "bytes_drop", "queue");
+	for (frag_id = 0; frag_id < RLE_MAX_FRAG_NUMBER; ++frag_id) {
+		const struct rle_receiver_stats *const s = &r->ctx[frag_id];
+
+		printf("  %3zu %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %12" PRIu64
+		       " %12" PRIu64 " %12" PRIu64 " %6" PRIu64 "\n", frag_id, s->sdus_received,
+		       s->sdus_reassembled, s->sdus_dropped, s->sdus_lost, s->bytes_received,
+		       s->bytes_reassembled, s->bytes_dropped, r->queue_size[frag_id]);
+	}
+	printf("  all %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %12" PRIu64
+	       " %12" PRIu64 " %12" PRIu64 "\n", r->total.sdus_received, r->total.sdus_reassembled,
+	       r->total.sdus_dropped, r->total.sdus_lost, r->total.bytes_received,
+	       r->total.bytes_reassembled, r->total.bytes_dropped);
+	printf("  errors:");
+	for (type = 0; type < RLE_DECAP_ERROR_NB; ++type) {
+		printf(" %s=%" PRIu64, decap_error_names[type], r->errors.errors[type]);
+	}
+	printf(" traces_suppressed=%" PRIu64 " fpdus_filtered=%" PRIu64 "\n",
+	       r->errors.traces_suppressed, r->errors.fpdus_filtered);
+	printf("\n");
+	fflush(stdout);
+}